@@ -0,0 +1,105 @@
+#ifndef COLLECTOR_H
+#define COLLECTOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "event_loop.h"
+#include "node_state.h"
+#include "serial_source.h"
+#include "ts_log.h"
+#include "ws_server.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         COLLECTOR                                         ║
+// ║  Serial sources -> mesh state + time-series log -> dashboard clients      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct CollectorOptions {
+    int httpPort;               // -1 = no HTTP listener, 0 = any free port
+    int wsPort;
+    std::string staticDir;      // Directory holding dashboard.html
+    std::string logDir;         // Empty = no time-series log
+    std::string recordPath;     // Empty = no recording
+    bool exitOnEof;             // Stop when every source has closed (replay)
+    bool verbose;               // Print source open/close
+};
+
+struct CollectorStats {
+    uint64_t lines;             // Non-empty lines from all sources
+    uint64_t bytes;
+    uint32_t sourcesOpen;
+    uint64_t recorded;          // Lines written to the recording
+};
+
+/**
+ * Collector - Wires sources, state, log and web server to one event loop
+ */
+class Collector {
+public:
+    Collector();
+    ~Collector();
+
+    /**
+     * Create the event loop, listeners, log and timers
+     * @return false on failure (message printed)
+     */
+    bool init(const CollectorOptions& options);
+
+    /**
+     * Add a gateway UART (also receives dashboard commands)
+     */
+    bool addSerialPort(const std::string& path, unsigned baud);
+
+    /**
+     * Add a read-only stream (replay pipe, stdin)
+     */
+    bool addStream(int fd, const std::string& name);
+
+    void run();
+    void stop();
+
+    /**
+     * Flush the log and recording, push a last update to clients
+     */
+    void finish();
+
+    EventLoop& eventLoop() { return loop; }
+    MeshState& meshState() { return state; }
+    WebServer& webServer() { return *web; }
+    TimeSeriesLog& timeSeriesLog() { return log; }
+    int httpPort() const { return boundHttpPort; }
+    int wsPort() const { return boundWsPort; }
+    const CollectorStats& stats() const { return collectorStats; }
+
+private:
+    bool addSource(std::unique_ptr<SerialSource> source, bool commandTarget);
+    void onReadable(SerialSource* source);
+    void onLine(SerialSource& source, std::string_view line, uint64_t wallMs, uint64_t monoMs);
+    std::string sendCommand(const std::string& line);
+    void flushRecording();
+    void appendStats(std::string& out);
+
+    EventLoop loop;
+    MeshState state;
+    std::unique_ptr<WebServer> web;
+    TimeSeriesLog log;
+    CollectorOptions options;
+
+    std::vector<std::unique_ptr<SerialSource>> sources;
+    std::vector<SerialSource*> commandTargets;
+    uint8_t nextSourceId;
+
+    std::vector<int> timers;
+    int recordFd;
+    std::string recordBuffer;
+
+    int boundHttpPort;
+    int boundWsPort;
+    CollectorStats collectorStats;
+};
+
+#endif // COLLECTOR_H
@@ -0,0 +1,34 @@
+#ifndef COLLECTOR_CONFIG_H
+#define COLLECTOR_CONFIG_H
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         COLLECTOR CONFIGURATION                           ║
+// ║  Defaults match serial_bridge.py so dashboard.html works unchanged        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define COLLECTOR_HTTP_PORT         8080    // Dashboard + REST API
+#define COLLECTOR_WS_PORT           8081    // WebSocket (dashboard.html connects here)
+#define COLLECTOR_DEFAULT_BAUD      115200
+
+#define COLLECTOR_MAX_SOURCES       16      // Serial ports / replay streams
+#define COLLECTOR_READ_CHUNK        65536   // Bytes per read() from a source
+#define COLLECTOR_LINE_MAX          4096    // Longer lines are dropped (garbage on the UART)
+#define COLLECTOR_MAX_NODE_ID       255     // Node IDs are 8-bit on the mesh
+
+#define COLLECTOR_TICK_MS           100     // Fan-out period (updates are coalesced per tick)
+#define COLLECTOR_OFFLINE_CHECK_MS  5000    // serial_bridge.py OFFLINE_CHECK_INTERVAL
+#define COLLECTOR_OFFLINE_MS        90000   // serial_bridge.py NODE_OFFLINE_TIMEOUT
+#define COLLECTOR_DUPLICATE_MS      30000   // Same node + meshMsgId within this = copy via another gateway
+#define COLLECTOR_DEDUPE_DEPTH      8       // Recent meshMsgIds kept per node (gateways drift apart)
+
+#define COLLECTOR_TOPOLOGY_SNAPSHOT_MS  30000   // Topology history interval
+#define COLLECTOR_TOPOLOGY_HISTORY      100     // Snapshots kept (MAX_TOPOLOGY_HISTORY)
+
+#define COLLECTOR_CLIENT_BACKLOG    (1 << 20)   // Console lines skipped for clients this far behind
+#define COLLECTOR_HTTP_REQUEST_MAX  16384       // Larger requests are rejected
+#define COLLECTOR_WS_FRAME_MAX      65536       // Largest client frame accepted
+
+#define COLLECTOR_LOG_BUFFER        65536   // Time-series log write buffer
+#define COLLECTOR_LOG_FLUSH_MS      1000    // Log flush interval
+
+#endif // COLLECTOR_CONFIG_H
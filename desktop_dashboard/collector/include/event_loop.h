@@ -0,0 +1,62 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         EVENT LOOP                                        ║
+// ║  Single-threaded epoll loop: serial sources, sockets and timers           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+class EventLoop {
+public:
+    typedef std::function<void(uint32_t events)> Handler;
+    typedef std::function<void()> TimerHandler;
+
+    EventLoop();
+    ~EventLoop();
+
+    /**
+     * Create the epoll instance
+     * @return false on failure (errno set)
+     */
+    bool init();
+
+    /**
+     * Watch fd for events (EPOLLIN, EPOLLOUT, ...)
+     */
+    bool add(int fd, uint32_t events, Handler handler);
+    bool modify(int fd, uint32_t events);
+    void remove(int fd);
+
+    /**
+     * Call handler every periodMs (timerfd)
+     * @return timer fd, or -1 on failure
+     */
+    int addTimer(unsigned periodMs, TimerHandler handler);
+
+    /**
+     * Dispatch events until stop() is called
+     */
+    void run();
+    void stop();
+
+    /**
+     * Monotonic milliseconds
+     */
+    static uint64_t monotonicMs();
+
+    /**
+     * Wall clock milliseconds since the Unix epoch
+     */
+    static uint64_t wallMs();
+
+private:
+    int epollFd;
+    bool running;
+    std::unordered_map<int, Handler> handlers;
+};
+
+#endif // EVENT_LOOP_H
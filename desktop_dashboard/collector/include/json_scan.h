@@ -0,0 +1,55 @@
+#ifndef JSON_SCAN_H
+#define JSON_SCAN_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         JSON LINE SCANNER                                 ║
+// ║  Zero-copy scan of the one-line objects printed by serial_json.cpp        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define JSON_SCAN_MAX_FIELDS    48      // node_data has 21 fields
+
+/**
+ * JsonField - One top-level member of the object
+ *
+ * key and value point into the scanned line. String values are given
+ * without their quotes (escapes left as is). Nested objects and arrays
+ * (load_report's "curve") are given whole, brackets included.
+ */
+struct JsonField {
+    std::string_view key;
+    std::string_view value;
+    bool quoted;
+};
+
+/**
+ * Scan the top-level members of a one-line JSON object
+ *
+ * Only the structure is checked (balanced brackets, closed strings), not
+ * number syntax: the firmware is the only producer.
+ *
+ * @param line - One serial line
+ * @param fields - Output array
+ * @param maxFields - Capacity of fields (extra members are skipped)
+ * @return number of fields, or -1 if line is not a JSON object
+ */
+int scanJsonObject(std::string_view line, JsonField* fields, int maxFields);
+
+/**
+ * Find a member by key
+ * @return field, or nullptr
+ */
+const JsonField* findJsonField(const JsonField* fields, int count, std::string_view key);
+
+bool jsonToLong(std::string_view value, long& out);
+bool jsonToDouble(std::string_view value, double& out);
+
+/**
+ * Append value as a JSON string (quoted, escaped) to out
+ */
+void appendJsonString(std::string& out, std::string_view value);
+
+#endif // JSON_SCAN_H
@@ -0,0 +1,181 @@
+#ifndef NODE_STATE_H
+#define NODE_STATE_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+
+#include "collector_config.h"
+#include "json_scan.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MESH STATE                                        ║
+// ║  In-memory per-node state, gateway status, mesh stats and topology        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define COLLECTOR_GATEWAY_NODE_ID   1       // serial_bridge.py GATEWAY_NODE_ID
+
+/**
+ * IngestResult - What a serial line did to the state
+ */
+enum IngestResult {
+    INGEST_NOT_JSON,        // Boot log, debug print, ...
+    INGEST_INVALID,         // Looked like JSON but did not scan
+    INGEST_NODE,            // node_data stored
+    INGEST_DUPLICATE,       // node_data already received via another gateway
+    INGEST_GATEWAY,         // gateway_status stored
+    INGEST_MESH_STATS,      // mesh_stats stored
+    INGEST_OTHER            // beacon, load_report, unknown types
+};
+
+/**
+ * NodeSample - Parsed node_data values (time-series log input)
+ */
+struct NodeSample {
+    uint64_t timeMs;        // Wall clock at the collector
+    uint8_t nodeId;
+    uint8_t sourceId;       // Which serial source delivered it
+    uint8_t hopDistance;
+    uint8_t satellites;
+    uint8_t neighborCount;
+    uint8_t sensorsOk;
+    uint16_t meshMsgId;
+    double temp;
+    double humidity;
+    long pressure;
+    long altitude;
+    double lat;
+    double lng;
+    double rssi;
+    double snr;
+};
+
+struct MeshStateStats {
+    uint64_t nodeLines;         // node_data lines stored
+    uint64_t duplicates;        // node_data dropped by multi-gateway dedupe
+    uint64_t invalid;           // '{' lines that did not scan
+    uint64_t otherJson;         // Other JSON types
+    uint64_t textLines;         // Non-JSON lines
+};
+
+/**
+ * NodeEntry - One node, indexed by node ID
+ *
+ * json is the node_data line as received with the collector's fields
+ * appended, so it is forwarded without re-serialising the sensor values.
+ * The appended keys come last and win over the line's own "online".
+ */
+struct NodeEntry {
+    bool present;
+    uint64_t version;           // MeshState version when json last changed
+    std::string line;           // node_data line without its closing '}'
+    std::string json;           // line + lastUpdate/online/messageCount + '}'
+    std::string topologyBody;   // Topology node object without online/lastSeen and '}'
+    uint64_t lastSeenWallMs;
+    uint64_t lastSeenMonoMs;
+    uint32_t messageCount;
+    bool online;
+    uint8_t parentNode;
+    // Recent reports for multi-gateway dedupe (ring)
+    uint16_t recentMsgId[COLLECTOR_DEDUPE_DEPTH];
+    uint8_t recentSource[COLLECTOR_DEDUPE_DEPTH];
+    uint64_t recentMonoMs[COLLECTOR_DEDUPE_DEPTH];
+    uint8_t recentNext;
+    double rssi;
+};
+
+/**
+ * MeshState - Everything the dashboard shows
+ *
+ * Every change bumps a global version and stamps the changed item with it,
+ * so a client that has seen version V only needs items newer than V.
+ */
+class MeshState {
+public:
+    MeshState();
+
+    /**
+     * Apply one serial line
+     * @param line - Line without '\r\n'
+     * @param sourceId - Serial source it came from
+     * @param wallMs - Wall clock now
+     * @param monoMs - Monotonic clock now
+     * @param sample - Filled when the result is INGEST_NODE
+     */
+    IngestResult ingest(std::string_view line, uint8_t sourceId,
+                        uint64_t wallMs, uint64_t monoMs, NodeSample& sample);
+
+    /**
+     * Mark nodes offline / back online (serial_bridge.py check_offline_nodes)
+     * @return number of nodes whose state changed
+     */
+    int checkOffline(uint64_t monoMs);
+
+    /**
+     * Save a topology history entry if the topology changed since the last one
+     */
+    void snapshotTopology(uint64_t wallMs);
+
+    /**
+     * Append "id":{...} members of nodes changed after since
+     * @return number of nodes appended
+     */
+    int appendNodesSince(std::string& out, uint64_t since) const;
+
+    /**
+     * Cached topology object {"nodes":[...],"edges":[...],"historyCount":N}
+     */
+    const std::string& topologyJson();
+
+    /**
+     * Append the topology history as a JSON array (oldest first)
+     */
+    void appendTopologyHistory(std::string& out) const;
+
+    const std::string& gatewayJson() const { return gateway; }
+    const std::string& meshStatsJson() const { return meshStats; }
+
+    uint64_t version() const { return currentVersion; }
+    uint64_t gatewayVersion() const { return gatewayVer; }
+    uint64_t meshStatsVersion() const { return meshStatsVer; }
+    uint64_t topologyVersion() const { return topologyVer; }
+    int nodeCount() const { return presentCount; }
+    const MeshStateStats& stats() const { return stateStats; }
+
+private:
+    void ingestNode(const JsonField* fields, int count, std::string_view line,
+                    uint64_t wallMs, uint64_t monoMs, NodeSample& sample, IngestResult& result);
+    void rebuildNodeJson(NodeEntry& node);
+    void appendTopologyNode(std::string& out, const NodeEntry& node) const;
+
+    NodeEntry nodes[COLLECTOR_MAX_NODE_ID + 1];
+    int presentCount;
+    uint64_t currentVersion;
+
+    std::string gateway;        // "{}" until the first gateway_status
+    std::string meshStats;
+    uint64_t gatewayVer;
+    uint64_t meshStatsVer;
+
+    uint64_t topologyVer;       // Bumped by node changes
+    uint64_t topologyBuiltVer;
+    uint64_t topologySnapshotVer;
+    size_t topologyBuiltHistory;
+    std::string topologyCache;
+    std::deque<std::string> topologyHistory;
+
+    MeshStateStats stateStats;
+};
+
+/**
+ * Append seconds since the epoch with millisecond precision ("1718000000.123")
+ */
+void appendEpochSeconds(std::string& out, uint64_t wallMs);
+
+/**
+ * Append an ISO-8601 local timestamp ("2024-06-10T12:00:00.123000")
+ */
+void appendIsoTime(std::string& out, uint64_t wallMs);
+
+#endif // NODE_STATE_H
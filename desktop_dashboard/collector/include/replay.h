@@ -0,0 +1,98 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RECORDING REPLAY                                  ║
+// ║  Feeds a recorded serial stream back through pipes at N× speed            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+// Recording format (written by --record, one line per serial line):
+//   <wall clock ms> <source id> <line as received>
+
+#define REPLAY_BATCH_BYTES  32768   // Pipe write size at full speed
+
+struct ReplayStats {
+    uint64_t lines;
+    uint64_t bytes;
+    uint64_t recordedMs;        // Time span covered by the recording
+    uint64_t elapsedMs;         // Wall time the replay took
+    uint64_t lateMs;            // Worst lag behind the paced schedule
+};
+
+/**
+ * Replayer - Writes a recording into one pipe per source on its own thread
+ *
+ * Lines are released when their recorded time, divided by speed, has
+ * passed. Speed 0 writes as fast as the collector reads.
+ */
+class Replayer {
+public:
+    Replayer();
+    ~Replayer();
+
+    /**
+     * Load the recording and create sourceCount pipes
+     * @return false if the file cannot be read or is empty
+     */
+    bool load(const std::string& path, unsigned sourceCount);
+
+    /**
+     * Read end of the pipe for source index (give to Collector::addStream)
+     */
+    int readFd(unsigned source) const { return pipes[source].readFd; }
+    unsigned sourceCount() const { return (unsigned)pipes.size(); }
+
+    void start(double speed);
+
+    /**
+     * Ask the thread to finish early (replay interrupted)
+     */
+    void stop() { stopping = true; }
+    void join();
+
+    const ReplayStats& stats() const { return replayStats; }
+
+private:
+    struct Pipe {
+        int readFd = -1;
+        int writeFd = -1;
+        std::string pending;
+    };
+
+    struct Entry {
+        uint64_t timeMs;        // Relative to the first line
+        uint32_t source;
+        uint32_t offset;        // Into text
+        uint32_t length;        // Including '\n'
+    };
+
+    void run(double speed);
+    void flushPipe(Pipe& pipe);
+
+    std::string text;           // All lines, '\n' terminated
+    std::vector<Entry> entries;
+    std::vector<Pipe> pipes;
+    std::thread worker;
+    std::atomic<bool> stopping;
+    ReplayStats replayStats;
+};
+
+/**
+ * Write a synthetic recording in the serial_json.cpp line format
+ *
+ * Every node reports once per reportSec and is heard by each gateway
+ * (so gateways > 1 exercises dedupe). Each gateway also prints
+ * gateway_status, mesh_stats, beacon lines and textPerSec debug lines.
+ *
+ * @return false if the file cannot be written
+ */
+bool generateRecording(const std::string& path, unsigned nodes, unsigned gateways,
+                       unsigned minutes, unsigned reportSec, unsigned textPerSec);
+
+#endif // REPLAY_H
@@ -0,0 +1,72 @@
+#ifndef SERIAL_SOURCE_H
+#define SERIAL_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SERIAL SOURCE                                     ║
+// ║  One gateway UART (or a pipe replaying a recording)                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct SourceStats {
+    uint64_t bytes;         // Bytes read
+    uint64_t lines;         // Complete lines delivered
+    uint64_t oversized;     // Lines dropped (longer than COLLECTOR_LINE_MAX)
+};
+
+/**
+ * SerialSource - Non-blocking line reader
+ *
+ * Bytes are read straight into one buffer and lines are handed out as
+ * string_views into it (no copy per line). A partial line at the end of a
+ * read is moved to the front of the buffer for the next read.
+ */
+class SerialSource {
+public:
+    typedef std::function<void(std::string_view line)> LineHandler;
+
+    SerialSource(uint8_t id, const std::string& name);
+    ~SerialSource();
+
+    /**
+     * Open a tty in raw mode at baud (non-blocking)
+     */
+    bool openTty(const std::string& path, unsigned baud);
+
+    /**
+     * Use an already open fd (pipe, file, stdin) - made non-blocking
+     */
+    bool openFd(int fd);
+
+    /**
+     * Read everything available and deliver complete lines ('\r' stripped)
+     * @return false on EOF or error (source should be closed)
+     */
+    bool readLines(const LineHandler& handler);
+
+    /**
+     * Write a command line to the gateway (blocking, short)
+     */
+    bool writeLine(const std::string& line);
+
+    int fd() const { return fileFd; }
+    uint8_t id() const { return sourceId; }
+    const std::string& name() const { return sourceName; }
+    const SourceStats& stats() const { return sourceStats; }
+
+private:
+    uint8_t sourceId;
+    std::string sourceName;
+    int fileFd;
+    std::vector<char> buffer;
+    size_t used;            // Bytes of the partial line kept from the last read
+    bool skipping;          // Inside an oversized line, drop until '\n'
+    SourceStats sourceStats;
+};
+
+#endif // SERIAL_SOURCE_H
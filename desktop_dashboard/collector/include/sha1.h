@@ -0,0 +1,24 @@
+#ifndef SHA1_H
+#define SHA1_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SHA-1 / BASE64                                    ║
+// ║  Only used for the WebSocket handshake (RFC 6455 Sec-WebSocket-Accept)    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define SHA1_DIGEST_SIZE    20
+
+void sha1(const void* data, size_t length, uint8_t digest[SHA1_DIGEST_SIZE]);
+
+std::string base64Encode(const uint8_t* data, size_t length);
+
+/**
+ * Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key
+ */
+std::string websocketAcceptKey(const std::string& clientKey);
+
+#endif // SHA1_H
@@ -0,0 +1,97 @@
+#ifndef TS_LOG_H
+#define TS_LOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "node_state.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         TIME-SERIES LOG                                   ║
+// ║  Append-only binary log of node_data samples, one file per day            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define TS_LOG_MAGIC        "MESHTSL1"
+#define TS_LOG_HEADER_SIZE  16          // Magic + record size + reserved
+
+#define TS_FLAG_SENSORS_OK  0x01
+
+/**
+ * TsRecord - One node_data sample on disk (little-endian, 40 bytes)
+ *
+ * Values are scaled to integers so a day of 1000 nodes reporting every
+ * minute is about 57 MB.
+ */
+struct __attribute__((packed)) TsRecord {
+    uint64_t timeMs;        // Wall clock at the collector (Unix ms)
+    uint8_t nodeId;
+    uint8_t sourceId;
+    uint8_t hopDistance;
+    uint8_t satellites;
+    int16_t tempX10;        // 0.1 °F
+    uint16_t humidityX10;   // 0.1 %
+    uint32_t pressure;      // Pa
+    int16_t altitude;       // m
+    int32_t latE6;          // Degrees × 1e6
+    int32_t lngE6;
+    int16_t rssi;           // dBm
+    int16_t snrX10;         // 0.1 dB
+    uint8_t neighborCount;
+    uint8_t flags;          // TS_FLAG_*
+    uint16_t meshMsgId;
+    uint8_t reserved[2];
+};
+
+static_assert(sizeof(TsRecord) == 40, "TsRecord layout changed");
+
+/**
+ * TimeSeriesLog - Buffered writer for mesh-YYYYMMDD.tsl files
+ */
+class TimeSeriesLog {
+public:
+    TimeSeriesLog();
+    ~TimeSeriesLog();
+
+    /**
+     * Log into directory (created if missing)
+     * @return false if the directory cannot be used
+     */
+    bool open(const std::string& directory);
+
+    /**
+     * Buffer one sample (flushed when the buffer fills or by flush())
+     */
+    void append(const NodeSample& sample);
+
+    /**
+     * Write buffered records to the current file
+     */
+    void flush();
+
+    void close();
+
+    bool isOpen() const { return !directory.empty(); }
+    uint64_t recordsWritten() const { return written; }
+    uint64_t writeErrors() const { return errors; }
+
+private:
+    bool openDay(uint64_t timeMs);
+
+    std::string directory;
+    int fileFd;
+    int fileDay;                // YYYYMMDD of the open file
+    std::vector<uint8_t> buffer;
+    size_t used;
+    uint64_t written;
+    uint64_t errors;
+};
+
+/**
+ * Print a log file as CSV
+ * @return false if the file is not a time-series log
+ */
+bool dumpTimeSeriesLog(const std::string& path, FILE* out);
+
+#endif // TS_LOG_H
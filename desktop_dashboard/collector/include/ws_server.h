@@ -0,0 +1,121 @@
+#ifndef WS_SERVER_H
+#define WS_SERVER_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "event_loop.h"
+#include "node_state.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HTTP / WEBSOCKET SERVER                           ║
+// ║  Serves dashboard.html + REST API and pushes per-client diffs             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct WebServerStats {
+    uint32_t clients;           // Open WebSocket clients
+    uint64_t httpRequests;
+    uint64_t wsMessages;        // Frames queued to clients
+    uint64_t bytesSent;
+    uint64_t updatesBuilt;      // Update messages serialised (shared between clients)
+    uint64_t consoleLines;      // Console lines queued
+    uint64_t consoleDropped;    // Console lines skipped for slow clients
+};
+
+/**
+ * WebServer - Non-blocking HTTP/1.1 + WebSocket server on the event loop
+ *
+ * Both listening ports accept both protocols, so the dashboard works with
+ * the serial_bridge.py port layout (HTTP 8080, WebSocket 8081).
+ *
+ * Instead of broadcasting the full state per serial line, each client
+ * remembers the state version it was last sent. Once per tick it gets one
+ * "update" with "partial":true holding only nodes (and gateway, mesh stats,
+ * topology) newer than that version. Clients at the same version share one
+ * serialised message.
+ */
+class WebServer {
+public:
+    /**
+     * Run a gateway command line ("SETTIME 12:00:00")
+     * @return empty string on success, error text otherwise
+     */
+    typedef std::function<std::string(const std::string& line)> CommandHandler;
+
+    /**
+     * Append extra JSON (an object) for /api/collector
+     */
+    typedef std::function<void(std::string& out)> StatsHandler;
+
+    WebServer(EventLoop& loop, MeshState& state);
+    ~WebServer();
+
+    /**
+     * Listen on port (all interfaces, 0 = any free port)
+     * @return bound port, or -1 on failure
+     */
+    int listen(uint16_t port);
+
+    void setStaticDir(const std::string& dir) { staticDir = dir; }
+    void setCommandHandler(CommandHandler handler) { commandHandler = handler; }
+    void setStatsHandler(StatsHandler handler) { statsHandler = handler; }
+
+    /**
+     * Queue a raw serial line for the dashboard console (sent on the next tick)
+     */
+    void queueConsoleLine(std::string_view line, uint64_t wallMs);
+
+    /**
+     * Send console lines and state diffs to all WebSocket clients
+     */
+    void tick();
+
+    const WebServerStats& stats() const { return serverStats; }
+
+private:
+    struct Connection {
+        int fd;
+        bool websocket;
+        bool closing;           // Close once out is drained
+        bool dead;              // Close at the end of the current event
+        bool writeWatch;        // EPOLLOUT registered
+        std::string in;
+        std::string out;        // Bytes the socket did not take yet
+        uint64_t sentVersion;   // MeshState version of the last update
+    };
+
+    void onAccept(int listenFd);
+    void onEvent(int fd, uint32_t events);
+    void closeConnection(int fd);
+
+    void handleHttp(Connection& conn);
+    void handleWebSocketData(Connection& conn);
+    void handleClientMessage(Connection& conn, std::string_view message);
+    bool upgradeWebSocket(Connection& conn, const std::string& key);
+
+    void sendHttp(Connection& conn, int status, const char* contentType, const std::string& body);
+    void sendFrame(Connection& conn, uint8_t opcode, std::string_view payload);
+    void sendBytes(Connection& conn, std::string_view data);
+    void flushOut(Connection& conn);
+
+    void buildState(std::string& out, const char* type, uint64_t since);
+    bool readFile(const std::string& path, std::string& out);
+
+    EventLoop& loop;
+    MeshState& state;
+    std::unordered_map<int, Connection> connections;
+    std::vector<int> listeners;
+    std::string staticDir;
+    CommandHandler commandHandler;
+    StatsHandler statsHandler;
+
+    std::string consoleBatch;       // Console frames for the next tick
+    uint32_t consoleBatchLines;
+    WebServerStats serverStats;
+};
+
+#endif // WS_SERVER_H
@@ -0,0 +1,336 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         COLLECTOR BENCHMARK                               ║
+// ║  Replays a recorded serial stream through the full ingest/fan-out path    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   collector_bench [--recording FILE] [--speed 100] [--clients 4] ...
+//
+// Without --recording a synthetic recording is generated first. Each run
+// replays it through pipes into a Collector (parser, state, time-series
+// log, WebSocket fan-out) with loopback WebSocket clients attached, and
+// reports throughput and the collector thread's CPU time.
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "collector.h"
+#include "collector_config.h"
+#include "replay.h"
+
+struct BenchOptions {
+    std::string recording;
+    std::string logDir;
+    unsigned nodes;
+    unsigned gateways;
+    unsigned minutes;
+    unsigned reportSec;
+    unsigned textPerSec;
+    unsigned clients;
+    double speed;
+};
+
+struct ClientStats {
+    uint64_t bytes;
+    uint64_t frames;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOOPBACK WEBSOCKET CLIENTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int connectWebSocket(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    const char* request =
+        "GET / HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n\r\n";
+    if (send(fd, request, strlen(request), MSG_NOSIGNAL) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Read and count server frames until stop is set and the sockets are idle
+ */
+static void drainClients(std::vector<int> fds, std::atomic<bool>& stop, ClientStats& stats) {
+    std::vector<pollfd> polls(fds.size());
+    std::vector<std::string> buffers(fds.size());
+    std::vector<bool> upgraded(fds.size(), false);
+    for (size_t i = 0; i < fds.size(); i++) {
+        polls[i].fd = fds[i];
+        polls[i].events = POLLIN;
+    }
+
+    char chunk[65536];
+    while (true) {
+        int ready = poll(polls.data(), polls.size(), 50);
+        if (ready <= 0) {
+            if (stop) break;
+            continue;
+        }
+
+        for (size_t i = 0; i < polls.size(); i++) {
+            if (!(polls[i].revents & (POLLIN | POLLHUP))) continue;
+            ssize_t n = recv(polls[i].fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                polls[i].fd = -1;
+                continue;
+            }
+            stats.bytes += n;
+
+            // Count frames: skip the 101 response, then walk frame headers
+            std::string& buffer = buffers[i];
+            buffer.append(chunk, n);
+            size_t offset = 0;
+            if (!upgraded[i]) {
+                size_t end = buffer.find("\r\n\r\n");
+                if (end == std::string::npos) continue;
+                offset = end + 4;
+                upgraded[i] = true;
+            }
+            while (buffer.size() - offset >= 2) {
+                const uint8_t* bytes = (const uint8_t*)buffer.data() + offset;
+                uint64_t length = bytes[1] & 0x7F;
+                size_t header = 2;
+                if (length == 126) {
+                    if (buffer.size() - offset < 4) break;
+                    length = ((uint64_t)bytes[2] << 8) | bytes[3];
+                    header = 4;
+                } else if (length == 127) {
+                    if (buffer.size() - offset < 10) break;
+                    length = 0;
+                    for (int b = 0; b < 8; b++) length = (length << 8) | bytes[2 + b];
+                    header = 10;
+                }
+                if (buffer.size() - offset < header + length) break;
+                offset += header + length;
+                stats.frames++;
+            }
+            buffer.erase(0, offset);
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ONE RUN
+// ═══════════════════════════════════════════════════════════════════════════
+
+static double threadCpuSeconds() {
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+static bool runOnce(const BenchOptions& opts, double speed) {
+    Replayer replayer;
+    if (!replayer.load(opts.recording, opts.gateways)) {
+        fprintf(stderr, "%s: cannot load recording\n", opts.recording.c_str());
+        return false;
+    }
+
+    CollectorOptions options;
+    options.httpPort = -1;
+    options.wsPort = 0;
+    options.logDir = opts.logDir;
+    options.exitOnEof = true;
+    options.verbose = false;
+
+    Collector collector;
+    if (!collector.init(options)) return false;
+    for (unsigned i = 0; i < replayer.sourceCount(); i++) {
+        collector.addStream(replayer.readFd(i), "replay#" + std::to_string(i));
+    }
+
+    // Clients connect before the replay starts so they see every update
+    std::vector<int> clientFds;
+    for (unsigned i = 0; i < opts.clients; i++) {
+        int fd = connectWebSocket(collector.wsPort());
+        if (fd < 0) {
+            perror("connect");
+            return false;
+        }
+        clientFds.push_back(fd);
+    }
+
+    // Let the loop accept and upgrade them
+    EventLoop& loop = collector.eventLoop();
+    int waitTimer = loop.addTimer(10, [&]() {
+        if (collector.webServer().stats().clients >= opts.clients) loop.stop();
+    });
+    loop.run();
+    loop.remove(waitTimer);
+    close(waitTimer);
+
+    std::atomic<bool> clientsStop(false);
+    ClientStats clientStats = {};
+    std::thread clientThread(drainClients, clientFds, std::ref(clientsStop), std::ref(clientStats));
+
+    double cpuStart = threadCpuSeconds();
+    uint64_t startMs = EventLoop::monotonicMs();
+    replayer.start(speed);
+    collector.run();
+    collector.finish();
+    uint64_t elapsedMs = EventLoop::monotonicMs() - startMs;
+    double cpu = threadCpuSeconds() - cpuStart;
+    replayer.join();
+
+    clientsStop = true;
+    clientThread.join();
+    for (int fd : clientFds) close(fd);
+
+    const CollectorStats& stats = collector.stats();
+    const MeshStateStats& state = collector.meshState().stats();
+    const WebServerStats& web = collector.webServer().stats();
+    const ReplayStats& replay = replayer.stats();
+    double seconds = elapsedMs / 1000.0;
+
+    char speedText[32];
+    if (speed > 0) {
+        snprintf(speedText, sizeof(speedText), "%gx", speed);
+    } else {
+        snprintf(speedText, sizeof(speedText), "max");
+    }
+
+    printf("\n─── Replay %s ───\n", speedText);
+    printf("  Recording:        %.1f min, %llu lines, %.1f MB\n",
+           replay.recordedMs / 60000.0, (unsigned long long)replay.lines, replay.bytes / 1e6);
+    printf("  Wall time:        %.2f s (achieved %.0fx real time, worst lag %llu ms)\n",
+           seconds, seconds > 0 ? replay.recordedMs / 1000.0 / seconds : 0.0,
+           (unsigned long long)replay.lateMs);
+    printf("  Throughput:       %.0f lines/s, %.2f MB/s\n",
+           seconds > 0 ? stats.lines / seconds : 0.0, seconds > 0 ? stats.bytes / 1e6 / seconds : 0.0);
+    printf("  Collector CPU:    %.2f s (%.1f%% of one core, %.2f us/line)\n",
+           cpu, seconds > 0 ? cpu * 100.0 / seconds : 0.0,
+           stats.lines > 0 ? cpu * 1e6 / stats.lines : 0.0);
+    printf("  State:            %d nodes, %llu reports, %llu duplicates dropped, %llu invalid\n",
+           collector.meshState().nodeCount(), (unsigned long long)state.nodeLines,
+           (unsigned long long)state.duplicates, (unsigned long long)state.invalid);
+    printf("  Log:              %llu records\n",
+           (unsigned long long)collector.timeSeriesLog().recordsWritten());
+    printf("  WebSocket:        %u clients, %llu updates built, %llu frames, %.1f MB sent\n",
+           opts.clients, (unsigned long long)web.updatesBuilt, (unsigned long long)web.wsMessages,
+           web.bytesSent / 1e6);
+    printf("  Clients received: %llu frames, %.1f MB (console dropped %llu)\n",
+           (unsigned long long)clientStats.frames, clientStats.bytes / 1e6,
+           (unsigned long long)web.consoleDropped);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n\n", program);
+    printf("  --recording FILE    Replay FILE (default: generate bench.rec)\n");
+    printf("  --nodes N           Synthetic nodes (default 60)\n");
+    printf("  --gateways N        Gateways hearing every node (default 2)\n");
+    printf("  --minutes N         Synthetic recording length (default 10)\n");
+    printf("  --report-sec N      Node report interval (default 10)\n");
+    printf("  --text N            Debug lines per second per gateway (default 50)\n");
+    printf("  --clients N         Loopback WebSocket clients (default 4)\n");
+    printf("  --speed X           Paced replay speed (default 100)\n");
+    printf("  --log-dir DIR       Time-series log directory (default bench-logs)\n");
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    opts.nodes = 60;
+    opts.gateways = 2;
+    opts.minutes = 10;
+    opts.reportSec = 10;
+    opts.textPerSec = 50;
+    opts.clients = 4;
+    opts.speed = 100;
+    opts.logDir = "bench-logs";
+    bool generate = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--recording" && hasValue) {
+            opts.recording = argv[++i];
+            generate = false;
+        } else if (arg == "--nodes" && hasValue) {
+            opts.nodes = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--gateways" && hasValue) {
+            opts.gateways = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--minutes" && hasValue) {
+            opts.minutes = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--report-sec" && hasValue) {
+            opts.reportSec = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--text" && hasValue) {
+            opts.textPerSec = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--clients" && hasValue) {
+            opts.clients = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--speed" && hasValue) {
+            opts.speed = atof(argv[++i]);
+        } else if (arg == "--log-dir" && hasValue) {
+            opts.logDir = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return (arg == "-h" || arg == "--help") ? 0 : 1;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    if (generate) {
+        opts.recording = "bench.rec";
+        printf("Generating %s: %u nodes, %u gateways, %u min, report every %u s, %u text lines/s\n",
+               opts.recording.c_str(), opts.nodes, opts.gateways, opts.minutes,
+               opts.reportSec, opts.textPerSec);
+        if (!generateRecording(opts.recording, opts.nodes, opts.gateways, opts.minutes,
+                               opts.reportSec, opts.textPerSec)) {
+            perror(opts.recording.c_str());
+            return 1;
+        }
+    } else {
+        opts.gateways = 0;
+        FILE* file = fopen(opts.recording.c_str(), "r");
+        char line[COLLECTOR_LINE_MAX + 64];
+        unsigned long long timeMs;
+        unsigned source;
+        while (file != nullptr && fgets(line, sizeof(line), file) != nullptr) {
+            if (sscanf(line, "%llu %u", &timeMs, &source) == 2 && source + 1 > opts.gateways) {
+                opts.gateways = source + 1;
+            }
+        }
+        if (file != nullptr) fclose(file);
+        if (opts.gateways == 0) opts.gateways = 1;
+    }
+
+    if (!runOnce(opts, opts.speed)) return 1;
+    if (!runOnce(opts, 0)) return 1;
+    return 0;
+}
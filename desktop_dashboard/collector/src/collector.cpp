@@ -0,0 +1,239 @@
+#include "collector.h"
+#include "collector_config.h"
+
+#include <cstdio>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+Collector::Collector()
+    : nextSourceId(0), recordFd(-1), boundHttpPort(-1), boundWsPort(-1), collectorStats() {}
+
+Collector::~Collector() {
+    finish();
+    if (recordFd >= 0) close(recordFd);
+    // Sources and web server unregister from the loop before it closes
+    for (auto& source : sources) loop.remove(source->fd());
+    sources.clear();
+    web.reset();
+    for (int fd : timers) {
+        if (fd < 0) continue;
+        loop.remove(fd);
+        close(fd);
+    }
+}
+
+bool Collector::init(const CollectorOptions& opts) {
+    options = opts;
+
+    if (!loop.init()) {
+        fprintf(stderr, "epoll_create1: %s\n", strerror(errno));
+        return false;
+    }
+
+    web.reset(new WebServer(loop, state));
+    web->setStaticDir(options.staticDir);
+    web->setCommandHandler([this](const std::string& line) { return sendCommand(line); });
+    web->setStatsHandler([this](std::string& out) { appendStats(out); });
+
+    if (options.httpPort >= 0) {
+        boundHttpPort = web->listen((uint16_t)options.httpPort);
+        if (boundHttpPort < 0) {
+            fprintf(stderr, "HTTP port %d: %s\n", options.httpPort, strerror(errno));
+            return false;
+        }
+    }
+    if (options.wsPort >= 0) {
+        boundWsPort = web->listen((uint16_t)options.wsPort);
+        if (boundWsPort < 0) {
+            fprintf(stderr, "WebSocket port %d: %s\n", options.wsPort, strerror(errno));
+            return false;
+        }
+    }
+
+    if (!options.logDir.empty() && !log.open(options.logDir)) {
+        fprintf(stderr, "Log directory %s: %s\n", options.logDir.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (!options.recordPath.empty()) {
+        recordFd = open(options.recordPath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (recordFd < 0) {
+            fprintf(stderr, "Recording %s: %s\n", options.recordPath.c_str(), strerror(errno));
+            return false;
+        }
+    }
+
+    // ─── Timers ───
+    timers.push_back(loop.addTimer(COLLECTOR_TICK_MS, [this]() { web->tick(); }));
+    timers.push_back(loop.addTimer(COLLECTOR_OFFLINE_CHECK_MS, [this]() {
+        state.checkOffline(EventLoop::monotonicMs());
+    }));
+    timers.push_back(loop.addTimer(COLLECTOR_LOG_FLUSH_MS, [this]() {
+        log.flush();
+        if (recordFd >= 0) flushRecording();
+    }));
+    timers.push_back(loop.addTimer(COLLECTOR_TOPOLOGY_SNAPSHOT_MS, [this]() {
+        state.snapshotTopology(EventLoop::wallMs());
+    }));
+
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SOURCES
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool Collector::addSource(std::unique_ptr<SerialSource> source, bool commandTarget) {
+    SerialSource* raw = source.get();
+    if (!loop.add(raw->fd(), EPOLLIN, [this, raw](uint32_t) { onReadable(raw); })) {
+        return false;
+    }
+    if (commandTarget) commandTargets.push_back(raw);
+    sources.push_back(std::move(source));
+    collectorStats.sourcesOpen++;
+
+    if (options.verbose) printf("[SOURCE %u] %s\n", raw->id(), raw->name().c_str());
+    return true;
+}
+
+bool Collector::addSerialPort(const std::string& path, unsigned baud) {
+    if (sources.size() >= COLLECTOR_MAX_SOURCES) {
+        errno = EMFILE;
+        return false;
+    }
+    std::unique_ptr<SerialSource> source(new SerialSource(nextSourceId, path));
+    if (!source->openTty(path, baud)) return false;
+    nextSourceId++;
+    return addSource(std::move(source), true);
+}
+
+bool Collector::addStream(int fd, const std::string& name) {
+    if (sources.size() >= COLLECTOR_MAX_SOURCES) {
+        errno = EMFILE;
+        return false;
+    }
+    std::unique_ptr<SerialSource> source(new SerialSource(nextSourceId, name));
+    if (!source->openFd(fd)) return false;
+    nextSourceId++;
+    return addSource(std::move(source), false);
+}
+
+void Collector::onReadable(SerialSource* source) {
+    // One clock read per batch of lines
+    uint64_t wallMs = EventLoop::wallMs();
+    uint64_t monoMs = EventLoop::monotonicMs();
+    uint64_t bytesBefore = source->stats().bytes;
+
+    bool open = source->readLines([&](std::string_view line) {
+        onLine(*source, line, wallMs, monoMs);
+    });
+    collectorStats.bytes += source->stats().bytes - bytesBefore;
+    if (open) return;
+
+    // EOF or error: drop the source
+    if (options.verbose) printf("[SOURCE %u] %s closed\n", source->id(), source->name().c_str());
+    loop.remove(source->fd());
+    for (size_t i = 0; i < commandTargets.size(); i++) {
+        if (commandTargets[i] == source) {
+            commandTargets.erase(commandTargets.begin() + i);
+            break;
+        }
+    }
+    collectorStats.sourcesOpen--;
+
+    if (options.exitOnEof && collectorStats.sourcesOpen == 0) loop.stop();
+}
+
+void Collector::onLine(SerialSource& source, std::string_view line, uint64_t wallMs, uint64_t monoMs) {
+    // serial_bridge.py skips empty lines
+    if (line.empty()) return;
+    collectorStats.lines++;
+
+    if (recordFd >= 0) {
+        char prefix[40];
+        int len = snprintf(prefix, sizeof(prefix), "%llu %u ", (unsigned long long)wallMs, source.id());
+        recordBuffer.append(prefix, len);
+        recordBuffer.append(line.data(), line.size());
+        recordBuffer += '\n';
+        collectorStats.recorded++;
+        if (recordBuffer.size() >= COLLECTOR_LOG_BUFFER) flushRecording();
+    }
+
+    // Every line goes to the console, JSON lines also update the state
+    web->queueConsoleLine(line, wallMs);
+
+    NodeSample sample;
+    if (state.ingest(line, source.id(), wallMs, monoMs, sample) == INGEST_NODE) {
+        log.append(sample);
+    }
+}
+
+void Collector::flushRecording() {
+    size_t offset = 0;
+    while (offset < recordBuffer.size()) {
+        ssize_t n = write(recordFd, recordBuffer.data() + offset, recordBuffer.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        offset += n;
+    }
+    recordBuffer.clear();
+}
+
+std::string Collector::sendCommand(const std::string& line) {
+    if (commandTargets.empty()) return "Serial port not connected";
+
+    // Every gateway gets the command (SETTIME keeps them in step)
+    for (SerialSource* target : commandTargets) {
+        if (!target->writeLine(line)) return strerror(errno);
+    }
+    if (options.verbose) printf("[COMMAND] %s\n", line.c_str());
+    return std::string();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONTROL
+// ═══════════════════════════════════════════════════════════════════════════
+
+void Collector::run() {
+    loop.run();
+}
+
+void Collector::stop() {
+    loop.stop();
+}
+
+void Collector::finish() {
+    if (web) web->tick();
+    log.flush();
+    if (recordFd >= 0) flushRecording();
+}
+
+void Collector::appendStats(std::string& out) {
+    char text[160];
+    int len = snprintf(text, sizeof(text),
+                       ",\"lines\":%llu,\"bytes\":%llu,\"logRecords\":%llu,\"logErrors\":%llu,\"sources\":[",
+                       (unsigned long long)collectorStats.lines, (unsigned long long)collectorStats.bytes,
+                       (unsigned long long)log.recordsWritten(), (unsigned long long)log.writeErrors());
+    out.append(text, len);
+
+    bool first = true;
+    for (const auto& source : sources) {
+        const SourceStats& stats = source->stats();
+        if (!first) out += ',';
+        out += "{\"id\":";
+        out += std::to_string(source->id());
+        out += ",\"name\":";
+        appendJsonString(out, source->name());
+        len = snprintf(text, sizeof(text), ",\"bytes\":%llu,\"lines\":%llu,\"oversized\":%llu}",
+                       (unsigned long long)stats.bytes, (unsigned long long)stats.lines,
+                       (unsigned long long)stats.oversized);
+        out.append(text, len);
+        first = false;
+    }
+    out += ']';
+}
@@ -0,0 +1,101 @@
+#include "event_loop.h"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EVENT_LOOP_MAX_EVENTS   64
+
+EventLoop::EventLoop() : epollFd(-1), running(false) {}
+
+EventLoop::~EventLoop() {
+    if (epollFd >= 0) close(epollFd);
+}
+
+bool EventLoop::init() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    return epollFd >= 0;
+}
+
+bool EventLoop::add(int fd, uint32_t events, Handler handler) {
+    epoll_event ev = {};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) return false;
+    handlers[fd] = handler;
+    return true;
+}
+
+bool EventLoop::modify(int fd, uint32_t events) {
+    epoll_event ev = {};
+    ev.events = events;
+    ev.data.fd = fd;
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+void EventLoop::remove(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    handlers.erase(fd);
+}
+
+int EventLoop::addTimer(unsigned periodMs, TimerHandler handler) {
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) return -1;
+
+    itimerspec spec = {};
+    spec.it_interval.tv_sec = periodMs / 1000;
+    spec.it_interval.tv_nsec = (long)(periodMs % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    timerfd_settime(fd, 0, &spec, nullptr);
+
+    bool ok = add(fd, EPOLLIN, [fd, handler](uint32_t) {
+        uint64_t expirations;
+        if (read(fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            handler();
+        }
+    });
+    if (!ok) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void EventLoop::run() {
+    epoll_event events[EVENT_LOOP_MAX_EVENTS];
+    running = true;
+
+    while (running) {
+        int count = epoll_wait(epollFd, events, EVENT_LOOP_MAX_EVENTS, 1000);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < count && running; i++) {
+            // Handler may remove fds (including its own): look it up each time
+            auto it = handlers.find(events[i].data.fd);
+            if (it == handlers.end()) continue;
+            Handler handler = it->second;
+            handler(events[i].events);
+        }
+    }
+}
+
+void EventLoop::stop() {
+    running = false;
+}
+
+uint64_t EventLoop::monotonicMs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
+
+uint64_t EventLoop::wallMs() {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
@@ -0,0 +1,143 @@
+#include "json_scan.h"
+
+#include <charconv>
+#include <cstdlib>
+
+static size_t skipSpace(std::string_view s, size_t i) {
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t')) i++;
+    return i;
+}
+
+/**
+ * Index just past the closing quote of the string starting at s[i] == '"'
+ * @return 0 if the string is not closed
+ */
+static size_t skipString(std::string_view s, size_t i) {
+    for (i++; i < s.size(); i++) {
+        if (s[i] == '\\') {
+            i++;
+        } else if (s[i] == '"') {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Index just past the value starting at s[i]
+ * @return 0 if the value is malformed
+ */
+static size_t skipValue(std::string_view s, size_t i) {
+    if (i >= s.size()) return 0;
+
+    if (s[i] == '"') return skipString(s, i);
+
+    if (s[i] == '{' || s[i] == '[') {
+        int depth = 0;
+        while (i < s.size()) {
+            char c = s[i];
+            if (c == '"') {
+                i = skipString(s, i);
+                if (i == 0) return 0;
+                continue;
+            }
+            if (c == '{' || c == '[') depth++;
+            if (c == '}' || c == ']') {
+                if (--depth == 0) return i + 1;
+            }
+            i++;
+        }
+        return 0;
+    }
+
+    // Number, true, false, null
+    size_t start = i;
+    while (i < s.size() && s[i] != ',' && s[i] != '}' && s[i] != ' ') i++;
+    return (i > start) ? i : 0;
+}
+
+int scanJsonObject(std::string_view line, JsonField* fields, int maxFields) {
+    size_t i = skipSpace(line, 0);
+    if (i >= line.size() || line[i] != '{') return -1;
+    i = skipSpace(line, i + 1);
+
+    int count = 0;
+    if (i < line.size() && line[i] == '}') return 0;
+
+    while (i < line.size()) {
+        // Key
+        if (line[i] != '"') return -1;
+        size_t keyEnd = skipString(line, i);
+        if (keyEnd == 0) return -1;
+        std::string_view key = line.substr(i + 1, keyEnd - i - 2);
+
+        i = skipSpace(line, keyEnd);
+        if (i >= line.size() || line[i] != ':') return -1;
+        i = skipSpace(line, i + 1);
+
+        // Value
+        size_t valueEnd = skipValue(line, i);
+        if (valueEnd == 0) return -1;
+        if (count < maxFields) {
+            JsonField& field = fields[count++];
+            field.key = key;
+            field.quoted = (line[i] == '"');
+            field.value = field.quoted ? line.substr(i + 1, valueEnd - i - 2)
+                                       : line.substr(i, valueEnd - i);
+        }
+
+        i = skipSpace(line, valueEnd);
+        if (i >= line.size()) return -1;
+        if (line[i] == '}') return count;
+        if (line[i] != ',') return -1;
+        i = skipSpace(line, i + 1);
+    }
+    return -1;
+}
+
+const JsonField* findJsonField(const JsonField* fields, int count, std::string_view key) {
+    for (int i = 0; i < count; i++) {
+        if (fields[i].key == key) return &fields[i];
+    }
+    return nullptr;
+}
+
+bool jsonToLong(std::string_view value, long& out) {
+    auto result = std::from_chars(value.data(), value.data() + value.size(), out);
+    return result.ec == std::errc() && result.ptr == value.data() + value.size();
+}
+
+bool jsonToDouble(std::string_view value, double& out) {
+    // from_chars(double) is missing from older libstdc++, strtod needs a terminator
+    char text[40];
+    if (value.empty() || value.size() >= sizeof(text)) return false;
+    value.copy(text, value.size());
+    text[value.size()] = '\0';
+
+    char* end;
+    out = strtod(text, &end);
+    return end == text + value.size();
+}
+
+void appendJsonString(std::string& out, std::string_view value) {
+    static const char HEX[] = "0123456789abcdef";
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    out += "\\u00";
+                    out += HEX[(c >> 4) & 0xF];
+                    out += HEX[c & 0xF];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
@@ -0,0 +1,189 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MESH COLLECTOR                                    ║
+// ║  Native replacement for serial_bridge.py (dashboard.html unchanged)       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   mesh_collector --port /dev/ttyUSB0 [--port /dev/ttyUSB1 ...]
+//   mesh_collector --replay capture.rec --speed 10
+//   mesh_collector --dump logs/mesh-20240610.tsl
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <errno.h>
+#include <signal.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+#include <vector>
+
+#include "collector.h"
+#include "collector_config.h"
+#include "replay.h"
+#include "ts_log.h"
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n\n", program);
+    printf("Sources:\n");
+    printf("  --port DEV          Gateway serial port (repeat for more gateways)\n");
+    printf("  --baud N            Baud rate (default %d)\n", COLLECTOR_DEFAULT_BAUD);
+    printf("  --replay FILE       Replay a recording instead of serial ports\n");
+    printf("  --speed X           Replay speed factor (default 1, 0 = as fast as possible)\n");
+    printf("  --sources N         Replay pipes (default: one per recorded source, max %d)\n",
+           COLLECTOR_MAX_SOURCES);
+    printf("\nServers:\n");
+    printf("  --http-port N       Dashboard/API port (default %d)\n", COLLECTOR_HTTP_PORT);
+    printf("  --ws-port N         WebSocket port (default %d)\n", COLLECTOR_WS_PORT);
+    printf("  --static DIR        Directory with dashboard.html (default ..)\n");
+    printf("\nStorage:\n");
+    printf("  --log-dir DIR       Write node_data samples to DIR/mesh-YYYYMMDD.tsl\n");
+    printf("  --record FILE       Append every serial line to FILE (replayable)\n");
+    printf("  --dump FILE         Print a .tsl log as CSV and exit\n");
+    printf("\n  -v, --verbose       Print source and command events\n");
+}
+
+/**
+ * Highest source id in a recording + 1
+ */
+static unsigned recordedSources(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == nullptr) return 1;
+
+    unsigned long long timeMs;
+    unsigned source, highest = 0;
+    char line[COLLECTOR_LINE_MAX + 64];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (sscanf(line, "%llu %u", &timeMs, &source) == 2 && source > highest) highest = source;
+    }
+    fclose(file);
+    return (highest + 1 < COLLECTOR_MAX_SOURCES) ? highest + 1 : COLLECTOR_MAX_SOURCES;
+}
+
+int main(int argc, char** argv) {
+    CollectorOptions options;
+    options.httpPort = COLLECTOR_HTTP_PORT;
+    options.wsPort = COLLECTOR_WS_PORT;
+    options.staticDir = "..";
+    options.exitOnEof = false;
+    options.verbose = false;
+
+    std::vector<std::string> ports;
+    unsigned baud = COLLECTOR_DEFAULT_BAUD;
+    std::string replayPath;
+    double speed = 1.0;
+    unsigned replaySources = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--port" && hasValue) {
+            ports.push_back(argv[++i]);
+        } else if (arg == "--baud" && hasValue) {
+            baud = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        } else if (arg == "--speed" && hasValue) {
+            speed = atof(argv[++i]);
+        } else if (arg == "--sources" && hasValue) {
+            replaySources = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--http-port" && hasValue) {
+            options.httpPort = atoi(argv[++i]);
+        } else if (arg == "--ws-port" && hasValue) {
+            options.wsPort = atoi(argv[++i]);
+        } else if (arg == "--static" && hasValue) {
+            options.staticDir = argv[++i];
+        } else if (arg == "--log-dir" && hasValue) {
+            options.logDir = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--dump" && hasValue) {
+            if (!dumpTimeSeriesLog(argv[++i], stdout)) {
+                fprintf(stderr, "%s: not a time-series log\n", argv[i]);
+                return 1;
+            }
+            return 0;
+        } else if (arg == "-v" || arg == "--verbose") {
+            options.verbose = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (ports.empty() && replayPath.empty()) {
+        fprintf(stderr, "No source: give --port DEV or --replay FILE\n\n");
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    // Declared first so it is destroyed last: the collector closes the pipe
+    // read ends, which unblocks the replay thread
+    Replayer replayer;
+    Collector collector;
+    if (!collector.init(options)) return 1;
+
+    for (const std::string& port : ports) {
+        if (!collector.addSerialPort(port, baud)) {
+            fprintf(stderr, "%s: %s\n", port.c_str(), strerror(errno));
+            return 1;
+        }
+    }
+
+    if (!replayPath.empty()) {
+        if (replaySources == 0) replaySources = recordedSources(replayPath);
+        if (!replayer.load(replayPath, replaySources)) {
+            fprintf(stderr, "%s: cannot load recording\n", replayPath.c_str());
+            return 1;
+        }
+        for (unsigned i = 0; i < replayer.sourceCount(); i++) {
+            collector.addStream(replayer.readFd(i), replayPath + "#" + std::to_string(i));
+        }
+    }
+
+    // Ctrl+C / SIGTERM stop the loop so logs are flushed
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    int signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    collector.eventLoop().add(signalFd, EPOLLIN, [&collector](uint32_t) { collector.stop(); });
+
+    printf("\n════════════════════════════════════════════════════════════\n");
+    printf("  Mesh Collector\n");
+    printf("════════════════════════════════════════════════════════════\n");
+    printf("  Dashboard:  http://localhost:%d\n", collector.httpPort());
+    printf("  WebSocket:  ws://localhost:%d\n", collector.wsPort());
+    for (const std::string& port : ports) printf("  Serial:     %s @ %u\n", port.c_str(), baud);
+    if (!replayPath.empty()) {
+        printf("  Replay:     %s (%u sources, %gx)\n", replayPath.c_str(), replayer.sourceCount(), speed);
+    }
+    if (!options.logDir.empty()) printf("  Log:        %s\n", options.logDir.c_str());
+    if (!options.recordPath.empty()) printf("  Recording:  %s\n", options.recordPath.c_str());
+    printf("════════════════════════════════════════════════════════════\n\n");
+    fflush(stdout);
+
+    // Replay starts after the signal mask so its thread inherits it
+    if (!replayPath.empty()) replayer.start(speed);
+
+    collector.run();
+    collector.finish();
+    replayer.stop();
+
+    const CollectorStats& stats = collector.stats();
+    const MeshStateStats& state = collector.meshState().stats();
+    printf("\n[COLLECTOR] %llu lines, %llu node reports, %llu duplicates, %d nodes\n",
+           (unsigned long long)stats.lines, (unsigned long long)state.nodeLines,
+           (unsigned long long)state.duplicates, collector.meshState().nodeCount());
+
+    close(signalFd);
+    return 0;
+}
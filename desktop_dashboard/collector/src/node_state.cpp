@@ -0,0 +1,397 @@
+#include "node_state.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FORMATTING HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void appendEpochSeconds(std::string& out, uint64_t wallMs) {
+    char text[32];
+    int len = snprintf(text, sizeof(text), "%llu.%03u",
+                       (unsigned long long)(wallMs / 1000), (unsigned)(wallMs % 1000));
+    out.append(text, len);
+}
+
+void appendIsoTime(std::string& out, uint64_t wallMs) {
+    // Every console line carries a timestamp: only redo the date part per second
+    static time_t cachedSecond = -1;
+    static char cachedText[32];
+    static size_t cachedLength = 0;
+
+    time_t seconds = (time_t)(wallMs / 1000);
+    if (seconds != cachedSecond) {
+        tm local;
+        localtime_r(&seconds, &local);
+        cachedLength = strftime(cachedText, sizeof(cachedText), "%Y-%m-%dT%H:%M:%S", &local);
+        cachedSecond = seconds;
+    }
+
+    char millis[16];
+    int len = snprintf(millis, sizeof(millis), ".%03u000", (unsigned)(wallMs % 1000));
+    out.append(cachedText, cachedLength);
+    out.append(millis, len);
+}
+
+static void appendUnsigned(std::string& out, uint64_t value) {
+    char text[24];
+    int len = snprintf(text, sizeof(text), "%llu", (unsigned long long)value);
+    out.append(text, len);
+}
+
+/**
+ * Append a field's raw value text, or fallback if the field is missing
+ */
+static void appendRaw(std::string& out, const JsonField* field, const char* fallback) {
+    if (field == nullptr) {
+        out += fallback;
+    } else if (field->quoted) {
+        out += '"';
+        out.append(field->value.data(), field->value.size());
+        out += '"';
+    } else {
+        out.append(field->value.data(), field->value.size());
+    }
+}
+
+static long fieldLong(const JsonField* field, long fallback) {
+    long value;
+    if (field == nullptr || !jsonToLong(field->value, value)) return fallback;
+    return value;
+}
+
+static double fieldDouble(const JsonField* field, double fallback) {
+    double value;
+    if (field == nullptr || !jsonToDouble(field->value, value)) return fallback;
+    return value;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MESH STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+MeshState::MeshState()
+    : presentCount(0), currentVersion(0),
+      gateway("{}"), meshStats("{}"), gatewayVer(0), meshStatsVer(0),
+      topologyVer(0), topologyBuiltVer(0), topologySnapshotVer(0),
+      topologyBuiltHistory(0), stateStats() {
+    for (NodeEntry& node : nodes) {
+        node.present = false;
+        node.version = 0;
+        node.lastSeenWallMs = 0;
+        node.lastSeenMonoMs = 0;
+        node.messageCount = 0;
+        node.online = false;
+        node.parentNode = 0;
+        memset(node.recentMsgId, 0, sizeof(node.recentMsgId));
+        memset(node.recentSource, 0, sizeof(node.recentSource));
+        memset(node.recentMonoMs, 0, sizeof(node.recentMonoMs));
+        node.recentNext = 0;
+        node.rssi = -100;
+    }
+    // Force the first topologyJson() call to build
+    topologyBuiltHistory = (size_t)-1;
+}
+
+IngestResult MeshState::ingest(std::string_view line, uint8_t sourceId,
+                               uint64_t wallMs, uint64_t monoMs, NodeSample& sample) {
+    if (line.empty() || line[0] != '{') {
+        stateStats.textLines++;
+        return INGEST_NOT_JSON;
+    }
+
+    JsonField fields[JSON_SCAN_MAX_FIELDS];
+    int count = scanJsonObject(line, fields, JSON_SCAN_MAX_FIELDS);
+    if (count < 0 || line.back() != '}') {
+        stateStats.invalid++;
+        return INGEST_INVALID;
+    }
+
+    const JsonField* type = findJsonField(fields, count, "type");
+    std::string_view typeName = (type != nullptr) ? type->value : std::string_view();
+
+    if (typeName == "node_data") {
+        IngestResult result = INGEST_INVALID;
+        sample.sourceId = sourceId;
+        ingestNode(fields, count, line, wallMs, monoMs, sample, result);
+        return result;
+    }
+
+    if (typeName == "gateway_status") {
+        gateway.assign(line.data(), line.size());
+        gatewayVer = ++currentVersion;
+        stateStats.otherJson++;
+        return INGEST_GATEWAY;
+    }
+
+    if (typeName == "mesh_stats") {
+        meshStats.assign(line.data(), line.size());
+        meshStatsVer = ++currentVersion;
+        stateStats.otherJson++;
+        return INGEST_MESH_STATS;
+    }
+
+    stateStats.otherJson++;
+    return INGEST_OTHER;
+}
+
+void MeshState::ingestNode(const JsonField* fields, int count, std::string_view line,
+                           uint64_t wallMs, uint64_t monoMs, NodeSample& sample,
+                           IngestResult& result) {
+    long nodeId = fieldLong(findJsonField(fields, count, "nodeId"), 0);
+    if (nodeId <= 0 || nodeId > COLLECTOR_MAX_NODE_ID) {
+        stateStats.invalid++;
+        result = INGEST_INVALID;
+        return;
+    }
+
+    NodeEntry& node = nodes[nodeId];
+    const JsonField* msgIdField = findJsonField(fields, count, "meshMsgId");
+    uint16_t msgId = (uint16_t)fieldLong(msgIdField, 0);
+
+    // The same report heard by two gateways arrives on two sources, not
+    // necessarily in order: one gateway's UART can run a few reports ahead
+    if (node.present && msgId != 0) {
+        for (int i = 0; i < COLLECTOR_DEDUPE_DEPTH; i++) {
+            if (node.recentMsgId[i] == msgId && node.recentSource[i] != sample.sourceId &&
+                monoMs - node.recentMonoMs[i] < COLLECTOR_DUPLICATE_MS) {
+                stateStats.duplicates++;
+                result = INGEST_DUPLICATE;
+                return;
+            }
+        }
+    }
+
+    if (!node.present) {
+        node.present = true;
+        presentCount++;
+    }
+    node.recentMsgId[node.recentNext] = msgId;
+    node.recentSource[node.recentNext] = sample.sourceId;
+    node.recentMonoMs[node.recentNext] = monoMs;
+    node.recentNext = (node.recentNext + 1) % COLLECTOR_DEDUPE_DEPTH;
+    node.lastSeenWallMs = wallMs;
+    node.lastSeenMonoMs = monoMs;
+    node.messageCount++;
+    node.online = true;
+
+    // Keep the line as received, minus the closing brace
+    node.line.assign(line.data(), line.size() - 1);
+
+    // ─── Topology (serial_bridge.py update_topology) ───
+    const JsonField* rssi = findJsonField(fields, count, "rssi");
+    const JsonField* hops = findJsonField(fields, count, "hopDistance");
+    const JsonField* timeSource = findJsonField(fields, count, "timeSource");
+    const JsonField* lat = findJsonField(fields, count, "lat");
+    const JsonField* lng = findJsonField(fields, count, "lng");
+    const JsonField* temp = findJsonField(fields, count, "temp");
+    const JsonField* humidity = findJsonField(fields, count, "humidity");
+    const JsonField* satellites = findJsonField(fields, count, "satellites");
+    const JsonField* neighbors = findJsonField(fields, count, "neighborCount");
+
+    long parent = fieldLong(findJsonField(fields, count, "meshSenderId"), 0);
+    if (parent == 0 || parent == nodeId) {
+        parent = (nodeId != COLLECTOR_GATEWAY_NODE_ID) ? COLLECTOR_GATEWAY_NODE_ID : 0;
+    }
+    node.parentNode = (uint8_t)parent;
+    node.rssi = fieldDouble(rssi, -100);
+
+    std::string& body = node.topologyBody;
+    body.clear();
+    body += "{\"nodeId\":";
+    appendUnsigned(body, nodeId);
+    body += ",\"parentNode\":";
+    appendUnsigned(body, node.parentNode);
+    body += ",\"hopDistance\":";
+    appendRaw(body, hops, "0");
+    body += ",\"rssi\":";
+    appendRaw(body, rssi, "-100");
+    body += ",\"timeSource\":";
+    if (timeSource == nullptr || timeSource->value == "UNKNOWN") {
+        body += "\"NONE\"";
+    } else {
+        appendRaw(body, timeSource, "\"NONE\"");
+    }
+    body += ",\"lat\":";
+    appendRaw(body, lat, "0");
+    body += ",\"lng\":";
+    appendRaw(body, lng, "0");
+    body += ",\"temp\":";
+    appendRaw(body, temp, "null");
+    body += ",\"humidity\":";
+    appendRaw(body, humidity, "null");
+    body += ",\"satellites\":";
+    appendRaw(body, satellites, "0");
+    body += ",\"neighborCount\":";
+    appendRaw(body, neighbors, "0");
+
+    // ─── Time-series sample ───
+    sample.timeMs = wallMs;
+    sample.nodeId = (uint8_t)nodeId;
+    sample.hopDistance = (uint8_t)fieldLong(hops, 0);
+    sample.satellites = (uint8_t)fieldLong(satellites, 0);
+    sample.neighborCount = (uint8_t)fieldLong(neighbors, 0);
+    const JsonField* sensorsOk = findJsonField(fields, count, "sensorsOk");
+    sample.sensorsOk = (sensorsOk != nullptr && sensorsOk->value == "true") ? 1 : 0;
+    sample.meshMsgId = msgId;
+    sample.temp = fieldDouble(temp, 0);
+    sample.humidity = fieldDouble(humidity, 0);
+    sample.pressure = fieldLong(findJsonField(fields, count, "pressure"), 0);
+    sample.altitude = fieldLong(findJsonField(fields, count, "altitude"), 0);
+    sample.lat = fieldDouble(lat, 0);
+    sample.lng = fieldDouble(lng, 0);
+    sample.rssi = node.rssi;
+    sample.snr = fieldDouble(findJsonField(fields, count, "snr"), 0);
+
+    rebuildNodeJson(node);
+    topologyVer = currentVersion;
+    stateStats.nodeLines++;
+    result = INGEST_NODE;
+}
+
+void MeshState::rebuildNodeJson(NodeEntry& node) {
+    std::string& json = node.json;
+    json.clear();
+    json.reserve(node.line.size() + 96);
+    json += node.line;
+    json += ",\"lastUpdate\":";
+    appendEpochSeconds(json, node.lastSeenWallMs);
+    json += node.online ? ",\"online\":true" : ",\"online\":false";
+    json += ",\"messageCount\":";
+    appendUnsigned(json, node.messageCount);
+    if (!node.online) {
+        json += ",\"offlineSince\":";
+        appendEpochSeconds(json, node.lastSeenWallMs);
+    }
+    json += '}';
+
+    node.version = ++currentVersion;
+}
+
+int MeshState::checkOffline(uint64_t monoMs) {
+    int changed = 0;
+    for (NodeEntry& node : nodes) {
+        if (!node.present) continue;
+
+        bool online = (monoMs - node.lastSeenMonoMs) <= COLLECTOR_OFFLINE_MS;
+        if (online != node.online) {
+            node.online = online;
+            rebuildNodeJson(node);
+            topologyVer = currentVersion;
+            changed++;
+        }
+    }
+    return changed;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OUTPUT
+// ═══════════════════════════════════════════════════════════════════════════
+
+int MeshState::appendNodesSince(std::string& out, uint64_t since) const {
+    int appended = 0;
+    for (int id = 1; id <= COLLECTOR_MAX_NODE_ID; id++) {
+        const NodeEntry& node = nodes[id];
+        if (!node.present || node.version <= since) continue;
+
+        if (appended > 0) out += ',';
+        out += '"';
+        appendUnsigned(out, id);
+        out += "\":";
+        out += node.json;
+        appended++;
+    }
+    return appended;
+}
+
+void MeshState::appendTopologyNode(std::string& out, const NodeEntry& node) const {
+    out += node.topologyBody;
+    out += node.online ? ",\"online\":true" : ",\"online\":false";
+    out += ",\"lastSeen\":";
+    appendEpochSeconds(out, node.lastSeenWallMs);
+    out += '}';
+}
+
+const std::string& MeshState::topologyJson() {
+    if (topologyBuiltVer == topologyVer && topologyBuiltHistory == topologyHistory.size()) {
+        return topologyCache;
+    }
+
+    std::string& out = topologyCache;
+    out.clear();
+    out += "{\"nodes\":[";
+    bool first = true;
+    for (int id = 1; id <= COLLECTOR_MAX_NODE_ID; id++) {
+        if (!nodes[id].present) continue;
+        if (!first) out += ',';
+        appendTopologyNode(out, nodes[id]);
+        first = false;
+    }
+
+    out += "],\"edges\":[";
+    first = true;
+    char edge[96];
+    for (int id = 1; id <= COLLECTOR_MAX_NODE_ID; id++) {
+        const NodeEntry& node = nodes[id];
+        if (!node.present || node.parentNode == 0 || node.parentNode == id) continue;
+
+        int len = snprintf(edge, sizeof(edge), "%s{\"from\":%d,\"to\":%u,\"rssi\":%g}",
+                           first ? "" : ",", id, node.parentNode, node.rssi);
+        out.append(edge, len);
+        first = false;
+    }
+
+    out += "],\"historyCount\":";
+    appendUnsigned(out, topologyHistory.size());
+    out += '}';
+
+    topologyBuiltVer = topologyVer;
+    topologyBuiltHistory = topologyHistory.size();
+    return topologyCache;
+}
+
+void MeshState::snapshotTopology(uint64_t wallMs) {
+    if (presentCount == 0 || topologySnapshotVer == topologyVer) return;
+    topologySnapshotVer = topologyVer;
+
+    std::string snapshot;
+    snapshot.reserve(presentCount * 320 + 96);
+    snapshot += "{\"timestamp\":";
+    appendEpochSeconds(snapshot, wallMs);
+    snapshot += ",\"datetime\":\"";
+    appendIsoTime(snapshot, wallMs);
+    snapshot += "\",\"nodes\":{";
+    bool first = true;
+    for (int id = 1; id <= COLLECTOR_MAX_NODE_ID; id++) {
+        if (!nodes[id].present) continue;
+        if (!first) snapshot += ',';
+        snapshot += '"';
+        appendUnsigned(snapshot, id);
+        snapshot += "\":";
+        appendTopologyNode(snapshot, nodes[id]);
+        first = false;
+    }
+    snapshot += "}}";
+
+    topologyHistory.push_back(std::move(snapshot));
+    if (topologyHistory.size() > COLLECTOR_TOPOLOGY_HISTORY) {
+        topologyHistory.pop_front();
+    }
+
+    // historyCount is part of the topology object
+    topologyVer = ++currentVersion;
+    topologySnapshotVer = topologyVer;
+}
+
+void MeshState::appendTopologyHistory(std::string& out) const {
+    out += '[';
+    bool first = true;
+    for (const std::string& snapshot : topologyHistory) {
+        if (!first) out += ',';
+        out += snapshot;
+        first = false;
+    }
+    out += ']';
+}
@@ -0,0 +1,234 @@
+#include "replay.h"
+#include "event_loop.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+Replayer::Replayer() : stopping(false), replayStats() {}
+
+Replayer::~Replayer() {
+    stop();
+    join();
+    for (Pipe& pipe : pipes) {
+        if (pipe.writeFd >= 0) close(pipe.writeFd);
+        // readFd belongs to the collector's SerialSource
+    }
+}
+
+bool Replayer::load(const std::string& path, unsigned sourceCount) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == nullptr || sourceCount == 0) {
+        if (file != nullptr) fclose(file);
+        return false;
+    }
+
+    char* line = nullptr;
+    size_t capacity = 0;
+    ssize_t length;
+    uint64_t firstMs = 0;
+    bool first = true;
+
+    while ((length = getline(&line, &capacity, file)) > 0) {
+        // <ms> <source> <text>
+        char* end;
+        unsigned long long timeMs = strtoull(line, &end, 10);
+        if (end == line || *end != ' ') continue;
+        char* sourceText = end + 1;
+        unsigned long source = strtoul(sourceText, &end, 10);
+        if (end == sourceText || *end != ' ') continue;
+        char* body = end + 1;
+        size_t bodyLength = line + length - body;
+        if (bodyLength == 0 || body[bodyLength - 1] != '\n') {
+            body[bodyLength++] = '\n';
+        }
+
+        if (first) {
+            firstMs = timeMs;
+            first = false;
+        }
+
+        Entry entry;
+        entry.timeMs = (timeMs > firstMs) ? timeMs - firstMs : 0;
+        entry.source = (uint32_t)(source % sourceCount);
+        entry.offset = (uint32_t)text.size();
+        entry.length = (uint32_t)bodyLength;
+        text.append(body, bodyLength);
+        entries.push_back(entry);
+    }
+    free(line);
+    fclose(file);
+
+    if (entries.empty()) return false;
+    replayStats.recordedMs = entries.back().timeMs;
+
+    pipes.resize(sourceCount);
+    for (Pipe& pipe : pipes) {
+        int fds[2];
+        if (pipe2(fds, O_CLOEXEC) < 0) return false;
+        pipe.readFd = fds[0];
+        pipe.writeFd = fds[1];
+    }
+    return true;
+}
+
+void Replayer::start(double speed) {
+    worker = std::thread([this, speed]() { run(speed); });
+}
+
+void Replayer::join() {
+    if (worker.joinable()) worker.join();
+}
+
+void Replayer::flushPipe(Pipe& pipe) {
+    size_t offset = 0;
+    while (offset < pipe.pending.size()) {
+        ssize_t n = write(pipe.writeFd, pipe.pending.data() + offset, pipe.pending.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // EPIPE: the collector closed the stream
+            stopping = true;
+            break;
+        }
+        offset += n;
+    }
+    replayStats.bytes += offset;
+    pipe.pending.clear();
+}
+
+void Replayer::run(double speed) {
+    uint64_t startMs = EventLoop::monotonicMs();
+
+    for (const Entry& entry : entries) {
+        if (stopping) break;
+
+        if (speed > 0) {
+            uint64_t dueMs = startMs + (uint64_t)(entry.timeMs / speed);
+            uint64_t nowMs = EventLoop::monotonicMs();
+            if (dueMs > nowMs) {
+                // Hand over what is due before sleeping
+                for (Pipe& pipe : pipes) flushPipe(pipe);
+                while (!stopping && (nowMs = EventLoop::monotonicMs()) < dueMs) {
+                    uint64_t waitMs = (dueMs - nowMs < 100) ? dueMs - nowMs : 100;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+                }
+            } else if (nowMs - dueMs > replayStats.lateMs) {
+                replayStats.lateMs = nowMs - dueMs;
+            }
+        }
+
+        Pipe& pipe = pipes[entry.source];
+        pipe.pending.append(text, entry.offset, entry.length);
+        if (pipe.pending.size() >= REPLAY_BATCH_BYTES) flushPipe(pipe);
+        replayStats.lines++;
+    }
+
+    for (Pipe& pipe : pipes) {
+        flushPipe(pipe);
+        close(pipe.writeFd);
+        pipe.writeFd = -1;
+    }
+    replayStats.elapsedMs = EventLoop::monotonicMs() - startMs;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SYNTHETIC RECORDING
+// ═══════════════════════════════════════════════════════════════════════════
+
+static const char* const DEBUG_LINES[] = {
+    "[TDMA] Slot %u start, queue depth %u",
+    "[MESH] Forwarded packet from %u, ttl %u",
+    "[RX] Packet: %u bytes, RSSI -%u dBm",
+    "[ROUTE] Beacon from node %u distance %u",
+    "[GPS] Fix valid, sats %u hdop 1.%u",
+};
+
+bool generateRecording(const std::string& path, unsigned nodes, unsigned gateways,
+                       unsigned minutes, unsigned reportSec, unsigned textPerSec) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) return false;
+    if (gateways == 0) gateways = 1;
+    if (reportSec == 0) reportSec = 60;
+
+    const uint64_t baseMs = 1700000000000ULL;
+    const uint64_t durationMs = (uint64_t)minutes * 60000ULL;
+    uint16_t msgIds[256] = {};
+    unsigned debugCounter = 0;
+    srand(490);
+
+    // 10 ms steps: each node reports in its own slot, text spread over the second
+    for (uint64_t t = 0; t < durationMs; t += 10) {
+        uint64_t timeMs = baseMs + t;
+        unsigned step = (unsigned)((t / 10) % (reportSec * 100));
+
+        for (unsigned n = 0; n < nodes; n++) {
+            if (step != (n * reportSec * 100) / (nodes ? nodes : 1)) continue;
+
+            unsigned nodeId = 2 + n % 250;
+            uint16_t msgId = ++msgIds[nodeId];
+            double temp = 68.0 + (rand() % 200) / 10.0;
+            double humidity = 40.0 + (rand() % 300) / 10.0;
+            unsigned hops = 1 + n % 4;
+            unsigned sender = (hops == 1) ? nodeId : 2 + (n + 1) % 250;
+
+            for (unsigned g = 0; g < gateways; g++) {
+                // Second gateway hears it a little later and weaker
+                fprintf(file,
+                    "%llu %u {\"type\":\"node_data\",\"nodeId\":%u,\"temp\":%.1f,\"humidity\":%.1f,"
+                    "\"pressure\":%u,\"altitude\":%d,\"sensorsOk\":true,"
+                    "\"lat\":%.6f,\"lng\":%.6f,\"satellites\":%u,\"rssi\":%d,\"snr\":%.1f,"
+                    "\"hopDistance\":%u,\"meshMsgId\":%u,\"meshTtl\":%u,\"meshSenderId\":%u,"
+                    "\"neighborCount\":%u,\"uptime_sec\":%llu,\"online\":true,\"timeSource\":\"GPS\"}\n",
+                    (unsigned long long)(timeMs + g * 3), g, nodeId, temp, humidity,
+                    101000 + rand() % 800, 30 + (int)(n % 20),
+                    33.7830 + n * 0.0005, -118.1140 - n * 0.0005, 6 + n % 6,
+                    -70 - (int)(n % 40) - (int)g * 6, 7.5 - g, hops, msgId, 5 - hops, sender,
+                    2 + n % 5, (unsigned long long)(t / 1000 + 300));
+            }
+        }
+
+        for (unsigned g = 0; g < gateways; g++) {
+            if (t % 10000 == g * 20) {
+                fprintf(file,
+                    "%llu %u {\"type\":\"gateway_status\",\"nodeId\":1,\"uptime\":%llu,"
+                    "\"freeHeap\":%u,\"isGateway\":true}\n",
+                    (unsigned long long)timeMs, g, (unsigned long long)(t / 1000 + 300),
+                    180000 + rand() % 4000);
+                fprintf(file,
+                    "%llu %u {\"type\":\"mesh_stats\",\"packetsReceived\":%llu,\"packetsSent\":%llu,"
+                    "\"packetsForwarded\":%llu,\"duplicatesDropped\":%llu,\"ttlExpired\":0,"
+                    "\"queueOverflows\":0,\"beaconsReceived\":%llu,\"beaconsSent\":%llu,"
+                    "\"unicastForwards\":%llu,\"floodingFallbacks\":0}\n",
+                    (unsigned long long)timeMs, g, (unsigned long long)(t / 1000 * nodes / reportSec),
+                    (unsigned long long)(t / 60000), (unsigned long long)(t / 2000),
+                    (unsigned long long)(t / 5000), (unsigned long long)(t / 3000),
+                    (unsigned long long)(t / 30000), (unsigned long long)(t / 2500));
+            }
+            if (t % 30000 == 500 + g * 20) {
+                fprintf(file, "%llu %u {\"type\":\"beacon\",\"senderId\":%u,\"distance\":%u,\"rssi\":%d}\n",
+                        (unsigned long long)timeMs, g, 2 + rand() % (nodes ? nodes : 1),
+                        1 + rand() % 3, -60 - rand() % 50);
+            }
+
+            // Verbose logging: textPerSec lines per gateway, evenly spread
+            if (textPerSec > 0 && (t / 10) % (100 / (textPerSec < 100 ? textPerSec : 100)) == 0) {
+                unsigned repeat = (textPerSec > 100) ? textPerSec / 100 : 1;
+                for (unsigned r = 0; r < repeat; r++) {
+                    const char* format = DEBUG_LINES[debugCounter % 5];
+                    fprintf(file, "%llu %u ", (unsigned long long)timeMs, g);
+                    fprintf(file, format, debugCounter % 97, debugCounter % 7);
+                    fputc('\n', file);
+                    debugCounter++;
+                }
+            }
+        }
+    }
+
+    bool ok = (ferror(file) == 0);
+    fclose(file);
+    return ok;
+}
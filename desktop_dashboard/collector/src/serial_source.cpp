@@ -0,0 +1,131 @@
+#include "serial_source.h"
+#include "collector_config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static speed_t baudConstant(unsigned baud) {
+    switch (baud) {
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 921600:  return B921600;
+        default:      return B0;
+    }
+}
+
+SerialSource::SerialSource(uint8_t id, const std::string& name)
+    : sourceId(id), sourceName(name), fileFd(-1),
+      buffer(COLLECTOR_READ_CHUNK + COLLECTOR_LINE_MAX), used(0), skipping(false) {
+    memset(&sourceStats, 0, sizeof(sourceStats));
+}
+
+SerialSource::~SerialSource() {
+    if (fileFd >= 0) close(fileFd);
+}
+
+bool SerialSource::openTty(const std::string& path, unsigned baud) {
+    speed_t speed = baudConstant(baud);
+    if (speed == B0) {
+        errno = EINVAL;
+        return false;
+    }
+
+    int fd = open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    termios tio;
+    if (tcgetattr(fd, &tio) < 0) {
+        close(fd);
+        return false;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~CRTSCTS;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if (tcsetattr(fd, TCSANOW, &tio) < 0) {
+        close(fd);
+        return false;
+    }
+    tcflush(fd, TCIFLUSH);
+
+    fileFd = fd;
+    return true;
+}
+
+bool SerialSource::openFd(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) return false;
+    fileFd = fd;
+    return true;
+}
+
+bool SerialSource::readLines(const LineHandler& handler) {
+    while (true) {
+        ssize_t n = read(fileFd, buffer.data() + used, buffer.size() - used);
+        if (n == 0) return false;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        sourceStats.bytes += n;
+
+        char* start = buffer.data();
+        char* end = buffer.data() + used + n;
+        char* scan = buffer.data() + used;
+
+        while (true) {
+            char* newline = (char*)memchr(scan, '\n', end - scan);
+            if (newline == nullptr) break;
+
+            size_t length = newline - start;
+            if (skipping) {
+                skipping = false;
+            } else if (length > COLLECTOR_LINE_MAX) {
+                sourceStats.oversized++;
+            } else {
+                if (length > 0 && start[length - 1] == '\r') length--;
+                sourceStats.lines++;
+                handler(std::string_view(start, length));
+            }
+            start = newline + 1;
+            scan = start;
+        }
+
+        // Keep the partial line for the next read
+        used = end - start;
+        if (skipping) {
+            used = 0;
+        } else if (used > COLLECTOR_LINE_MAX) {
+            sourceStats.oversized++;
+            skipping = true;
+            used = 0;
+        } else if (used > 0 && start != buffer.data()) {
+            memmove(buffer.data(), start, used);
+        }
+    }
+}
+
+bool SerialSource::writeLine(const std::string& line) {
+    std::string out = line + "\n";
+    size_t written = 0;
+    while (written < out.size()) {
+        ssize_t n = write(fileFd, out.data() + written, out.size() - written);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            return false;
+        }
+        written += n;
+    }
+    return true;
+}
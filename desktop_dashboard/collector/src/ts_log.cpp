@@ -0,0 +1,174 @@
+#include "ts_log.h"
+#include "collector_config.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int localDay(uint64_t timeMs) {
+    time_t seconds = (time_t)(timeMs / 1000);
+    tm local;
+    localtime_r(&seconds, &local);
+    return (local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 + local.tm_mday;
+}
+
+template <typename T>
+static T clampScaled(double value, double scale) {
+    double scaled = std::round(value * scale);
+    if (scaled < (double)std::numeric_limits<T>::min()) return std::numeric_limits<T>::min();
+    if (scaled > (double)std::numeric_limits<T>::max()) return std::numeric_limits<T>::max();
+    return (T)scaled;
+}
+
+TimeSeriesLog::TimeSeriesLog()
+    : fileFd(-1), fileDay(0), buffer(COLLECTOR_LOG_BUFFER), used(0), written(0), errors(0) {}
+
+TimeSeriesLog::~TimeSeriesLog() {
+    close();
+}
+
+bool TimeSeriesLog::open(const std::string& dir) {
+    if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) return false;
+
+    struct stat info;
+    if (stat(dir.c_str(), &info) < 0 || !S_ISDIR(info.st_mode)) return false;
+
+    directory = dir;
+    return true;
+}
+
+bool TimeSeriesLog::openDay(uint64_t timeMs) {
+    int day = localDay(timeMs);
+    if (fileFd >= 0 && day == fileDay) return true;
+
+    if (fileFd >= 0) {
+        ::close(fileFd);
+        fileFd = -1;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "/mesh-%08d.tsl", day);
+    std::string path = directory + name;
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size == 0) {
+        uint8_t header[TS_LOG_HEADER_SIZE] = {};
+        memcpy(header, TS_LOG_MAGIC, 8);
+        uint32_t recordSize = sizeof(TsRecord);
+        memcpy(header + 8, &recordSize, sizeof(recordSize));
+        if (write(fd, header, sizeof(header)) != (ssize_t)sizeof(header)) {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    fileFd = fd;
+    fileDay = day;
+    return true;
+}
+
+void TimeSeriesLog::append(const NodeSample& sample) {
+    if (!isOpen()) return;
+
+    // Buffered records belong to the previous day's file
+    int day = localDay(sample.timeMs);
+    if (fileFd < 0 || day != fileDay) {
+        flush();
+        if (!openDay(sample.timeMs)) {
+            errors++;
+            return;
+        }
+    }
+    if (used + sizeof(TsRecord) > buffer.size()) flush();
+
+    TsRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timeMs = sample.timeMs;
+    record.nodeId = sample.nodeId;
+    record.sourceId = sample.sourceId;
+    record.hopDistance = sample.hopDistance;
+    record.satellites = sample.satellites;
+    record.tempX10 = clampScaled<int16_t>(sample.temp, 10);
+    record.humidityX10 = clampScaled<uint16_t>(sample.humidity, 10);
+    record.pressure = (sample.pressure > 0) ? (uint32_t)sample.pressure : 0;
+    record.altitude = clampScaled<int16_t>(sample.altitude, 1);
+    record.latE6 = clampScaled<int32_t>(sample.lat, 1e6);
+    record.lngE6 = clampScaled<int32_t>(sample.lng, 1e6);
+    record.rssi = clampScaled<int16_t>(sample.rssi, 1);
+    record.snrX10 = clampScaled<int16_t>(sample.snr, 10);
+    record.neighborCount = sample.neighborCount;
+    record.flags = sample.sensorsOk ? TS_FLAG_SENSORS_OK : 0;
+    record.meshMsgId = sample.meshMsgId;
+
+    memcpy(buffer.data() + used, &record, sizeof(record));
+    used += sizeof(record);
+}
+
+void TimeSeriesLog::flush() {
+    if (used == 0 || fileFd < 0) return;
+
+    size_t offset = 0;
+    while (offset < used) {
+        ssize_t n = write(fileFd, buffer.data() + offset, used - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            errors++;
+            break;
+        }
+        offset += n;
+    }
+    written += offset / sizeof(TsRecord);
+    used = 0;
+}
+
+void TimeSeriesLog::close() {
+    flush();
+    if (fileFd >= 0) {
+        ::close(fileFd);
+        fileFd = -1;
+    }
+}
+
+bool dumpTimeSeriesLog(const std::string& path, FILE* out) {
+    FILE* in = fopen(path.c_str(), "rb");
+    if (in == nullptr) return false;
+
+    uint8_t header[TS_LOG_HEADER_SIZE];
+    uint32_t recordSize = 0;
+    if (fread(header, 1, sizeof(header), in) != sizeof(header) ||
+        memcmp(header, TS_LOG_MAGIC, 8) != 0) {
+        fclose(in);
+        return false;
+    }
+    memcpy(&recordSize, header + 8, sizeof(recordSize));
+    if (recordSize != sizeof(TsRecord)) {
+        fclose(in);
+        return false;
+    }
+
+    fprintf(out, "timeMs,nodeId,sourceId,hopDistance,satellites,temp,humidity,pressure,"
+                 "altitude,lat,lng,rssi,snr,neighborCount,sensorsOk,meshMsgId\n");
+
+    TsRecord record;
+    while (fread(&record, sizeof(record), 1, in) == 1) {
+        fprintf(out, "%llu,%u,%u,%u,%u,%.1f,%.1f,%u,%d,%.6f,%.6f,%d,%.1f,%u,%u,%u\n",
+                (unsigned long long)record.timeMs, record.nodeId, record.sourceId,
+                record.hopDistance, record.satellites,
+                record.tempX10 / 10.0, record.humidityX10 / 10.0, record.pressure,
+                record.altitude, record.latE6 / 1e6, record.lngE6 / 1e6,
+                record.rssi, record.snrX10 / 10.0, record.neighborCount,
+                (record.flags & TS_FLAG_SENSORS_OK) ? 1 : 0, record.meshMsgId);
+    }
+
+    fclose(in);
+    return true;
+}
@@ -0,0 +1,676 @@
+#include "ws_server.h"
+#include "collector_config.h"
+#include "json_scan.h"
+#include "sha1.h"
+
+#include <cstdio>
+#include <cstring>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <unordered_map>
+
+#define WS_OPCODE_CONTINUATION  0x0
+#define WS_OPCODE_TEXT          0x1
+#define WS_OPCODE_CLOSE         0x8
+#define WS_OPCODE_PING          0x9
+#define WS_OPCODE_PONG          0xA
+
+static void appendFrameHeader(std::string& out, uint8_t opcode, size_t length) {
+    out += (char)(0x80 | opcode);
+    if (length < 126) {
+        out += (char)length;
+    } else if (length <= 0xFFFF) {
+        out += (char)126;
+        out += (char)(length >> 8);
+        out += (char)(length & 0xFF);
+    } else {
+        out += (char)127;
+        for (int i = 7; i >= 0; i--) out += (char)((uint64_t)length >> (i * 8));
+    }
+}
+
+static const char* contentTypeFor(const std::string& path) {
+    size_t dot = path.rfind('.');
+    std::string ext = (dot == std::string::npos) ? "" : path.substr(dot + 1);
+    if (ext == "html") return "text/html; charset=utf-8";
+    if (ext == "js")   return "application/javascript";
+    if (ext == "css")  return "text/css";
+    if (ext == "json") return "application/json";
+    if (ext == "png")  return "image/png";
+    if (ext == "svg")  return "image/svg+xml";
+    return "application/octet-stream";
+}
+
+static const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        default:  return "Error";
+    }
+}
+
+/**
+ * Value of header name in the request head (case-insensitive), or empty
+ */
+static std::string headerValue(const std::string& head, const char* name) {
+    size_t nameLength = strlen(name);
+    size_t pos = head.find("\r\n");
+    while (pos != std::string::npos) {
+        size_t start = pos + 2;
+        size_t end = head.find("\r\n", start);
+        if (end == std::string::npos) end = head.size();
+
+        if (end - start > nameLength && head[start + nameLength] == ':' &&
+            strncasecmp(head.c_str() + start, name, nameLength) == 0) {
+            size_t valueStart = start + nameLength + 1;
+            while (valueStart < end && head[valueStart] == ' ') valueStart++;
+            return head.substr(valueStart, end - valueStart);
+        }
+        pos = (end < head.size()) ? end : std::string::npos;
+    }
+    return std::string();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONNECTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+WebServer::WebServer(EventLoop& eventLoop, MeshState& meshState)
+    : loop(eventLoop), state(meshState), consoleBatchLines(0), serverStats() {}
+
+WebServer::~WebServer() {
+    for (auto& entry : connections) {
+        loop.remove(entry.first);
+        close(entry.first);
+    }
+    for (int fd : listeners) {
+        loop.remove(fd);
+        close(fd);
+    }
+}
+
+int WebServer::listen(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    socklen_t addrLength = sizeof(addr);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || ::listen(fd, 64) < 0 ||
+        getsockname(fd, (sockaddr*)&addr, &addrLength) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    if (!loop.add(fd, EPOLLIN, [this, fd](uint32_t) { onAccept(fd); })) {
+        close(fd);
+        return -1;
+    }
+    listeners.push_back(fd);
+    return ntohs(addr.sin_port);
+}
+
+void WebServer::onAccept(int listenFd) {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        Connection& conn = connections[fd];
+        conn.fd = fd;
+        conn.websocket = false;
+        conn.closing = false;
+        conn.dead = false;
+        conn.writeWatch = false;
+        conn.sentVersion = 0;
+
+        if (!loop.add(fd, EPOLLIN | EPOLLRDHUP, [this, fd](uint32_t events) { onEvent(fd, events); })) {
+            connections.erase(fd);
+            close(fd);
+        }
+    }
+}
+
+void WebServer::closeConnection(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+
+    if (it->second.websocket) serverStats.clients--;
+    loop.remove(fd);
+    close(fd);
+    connections.erase(it);
+}
+
+void WebServer::onEvent(int fd, uint32_t events) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    Connection& conn = it->second;
+
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        closeConnection(fd);
+        return;
+    }
+
+    if (events & EPOLLOUT) flushOut(conn);
+
+    if (events & (EPOLLIN | EPOLLRDHUP)) {
+        char chunk[16384];
+        while (!conn.dead) {
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n == 0) {
+                conn.dead = true;
+            } else if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) conn.dead = true;
+                break;
+            } else {
+                conn.in.append(chunk, n);
+            }
+        }
+
+        if (!conn.in.empty()) {
+            if (conn.websocket) {
+                handleWebSocketData(conn);
+            } else {
+                handleHttp(conn);
+            }
+        }
+    }
+
+    if (conn.dead) closeConnection(fd);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OUTPUT
+// ═══════════════════════════════════════════════════════════════════════════
+
+void WebServer::flushOut(Connection& conn) {
+    while (!conn.out.empty()) {
+        ssize_t n = send(conn.fd, conn.out.data(), conn.out.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) conn.dead = true;
+            break;
+        }
+        serverStats.bytesSent += n;
+        conn.out.erase(0, n);
+    }
+
+    if (conn.out.empty()) {
+        if (conn.closing) conn.dead = true;
+        if (conn.writeWatch) {
+            loop.modify(conn.fd, EPOLLIN | EPOLLRDHUP);
+            conn.writeWatch = false;
+        }
+    } else if (!conn.writeWatch) {
+        loop.modify(conn.fd, EPOLLIN | EPOLLRDHUP | EPOLLOUT);
+        conn.writeWatch = true;
+    }
+}
+
+void WebServer::sendBytes(Connection& conn, std::string_view data) {
+    if (conn.dead) return;
+
+    // Try the socket first so the common case copies nothing
+    size_t sent = 0;
+    if (conn.out.empty()) {
+        while (sent < data.size()) {
+            ssize_t n = send(conn.fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    conn.dead = true;
+                    return;
+                }
+                break;
+            }
+            serverStats.bytesSent += n;
+            sent += n;
+        }
+        if (sent == data.size()) return;
+    }
+
+    conn.out.append(data.data() + sent, data.size() - sent);
+    flushOut(conn);
+}
+
+void WebServer::sendFrame(Connection& conn, uint8_t opcode, std::string_view payload) {
+    if (conn.dead) return;
+    serverStats.wsMessages++;
+
+    std::string header;
+    appendFrameHeader(header, opcode, payload.size());
+
+    if (!conn.out.empty()) {
+        conn.out += header;
+        conn.out.append(payload.data(), payload.size());
+        flushOut(conn);
+        return;
+    }
+
+    // Nothing queued: write header and payload in one call without copying
+    iovec parts[2];
+    parts[0].iov_base = (void*)header.data();
+    parts[0].iov_len = header.size();
+    parts[1].iov_base = (void*)payload.data();
+    parts[1].iov_len = payload.size();
+    msghdr message = {};
+    message.msg_iov = parts;
+    message.msg_iovlen = 2;
+
+    ssize_t n;
+    do {
+        n = sendmsg(conn.fd, &message, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            conn.dead = true;
+            return;
+        }
+        n = 0;
+    }
+    serverStats.bytesSent += n;
+
+    size_t total = header.size() + payload.size();
+    if ((size_t)n == total) return;
+
+    if ((size_t)n < header.size()) {
+        conn.out.append(header, n, std::string::npos);
+        conn.out.append(payload.data(), payload.size());
+    } else {
+        size_t sent = n - header.size();
+        conn.out.append(payload.data() + sent, payload.size() - sent);
+    }
+    flushOut(conn);
+}
+
+void WebServer::sendHttp(Connection& conn, int status, const char* contentType, const std::string& body) {
+    char head[256];
+    int len = snprintf(head, sizeof(head),
+                       "HTTP/1.1 %d %s\r\n"
+                       "Content-Type: %s\r\n"
+                       "Content-Length: %zu\r\n"
+                       "Access-Control-Allow-Origin: *\r\n"
+                       "Cache-Control: no-cache\r\n"
+                       "Connection: close\r\n\r\n",
+                       status, statusText(status), contentType, body.size());
+    conn.closing = true;
+    conn.out.append(head, len);
+    conn.out += body;
+    flushOut(conn);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HTTP
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool WebServer::readFile(const std::string& path, std::string& out) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+
+    char chunk[16384];
+    size_t n;
+    out.clear();
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) out.append(chunk, n);
+    fclose(file);
+    return true;
+}
+
+void WebServer::buildState(std::string& out, const char* type, uint64_t since) {
+    uint64_t now = EventLoop::wallMs();
+
+    out += "{\"type\":\"";
+    out += type;
+    out += '"';
+    if (since > 0) out += ",\"partial\":true";
+    out += ",\"timestamp\":\"";
+    appendIsoTime(out, now);
+    out += '"';
+
+    if (since == 0 || state.gatewayVersion() > since) {
+        out += ",\"gateway\":";
+        out += state.gatewayJson();
+    }
+
+    out += ",\"nodes\":{";
+    state.appendNodesSince(out, since);
+    out += '}';
+
+    if (since == 0 || state.meshStatsVersion() > since) {
+        out += ",\"meshStats\":";
+        out += state.meshStatsJson();
+    }
+
+    if (since == 0 || state.topologyVersion() > since) {
+        out += ",\"topology\":";
+        out += state.topologyJson();
+    }
+    out += '}';
+}
+
+void WebServer::handleHttp(Connection& conn) {
+    size_t headEnd = conn.in.find("\r\n\r\n");
+    if (headEnd == std::string::npos) {
+        if (conn.in.size() > COLLECTOR_HTTP_REQUEST_MAX) {
+            sendHttp(conn, 413, "text/plain", "Request too large\n");
+        }
+        return;
+    }
+    if (conn.closing) return;
+
+    std::string head = conn.in.substr(0, headEnd);
+    conn.in.erase(0, headEnd + 4);
+    serverStats.httpRequests++;
+
+    // Request line: METHOD PATH VERSION
+    size_t lineEnd = head.find("\r\n");
+    std::string requestLine = head.substr(0, lineEnd);
+    size_t space1 = requestLine.find(' ');
+    size_t space2 = (space1 == std::string::npos) ? std::string::npos : requestLine.find(' ', space1 + 1);
+    if (space2 == std::string::npos) {
+        sendHttp(conn, 400, "text/plain", "Bad request\n");
+        return;
+    }
+    std::string method = requestLine.substr(0, space1);
+    std::string path = requestLine.substr(space1 + 1, space2 - space1 - 1);
+    size_t query = path.find('?');
+    if (query != std::string::npos) path.resize(query);
+
+    if (method != "GET") {
+        sendHttp(conn, 405, "text/plain", "Method not allowed\n");
+        return;
+    }
+
+    // ─── WebSocket upgrade ───
+    std::string upgrade = headerValue(head, "Upgrade");
+    if (strcasecmp(upgrade.c_str(), "websocket") == 0) {
+        std::string key = headerValue(head, "Sec-WebSocket-Key");
+        if (key.empty() || !upgradeWebSocket(conn, key)) {
+            sendHttp(conn, 400, "text/plain", "Bad WebSocket handshake\n");
+        } else if (!conn.in.empty()) {
+            handleWebSocketData(conn);
+        }
+        return;
+    }
+
+    // ─── Routes (serial_bridge.py create_http_app) ───
+    std::string body;
+    uint64_t now = EventLoop::wallMs();
+
+    if (path == "/" || path == "/index.html") {
+        if (readFile(staticDir + "/dashboard.html", body)) {
+            sendHttp(conn, 200, "text/html; charset=utf-8", body);
+        } else {
+            sendHttp(conn, 404, "text/plain", "Dashboard not found. Please create dashboard.html");
+        }
+    } else if (path == "/api/data") {
+        body += "{\"timestamp\":\"";
+        appendIsoTime(body, now);
+        body += "\",\"gateway\":";
+        body += state.gatewayJson();
+        body += ",\"nodes\":{";
+        state.appendNodesSince(body, 0);
+        body += "},\"meshStats\":";
+        body += state.meshStatsJson();
+        body += '}';
+        sendHttp(conn, 200, "application/json", body);
+    } else if (path == "/api/nodes") {
+        body += "{\"nodes\":{";
+        state.appendNodesSince(body, 0);
+        body += "}}";
+        sendHttp(conn, 200, "application/json", body);
+    } else if (path == "/api/topology") {
+        body += "{\"timestamp\":\"";
+        appendIsoTime(body, now);
+        body += "\",\"topology\":";
+        body += state.topologyJson();
+        body += '}';
+        sendHttp(conn, 200, "application/json", body);
+    } else if (path == "/api/topology/history") {
+        body += "{\"timestamp\":\"";
+        appendIsoTime(body, now);
+        body += "\",\"history\":";
+        state.appendTopologyHistory(body);
+        body += '}';
+        sendHttp(conn, 200, "application/json", body);
+    } else if (path == "/api/collector") {
+        const MeshStateStats& meshStats = state.stats();
+        char text[512];
+        int len = snprintf(text, sizeof(text),
+            "{\"nodes\":%d,\"version\":%llu,\"nodeLines\":%llu,\"duplicates\":%llu,"
+            "\"invalid\":%llu,\"otherJson\":%llu,\"textLines\":%llu,"
+            "\"clients\":%u,\"httpRequests\":%llu,\"wsMessages\":%llu,\"bytesSent\":%llu,"
+            "\"updatesBuilt\":%llu,\"consoleLines\":%llu,\"consoleDropped\":%llu",
+            state.nodeCount(), (unsigned long long)state.version(),
+            (unsigned long long)meshStats.nodeLines, (unsigned long long)meshStats.duplicates,
+            (unsigned long long)meshStats.invalid, (unsigned long long)meshStats.otherJson,
+            (unsigned long long)meshStats.textLines, serverStats.clients,
+            (unsigned long long)serverStats.httpRequests, (unsigned long long)serverStats.wsMessages,
+            (unsigned long long)serverStats.bytesSent, (unsigned long long)serverStats.updatesBuilt,
+            (unsigned long long)serverStats.consoleLines, (unsigned long long)serverStats.consoleDropped);
+        body.append(text, len);
+        if (statsHandler) statsHandler(body);
+        body += '}';
+        sendHttp(conn, 200, "application/json", body);
+    } else if (path.compare(0, 8, "/static/") == 0 && path.find("..") == std::string::npos) {
+        std::string file = staticDir + "/" + path.substr(8);
+        if (readFile(file, body)) {
+            sendHttp(conn, 200, contentTypeFor(file), body);
+        } else {
+            sendHttp(conn, 404, "text/plain", "Not found\n");
+        }
+    } else {
+        sendHttp(conn, 404, "text/plain", "Not found\n");
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WEBSOCKET
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool WebServer::upgradeWebSocket(Connection& conn, const std::string& key) {
+    std::string response =
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: " + websocketAcceptKey(key) + "\r\n\r\n";
+    sendBytes(conn, response);
+    if (conn.dead) return false;
+
+    conn.websocket = true;
+    serverStats.clients++;
+
+    // Full state first (serial_bridge.py websocket_handler "init")
+    std::string init;
+    buildState(init, "init", 0);
+    conn.sentVersion = state.version();
+    sendFrame(conn, WS_OPCODE_TEXT, init);
+    return true;
+}
+
+void WebServer::handleWebSocketData(Connection& conn) {
+    size_t offset = 0;
+    const std::string& in = conn.in;
+
+    while (!conn.dead && in.size() - offset >= 2) {
+        const uint8_t* bytes = (const uint8_t*)in.data() + offset;
+        size_t available = in.size() - offset;
+
+        bool fin = bytes[0] & 0x80;
+        uint8_t opcode = bytes[0] & 0x0F;
+        bool masked = bytes[1] & 0x80;
+        uint64_t length = bytes[1] & 0x7F;
+        size_t headerSize = 2;
+
+        if (length == 126) {
+            if (available < 4) break;
+            length = ((uint64_t)bytes[2] << 8) | bytes[3];
+            headerSize = 4;
+        } else if (length == 127) {
+            if (available < 10) break;
+            length = 0;
+            for (int i = 0; i < 8; i++) length = (length << 8) | bytes[2 + i];
+            headerSize = 10;
+        }
+
+        // Clients must mask their frames (RFC 6455 5.1)
+        if (!masked || length > COLLECTOR_WS_FRAME_MAX) {
+            conn.dead = true;
+            break;
+        }
+        if (available < headerSize + 4 + length) break;
+
+        const uint8_t* mask = bytes + headerSize;
+        const uint8_t* data = mask + 4;
+        std::string payload((size_t)length, '\0');
+        for (size_t i = 0; i < length; i++) payload[i] = (char)(data[i] ^ mask[i & 3]);
+        offset += headerSize + 4 + length;
+
+        switch (opcode) {
+            case WS_OPCODE_TEXT:
+                // Dashboard commands are tiny, fragmented messages are not expected
+                if (fin) handleClientMessage(conn, payload);
+                break;
+            case WS_OPCODE_PING:
+                sendFrame(conn, WS_OPCODE_PONG, payload);
+                break;
+            case WS_OPCODE_CLOSE:
+                sendFrame(conn, WS_OPCODE_CLOSE, std::string_view(payload).substr(0, 2));
+                conn.closing = true;
+                if (conn.out.empty()) conn.dead = true;
+                break;
+            case WS_OPCODE_CONTINUATION:
+            case WS_OPCODE_PONG:
+            default:
+                break;
+        }
+    }
+
+    conn.in.erase(0, offset);
+}
+
+void WebServer::handleClientMessage(Connection& conn, std::string_view message) {
+    JsonField fields[JSON_SCAN_MAX_FIELDS];
+    int count = scanJsonObject(message, fields, JSON_SCAN_MAX_FIELDS);
+    if (count < 0) return;
+
+    const JsonField* type = findJsonField(fields, count, "type");
+    const JsonField* command = findJsonField(fields, count, "command");
+    if (type == nullptr || type->value != "command" || command == nullptr) return;
+
+    // serial_bridge.py handle_client_command: only settime exists
+    if (command->value != "settime") return;
+
+    long hms[3] = {0, 0, 0};
+    const char* names[3] = {"hour", "minute", "second"};
+    for (int i = 0; i < 3; i++) {
+        const JsonField* field = findJsonField(fields, count, names[i]);
+        if (field != nullptr) jsonToLong(field->value, hms[i]);
+    }
+
+    char time[16];
+    snprintf(time, sizeof(time), "%02ld:%02ld:%02ld", hms[0] % 100, hms[1] % 100, hms[2] % 100);
+
+    std::string error = commandHandler ? commandHandler(std::string("SETTIME ") + time)
+                                       : std::string("Serial port not connected");
+
+    std::string response = "{\"type\":\"command_response\",\"command\":\"settime\",";
+    if (error.empty()) {
+        response += "\"success\":true,\"message\":\"Time set to ";
+        response += time;
+        response += " UTC\"}";
+    } else {
+        response += "\"success\":false,\"error\":";
+        appendJsonString(response, error);
+        response += '}';
+    }
+    sendFrame(conn, WS_OPCODE_TEXT, response);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FAN-OUT
+// ═══════════════════════════════════════════════════════════════════════════
+
+void WebServer::queueConsoleLine(std::string_view line, uint64_t wallMs) {
+    if (serverStats.clients == 0) return;
+
+    // A tick's worth of console output is bounded like a client backlog
+    if (consoleBatch.size() > COLLECTOR_CLIENT_BACKLOG) {
+        serverStats.consoleDropped += serverStats.clients;
+        return;
+    }
+
+    std::string payload;
+    payload.reserve(line.size() + 96);
+    payload += "{\"type\":\"serial\",\"line\":";
+    appendJsonString(payload, line);
+    payload += ",\"timestamp\":\"";
+    appendIsoTime(payload, wallMs);
+    payload += "\"}";
+
+    appendFrameHeader(consoleBatch, WS_OPCODE_TEXT, payload.size());
+    consoleBatch += payload;
+    consoleBatchLines++;
+    serverStats.consoleLines++;
+}
+
+void WebServer::tick() {
+    // Update messages by the version the client was last sent
+    std::unordered_map<uint64_t, std::string> updates;
+    uint64_t version = state.version();
+
+    for (auto& entry : connections) {
+        Connection& conn = entry.second;
+        if (!conn.websocket || conn.dead || conn.closing) continue;
+
+        // Slow clients skip console lines, their state diff just grows
+        bool backlogged = conn.out.size() > COLLECTOR_CLIENT_BACKLOG;
+
+        if (!consoleBatch.empty()) {
+            if (backlogged) {
+                serverStats.consoleDropped += consoleBatchLines;
+            } else {
+                serverStats.wsMessages += consoleBatchLines;
+                sendBytes(conn, consoleBatch);
+            }
+        }
+
+        if (conn.sentVersion < version && !backlogged) {
+            auto it = updates.find(conn.sentVersion);
+            if (it == updates.end()) {
+                it = updates.emplace(conn.sentVersion, std::string()).first;
+                buildState(it->second, "update", conn.sentVersion);
+                serverStats.updatesBuilt++;
+            }
+            sendFrame(conn, WS_OPCODE_TEXT, it->second);
+            conn.sentVersion = version;
+        }
+    }
+
+    consoleBatch.clear();
+    consoleBatchLines = 0;
+
+    // Drop connections whose writes failed
+    std::vector<int> dead;
+    for (auto& entry : connections) {
+        if (entry.second.dead) dead.push_back(entry.first);
+    }
+    for (int fd : dead) closeConnection(fd);
+}
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "sensor_math.h"
 
 // BMP180 I2C address
 #define BMP180_ADDR 0x77
@@ -41,8 +42,11 @@ private:
     uint8_t _oss;  // Oversampling setting
     
     // Calibration coefficients
-    int16_t ac1, ac2, ac3, b1, b2, mb, mc, md;
-    uint16_t ac4, ac5, ac6;
+    Bmp180Calibration _cal;
+
+    // Last read() (fixed-point, see sensor_math.h)
+    int16_t _temperatureC_x10;
+    int32_t _pressurePa;
     
     // Private methods
     bool readCalibrationData();
@@ -51,7 +55,6 @@ private:
     uint16_t readRegister16(uint8_t reg);
     int32_t readRawTemperature();
     int32_t readRawPressure();
-    int32_t computeB5(int32_t UT);
 
 public:
     // Constructor
@@ -62,6 +65,11 @@ public:
     float readTemperature();
     float readPressure();
     float readAltitude(float seaLevelPressure = 101325.0);
+
+    // One temperature + one pressure conversion, compensated in integer math
+    bool read();
+    int16_t getTemperatureC_x10();    // 0.1 °C
+    int32_t getPressurePa();
     
     // Raw data access
     int32_t getRawTemperature();
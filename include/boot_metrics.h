@@ -0,0 +1,130 @@
+#ifndef BOOT_METRICS_H
+#define BOOT_METRICS_H
+
+#include <Arduino.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BOOT METRICS CONFIGURATION                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define BOOT_MAX_PHASES             12      // Timed setup() phases
+#define BOOT_SERVICES_STACK_SIZE    8192    // Boot services task stack (WiFi scan, WebServer setup)
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ASYNC BOOT SERVICES                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Services brought up by the boot services task after the radio is listening
+ */
+enum BootService {
+    BOOT_SVC_DISPLAY = 0,       // OLED
+    BOOT_SVC_WIFI,              // WiFi + web dashboard (gateway)
+    BOOT_SVC_THINGSPEAK,        // Cloud uplink (gateway, needs WiFi)
+    BOOT_SVC_COUNT
+};
+
+enum BootServiceState {
+    BOOT_SVC_PENDING = 0,       // Not started yet
+    BOOT_SVC_STARTING,          // Initialization in progress
+    BOOT_SVC_READY,             // Up and usable
+    BOOT_SVC_FAILED,            // Initialization failed
+    BOOT_SVC_SKIPPED            // Not used on this node
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BOOT METRICS STRUCTURES                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * BootPhase - One timed step of setup()
+ */
+struct BootPhase {
+    const char* name;
+    uint32_t    startMs;
+    uint32_t    durationMs;
+};
+
+/**
+ * BootServiceStatus - Readiness of one async service
+ * State is written by the boot services task and read from loop().
+ */
+struct BootServiceStatus {
+    volatile uint8_t state;         // BootServiceState
+    uint32_t         startMs;       // millis() when initialization began
+    uint32_t         readyMs;       // millis() when it finished (ready or failed)
+};
+
+/**
+ * BootMetrics - Boot timeline (all times are millis() since reset)
+ */
+struct BootMetrics {
+    BootPhase         phases[BOOT_MAX_PHASES];
+    uint8_t           phaseCount;
+    BootServiceStatus services[BOOT_SVC_COUNT];
+    uint32_t          radioListeningMs;     // Radio in RX mode
+    uint32_t          setupDoneMs;          // setup() returned, loop() about to run
+    uint32_t          firstRxMs;            // First packet received (0 = none yet)
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FUNCTION DECLARATIONS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Start timing a setup() phase (ends the previous one if still open)
+ *
+ * @param name - Phase label (must be a string literal)
+ */
+void bootPhaseBegin(const char* name);
+
+/**
+ * End the current setup() phase
+ */
+void bootPhaseEnd();
+
+/**
+ * Record the moment the radio started listening
+ */
+void bootMarkRadioListening();
+
+/**
+ * Record the end of setup()
+ */
+void bootMarkSetupDone();
+
+/**
+ * Note a received packet (records time-to-first-RX once)
+ * Cheap enough to call for every packet.
+ */
+void bootNoteRx();
+
+/**
+ * Async service lifecycle (called from the boot services task)
+ */
+void bootServiceStarting(BootService service);
+void bootServiceDone(BootService service, bool ok);
+void bootServiceSkip(BootService service);
+
+/**
+ * Check if an async service finished initializing successfully
+ */
+bool isBootServiceReady(BootService service);
+
+/**
+ * Get the boot timeline
+ */
+const BootMetrics& getBootMetrics();
+
+/**
+ * Print boot phase timings, service readiness and time to first RX
+ */
+void printBootMetrics();
+
+/**
+ * Print the build role, the subsystems it links, flash / RAM use and boot
+ * times ('mesh build'; compare across the role environments)
+ */
+void printBuildInfo();
+
+#endif // BOOT_METRICS_H
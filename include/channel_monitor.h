@@ -0,0 +1,173 @@
+#ifndef CHANNEL_MONITOR_H
+#define CHANNEL_MONITOR_H
+
+#include <Arduino.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CHANNEL MONITOR CONFIGURATION                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#ifndef CHANNEL_RSSI_INTERVAL_MS
+#define CHANNEL_RSSI_INTERVAL_MS        50      // Instantaneous RSSI read while idle in RX
+#endif
+#ifndef CHANNEL_CAD_INTERVAL_MS
+#define CHANNEL_CAD_INTERVAL_MS         1000    // Channel activity detection (pauses RX ~2 ms)
+#endif
+#define CHANNEL_BUSY_MARGIN_DB          10      // Above noise floor + margin = channel in use
+#define CHANNEL_FLOOR_ALPHA             0.02f   // Noise floor EWMA weight per quiet sample
+#define CHANNEL_TREND_MINUTES           60      // Per-minute noise floor / occupancy history
+#define CHANNEL_BUCKET_MAX_SAMPLES      1200    // Halve a second's counts past this (~1 hour)
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CHANNEL MONITOR STRUCTURES                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * ChannelSecond - Samples taken in one second of the TDMA minute
+ *
+ * Counts decay (halve) once rssiSamples passes CHANNEL_BUCKET_MAX_SAMPLES,
+ * so the heatmap follows the last hour or so rather than all time.
+ */
+struct ChannelSecond {
+    uint16_t rssiSamples;
+    uint16_t busySamples;       // RSSI above noise floor + margin
+    int32_t  rssiSumDbm;        // For the mean
+    uint16_t cadScans;          // CAD run while RSSI looked quiet
+    uint16_t cadDetected;       // ... and found a LoRa preamble anyway
+};
+
+/**
+ * ChannelTrendPoint - One minute of samples
+ */
+struct ChannelTrendPoint {
+    uint32_t atMs;              // millis() at the end of the minute
+    int8_t   floorDbm;          // Noise floor estimate
+    int8_t   maxDbm;            // Strongest sample
+    uint8_t  busyPct;           // Samples above floor + margin
+    uint8_t  cadPct;            // CAD detections per quiet scan
+};
+
+/**
+ * ChannelSlotSummary - Seconds rolled up by TDMA slot (active layout)
+ */
+struct ChannelSlotSummary {
+    uint8_t  band;              // Depth band (always 0 in the ID-ordered layout)
+    uint8_t  deviceId;          // Slot owner
+    uint8_t  firstSecond;
+    uint8_t  lastSecond;
+    float    busyPct;
+    float    cadPct;
+    float    meanDbm;
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CHANNEL MONITOR CLASS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * ChannelMonitor - Noise floor and occupancy, measured without transmitting
+ *
+ * While the radio idles in RX, update() reads the instantaneous RSSI every
+ * CHANNEL_RSSI_INTERVAL_MS and runs a CAD every CHANNEL_CAD_INTERVAL_MS.
+ * Samples are bucketed by second of the TDMA minute (once time is synced),
+ * giving a per-slot occupancy heatmap: strong energy shows as busy RSSI,
+ * weak LoRa below the noise floor as CAD detections. CAD is skipped in our
+ * own slot, in the beacon sub-frame and whenever RSSI already says busy.
+ *
+ * Usage:
+ *   channelMonitor.update();             // From loop(), after RX handling
+ *   channelMonitor.getNoiseFloorDbm();
+ *   channelMonitor.printReport();        // 'mesh channel'
+ */
+class ChannelMonitor {
+private:
+    ChannelSecond seconds[60];
+
+    ChannelTrendPoint trend[CHANNEL_TREND_MINUTES];
+    uint8_t  trendHead;                 // Next write position
+    uint8_t  trendCount;
+
+    float    floorDbm;
+    bool     floorValid;
+    bool     cadEnabled;
+
+    unsigned long lastRssiMs;
+    unsigned long lastCadMs;
+    unsigned long minuteStartMs;
+
+    // Current minute
+    uint16_t minuteSamples;
+    uint16_t minuteBusy;
+    uint16_t minuteCadScans;
+    uint16_t minuteCadDetected;
+    int16_t  minuteMinDbm;
+    int16_t  minuteMaxDbm;
+
+    void addRssiSample(int16_t dbm, bool synced, uint8_t second);
+    void addCadSample(bool detected, bool synced, uint8_t second);
+    void closeMinute(unsigned long now);
+
+public:
+    ChannelMonitor();
+
+    /**
+     * Take due samples (cheap when nothing is due)
+     */
+    void update();
+
+    void clear();
+
+    void setCadEnabled(bool enabled);
+    bool isCadEnabled() const;
+
+    /**
+     * Noise floor estimate (dBm), -127 before the first sample
+     */
+    int16_t getNoiseFloorDbm() const;
+
+    /**
+     * Occupancy of the last full minute (0 before the first one ends)
+     */
+    uint8_t getBusyPercent() const;
+    uint8_t getCadPercent() const;
+
+    const ChannelSecond& getSecond(uint8_t second) const;
+
+    /**
+     * Get a trend point, 0 = most recent minute
+     * @return false if fewer than index + 1 are stored
+     */
+    bool getTrend(uint8_t index, ChannelTrendPoint& out) const;
+    uint8_t getTrendCount() const;
+
+    /**
+     * Roll the per-second buckets up by TDMA slot
+     * @return Number of slots written (at most maxSlots)
+     */
+    uint8_t getSlotSummaries(ChannelSlotSummary* out, uint8_t maxSlots) const;
+
+    void printReport() const;
+
+    /**
+     * {"noiseFloor":..,"seconds":[..],"slots":[..],"trend":[..]} for /channel
+     */
+    void printJson(Print& out) const;
+};
+
+/**
+ * Channel fields for the mesh_stats line: ,"noiseFloor":N,"chanBusyPct":N,"cadPct":N
+ */
+void printChannelJsonFields(Print& out);
+
+/**
+ * channelMonitor.printJson() as a String (/channel endpoint)
+ */
+String getChannelJson();
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+extern ChannelMonitor channelMonitor;
+
+#endif // CHANNEL_MONITOR_H
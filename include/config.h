@@ -6,12 +6,43 @@
 
 
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BUILD ROLE                                        ║
+// ║  Set by the platformio.ini environment: -D MESH_ROLE=MESH_ROLE_LEAF      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define MESH_ROLE_ANY               0   // Role from DEVICE_ID at runtime, everything linked
+#define MESH_ROLE_GATEWAY           1   // Beacons, uplink, WiFi dashboard
+#define MESH_ROLE_RELAY             2   // Sensors + forwarding, no WiFi
+#define MESH_ROLE_LEAF              3   // Sensors only, never forwards
+
+#ifndef MESH_ROLE
+#define MESH_ROLE                   MESH_ROLE_ANY
+#endif
+
+// WiFi, web dashboards, dashboard JSON cache and cloud uplink.
+// The relay and leaf environments also leave their sources out of the build.
+#define MESH_WITH_UPLINK            (MESH_ROLE == MESH_ROLE_ANY || MESH_ROLE == MESH_ROLE_GATEWAY)
+
+// Leaf nodes never relay reports or beacons
+constexpr bool ROLE_FORWARDS = (MESH_ROLE != MESH_ROLE_LEAF);
+
+extern const char* const BUILD_ROLE_NAME;   // "gateway", "relay", "leaf" or "any"
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GATEWAY CONFIGURATION                             ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-extern const uint8_t GATEWAY_NODE_ID;   // Which node ID hosts the dashboard
-extern const bool IS_GATEWAY;           // Auto-set: true if DEVICE_ID == GATEWAY_NODE_ID
+#define MAX_GATEWAYS                3   // Gateways a node can route toward
+
+extern const uint8_t GATEWAY_NODE_IDS[MAX_GATEWAYS];  // All gateway node IDs (0 = unused slot)
+extern const uint8_t GATEWAY_NODE_ID;   // Primary gateway (first entry of GATEWAY_NODE_IDS)
+#if MESH_ROLE == MESH_ROLE_ANY
+extern const bool IS_GATEWAY;           // Auto-set: true if DEVICE_ID is in GATEWAY_NODE_IDS
+#else
+constexpr bool IS_GATEWAY = (MESH_ROLE == MESH_ROLE_GATEWAY);   // Fixed by the build
+#endif
+extern const unsigned long UPLINK_CLAIM_WAIT_MS;  // How long a gateway waits for another gateway's upload claim
 extern const char* WIFI_AP_SSID;        // WiFi network name
 extern const char* WIFI_AP_PASSWORD;    // WiFi password (min 8 characters)
 // WiFi Mode: AP (Access Point) or STA (Station - join existing network)
@@ -61,6 +92,20 @@ extern const unsigned long SENSOR_READ_INTERVAL_MS;
 // Sea level pressure for altitude calculation (Pa) - adjust for local conditions
 extern const float SEA_LEVEL_PRESSURE_PA;
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GPS CONFIGURATION                                 ║
+// ║  NEO-6M on Serial2; UBX mode needs the ESP32 TX -> GPS RX wire           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define GPS_RX_PIN          46      // GPS TX -> ESP32
+#define GPS_TX_PIN          45      // ESP32 -> GPS RX (configuration only)
+#define GPS_BAUD            9600
+
+extern const bool GPS_UBX_MODE;                   // Binary NAV messages instead of NMEA (falls back if the GPS never answers)
+extern const bool GPS_FIXED_POSITION;             // Node never moves: GPS power save once time is locked
+extern const unsigned long GPS_POWER_SAVE_PERIOD_MS;  // Fix interval in power save (<= 10 s cyclic tracking, longer = ON/OFF)
+extern const unsigned long GPS_HOLDOVER_MAX_MS;   // GPS time runs on millis() this long without a fix
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         NETWORK CONFIGURATION                             ║
 // ║  These must be #define because they're used as array sizes               ║
@@ -81,6 +126,7 @@ extern const unsigned long DISPLAY_UPDATE_INTERVAL_MS;
 
 // Node health timing
 extern const unsigned long NODE_TIMEOUT_MS;
+extern const unsigned long NODE_EVICT_AGE_MS;
 
 // Status print intervals
 extern const unsigned long GPS_STATUS_INTERVAL_MS;
@@ -93,6 +139,15 @@ extern const unsigned long DUPLICATE_TIMEOUT_MS;
 // Neighbor table maintenance
 extern const unsigned long NEIGHBOR_PRUNE_INTERVAL_MS;
 
+// Gateway reorder window (multipath arrivals)
+extern const unsigned long REORDER_HOLD_MS;
+
+// Warm start (state kept across soft resets)
+extern const unsigned long WARM_START_SNAPSHOT_INTERVAL_MS;
+
+// Per-node receive / forward token buckets (budgets in rate_limiter.h, 'mesh ratelimit')
+extern const bool USE_RATE_LIMIT;
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GRADIENT ROUTING CONFIGURATION                    ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -102,17 +157,46 @@ extern const unsigned long BEACON_INTERVAL_MS;    // How often gateway sends bea
 extern const unsigned long ROUTE_TIMEOUT_MS;      // Route expiration time (ms)
 extern const unsigned long BEACON_REBROADCAST_MIN_MS;  // Min delay before beacon rebroadcast
 extern const unsigned long BEACON_REBROADCAST_MAX_MS;  // Max delay before beacon rebroadcast
-
-// ThingSpeak Configuration
-extern const char* THINGSPEAK_API_KEYS[];
+extern const bool USE_DEPTH_ORDERED_SLOTS;        // Order TDMA slots deepest-first (false = by device ID)
+extern const bool USE_BEACON_SUBFRAME;            // Beacons at minute start in per-depth micro-slots
+extern const bool USE_RELAY_SLOT_MONITOR;         // Relays also time neighbors' slots (gateway always does)
+
+// ThingSpeak Configuration (one channel per uploading node, looked up by node ID)
+struct ThingSpeakChannel {
+    uint8_t nodeId;
+    const char* writeKey;
+    unsigned long channelId;
+    const char* readKey;
+};
+extern const ThingSpeakChannel THINGSPEAK_CHANNELS[];
+extern const uint8_t THINGSPEAK_CHANNEL_COUNT;
 extern const bool THINGSPEAK_ENABLED;
-extern const unsigned long THINGSPEAK_CHANNEL_IDS[];
-extern const char* THINGSPEAK_READ_KEYS[];
+
+// Cloud uplink backend (default only - "mesh uplink" switches it at runtime)
+enum UplinkBackend : uint8_t {
+    UPLINK_OFF = 0,
+    UPLINK_THINGSPEAK = 1,      // One HTTP GET per report
+    UPLINK_MQTT = 2             // Batched QoS 1 publishes over one persistent session
+};
+extern const UplinkBackend UPLINK_DEFAULT_BACKEND;
+
+// MQTT uplink Configuration
+extern const char* MQTT_BROKER_HOST;
+extern const uint16_t MQTT_BROKER_PORT;
+extern const char* MQTT_USERNAME;           // Empty = no credentials
+extern const char* MQTT_PASSWORD;
+extern const char* MQTT_TOPIC_PREFIX;       // Reports go to <prefix>/gw<DEVICE_ID>/reports
+extern const uint16_t MQTT_KEEPALIVE_SEC;
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         TIME HELPER FUNCTIONS                             ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
+/**
+ * Check if a node ID is one of the configured gateways
+ */
+bool isGatewayId(uint8_t nodeId);
+
 void getLocalTime(int utcHour, int utcMin, int utcSec, int &localHour, int &localMin, int &localSec);
 String formatTime12Hr(int hour, int minute, int second);
 
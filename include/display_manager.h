@@ -51,7 +51,11 @@ extern unsigned long displayStateStart;
 // ║                         FUNCTION DECLARATIONS                             ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
+// Clears the shown messages; call on the loop() core before the boot
+// services task runs initDisplay() (which only touches the OLED)
+void resetDisplayState();
 bool initDisplay();
+bool isDisplayReady();
 void updateDisplay();
 void forceDisplayUpdate();
 void setDisplayState(DisplayState state);
@@ -8,7 +8,9 @@
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 #define SEEN_CACHE_SIZE 32                  // Number of recent messages to track
+#ifndef DUPLICATE_WINDOW_MS
 #define DUPLICATE_WINDOW_MS 120000          // 2 minutes - messages older than this are forgotten
+#endif
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         SEEN MESSAGE STRUCTURE                            ║
@@ -0,0 +1,125 @@
+#ifndef FEC_H
+#define FEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FORWARD ERROR CORRECTION                          ║
+// ║  Reed-Solomon erasure coding for groups of equal-sized frames             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * A group of n data frames is sent together with k repair frames. The
+ * receiver rebuilds the data from ANY n of the n + k frames, so a lost
+ * frame costs nothing unless more than k go missing - instead of a NACK
+ * and a resend one TDMA cycle (60 s) later.
+ *
+ * Code: systematic Cauchy Reed-Solomon over GF(2^8). Data frames go out
+ * unchanged (indices 0..n-1), repair frame j is index n + j. Every frame
+ * of a group must have the same length; pad the last one.
+ *
+ * No Arduino dependency outside runFecBenchmark(), so the same file builds
+ * on the PC (tools/fec_bench).
+ */
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FEC CONFIGURATION                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define FEC_MAX_DATA_FRAMES         32      // n per group
+#define FEC_MAX_REPAIR_FRAMES       16      // k per group
+#ifndef FEC_TARGET_DELIVERY
+#define FEC_TARGET_DELIVERY         0.99f   // Chance a group decodes without a resend round
+#endif
+#define FEC_MIN_LOSS_RATE           0.02f   // Floor for the planner (short loss histories read low)
+#define FEC_DEFAULT_LOSS_RATE       0.10f   // Link with no loss estimate yet
+#define FEC_SIM_MAX_ROUNDS          50      // Simulated transfers give up after this many cycles
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CODEC                                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Build the GF(256) tables (called on first use, cheap to call again)
+ */
+void fecInit();
+
+/**
+ * Compute k repair frames from n data frames
+ *
+ * @param data - n frames of len bytes
+ * @param repair - k output buffers of len bytes
+ * @return false if n or k is out of range
+ */
+bool fecEncode(const uint8_t* const* data, uint8_t n, uint8_t* const* repair, uint8_t k, uint16_t len);
+
+/**
+ * Rebuild missing data frames in place
+ *
+ * @param frames - n + k buffers of len bytes, data first; every data slot
+ *                 must be writable, received or not
+ * @param received - n + k flags
+ * @return true if all n data frames are now valid (n or more received)
+ */
+bool fecDecode(uint8_t* const* frames, const bool* received, uint8_t n, uint8_t k, uint16_t len);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REDUNDANCY PLANNING                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Smallest k for which n data frames arrive with FEC_TARGET_DELIVERY
+ * probability, given an independent per-frame loss rate
+ *
+ * @param lossRate - 0.0-1.0 (raised to FEC_MIN_LOSS_RATE)
+ * @return k, capped at FEC_MAX_REPAIR_FRAMES
+ */
+uint8_t fecRepairFrames(uint8_t n, float lossRate);
+
+/**
+ * Probability that at least n of n + k frames arrive
+ */
+float fecGroupDelivery(uint8_t n, uint8_t k, float lossRate);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         TRANSFER SIMULATION                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * FecSimResult - One group transferred many times over a lossy link
+ *
+ * A round is one TDMA cycle: the sender's slot, then the receiver's
+ * ACK/NACK in its own slot (lost at the same rate). Without FEC the
+ * sender resends the frames the last ACK reported missing. With FEC it
+ * sends n + k, then fresh repair frames for the reported shortfall.
+ * A lost ACK makes the sender repeat its previous round.
+ */
+struct FecSimResult {
+    float    meanRounds;        // Cycles until the receiver holds all data
+    uint8_t  p95Rounds;
+    float    framesPerData;     // Airtime: frames sent per data frame
+    float    failedPct;         // Transfers not done after FEC_SIM_MAX_ROUNDS
+};
+
+/**
+ * @param repairFrames - k for the first round; 0 = plain ARQ
+ */
+void fecSimulateTransfer(uint8_t n, uint8_t repairFrames, float lossRate,
+                         uint16_t trials, uint32_t seed, FecSimResult& out);
+
+#ifdef ARDUINO
+/**
+ * k for a group sent to one neighbor, from its measured link loss
+ * (FEC_DEFAULT_LOSS_RATE until the neighbor table has an estimate)
+ */
+uint8_t fecRepairFramesFor(uint8_t nodeId, uint8_t n);
+
+/**
+ * Encode/decode throughput on this chip, the completion-time simulation,
+ * and the plan for each current neighbor ('mesh bench fec')
+ */
+void runFecBenchmark();
+#endif
+
+#endif // FEC_H
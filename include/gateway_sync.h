@@ -0,0 +1,136 @@
+#ifndef GATEWAY_SYNC_H
+#define GATEWAY_SYNC_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "mesh_protocol.h"
+#include "lora_comm.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GATEWAY SYNC CONFIGURATION                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define UPLINK_CLAIM_MAX_ENTRIES    8    // Reports claimed per claim frame
+#define UPLINK_CLAIM_HEADER_SIZE    9    // MeshHeader + entry count
+#define UPLINK_DEFER_SLOTS          8    // Reports waiting for another gateway's claim
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UPLINK CLAIM MESSAGE                              ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * UplinkClaimEntry - One report a gateway has uploaded to the cloud
+ */
+struct UplinkClaimEntry {
+    uint8_t sourceId;
+    uint8_t messageId;
+} __attribute__((packed));
+
+/**
+ * UplinkClaimMsg - Gateway-to-gateway dedupe channel
+ *
+ * With several gateways in range, each one can hear the same FULL_REPORT.
+ * The gateway a report is addressed to (anycast destId) uploads it right
+ * away and lists it in its next claim frame. Other gateways that heard the
+ * report hold their upload for UPLINK_CLAIM_WAIT_MS and drop it once the
+ * claim arrives - or upload it themselves if the claim never comes (the
+ * addressed gateway missed the report or is down).
+ *
+ * Claims are batched and sent from the gateway's own TDMA slot through the
+ * transmit queue. Relays flood them so every gateway hears them.
+ * Nothing is sent when only one gateway is configured.
+ *
+ * Total size: 8 bytes (MeshHeader) + 1 byte (count) + 2 bytes per entry
+ */
+struct UplinkClaimMsg {
+    MeshHeader       meshHeader;
+    uint8_t          count;
+    UplinkClaimEntry entries[UPLINK_CLAIM_MAX_ENTRIES];
+} __attribute__((packed));
+
+static_assert(sizeof(UplinkClaimMsg) == UPLINK_CLAIM_HEADER_SIZE + 2 * UPLINK_CLAIM_MAX_ENTRIES,
+              "UplinkClaimMsg layout mismatch");
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GATEWAY SYNC STATISTICS                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct GatewaySyncStats {
+    unsigned long uploadsDirect;       // Reports addressed to us, uploaded immediately
+    unsigned long uploadsDeferred;     // Reports held for another gateway's claim
+    unsigned long uploadsAfterWait;    // Deferred reports uploaded (no claim arrived)
+    unsigned long uploadsSuppressed;   // Reports another gateway already uploaded
+    unsigned long claimFramesSent;     // Claim frames queued for transmission
+    unsigned long claimEntriesSent;    // Reports claimed by us
+    unsigned long claimEntriesHeard;   // Reports claimed by other gateways
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FUNCTION DECLARATIONS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Initialize gateway sync (clears deferred uploads, claims and statistics)
+ */
+void initGatewaySync();
+
+/**
+ * Get the number of gateways configured in GATEWAY_NODE_IDS
+ */
+uint8_t getConfiguredGatewayCount();
+
+/**
+ * Upload a report to the cloud, coordinating with other gateways
+ *
+ * Uploads now when the report is addressed to this gateway (or flooded and
+ * we are the primary gateway), otherwise defers it until a claim arrives
+ * or UPLINK_CLAIM_WAIT_MS expires.
+ *
+ * @param report - Decoded FULL_REPORT (first copy)
+ * @param rssi - RSSI the report was received with
+ */
+void gatewayUplinkReport(const FullReportMsg& report, float rssi);
+
+/**
+ * Upload deferred reports whose claim window expired
+ * Call regularly from the main loop (gateway only).
+ */
+void gatewaySyncUpdate();
+
+/**
+ * Queue a claim frame for the reports uploaded since the last slot
+ * Call once per TDMA slot, after the primary report and before forwards.
+ *
+ * @return number of reports claimed
+ */
+uint8_t gatewaySyncOnSlot();
+
+/**
+ * Duplicate check for claim frames (marks the frame as seen)
+ * Kept separate from the main duplicate cache so claim IDs never shadow
+ * the gateway's FULL_REPORT message IDs.
+ *
+ * @return true if this claim frame was already seen
+ */
+bool isUplinkClaimDuplicate(uint8_t sourceId, uint8_t messageId);
+
+/**
+ * Apply a claim frame received from another gateway
+ *
+ * @param data - Encoded claim frame
+ * @param length - Frame length
+ * @return true if the frame was valid
+ */
+bool applyUplinkClaim(const uint8_t* data, uint8_t length);
+
+/**
+ * Get gateway sync statistics
+ */
+GatewaySyncStats getGatewaySyncStats();
+
+/**
+ * Print gateway list, routes and dedupe statistics
+ */
+void printGatewaySyncStatus();
+
+#endif // GATEWAY_SYNC_H
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "mesh_protocol.h"
+#include "config.h"
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GRADIENT ROUTING                                  ║
@@ -16,11 +17,25 @@
 // ║    - BEACON_INTERVAL_MS                                                   ║
 // ║    - ROUTE_TIMEOUT_MS                                                     ║
 // ║    - BEACON_REBROADCAST_MIN_MS / MAX_MS                                   ║
+// ║    - USE_BEACON_SUBFRAME                                                  ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 // Unknown distance value (no route established)
 #define DISTANCE_UNKNOWN            255
 
+// Gateways tracked per node (one gradient per gateway)
+#define ROUTE_TABLE_SIZE            MAX_GATEWAYS
+
+// Beacon sub-frame (USE_BEACON_SUBFRAME): seconds 0-3 of every minute.
+// The gateway transmits at 0 ms; a relay at depth d transmits in micro-slot
+// d * BEACON_DEPTH_SLOT_MS, staggered by device ID. Relays time their slot
+// from the beacon they heard (its sender's slot is known), so relaying
+// needs no synced clock and the beacon itself carries the sub-second phase.
+#define BEACON_DEPTH_SLOT_MS        500     // Micro-slot per hop of depth (3 hops = 1.5s)
+#define BEACON_ID_SPACING_MS        90      // Stagger inside a micro-slot (5 nodes = 450ms)
+#define BEACON_AIRTIME_MS           67      // 27-byte frame at SF7/125kHz/CR4:5
+#define BEACON_PHASE_TOLERANCE_MS   40      // Relay later than this misses its micro-slot
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         ROUTING STATE                                     ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -28,8 +43,11 @@
 /**
  * RoutingState - Stores gradient routing information for this node
  *
- * Each node maintains its distance to the gateway and the best
- * next-hop neighbor for forwarding data toward the gateway.
+ * Each node keeps one RoutingState per gateway it hears beacons from
+ * (its distance to that gateway and the best next-hop toward it).
+ * Gateway-bound traffic is anycast to the gateway with the lowest cost:
+ * fewest hops first, strongest RSSI as tiebreak. When that gateway's
+ * route expires the next best one takes over automatically.
  */
 struct RoutingState {
     uint8_t  distanceToGateway;    // Hop count (255 = unknown/no route)
@@ -47,6 +65,7 @@ struct RoutingState {
 
 /**
  * RoutingStats - Track gradient routing performance
+ * Counters live in the metrics registry; getRoutingStats() copies them.
  */
 struct RoutingStats {
     unsigned long beaconsReceived;     // Total beacons received
@@ -55,6 +74,22 @@ struct RoutingStats {
     unsigned long unicastForwards;     // Packets forwarded via gradient routing
     unsigned long floodingFallbacks;   // Times we fell back to flooding
     unsigned long routeExpirations;    // Times route expired
+    unsigned long gatewaySwitches;     // Times the selected gateway changed (failover/better cost)
+    unsigned long beaconSlotMisses;    // Sub-frame relays dropped (micro-slot already passed)
+    unsigned long beaconsOutOfPhase;   // Beacons heard outside the sub-frame while synced
+    unsigned long beaconsDuplicate;    // Echoes of the current beacon (dropped)
+    unsigned long beaconsStale;        // Older sequence or gateway epoch (dropped)
+    unsigned long gatewayReboots;      // Gateway epoch increases seen
+};
+
+/**
+ * BeaconCheck - Result of the per-gateway beacon freshness check
+ */
+enum BeaconCheck {
+    BEACON_FRESH = 0,           // Newer beacon: update routing and time, relay it
+    BEACON_ROUTE_COPY,          // Current beacon via an equal or shorter path: routing only
+    BEACON_DUPLICATE,           // Current beacon echoed from deeper in the mesh
+    BEACON_STALE                // Older sequence or older gateway epoch
 };
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -94,7 +129,7 @@ void updateRoutingState(uint8_t senderDistance, uint8_t senderId, uint8_t gatewa
 void checkRouteExpiration();
 
 /**
- * Manually invalidate the current route
+ * Manually invalidate all gateway routes
  * Forces fallback to flooding until new beacon received
  */
 void invalidateRoute();
@@ -111,16 +146,32 @@ bool hasValidRoute();
 
 /**
  * Get the next hop node ID for gateway-bound traffic
- * @return Node ID of next hop, or 0 if no route
+ * @return Node ID of next hop toward the selected gateway, or 0 if no route
  */
 uint8_t getNextHop();
 
 /**
- * Get our current distance to the gateway
+ * Get the next hop toward a specific gateway
+ * Falls back to the selected (lowest cost) gateway if we have no
+ * valid route to the requested one.
+ *
+ * @param gatewayId  Gateway the packet is addressed to
+ * @return Node ID of next hop, or 0 if no route
+ */
+uint8_t getNextHopFor(uint8_t gatewayId);
+
+/**
+ * Get our current distance to the selected gateway
  * @return Hop count (255 = unknown)
  */
 uint8_t getDistanceToGateway();
 
+/**
+ * Get the gateway our own reports should be addressed to (anycast)
+ * @return Selected gateway ID, or ADDR_BROADCAST when no route (flooding)
+ */
+uint8_t getAnycastGateway();
+
 /**
  * Check if this node is the gateway
  * @return true if DEVICE_ID == ADDR_GATEWAY
@@ -129,22 +180,80 @@ bool isGateway();
 
 /**
  * Get full routing state (for debugging/dashboard)
- * @return Copy of current routing state
+ * @return Copy of the selected (lowest cost) gateway route
  */
 RoutingState getRoutingState();
 
+/**
+ * Get the route to one tracked gateway
+ *
+ * @param index  0 to ROUTE_TABLE_SIZE-1
+ * @param state  Output: route for that gateway
+ * @return true if the table slot is in use
+ */
+bool getGatewayRoute(uint8_t index, RoutingState& state);
+
+/**
+ * Restore a gateway route saved before a reset
+ * The route keeps its remaining lifetime: it is backdated by ageMs and
+ * rejected if already past ROUTE_TIMEOUT_MS. Beacons always win over it.
+ *
+ * @param route  Saved route (gatewayId, distance, nextHop, RSSI, seq)
+ * @param ageMs  Time since the route's last beacon
+ * @return true if the route was restored
+ */
+bool restoreGatewayRoute(const RoutingState& route, unsigned long ageMs);
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Beacon Handling
 // ─────────────────────────────────────────────────────────────────────────────
 
 /**
- * Schedule a beacon for rebroadcast after random delay
- * Only non-gateway nodes should call this
+ * Classify a received beacon against the newest one seen from its gateway
+ * Call before updateRoutingState(). Only BEACON_FRESH beacons should update
+ * network time and be rebroadcast; BEACON_ROUTE_COPY may still improve the
+ * route (same or fewer hops than the first copy, RSSI tiebreak).
+ *
+ * A gateway we have not accepted a beacon from within ROUTE_TIMEOUT_MS is
+ * resynchronized on its next beacon, so a gateway that lost its epoch
+ * (NVS erased) is only ignored until then.
+ *
+ * @param beacon  Decoded beacon
+ * @return freshness class (also counted in RoutingStats)
+ */
+BeaconCheck checkBeaconFreshness(const BeaconMsg& beacon);
+
+/**
+ * Schedule a beacon for rebroadcast
+ * Only non-gateway nodes should call this, and only for BEACON_FRESH
+ * beacons. Each gateway's beacon has its own pending slot.
+ * Sub-frame beacons are relayed in our depth micro-slot, others after a
+ * random BEACON_REBROADCAST_MIN_MS..MAX_MS delay.
  *
  * @param receivedBeacon  The beacon we received
- * @param rssi            RSSI of received beacon
+ * @param receivedAtMs    millis() when the beacon finished arriving
+ */
+void scheduleBeaconRebroadcast(const BeaconMsg& receivedBeacon, unsigned long receivedAtMs);
+
+/**
+ * Check if a beacon was sent in the sub-frame (gateway time at second 0)
+ * Its phase within the minute is then known from the sender's micro-slot.
+ */
+bool isSubframeBeacon(const BeaconMsg& beacon);
+
+/**
+ * Get a node's beacon micro-slot, in ms from the start of the minute
+ *
+ * @param distanceToGateway  Node's depth (0 = gateway)
+ * @param nodeId             Node's device ID (ignored for the gateway)
+ */
+uint16_t getBeaconSlotOffsetMs(uint8_t distanceToGateway, uint8_t nodeId);
+
+/**
+ * Count a beacon heard outside the sub-frame while our slots are synced
+ * (a sender out of phase with the TDMA frame)
  */
-void scheduleBeaconRebroadcast(const BeaconMsg& receivedBeacon, int16_t rssi);
+void noteBeaconOutOfPhase();
 
 /**
  * Check if there's a pending beacon ready to send
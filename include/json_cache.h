@@ -0,0 +1,97 @@
+#ifndef JSON_CACHE_H
+#define JSON_CACHE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "node_store.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         JSON CACHE CONFIGURATION                          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define JSON_NODE_FRAGMENT_SIZE     576     // Format buffer: ~120 node fields + SCHEMA_REPORT_JSON_MAX
+#define JSON_BENCH_REPEATS          20      // Responses built per benchmark point
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         JSON CACHE STRUCTURES                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * NodeJsonFragment - Pre-serialised dashboard JSON for one node
+ *
+ * Holds everything after "online" in the node's object of the /data
+ * response (online depends on the current time, so it is added when the
+ * response is assembled). The text is regenerated only when the node's
+ * snapshot has a new publishCount, at most once per change.
+ *
+ * One fragment per node table slot. text is on the heap and sized to the
+ * longest fragment the slot has held, so empty slots cost no text.
+ *
+ * version is taken from a global counter when the node changes, so a
+ * client that saw version V only needs the nodes with version > V.
+ */
+struct NodeJsonFragment {
+    char*    text;          // Heap, nullptr until the slot's first node
+    uint16_t capacity;      // Bytes allocated for text
+    uint16_t length;
+    uint32_t version;       // Global version of the node's last change
+    uint32_t publishCount;  // Snapshot publishCount the text was built from
+    uint8_t  nodeId;        // Node the text belongs to (slots are reused after eviction)
+    bool     online;        // Online state in the last response
+};
+
+struct JsonCacheStats {
+    unsigned long responses;        // Responses assembled
+    unsigned long fragmentsBuilt;   // Fragments (re)serialised
+    unsigned long fragmentsReused;  // Fragments copied from the cache
+    unsigned long lastResponseUs;   // Time to assemble the last response
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FUNCTION DECLARATIONS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Initialize the cache (no fragments built, version 0)
+ */
+void initJsonCache();
+
+/**
+ * Get the global version (version of the newest change)
+ */
+uint32_t getJsonCacheVersion();
+
+/**
+ * Append the members of the "nodes" object ("1":{...},"2":{...})
+ * Visits live nodes only.
+ *
+ * @param json - Response being built
+ * @param since - Only nodes changed after this version (0 = all nodes)
+ * @return number of nodes appended
+ */
+uint16_t appendNodesJson(String& json, uint32_t since);
+
+/**
+ * Format one node's fragment (shared by the cache and the benchmark)
+ *
+ * @return fragment length (0 if bufferSize cannot hold the worst case)
+ */
+uint16_t formatNodeFragment(char* buffer, size_t bufferSize, const NodeSnapshot& node);
+
+/**
+ * Record the time the last response took to assemble
+ */
+void jsonCacheNoteResponse(unsigned long elapsedUs);
+
+/**
+ * Get cache statistics
+ */
+JsonCacheStats getJsonCacheStats();
+
+/**
+ * Time /data responses for 5 and 100 nodes, re-serialising every node
+ * versus concatenating cached fragments, and print the cache statistics
+ */
+void runJsonBenchmark();
+
+#endif // JSON_CACHE_H
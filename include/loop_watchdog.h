@@ -0,0 +1,141 @@
+#ifndef LOOP_WATCHDOG_H
+#define LOOP_WATCHDOG_H
+
+#include <Arduino.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         LOOP WATCHDOG CONFIGURATION                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#ifndef LOOP_STALL_BUDGET_MS
+#define LOOP_STALL_BUDGET_MS        50      // One loop() iteration should finish within this
+#endif
+#define LOOP_TX_ALLOWANCE_MS        1500    // Blocking TX time (own report + forwards) not charged to the budget
+#define LOOP_STALL_HISTORY          16      // Overruns kept for 'mesh stalls'
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         INSTRUMENTED SECTIONS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Parts of loop() the watchdog times separately
+ * Keep LOOP_SECTION_NAMES in loop_watchdog.cpp in the same order.
+ */
+enum LoopSection {
+    LOOP_SEC_SERIAL = 0,        // SETTIME and 'mesh' commands
+    LOOP_SEC_GPS,               // NMEA/UBX parsing
+    LOOP_SEC_TDMA,              // Scheduler update, slot entry/exit prints
+    LOOP_SEC_SENSORS,           // SHT30 / BMP180 reads
+    LOOP_SEC_STATUS,            // GPS status line, node timeouts, periodic stats
+    LOOP_SEC_BEACON,            // Gateway beacons and rebroadcasts
+    LOOP_SEC_UPLINK,            // Gateway sync, cloud uplink, warm start
+    LOOP_SEC_PRUNE,             // Neighbor / duplicate / queue pruning
+    LOOP_SEC_RX,                // checkForIncomingMessages()
+    LOOP_SEC_TX,                // Own report and queued forwards
+    LOOP_SEC_DISPLAY,           // OLED
+    LOOP_SEC_WEB,               // Web dashboard handleClient()
+    LOOP_SEC_OTHER,             // Anything between instrumented blocks
+    LOOP_SEC_COUNT
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         LOOP WATCHDOG STRUCTURES                          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * LoopStall - One iteration that went over budget
+ */
+struct LoopStall {
+    uint32_t atMs;              // millis() when the iteration started
+    uint32_t totalUs;           // Whole iteration
+    uint32_t chargedUs;         // Iteration minus allowed TX time
+    uint8_t  culprit;           // LoopSection running when the budget ran out
+    uint32_t culpritUs;         // Time spent in that section
+    uint8_t  longest;           // Slowest section of the iteration
+    uint32_t longestUs;
+};
+
+/**
+ * LoopWatchdogStats - Totals since boot or 'mesh stalls clear'
+ */
+struct LoopWatchdogStats {
+    uint32_t iterations;
+    uint32_t overruns;
+    uint32_t worstUs;                               // Slowest charged iteration
+    uint32_t sectionMaxUs[LOOP_SEC_COUNT];          // Slowest single pass per section
+    uint32_t sectionBlamed[LOOP_SEC_COUNT];         // Overruns attributed per section
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         LOOP WATCHDOG CLASS                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Soft watchdog for one loop (main loop or a task's loop body)
+ *
+ * Call startIteration() at the top of the loop, enterSection() before each
+ * instrumented block and endIteration() at the bottom; time between blocks
+ * counts as LOOP_SEC_OTHER. TX time up to LOOP_TX_ALLOWANCE_MS per
+ * iteration is expected (radio airtime) and is not charged. The section
+ * running when the charged time passes the budget gets the blame.
+ * Costs one micros() read per section; nothing is printed on overrun.
+ */
+class LoopWatchdog {
+private:
+    uint32_t budgetUs;
+    uint32_t iterationStartUs;
+    uint32_t sectionStartUs;
+    uint32_t chargedUs;                             // Charged time of closed sections
+    uint32_t sectionUs[LOOP_SEC_COUNT];             // This iteration
+    uint8_t  current;                               // Open section
+    uint8_t  culprit;                               // LOOP_SEC_COUNT until the budget runs out
+
+    LoopStall history[LOOP_STALL_HISTORY];
+    uint8_t   historyHead;                          // Next write position
+    uint8_t   historyCount;
+
+    LoopWatchdogStats stats;
+
+    void closeSection(uint32_t nowUs);
+
+public:
+    LoopWatchdog();
+
+    void startIteration();
+    void enterSection(LoopSection section);
+    void endIteration();
+
+    void setBudgetMs(uint32_t ms);
+    uint32_t getBudgetMs() const;
+
+    const LoopWatchdogStats& getStats() const;
+
+    /**
+     * Get a recorded overrun, 0 = most recent
+     * @return false if fewer than index + 1 are stored
+     */
+    bool getStall(uint8_t index, LoopStall& out) const;
+    uint8_t getStallCount() const;
+
+    void clear();
+    void printReport() const;
+};
+
+/**
+ * Section label for reports and JSON ("?" if out of range)
+ */
+const char* loopSectionName(uint8_t section);
+
+/**
+ * Overrun counters as JSON fields: ,"loopStalls":N,"loopWorstMs":N,...
+ * (appended to the mesh_stats line)
+ */
+void printLoopWatchdogJsonFields(Print& out);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+extern LoopWatchdog loopWatchdog;      // main loop()
+
+#endif // LOOP_WATCHDOG_H
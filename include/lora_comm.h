@@ -73,6 +73,7 @@ struct LoRaReceivedPacket {
     String payload;              // String version (for legacy/text messages)
     float rssi;
     float snr;
+    unsigned long receivedAtMs;  // millis() when the radio signalled RX done
 };
 
 // LoRa communication functions
@@ -89,6 +90,60 @@ bool isLoRaReady();
 // LoRa status functions
 float getLastRSSI();
 float getLastSNR();
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RX PATH                                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Bytes read from the FIFO before the filter runs (LoRa header + MeshHeader)
+const size_t LORA_RX_HEAD_SIZE = LORA_HEADER_SIZE + sizeof(MeshHeader);
+
+// RX header filter - decides from the headers alone whether a frame is worth
+// reading. Gets the LoRa header and the start of the payload (the MeshHeader
+// when headLen >= 8). Return false to drop the frame with its payload still
+// in the radio FIFO. Called from receivePacket(), i.e. from loop().
+typedef bool (*RxHeaderFilter)(const LoRaPacketHeader& header, const uint8_t* payloadHead, uint8_t headLen);
+
+// Install the RX header filter (nullptr = read every frame)
+void setRxHeaderFilter(RxHeaderFilter filter);
+
+// RX path statistics (SPI and CPU time per received frame)
+struct RadioRxStats {
+    unsigned long framesRead;       // Frames read completely and returned
+    unsigned long framesFiltered;   // Dropped by the header filter (payload not read)
+    unsigned long framesOwn;        // Our own frames (dropped after the header)
+    unsigned long framesInvalid;    // CRC error or bad length
+    unsigned long bytesRead;        // Bytes transferred from the FIFO
+    unsigned long bytesSkipped;     // Payload bytes never transferred
+    unsigned long spiTimeUs;        // Time in SPI transfers (status, FIFO, RSSI/SNR)
+    unsigned long rxTimeUs;         // Time in receivePacket() per frame, total
+    unsigned long maxSpiUs;         // Worst single frame
+    unsigned long maxRxUs;
+    uint32_t      spiClockHz;       // Radio SPI clock
+};
+
+// Get RX path statistics
+RadioRxStats getRadioRxStats();
+
+// Print RX path statistics
+void printRadioRxStats();
+
+// Time on air (ms) of a frame carrying payloadLen mesh bytes (LoRa header added)
+uint32_t getFrameAirtimeMs(size_t payloadLen);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CHANNEL SAMPLING                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Instantaneous RSSI (dBm) while listening; reception is not disturbed.
+// Returns 0 if the radio is not ready.
+float sampleChannelRssi();
+
+// Channel activity detection: looks for a LoRa preamble, then restarts RX.
+// Pauses reception for about 2 ms (CAD at SF7). Skipped while a received
+// frame waits to be read.
+// Returns 1 = activity, 0 = free, -1 = not sampled
+int8_t sampleChannelActivity();
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         FULL_REPORT ENCODING                              ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -97,6 +152,10 @@ float getLastSNR();
 // Returns: number of bytes written (38 bytes: 8-byte MeshHeader + 30-byte payload)
 uint8_t encodeFullReport(uint8_t* buffer, const FullReportMsg& report);
 
+// Mesh messageId counter (persisted across resets by warm_start)
+uint8_t getMeshMessageSeq();
+void setMeshMessageSeq(uint8_t seq);
+
 // Decode a FULL_REPORT message from buffer
 // Returns: true if valid FULL_REPORT, false otherwise
 bool decodeFullReport(const uint8_t* buffer, uint8_t length, FullReportMsg& report);
@@ -109,7 +168,7 @@ MessageType getMessageType(const uint8_t* buffer, uint8_t length);
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 // Encode a BEACON message into buffer
-// Returns: number of bytes written (12 bytes: 8-byte MeshHeader + 4-byte payload)
+// Returns: number of bytes written (21 bytes: 8-byte MeshHeader + 13-byte payload)
 uint8_t encodeBeacon(uint8_t* buffer, const BeaconMsg& beacon);
 
 // Decode a BEACON message from buffer
@@ -15,6 +15,29 @@
  *   mesh stats   - Print detailed mesh statistics
  *   mesh reset   - Clear all caches and reset statistics
  *   mesh test    - Send test message with configurable TTL
+ *   mesh load    - Traffic generator / capacity test (start, ramp, report)
+ *   mesh gateways - Gateway routes, anycast target and upload dedupe
+ *   mesh reorder - Gateway reorder window and per-path stats
+ *   mesh warmstart - Reset reason, restored state, time to first report
+ *   mesh boot    - Boot phase timings, async services, time to first RX
+ *   mesh build   - Build role, linked subsystems, flash / RAM use, boot time
+ *   mesh latency - Report age at the gateway by hop count
+ *   mesh radio   - RX path: header-filtered frames, SPI/CPU time per frame
+ *   mesh nodes   - Node table occupancy, evictions, memory per node
+ *   mesh stalls  - loop() overruns and the section that caused them
+ *   mesh channel - Noise floor, per-slot occupancy heatmap (RSSI + CAD)
+ *   mesh slots   - Per-node TX timing vs the schedule, flags, corrections
+ *   mesh ratelimit - Per-node RX/forward token buckets, drops, runtime limits
+ *   mesh gps     - GPS receiver mode, power save, UART bytes/s, parse time
+ *   mesh metrics - Metrics registry as a table, JSON line or Prometheus text
+ *   mesh uplink  - Cloud uplink stats, switch ThingSpeak / MQTT / off (gateway builds)
+ *   mesh schema lua - Wireshark dissector generated from the message schema
+ *   mesh bench json - Dashboard JSON time, full vs cached node fragments
+ *   mesh bench snapshot - Node snapshot stress test (torn reads across cores)
+ *   mesh bench uplink - ThingSpeak GET vs batched MQTT throughput and latency
+ *   mesh bench codec - Schema-generated vs hand-written codec and JSON time
+ *   mesh bench fec - FEC encode/decode throughput and ARQ vs FEC completion time
+ *   mesh bench sensors - Cycles per sample, float vs fixed-point sensor math
  *   mesh help    - Show command help
  *
  * Usage:
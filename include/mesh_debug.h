@@ -227,6 +227,11 @@ inline void debugLogDuplicate(uint8_t sourceId, uint8_t messageId, bool isDup) {
 inline void debugLogSlotTiming(const char* event, uint8_t currentSecond, uint8_t slotStart, uint8_t slotEnd) {
 #if DEBUG_MESH_TIMING
     DEBUG_TIME_F("%s | sec=%d slot=[%d-%d]", event, currentSecond, slotStart, slotEnd);
+#else
+    (void)event;
+    (void)currentSecond;
+    (void)slotStart;
+    (void)slotEnd;
 #endif
 }
 
@@ -26,6 +26,8 @@ enum MessageType : uint8_t {
     MSG_ROUTED_DATA = 0x02,  // General routed data packet (variable payload)
     MSG_ACK         = 0x03,  // Acknowledgment message (confirms receipt)
     MSG_BEACON      = 0x0A,  // Gradient routing beacon (gateway distance advertisement)
+    MSG_LOAD_TEST   = 0x0B,  // Synthetic traffic generator frame (capacity testing)
+    MSG_UPLINK_CLAIM = 0x0C, // Gateway-to-gateway cloud upload claims (dedupe)
 
     // Legacy message types (for backward compatibility)
     MSG_HEARTBEAT   = 0x04,  // Simple heartbeat/keepalive
@@ -144,7 +146,22 @@ static_assert(sizeof(MeshHeader) == 8, "MeshHeader must be exactly 8 bytes");
  * NEW: Beacons now include GPS timestamp for network time synchronization.
  * Nodes without GPS lock can use this time to participate in TDMA scheduling.
  *
- * Total size: 8 bytes (MeshHeader) + 8 bytes (payload) = 16 bytes
+ * Total size: 8 bytes (MeshHeader) + 13 bytes (payload) = 21 bytes
+ *
+ * Freshness:
+ * ----------
+ * epoch is the gateway's boot count and sequenceNumber counts beacons
+ * within that boot, so (epoch, sequence) only ever increases. Nodes keep
+ * the newest pair per gateway and drop older beacons (e.g. still in flight
+ * from before a gateway reboot) and echoes of the current one before they
+ * touch routing or time. Old 16-byte beacons decode with epoch 0.
+ *
+ * Slot correction:
+ * ----------------
+ * The gateway times every report it hears directly against the TDMA
+ * schedule (slot_monitor.h). A node running late or early on network time
+ * is named in correctionNodeId and adds correctionMs to its clock. Relays
+ * copy both fields unchanged; 18-byte beacons decode with no correction.
  *
  * Beacon Propagation:
  * -------------------
@@ -153,13 +170,14 @@ static_assert(sizeof(MeshHeader) == 8, "MeshHeader must be exactly 8 bytes");
  * 3. Nodes store best route (lowest distance, or best RSSI as tiebreaker)
  * 4. Nodes WITHOUT GPS lock extract time for TDMA scheduling
  * 5. Nodes rebroadcast beacon with incremented distance after random delay
+ *    (or in their depth micro-slot, see gradient_routing.h)
  * 6. Process repeats until all reachable nodes have routes
  *
  * Route Selection:
  * ----------------
  * - Primary: Choose lowest hop count to gateway
  * - Tiebreaker: If equal hop count, choose strongest RSSI
- * - Expiration: Routes expire after ROUTE_TIMEOUT_MS (default 60s)
+ * - Expiration: Routes expire after ROUTE_TIMEOUT_MS (default 150s)
  *
  * Time Sync Priority:
  * -------------------
@@ -181,9 +199,16 @@ struct BeaconMsg {
     uint8_t  gpsMinute;             // Gateway's GPS minute (0-59)
     uint8_t  gpsSecond;             // Gateway's GPS second (0-59)
     uint8_t  gpsValid;              // 1 = GPS time valid, 0 = invalid
+
+    // Beacon payload - freshness (2 bytes)
+    uint16_t epoch;                 // Gateway boot count (sequence restarts each boot)
+
+    // Beacon payload - slot timing correction (3 bytes)
+    uint8_t  correctionNodeId;      // Node to correct (0 = none)
+    int16_t  correctionMs;          // Add to that node's network time (+ = it runs late)
 } __attribute__((packed));
 
 // Compile-time assertion to verify beacon size
-static_assert(sizeof(BeaconMsg) == 16, "BeaconMsg must be exactly 16 bytes");
+static_assert(sizeof(BeaconMsg) == 21, "BeaconMsg must be exactly 21 bytes");
 
 #endif // MESH_PROTOCOL_H
@@ -0,0 +1,156 @@
+#ifndef MESH_SCHEMA_H
+#define MESH_SCHEMA_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "mesh_protocol.h"
+#include "lora_comm.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MESSAGE SCHEMA                                    ║
+// ║  One field list per message; codecs, JSON and the dissector expand it     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Each entry is X(type, field, jsonKey, jsonFormat), in wire order.
+ *
+ *   type       - C type of the struct member (wire size = sizeof(type))
+ *   field      - member name in the message struct
+ *   jsonKey    - key in node_data lines and dashboard /data ("" = none)
+ *   jsonFormat - NONE, INT, X10 (one decimal) or X1E6 (six decimals)
+ *
+ * Mesh payloads are little-endian. Adding a field here updates the
+ * encoder, decoder, JSON and dissector together; the struct in
+ * mesh_protocol.h / lora_comm.h must get the same member, and the
+ * static_asserts below catch a mismatch in size.
+ */
+
+#define MESH_HEADER_SCHEMA(X) \
+    X(uint8_t,  version,            "",             NONE) \
+    X(uint8_t,  messageType,        "",             NONE) \
+    X(uint8_t,  sourceId,           "meshSourceId", INT)  \
+    X(uint8_t,  destId,             "",             NONE) \
+    X(uint8_t,  senderId,           "meshSenderId", INT)  \
+    X(uint8_t,  messageId,          "meshMsgId",    INT)  \
+    X(uint8_t,  ttl,                "meshTtl",      INT)  \
+    X(uint8_t,  flags,              "",             NONE)
+
+#define FULL_REPORT_SCHEMA(X) \
+    X(int16_t,  temperatureF_x10,   "temp",         X10)  \
+    X(uint16_t, humidity_x10,       "humidity",     X10)  \
+    X(uint16_t, pressure_hPa,       "pressure",     INT)  \
+    X(int16_t,  altitude_m,         "altitude",     INT)  \
+    X(int32_t,  latitude_x1e6,      "lat",          X1E6) \
+    X(int32_t,  longitude_x1e6,     "lng",          X1E6) \
+    X(int16_t,  gps_altitude_m,     "gpsAlt",       INT)  \
+    X(uint8_t,  satellites,         "satellites",   INT)  \
+    X(uint8_t,  hdop_x10,           "hdop",         X10)  \
+    X(uint32_t, uptime_sec,         "uptime_sec",   INT)  \
+    X(uint16_t, txCount,            "txCount",      INT)  \
+    X(uint16_t, rxCount,            "rxCount",      INT)  \
+    X(uint8_t,  battery_pct,        "battery",      INT)  \
+    X(uint8_t,  neighborCount,      "neighborCount", INT) \
+    X(uint8_t,  flags,              "",             NONE)
+
+#define BEACON_SCHEMA(X) \
+    X(uint8_t,  distanceToGateway,  "",             NONE) \
+    X(uint8_t,  gatewayId,          "",             NONE) \
+    X(uint16_t, sequenceNumber,     "",             NONE) \
+    X(uint8_t,  gpsHour,            "",             NONE) \
+    X(uint8_t,  gpsMinute,          "",             NONE) \
+    X(uint8_t,  gpsSecond,          "",             NONE) \
+    X(uint8_t,  gpsValid,           "",             NONE) \
+    X(uint16_t, epoch,              "",             NONE) \
+    X(uint8_t,  correctionNodeId,   "",             NONE) \
+    X(int16_t,  correctionMs,       "",             NONE)
+
+// LoRa frame header (big-endian, written by lora_comm.cpp) - dissector only
+#define LORA_HEADER_SCHEMA(X) \
+    X(uint8_t,  originId,           "",             NONE) \
+    X(uint16_t, seq,                "",             NONE) \
+    X(uint8_t,  ttl,                "",             NONE) \
+    X(uint16_t, payloadLen,         "",             NONE)
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         WIRE SIZES                                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define SCHEMA_WIRE_SIZE(type, field, key, format) + sizeof(type)
+
+constexpr uint8_t MESH_HEADER_WIRE_SIZE = 0 MESH_HEADER_SCHEMA(SCHEMA_WIRE_SIZE);
+constexpr uint8_t FULL_REPORT_WIRE_SIZE = MESH_HEADER_WIRE_SIZE + 0 FULL_REPORT_SCHEMA(SCHEMA_WIRE_SIZE);
+constexpr uint8_t BEACON_WIRE_SIZE = MESH_HEADER_WIRE_SIZE + 0 BEACON_SCHEMA(SCHEMA_WIRE_SIZE);
+constexpr uint8_t LORA_HEADER_WIRE_SIZE = 0 LORA_HEADER_SCHEMA(SCHEMA_WIRE_SIZE);
+
+static_assert(MESH_HEADER_WIRE_SIZE == sizeof(MeshHeader), "MESH_HEADER_SCHEMA does not match MeshHeader");
+static_assert(FULL_REPORT_WIRE_SIZE == sizeof(FullReportMsg), "FULL_REPORT_SCHEMA does not match FullReportMsg");
+static_assert(BEACON_WIRE_SIZE == sizeof(BeaconMsg), "BEACON_SCHEMA does not match BeaconMsg");
+static_assert(LORA_HEADER_WIRE_SIZE == LORA_HEADER_SIZE, "LORA_HEADER_SCHEMA does not match LORA_HEADER_SIZE");
+
+// Largest output of schemaReportJson(): ",\"key\":" plus 12 characters per field
+#define SCHEMA_JSON_SIZE_NONE(key)  0
+#define SCHEMA_JSON_SIZE_INT(key)   (sizeof(key) + 3 + 11)
+#define SCHEMA_JSON_SIZE_X10(key)   (sizeof(key) + 3 + 12)
+#define SCHEMA_JSON_SIZE_X1E6(key)  (sizeof(key) + 3 + 12)
+#define SCHEMA_JSON_SIZE(type, field, key, format) + SCHEMA_JSON_SIZE_##format(key)
+
+constexpr uint16_t SCHEMA_REPORT_JSON_MAX =
+    1 MESH_HEADER_SCHEMA(SCHEMA_JSON_SIZE) FULL_REPORT_SCHEMA(SCHEMA_JSON_SIZE);
+
+#define CODEC_BENCH_ITERATIONS      2000    // Messages per codec timing
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GENERATED CODECS                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Write the message exactly as given (header included) at fixed offsets
+ * @return FULL_REPORT_WIRE_SIZE
+ */
+uint8_t schemaEncodeFullReport(uint8_t* buffer, const FullReportMsg& report);
+
+/**
+ * Read a message without validating version or type
+ * @return false if length < FULL_REPORT_WIRE_SIZE (report untouched)
+ */
+bool schemaDecodeFullReport(const uint8_t* buffer, uint8_t length, FullReportMsg& report);
+
+uint8_t schemaEncodeBeacon(uint8_t* buffer, const BeaconMsg& beacon);
+bool schemaDecodeBeacon(const uint8_t* buffer, uint8_t length, BeaconMsg& beacon);
+
+/**
+ * Append ,"key":value for every report field that has a JSON key
+ *
+ * @param out Room for SCHEMA_REPORT_JSON_MAX bytes
+ * @return Characters written (out is null-terminated)
+ */
+uint16_t schemaReportJson(char* out, const FullReportMsg& report);
+
+/**
+ * Hops a report travelled to reach us: 1 for a direct neighbor,
+ * 0 for a report from a gateway itself. Every JSON output and the
+ * report-age statistics use this one definition.
+ */
+inline uint8_t meshHopCount(const MeshHeader& header) {
+    if (isGatewayId(header.sourceId)) return 0;
+    return (header.ttl < MESH_DEFAULT_TTL) ? MESH_DEFAULT_TTL - header.ttl + 1 : 1;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         DISSECTOR / BENCHMARK                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Print a Wireshark Lua dissector generated from the schema
+ *
+ * Frames are LoRa header + mesh payload, as sent over the air, in a pcap
+ * with link type USER0 (147).
+ */
+void printLuaDissector(Print& out);
+
+/**
+ * Time generated vs hand-written codecs and JSON, and check they agree
+ */
+void runCodecBenchmark();
+
+#endif // MESH_SCHEMA_H
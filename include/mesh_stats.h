@@ -7,6 +7,10 @@
 // ║                         MESH STATISTICS STRUCTURE                         ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
+/**
+ * MeshStats - Copy of the packet counters in the metrics registry
+ * (metrics.h); the increment functions below update the registry.
+ */
 struct MeshStats {
     // Reception statistics
     uint32_t packetsReceived;       // Total packets received
@@ -26,6 +30,25 @@ struct MeshStats {
     uint32_t uptimeSeconds;         // Total system uptime in seconds
 };
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REPORT AGE STATISTICS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define REPORT_AGE_HOP_BUCKETS  3   // 1-hop, 2-hop, 3+ hop
+
+/**
+ * ReportAgeStats - Gateway-side age of reports at first arrival
+ *
+ * Age = arrival second - the source's scheduled TX second (mod 60), so it
+ * needs no timestamp in the report. Bucket i holds reports that took i+1
+ * radio hops (last bucket: that many or more).
+ */
+struct ReportAgeStats {
+    uint32_t count[REPORT_AGE_HOP_BUCKETS];
+    uint32_t sumSec[REPORT_AGE_HOP_BUCKETS];
+    uint8_t  maxSec[REPORT_AGE_HOP_BUCKETS];
+};
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         FUNCTION DECLARATIONS                             ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -49,8 +72,14 @@ void incrementQueueOverflows();
 void incrementOwnPacketsIgnored();
 void incrementGatewayBroadcastSkips();
 
-// Update uptime
-void updateMeshStatsUptime();
+// Record the age of a report at the gateway (hops >= 1)
+void recordReportAge(uint8_t hops, uint8_t ageSec);
+
+// Get report age statistics
+ReportAgeStats getReportAgeStats();
+
+// Print report age by hop count
+void printReportAgeStats();
 
 // Print statistics to serial
 void printMeshStats();
@@ -0,0 +1,191 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         METRICS REGISTRY                                  ║
+// ║  Named counters, gauges and histograms behind one enumeration API         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * All updates are relaxed 32-bit atomics: safe from ISRs, loop() and other
+ * tasks without locks. A reader may see counters from slightly different
+ * moments (no snapshot across metrics), which is fine for statistics.
+ *
+ * Each metric is declared here and described (name, help) in the table of
+ * the same order in metrics.cpp. Serial dumps, the JSON line and the
+ * /metrics scrape all go through metricsForEach(), so a new entry shows
+ * up everywhere at once.
+ */
+
+#define METRIC_NODE_LABELS          256     // Per-node families: node ID 0-255
+#define METRIC_TYPE_LABELS          16      // Per-message-type families: type 0x00-0x0F
+#define METRIC_MAX_BUCKETS          10      // Upper bounds per histogram (+Inf is implicit)
+
+enum MetricKind {
+    METRIC_COUNTER = 0,         // Only goes up (until reset)
+    METRIC_GAUGE,               // Current value
+    METRIC_HISTOGRAM            // Fixed buckets + count + sum
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SCALAR METRICS                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+enum MetricId {
+    // Packet path (mesh_stats / packet_handler)
+    MET_PACKETS_RECEIVED = 0,   // Mesh reports accepted
+    MET_PACKETS_SENT,           // Own packets transmitted
+    MET_PACKETS_FORWARDED,      // Forwards transmitted
+    MET_FORWARDS_SCHEDULED,     // Forwards queued by the packet handler
+    MET_DUPLICATES_DROPPED,     // Mesh duplicates (duplicate cache)
+    MET_TTL_EXPIRED,
+    MET_QUEUE_OVERFLOWS,
+    MET_OWN_PACKETS_IGNORED,
+    MET_GATEWAY_BC_SKIPS,
+    MET_RX_FRAMES,              // Frames handed to the packet handler
+    MET_RX_LEGACY_DUPLICATES,   // Duplicates of non-mesh (legacy) messages
+    MET_RADIO_IRQS,             // RX-done interrupts
+    MET_TX_AIRTIME_MS,          // Total time on air
+
+    // Gradient routing (RoutingStats)
+    MET_BEACONS_RECEIVED,
+    MET_BEACONS_SENT,
+    MET_ROUTE_UPDATES,
+    MET_UNICAST_FORWARDS,
+    MET_FLOODING_FALLBACKS,
+    MET_ROUTE_EXPIRATIONS,
+    MET_GATEWAY_SWITCHES,
+    MET_BEACON_SLOT_MISSES,
+    MET_BEACONS_OUT_OF_PHASE,
+    MET_BEACONS_DUPLICATE,
+    MET_BEACONS_STALE,
+    MET_GATEWAY_REBOOTS,
+
+    // Channel monitor (instantaneous RSSI and CAD while idle in RX)
+    MET_CHANNEL_SAMPLES,
+    MET_CHANNEL_BUSY_SAMPLES,
+    MET_CAD_SCANS,
+    MET_CAD_DETECTED,
+
+    // Slot monitor (TDMA timing of received frames)
+    MET_SLOT_VIOLATIONS,
+    MET_SLOT_CORRECTIONS_SENT,
+    MET_SLOT_CORRECTIONS_APPLIED,
+
+    // GPS receiver (NMEA or UBX)
+    MET_GPS_UART_BYTES,
+    MET_GPS_PARSE_US,
+
+    // Gauges (usually bound to a reader, see metricBind)
+    MET_UPTIME_SEC,
+    MET_FREE_HEAP,
+    MET_MIN_FREE_HEAP,
+    MET_TX_QUEUE_DEPTH,
+    MET_NEIGHBORS,
+    MET_LIVE_NODES,
+    MET_GATEWAY_DISTANCE,
+    MET_LOOP_STALLS,
+    MET_CHANNEL_BUSY_PCT,
+    MET_SLOT_FLAGGED_NODES,
+
+    MET_COUNT
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HISTOGRAMS                                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+enum HistogramId {
+    HIST_TX_QUEUE_DEPTH = 0,    // Queue depth after each enqueue
+    HIST_RX_RSSI,               // dBm of every received frame
+    HIST_REPORT_AGE,            // Seconds from the source's TX slot to gateway arrival
+    HIST_SLOT_AIRTIME,          // ms on air per own TDMA slot (report + forwards)
+    HIST_CHANNEL_RSSI,          // dBm of idle-channel samples (noise floor spread)
+    HIST_SLOT_TIMING_ERROR,     // ms from a node's TX second to its report going on air
+    HIST_COUNT
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         LABELLED FAMILIES                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+enum MetricFamily {
+    FAM_REPORTS_BY_NODE = 0,    // Reports accepted, by source node
+    FAM_FORWARDS_BY_NODE,       // Forwards queued, by source node
+    FAM_RX_BY_TYPE,             // Frames received, by message type
+    FAM_TX_BY_TYPE,             // Frames sent, by message type
+    FAM_RX_LIMITED_BY_NODE,     // Frames dropped over the receive rate limit, by node
+    FAM_FORWARDS_LIMITED_BY_NODE,   // Forwards dropped over the forward rate limit, by source
+    FAM_COUNT
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ENUMERATION                                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * MetricSample - One value handed to a visitor
+ *
+ * Histograms carry cumulative bucket counts (Prometheus "le" semantics);
+ * bucketCounts[bucketCount] is the +Inf bucket and equals count.
+ */
+struct MetricSample {
+    const char*    name;
+    const char*    help;
+    uint8_t        kind;                // MetricKind
+    const char*    labelName;           // nullptr = unlabelled
+    char           labelValue[16];
+    uint32_t       value;               // Counter / gauge
+
+    const int32_t* bounds;              // Histogram upper bounds
+    uint8_t        bucketCount;
+    uint32_t       bucketCounts[METRIC_MAX_BUCKETS + 1];
+    uint32_t       count;
+    int32_t        sum;
+};
+
+typedef void (*MetricVisitor)(const MetricSample& sample, void* context);
+typedef uint32_t (*MetricReader)();
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FUNCTION DECLARATIONS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Updates (lock-free, callable from ISRs and any task)
+void metricInc(MetricId id);
+void metricAdd(MetricId id, uint32_t amount);
+void metricSet(MetricId id, uint32_t value);
+void metricObserve(HistogramId id, int32_t value);
+void metricIncLabel(MetricFamily family, uint8_t label);
+
+// Reads
+uint32_t metricGet(MetricId id);
+uint32_t metricGetLabel(MetricFamily family, uint8_t label);
+
+/**
+ * Read a metric from its owner at enumeration time instead of storing it
+ * (free heap, queue depth, ...). metricGet() calls the reader too.
+ */
+void metricBind(MetricId id, MetricReader reader);
+
+/**
+ * Zero counters, histograms and families (gauges and readers are kept)
+ */
+void metricsReset();
+
+/**
+ * Visit every metric: scalars, then histograms, then non-zero family members
+ */
+void metricsForEach(MetricVisitor visitor, void* context);
+
+/**
+ * Output formats, all built on metricsForEach()
+ */
+void printMetrics(Print& out);              // Readable table ('mesh metrics')
+void printMetricsJson(Print& out);          // {"type":"metrics",...} line for the serial bridge
+void printMetricsPrometheus(Print& out);    // Text exposition format (/metrics)
+String getMetricsPrometheus();
+
+#endif // METRICS_H
@@ -0,0 +1,229 @@
+#ifndef MQTT_UPLINK_H
+#define MQTT_UPLINK_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <atomic>
+#include "config.h"
+#include "lora_comm.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MQTT UPLINK CONFIGURATION                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define MQTT_QUEUE_SIZE             32      // Reports waiting for a publish slot
+#define MQTT_BATCH_MAX              8       // Reports per PUBLISH
+#define MQTT_BATCH_WAIT_MS          2000    // Publish a partial batch once its oldest report is this old
+#define MQTT_INFLIGHT_MAX           4       // Unacknowledged QoS 1 publishes
+#define MQTT_RETRY_MS               5000    // PUBACK wait before resending with DUP
+#define MQTT_CONNACK_TIMEOUT_MS     5000
+#define MQTT_CONNECT_STACK_SIZE     4096    // One-shot core 0 task for the blocking TCP connect
+#define MQTT_RECONNECT_MIN_MS       1000    // Backoff doubles up to the max while the broker is down
+#define MQTT_RECONNECT_MAX_MS       60000
+#define MQTT_TOPIC_MAX              48
+#define MQTT_CLIENT_ID_MAX          24
+#define MQTT_RX_BUFFER_SIZE         16      // Broker only sends CONNACK/PUBACK/PINGRESP to us
+
+#define MQTT_PAYLOAD_VERSION        1
+#define MQTT_PAYLOAD_HEADER_SIZE    3       // version, gatewayId, count
+#define MQTT_RECORD_SIZE            26
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MQTT PAYLOAD FORMAT                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * MqttReportRecord - One node report inside a batched PUBLISH
+ *
+ * Payload: version (1), gatewayId (1), count (1), then count records.
+ * All fields little-endian, same scaling as FullReportMsg. A full batch of
+ * 8 reports is 211 bytes - about what a single ThingSpeak GET URL costs.
+ *
+ * Total size: 26 bytes
+ */
+struct MqttReportRecord {
+    uint8_t  nodeId;
+    uint8_t  messageId;         // Mesh messageId (lets the consumer dedupe gateways)
+    int16_t  temperatureF_x10;
+    uint16_t humidity_x10;
+    uint16_t pressure_hPa;
+    int16_t  altitude_m;
+    int32_t  latitude_x1e6;
+    int32_t  longitude_x1e6;
+    uint8_t  satellites;
+    uint8_t  battery_pct;
+    int8_t   rssi;              // dBm at this gateway
+    uint8_t  flags;
+    uint32_t uptime_sec;
+} __attribute__((packed));
+
+static_assert(sizeof(MqttReportRecord) == MQTT_RECORD_SIZE, "MqttReportRecord layout mismatch");
+
+#define MQTT_PAYLOAD_MAX    (MQTT_PAYLOAD_HEADER_SIZE + MQTT_BATCH_MAX * MQTT_RECORD_SIZE)
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MQTT UPLINK STATISTICS                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct MqttUplinkStats {
+    unsigned long reportsQueued;
+    unsigned long reportsAcked;         // Covered by a PUBACK
+    unsigned long reportsDropped;       // Queue full
+    unsigned long publishes;
+    unsigned long retransmits;          // Publishes resent with DUP
+    unsigned long pubacks;
+    unsigned long connects;             // CONNACK accepted
+    unsigned long connectFailures;      // TCP refused, CONNACK refused or timed out
+    unsigned long sessionsResumed;      // CONNACK with session present
+    unsigned long bytesSent;
+    unsigned long latencySumMs;         // Queued -> PUBACK, summed over acked reports
+    unsigned long latencyMaxMs;
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MQTT UPLINK CLASS                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * MqttUplink - Minimal MQTT 3.1.1 publisher for gateway reports
+ *
+ * Keeps one TCP connection to the broker with clean session off, so the
+ * broker holds our QoS 1 state across reconnects. Reports are queued and
+ * sent MQTT_BATCH_MAX per PUBLISH (or fewer after MQTT_BATCH_WAIT_MS), with
+ * up to MQTT_INFLIGHT_MAX publishes waiting for their PUBACK at once.
+ * Unacknowledged publishes are resent with DUP after MQTT_RETRY_MS and
+ * right after a reconnect.
+ *
+ * Nothing blocks the caller. WiFiClient::connect() waits for the TCP handshake
+ * (seconds when the broker is down), so it runs in a one-shot task on core 0.
+ * update() polls the result and does not touch the client until the task ends.
+ *
+ * Usage:
+ *   mqttUplink.begin(host, port, clientId, topic);
+ *   mqttUplink.enqueue(nodeId, report, rssi);  // per report
+ *   mqttUplink.update();                        // from the main loop
+ */
+class MqttUplink {
+private:
+    enum State : uint8_t {
+        STATE_IDLE,                     // Not started or stopped
+        STATE_DISCONNECTED,             // Waiting for the next connect attempt
+        STATE_TCP_CONNECT,              // connectTask() owns the client
+        STATE_CONNACK_WAIT,
+        STATE_CONNECTED
+    };
+
+    enum ConnectResult : uint8_t {
+        CONNECT_NONE,                   // No connect task
+        CONNECT_PENDING,                // connectTask() running
+        CONNECT_OK,
+        CONNECT_FAILED
+    };
+
+    struct QueuedReport {
+        MqttReportRecord record;
+        uint32_t         queuedAtMs;
+    };
+
+    struct InflightPublish {
+        uint16_t         packetId;      // 0 = free slot
+        uint8_t          count;
+        uint32_t         sentAtMs;
+        MqttReportRecord records[MQTT_BATCH_MAX];
+        uint32_t         queuedAtMs[MQTT_BATCH_MAX];
+    };
+
+    WiFiClient      client;
+    State           state;
+    char            host[40];
+    uint16_t        port;
+    char            clientId[MQTT_CLIENT_ID_MAX];
+    char            topic[MQTT_TOPIC_MAX];
+    const char*     username;
+    const char*     password;
+    uint16_t        keepAliveSec;
+
+    QueuedReport    queue[MQTT_QUEUE_SIZE];
+    uint8_t         queueHead;
+    uint8_t         queueCount;
+    InflightPublish inflight[MQTT_INFLIGHT_MAX];
+    uint16_t        nextPacketId;
+
+    uint8_t         rxBuffer[MQTT_RX_BUFFER_SIZE];
+    uint8_t         rxLength;
+
+    uint32_t        stateSinceMs;
+    uint32_t        reconnectDelayMs;
+    uint32_t        lastSendMs;
+    uint32_t        pingSentMs;
+    bool            pingOutstanding;
+    std::atomic<uint8_t> connectResult; // ConnectResult, set by connectTask()
+    MqttUplinkStats stats;
+
+    static void connectTask(void* param);
+    bool connectTaskBusy();
+    bool writePacket(const uint8_t* data, size_t length);
+    void startConnect();
+    void sendConnect();
+    void dropConnection();
+    void readPackets();
+    void handlePacket(uint8_t type, const uint8_t* body, uint8_t length);
+    void handlePuback(uint16_t packetId);
+    bool sendPublish(InflightPublish& slot, bool duplicate);
+    void publishBatch();
+    void retransmit(bool all);
+    uint8_t inflightCount() const;
+
+public:
+    MqttUplink();
+
+    /**
+     * Set the broker and topic and start connecting on the next update()
+     *
+     * @param clientId Stable per gateway - the broker keeps the session under it
+     */
+    void begin(const char* brokerHost, uint16_t brokerPort, const char* clientId,
+               const char* topic, const char* user = "", const char* pass = "",
+               uint16_t keepAlive = MQTT_KEEPALIVE_SEC);
+
+    /**
+     * Send DISCONNECT and stay idle until begin() (queued reports are kept)
+     */
+    void stop();
+
+    /**
+     * Queue one report for the next batch
+     *
+     * @return false if the queue is full (report dropped)
+     */
+    bool enqueue(uint8_t nodeId, const FullReportMsg& report, float rssi);
+
+    /**
+     * Connect, read acknowledgements, publish due batches, keepalive
+     * Call every loop iteration.
+     */
+    void update();
+
+    bool isConnected() const { return state == STATE_CONNECTED; }
+    bool isStarted() const { return state != STATE_IDLE; }
+
+    /**
+     * A connect task still holds this object (do not delete it yet)
+     */
+    bool isConnecting() const { return connectResult.load() == CONNECT_PENDING; }
+
+    /**
+     * Reports not yet acknowledged (queued + in flight)
+     */
+    uint16_t pendingReports() const;
+
+    const MqttUplinkStats& getStats() const { return stats; }
+    void resetStats();
+
+    /**
+     * Print connection, queue and per-report latency
+     */
+    void printStatus();
+};
+
+#endif // MQTT_UPLINK_H
@@ -8,7 +8,12 @@
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 #define MAX_NEIGHBORS 10                    // Maximum number of neighbors to track
+#ifndef NEIGHBOR_TIMEOUT_MS
 #define NEIGHBOR_TIMEOUT_MS 180000          // 3 minutes - neighbor considered stale after this
+#endif
+#define NEIGHBOR_LOSS_ALPHA 0.1f            // EWMA weight of each report slot for the link loss rate
+#define NEIGHBOR_LOSS_MIN_SAMPLES 8         // Report slots seen before the loss rate is trusted
+#define NEIGHBOR_SEQ_RESYNC_GAP 32          // Larger messageId jumps are reboots, not losses
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         NEIGHBOR STRUCTURE                                ║
@@ -29,6 +34,11 @@ struct Neighbor {
     uint8_t  packetsReceived;   // Number of packets received from this neighbor
     bool     isActive;          // True if entry is in use
 
+    // Link loss, from gaps in the messageIds of the neighbor's own reports
+    uint8_t  lastMessageId;     // Last own-report messageId heard
+    uint8_t  lossSamples;       // Report slots counted (saturates at 255)
+    float    lossRate;          // EWMA of missed reports, 0.0-1.0
+
     // Constructor
     Neighbor() :
         nodeId(0),
@@ -37,7 +47,10 @@ struct Neighbor {
         rssiMax(-120),
         lastHeardMs(0),
         packetsReceived(0),
-        isActive(false)
+        isActive(false),
+        lastMessageId(0),
+        lossSamples(0),
+        lossRate(0.0f)
     {}
 };
 
@@ -130,6 +143,38 @@ public:
      * @return Average RSSI, or -120 if not found
      */
     int16_t getAverageRSSI(uint8_t nodeId);
+
+    /**
+     * Count a report the neighbor originated and heard directly
+     *
+     * Every own report takes the next messageId, so a gap of g means g - 1
+     * reports were lost on this link. Call after update() for the same node.
+     *
+     * @param nodeId - Neighbor (source and sender of the report)
+     * @param messageId - MeshHeader messageId
+     */
+    void noteMessageId(uint8_t nodeId, uint8_t messageId);
+
+    /**
+     * Get the measured link loss rate for a neighbor
+     *
+     * @param nodeId - Node to query
+     * @param lossRate - Set to the EWMA loss rate (0.0-1.0)
+     * @return false if unknown or fewer than NEIGHBOR_LOSS_MIN_SAMPLES seen
+     */
+    bool getLinkLoss(uint8_t nodeId, float& lossRate);
+
+    /**
+     * Restore a neighbor saved before a reset
+     *
+     * Re-creates the entry with its RSSI statistics, backdating lastHeardMs
+     * by ageMs so the normal timeout still applies.
+     *
+     * @param entry - Saved neighbor (nodeId, RSSI stats, packet count)
+     * @param ageMs - Time since the neighbor was last heard
+     * @return true if restored (not expired and space available)
+     */
+    bool restore(const Neighbor& entry, uint32_t ageMs);
 };
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
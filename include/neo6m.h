@@ -3,6 +3,7 @@
 
 #include <TinyGPS++.h>
 #include <Arduino.h>
+#include "ubx.h"
 
 // UTC offset configuration
 extern const int UTC_OFFSET; // set to -8 in winter
@@ -19,14 +20,59 @@ extern int g_second;
 extern bool g_location_valid;
 extern bool g_datetime_valid;
 
-// TinyGPS++ object
+// TinyGPS++ object (NMEA mode; use the accessors below, they also cover UBX mode)
 extern TinyGPSPlus gps;
 
+// ===== UBX Binary Mode =====
+// Enabled by GPS_UBX_MODE in config.h. The driver switches the receiver to
+// binary NAV messages and turns NMEA off; on GPS_FIXED_POSITION nodes it
+// then enters power save once time is locked, and g_* time keeps running
+// from millis() between fixes.
+
+#ifndef GPS_UBX_ACK_TIMEOUT_MS
+#define GPS_UBX_ACK_TIMEOUT_MS    500     // Wait for ACK-ACK/NAK per CFG message
+#endif
+#define GPS_UBX_CFG_RETRIES       3       // Resends before giving up on a CFG message
+#define GPS_UBX_DOP_RATE          5       // NAV-DOP every 5th solution (HDOP changes slowly)
+#define GPS_POWER_SAVE_SETTLE_MS  60000   // 3D fix + valid time this long before power save (ephemeris)
+#define GPS_STATS_WINDOW_MS       10000   // Bytes/s and parse time/s averaged over this window
+
+// Raw UART capture for tools/ubx_test/streams: build with
+// -D GPS_CAPTURE_MS=30000 and for that long after boot every byte read from
+// the receiver is echoed to Serial as "GPSRX <ms> <hex>" and every CFG frame
+// sent to it on GPS_TX_PIN as "GPSTX <ms> <hex>".
+// tools/ubx_test/capture_stream.py turns the log into a stream file.
+#ifndef GPS_CAPTURE_MS
+#define GPS_CAPTURE_MS            0
+#endif
+
+enum GpsUbxState : uint8_t {
+  GPS_UBX_OFF = 0,        // NMEA only (GPS_UBX_MODE = false)
+  GPS_UBX_CONFIGURING,    // CFG-MSG sequence in flight, NMEA still parsed
+  GPS_UBX_ACTIVE,         // Binary NAV messages, NMEA off
+  GPS_UBX_FAILED          // Receiver never answered: NMEA only
+};
+
+struct GpsStats {
+  GpsUbxState ubxState;
+  bool powerSave;             // CFG-RXM power save accepted
+  uint32_t bytes;             // UART bytes since boot
+  uint32_t parseUs;           // Time spent in processGPSData()
+  uint32_t nmeaSentences;     // TinyGPS++ checksum passes
+  uint32_t nmeaFailed;
+  UbxParserStats ubx;
+  uint8_t cfgNaks;            // CFG messages the receiver refused
+  float bytesPerSec;          // Last GPS_STATS_WINDOW_MS
+  float parseUsPerSec;
+  unsigned long timeAgeMs;    // Since the last valid NAV-TIMEUTC (UBX mode)
+};
+
 // Function declarations
 void initGPS();
 void updateGlobalGPSData();
 void displayGPSInfo();
 bool processGPSData();
+void updateGPS();           // Call every loop: UBX configuration, power save, time holdover
 int daysInMonth(int month, int year);
 void applyUtcOffset(int &year, int &month, int &day, int &hour, int offsetHours);
 
@@ -46,6 +92,16 @@ int getGPSSecond();
 float getGPSAltitude();
 bool isAltitudeValid();
 
+// Fix quality (NMEA or UBX, whichever is active)
+bool isSatellitesValid();
+uint8_t getGPSSatellites();
+bool isHdopValid();
+float getGPSHdop();
+
+// Receiver mode and parse cost ('mesh gps')
+GpsStats getGPSStats();
+void printGPSStatus();
+
 // Format helpers
 String getFormattedTime12Hour();
 String getFormattedTime24Hour();
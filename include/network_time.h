@@ -44,11 +44,13 @@ struct NetworkTimeState {
     uint8_t  hour;                  // Received hour (0-23)
     uint8_t  minute;                // Received minute (0-59)
     uint8_t  second;                // Received second (0-59)
+    uint16_t subSecondMs;           // Time was hour:minute:second + this at receivedAtMillis
     unsigned long receivedAtMillis; // Local millis() when beacon was received
     unsigned long lastUpdateTime;   // millis() of last update
     bool     valid;                 // Is network time currently valid?
     uint8_t  sourceNodeId;          // Which node provided the time
     uint8_t  hopCount;              // Hops from GPS source (0=GPS, 1=gateway, 2+=relay)
+    int16_t  correctionMs;          // Gateway slot corrections so far, added to every reading
 };
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -72,8 +74,11 @@ void initNetworkTime();
  * @param second    Second from beacon (0-59)
  * @param sourceNode Node ID that sent the beacon
  * @param hopCount  Number of hops from GPS source (1=from gateway, 2+=relayed)
+ * @param phaseMs   Time elapsed since hour:minute:second when the beacon
+ *                  arrived (known from the beacon sub-frame micro-slot, 0 if not)
  */
-void updateNetworkTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t sourceNode, uint8_t hopCount);
+void updateNetworkTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t sourceNode, uint8_t hopCount,
+                       uint16_t phaseMs = 0);
 
 /**
  * Get current hop count of network time
@@ -92,6 +97,27 @@ uint8_t getNetworkTimeHopCount();
  */
 bool getNetworkTime(uint8_t &hour, uint8_t &minute, uint8_t &second);
 
+/**
+ * Get the current network time with milliseconds into the second
+ *
+ * @param millisecond Output: milliseconds past 'second' (0-999)
+ * @return true if network time is valid, false otherwise
+ */
+bool getNetworkTimeMs(uint8_t &hour, uint8_t &minute, uint8_t &second, uint16_t &millisecond);
+
+/**
+ * Apply a slot timing correction from a gateway beacon
+ *
+ * The gateway measured our reports arriving correctionMs late (negative =
+ * early) against its TDMA schedule. The correction persists across later
+ * beacons - it compensates a bias in how this node reads beacon time, which
+ * the next beacon would otherwise reintroduce.
+ *
+ * @param correctionMs Milliseconds to add to network time
+ * @return false if network time is not in use (GPS-timed nodes ignore it)
+ */
+bool applyNetworkTimeCorrection(int16_t correctionMs);
+
 /**
  * Check if network time is currently valid
  * Network time becomes invalid if no beacon received within NETWORK_TIME_MAX_AGE_MS
@@ -105,6 +131,24 @@ bool isNetworkTimeValid();
  */
 void invalidateNetworkTime();
 
+/**
+ * Restore a time reference saved before a reset
+ *
+ * The saved time-of-day is treated as if it had been received ageMs ago,
+ * so getNetworkTime() extrapolates across the reset. Rejected if older
+ * than NETWORK_TIME_MAX_AGE_MS or if a beacon already set the time.
+ *
+ * @param hour       Saved hour (0-23)
+ * @param minute     Saved minute (0-59)
+ * @param second     Saved second (0-59)
+ * @param sourceNode Node that provided the time
+ * @param hopCount   Hops from GPS source
+ * @param ageMs      Time elapsed since the saved time was current
+ * @return true if the time was restored
+ */
+bool restoreNetworkTime(uint8_t hour, uint8_t minute, uint8_t second,
+                        uint8_t sourceNode, uint8_t hopCount, unsigned long ageMs);
+
 /**
  * Get age of network time in seconds
  *
@@ -5,14 +5,29 @@
 #include "config.h"
 #include "lora_comm.h"
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         NODE TABLE CONFIGURATION                          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define NODE_TABLE_SIZE             128     // Slots, power of two (open addressing)
+#define NODE_TABLE_MAX_LIVE         100     // Live nodes before LRU eviction (load <= 0.8)
+#define NODE_ID_EMPTY               0x00    // Slot never used (ends a probe)
+#define NODE_ID_TOMBSTONE           0xFF    // Slot of an evicted node (probe continues)
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         NODE MESSAGE STRUCTURE                            ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
+/**
+ * NodeMessage - Writer's entry for one node in the node table
+ *
+ * Plain data (no heap), keyed by nodeId. Node IDs 1-254 are valid,
+ * 0 and 255 mark empty and evicted slots.
+ */
 struct NodeMessage {
+    uint8_t nodeId;                   // Table key (NODE_ID_EMPTY / NODE_ID_TOMBSTONE if unused)
     bool hasData;
     bool isOnline;
-    String payload;
     uint8_t originId;
     uint16_t lastSeq;
     uint16_t expectedNextSeq;
@@ -21,6 +36,8 @@ struct NodeMessage {
     unsigned long lastHeardTime;
     unsigned long messageCount;
     unsigned long packetsLost;
+    unsigned long packetsReordered;   // Late arrivals that were counted lost earlier
+    uint32_t missingMask;             // Bit k = ID (expectedNextSeq-1-k) counted as lost
     FullReportMsg lastReport;
     NodeMessage();
     void clear();
@@ -30,25 +47,137 @@ struct NodeMessage {
 
     // Update from mesh packet - uses mesh messageId for gap detection
     // Returns number of packets lost (gap size), 0 if no gap
+    // A late packet whose ID was already counted lost is recorded as a
+    // reorder (loss is corrected) and does not move the sequence window back
     uint16_t updateFromMeshPacket(const LoRaReceivedPacket& packet, uint8_t meshMessageId);
 
+    // True if this messageId is older than the sequence window (late arrival)
+    bool isLateMeshPacket(uint8_t meshMessageId) const;
+
     // Update from legacy packet - uses LoRa seq for gap detection
     // Returns number of packets lost (gap size), 0 if no gap
     uint16_t updateFromPacket(const LoRaReceivedPacket& packet);
 };
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
-// ║                         GLOBAL NODE STORE                                 ║
+// ║                         NODE SNAPSHOTS                                    ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-extern NodeMessage nodeStore[MESH_MAX_NODES];
+#define SNAPSHOT_STRESS_MS          5000    // Duration of `mesh bench snapshot`
+#define SNAPSHOT_STRESS_STACK_SIZE  4096    // Stack of each stress reader task
+#define SNAPSHOT_STRESS_NODES       8       // Slots the stress test publishes and reads
+
+/**
+ * NodeSnapshot - Published copy of one node's state
+ *
+ * The node table is the writer's working copy: only the packet path
+ * (checkForIncomingMessages, the self report, checkNodeTimeouts) may touch
+ * it. After changing a node the writer calls publishNode(), which copies
+ * these fields into a double-buffered latch (seqcount + two copies).
+ *
+ * Readers in any task (web handlers, display, status prints) take
+ * snapshots. The writer never waits for them, and they never see a
+ * half-written report: a read that overlaps a publish is simply retried.
+ */
+struct NodeSnapshot {
+    uint8_t nodeId;                   // NODE_ID_EMPTY / NODE_ID_TOMBSTONE if the slot is unused
+    uint16_t slot;                    // Table slot (stable until the node is evicted)
+    bool hasData;
+    bool isOnline;
+    float lastRssi;
+    float lastSnr;
+    unsigned long lastHeardTime;
+    unsigned long messageCount;
+    unsigned long packetsLost;
+    uint32_t publishCount;            // Incremented on every publish of this node
+    FullReportMsg lastReport;
+
+    unsigned long getAgeSeconds() const;
+    float getPacketLossPercent() const;
+};
+
+struct SnapshotStats {
+    unsigned long published;          // publishNode() calls
+    unsigned long reads;              // Snapshots read
+    unsigned long retries;            // Reads repeated because a publish overlapped
+};
+
+struct NodeTableStats {
+    uint16_t live;                    // Nodes in the table
+    uint16_t tombstones;              // Evicted slots not reused yet
+    unsigned long inserted;           // Nodes added
+    unsigned long evicted;            // Long-dead nodes evicted to make room
+    unsigned long rejected;           // New nodes dropped (table full of live nodes)
+    uint16_t bytesPerSlot;            // Entry + two published copies
+};
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         FUNCTION DECLARATIONS                             ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 void initNodeStore();
+
+/**
+ * Writer's working copy of a node (packet path only, readers use snapshots)
+ *
+ * Adds the node if it is not in the table. When NODE_TABLE_MAX_LIVE nodes
+ * are present, the least recently heard node silent for NODE_EVICT_AGE_MS
+ * is evicted first.
+ *
+ * @return entry, or nullptr if nodeId is invalid or no node can be evicted
+ */
 NodeMessage* getNodeMessage(uint8_t nodeId);
+
+/**
+ * Writer's working copy of a node, without adding it
+ */
+NodeMessage* findNodeMessage(uint8_t nodeId);
+
+/**
+ * Publish a node's working copy to readers (writer only, wait-free)
+ * Call after every change to the node's NodeMessage.
+ */
+void publishNode(uint8_t nodeId);
+
+/**
+ * Read a consistent snapshot of one node
+ * @return false if the node is not in the table
+ */
+bool readNodeSnapshot(uint8_t nodeId, NodeSnapshot& snapshot);
+
+/**
+ * Iterate over live nodes only (in slot order, node ID order for IDs < 128)
+ *
+ *   uint16_t cursor = 0;
+ *   NodeSnapshot node;
+ *   while (nextLiveNode(cursor, node)) { ... }
+ *
+ * Each node is a consistent snapshot. For a consistent view of all nodes,
+ * compare getNodeStoreSequence() before and after the loop.
+ *
+ * @return false when there are no more live nodes
+ */
+bool nextLiveNode(uint16_t& cursor, NodeSnapshot& snapshot);
+
+/**
+ * Latch sequence (changes on every publish)
+ */
+uint32_t getNodeStoreSequence();
+
+SnapshotStats getSnapshotStats();
+NodeTableStats getNodeTableStats();
+
+/**
+ * Print table occupancy, evictions and memory per node (mesh nodes)
+ */
+void printNodeTable();
+
+/**
+ * Stress the latch: the loop task publishes a test pattern while reader
+ * tasks on both cores check every view for torn or mixed reads
+ */
+void runSnapshotStressTest();
+
 void checkNodeTimeouts();
 String getNodeStatusIcon(uint8_t nodeId);
 uint8_t getNodeCount();
@@ -17,7 +17,7 @@ void checkForIncomingMessages();
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 bool shouldForward(MeshHeader* header);
-void scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header);
+bool scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header);   // true if queued
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         STATISTICS ACCESS                                 ║
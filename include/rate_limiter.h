@@ -0,0 +1,191 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <Arduino.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RATE LIMITER CONFIGURATION                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define RATE_LIMIT_NODES            100     // One entry per node with every class: NODE_TABLE_MAX_LIVE (node_store.cpp checks)
+
+// Per-node budgets: sustained frames per minute and burst (bucket depth).
+// A node sends one report per TDMA cycle (60 s), so the defaults leave
+// room for 'mesh test', slot changes and a gateway's claim in the same slot.
+#ifndef RATE_REPORT_PER_MIN
+#define RATE_REPORT_PER_MIN         4       // FULL_REPORT, per source
+#define RATE_REPORT_BURST           4
+#endif
+#ifndef RATE_BEACON_PER_MIN
+#define RATE_BEACON_PER_MIN         12      // Beacons, per relaying neighbor (3 gateways, unsynced 30 s)
+#define RATE_BEACON_BURST           6
+#endif
+#ifndef RATE_CLAIM_PER_MIN
+#define RATE_CLAIM_PER_MIN          6       // Uplink claims, per source gateway
+#define RATE_CLAIM_BURST            4
+#endif
+#ifndef RATE_OTHER_PER_MIN
+#define RATE_OTHER_PER_MIN          12      // Routed data, ACKs and legacy text frames
+#define RATE_OTHER_BURST            6
+#endif
+#ifndef RATE_FORWARD_PER_MIN
+#define RATE_FORWARD_PER_MIN        3       // Forwards queued, per source (report + claim per slot)
+#define RATE_FORWARD_BURST          3
+#endif
+// Traffic generator frames are not limited: they exist to load the mesh
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RATE LIMITER STRUCTURES                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * What a bucket counts. Receive classes are checked in the RX header
+ * filter, before the payload leaves the radio FIFO; RATE_FORWARD is
+ * checked when a frame is about to be queued for forwarding.
+ */
+enum RateClass : uint8_t {
+    RATE_RX_REPORT = 0,         // FULL_REPORT, keyed by source
+    RATE_RX_BEACON,             // Beacons, keyed by the neighbor that relayed them
+    RATE_RX_CLAIM,              // Uplink claims, keyed by source gateway
+    RATE_RX_LOAD,               // Traffic generator frames (unlimited by default)
+    RATE_RX_OTHER,              // Everything else, keyed by source
+    RATE_FORWARD,               // Forwards queued, keyed by source
+    RATE_CLASS_COUNT
+};
+
+/**
+ * RateLimit - Budget of one class (perMinute = 0 means unlimited)
+ */
+struct RateLimit {
+    uint16_t perMinute;
+    uint8_t  burst;
+};
+
+/**
+ * RateNodeEntry - Token buckets of one node, one per class
+ *
+ * Tokens are kept in 1/60000 units so that each millisecond adds exactly
+ * perMinute units and no fraction is lost between refills. All classes of
+ * a node refill together, so one timestamp serves them.
+ */
+struct RateNodeEntry {
+    uint8_t  nodeId;
+    bool     used;
+    uint8_t  limitedMask;                       // Bit per RateClass: last frame was dropped (log once per episode)
+    uint32_t lastRefillMs;
+    uint32_t lastUsedMs;
+    uint32_t passed;
+    uint32_t dropped;
+    uint32_t tokens[RATE_CLASS_COUNT];          // 60000 = one frame
+    uint16_t episodeDrops[RATE_CLASS_COUNT];    // Drops since the class went over the limit (saturates)
+};
+
+/**
+ * RateLimiterStats - Totals since boot (per-node drops are in the metrics
+ * families mesh_node_rx_limited_total / mesh_node_forwards_limited_total)
+ */
+struct RateLimiterStats {
+    uint32_t passed[RATE_CLASS_COUNT];
+    uint32_t dropped[RATE_CLASS_COUNT];
+    uint32_t evictions;         // Entries reused for another node
+    uint32_t limitedEvictions;  // ... of which were over budget (more live IDs than entries)
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RATE LIMITER CLASS                                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * RateLimiter - Per-node token buckets for the receive and forward paths
+ *
+ * A node that transmits continuously would otherwise have every frame
+ * decoded, printed, stored, uploaded and queued for forwarding by every
+ * neighbor. With a bucket per node, a babbling node only costs its own
+ * budget: its excess frames are dropped from the header alone, and the
+ * rest of the mesh keeps its queue space and CPU time.
+ *
+ * There is one entry per node, as many as the node table holds. When a
+ * new node needs one, the least recently used entry that is within budget
+ * is reused, so a flood of new IDs cannot reset an over-budget node.
+ *
+ * Usage:
+ *   if (!rateLimiter.allow(header.sourceId, rateClassForType(header.messageType))) {
+ *       return false;   // Over budget - skip the payload
+ *   }
+ */
+class RateLimiter {
+private:
+    RateNodeEntry entries[RATE_LIMIT_NODES];
+    RateLimit limits[RATE_CLASS_COUNT];
+    RateLimiterStats stats;
+    bool enabled;
+
+    RateNodeEntry* findEntry(uint8_t nodeId, uint32_t now);
+    void refill(RateNodeEntry& entry, uint32_t now);
+
+public:
+    // Constructor
+    RateLimiter();
+
+    /**
+     * Take one frame from a node's budget
+     *
+     * Frames over budget are counted per node; the first drop of an
+     * episode and its end are logged, the drops in between are not.
+     *
+     * @param nodeId - Source (or relaying neighbor for beacons)
+     * @param rateClass - Which budget to charge
+     * @return true if the frame may be processed
+     */
+    bool allow(uint8_t nodeId, RateClass rateClass);
+
+    /**
+     * Change a class budget at runtime ('mesh ratelimit <class> <perMin> <burst>')
+     * Existing entries keep their tokens, capped to the new burst.
+     */
+    void setLimit(RateClass rateClass, uint16_t perMinute, uint8_t burst);
+    RateLimit getLimit(RateClass rateClass) const;
+
+    void setEnabled(bool on);
+    bool isEnabled() const;
+
+    /**
+     * Forget all entries and statistics (limits are kept)
+     */
+    void clear();
+
+    RateLimiterStats getStats() const;
+
+    /**
+     * Number of nodes with an entry
+     */
+    uint8_t trackedNodes() const;
+
+    /**
+     * Print limits, totals and the nodes that were over budget ('mesh ratelimit')
+     */
+    void printStatus() const;
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HELPERS                                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Receive class for a MeshHeader message type
+ */
+RateClass rateClassForType(uint8_t messageType);
+
+/**
+ * Class name as used by 'mesh ratelimit' (report, beacon, claim, load, other, forward)
+ */
+const char* getRateClassName(RateClass rateClass);
+bool parseRateClass(const String& name, RateClass& rateClass);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+extern RateLimiter rateLimiter;
+
+#endif // RATE_LIMITER_H
@@ -0,0 +1,167 @@
+#ifndef REORDER_BUFFER_H
+#define REORDER_BUFFER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "lora_comm.h"
+#include "mesh_protocol.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REORDER BUFFER CONFIGURATION                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define REORDER_MAX_ORIGINS     16               // Windows; the least recently heard idle one is reused
+#define REORDER_WINDOW_SIZE     4                // Reports held per source
+#define REORDER_MAX_PATHS       4                // Last-hop senders tracked per source
+#define REORDER_MAX_AHEAD       16               // Larger jumps = source restart, resync
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REORDER STRUCTURES                                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * HeldReport - A FULL_REPORT waiting for an earlier messageId to arrive
+ */
+struct HeldReport {
+    LoRaPacketHeader header;    // LoRa header of the copy that won
+    FullReportMsg    report;    // Decoded report
+    float            rssi;
+    float            snr;
+    uint32_t         heldSinceMs;
+    bool             occupied;
+};
+
+/**
+ * PathStats - How often a last-hop sender delivered the first copy
+ *
+ * A "win" is the first copy of a report heard through this sender,
+ * a "loss" is a later copy of the same report (already delivered).
+ */
+struct PathStats {
+    uint8_t  senderId;
+    uint16_t wins;
+    uint16_t losses;
+};
+
+/**
+ * ReorderWindow - Per-source reorder state
+ */
+struct ReorderWindow {
+    uint8_t    originId;
+    uint8_t    expectedId;      // Next messageId to release
+    bool       synced;          // false until the first report is seen
+    bool       used;
+    uint32_t   lastReportMs;    // Last submit() from this source (reuse order)
+    HeldReport held[REORDER_WINDOW_SIZE];
+    PathStats  paths[REORDER_MAX_PATHS];
+    uint32_t   released;        // Reports delivered in order
+    uint32_t   reordered;       // Gaps filled while later reports were held
+    uint32_t   timeouts;        // Held reports released after REORDER_HOLD_MS
+    uint32_t   lateArrivals;    // Reports that arrived after their slot was released
+};
+
+/**
+ * Delivery callback - receives reports in messageId order
+ */
+typedef void (*ReorderDeliverFn)(const LoRaReceivedPacket& packet, const FullReportMsg& report);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REORDER BUFFER CLASS                              ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * ReorderBuffer - Gateway-side reorder window for multipath arrivals
+ *
+ * With several relays in range, copies of a report reach the gateway through
+ * different paths and in different slots, so report N+1 can arrive before N.
+ * The duplicate cache already drops the extra copies; this buffer holds
+ * reports that arrive ahead of a missing messageId for a bounded time
+ * (REORDER_HOLD_MS) so the dashboard, ThingSpeak and node statistics see
+ * each source in order. Nothing is retransmitted - it costs no airtime.
+ *
+ * Windows are fewer than the node table: a new source takes over the window
+ * of the source heard least recently that holds nothing. If every window is
+ * holding reports, the new source's report is delivered as it comes and
+ * counted as bypassed.
+ *
+ * Usage:
+ *   reorderBuffer.setDeliveryHandler(onReport);
+ *   reorderBuffer.submit(packet, report);     // first copy of each report
+ *   reorderBuffer.noteDuplicate(src, sender); // later copies
+ *   reorderBuffer.flushExpired();             // from the RX loop
+ */
+class ReorderBuffer {
+private:
+    ReorderWindow    windows[REORDER_MAX_ORIGINS];
+    ReorderDeliverFn deliverFn;
+    uint32_t         evictions;     // Idle windows reused for another source
+    uint32_t         bypassed;      // Reports delivered unordered: every window was holding
+
+    ReorderWindow* getWindow(uint8_t originId, bool create);
+    void recordPath(ReorderWindow& window, uint8_t senderId, bool firstCopy);
+    void deliver(const LoRaPacketHeader& header, const FullReportMsg& report, float rssi, float snr);
+    void releaseHeld(ReorderWindow& window, uint8_t index);
+    void drainInOrder(ReorderWindow& window);
+    void releaseOldest(ReorderWindow& window);
+    void flushWindow(ReorderWindow& window);
+    uint8_t heldCount(const ReorderWindow& window) const;
+
+public:
+    // Constructor
+    ReorderBuffer();
+
+    /**
+     * Set the function that receives released reports
+     */
+    void setDeliveryHandler(ReorderDeliverFn fn);
+
+    /**
+     * Submit the first copy of a report (after duplicate filtering)
+     *
+     * Delivers immediately when it is the expected messageId (plus any held
+     * reports that follow it), otherwise holds it until the gap is filled
+     * or REORDER_HOLD_MS expires.
+     */
+    void submit(const LoRaReceivedPacket& packet, const FullReportMsg& report);
+
+    /**
+     * Record a duplicate copy heard through another last-hop sender
+     */
+    void noteDuplicate(uint8_t originId, uint8_t senderId);
+
+    /**
+     * Release held reports whose gap was not filled in time
+     * Call regularly (e.g. from the RX loop).
+     */
+    void flushExpired();
+
+    /**
+     * Release everything held, in order
+     */
+    void flushAll();
+
+    /**
+     * Drop all windows and statistics (held reports are discarded)
+     */
+    void clear();
+
+    /**
+     * Access the window for one source
+     *
+     * @return pointer to the window or nullptr if the source was never seen
+     */
+    const ReorderWindow* getWindowFor(uint8_t originId) const;
+
+    /**
+     * Print per-source reorder and path statistics
+     */
+    void printStatus();
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+extern ReorderBuffer reorderBuffer;
+
+#endif // REORDER_BUFFER_H
@@ -0,0 +1,171 @@
+#ifndef SENSOR_MATH_H
+#define SENSOR_MATH_H
+
+#include <stdint.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SENSOR MATH                                       ║
+// ║  Fixed-point BMP180 / SHT30 compensation and barometric altitude          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Everything here is integer arithmetic and yields the FullReportMsg
+ * scaling directly (0.1 °F, 0.1 %RH, hPa, m), so a sample goes from raw
+ * sensor counts to the wire without touching float.
+ *
+ * The barometric formula h = 44330 * (1 - (p / p0)^(1/5.255)) and its
+ * inverse come from two 257-point tables built at compile time
+ * (constexpr), linearly interpolated. Over 300-1100 hPa the altitude is
+ * within 0.13 m of the exact curve, and within 3 cm below 3 km.
+ *
+ * No Arduino dependency outside runSensorMathBenchmark(), so the same
+ * file builds on the PC (tools/sensor_bench).
+ */
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SENSOR MATH CONFIGURATION                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define BARO_TABLE_POINTS           257
+
+// Altitude table: p / p0 from 0.25 (~10.3 km) to 1.25 (~-1.9 km), Q24
+#define BARO_RATIO_MIN_Q24          (1UL << 22)
+#define BARO_RATIO_STEP_SHIFT       16      // 256 steps of 1/256
+
+// Sea-level table: height from -1048.576 m to 15728.64 m, in mm
+#define BARO_HEIGHT_MIN_MM          (-(1L << 20))
+#define BARO_HEIGHT_STEP_SHIFT      16      // 256 steps of 65.536 m
+
+// GPS sea-level calibration: EMA weight 1/20, state in Pa Q8
+#define BARO_SEA_LEVEL_EMA_DIV      20
+#define BARO_SEA_LEVEL_EMA_SHIFT    8
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BMP180                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Bmp180Calibration - The 11 EEPROM coefficients (datasheet 3.4)
+ */
+struct Bmp180Calibration {
+    int16_t  ac1, ac2, ac3;
+    uint16_t ac4, ac5, ac6;
+    int16_t  b1, b2;
+    int16_t  mb, mc, md;
+};
+
+/**
+ * Temperature term shared by both conversions (datasheet 3.5)
+ *
+ * @param ut - Uncompensated temperature
+ */
+int32_t bmp180ComputeB5(const Bmp180Calibration& cal, int32_t ut);
+
+/**
+ * @return 0.1 °C
+ */
+int16_t bmp180TemperatureC_x10(int32_t b5);
+
+/**
+ * True pressure (datasheet 3.5)
+ *
+ * @param up - Uncompensated pressure, already shifted right by 8 - oss
+ * @return Pa
+ */
+int32_t bmp180PressurePa(const Bmp180Calibration& cal, int32_t b5, int32_t up, uint8_t oss);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SHT30                                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * CRC-8 over one measurement word (datasheet 4.12: poly 0x31, init 0xFF)
+ */
+uint8_t sht30Crc8(const uint8_t* data, uint8_t len);
+
+/**
+ * Datasheet 4.13: T = -49 + 315 * S / 65535 (°F), rounded to 0.1 °F
+ */
+int16_t sht30TemperatureF_x10(uint16_t raw);
+
+/**
+ * T = -45 + 175 * S / 65535 (°C), rounded to 0.01 °C
+ */
+int16_t sht30TemperatureC_x100(uint16_t raw);
+
+/**
+ * RH = 100 * S / 65535, rounded to 0.1 %
+ */
+uint16_t sht30Humidity_x10(uint16_t raw);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CONVERSIONS                                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * 0.1 °C to 0.1 °F, rounded
+ */
+int16_t celsiusToFahrenheit_x10(int16_t celsius_x10);
+
+/**
+ * Pa to whole hPa, rounded (FullReportMsg::pressure_hPa)
+ */
+uint16_t pressureToHpa(int32_t pressurePa);
+
+/**
+ * Barometric altitude above the p0 level
+ *
+ * @return mm (p / p0 outside the table clamps to its ends)
+ */
+int32_t baroAltitudeMm(int32_t pressurePa, int32_t seaLevelPa);
+
+/**
+ * baroAltitudeMm() rounded to whole metres (FullReportMsg::altitude_m)
+ */
+int16_t baroAltitudeM(int32_t pressurePa, int32_t seaLevelPa);
+
+/**
+ * Sea-level pressure for a reading taken at a known height (GPS)
+ *
+ * @param altitudeMm - Height above sea level (clamped to the table)
+ * @return Pa
+ */
+int32_t baroSeaLevelPa(int32_t pressurePa, int32_t altitudeMm);
+
+/**
+ * One step of the sea-level calibration average (weight 1/BARO_SEA_LEVEL_EMA_DIV)
+ *
+ * The average is kept in Pa Q8 and the step is rounded, so it settles on
+ * the GPS value instead of stopping up to 19 Pa short of it (integer Pa
+ * steps truncate to zero once the gap is under BARO_SEA_LEVEL_EMA_DIV).
+ *
+ * @param averageQ8 - Current average, Pa << BARO_SEA_LEVEL_EMA_SHIFT
+ * @return New average, same scaling
+ */
+int32_t baroSeaLevelEmaQ8(int32_t averageQ8, int32_t samplePa);
+
+/**
+ * Pa to the Q8 average and back (rounded)
+ */
+int32_t baroSeaLevelToQ8(int32_t pressurePa);
+int32_t baroSeaLevelFromQ8(int32_t averageQ8);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FLOAT REFERENCE                                   ║
+// ║  The float code this replaces; accuracy tests and benchmarks only        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+float sht30TemperatureFRef(uint16_t raw);
+float sht30HumidityRef(uint16_t raw);
+float baroAltitudeRef(float pressurePa, float seaLevelPa);
+float baroSeaLevelRef(float pressurePa, float altitudeM);
+
+#ifdef ARDUINO
+/**
+ * CPU cycles per sample, fixed-point vs float, on this chip
+ * ('mesh bench sensors')
+ */
+void runSensorMathBenchmark();
+#endif
+
+#endif // SENSOR_MATH_H
@@ -4,6 +4,8 @@
 #include <Arduino.h>
 #include "lora_comm.h"
 
+#define SERIAL_JSON_LINE_SIZE   576     // node_data line: 30 + SCHEMA_REPORT_JSON_MAX (414) + ~110 tail
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         SERIAL JSON OUTPUT                                ║
 // ║  Outputs mesh data as JSON for desktop dashboard bridge                   ║
@@ -40,4 +42,10 @@ void outputMeshStatsJson();
  */
 void outputBeaconJson(uint8_t senderId, uint8_t distance, int16_t rssi);
 
+/**
+ * Output the capacity test report as JSON (one line per source)
+ * Each line carries the capacity curve points for that source
+ */
+void outputLoadReportJson();
+
 #endif // SERIAL_JSON_H
@@ -2,6 +2,7 @@
 #define SHT30_H
 
 #include <Wire.h>
+#include "sensor_math.h"
 
 class SHT30 {
 public:
@@ -11,10 +12,14 @@ public:
   float getTemperature();
   float getHumidity();
 
+  // Wire scaling (FullReportMsg), integer math from the last read()
+  int16_t getTemperatureF_x10();
+  uint16_t getHumidity_x10();
+
 private:
   TwoWire *_wire;
-  float _temperature;
-  float _humidity;
+  uint16_t _rawTemperature;
+  uint16_t _rawHumidity;
 };
 
 #endif
\ No newline at end of file
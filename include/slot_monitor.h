@@ -0,0 +1,124 @@
+#ifndef SLOT_MONITOR_H
+#define SLOT_MONITOR_H
+
+#include <Arduino.h>
+#include "lora_comm.h"
+#include "tdma_scheduler.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SLOT MONITOR CONFIGURATION                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#ifndef SLOT_TIMING_GUARD_MS
+#define SLOT_TIMING_GUARD_MS            1000    // Quiet time before a sub-slot ends (forwards stop 1 s early)
+#endif
+#define SLOT_TIMING_FLAG_PCT            50      // Flag a node once its error reaches this share of the guard
+#ifndef SLOT_CORRECTION_MIN_MS
+#define SLOT_CORRECTION_MIN_MS          150     // Smaller errors are loop latency, not clock drift
+#endif
+#define SLOT_CORRECTION_MAX_MS          1000    // Largest step sent in one beacon
+#define SLOT_TIMING_MIN_SAMPLES         3       // Reports timed before a correction
+#define SLOT_TIMING_ALPHA               0.3f    // Error EWMA weight per report
+#define SLOT_TIMING_STALE_MS            180000  // Not heard for 3 minutes: no corrections
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SLOT MONITOR STRUCTURES                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * SlotTimingStats - Timing of one node's transmissions, as heard here
+ *
+ * Error is when a report started on air minus the start of the node's
+ * scheduled TX second: positive = late, negative = early. The EWMA
+ * restarts after each correction so it measures what the node does next.
+ */
+struct SlotTimingStats {
+    uint16_t reports;           // Own reports timed (heard directly)
+    uint16_t outOfSlot;         // Frames that started outside the sender's slot
+    uint16_t intrusions;        // Other nodes' frames that started in this node's slot
+    int16_t  lastErrorMs;
+    int16_t  minErrorMs;
+    int16_t  maxErrorMs;
+    int32_t  errorSumMs;        // For the mean
+    float    ewmaErrorMs;       // Since the last correction
+    uint8_t  ewmaSamples;
+    uint8_t  timeSource;        // TimeSource from the last report's flags
+    bool     flagged;           // Error EWMA near the guard
+    int16_t  lastCorrectionMs;
+    uint16_t corrections;       // Corrections sent in beacons
+    unsigned long lastHeardMs;
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SLOT MONITOR CLASS                                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * SlotMonitor - Times every received frame against the TDMA schedule
+ *
+ * Runs on the gateway, and on relays with USE_RELAY_SLOT_MONITOR. Each
+ * frame's start on air (RX-done interrupt minus time on air) is placed in
+ * the active slot layout: a frame outside its sender's slot counts against
+ * the sender and as an intrusion on the slot it hit. Reports heard straight
+ * from their source also give the sender's timing error. The gateway names
+ * the worst drifting network-time node in its next beacon, with the
+ * correction to add to its clock (GPS-timed nodes are only flagged).
+ *
+ * Usage:
+ *   slotMonitor.noteFrame(packet, msgType);    // Every received frame
+ *   slotMonitor.takeCorrection(nodeId, ms);    // Gateway, building a beacon
+ *   slotMonitor.printReport();                 // 'mesh slots'
+ */
+class SlotMonitor {
+private:
+    SlotTimingStats nodes[TDMAScheduler::MAX_NODES];    // Index = node ID - 1
+
+    void noteReportTiming(SlotTimingStats& stats, uint8_t nodeId, int32_t errorMs,
+                          uint8_t timeSource);
+
+public:
+    SlotMonitor();
+
+    /**
+     * Gateway, or relay with USE_RELAY_SLOT_MONITOR
+     */
+    bool isEnabled() const;
+
+    /**
+     * Place a received frame in the schedule (beacons and non-mesh frames
+     * are ignored; nothing is recorded until time is synced)
+     */
+    void noteFrame(const LoRaReceivedPacket& packet, MessageType type);
+
+    /**
+     * Pick the network-time node that most needs a correction
+     *
+     * The node's EWMA restarts, so one measurement is never sent twice.
+     * @return false if no node is due (or this is not a gateway)
+     */
+    bool takeCorrection(uint8_t& nodeId, int16_t& correctionMs);
+
+    /**
+     * @return nullptr for IDs outside the TDMA schedule
+     */
+    const SlotTimingStats* getStats(uint8_t nodeId) const;
+
+    uint8_t getFlaggedCount() const;
+
+    void clear();
+
+    void printReport() const;
+
+    /**
+     * {"guardMs":..,"nodes":[{"node":..,"reports":..,"ewmaMs":..,..}]}
+     */
+    void printJson(Print& out) const;
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+extern SlotMonitor slotMonitor;
+
+#endif // SLOT_MONITOR_H
@@ -0,0 +1,144 @@
+#ifndef SNAPSHOT_LATCH_H
+#define SNAPSHOT_LATCH_H
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SNAPSHOT LATCH                                    ║
+// ║  Seqcount latch over two copies of an array (one writer, any readers)     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * SnapshotLatch - Double-buffered seqcount for wait-free publishing
+ *
+ * The writer bumps the sequence to odd, updates copies[0], bumps it to
+ * even, updates copies[1]. Readers use copies[sequence & 1], which is never
+ * the copy being written, and retry if the sequence moved while they copied.
+ *
+ * The payload is kept as relaxed atomic words, so a reader overlapping a
+ * publish reads stale or mixed words but is never a data race. The sequence
+ * orders them as in the usual seqlock recipe: release RMW + release fence
+ * before the payload stores, acquire load + acquire fence around the
+ * payload loads.
+ *
+ * No Arduino dependency, so the same code runs in tools/snapshot_stress.
+ *
+ * Usage (writer):
+ *   latch.publish(index, value);
+ *
+ * Usage (reader):
+ *   T value;
+ *   latch.read(index, 1, &value);
+ */
+template <typename T, uint16_t N>
+class SnapshotLatch {
+    static_assert(std::is_trivially_copyable<T>::value, "latched type must be trivially copyable");
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "latched type must be a whole number of words");
+
+public:
+    static const uint16_t WORDS = sizeof(T) / sizeof(uint32_t);
+
+    /**
+     * Zero both copies and the sequence (no readers or writer may be active)
+     */
+    void reset() {
+        for (uint8_t c = 0; c < 2; c++) {
+            for (uint16_t i = 0; i < N; i++) {
+                for (uint16_t w = 0; w < WORDS; w++) {
+                    words[c][i][w].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+        sequence.store(0, std::memory_order_release);
+    }
+
+    /**
+     * Publish one entry (single writer, wait-free)
+     */
+    void publish(uint16_t index, const T& value) {
+        uint32_t raw[WORDS];
+        memcpy(raw, &value, sizeof(T));
+
+        // Odd: readers move to copies[1] while copies[0] is written
+        sequence.fetch_add(1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWords(0, index, raw);
+
+        // Even: readers back on copies[0] while copies[1] catches up
+        sequence.fetch_add(1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWords(1, index, raw);
+    }
+
+    /**
+     * Copy count entries starting at first, consistent with each other
+     * @return number of retries
+     */
+    uint32_t read(uint16_t first, uint16_t count, T* out) const {
+        uint32_t retries = 0;
+        while (true) {
+            uint32_t begin = beginRead();
+            for (uint16_t i = 0; i < count; i++) {
+                load(begin & 1, first + i, out[i]);
+            }
+            if (!retryRead(begin)) break;
+            retries++;
+        }
+        return retries;
+    }
+
+    /**
+     * Start of a custom read: use copy (sequence & 1), then retryRead()
+     */
+    uint32_t beginRead() const {
+        return sequence.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @return true if a publish overlapped the read started at sequence
+     */
+    bool retryRead(uint32_t begin) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) != begin;
+    }
+
+    /**
+     * Copy one entry of one copy, with no consistency check of its own
+     */
+    void load(uint8_t copy, uint16_t index, T& out) const {
+        uint32_t raw[WORDS];
+        for (uint16_t w = 0; w < WORDS; w++) {
+            raw[w] = words[copy][index][w].load(std::memory_order_relaxed);
+        }
+        memcpy(&out, raw, sizeof(T));
+    }
+
+    /**
+     * One word of one entry (cheap look at a key without copying the entry)
+     */
+    uint32_t loadWord(uint8_t copy, uint16_t index, uint16_t word) const {
+        return words[copy][index][word].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Changes on every publish (odd while copies[0] is being written)
+     */
+    uint32_t getSequence() const {
+        return sequence.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> words[2][N][WORDS];
+
+    void storeWords(uint8_t copy, uint16_t index, const uint32_t* raw) {
+        for (uint16_t w = 0; w < WORDS; w++) {
+            words[copy][index][w].store(raw[w], std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif // SNAPSHOT_LATCH_H
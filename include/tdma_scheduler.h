@@ -14,6 +14,31 @@
 //   Node 3: 24-35  (TX at 30)
 //   Node 4: 36-47  (TX at 42)
 //   Node 5: 48-59  (TX at 54)
+//
+// Depth-ordered layout (USE_DEPTH_ORDERED_SLOTS):
+// The minute is split into three 20-second bands by hop distance to the
+// gateway, deepest first, so a report forwarded in one band is relayed
+// again in a later band of the same minute. Each band has a 4-second
+// sub-slot per device ID (TX 1 s in, forwards until 1 s before the end).
+//   Band 0:  0-19  depth 3+ or no route
+//   Band 1: 20-39  depth 2
+//   Band 2: 40-59  depth 1 (and the gateway itself)
+//   e.g. Node 3 at depth 2: 28-31 (TX at 29)
+//
+// Beacon sub-frame (USE_BEACON_SUBFRAME):
+// Seconds 0-3 carry only beacons (gateway at 0 ms, relays in per-depth
+// micro-slots, see gradient_routing.h). Depth bands shrink to 15 seconds
+// with 3-second sub-slots (TX at sub-slot start) and start at second 4:
+//   Band 0:  4-18   Band 1: 19-33   Band 2: 34-48   (49-59 unassigned)
+// The ID-ordered layout is unchanged (beacons fall before Node 1's TX at 6).
+
+// TX offsets (per-site values from tools/mesh_autotune can be set in build_flags)
+#ifndef TDMA_TX_OFFSET_SEC
+#define TDMA_TX_OFFSET_SEC          6       // ID-ordered: TX second within the 12-second slot
+#endif
+#ifndef TDMA_SUBSLOT_TX_OFFSET_SEC
+#define TDMA_SUBSLOT_TX_OFFSET_SEC  1       // Depth-ordered (no beacon sub-frame): TX second within the sub-slot
+#endif
 
 struct TDMAConfig {
     uint8_t deviceId;                    // Device identifier (1-5)
@@ -54,7 +79,18 @@ public:
     static constexpr uint8_t SLOT_DURATION_SEC = 12;    // 60s / 5 nodes = 12s per node
     static constexpr uint8_t TX_WINDOW_SEC = 10;        // Active transmit window (with 2s guard)
     static constexpr uint8_t TX_PER_SLOT = 1;           // One transmission per window
-    static constexpr uint8_t DEFAULT_TX_OFFSET = 6;     // TX at middle of slot (6 seconds in)
+    static constexpr uint8_t DEFAULT_TX_OFFSET = TDMA_TX_OFFSET_SEC;  // TX at middle of slot (6 seconds in)
+
+    // Depth-ordered slot constants - 3 depth bands x 5 nodes x 4 seconds
+    static constexpr uint8_t DEPTH_BANDS = 3;           // Depth 3+, depth 2, depth 1
+    static constexpr uint8_t BAND_DURATION_SEC = 20;    // 60s / 3 bands
+    static constexpr uint8_t SUBSLOT_DURATION_SEC = 4;  // 20s / 5 nodes
+    static constexpr uint8_t SUBSLOT_TX_OFFSET = TDMA_SUBSLOT_TX_OFFSET_SEC;  // TX 1 second into the sub-slot
+
+    // Beacon sub-frame constants - depth bands move behind seconds 0-3
+    static constexpr uint8_t BEACON_SUBFRAME_SEC = 4;           // Beacon-only seconds at minute start
+    static constexpr uint8_t SUBFRAME_BAND_DURATION_SEC = 15;   // 3 bands x 15s = seconds 4-48
+    static constexpr uint8_t SUBFRAME_SUBSLOT_SEC = 3;          // 15s / 5 nodes
 
     // Initialize with device ID (1-5)
     void init(uint8_t deviceId);
@@ -62,6 +98,31 @@ public:
     // Set custom transmission offset within slot (default: 6)
     void setTransmissionOffset(uint8_t offset);
 
+    // Order slots by hop distance to the gateway instead of by device ID
+    void setDepthOrdering(bool enabled);
+
+    // Report our hop distance to the gateway (255 = no route)
+    // A band change is applied outside our own slot only.
+    void setDepth(uint8_t distanceToGateway);
+
+    // Get current depth band (0 = first in the minute)
+    uint8_t getDepthBand();
+
+    // Reserve the start of each minute for beacons (shifts depth bands)
+    void setBeaconSubframe(bool enabled);
+
+    // True while inside the beacon sub-frame (never a data slot)
+    bool isInBeaconSubframe();
+
+    // Scheduled TX second of another node under the active layout
+    // (used by the gateway to age reports without a timestamp)
+    uint8_t getTransmissionSecondFor(uint8_t deviceId, uint8_t distanceToGateway);
+
+    // Slot covering a second of the minute under the active layout
+    // (band is 0 in the ID-ordered layout). False for seconds that belong
+    // to no data slot (beacon sub-frame, unassigned tail).
+    bool getSlotAt(uint8_t second, uint8_t& band, uint8_t& deviceId);
+
     // Update scheduler with current GPS time (legacy method)
     void update(int gpsHour, int gpsMinute, int gpsSecond, bool gpsValid);
 
@@ -103,6 +164,18 @@ public:
     uint8_t getSlotStart();
     uint8_t getSlotEnd();
 
+    // Get current second of the minute from the active time source,
+    // advanced with millis() between updates (safe inside a blocking TX loop)
+    uint8_t getCurrentSecond();
+
+    // Get milliseconds into the current minute (0-59999)
+    // Network time carries the beacon's sub-second phase; GPS time is
+    // phased to the moment loop() saw the second change.
+    uint32_t getMillisIntoMinute();
+
+    // Get the minute counter of the active time source (for once-per-frame events)
+    uint8_t getCurrentMinute();
+
 private:
     TDMAConfig config;
     TDMAStatus status;
@@ -112,12 +185,26 @@ private:
     uint8_t transmissionsCompletedThisSlot;
     bool slotActiveThisMinute;
 
+    bool depthOrdered;
+    uint8_t depth;                       // Last reported hop distance
+    uint8_t depthBand;                   // Band the current slot layout uses
+    unsigned long secondStartedMs;       // millis() when currentTime.second last changed
+
+    // Depth layout geometry (depends on the beacon sub-frame)
+    bool beaconSubframe;
+    uint8_t dataStartSec;                // First second available for data
+    uint8_t bandDurationSec;
+    uint8_t subslotDurationSec;
+    uint8_t subslotTxOffset;
+
     // Helper functions
     uint8_t calculateSlotStart(uint8_t deviceId);
     uint8_t calculateSlotEnd(uint8_t deviceId);
     bool isWithinMySlot(uint8_t second);
     bool isTransmissionSecond(uint8_t second);
     uint8_t getAbsoluteTransmissionSecond();
+    uint8_t bandForDepth(uint8_t distanceToGateway);
+    void applySlotLayout();
 };
 
 #endif // TDMA_SCHEDULER_H
\ No newline at end of file
@@ -3,16 +3,27 @@
 
 #include <Arduino.h>
 #include "lora_comm.h"
+#include "config.h"
 
 // Initialize ThingSpeak (call in setup)
 void initThingSpeak();
 
+// Find the ThingSpeak channel configured for a node (nullptr if none)
+const ThingSpeakChannel* findThingSpeakChannel(uint8_t nodeId);
+
 // Send a FULL_REPORT to ThingSpeak
 // Returns true if successful, false otherwise
 bool sendToThingSpeak(uint8_t nodeId, const FullReportMsg& report, float rssi);
 
+// One blocking GET against a ThingSpeak-style update URL (no statistics)
+// Returns the HTTP code (negative for connection errors); response holds the entry ID
+int thingSpeakUpdate(const char* updateUrl, const char* apiKey, uint8_t nodeId,
+                     const FullReportMsg& report, float rssi, String& response);
+
 // Get statistics
 unsigned long getThingSpeakSuccessCount();
 unsigned long getThingSpeakFailCount();
+unsigned long getThingSpeakLatencyAvgMs();   // Request time, successful uploads
+unsigned long getThingSpeakLatencyMaxMs();
 
 #endif // THINGSPEAK_H
\ No newline at end of file
@@ -0,0 +1,192 @@
+#ifndef TRAFFIC_GENERATOR_H
+#define TRAFFIC_GENERATOR_H
+
+#include <Arduino.h>
+#include "mesh_protocol.h"
+#include "config.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         TRAFFIC GENERATOR CONFIGURATION                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define LOADGEN_MAX_SOURCES     MESH_MAX_NODES   // Sources tracked by the gateway
+#define LOADGEN_MAX_LEVELS      8                // Capacity curve points per source
+#define LOADGEN_MAX_RATE        16               // Max synthetic frames per slot
+#define LOADGEN_MAX_BURST       (LOADGEN_MAX_RATE * 4)  // Max frames in a burst slot
+#define LOADGEN_DUP_WINDOW      128              // Sequences remembered per source
+#define LOADGEN_HEADER_SIZE     18               // MeshHeader + load test fields
+
+// A late copy from a second relay must still find its burst in the window
+static_assert(LOADGEN_DUP_WINDOW >= 2 * LOADGEN_MAX_BURST && LOADGEN_DUP_WINDOW % 32 == 0,
+              "LOADGEN_DUP_WINDOW must cover two bursts, in 32-bit words");
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         LOAD TEST MESSAGE                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * LoadTestMsg - Synthetic frame produced by the traffic generator
+ *
+ * Frames travel through the normal transmit queue and forwarding path so the
+ * gateway sees the same contention, queueing and loss as real reports.
+ * The frame is padded with filler bytes up to the configured size.
+ *
+ * latencyMs accumulates the time the frame spent in transmit queues: the
+ * source and every relay add their own queue residence time just before
+ * transmitting. This avoids needing synchronized clocks between nodes.
+ *
+ * Total size: 8 bytes (MeshHeader) + 10 bytes (load fields) + padding
+ */
+struct LoadTestMsg {
+    MeshHeader meshHeader;          // Standard routing header
+    uint8_t    testId;              // Changes on every 'mesh load start/ramp'
+    uint8_t    offeredPerSlot;      // Offered load when this frame was created
+    uint16_t   sequence;            // Per-test sequence (gap = loss)
+    uint32_t   latencyMs;           // Accumulated queue residence time
+    uint16_t   generatorDrops;      // Frames the source could not enqueue
+} __attribute__((packed));
+
+static_assert(sizeof(LoadTestMsg) == LOADGEN_HEADER_SIZE, "LoadTestMsg must be exactly 18 bytes");
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GENERATOR SETTINGS                                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct LoadGenConfig {
+    uint8_t  framesPerSlot;     // Offered load (synthetic frames per TDMA slot)
+    uint8_t  minBytes;          // Smallest frame (>= LOADGEN_HEADER_SIZE)
+    uint8_t  maxBytes;          // Largest frame (<= MAX_MESSAGE_SIZE)
+    uint8_t  burstPercent;      // Chance (0-100) a slot carries a burst
+    uint8_t  burstMultiplier;   // Burst slots offer framesPerSlot × this
+    uint8_t  rampTo;            // Ramp target rate (0 = no ramp)
+    uint8_t  rampSlotsPerStep;  // Slots spent at each ramp level
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GATEWAY MEASUREMENTS                              ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * One point of the capacity curve: everything received from one source
+ * while it was offering a given load.
+ */
+struct LoadLevelStats {
+    uint8_t  offeredPerSlot;    // Offered load for this point
+    uint32_t received;          // Frames delivered to the gateway
+    uint32_t bytes;             // Payload bytes after the load header (goodput)
+    uint16_t firstSeq;          // First sequence seen at this level
+    uint16_t highestSeq;        // Highest sequence seen at this level
+    uint32_t latencySumMs;      // Sum of accumulated queue latency
+    uint32_t latencyMaxMs;      // Worst accumulated queue latency
+    uint32_t firstRxMs;         // Arrival time of first frame
+    uint32_t lastRxMs;          // Arrival time of last frame
+    uint16_t dropsAtStart;      // Source generatorDrops at first frame
+    uint16_t dropsAtEnd;        // Source generatorDrops at last frame
+    bool     used;
+};
+
+struct LoadSourceStats {
+    uint8_t        sourceId;
+    uint8_t        testId;
+    uint8_t        levelCount;
+    LoadLevelStats levels[LOADGEN_MAX_LEVELS];
+    bool           used;
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FUNCTION DECLARATIONS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Initialize the traffic generator (stopped, gateway statistics cleared)
+ */
+void initTrafficGenerator();
+
+/**
+ * Start generating a constant offered load
+ *
+ * @param config - Rate, size distribution and burstiness
+ * @return true if the configuration was accepted
+ */
+bool startLoadGenerator(const LoadGenConfig& config);
+
+/**
+ * Stop the generator (gateway statistics are kept until cleared)
+ */
+void stopLoadGenerator();
+
+/**
+ * Check if the generator is currently running
+ */
+bool isLoadGeneratorActive();
+
+/**
+ * Get the active generator configuration
+ */
+LoadGenConfig getLoadGenConfig();
+
+/**
+ * Enqueue this slot's synthetic frames into the transmit queue
+ * Call once per TDMA slot, after the primary report and before forwards.
+ * Also advances the ramp when one is configured.
+ *
+ * @return number of frames enqueued
+ */
+uint8_t loadGenOnSlot();
+
+/**
+ * Add queue residence time to a load test frame before it is transmitted
+ * Safe to call with any frame; non load-test frames are left untouched.
+ *
+ * @param data - Encoded frame (modified in place)
+ * @param length - Frame length
+ * @param residenceMs - Time the frame waited in the local transmit queue
+ */
+void loadGenStampResidence(uint8_t* data, uint8_t length, uint32_t residenceMs);
+
+/**
+ * Record a load test frame that reached the gateway
+ *
+ * @param data - Encoded frame
+ * @param length - Frame length
+ * @return true if the frame was a valid load test frame
+ */
+bool recordLoadTestFrame(const uint8_t* data, uint8_t length);
+
+/**
+ * Duplicate check for load test frames (marks the frame as seen)
+ * Kept separate from the main duplicate cache so synthetic sequences never
+ * shadow FULL_REPORT message IDs. Each source has a window of the last
+ * LOADGEN_DUP_WINDOW 16-bit sequences of its current test; older frames
+ * count as duplicates.
+ *
+ * @param data - Encoded frame (at least LOADGEN_HEADER_SIZE bytes)
+ * @param length - Frame length
+ * @return true if this frame was already seen
+ */
+bool isLoadTestDuplicate(const uint8_t* data, uint8_t length);
+
+/**
+ * Access gateway-side statistics for one tracked source
+ *
+ * @param index - 0 to LOADGEN_MAX_SOURCES-1
+ * @return pointer to stats or nullptr if the slot is unused
+ */
+const LoadSourceStats* getLoadSourceStats(uint8_t index);
+
+/**
+ * Clear all gateway-side load test statistics
+ */
+void clearLoadTestStats();
+
+/**
+ * Print generator state (node side)
+ */
+void printLoadGenStatus();
+
+/**
+ * Print the capacity curve report (gateway side)
+ */
+void printLoadReport();
+
+#endif // TRAFFIC_GENERATOR_H
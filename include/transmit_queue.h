@@ -7,7 +7,13 @@
 // ║                         TRANSMIT QUEUE CONFIGURATION                      ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
+// Per-site values (tools/mesh_autotune) can be set from build_flags
+#ifndef TX_QUEUE_SIZE
 #define TX_QUEUE_SIZE 8
+#endif
+#ifndef MAX_FORWARDS_PER_SLOT
+#define MAX_FORWARDS_PER_SLOT 5             // Forwards sent after our own report each slot
+#endif
 #define MAX_MESSAGE_SIZE 64
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
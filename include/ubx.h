@@ -0,0 +1,232 @@
+#ifndef UBX_H
+#define UBX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UBX PROTOCOL                                      ║
+// ║  u-blox binary messages for the NEO-6M (protocol version 7)               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Frame: 0xB5 0x62, class, id, payload length (2 bytes LE), payload,
+ * then an 8-bit Fletcher checksum over class..payload. All multi-byte
+ * fields are little-endian.
+ *
+ * The NEO-6 has no NAV-PVT (added in protocol 14), so the driver enables
+ * NAV-POSLLH (position), NAV-SOL (fix + satellites), NAV-TIMEUTC (time)
+ * and NAV-DOP (HDOP, at a lower rate) instead.
+ *
+ * No Arduino dependency, so the same file builds on the PC
+ * (tools/ubx_test).
+ */
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UBX CONFIGURATION                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define UBX_MAX_PAYLOAD             64      // Longer frames are skipped (NAV-SOL, the largest we read, is 52)
+#define UBX_FRAME_OVERHEAD          8       // Sync, class, id, length, checksum
+#define UBX_MAX_FRAME               (UBX_MAX_PAYLOAD + UBX_FRAME_OVERHEAD)
+
+#define UBX_SYNC_1                  0xB5
+#define UBX_SYNC_2                  0x62
+
+// Classes
+#define UBX_CLASS_NAV               0x01
+#define UBX_CLASS_ACK               0x05
+#define UBX_CLASS_CFG               0x06
+#define UBX_CLASS_NMEA              0xF0    // Standard NMEA sentences (CFG-MSG only)
+
+// NAV
+#define UBX_NAV_POSLLH              0x02
+#define UBX_NAV_DOP                 0x04
+#define UBX_NAV_SOL                 0x06
+#define UBX_NAV_TIMEUTC             0x21
+
+// ACK
+#define UBX_ACK_NAK                 0x00
+#define UBX_ACK_ACK                 0x01
+
+// CFG
+#define UBX_CFG_MSG                 0x01
+#define UBX_CFG_RXM                 0x11
+#define UBX_CFG_PM2                 0x3B
+
+// NMEA sentences the NEO-6M sends by default
+#define UBX_NMEA_GGA                0x00
+#define UBX_NMEA_GLL                0x01
+#define UBX_NMEA_GSA                0x02
+#define UBX_NMEA_GSV                0x03
+#define UBX_NMEA_RMC                0x04
+#define UBX_NMEA_VTG                0x05
+
+// Power save: up to this period the receiver tracks continuously at low
+// power (cyclic tracking), longer periods switch it fully off in between
+#define UBX_PM2_CYCLIC_MAX_MS       10000
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FRAME BUILDING                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Fletcher checksum over class, id, length and payload
+ */
+void ubxChecksum(const uint8_t* data, uint16_t len, uint8_t& ckA, uint8_t& ckB);
+
+/**
+ * Wrap a payload into a frame
+ *
+ * @param out - at least len + UBX_FRAME_OVERHEAD bytes
+ * @return Frame length, 0 if len > UBX_MAX_PAYLOAD
+ */
+uint16_t ubxBuildFrame(uint8_t msgClass, uint8_t msgId, const uint8_t* payload, uint16_t len,
+                       uint8_t* out);
+
+/**
+ * CFG-MSG: output rate of one message on the port this is sent on
+ *
+ * @param rate - 0 = off, 1 = every navigation solution, N = every Nth
+ */
+uint16_t ubxBuildCfgMsg(uint8_t msgClass, uint8_t msgId, uint8_t rate, uint8_t* out);
+
+/**
+ * CFG-RXM: continuous (max performance) or power save mode
+ */
+uint16_t ubxBuildCfgRxm(bool powerSave, uint8_t* out);
+
+/**
+ * CFG-PM2: power save timing (takes effect with CFG-RXM power save)
+ *
+ * Cyclic tracking up to UBX_PM2_CYCLIC_MAX_MS, ON/OFF above it. Both
+ * wait for a time fix before sleeping and keep ephemeris current.
+ *
+ * @param updatePeriodMs - time between fixes
+ */
+uint16_t ubxBuildCfgPm2(uint32_t updatePeriodMs, uint8_t* out);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STREAM PARSER                                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+enum UbxFeedResult : uint8_t {
+    UBX_FEED_NONE = 0,          // Not part of a UBX frame (NMEA text, noise)
+    UBX_FEED_PARTIAL,           // Inside a frame
+    UBX_FEED_FRAME,             // Frame complete and valid, see frame()
+    UBX_FEED_ERROR              // Frame ended with a bad checksum
+};
+
+struct UbxFrame {
+    uint8_t  msgClass;
+    uint8_t  msgId;
+    uint16_t length;
+    uint8_t  payload[UBX_MAX_PAYLOAD];
+};
+
+struct UbxParserStats {
+    uint32_t frames;            // Valid frames
+    uint32_t checksumErrors;
+    uint32_t oversized;         // Valid frames too long to keep (skipped)
+    uint32_t otherBytes;        // Bytes outside frames (NMEA while it is still on)
+};
+
+/**
+ * UbxParser - Byte-at-a-time frame parser
+ *
+ * Tolerates NMEA interleaved with UBX (as during configuration): bytes
+ * outside a frame come back as UBX_FEED_NONE so the caller can hand them
+ * to an NMEA parser.
+ *
+ * Usage:
+ *   if (parser.feed(byte) == UBX_FEED_FRAME) handle(parser.frame());
+ */
+class UbxParser {
+private:
+    enum State : uint8_t {
+        WAIT_SYNC_1, WAIT_SYNC_2, READ_CLASS, READ_ID, READ_LEN_1, READ_LEN_2,
+        READ_PAYLOAD, READ_CK_A, READ_CK_B
+    };
+
+    State    state;
+    UbxFrame current;
+    uint16_t received;          // Payload bytes so far
+    uint8_t  ckA, ckB;          // Running checksum
+    uint8_t  rxCkA;
+    UbxParserStats stats;
+
+    void addToChecksum(uint8_t byte);
+
+public:
+    UbxParser();
+
+    UbxFeedResult feed(uint8_t byte);
+
+    /**
+     * Last complete frame (valid until the next feed)
+     */
+    const UbxFrame& frame() const;
+
+    const UbxParserStats& getStats() const;
+
+    void reset();
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MESSAGE DECODING                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// UbxNavState::seen bits
+#define UBX_SEEN_POSLLH             0x01
+#define UBX_SEEN_SOL                0x02
+#define UBX_SEEN_TIMEUTC            0x04
+#define UBX_SEEN_DOP                0x08
+
+/**
+ * UbxNavState - Latest value of every NAV field the driver uses
+ */
+struct UbxNavState {
+    // NAV-POSLLH
+    int32_t  latE7;             // Degrees x 1e7
+    int32_t  lonE7;
+    int32_t  heightMslMm;       // Above mean sea level
+    uint32_t hAccMm;
+
+    // NAV-SOL
+    uint8_t  fixType;           // 0 none, 2 = 2D, 3 = 3D, 5 = time only
+    bool     fixOk;             // gpsFixOk: within DOP/accuracy masks
+    uint8_t  numSV;
+
+    // NAV-DOP
+    uint16_t hDopX100;
+
+    // NAV-TIMEUTC
+    uint16_t year;
+    uint8_t  month;             // 1-12
+    uint8_t  day;
+    uint8_t  hour;
+    uint8_t  minute;
+    uint8_t  second;
+    int32_t  nanos;             // -1e9..1e9, add to the second above
+    uint32_t tAccNs;
+    bool     timeValid;         // validUTC: leap seconds known
+
+    uint8_t  seen;              // UBX_SEEN_* of messages decoded at least once
+};
+
+/**
+ * Update state from a NAV frame
+ *
+ * @return UBX_SEEN_* bit of the message decoded, 0 if not a NAV message
+ *         we read (or its length is wrong)
+ */
+uint8_t ubxDecodeNav(const UbxFrame& frame, UbxNavState& state);
+
+/**
+ * Is this frame the receiver's answer to a CFG message?
+ *
+ * @param acked - true for ACK-ACK, false for ACK-NAK
+ */
+bool ubxIsAckFor(const UbxFrame& frame, uint8_t msgClass, uint8_t msgId, bool& acked);
+
+#endif // UBX_H
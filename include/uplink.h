@@ -0,0 +1,82 @@
+#ifndef UPLINK_H
+#define UPLINK_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "lora_comm.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UPLINK CONFIGURATION                              ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define UPLINK_BENCH_REPORTS        200     // Default reports pushed through each backend
+#define UPLINK_BENCH_MAX_REPORTS    2000
+#define UPLINK_BENCH_MQTT_PORT      18830   // Loopback broker stand-in
+#define UPLINK_BENCH_HTTP_PORT      18080   // Loopback ThingSpeak stand-in
+#define UPLINK_BENCH_STACK_SIZE     6144
+#define UPLINK_BENCH_TIMEOUT_MS     60000   // Per backend
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UPLINK FUNCTIONS                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Cloud uplink - routes gateway reports to the selected backend
+ *
+ *   UPLINK_THINGSPEAK - one blocking HTTP GET per report (thingspeak.cpp)
+ *   UPLINK_MQTT       - queued, batched QoS 1 publishes over one persistent
+ *                       MQTT session (mqtt_uplink.cpp)
+ *   UPLINK_OFF        - reports stay on the serial/dashboard side only
+ *
+ * The backend starts as UPLINK_DEFAULT_BACKEND and "mesh uplink <name>"
+ * switches it at runtime; the choice is saved in NVS and survives resets.
+ */
+
+/**
+ * Load the saved backend and start it (gateway, after WiFi)
+ */
+void initUplink();
+
+/**
+ * Hand one report to the current backend
+ *
+ * @return true if uploaded (ThingSpeak) or accepted into the publish
+ *         queue (MQTT) - the gateway then claims the report
+ */
+bool uplinkReport(uint8_t nodeId, const FullReportMsg& report, float rssi);
+
+/**
+ * Drive the MQTT session (connect, acks, batches, keepalive)
+ * Call every loop iteration on the gateway.
+ */
+void uplinkUpdate();
+
+UplinkBackend getUplinkBackend();
+
+/**
+ * Switch backends and save the choice
+ * Reports still queued for MQTT are kept and sent if MQTT is selected again.
+ */
+void setUplinkBackend(UplinkBackend backend);
+
+const char* getUplinkBackendName(UplinkBackend backend);
+
+/**
+ * Parse "thingspeak", "mqtt" or "off"
+ * @return false if the name is unknown
+ */
+bool parseUplinkBackend(const String& name, UplinkBackend& backend);
+
+/**
+ * Print backend, ThingSpeak and MQTT session statistics
+ */
+void printUplinkStatus();
+
+/**
+ * Push synthetic reports through both backends against loopback stand-ins
+ * (HTTP update endpoint and MQTT broker on a core 0 task) and compare
+ * throughput and per-report latency. Does not touch the live session.
+ */
+void runUplinkBenchmark(uint16_t reports);
+
+#endif // UPLINK_H
@@ -0,0 +1,144 @@
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "gradient_routing.h"
+#include "neighbor_table.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         WARM START CONFIGURATION                          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define WARM_START_MAGIC            0x574D5354UL   // "WMST"
+#define WARM_START_VERSION          1
+#define WARM_START_SEQ_STRIDE       16             // messageIds reserved per NVS write
+#define WARM_START_SEQ_REFRESH      8              // Rewrite NVS when fewer than this remain
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SNAPSHOT STRUCTURES                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * WarmRoute - Compact per-gateway route
+ */
+struct WarmRoute {
+    uint8_t  gatewayId;
+    uint8_t  distanceToGateway;
+    uint8_t  nextHop;
+    int16_t  bestRssi;
+    uint16_t lastBeaconSeq;
+    uint32_t ageMs;             // Time since last beacon when saved
+} __attribute__((packed));
+
+/**
+ * WarmNeighbor - Compact neighbor entry
+ */
+struct WarmNeighbor {
+    uint8_t  nodeId;
+    int16_t  rssi;
+    int16_t  rssiMin;
+    int16_t  rssiMax;
+    uint8_t  packetsReceived;
+    uint32_t ageMs;             // Time since last heard when saved
+} __attribute__((packed));
+
+/**
+ * WarmTime - Time-of-day reference (own GPS or network time)
+ */
+struct WarmTime {
+    uint8_t  hour;
+    uint8_t  minute;
+    uint8_t  second;
+    uint8_t  sourceNodeId;
+    uint8_t  hopCount;          // 0 = our own GPS
+    uint8_t  valid;
+    uint32_t ageMs;             // Time since the reference was current when saved
+} __attribute__((packed));
+
+/**
+ * WarmStartSnapshot - State kept in RTC memory across soft resets
+ *
+ * RTC_NOINIT memory survives watchdog, panic, software and (usually)
+ * brownout resets, but not power loss. The CRC rejects garbage after a
+ * power-on. Elapsed time across the reset comes from the RTC-backed
+ * system clock (gettimeofday), which keeps running through soft resets;
+ * if it went backwards the time-sensitive parts are discarded.
+ *
+ * Only the messageId counter and boot count also go to NVS (flash), since
+ * routes, neighbors and time are useless after an unknown power-off time.
+ */
+struct WarmStartSnapshot {
+    uint32_t     magic;
+    uint8_t      version;
+    uint8_t      deviceId;
+    uint16_t     bootCount;
+    int64_t      savedAtUs;             // System clock when saved
+    uint8_t      meshMessageSeq;        // Next FULL_REPORT messageId
+    uint8_t      routeCount;
+    WarmRoute    routes[ROUTE_TABLE_SIZE];
+    uint8_t      neighborCount;
+    WarmNeighbor neighbors[MAX_NEIGHBORS];
+    WarmTime     time;
+    uint32_t     firstReportMs;         // Time-to-first-report of the boot that saved it
+    uint8_t      firstReportWarm;       // 1 if that boot was a warm start
+    uint32_t     crc;                   // CRC32 of everything above
+} __attribute__((packed));
+
+/**
+ * WarmStartStatus - What happened at this boot
+ */
+struct WarmStartStatus {
+    uint16_t bootCount;
+    uint8_t  resetReason;           // esp_reset_reason_t
+    bool     snapshotValid;         // RTC snapshot passed magic/CRC/device checks
+    bool     elapsedKnown;          // System clock moved forward across the reset
+    uint32_t elapsedMs;             // Time between snapshot and boot
+    bool     seqFromRtc;            // messageId restored exactly
+    bool     seqFromNvs;            // messageId skipped ahead from NVS reservation
+    uint8_t  routesRestored;
+    uint8_t  neighborsRestored;
+    bool     timeRestored;
+    uint32_t firstReportMs;         // This boot's time to first report (0 = not yet)
+    uint32_t previousFirstReportMs; // Previous boot's, from the snapshot
+    bool     previousWasWarm;
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FUNCTION DECLARATIONS                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Read reset reason, boot counter and validate the RTC snapshot
+ * Call first thing in setup() (before other modules overwrite state).
+ */
+void initWarmStart();
+
+/**
+ * Restore routing, neighbors, network time and messageId from the snapshot
+ * Call after initGradientRouting() and initNetworkTime().
+ */
+void applyWarmStart();
+
+/**
+ * Periodic snapshot to RTC memory and messageId reservation in NVS
+ * Call from loop(); internally rate limited to WARM_START_SNAPSHOT_INTERVAL_MS.
+ */
+void warmStartUpdate();
+
+/**
+ * Record a successful own report (measures time to first report)
+ */
+void warmStartOnReportSent();
+
+/**
+ * Get this boot's warm start status
+ */
+const WarmStartStatus& getWarmStartStatus();
+
+/**
+ * Print warm start status (restored state and time to first report)
+ */
+void printWarmStartStatus();
+
+#endif // WARM_START_H
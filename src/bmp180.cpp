@@ -1,8 +1,7 @@
 #include "bmp180.h"
 #include <Wire.h>
-#include <math.h>
 
-BMP180::BMP180() : _wire(nullptr), _oss(BMP180_OSS_ULTRAHIGHRES) {}
+BMP180::BMP180() : _wire(nullptr), _oss(BMP180_OSS_ULTRAHIGHRES), _cal(), _temperatureC_x10(0), _pressurePa(0) {}
 
 bool BMP180::begin(TwoWire* wire, uint8_t oss) {
     _wire = wire;
@@ -23,22 +22,22 @@ bool BMP180::isConnected() {
 
 bool BMP180::readCalibrationData() {
     // Read all calibration coefficients as per datasheet
-    ac1 = (int16_t)readRegister16(BMP180_REG_CAL_AC1);
-    ac2 = (int16_t)readRegister16(BMP180_REG_CAL_AC2);
-    ac3 = (int16_t)readRegister16(BMP180_REG_CAL_AC3);
-    ac4 =              readRegister16(BMP180_REG_CAL_AC4);
-    ac5 =              readRegister16(BMP180_REG_CAL_AC5);
-    ac6 =              readRegister16(BMP180_REG_CAL_AC6);
-    b1  = (int16_t)readRegister16(BMP180_REG_CAL_B1);
-    b2  = (int16_t)readRegister16(BMP180_REG_CAL_B2);
-    mb  = (int16_t)readRegister16(BMP180_REG_CAL_MB);
-    mc  = (int16_t)readRegister16(BMP180_REG_CAL_MC);
-    md  = (int16_t)readRegister16(BMP180_REG_CAL_MD);
+    _cal.ac1 = (int16_t)readRegister16(BMP180_REG_CAL_AC1);
+    _cal.ac2 = (int16_t)readRegister16(BMP180_REG_CAL_AC2);
+    _cal.ac3 = (int16_t)readRegister16(BMP180_REG_CAL_AC3);
+    _cal.ac4 =              readRegister16(BMP180_REG_CAL_AC4);
+    _cal.ac5 =              readRegister16(BMP180_REG_CAL_AC5);
+    _cal.ac6 =              readRegister16(BMP180_REG_CAL_AC6);
+    _cal.b1  = (int16_t)readRegister16(BMP180_REG_CAL_B1);
+    _cal.b2  = (int16_t)readRegister16(BMP180_REG_CAL_B2);
+    _cal.mb  = (int16_t)readRegister16(BMP180_REG_CAL_MB);
+    _cal.mc  = (int16_t)readRegister16(BMP180_REG_CAL_MC);
+    _cal.md  = (int16_t)readRegister16(BMP180_REG_CAL_MD);
 
     // Basic sanity checks (protect against all-zeros or 0xFFFF on unsigned fields)
-    if (ac1 == 0 || ac1 == -1) return false;
-    if (ac4 == 0 || ac4 == 0xFFFF) return false;
-    if (ac5 == 0 || ac5 == 0xFFFF) return false;
+    if (_cal.ac1 == 0 || _cal.ac1 == -1) return false;
+    if (_cal.ac4 == 0 || _cal.ac4 == 0xFFFF) return false;
+    if (_cal.ac5 == 0 || _cal.ac5 == 0xFFFF) return false;
 
     return true;
 }
@@ -113,62 +112,43 @@ int32_t BMP180::readRawPressure() {
     return (int32_t)raw;
 }
 
-int32_t BMP180::computeB5(int32_t UT) {
-    // B5 = X1 + X2, where:
-    // X1 = (UT - AC6) * AC5 / 2^15
-    // X2 = MC * 2^11 / (X1 + MD)
-    int32_t X1 = ((UT - (int32_t)ac6) * (int32_t)ac5) >> 15;
-    int32_t X2 = ((int32_t)mc << 11) / (X1 + (int32_t)md);
-    return X1 + X2;
-}
-
 float BMP180::readTemperature() {
     int32_t UT = readRawTemperature();
-    int32_t B5 = computeB5(UT);
-    // T in 0.1 °C: T = (B5 + 8) / 2^4
-    int32_t T = (B5 + 8) >> 4;
-    return T / 10.0f;
+    return bmp180TemperatureC_x10(bmp180ComputeB5(_cal, UT)) / 10.0f;
 }
 
 float BMP180::readPressure() {
     int32_t UT = readRawTemperature();
     int32_t UP = readRawPressure();
-    // True pressure calculation (datasheet)
-    int32_t B5 = computeB5(UT);
-    int32_t B6 = B5 - 4000;
-    int32_t X1 = ((int32_t)b2 * ((B6 * B6) >> 12)) >> 11;
-    int32_t X2 = ((int32_t)ac2 * B6) >> 11;
-    int32_t X3 = X1 + X2;
-    // Correct rounding per datasheet:
-    // B3 = (((AC1*4 + X3) << OSS) + 2) / 4
-    int32_t B3 = (((((int32_t)ac1) * 4 + X3) << _oss) + 2) >> 2;
-    X1 = ((int32_t)ac3 * B6) >> 13;
-    X2 = ((int32_t)b1  * ((B6 * B6) >> 12)) >> 16;
-    X3 = ((X1 + X2) + 2) >> 2;
-    uint32_t B4 = ((uint32_t)ac4 * (uint32_t)(X3 + 32768)) >> 15;
-    uint32_t B7 = ((uint32_t)UP - (uint32_t)B3) * (uint32_t)(50000UL >> _oss);
-    int32_t p;
-    if (B7 < 0x80000000UL) {
-        // p = (B7 * 2) / B4
-        p = (int32_t)((B7 << 1) / B4);
-    } else {
-        // p = (B7 / B4) * 2
-        p = (int32_t)((B7 / B4) << 1);
-    }
-    X1 = (p >> 8);
-    X1 = (X1 * X1);
-    X1 = (X1 * 3038) >> 16;
-    X2 = (-7357 * p) >> 16;
-    p = p + ((X1 + X2 + (int32_t)3791) >> 4);
-    return (float)p; // Pascals
+    // True pressure calculation (datasheet, see sensor_math.cpp)
+    return (float)bmp180PressurePa(_cal, bmp180ComputeB5(_cal, UT), UP, _oss); // Pascals
 }
 
 float BMP180::readAltitude(float seaLevelPressure /* Pa */) {
     // Protect against bad input
     if (seaLevelPressure <= 0.0f) seaLevelPressure = 101325.0f;
-    const float pressure = readPressure(); // Pa
-    // Standard barometric formula: 0.190294957 ≈ 1/5.255
-    return 44330.0f * (1.0f - powf(pressure / seaLevelPressure, 0.190294957f));
+    const int32_t pressure = (int32_t)readPressure(); // Pa
+    // Standard barometric formula, from the table in sensor_math.cpp
+    return baroAltitudeMm(pressure, (int32_t)seaLevelPressure) / 1000.0f;
+}
+
+bool BMP180::read() {
+    int32_t UT = readRawTemperature();
+    int32_t UP = readRawPressure();
+    if (UT == 0 || UP == 0) return false;   // I2C read failed
+
+    int32_t B5 = bmp180ComputeB5(_cal, UT);
+    _temperatureC_x10 = bmp180TemperatureC_x10(B5);
+    _pressurePa = bmp180PressurePa(_cal, B5, UP, _oss);
+    return _pressurePa > 0;
+}
+
+int16_t BMP180::getTemperatureC_x10() {
+    return _temperatureC_x10;
+}
+
+int32_t BMP180::getPressurePa() {
+    return _pressurePa;
 }
 
 int32_t BMP180::getRawTemperature() {
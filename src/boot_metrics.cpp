@@ -0,0 +1,186 @@
+#include "boot_metrics.h"
+#include "config.h"
+
+// DRAM bounds of .data / .bss from the ESP-IDF linker script
+extern "C" int _data_start, _data_end, _bss_start, _bss_end;
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL STATE                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static BootMetrics bootMetrics;
+static bool phaseOpen = false;
+
+static const char* const SERVICE_NAMES[BOOT_SVC_COUNT] = {
+    "Display",
+    "WiFi/Dashboard",
+    "Cloud Uplink"
+};
+
+static const char* serviceStateString(uint8_t state) {
+    switch (state) {
+        case BOOT_SVC_PENDING:  return "pending";
+        case BOOT_SVC_STARTING: return "starting";
+        case BOOT_SVC_READY:    return "ready";
+        case BOOT_SVC_FAILED:   return "FAILED";
+        case BOOT_SVC_SKIPPED:  return "n/a";
+        default:                return "?";
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SETUP PHASES                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void bootPhaseBegin(const char* name) {
+    if (phaseOpen) bootPhaseEnd();
+    if (bootMetrics.phaseCount >= BOOT_MAX_PHASES) return;
+
+    BootPhase& phase = bootMetrics.phases[bootMetrics.phaseCount];
+    phase.name = name;
+    phase.startMs = millis();
+    phase.durationMs = 0;
+    phaseOpen = true;
+}
+
+void bootPhaseEnd() {
+    if (!phaseOpen) return;
+
+    BootPhase& phase = bootMetrics.phases[bootMetrics.phaseCount];
+    phase.durationMs = millis() - phase.startMs;
+    bootMetrics.phaseCount++;
+    phaseOpen = false;
+}
+
+void bootMarkRadioListening() {
+    bootMetrics.radioListeningMs = millis();
+}
+
+void bootMarkSetupDone() {
+    if (phaseOpen) bootPhaseEnd();
+    bootMetrics.setupDoneMs = millis();
+}
+
+void bootNoteRx() {
+    if (bootMetrics.firstRxMs != 0) return;
+
+    bootMetrics.firstRxMs = millis();
+    Serial.printf("[BOOT] First packet received %lu ms after reset (radio listening since %lu ms)\n",
+                  (unsigned long)bootMetrics.firstRxMs,
+                  (unsigned long)bootMetrics.radioListeningMs);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ASYNC SERVICES                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void bootServiceStarting(BootService service) {
+    BootServiceStatus& status = bootMetrics.services[service];
+    status.startMs = millis();
+    status.state = BOOT_SVC_STARTING;
+}
+
+void bootServiceDone(BootService service, bool ok) {
+    BootServiceStatus& status = bootMetrics.services[service];
+    status.readyMs = millis();
+    status.state = ok ? BOOT_SVC_READY : BOOT_SVC_FAILED;
+
+    Serial.printf("[BOOT] %s %s at %lu ms (took %lu ms)\n",
+                  SERVICE_NAMES[service],
+                  ok ? "ready" : "FAILED",
+                  (unsigned long)status.readyMs,
+                  (unsigned long)(status.readyMs - status.startMs));
+}
+
+void bootServiceSkip(BootService service) {
+    bootMetrics.services[service].state = BOOT_SVC_SKIPPED;
+}
+
+bool isBootServiceReady(BootService service) {
+    return bootMetrics.services[service].state == BOOT_SVC_READY;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STATUS                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+const BootMetrics& getBootMetrics() {
+    return bootMetrics;
+}
+
+void printBootMetrics() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  BOOT TIMELINE                                                ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    Serial.println(F("  setup() phases:"));
+    for (uint8_t i = 0; i < bootMetrics.phaseCount; i++) {
+        const BootPhase& phase = bootMetrics.phases[i];
+        Serial.printf("    %-20s @%6lu ms  %6lu ms\n",
+                      phase.name,
+                      (unsigned long)phase.startMs,
+                      (unsigned long)phase.durationMs);
+    }
+
+    Serial.println(F("  Async services:"));
+    for (uint8_t s = 0; s < BOOT_SVC_COUNT; s++) {
+        const BootServiceStatus& status = bootMetrics.services[s];
+        Serial.printf("    %-20s %-9s", SERVICE_NAMES[s], serviceStateString(status.state));
+        if (status.state == BOOT_SVC_READY || status.state == BOOT_SVC_FAILED) {
+            Serial.printf(" @%6lu ms  %6lu ms",
+                          (unsigned long)status.readyMs,
+                          (unsigned long)(status.readyMs - status.startMs));
+        }
+        Serial.println();
+    }
+
+    Serial.printf("  Radio listening:   %lu ms\n", (unsigned long)bootMetrics.radioListeningMs);
+    Serial.printf("  Main loop started: %lu ms\n", (unsigned long)bootMetrics.setupDoneMs);
+    if (bootMetrics.firstRxMs != 0) {
+        Serial.printf("  First RX:          %lu ms\n", (unsigned long)bootMetrics.firstRxMs);
+    } else {
+        Serial.println(F("  First RX:          nothing received yet"));
+    }
+    Serial.println();
+}
+
+void printBuildInfo() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  BUILD                                                        ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    Serial.printf("  Role:              %s%s\n", BUILD_ROLE_NAME,
+                  MESH_ROLE == MESH_ROLE_ANY ? (IS_GATEWAY ? " (gateway by DEVICE_ID)" : " (node by DEVICE_ID)") : "");
+    Serial.printf("  Forwarding:        %s\n", ROLE_FORWARDS ? "yes" : "no (leaf)");
+    Serial.printf("  WiFi / dashboard:  %s\n", MESH_WITH_UPLINK ? "linked" : "not linked");
+    Serial.printf("  Cloud uplink:      %s\n", MESH_WITH_UPLINK ? "linked" : "not linked");
+
+    uint32_t dataBytes = (uint32_t)((uint8_t*)&_data_end - (uint8_t*)&_data_start);
+    uint32_t bssBytes = (uint32_t)((uint8_t*)&_bss_end - (uint8_t*)&_bss_start);
+    Serial.printf("  Flash image:       %lu KB of %lu KB\n",
+                  (unsigned long)(ESP.getSketchSize() / 1024),
+                  (unsigned long)(ESP.getFreeSketchSpace() / 1024));
+    Serial.printf("  Static RAM:        %lu B (.data %lu + .bss %lu)\n",
+                  (unsigned long)(dataBytes + bssBytes), (unsigned long)dataBytes, (unsigned long)bssBytes);
+    Serial.printf("  Heap:              %lu B free of %lu B (min %lu B)\n",
+                  (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getHeapSize(),
+                  (unsigned long)ESP.getMinFreeHeap());
+
+    Serial.printf("  Radio listening:   %lu ms\n", (unsigned long)bootMetrics.radioListeningMs);
+    Serial.printf("  Main loop started: %lu ms\n", (unsigned long)bootMetrics.setupDoneMs);
+    uint32_t allReadyMs = 0;
+    bool allDone = true;
+    for (uint8_t s = 0; s < BOOT_SVC_COUNT; s++) {
+        const BootServiceStatus& status = bootMetrics.services[s];
+        if (status.state == BOOT_SVC_PENDING || status.state == BOOT_SVC_STARTING) allDone = false;
+        if (status.readyMs > allReadyMs) allReadyMs = status.readyMs;
+    }
+    if (allDone) {
+        Serial.printf("  Services settled:  %lu ms\n", (unsigned long)max(allReadyMs, bootMetrics.setupDoneMs));
+    } else {
+        Serial.println(F("  Services settled:  still starting"));
+    }
+    Serial.println();
+}
@@ -0,0 +1,376 @@
+#include "channel_monitor.h"
+#include "lora_comm.h"
+#include "tdma_scheduler.h"
+#include "metrics.h"
+
+extern TDMAScheduler tdmaScheduler;
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+ChannelMonitor channelMonitor;
+
+static const uint32_t TREND_PERIOD_MS = 60000UL;
+
+static float percent(uint32_t part, uint32_t whole) {
+    return whole ? 100.0f * part / whole : 0.0f;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SAMPLING                                          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+ChannelMonitor::ChannelMonitor() : cadEnabled(true) {
+    clear();
+}
+
+void ChannelMonitor::clear() {
+    memset(seconds, 0, sizeof(seconds));
+    memset(trend, 0, sizeof(trend));
+    trendHead = 0;
+    trendCount = 0;
+    floorDbm = -127.0f;
+    floorValid = false;
+    lastRssiMs = 0;
+    lastCadMs = 0;
+    minuteStartMs = millis();
+    minuteSamples = 0;
+    minuteBusy = 0;
+    minuteCadScans = 0;
+    minuteCadDetected = 0;
+    minuteMinDbm = 0;
+    minuteMaxDbm = -127;
+}
+
+void ChannelMonitor::update() {
+    if (!isLoRaReady()) return;
+
+    unsigned long now = millis();
+    if (now - minuteStartMs >= TREND_PERIOD_MS) {
+        closeMinute(now);
+    }
+    if (now - lastRssiMs < CHANNEL_RSSI_INTERVAL_MS) return;
+    lastRssiMs = now;
+
+    bool synced = tdmaScheduler.getStatus().timeSynced;
+    uint8_t second = synced ? (uint8_t)(tdmaScheduler.getMillisIntoMinute() / 1000UL) : 0;
+
+    int16_t dbm = (int16_t)lroundf(sampleChannelRssi());
+    addRssiSample(dbm, synced, second);
+    bool busy = floorValid && dbm > floorDbm + CHANNEL_BUSY_MARGIN_DB;
+
+    // CAD only where stopping RX for a moment costs nothing we need
+    if (!cadEnabled || busy || now - lastCadMs < CHANNEL_CAD_INTERVAL_MS) return;
+    if (tdmaScheduler.isMyTimeSlot() || tdmaScheduler.isInBeaconSubframe()) return;
+    lastCadMs = now;
+
+    int8_t activity = sampleChannelActivity();
+    if (activity >= 0) {
+        addCadSample(activity == 1, synced, second);
+    }
+}
+
+void ChannelMonitor::addRssiSample(int16_t dbm, bool synced, uint8_t second) {
+    if (!floorValid) {
+        floorDbm = dbm;
+        floorValid = true;
+    }
+
+    bool busy = dbm > floorDbm + CHANNEL_BUSY_MARGIN_DB;
+    if (!busy) {
+        floorDbm += CHANNEL_FLOOR_ALPHA * (dbm - floorDbm);
+    }
+
+    if (minuteSamples == 0 || dbm < minuteMinDbm) minuteMinDbm = dbm;
+    if (dbm > minuteMaxDbm) minuteMaxDbm = dbm;
+    minuteSamples++;
+    if (busy) minuteBusy++;
+
+    metricInc(MET_CHANNEL_SAMPLES);
+    if (busy) metricInc(MET_CHANNEL_BUSY_SAMPLES);
+    metricObserve(HIST_CHANNEL_RSSI, dbm);
+
+    if (!synced) return;
+    ChannelSecond& s = seconds[second];
+    s.rssiSamples++;
+    s.rssiSumDbm += dbm;
+    if (busy) s.busySamples++;
+}
+
+void ChannelMonitor::addCadSample(bool detected, bool synced, uint8_t second) {
+    minuteCadScans++;
+    if (detected) minuteCadDetected++;
+
+    metricInc(MET_CAD_SCANS);
+    if (detected) metricInc(MET_CAD_DETECTED);
+
+    if (!synced) return;
+    seconds[second].cadScans++;
+    if (detected) seconds[second].cadDetected++;
+}
+
+void ChannelMonitor::closeMinute(unsigned long now) {
+    // A floor that only ever follows quiet samples cannot climb: if a whole
+    // minute stayed above it, the noise itself went up
+    if (minuteSamples > 0 && minuteMinDbm > floorDbm + CHANNEL_BUSY_MARGIN_DB) {
+        floorDbm = minuteMinDbm;
+    }
+
+    if (minuteSamples > 0) {
+        ChannelTrendPoint& point = trend[trendHead];
+        point.atMs = now;
+        point.floorDbm = (int8_t)lroundf(floorDbm);
+        point.maxDbm = (int8_t)minuteMaxDbm;
+        point.busyPct = (uint8_t)lroundf(percent(minuteBusy, minuteSamples));
+        point.cadPct = (uint8_t)lroundf(percent(minuteCadDetected, minuteCadScans));
+        trendHead = (trendHead + 1) % CHANNEL_TREND_MINUTES;
+        if (trendCount < CHANNEL_TREND_MINUTES) trendCount++;
+    }
+
+    // Age the heatmap so it follows recent conditions
+    for (uint8_t i = 0; i < 60; i++) {
+        ChannelSecond& s = seconds[i];
+        if (s.rssiSamples < CHANNEL_BUCKET_MAX_SAMPLES) continue;
+        s.rssiSamples /= 2;
+        s.busySamples /= 2;
+        s.rssiSumDbm /= 2;
+        s.cadScans /= 2;
+        s.cadDetected /= 2;
+    }
+
+    minuteStartMs = now;
+    minuteSamples = 0;
+    minuteBusy = 0;
+    minuteCadScans = 0;
+    minuteCadDetected = 0;
+    minuteMaxDbm = -127;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ACCESS                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void ChannelMonitor::setCadEnabled(bool enabled) {
+    cadEnabled = enabled;
+}
+
+bool ChannelMonitor::isCadEnabled() const {
+    return cadEnabled;
+}
+
+int16_t ChannelMonitor::getNoiseFloorDbm() const {
+    return (int16_t)lroundf(floorDbm);
+}
+
+uint8_t ChannelMonitor::getBusyPercent() const {
+    ChannelTrendPoint point;
+    return getTrend(0, point) ? point.busyPct : 0;
+}
+
+uint8_t ChannelMonitor::getCadPercent() const {
+    ChannelTrendPoint point;
+    return getTrend(0, point) ? point.cadPct : 0;
+}
+
+const ChannelSecond& ChannelMonitor::getSecond(uint8_t second) const {
+    return seconds[second % 60];
+}
+
+bool ChannelMonitor::getTrend(uint8_t index, ChannelTrendPoint& out) const {
+    if (index >= trendCount) return false;
+    out = trend[(trendHead + CHANNEL_TREND_MINUTES - 1 - index) % CHANNEL_TREND_MINUTES];
+    return true;
+}
+
+uint8_t ChannelMonitor::getTrendCount() const {
+    return trendCount;
+}
+
+// Running totals of the seconds in one slot
+struct SlotTotals {
+    uint32_t samples, busy, scans, detected;
+    int32_t  sumDbm;
+};
+
+static void finishSlot(ChannelSlotSummary& slot, const SlotTotals& t) {
+    slot.busyPct = percent(t.busy, t.samples);
+    slot.cadPct = percent(t.detected, t.scans);
+    slot.meanDbm = t.samples ? (float)t.sumDbm / t.samples : 0.0f;
+}
+
+uint8_t ChannelMonitor::getSlotSummaries(ChannelSlotSummary* out, uint8_t maxSlots) const {
+    uint8_t count = 0;
+    bool open = false;
+    SlotTotals totals;
+
+    for (uint8_t second = 0; second < 60; second++) {
+        uint8_t band, deviceId;
+        bool inSlot = tdmaScheduler.getSlotAt(second, band, deviceId);
+        bool extends = open && inSlot && out[count - 1].band == band &&
+                       out[count - 1].deviceId == deviceId;
+
+        if (extends) {
+            out[count - 1].lastSecond = second;
+        } else {
+            if (open) finishSlot(out[count - 1], totals);
+            open = false;
+            if (!inSlot) continue;
+            if (count == maxSlots) return count;
+
+            out[count].band = band;
+            out[count].deviceId = deviceId;
+            out[count].firstSecond = second;
+            out[count].lastSecond = second;
+            count++;
+            open = true;
+            memset(&totals, 0, sizeof(totals));
+        }
+
+        const ChannelSecond& s = seconds[second];
+        totals.samples += s.rssiSamples;
+        totals.busy += s.busySamples;
+        totals.scans += s.cadScans;
+        totals.detected += s.cadDetected;
+        totals.sumDbm += s.rssiSumDbm;
+    }
+
+    if (open) finishSlot(out[count - 1], totals);
+    return count;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REPORTING                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// One heatmap cell per second: blank, then light to full shade
+static const char* shade(float pct) {
+    if (pct < 1.0f)  return "·";
+    if (pct < 10.0f) return "░";
+    if (pct < 30.0f) return "▒";
+    if (pct < 60.0f) return "▓";
+    return "█";
+}
+
+void ChannelMonitor::printReport() const {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  CHANNEL OCCUPANCY                                            ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    Serial.printf("  Noise floor:  %d dBm (busy = floor + %u dB)\n",
+                  getNoiseFloorDbm(), CHANNEL_BUSY_MARGIN_DB);
+    Serial.printf("  Last minute:  %u%% busy, %u%% CAD activity\n",
+                  getBusyPercent(), getCadPercent());
+    Serial.printf("  Sampling:     RSSI every %u ms, CAD every %u ms (%s)\n",
+                  CHANNEL_RSSI_INTERVAL_MS, CHANNEL_CAD_INTERVAL_MS,
+                  cadEnabled ? "on" : "off");
+
+    // Heatmap, one column per second of the minute
+    Serial.println();
+    Serial.println(F("  Second   0         1         2         3         4         5"));
+    Serial.println(F("           012345678901234567890123456789012345678901234567890123456789"));
+    Serial.print(F("  Busy     "));
+    for (uint8_t i = 0; i < 60; i++) {
+        Serial.print(shade(percent(seconds[i].busySamples, seconds[i].rssiSamples)));
+    }
+    Serial.println();
+    Serial.print(F("  CAD      "));
+    for (uint8_t i = 0; i < 60; i++) {
+        Serial.print(shade(percent(seconds[i].cadDetected, seconds[i].cadScans)));
+    }
+    Serial.println();
+    Serial.println(F("           · <1%  ░ <10%  ▒ <30%  ▓ <60%  █ 60%+"));
+
+    ChannelSlotSummary slots[TDMAScheduler::DEPTH_BANDS * TDMAScheduler::MAX_NODES];
+    uint8_t slotCount = getSlotSummaries(slots, sizeof(slots) / sizeof(slots[0]));
+    if (slotCount > 0) {
+        Serial.println();
+        Serial.println(F("    Slot        Seconds   Busy     CAD    Mean dBm"));
+        for (uint8_t i = 0; i < slotCount; i++) {
+            const ChannelSlotSummary& s = slots[i];
+            Serial.printf("    B%u Node %-3u %2u-%-2u   %5.1f%%  %5.1f%%   %6.1f\n",
+                          s.band, s.deviceId, s.firstSecond, s.lastSecond,
+                          s.busyPct, s.cadPct, s.meanDbm);
+        }
+    }
+
+    if (trendCount > 0) {
+        Serial.println();
+        Serial.println(F("    Min ago   Floor   Max    Busy   CAD"));
+        uint8_t shown = trendCount < 10 ? trendCount : 10;
+        for (uint8_t i = 0; i < shown; i++) {
+            ChannelTrendPoint point;
+            getTrend(i, point);
+            Serial.printf("    %5lu    %5d  %5d  %4u%%  %3u%%\n",
+                          (unsigned long)((millis() - point.atMs) / 60000UL),
+                          point.floorDbm, point.maxDbm, point.busyPct, point.cadPct);
+        }
+    }
+    Serial.println();
+}
+
+void ChannelMonitor::printJson(Print& out) const {
+    out.printf("{\"noiseFloor\":%d,\"busyPct\":%u,\"cadPct\":%u,\"cad\":%s,\"synced\":%s,",
+               getNoiseFloorDbm(), getBusyPercent(), getCadPercent(),
+               cadEnabled ? "true" : "false",
+               tdmaScheduler.getStatus().timeSynced ? "true" : "false");
+
+    // [busy %, CAD %, mean dBm, samples] per second of the minute
+    out.print(F("\"seconds\":["));
+    for (uint8_t i = 0; i < 60; i++) {
+        const ChannelSecond& s = seconds[i];
+        out.printf("%s[%.1f,%.1f,%d,%u]", i ? "," : "",
+                   percent(s.busySamples, s.rssiSamples),
+                   percent(s.cadDetected, s.cadScans),
+                   s.rssiSamples ? (int)lroundf((float)s.rssiSumDbm / s.rssiSamples) : 0,
+                   s.rssiSamples);
+    }
+
+    ChannelSlotSummary slots[TDMAScheduler::DEPTH_BANDS * TDMAScheduler::MAX_NODES];
+    uint8_t slotCount = getSlotSummaries(slots, sizeof(slots) / sizeof(slots[0]));
+    out.print(F("],\"slots\":["));
+    for (uint8_t i = 0; i < slotCount; i++) {
+        const ChannelSlotSummary& s = slots[i];
+        out.printf("%s{\"band\":%u,\"node\":%u,\"from\":%u,\"to\":%u,\"busy\":%.1f,\"cad\":%.1f,\"meanDbm\":%.1f}",
+                   i ? "," : "", s.band, s.deviceId, s.firstSecond, s.lastSecond,
+                   s.busyPct, s.cadPct, s.meanDbm);
+    }
+
+    // Oldest first: [minutes ago, floor, max, busy %, CAD %]
+    out.print(F("],\"trend\":["));
+    for (uint8_t i = trendCount; i > 0; i--) {
+        ChannelTrendPoint point;
+        getTrend(i - 1, point);
+        out.printf("%s[%lu,%d,%d,%u,%u]", (i < trendCount) ? "," : "",
+                   (unsigned long)((millis() - point.atMs) / 60000UL),
+                   point.floorDbm, point.maxDbm, point.busyPct, point.cadPct);
+    }
+    out.print(F("]}"));
+}
+
+void printChannelJsonFields(Print& out) {
+    out.printf(",\"noiseFloor\":%d,\"chanBusyPct\":%u,\"cadPct\":%u",
+               channelMonitor.getNoiseFloorDbm(),
+               channelMonitor.getBusyPercent(),
+               channelMonitor.getCadPercent());
+}
+
+// Collects printJson() output for the web server
+class ChannelStringPrint : public Print {
+public:
+    String& target;
+    explicit ChannelStringPrint(String& s) : target(s) {}
+    size_t write(uint8_t c) override {
+        target += (char)c;
+        return 1;
+    }
+};
+
+String getChannelJson() {
+    String json;
+    json.reserve(2560);
+    ChannelStringPrint printer(json);
+    channelMonitor.printJson(printer);
+    return json;
+}
@@ -3,17 +3,46 @@
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GATEWAY CONFIGURATION                             ║
-// ║  Set GATEWAY_NODE_ID to the DEVICE_ID of the node that hosts dashboard   ║
-// ║  Example: If GATEWAY_NODE_ID = 1, then Device 1 becomes the gateway      ║
+// ║  List the DEVICE_IDs of every node with an uplink in GATEWAY_NODE_IDS    ║
+// ║  The first entry is the primary gateway (uploads flooded reports)        ║
+// ║  Example: { 1, 4, 0 } makes Device 1 and Device 4 gateways               ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-const uint8_t GATEWAY_NODE_ID = 1;               // Which node ID is the gateway?
+constexpr uint8_t GATEWAY_NODE_IDS[MAX_GATEWAYS] = { 1, 0, 0 };  // Which node IDs are gateways? (0 = unused)
+const uint8_t GATEWAY_NODE_ID = GATEWAY_NODE_IDS[0];          // Primary gateway
+const unsigned long UPLINK_CLAIM_WAIT_MS = 150000;            // Wait for another gateway's claim (claims ride the next slots)
+
+bool isGatewayId(uint8_t nodeId) {
+    if (nodeId == 0) return false;
+    for (uint8_t i = 0; i < MAX_GATEWAYS; i++) {
+        if (GATEWAY_NODE_IDS[i] == nodeId) return true;
+    }
+    return false;
+}
+
+// isGatewayId() at compile time, for the role check below
+static constexpr bool listsGateway(uint8_t nodeId, uint8_t i = 0) {
+    return nodeId != 0 && i < MAX_GATEWAYS &&
+           (GATEWAY_NODE_IDS[i] == nodeId || listsGateway(nodeId, i + 1));
+}
 
 // ⚠️  CRITICAL: IS_GATEWAY depends on DEVICE_ID initialization
 // These MUST remain in the same compilation unit (config.cpp) to ensure
 // proper initialization order. Do not move IS_GATEWAY to a different file.
 // Static initialization order fiasco prevention: both constants are in same TU.
-const bool IS_GATEWAY = (DEVICE_ID == GATEWAY_NODE_ID);
+#if MESH_ROLE == MESH_ROLE_ANY
+const bool IS_GATEWAY = isGatewayId(DEVICE_ID);
+#endif
+
+#if MESH_ROLE == MESH_ROLE_GATEWAY
+const char* const BUILD_ROLE_NAME = "gateway";
+#elif MESH_ROLE == MESH_ROLE_RELAY
+const char* const BUILD_ROLE_NAME = "relay";
+#elif MESH_ROLE == MESH_ROLE_LEAF
+const char* const BUILD_ROLE_NAME = "leaf";
+#else
+const char* const BUILD_ROLE_NAME = "any";
+#endif
 const char* WIFI_AP_SSID = "LoRa_Mesh";          // Network name
 const char* WIFI_AP_PASSWORD = "mesh1234";       // Password (min 8 chars)
 
@@ -51,6 +80,14 @@ const char* WIFI_STA_PASSWORD = "";  // Your hotspot password
 const uint8_t DEVICE_ID = 3;
 const char* const DEVICE_NAME = "DEV3";
 
+// A role build fixes IS_GATEWAY at compile time: refuse to build an image
+// whose role disagrees with GATEWAY_NODE_IDS for this DEVICE_ID
+#if MESH_ROLE != MESH_ROLE_ANY
+static_assert(listsGateway(DEVICE_ID) == (MESH_ROLE == MESH_ROLE_GATEWAY),
+              "MESH_ROLE disagrees with GATEWAY_NODE_IDS for this DEVICE_ID "
+              "(use the gateway env only for listed IDs, relay/leaf for the rest)");
+#endif
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         TIMEZONE CONFIGURATION                            ║
 // ║  Change this for your timezone                                           ║
@@ -71,6 +108,7 @@ const unsigned long DISPLAY_UPDATE_INTERVAL_MS = 250;
 
 // Node health timing
 const unsigned long NODE_TIMEOUT_MS = 90000;
+const unsigned long NODE_EVICT_AGE_MS = 3600000;         // Silent for an hour: may be evicted from a full node table
 
 // Status print intervals
 const unsigned long GPS_STATUS_INTERVAL_MS = 5000;
@@ -83,6 +121,13 @@ const unsigned long DUPLICATE_TIMEOUT_MS = 60000;
 // Neighbor table maintenance
 const unsigned long NEIGHBOR_PRUNE_INTERVAL_MS = 60000;  // Prune expired neighbors every 60 seconds
 
+// Gateway reorder window
+const unsigned long REORDER_HOLD_MS = 65000;  // Max wait for a missing report (one TDMA frame + margin)
+
+// Warm start
+const unsigned long WARM_START_SNAPSHOT_INTERVAL_MS = 10000;  // RTC snapshot of routes/neighbors/time every 10 seconds
+const bool USE_RATE_LIMIT = true;                         // Drop a babbling node's excess frames from the header alone
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GRADIENT ROUTING CONFIGURATION                    ║
 // ║  Gradient routing reduces bandwidth by ~64% compared to flooding          ║
@@ -90,36 +135,40 @@ const unsigned long NEIGHBOR_PRUNE_INTERVAL_MS = 60000;  // Prune expired neighb
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 const bool USE_GRADIENT_ROUTING = true;                  // Enable gradient routing (false = pure flooding)
-const unsigned long BEACON_INTERVAL_MS = 30000;          // Gateway beacon interval (30 seconds)
-const unsigned long ROUTE_TIMEOUT_MS = 60000;            // Route expires after 60 seconds without beacon
+const unsigned long BEACON_INTERVAL_MS = 30000;          // Gateway beacon interval (30 seconds, used until time is synced)
+const unsigned long ROUTE_TIMEOUT_MS = 150000;           // Route expires after 2.5 minutes without beacon (one per minute in the sub-frame)
 const unsigned long BEACON_REBROADCAST_MIN_MS = 100;     // Min random delay before beacon rebroadcast
 const unsigned long BEACON_REBROADCAST_MAX_MS = 500;     // Max random delay before beacon rebroadcast
+const bool USE_DEPTH_ORDERED_SLOTS = true;               // Deepest nodes transmit first so relays forward in the same minute
+const bool USE_BEACON_SUBFRAME = true;                   // Gateway beacons at second 0, relays in per-depth micro-slots (needs synced time)
+const bool USE_RELAY_SLOT_MONITOR = false;               // Relays time neighbors against the schedule too ('mesh slots'); only the gateway corrects
 
 // ThingSpeak Configuration
-const char* THINGSPEAK_API_KEYS[] = {
-    "",                 // Gateway
-    "8LBHS85TKG8AS2U0", // Node 2
-    "D35GBS8QVSC0BVQJ", // Node 3
-    "I1MFITOW8JNJJWD1", // Node 4
-    "KS12LH06QHZU8D8J"  // Node 5
-};
-// ThingSpeak Channel IDs (index 0 = Node 1, index 1 = Node 2, etc.)
-const unsigned long THINGSPEAK_CHANNEL_IDS[] = {
-    0,         // Node 1 (gateway) - not used
-    3194362,   // Node 2 - replace with your actual channel ID
-    3194371,         // Node 3 - replace when you create the channel
-    3194372,         // Node 4 - replace when you create the channel
-    3194374          // Node 5 - replace when you create the channel
-};
-const char* THINGSPEAK_READ_KEYS[] = {
-    "",                  // Node 1 (gateway) - not used
-    "DZ7L3266JBJ0TITC",  // Node 2 - replace with actual Read API Key
-    "HZFT8OH0W6CI6BXJ",                  // Node 3
-    "3LOL0G23XL9SYF6F",                  // Node 4
-    "UEF28CAKQ0OUGYX8"                   // Node 5
+// One entry per uploading node, any order and any node IDs (the gateway
+// doesn't upload its own data). Nodes without an entry are not uploaded.
+const ThingSpeakChannel THINGSPEAK_CHANNELS[] = {
+    //  Node  Write API Key       Channel ID  Read API Key
+    {   2,    "8LBHS85TKG8AS2U0", 3194362,    "DZ7L3266JBJ0TITC" },
+    {   3,    "D35GBS8QVSC0BVQJ", 3194371,    "HZFT8OH0W6CI6BXJ" },
+    {   4,    "I1MFITOW8JNJJWD1", 3194372,    "3LOL0G23XL9SYF6F" },
+    {   5,    "KS12LH06QHZU8D8J", 3194374,    "UEF28CAKQ0OUGYX8" },
 };
+const uint8_t THINGSPEAK_CHANNEL_COUNT = sizeof(THINGSPEAK_CHANNELS) / sizeof(THINGSPEAK_CHANNELS[0]);
 const bool THINGSPEAK_ENABLED = true;
 
+// Cloud uplink backend used until "mesh uplink <thingspeak|mqtt|off>" saves another one
+const UplinkBackend UPLINK_DEFAULT_BACKEND = UPLINK_THINGSPEAK;
+
+// MQTT uplink Configuration
+// The gateway keeps one session open (clean session off) and publishes
+// batches of compact binary reports - see include/mqtt_uplink.h for the layout
+const char* MQTT_BROKER_HOST = "192.168.1.10";
+const uint16_t MQTT_BROKER_PORT = 1883;
+const char* MQTT_USERNAME = "";
+const char* MQTT_PASSWORD = "";
+const char* MQTT_TOPIC_PREFIX = "cecs490/mesh";
+const uint16_t MQTT_KEEPALIVE_SEC = 60;
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         SENSOR CONFIGURATION                              ║
 // ║  Enable/disable SHT30 and BMP180 sensors                                  ║
@@ -131,6 +180,17 @@ const bool SENSOR_BMP180_ENABLED = true;      // Pressure/altitude sensor
 const unsigned long SENSOR_READ_INTERVAL_MS = 5000;  // Read sensors every 5 seconds
 const float SEA_LEVEL_PRESSURE_PA = 102000.0; // Adjusted for Long Beach ~62ft elevation + current weather (~1020 hPa)
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GPS CONFIGURATION                                 ║
+// ║  UBX mode switches the NEO-6M to binary NAV messages (~73% fewer UART     ║
+// ║  bytes, no NMEA parsing); wire GPIO45 to the GPS RX pin for it            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+const bool GPS_UBX_MODE = true;                          // Configure the receiver over UBX at boot (NMEA if it never ACKs)
+const bool GPS_FIXED_POSITION = true;                    // Weather stations don't move: power save after a settled 3D fix
+const unsigned long GPS_POWER_SAVE_PERIOD_MS = 1000;     // Cyclic tracking at 1 Hz keeps TDMA time exact (~11 mA vs ~39 mA)
+const unsigned long GPS_HOLDOVER_MAX_MS = 120000;        // Without a fix, GPS time free-runs on millis() for 2 minutes
+
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         TIME HELPER FUNCTIONS                             ║
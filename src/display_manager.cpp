@@ -1,4 +1,5 @@
 #include "display_manager.h"
+#include <atomic>
 #include "config.h"
 #include "node_store.h"
 #include "neo6m.h"
@@ -21,6 +22,10 @@ unsigned long displayStateStart = 0;
 
 static unsigned long lastDisplayUpdate = 0;
 
+// Set once initDisplay() succeeds on the boot services task (core 0); the
+// release store publishes the OLED state to loop() (core 1)
+static std::atomic<bool> displayReady(false);
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         DISPLAY MESSAGE METHODS                           ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -77,11 +82,13 @@ void DisplayMessage::updateFromTx(const String& msg, uint16_t seqNum) {
 // ║                         INITIALIZATION                                    ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-bool initDisplay() {
+void resetDisplayState() {
     rxMessage.clear();
     txMessage.clear();
     currentDisplay = DISPLAY_WAITING;
+}
 
+bool initDisplay() {
     if (display.init()) {
         display.clearDisplay();
 
@@ -92,6 +99,7 @@ bool initDisplay() {
 
         display.drawString(0, 10, "Starting...");
         display.updateDisplay();
+        displayReady.store(true, std::memory_order_release);
         return true;
     }
     return false;
@@ -129,9 +137,9 @@ void displayWaiting() {
         display.drawString(0, 10, timeStr);
 
         // Satellites on same line
-        if (gps.satellites.isValid()) {
+        if (isSatellitesValid()) {
             char satStr[16];
-            snprintf(satStr, sizeof(satStr), "Sat:%d", gps.satellites.value());
+            snprintf(satStr, sizeof(satStr), "Sat:%d", getGPSSatellites());
             display.drawString(78, 10, satStr);
         }
     } else {
@@ -143,37 +151,45 @@ void displayWaiting() {
     snprintf(countersStr, sizeof(countersStr), "Tx:%lu Rx:%lu", txSeq, getRxCount());
     display.drawString(0, 20, countersStr);
     
-    // Line 3: Node status with better icons
+    // Line 3: Node status with better icons (live nodes in ID order)
     char nodeStatus[32];
     int pos = snprintf(nodeStatus, sizeof(nodeStatus), "Nodes:");
-    for (uint8_t i = 1; i <= MESH_MAX_NODES && pos < 31; i++) {
-        if (i == DEVICE_ID) {
+    uint16_t online = 0;
+    uint16_t known = 0;
+    uint16_t cursor = 0;
+    NodeSnapshot node;
+    while (nextLiveNode(cursor, node)) {
+        if (node.nodeId != DEVICE_ID && !node.hasData) continue;
+        known++;
+        if (node.nodeId == DEVICE_ID || node.isOnline) online++;
+        if (pos >= 31) continue;
+
+        if (node.nodeId == DEVICE_ID) {
             pos += snprintf(nodeStatus + pos, sizeof(nodeStatus) - pos, "*");  // Self
+        } else if (node.isOnline) {
+            pos += snprintf(nodeStatus + pos, sizeof(nodeStatus) - pos, "%d", node.nodeId);  // Show node number
         } else {
-            NodeMessage* node = getNodeMessage(i);
-            if (node && node->isOnline) {
-                pos += snprintf(nodeStatus + pos, sizeof(nodeStatus) - pos, "%d", i);  // Show node number
-            } else if (node && node->hasData) {
-                pos += snprintf(nodeStatus + pos, sizeof(nodeStatus) - pos, "x");  // Was online, now offline
-            } else {
-                pos += snprintf(nodeStatus + pos, sizeof(nodeStatus) - pos, "-");  // Never seen
-            }
+            pos += snprintf(nodeStatus + pos, sizeof(nodeStatus) - pos, "x");  // Was online, now offline
         }
     }
+    if (pos >= 31) {
+        // Too many to list on one line - show counts instead
+        snprintf(nodeStatus, sizeof(nodeStatus), "Nodes: %u/%u online", online, known);
+    }
     display.drawString(0, 30, nodeStatus);
     
     // Line 4: Last heard (if any nodes online)
     char lastHeard[32];
     int lhPos = 0;
-    for (uint8_t i = 1; i <= MESH_MAX_NODES && lhPos < 30; i++) {
-        if (i == DEVICE_ID) continue;
-        NodeMessage* node = getNodeMessage(i);
-        if (node && node->hasData && node->isOnline) {
-            unsigned long age = node->getAgeSeconds();
+    cursor = 0;
+    while (lhPos < 30 && nextLiveNode(cursor, node)) {
+        if (node.nodeId == DEVICE_ID) continue;
+        if (node.hasData && node.isOnline) {
+            unsigned long age = node.getAgeSeconds();
             if (lhPos > 0 && lhPos < 31) {
                 lastHeard[lhPos++] = ' ';  // Add space separator
             }
-            lhPos += snprintf(lastHeard + lhPos, sizeof(lastHeard) - lhPos, "N%d:%lus", i, age);
+            lhPos += snprintf(lastHeard + lhPos, sizeof(lastHeard) - lhPos, "N%d:%lus", node.nodeId, age);
         }
     }
     if (lhPos > 0) {
@@ -233,7 +249,13 @@ void displayTxFailed() {
     display.drawString(0, 45, "and LoRa module");
 }
 
+bool isDisplayReady() {
+    return displayReady.load(std::memory_order_acquire);
+}
+
 void updateDisplay() {
+    if (!isDisplayReady()) return;
+
     display.clearDisplay();
 
     switch (currentDisplay) {
@@ -300,6 +322,8 @@ void updateRxDisplayFullReport(const LoRaReceivedPacket& packet, const FullRepor
 
     setDisplayState(DISPLAY_RECEIVED_MSG);
 
+    if (!isDisplayReady()) return;
+
     display.clearDisplay();
 
     // Line 0: Header with node ID
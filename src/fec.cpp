@@ -0,0 +1,399 @@
+#include "fec.h"
+#include <string.h>
+#include <math.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "neighbor_table.h"
+#endif
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GF(256) ARITHMETIC                                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Field polynomial x^8 + x^4 + x^3 + x^2 + 1, generator 2
+static const uint16_t GF_POLY = 0x11D;
+
+// Repair row j uses Cauchy point FEC_MAX_DATA_FRAMES + j, data column i
+// uses point i; the two sets never meet, so every square submatrix of
+// [identity; Cauchy] is invertible (any n frames decode).
+static const uint8_t REPAIR_POINT_BASE = FEC_MAX_DATA_FRAMES;
+
+static uint8_t gfExp[512];      // Doubled so log sums need no modulo
+static uint8_t gfLog[256];
+static bool    gfReady = false;
+
+void fecInit() {
+    if (gfReady) return;
+
+    uint16_t x = 1;
+    for (uint16_t i = 0; i < 255; i++) {
+        gfExp[i] = (uint8_t)x;
+        gfLog[x] = (uint8_t)i;
+        x <<= 1;
+        if (x & 0x100) x ^= GF_POLY;
+    }
+    for (uint16_t i = 255; i < 512; i++) {
+        gfExp[i] = gfExp[i - 255];
+    }
+    gfLog[0] = 0;   // Never read: callers skip zero
+    gfReady = true;
+}
+
+static inline uint8_t gfMul(uint8_t a, uint8_t b) {
+    if (a == 0 || b == 0) return 0;
+    return gfExp[gfLog[a] + gfLog[b]];
+}
+
+static inline uint8_t gfInv(uint8_t a) {
+    return gfExp[255 - gfLog[a]];
+}
+
+// Coefficient of data frame col in repair frame row
+static inline uint8_t cauchyCoef(uint8_t row, uint8_t col) {
+    return gfInv((uint8_t)(REPAIR_POINT_BASE + row) ^ col);
+}
+
+// dst ^= c * src
+static void gfMulAdd(uint8_t* dst, const uint8_t* src, uint8_t c, uint16_t len) {
+    if (c == 0) return;
+    if (c == 1) {
+        for (uint16_t b = 0; b < len; b++) dst[b] ^= src[b];
+        return;
+    }
+    const uint8_t* expC = &gfExp[gfLog[c]];
+    for (uint16_t b = 0; b < len; b++) {
+        uint8_t s = src[b];
+        if (s) dst[b] ^= expC[gfLog[s]];
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ENCODE / DECODE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+bool fecEncode(const uint8_t* const* data, uint8_t n, uint8_t* const* repair, uint8_t k, uint16_t len) {
+    if (n == 0 || n > FEC_MAX_DATA_FRAMES || k > FEC_MAX_REPAIR_FRAMES) return false;
+    fecInit();
+
+    for (uint8_t j = 0; j < k; j++) {
+        memset(repair[j], 0, len);
+        for (uint8_t i = 0; i < n; i++) {
+            gfMulAdd(repair[j], data[i], cauchyCoef(j, i), len);
+        }
+    }
+    return true;
+}
+
+// Gauss-Jordan inverse of an m x m matrix (rows of FEC_MAX_REPAIR_FRAMES)
+static bool gfInvert(uint8_t a[][FEC_MAX_REPAIR_FRAMES], uint8_t inv[][FEC_MAX_REPAIR_FRAMES], uint8_t m) {
+    for (uint8_t r = 0; r < m; r++) {
+        memset(inv[r], 0, m);
+        inv[r][r] = 1;
+    }
+
+    for (uint8_t col = 0; col < m; col++) {
+        uint8_t pivot = col;
+        while (pivot < m && a[pivot][col] == 0) pivot++;
+        if (pivot == m) return false;
+
+        if (pivot != col) {
+            for (uint8_t c = 0; c < m; c++) {
+                uint8_t t = a[col][c]; a[col][c] = a[pivot][c]; a[pivot][c] = t;
+                t = inv[col][c]; inv[col][c] = inv[pivot][c]; inv[pivot][c] = t;
+            }
+        }
+
+        uint8_t scale = gfInv(a[col][col]);
+        for (uint8_t c = 0; c < m; c++) {
+            a[col][c] = gfMul(a[col][c], scale);
+            inv[col][c] = gfMul(inv[col][c], scale);
+        }
+
+        for (uint8_t r = 0; r < m; r++) {
+            uint8_t factor = a[r][col];
+            if (r == col || factor == 0) continue;
+            for (uint8_t c = 0; c < m; c++) {
+                a[r][c] ^= gfMul(factor, a[col][c]);
+                inv[r][c] ^= gfMul(factor, inv[col][c]);
+            }
+        }
+    }
+    return true;
+}
+
+bool fecDecode(uint8_t* const* frames, const bool* received, uint8_t n, uint8_t k, uint16_t len) {
+    if (n == 0 || n > FEC_MAX_DATA_FRAMES || k > FEC_MAX_REPAIR_FRAMES) return false;
+    fecInit();
+
+    uint8_t missing[FEC_MAX_REPAIR_FRAMES];
+    uint8_t m = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        if (received[i]) continue;
+        if (m == k) return false;           // More holes than repair frames
+        missing[m++] = i;
+    }
+    if (m == 0) return true;
+
+    uint8_t rows[FEC_MAX_REPAIR_FRAMES];
+    uint8_t found = 0;
+    for (uint8_t j = 0; j < k && found < m; j++) {
+        if (received[n + j]) rows[found++] = j;
+    }
+    if (found < m) return false;
+
+    // Repair rows restricted to the missing columns, inverted
+    uint8_t a[FEC_MAX_REPAIR_FRAMES][FEC_MAX_REPAIR_FRAMES];
+    uint8_t inv[FEC_MAX_REPAIR_FRAMES][FEC_MAX_REPAIR_FRAMES];
+    for (uint8_t r = 0; r < m; r++) {
+        for (uint8_t c = 0; c < m; c++) {
+            a[r][c] = cauchyCoef(rows[r], missing[c]);
+        }
+    }
+    if (!gfInvert(a, inv, m)) return false;
+
+    // Syndromes: each repair frame minus the data that did arrive, built
+    // in the missing frames' own buffers
+    for (uint8_t r = 0; r < m; r++) {
+        uint8_t* s = frames[missing[r]];
+        memcpy(s, frames[n + rows[r]], len);
+        for (uint8_t i = 0; i < n; i++) {
+            if (received[i]) gfMulAdd(s, frames[i], cauchyCoef(rows[r], i), len);
+        }
+    }
+
+    // Missing data = inverse x syndromes, one byte column at a time
+    uint8_t column[FEC_MAX_REPAIR_FRAMES];
+    for (uint16_t b = 0; b < len; b++) {
+        for (uint8_t r = 0; r < m; r++) column[r] = frames[missing[r]][b];
+        for (uint8_t c = 0; c < m; c++) {
+            uint8_t v = 0;
+            for (uint8_t r = 0; r < m; r++) v ^= gfMul(inv[c][r], column[r]);
+            frames[missing[c]][b] = v;
+        }
+    }
+    return true;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REDUNDANCY PLANNING                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+float fecGroupDelivery(uint8_t n, uint8_t k, float lossRate) {
+    if (lossRate <= 0.0f) return 1.0f;
+    if (lossRate >= 1.0f) return 0.0f;
+
+    // P(losses <= k) for Binomial(n + k, p), term by term
+    uint16_t total = (uint16_t)n + k;
+    double p = lossRate;
+    double term = pow(1.0 - p, total);
+    double sum = term;
+    for (uint16_t j = 0; j < k; j++) {
+        term *= (double)(total - j) / (j + 1) * p / (1.0 - p);
+        sum += term;
+    }
+    return (float)(sum > 1.0 ? 1.0 : sum);
+}
+
+uint8_t fecRepairFrames(uint8_t n, float lossRate) {
+    if (n == 0) return 0;
+    if (lossRate < FEC_MIN_LOSS_RATE) lossRate = FEC_MIN_LOSS_RATE;
+
+    for (uint8_t k = 0; k < FEC_MAX_REPAIR_FRAMES; k++) {
+        if (fecGroupDelivery(n, k, lossRate) >= FEC_TARGET_DELIVERY) return k;
+    }
+    return FEC_MAX_REPAIR_FRAMES;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         TRANSFER SIMULATION                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static uint32_t simState = 1;
+
+static float simRandom() {
+    simState ^= simState << 13;
+    simState ^= simState >> 17;
+    simState ^= simState << 5;
+    return (simState >> 8) * (1.0f / 16777216.0f);
+}
+
+// Rounds until done for one plain ARQ transfer
+static uint8_t simulateArq(uint8_t n, float loss, uint32_t& sent) {
+    uint32_t all = (n >= 32) ? 0xFFFFFFFFUL : ((1UL << n) - 1);
+    uint32_t have = 0;
+    uint32_t toSend = all;                  // Sender's view of what is missing
+
+    for (uint8_t round = 1; round <= FEC_SIM_MAX_ROUNDS; round++) {
+        for (uint8_t i = 0; i < n; i++) {
+            if (!(toSend & (1UL << i))) continue;
+            sent++;
+            if (simRandom() >= loss) have |= (1UL << i);
+        }
+        if (have == all) return round;
+        if (simRandom() >= loss) toSend = all & ~have;      // NACK arrived
+    }
+    return FEC_SIM_MAX_ROUNDS + 1;
+}
+
+// Rounds until done for one FEC transfer (any n distinct frames decode)
+static uint8_t simulateFec(uint8_t n, uint8_t k, float loss, uint32_t& sent) {
+    uint16_t have = 0;
+    uint16_t burst = (uint16_t)n + k;
+
+    for (uint8_t round = 1; round <= FEC_SIM_MAX_ROUNDS; round++) {
+        for (uint16_t f = 0; f < burst; f++) {
+            sent++;
+            if (simRandom() >= loss) have++;
+        }
+        if (have >= n) return round;
+        if (simRandom() >= loss) {                          // NACK carries the shortfall
+            uint8_t shortfall = (uint8_t)(n - have);
+            burst = shortfall + fecRepairFrames(shortfall, loss);
+        }
+    }
+    return FEC_SIM_MAX_ROUNDS + 1;
+}
+
+void fecSimulateTransfer(uint8_t n, uint8_t repairFrames, float lossRate,
+                         uint16_t trials, uint32_t seed, FecSimResult& out) {
+    memset(&out, 0, sizeof(out));
+    if (n == 0 || n > FEC_MAX_DATA_FRAMES || trials == 0) return;
+
+    simState = seed ? seed : 1;
+    uint32_t histogram[FEC_SIM_MAX_ROUNDS + 2] = { 0 };
+    uint32_t roundSum = 0;
+    uint32_t sent = 0;
+    uint16_t failed = 0;
+
+    for (uint16_t t = 0; t < trials; t++) {
+        uint8_t rounds = repairFrames
+            ? simulateFec(n, repairFrames, lossRate, sent)
+            : simulateArq(n, lossRate, sent);
+        histogram[rounds]++;
+        if (rounds > FEC_SIM_MAX_ROUNDS) failed++;
+        roundSum += rounds;
+    }
+
+    out.meanRounds = (float)roundSum / trials;
+    out.framesPerData = (float)sent / ((uint32_t)trials * n);
+    out.failedPct = 100.0f * failed / trials;
+
+    uint32_t target = (uint32_t)ceilf(trials * 0.95f);
+    uint32_t seen = 0;
+    for (uint8_t r = 1; r < FEC_SIM_MAX_ROUNDS + 2; r++) {
+        seen += histogram[r];
+        if (seen >= target) {
+            out.p95Rounds = r;
+            break;
+        }
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ON-DEVICE BENCHMARK                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#ifdef ARDUINO
+
+#define FEC_BENCH_FRAME_BYTES       200     // Payload of one frame (LoRa max 255 less headers)
+#define FEC_BENCH_ITERATIONS        20
+
+uint8_t fecRepairFramesFor(uint8_t nodeId, uint8_t n) {
+    float loss;
+    if (!neighborTable.getLinkLoss(nodeId, loss)) loss = FEC_DEFAULT_LOSS_RATE;
+    return fecRepairFrames(n, loss);
+}
+
+// Encode, then drop the first k data frames (worst case) and decode
+static void benchGroup(uint8_t n, uint8_t k) {
+    static uint8_t store[FEC_MAX_DATA_FRAMES + FEC_MAX_REPAIR_FRAMES][FEC_BENCH_FRAME_BYTES];
+    static uint8_t original[FEC_MAX_REPAIR_FRAMES][FEC_BENCH_FRAME_BYTES];
+    uint8_t* frames[FEC_MAX_DATA_FRAMES + FEC_MAX_REPAIR_FRAMES];
+    bool received[FEC_MAX_DATA_FRAMES + FEC_MAX_REPAIR_FRAMES];
+
+    for (uint8_t f = 0; f < n + k; f++) frames[f] = store[f];
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint16_t b = 0; b < FEC_BENCH_FRAME_BYTES; b++) store[i][b] = (uint8_t)(i * 31 + b * 7 + 1);
+    }
+    for (uint8_t i = 0; i < k; i++) memcpy(original[i], store[i], FEC_BENCH_FRAME_BYTES);
+
+    unsigned long start = micros();
+    for (uint8_t it = 0; it < FEC_BENCH_ITERATIONS; it++) {
+        fecEncode(frames, n, frames + n, k, FEC_BENCH_FRAME_BYTES);
+    }
+    unsigned long encodeUs = micros() - start;
+
+    bool ok = true;
+    unsigned long decodeUs = 0;
+    for (uint8_t it = 0; it < FEC_BENCH_ITERATIONS; it++) {
+        for (uint8_t f = 0; f < n + k; f++) received[f] = (f >= k);
+        for (uint8_t i = 0; i < k; i++) memset(store[i], 0, FEC_BENCH_FRAME_BYTES);
+        start = micros();
+        ok &= fecDecode(frames, received, n, k, FEC_BENCH_FRAME_BYTES);
+        decodeUs += micros() - start;
+    }
+    for (uint8_t i = 0; i < k; i++) {
+        if (memcmp(original[i], store[i], FEC_BENCH_FRAME_BYTES) != 0) ok = false;
+    }
+
+    float dataKb = (float)n * FEC_BENCH_FRAME_BYTES * FEC_BENCH_ITERATIONS / 1024.0f;
+    Serial.printf("    %2u+%-2u  %8.1f us %7.0f KB/s  %8.1f us %7.0f KB/s  %s\n",
+                  n, k,
+                  (float)encodeUs / FEC_BENCH_ITERATIONS, dataKb / (encodeUs / 1e6f),
+                  (float)decodeUs / FEC_BENCH_ITERATIONS, dataKb / (decodeUs / 1e6f),
+                  ok ? "ok" : "MISMATCH");
+}
+
+void runFecBenchmark() {
+    fecInit();
+
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  FEC BENCHMARK                                                ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  %u-byte frames, %u groups per point, decode with k data frames lost\n",
+                  FEC_BENCH_FRAME_BYTES, FEC_BENCH_ITERATIONS);
+    Serial.println(F("    n+k     encode/group   rate      decode/group   rate"));
+    benchGroup(4, 1);
+    benchGroup(8, 2);
+    benchGroup(16, 4);
+    benchGroup(32, 8);
+
+    Serial.println();
+    Serial.println(F("  Completion time, 16-frame transfer (1 round = 1 TDMA cycle)"));
+    Serial.println(F("    loss   k   ARQ mean  p95  frames   FEC mean  p95  frames"));
+    static const float LOSS_POINTS[] = { 0.01f, 0.05f, 0.10f, 0.20f, 0.30f };
+    for (uint8_t p = 0; p < sizeof(LOSS_POINTS) / sizeof(LOSS_POINTS[0]); p++) {
+        float loss = LOSS_POINTS[p];
+        uint8_t k = fecRepairFrames(16, loss);
+        FecSimResult arq, fec;
+        fecSimulateTransfer(16, 0, loss, 1000, 490 + p, arq);
+        fecSimulateTransfer(16, k, loss, 1000, 490 + p, fec);
+        Serial.printf("    %3.0f%%  %2u   %8.2f  %3u  %6.2f   %8.2f  %3u  %6.2f\n",
+                      loss * 100.0f, k,
+                      arq.meanRounds, arq.p95Rounds, arq.framesPerData,
+                      fec.meanRounds, fec.p95Rounds, fec.framesPerData);
+        yield();
+    }
+
+    Serial.println();
+    Serial.println(F("  Plan per neighbor (8 data frames)"));
+    Neighbor* neighbors[MAX_NEIGHBORS];
+    uint8_t count = neighborTable.getActiveNeighbors(neighbors, MAX_NEIGHBORS);
+    if (count == 0) {
+        Serial.println(F("    No active neighbors"));
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        float loss;
+        bool measured = neighborTable.getLinkLoss(neighbors[i]->nodeId, loss);
+        Serial.printf("    Node %-3u loss %5.1f%% %-10s -> 8+%u\n",
+                      neighbors[i]->nodeId,
+                      (measured ? loss : FEC_DEFAULT_LOSS_RATE) * 100.0f,
+                      measured ? "" : "(default)",
+                      fecRepairFramesFor(neighbors[i]->nodeId, 8));
+    }
+    Serial.println();
+}
+
+#endif // ARDUINO
@@ -0,0 +1,322 @@
+#include "gateway_sync.h"
+#include "gradient_routing.h"
+#include "duplicate_cache.h"
+#include "transmit_queue.h"
+#if MESH_WITH_UPLINK
+#include "uplink.h"
+#endif
+#include "mesh_debug.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL STATE                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct DeferredUpload {
+    FullReportMsg report;
+    float         rssi;
+    uint32_t      heardAtMs;
+    bool          used;
+};
+
+static DeferredUpload deferredUploads[UPLINK_DEFER_SLOTS];
+
+// Reports we uploaded and still have to announce
+static UplinkClaimEntry pendingClaims[UPLINK_CLAIM_MAX_ENTRIES];
+static uint8_t pendingClaimCount = 0;
+
+// Reports other gateways announced (sourceId + messageId)
+static DuplicateCache claimedReports;
+
+// Claim frames already seen (sourceId = claiming gateway)
+static DuplicateCache claimFrameCache;
+
+static uint8_t claimSequence = 0;
+static uint8_t configuredGateways = 0;
+static GatewaySyncStats syncStats;
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         INITIALIZATION                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void initGatewaySync() {
+    memset(deferredUploads, 0, sizeof(deferredUploads));
+    memset(&syncStats, 0, sizeof(syncStats));
+    pendingClaimCount = 0;
+    claimedReports.clear();
+    claimFrameCache.clear();
+
+    configuredGateways = 0;
+    for (uint8_t i = 0; i < MAX_GATEWAYS; i++) {
+        if (GATEWAY_NODE_IDS[i] != 0) configuredGateways++;
+    }
+}
+
+uint8_t getConfiguredGatewayCount() {
+    return configuredGateways;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UPLOAD COORDINATION                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static void addClaim(uint8_t sourceId, uint8_t messageId) {
+    // Batch full - drop the oldest claim (worst case: one double upload)
+    if (pendingClaimCount >= UPLINK_CLAIM_MAX_ENTRIES) {
+        memmove(&pendingClaims[0], &pendingClaims[1],
+                sizeof(UplinkClaimEntry) * (UPLINK_CLAIM_MAX_ENTRIES - 1));
+        pendingClaimCount--;
+    }
+    pendingClaims[pendingClaimCount].sourceId = sourceId;
+    pendingClaims[pendingClaimCount].messageId = messageId;
+    pendingClaimCount++;
+}
+
+// Only a gateway gets here; relay and leaf builds link no uplink
+static bool uploadReport(uint8_t sourceId, const FullReportMsg& report, float rssi) {
+#if MESH_WITH_UPLINK
+    return uplinkReport(sourceId, report, rssi);
+#else
+    return false;
+#endif
+}
+
+static void uploadDeferred(DeferredUpload& entry) {
+    entry.used = false;
+    syncStats.uploadsAfterWait++;
+    uploadReport(entry.report.meshHeader.sourceId, entry.report, entry.rssi);
+}
+
+void gatewayUplinkReport(const FullReportMsg& report, float rssi) {
+    uint8_t sourceId = report.meshHeader.sourceId;
+    uint8_t messageId = report.meshHeader.messageId;
+    uint8_t destId = report.meshHeader.destId;
+
+    // Single gateway - nothing to coordinate
+    if (configuredGateways <= 1) {
+        syncStats.uploadsDirect++;
+        uploadReport(sourceId, report, rssi);
+        return;
+    }
+
+    // Another gateway already uploaded it
+    if (claimedReports.isDuplicate(sourceId, messageId)) {
+        syncStats.uploadsSuppressed++;
+        Serial.print(F("[GW-SYNC] Node "));
+        Serial.print(sourceId);
+        Serial.print(F(" msg #"));
+        Serial.print(messageId);
+        Serial.println(F(" already uploaded by another gateway"));
+        return;
+    }
+
+    // Ours if addressed to us, or flooded (no anycast target) and we are primary
+    bool addressedToUs = (destId == DEVICE_ID);
+    bool unowned = (destId == ADDR_BROADCAST || !isGatewayId(destId));
+    if (addressedToUs || (unowned && DEVICE_ID == GATEWAY_NODE_ID)) {
+        syncStats.uploadsDirect++;
+        if (uploadReport(sourceId, report, rssi)) {
+            addClaim(sourceId, messageId);
+        }
+        return;
+    }
+
+    // Someone else's - wait for their claim
+    int8_t freeSlot = -1;
+    int8_t oldestSlot = 0;
+    for (uint8_t i = 0; i < UPLINK_DEFER_SLOTS; i++) {
+        if (!deferredUploads[i].used) {
+            if (freeSlot < 0) freeSlot = i;
+        } else if (deferredUploads[i].heardAtMs < deferredUploads[oldestSlot].heardAtMs ||
+                   !deferredUploads[oldestSlot].used) {
+            oldestSlot = i;
+        }
+    }
+
+    // Table full - give up waiting on the oldest one
+    if (freeSlot < 0) {
+        uploadDeferred(deferredUploads[oldestSlot]);
+        freeSlot = oldestSlot;
+    }
+
+    DeferredUpload& entry = deferredUploads[freeSlot];
+    entry.report = report;
+    entry.rssi = rssi;
+    entry.heardAtMs = millis();
+    entry.used = true;
+    syncStats.uploadsDeferred++;
+
+    Serial.print(F("[GW-SYNC] Node "));
+    Serial.print(sourceId);
+    Serial.print(F(" msg #"));
+    Serial.print(messageId);
+    Serial.print(F(" addressed to gateway "));
+    Serial.print(destId);
+    Serial.println(F(" - upload deferred"));
+}
+
+void gatewaySyncUpdate() {
+    if (configuredGateways <= 1) return;
+
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < UPLINK_DEFER_SLOTS; i++) {
+        DeferredUpload& entry = deferredUploads[i];
+        if (entry.used && now - entry.heardAtMs >= UPLINK_CLAIM_WAIT_MS) {
+            Serial.print(F("[GW-SYNC] No claim for Node "));
+            Serial.print(entry.report.meshHeader.sourceId);
+            Serial.print(F(" msg #"));
+            Serial.print(entry.report.meshHeader.messageId);
+            Serial.println(F(" - uploading"));
+            uploadDeferred(entry);
+        }
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CLAIM FRAMES                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+uint8_t gatewaySyncOnSlot() {
+    if (!IS_GATEWAY || configuredGateways <= 1 || pendingClaimCount == 0) {
+        return 0;
+    }
+
+    uint8_t frame[sizeof(UplinkClaimMsg)];
+    uint8_t idx = 0;
+
+    // MeshHeader (8 bytes)
+    frame[idx++] = MESH_PROTOCOL_VERSION;
+    frame[idx++] = MSG_UPLINK_CLAIM;
+    frame[idx++] = DEVICE_ID;
+    frame[idx++] = ADDR_BROADCAST;
+    frame[idx++] = DEVICE_ID;
+    frame[idx++] = claimSequence;
+    frame[idx++] = MESH_DEFAULT_TTL;
+    frame[idx++] = 0;
+
+    // Claimed reports
+    frame[idx++] = pendingClaimCount;
+    for (uint8_t i = 0; i < pendingClaimCount; i++) {
+        frame[idx++] = pendingClaims[i].sourceId;
+        frame[idx++] = pendingClaims[i].messageId;
+    }
+
+    if (!transmitQueue.enqueue(frame, idx)) {
+        DEBUG_QUE_F("Uplink claim not queued (queue full), %d claims kept", pendingClaimCount);
+        return 0;
+    }
+
+    uint8_t claimed = pendingClaimCount;
+    claimSequence++;
+    pendingClaimCount = 0;
+    syncStats.claimFramesSent++;
+    syncStats.claimEntriesSent += claimed;
+
+    DEBUG_QUE_F("Uplink claim queued | %d reports | depth=%d/%d",
+                claimed, transmitQueue.depth(), TX_QUEUE_SIZE);
+    return claimed;
+}
+
+bool isUplinkClaimDuplicate(uint8_t sourceId, uint8_t messageId) {
+    if (claimFrameCache.isDuplicate(sourceId, messageId)) {
+        return true;
+    }
+    claimFrameCache.markSeen(sourceId, messageId);
+    return false;
+}
+
+bool applyUplinkClaim(const uint8_t* data, uint8_t length) {
+    if (length < UPLINK_CLAIM_HEADER_SIZE) return false;
+
+    uint8_t count = data[UPLINK_CLAIM_HEADER_SIZE - 1];
+    if (count > UPLINK_CLAIM_MAX_ENTRIES || length < UPLINK_CLAIM_HEADER_SIZE + 2 * count) {
+        return false;
+    }
+
+    const uint8_t* entries = data + UPLINK_CLAIM_HEADER_SIZE;
+    for (uint8_t c = 0; c < count; c++) {
+        uint8_t sourceId = entries[c * 2];
+        uint8_t messageId = entries[c * 2 + 1];
+
+        claimedReports.markSeen(sourceId, messageId);
+        syncStats.claimEntriesHeard++;
+
+        // Drop our deferred copy
+        for (uint8_t i = 0; i < UPLINK_DEFER_SLOTS; i++) {
+            DeferredUpload& entry = deferredUploads[i];
+            if (entry.used &&
+                entry.report.meshHeader.sourceId == sourceId &&
+                entry.report.meshHeader.messageId == messageId) {
+                entry.used = false;
+                syncStats.uploadsSuppressed++;
+            }
+        }
+    }
+
+    return true;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STATISTICS AND DEBUGGING                          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+GatewaySyncStats getGatewaySyncStats() {
+    return syncStats;
+}
+
+void printGatewaySyncStatus() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  GATEWAYS                                                     ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    Serial.print(F("  Configured:"));
+    for (uint8_t i = 0; i < MAX_GATEWAYS; i++) {
+        if (GATEWAY_NODE_IDS[i] == 0) continue;
+        Serial.print(F(" "));
+        Serial.print(GATEWAY_NODE_IDS[i]);
+        if (GATEWAY_NODE_IDS[i] == GATEWAY_NODE_ID) Serial.print(F("(primary)"));
+        if (GATEWAY_NODE_IDS[i] == DEVICE_ID) Serial.print(F("(this node)"));
+    }
+    Serial.println();
+
+    if (!IS_GATEWAY) {
+        RoutingState selected = getRoutingState();
+        Serial.print(F("  Anycast target: "));
+        if (selected.routeValid) {
+            Serial.print(F("Node "));
+            Serial.print(selected.gatewayId);
+            Serial.print(F(" ("));
+            Serial.print(selected.distanceToGateway);
+            Serial.print(F(" hops via Node "));
+            Serial.print(selected.nextHop);
+            Serial.println(F(")"));
+        } else {
+            Serial.println(F("none (flooding)"));
+        }
+
+        for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+            RoutingState route;
+            if (!getGatewayRoute(i, route)) continue;
+            Serial.printf("    Gateway %u: %s, %u hops via %u, RSSI %d dBm\n",
+                          route.gatewayId,
+                          route.routeValid ? "valid" : "expired",
+                          route.distanceToGateway,
+                          route.nextHop,
+                          route.bestRssi);
+        }
+    } else {
+        uint8_t waiting = 0;
+        for (uint8_t i = 0; i < UPLINK_DEFER_SLOTS; i++) {
+            if (deferredUploads[i].used) waiting++;
+        }
+
+        Serial.printf("  Uploads direct:     %lu\n", syncStats.uploadsDirect);
+        Serial.printf("  Uploads deferred:   %lu (waiting %u)\n", syncStats.uploadsDeferred, waiting);
+        Serial.printf("  Uploaded after wait:%lu\n", syncStats.uploadsAfterWait);
+        Serial.printf("  Suppressed (dup):   %lu\n", syncStats.uploadsSuppressed);
+        Serial.printf("  Claims sent:        %lu frames, %lu reports (pending %u)\n",
+                      syncStats.claimFramesSent, syncStats.claimEntriesSent, pendingClaimCount);
+        Serial.printf("  Claims heard:       %lu reports\n", syncStats.claimEntriesHeard);
+    }
+    Serial.println();
+}
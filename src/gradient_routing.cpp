@@ -1,18 +1,113 @@
 #include "gradient_routing.h"
 #include "config.h"
 #include "mesh_protocol.h"
+#include "metrics.h"
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GLOBAL STATE                                      ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-static RoutingState routingState;
-static RoutingStats routingStats;
+static RoutingState routingState;                  // Selected (lowest cost) route
+static RoutingState gatewayRoutes[ROUTE_TABLE_SIZE];  // One gradient per gateway
+
+// Pending beacon rebroadcasts (one per gateway, with random delay or in our micro-slot)
+struct PendingBeacon {
+    BeaconMsg     beacon;
+    unsigned long scheduledTime;
+    bool          inMicroSlot;      // Sub-frame relay: drop it if we are too late
+    bool          pending;
+};
+static PendingBeacon pendingBeacons[ROUTE_TABLE_SIZE];
+
+// Newest beacon seen from each gateway (freshness check)
+struct BeaconFreshness {
+    uint8_t       gatewayId;        // ADDR_GATEWAY = unused
+    uint16_t      epoch;
+    uint16_t      sequence;
+    uint8_t       bestDistance;     // Shallowest sender heard for this sequence
+    unsigned long acceptedAt;       // millis() of the last fresh beacon
+};
+static BeaconFreshness beaconFreshness[ROUTE_TABLE_SIZE];
 
-// Pending beacon for rebroadcast (with random delay)
-static BeaconMsg pendingBeacon;
-static bool beaconPending = false;
-static unsigned long beaconScheduledTime = 0;
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ROUTE TABLE HELPERS                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static void clearRoute(RoutingState& route) {
+    route.distanceToGateway = DISTANCE_UNKNOWN;
+    route.nextHop = 0;
+    route.gatewayId = ADDR_GATEWAY;
+    route.bestRssi = -127;  // Worst possible RSSI
+    route.lastBeaconSeq = 0;
+    route.lastBeaconTime = 0;
+    route.routeValid = false;
+}
+
+/**
+ * Find the table slot for a gateway, optionally claiming a free (or stale) one
+ */
+static int8_t findRouteSlot(uint8_t gatewayId, bool create) {
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        if (gatewayRoutes[i].gatewayId == gatewayId && gatewayId != ADDR_GATEWAY) {
+            return i;
+        }
+    }
+    if (!create) return -1;
+
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        if (gatewayRoutes[i].gatewayId == ADDR_GATEWAY || !gatewayRoutes[i].routeValid) {
+            clearRoute(gatewayRoutes[i]);
+            gatewayRoutes[i].gatewayId = gatewayId;
+            pendingBeacons[i].pending = false;
+            return i;
+        }
+    }
+    return -1;  // Table full of live gateways
+}
+
+/**
+ * Pick the lowest cost gateway: fewest hops, then strongest RSSI
+ */
+static void selectBestRoute() {
+    int8_t best = -1;
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        const RoutingState& route = gatewayRoutes[i];
+        if (!route.routeValid) continue;
+        if (best < 0 ||
+            route.distanceToGateway < gatewayRoutes[best].distanceToGateway ||
+            (route.distanceToGateway == gatewayRoutes[best].distanceToGateway &&
+             route.bestRssi > gatewayRoutes[best].bestRssi)) {
+            best = i;
+        }
+    }
+
+    uint8_t previousGateway = routingState.routeValid ? routingState.gatewayId : ADDR_GATEWAY;
+
+    if (best < 0) {
+        clearRoute(routingState);
+        return;
+    }
+
+    routingState = gatewayRoutes[best];
+
+    if (previousGateway != ADDR_GATEWAY && previousGateway != routingState.gatewayId) {
+        metricInc(MET_GATEWAY_SWITCHES);
+
+        Serial.println(F(""));
+        Serial.println(F("╔═══════════════════════════════════════════════════════════╗"));
+        Serial.println(F("║               GATEWAY SWITCH                              ║"));
+        Serial.println(F("╚═══════════════════════════════════════════════════════════╝"));
+        Serial.print(F("  Gateway: Node "));
+        Serial.print(previousGateway);
+        Serial.print(F(" -> Node "));
+        Serial.println(routingState.gatewayId);
+        Serial.print(F("  Distance: "));
+        Serial.print(routingState.distanceToGateway);
+        Serial.print(F(" hops via Node "));
+        Serial.println(routingState.nextHop);
+        Serial.println(F("─────────────────────────────────────────────────────────────"));
+    }
+}
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         INITIALIZATION                                    ║
@@ -20,26 +115,22 @@ static unsigned long beaconScheduledTime = 0;
 
 void initGradientRouting() {
     // Initialize routing state
-    routingState.distanceToGateway = DISTANCE_UNKNOWN;
-    routingState.nextHop = 0;
-    routingState.gatewayId = ADDR_GATEWAY;
-    routingState.bestRssi = -127;  // Worst possible RSSI
-    routingState.lastBeaconSeq = 0;
-    routingState.lastBeaconTime = 0;
-    routingState.routeValid = false;
+    clearRoute(routingState);
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        clearRoute(gatewayRoutes[i]);
+    }
 
     // Gateway always has distance 0 to itself
     if (IS_GATEWAY) {
         routingState.distanceToGateway = 0;
         routingState.nextHop = DEVICE_ID;
+        routingState.gatewayId = DEVICE_ID;
         routingState.routeValid = true;
     }
 
-    // Clear statistics
-    memset(&routingStats, 0, sizeof(routingStats));
-
-    // Clear pending beacon
-    beaconPending = false;
+    // Clear pending beacons and beacon freshness
+    memset(pendingBeacons, 0, sizeof(pendingBeacons));
+    memset(beaconFreshness, 0, sizeof(beaconFreshness));
 
     Serial.println(F(""));
     Serial.println(F("╔═══════════════════════════════════════════════════════════╗"));
@@ -54,6 +145,8 @@ void initGradientRouting() {
         Serial.print(F("  Route timeout: "));
         Serial.print(ROUTE_TIMEOUT_MS / 1000);
         Serial.println(F(" seconds"));
+        Serial.print(F("  Gateways tracked: up to "));
+        Serial.println(ROUTE_TABLE_SIZE);
     }
     Serial.println(F("─────────────────────────────────────────────────────────────"));
 }
@@ -66,11 +159,18 @@ void updateRoutingState(uint8_t senderDistance, uint8_t senderId, uint8_t gatewa
                         uint16_t beaconSeq, int16_t rssi) {
     // Gateway doesn't update its route (always distance 0)
     if (isGateway()) {
-        routingStats.beaconsReceived++;
+        metricInc(MET_BEACONS_RECEIVED);
         return;
     }
 
-    routingStats.beaconsReceived++;
+    metricInc(MET_BEACONS_RECEIVED);
+
+    int8_t slot = findRouteSlot(gatewayId, true);
+    if (slot < 0) {
+        // Already tracking ROUTE_TABLE_SIZE live gateways
+        return;
+    }
+    RoutingState& route = gatewayRoutes[slot];
 
     // Calculate our distance through this sender
     uint8_t newDistance = senderDistance + 1;
@@ -85,40 +185,40 @@ void updateRoutingState(uint8_t senderDistance, uint8_t senderId, uint8_t gatewa
     const char* updateReason = "";
 
     // Case 1: No valid route - accept any route
-    if (!routingState.routeValid) {
+    if (!route.routeValid) {
         shouldUpdate = true;
         updateReason = "First route";
     }
     // Case 2: Shorter path - always prefer
-    else if (newDistance < routingState.distanceToGateway) {
+    else if (newDistance < route.distanceToGateway) {
         shouldUpdate = true;
         updateReason = "Shorter path";
     }
     // Case 3: Same distance but better RSSI - prefer stronger signal
-    else if (newDistance == routingState.distanceToGateway && rssi > routingState.bestRssi) {
+    else if (newDistance == route.distanceToGateway && rssi > route.bestRssi) {
         shouldUpdate = true;
         updateReason = "Better RSSI";
     }
     // Case 4: Same sender with newer beacon - refresh route
-    else if (senderId == routingState.nextHop) {
+    else if (senderId == route.nextHop) {
         shouldUpdate = true;
         updateReason = "Route refresh";
     }
 
     if (shouldUpdate) {
-        uint8_t oldDistance = routingState.distanceToGateway;
-        uint8_t oldNextHop = routingState.nextHop;
-        int16_t oldRssi = routingState.bestRssi;
-
-        routingState.distanceToGateway = newDistance;
-        routingState.nextHop = senderId;
-        routingState.gatewayId = gatewayId;
-        routingState.bestRssi = rssi;
-        routingState.lastBeaconSeq = beaconSeq;
-        routingState.lastBeaconTime = millis();
-        routingState.routeValid = true;
+        uint8_t oldDistance = route.distanceToGateway;
+        uint8_t oldNextHop = route.nextHop;
+        int16_t oldRssi = route.bestRssi;
 
-        routingStats.routeUpdates++;
+        route.distanceToGateway = newDistance;
+        route.nextHop = senderId;
+        route.gatewayId = gatewayId;
+        route.bestRssi = rssi;
+        route.lastBeaconSeq = beaconSeq;
+        route.lastBeaconTime = millis();
+        route.routeValid = true;
+
+        metricInc(MET_ROUTE_UPDATES);
 
         // Log route update
         Serial.println(F(""));
@@ -126,7 +226,9 @@ void updateRoutingState(uint8_t senderDistance, uint8_t senderId, uint8_t gatewa
         Serial.println(F("║               ROUTE UPDATED                               ║"));
         Serial.println(F("╚═══════════════════════════════════════════════════════════╝"));
         Serial.print(F("  Reason: "));
-        Serial.println(updateReason);
+        Serial.print(updateReason);
+        Serial.print(F("  |  Gateway: Node "));
+        Serial.println(gatewayId);
         Serial.print(F("  Distance: "));
         if (oldDistance == DISTANCE_UNKNOWN) {
             Serial.print(F("UNKNOWN"));
@@ -148,6 +250,8 @@ void updateRoutingState(uint8_t senderDistance, uint8_t senderId, uint8_t gatewa
         Serial.print(F("  Beacon seq: "));
         Serial.println(beaconSeq);
         Serial.println(F("─────────────────────────────────────────────────────────────"));
+
+        selectBestRoute();
     }
 }
 
@@ -155,29 +259,47 @@ void checkRouteExpiration() {
     // Gateway route never expires
     if (isGateway()) return;
 
-    if (routingState.routeValid) {
-        unsigned long elapsed = millis() - routingState.lastBeaconTime;
+    bool anyExpired = false;
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        RoutingState& route = gatewayRoutes[i];
+        if (!route.routeValid) continue;
+
+        unsigned long elapsed = millis() - route.lastBeaconTime;
         if (elapsed > ROUTE_TIMEOUT_MS) {
-            invalidateRoute();
-            routingStats.routeExpirations++;
+            route.routeValid = false;
+            route.distanceToGateway = DISTANCE_UNKNOWN;
+            route.bestRssi = -127;
+            metricInc(MET_ROUTE_EXPIRATIONS);
+            anyExpired = true;
 
             Serial.println(F(""));
             Serial.println(F("⚠️ ═══════════════════════════════════════════════════════"));
-            Serial.println(F("   ROUTE EXPIRED - Falling back to flooding"));
+            Serial.print(F("   ROUTE EXPIRED - Gateway Node "));
+            Serial.println(route.gatewayId);
             Serial.print(F("   No beacon received for "));
             Serial.print(elapsed / 1000);
             Serial.println(F(" seconds"));
             Serial.println(F("═══════════════════════════════════════════════════════════"));
         }
     }
+
+    if (anyExpired) {
+        selectBestRoute();
+        if (!routingState.routeValid) {
+            Serial.println(F("   No gateway reachable - Falling back to flooding"));
+        }
+    }
 }
 
 void invalidateRoute() {
     if (isGateway()) return;  // Gateway route never invalidates
 
-    routingState.routeValid = false;
-    routingState.distanceToGateway = DISTANCE_UNKNOWN;
-    routingState.bestRssi = -127;
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        gatewayRoutes[i].routeValid = false;
+        gatewayRoutes[i].distanceToGateway = DISTANCE_UNKNOWN;
+        gatewayRoutes[i].bestRssi = -127;
+    }
+    clearRoute(routingState);
 }
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -197,10 +319,25 @@ uint8_t getNextHop() {
     return routingState.nextHop;
 }
 
+uint8_t getNextHopFor(uint8_t gatewayId) {
+    int8_t slot = findRouteSlot(gatewayId, false);
+    if (slot >= 0 && gatewayRoutes[slot].routeValid) {
+        return gatewayRoutes[slot].nextHop;
+    }
+    return routingState.nextHop;
+}
+
 uint8_t getDistanceToGateway() {
     return routingState.distanceToGateway;
 }
 
+uint8_t getAnycastGateway() {
+    if (!hasValidRoute()) {
+        return ADDR_BROADCAST;
+    }
+    return routingState.gatewayId;
+}
+
 bool isGateway() {
     return IS_GATEWAY;
 }
@@ -209,14 +346,117 @@ RoutingState getRoutingState() {
     return routingState;
 }
 
+bool getGatewayRoute(uint8_t index, RoutingState& state) {
+    if (index >= ROUTE_TABLE_SIZE) return false;
+    if (gatewayRoutes[index].gatewayId == ADDR_GATEWAY) return false;
+    state = gatewayRoutes[index];
+    return true;
+}
+
+bool restoreGatewayRoute(const RoutingState& route, unsigned long ageMs) {
+    if (isGateway() || ageMs >= ROUTE_TIMEOUT_MS) return false;
+    if (route.gatewayId == ADDR_GATEWAY || route.distanceToGateway == DISTANCE_UNKNOWN) return false;
+
+    // A beacon heard since boot is always fresher than the snapshot
+    int8_t existing = findRouteSlot(route.gatewayId, false);
+    if (existing >= 0 && gatewayRoutes[existing].routeValid) return false;
+
+    int8_t slot = findRouteSlot(route.gatewayId, true);
+    if (slot < 0) return false;
+
+    gatewayRoutes[slot] = route;
+    gatewayRoutes[slot].lastBeaconTime = millis() - ageMs;
+    gatewayRoutes[slot].routeValid = true;
+
+    selectBestRoute();
+    return true;
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         BEACON HANDLING                                   ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-void scheduleBeaconRebroadcast(const BeaconMsg& receivedBeacon, int16_t rssi) {
+BeaconCheck checkBeaconFreshness(const BeaconMsg& beacon) {
+    // Our own beacons echoed back by relays
+    if (isGateway() && beacon.gatewayId == DEVICE_ID) {
+        metricInc(MET_BEACONS_DUPLICATE);
+        return BEACON_DUPLICATE;
+    }
+
+    unsigned long now = millis();
+    BeaconFreshness* entry = nullptr;
+    BeaconFreshness* victim = nullptr;      // Free slot, else least recently heard
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        BeaconFreshness& f = beaconFreshness[i];
+        if (f.gatewayId == beacon.gatewayId) {
+            entry = &f;
+            break;
+        }
+        if (victim == nullptr || f.gatewayId == ADDR_GATEWAY ||
+            (victim->gatewayId != ADDR_GATEWAY && now - f.acceptedAt > now - victim->acceptedAt)) {
+            victim = &f;
+        }
+    }
+
+    if (entry == nullptr) {
+        // First beacon from this gateway
+        entry = victim;
+    } else if (now - entry->acceptedAt <= ROUTE_TIMEOUT_MS) {
+        // Serial number comparison: both counters may wrap
+        int16_t epochDelta = (int16_t)(beacon.epoch - entry->epoch);
+        int16_t seqDelta = (int16_t)(beacon.sequenceNumber - entry->sequence);
+
+        if (epochDelta < 0 || (epochDelta == 0 && seqDelta < 0)) {
+            metricInc(MET_BEACONS_STALE);
+            return BEACON_STALE;
+        }
+        if (epochDelta == 0 && seqDelta == 0) {
+            if (beacon.distanceToGateway <= entry->bestDistance) {
+                entry->bestDistance = beacon.distanceToGateway;
+                return BEACON_ROUTE_COPY;
+            }
+            metricInc(MET_BEACONS_DUPLICATE);
+            return BEACON_DUPLICATE;
+        }
+        if (epochDelta > 0) {
+            metricInc(MET_GATEWAY_REBOOTS);
+            Serial.printf("  Gateway %u rebooted (epoch %u -> %u), older beacons now stale\n",
+                          beacon.gatewayId, entry->epoch, beacon.epoch);
+        }
+    }
+    // else: nothing accepted for ROUTE_TIMEOUT_MS - resynchronize to this beacon
+
+    entry->gatewayId = beacon.gatewayId;
+    entry->epoch = beacon.epoch;
+    entry->sequence = beacon.sequenceNumber;
+    entry->bestDistance = beacon.distanceToGateway;
+    entry->acceptedAt = now;
+    return BEACON_FRESH;
+}
+
+bool isSubframeBeacon(const BeaconMsg& beacon) {
+    return USE_BEACON_SUBFRAME && beacon.gpsValid && beacon.gpsSecond == 0;
+}
+
+uint16_t getBeaconSlotOffsetMs(uint8_t distanceToGateway, uint8_t nodeId) {
+    if (distanceToGateway == 0 || distanceToGateway == DISTANCE_UNKNOWN) {
+        return 0;
+    }
+    uint8_t idIndex = (nodeId > 0) ? nodeId - 1 : 0;
+    return (uint16_t)(distanceToGateway * BEACON_DEPTH_SLOT_MS + idIndex * BEACON_ID_SPACING_MS);
+}
+
+void noteBeaconOutOfPhase() {
+    metricInc(MET_BEACONS_OUT_OF_PHASE);
+}
+
+void scheduleBeaconRebroadcast(const BeaconMsg& receivedBeacon, unsigned long receivedAtMs) {
     // Gateway doesn't rebroadcast beacons (it originates them)
     if (isGateway()) return;
 
+    // Leaf nodes have no children to reach
+    if (!ROLE_FORWARDS) return;
+
     // Don't rebroadcast if TTL exhausted
     if (receivedBeacon.meshHeader.ttl <= 1) {
         Serial.println(F("  Beacon TTL exhausted, not rebroadcasting"));
@@ -228,17 +468,41 @@ void scheduleBeaconRebroadcast(const BeaconMsg& receivedBeacon, int16_t rssi) {
         return;
     }
 
-    // Schedule beacon with random delay to prevent collisions
-    unsigned long delayMs = random(BEACON_REBROADCAST_MIN_MS, BEACON_REBROADCAST_MAX_MS);
-    beaconScheduledTime = millis() + delayMs;
+    int8_t slot = findRouteSlot(receivedBeacon.gatewayId, false);
+    if (slot < 0 || !gatewayRoutes[slot].routeValid) {
+        return;
+    }
+    PendingBeacon& pending = pendingBeacons[slot];
+
+    unsigned long delayMs;
+    if (isSubframeBeacon(receivedBeacon)) {
+        // Relay in our micro-slot, timed from the sender's (it ended one airtime after)
+        uint16_t heardAtMs = getBeaconSlotOffsetMs(receivedBeacon.distanceToGateway,
+                                                   receivedBeacon.meshHeader.senderId) + BEACON_AIRTIME_MS;
+        uint16_t ourSlotMs = getBeaconSlotOffsetMs(gatewayRoutes[slot].distanceToGateway, DEVICE_ID);
+        if (ourSlotMs <= heardAtMs) {
+            // Heard from our own depth or deeper first: our slot is gone this minute
+            metricInc(MET_BEACON_SLOT_MISSES);
+            Serial.println(F("  Beacon micro-slot already passed, not rebroadcasting"));
+            return;
+        }
+        delayMs = ourSlotMs - heardAtMs;
+        pending.scheduledTime = receivedAtMs + delayMs;
+        pending.inMicroSlot = true;
+    } else {
+        // Schedule beacon with random delay to prevent collisions
+        delayMs = random(BEACON_REBROADCAST_MIN_MS, BEACON_REBROADCAST_MAX_MS);
+        pending.scheduledTime = millis() + delayMs;
+        pending.inMicroSlot = false;
+    }
 
     // Prepare beacon for rebroadcast
-    pendingBeacon = receivedBeacon;
-    pendingBeacon.distanceToGateway = routingState.distanceToGateway;  // Our distance
-    pendingBeacon.meshHeader.senderId = DEVICE_ID;  // We're now the sender
-    pendingBeacon.meshHeader.ttl--;  // Decrement TTL
+    pending.beacon = receivedBeacon;
+    pending.beacon.distanceToGateway = gatewayRoutes[slot].distanceToGateway;  // Our distance to this gateway
+    pending.beacon.meshHeader.senderId = DEVICE_ID;  // We're now the sender
+    pending.beacon.meshHeader.ttl--;  // Decrement TTL
 
-    beaconPending = true;
+    pending.pending = true;
 
     Serial.print(F("  Beacon scheduled for rebroadcast in "));
     Serial.print(delayMs);
@@ -246,18 +510,36 @@ void scheduleBeaconRebroadcast(const BeaconMsg& receivedBeacon, int16_t rssi) {
 }
 
 bool hasPendingBeacon() {
-    if (!beaconPending) return false;
-    return (millis() >= beaconScheduledTime);
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        if (pendingBeacons[i].pending && now >= pendingBeacons[i].scheduledTime) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool getPendingBeacon(BeaconMsg& beacon) {
-    if (!hasPendingBeacon()) return false;
-
-    beacon = pendingBeacon;
-    beaconPending = false;
-    routingStats.beaconsSent++;
-
-    return true;
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        if (pendingBeacons[i].pending && now >= pendingBeacons[i].scheduledTime) {
+            pendingBeacons[i].pending = false;
+
+            // A late relay would land in the next depth's micro-slot
+            if (pendingBeacons[i].inMicroSlot &&
+                now - pendingBeacons[i].scheduledTime > BEACON_PHASE_TOLERANCE_MS) {
+                metricInc(MET_BEACON_SLOT_MISSES);
+                Serial.printf("  Beacon relay %lu ms late for its micro-slot, dropped\n",
+                              now - pendingBeacons[i].scheduledTime);
+                continue;
+            }
+
+            beacon = pendingBeacons[i].beacon;
+            metricInc(MET_BEACONS_SENT);
+            return true;
+        }
+    }
+    return false;
 }
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -279,6 +561,9 @@ void printRoutingTable() {
     Serial.print(F("  Route Valid: "));
     Serial.println(routingState.routeValid ? F("YES") : F("NO"));
 
+    Serial.print(F("  Selected Gateway: Node "));
+    Serial.println(routingState.gatewayId);
+
     Serial.print(F("  Distance to Gateway: "));
     if (routingState.distanceToGateway == DISTANCE_UNKNOWN) {
         Serial.println(F("UNKNOWN"));
@@ -307,12 +592,29 @@ void printRoutingTable() {
             Serial.print(remaining);
             Serial.println(F(" sec)"));
         }
+
+        Serial.println(F("  Gateway │ Valid │ Hops │ Next │ RSSI │ Age"));
+        for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+            const RoutingState& route = gatewayRoutes[i];
+            if (route.gatewayId == ADDR_GATEWAY) continue;
+            unsigned long routeAge = (millis() - route.lastBeaconTime) / 1000;
+            Serial.printf("  %7u │ %-5s │ %4u │ %4u │ %4d │ %lus%s\n",
+                          route.gatewayId,
+                          route.routeValid ? "yes" : "no",
+                          route.distanceToGateway,
+                          route.nextHop,
+                          route.bestRssi,
+                          routeAge,
+                          (route.routeValid && route.gatewayId == routingState.gatewayId) ? "  ◀ selected" : "");
+        }
     }
 
     Serial.println(F("─────────────────────────────────────────────────────────────"));
 }
 
 void printRoutingStats() {
+    RoutingStats routingStats = getRoutingStats();
+
     Serial.println(F(""));
     Serial.println(F("╔═══════════════════════════════════════════════════════════╗"));
     Serial.println(F("║             GRADIENT ROUTING STATISTICS                   ║"));
@@ -336,6 +638,26 @@ void printRoutingStats() {
     Serial.print(F("  Route Expirations: "));
     Serial.println(routingStats.routeExpirations);
 
+    Serial.print(F("  Gateway Switches: "));
+    Serial.println(routingStats.gatewaySwitches);
+
+    if (USE_BEACON_SUBFRAME) {
+        Serial.print(F("  Beacon Slot Misses: "));
+        Serial.println(routingStats.beaconSlotMisses);
+
+        Serial.print(F("  Beacons Out of Phase: "));
+        Serial.println(routingStats.beaconsOutOfPhase);
+    }
+
+    Serial.print(F("  Beacons Dropped: "));
+    Serial.print(routingStats.beaconsDuplicate);
+    Serial.print(F(" duplicate, "));
+    Serial.print(routingStats.beaconsStale);
+    Serial.println(F(" stale"));
+
+    Serial.print(F("  Gateway Reboots Seen: "));
+    Serial.println(routingStats.gatewayReboots);
+
     // Calculate efficiency
     unsigned long totalForwards = routingStats.unicastForwards + routingStats.floodingFallbacks;
     if (totalForwards > 0) {
@@ -349,13 +671,26 @@ void printRoutingStats() {
 }
 
 RoutingStats getRoutingStats() {
-    return routingStats;
+    RoutingStats stats;
+    stats.beaconsReceived   = metricGet(MET_BEACONS_RECEIVED);
+    stats.beaconsSent       = metricGet(MET_BEACONS_SENT);
+    stats.routeUpdates      = metricGet(MET_ROUTE_UPDATES);
+    stats.unicastForwards   = metricGet(MET_UNICAST_FORWARDS);
+    stats.floodingFallbacks = metricGet(MET_FLOODING_FALLBACKS);
+    stats.routeExpirations  = metricGet(MET_ROUTE_EXPIRATIONS);
+    stats.gatewaySwitches   = metricGet(MET_GATEWAY_SWITCHES);
+    stats.beaconSlotMisses  = metricGet(MET_BEACON_SLOT_MISSES);
+    stats.beaconsOutOfPhase = metricGet(MET_BEACONS_OUT_OF_PHASE);
+    stats.beaconsDuplicate  = metricGet(MET_BEACONS_DUPLICATE);
+    stats.beaconsStale      = metricGet(MET_BEACONS_STALE);
+    stats.gatewayReboots    = metricGet(MET_GATEWAY_REBOOTS);
+    return stats;
 }
 
 void incrementUnicastForwards() {
-    routingStats.unicastForwards++;
+    metricInc(MET_UNICAST_FORWARDS);
 }
 
 void incrementFloodingFallbacks() {
-    routingStats.floodingFallbacks++;
+    metricInc(MET_FLOODING_FALLBACKS);
 }
@@ -0,0 +1,235 @@
+#include "json_cache.h"
+#include "mesh_protocol.h"
+#include "mesh_schema.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL STATE                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static NodeJsonFragment fragments[NODE_TABLE_SIZE];
+static uint32_t cacheVersion = 0;
+static JsonCacheStats cacheStats;
+
+static const uint8_t BENCH_NODE_COUNTS[] = {5, 100};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FRAGMENTS                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+uint16_t formatNodeFragment(char* buffer, size_t bufferSize, const NodeSnapshot& node) {
+    const FullReportMsg& report = node.lastReport;
+
+    // Node-table fields here, report fields from the schema (mesh_schema.h)
+    int len = snprintf(buffer, bufferSize,
+        "\"lastHeard\":%lu,\"messageCount\":%lu,\"rssi\":%.0f,\"snr\":%.1f,\"packetsLost\":%lu,"
+        "\"hopDistance\":%u",
+        node.lastHeardTime, node.messageCount, node.lastRssi, node.lastSnr, node.packetsLost,
+        meshHopCount(report.meshHeader));
+
+    if (len < 0 || (size_t)len + SCHEMA_REPORT_JSON_MAX + 1 > bufferSize) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    len += schemaReportJson(buffer + len, report);
+    buffer[len++] = '}';
+    buffer[len] = '\0';
+    return (uint16_t)len;
+}
+
+/**
+ * Append one "id":{"online":...,<fragment> member
+ */
+static void appendNodeMember(String& json, bool first, uint8_t nodeId, bool online, const char* fragment) {
+    if (!first) json += ',';
+    json += '"';
+    json += nodeId;
+    json += online ? "\":{\"online\":true," : "\":{\"online\":false,";
+    json += fragment;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CACHE                                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void initJsonCache() {
+    for (uint16_t i = 0; i < NODE_TABLE_SIZE; i++) {
+        free(fragments[i].text);
+    }
+    memset(fragments, 0, sizeof(fragments));
+    cacheVersion = 0;
+    memset(&cacheStats, 0, sizeof(cacheStats));
+}
+
+uint32_t getJsonCacheVersion() {
+    return cacheVersion;
+}
+
+/**
+ * Re-format a slot's fragment, growing its text if needed
+ * @return false if out of heap (fragment left unbuilt)
+ */
+static bool buildFragment(NodeJsonFragment& fragment, const NodeSnapshot& node) {
+    char scratch[JSON_NODE_FRAGMENT_SIZE];
+    uint16_t length = formatNodeFragment(scratch, sizeof(scratch), node);
+
+    if (length + 1 > fragment.capacity) {
+        char* text = (char*)realloc(fragment.text, length + 1);
+        if (text == nullptr) {
+            fragment.nodeId = 0;
+            return false;
+        }
+        fragment.text = text;
+        fragment.capacity = length + 1;
+    }
+
+    memcpy(fragment.text, scratch, length + 1);
+    fragment.length = length;
+    fragment.nodeId = node.nodeId;
+    fragment.publishCount = node.publishCount;
+    return true;
+}
+
+uint16_t appendNodesJson(String& json, uint32_t since) {
+    unsigned long now = millis();
+    uint16_t appended = 0;
+
+    uint16_t cursor = 0;
+    NodeSnapshot node;
+    while (nextLiveNode(cursor, node)) {
+        NodeJsonFragment& fragment = fragments[node.slot];
+
+        // Gateway is always online (it's running this code!), others if
+        // heard within the last 60 seconds
+        bool online = (node.nodeId == DEVICE_ID) || (node.hasData && (now - node.lastHeardTime < 60000));
+        bool changed = fragment.nodeId != node.nodeId || node.publishCount != fragment.publishCount;
+        if (changed) {
+            if (!buildFragment(fragment, node)) continue;
+            cacheStats.fragmentsBuilt++;
+        }
+        if (changed || online != fragment.online) {
+            // Going offline (or coming back) without a report is a change for ?since= too
+            fragment.online = online;
+            fragment.version = ++cacheVersion;
+        }
+
+        if (since != 0 && fragment.version <= since) continue;
+        if (!changed) cacheStats.fragmentsReused++;
+
+        appendNodeMember(json, appended == 0, node.nodeId, online, fragment.text);
+        appended++;
+    }
+
+    cacheStats.responses++;
+    return appended;
+}
+
+void jsonCacheNoteResponse(unsigned long elapsedUs) {
+    cacheStats.lastResponseUs = elapsedUs;
+}
+
+JsonCacheStats getJsonCacheStats() {
+    return cacheStats;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BENCHMARK                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Representative node (full-width numbers, like a real outdoor node)
+ */
+static void fillBenchNode(NodeSnapshot& node) {
+    memset(&node, 0, sizeof(node));
+    node.hasData = true;
+    node.lastHeardTime = millis();
+    node.messageCount = 12345;
+    node.packetsLost = 17;
+    node.lastRssi = -97.0f;
+    node.lastSnr = 7.25f;
+
+    FullReportMsg& report = node.lastReport;
+    report.meshHeader.sourceId = 3;
+    report.meshHeader.senderId = 2;
+    report.meshHeader.ttl = 2;
+    report.meshHeader.messageId = 201;
+    report.temperatureF_x10 = 725;
+    report.humidity_x10 = 456;
+    report.pressure_hPa = 1013;
+    report.altitude_m = 42;
+    report.latitude_x1e6 = 33783823;
+    report.longitude_x1e6 = -118114159;
+    report.satellites = 9;
+    report.gps_altitude_m = 45;
+    report.neighborCount = 4;
+}
+
+void runJsonBenchmark() {
+    NodeSnapshot node;
+    fillBenchNode(node);
+    char scratch[JSON_NODE_FRAGMENT_SIZE];
+
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  JSON RESPONSE BENCHMARK                                      ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  %u responses per point, time per /data response body\n", JSON_BENCH_REPEATS);
+    Serial.println(F("  Nodes   Bytes   Re-serialise      Cached   Speedup"));
+
+    for (uint8_t c = 0; c < sizeof(BENCH_NODE_COUNTS); c++) {
+        uint8_t count = BENCH_NODE_COUNTS[c];
+        char* cached = (char*)malloc((size_t)count * JSON_NODE_FRAGMENT_SIZE);
+        if (cached == nullptr) {
+            Serial.printf("  %5u   not enough heap for %u fragments\n", count, count);
+            continue;
+        }
+        size_t reserve = 64 + (size_t)count * JSON_NODE_FRAGMENT_SIZE;
+        size_t bytes = 0;
+
+        // Every node serialised for every response (previous behaviour)
+        unsigned long start = micros();
+        for (uint8_t r = 0; r < JSON_BENCH_REPEATS; r++) {
+            String json;
+            json.reserve(reserve);
+            json = "{\"nodes\":{";
+            for (uint8_t n = 1; n <= count; n++) {
+                formatNodeFragment(scratch, sizeof(scratch), node);
+                appendNodeMember(json, n == 1, n, true, scratch);
+            }
+            json += "}}";
+            bytes = json.length();
+        }
+        unsigned long fullUs = (micros() - start) / JSON_BENCH_REPEATS;
+
+        // Fragments serialised once, responses only concatenate
+        for (uint8_t n = 1; n <= count; n++) {
+            formatNodeFragment(cached + (size_t)(n - 1) * JSON_NODE_FRAGMENT_SIZE,
+                               JSON_NODE_FRAGMENT_SIZE, node);
+        }
+        start = micros();
+        for (uint8_t r = 0; r < JSON_BENCH_REPEATS; r++) {
+            String json;
+            json.reserve(reserve);
+            json = "{\"nodes\":{";
+            for (uint8_t n = 1; n <= count; n++) {
+                appendNodeMember(json, n == 1, n, true,
+                                 cached + (size_t)(n - 1) * JSON_NODE_FRAGMENT_SIZE);
+            }
+            json += "}}";
+        }
+        unsigned long cachedUs = (micros() - start) / JSON_BENCH_REPEATS;
+
+        free(cached);
+
+        Serial.printf("  %5u  %6u  %10lu us  %7lu us  %7.1fx\n",
+                      count, (unsigned)bytes, fullUs, cachedUs,
+                      cachedUs > 0 ? (float)fullUs / cachedUs : 0.0f);
+        yield();
+    }
+
+    Serial.println();
+    Serial.printf("  Cache version:    %lu\n", (unsigned long)cacheVersion);
+    Serial.printf("  Responses:        %lu (last %lu us)\n", cacheStats.responses, cacheStats.lastResponseUs);
+    Serial.printf("  Fragments:        %lu built, %lu reused\n",
+                  cacheStats.fragmentsBuilt, cacheStats.fragmentsReused);
+    Serial.println();
+}
@@ -0,0 +1,206 @@
+#include "loop_watchdog.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL STATE                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+LoopWatchdog loopWatchdog;
+
+static const char* const LOOP_SECTION_NAMES[LOOP_SEC_COUNT] = {
+    "serial",
+    "gps",
+    "tdma",
+    "sensors",
+    "status",
+    "beacon",
+    "uplink",
+    "prune",
+    "rx",
+    "tx",
+    "display",
+    "web",
+    "other"
+};
+
+static const uint32_t TX_ALLOWANCE_US = (uint32_t)LOOP_TX_ALLOWANCE_MS * 1000UL;
+
+const char* loopSectionName(uint8_t section) {
+    return (section < LOOP_SEC_COUNT) ? LOOP_SECTION_NAMES[section] : "?";
+}
+
+// TX time beyond the per-iteration allowance
+static uint32_t chargedTxUs(uint32_t txUs) {
+    return (txUs > TX_ALLOWANCE_US) ? txUs - TX_ALLOWANCE_US : 0;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ITERATION TIMING                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+LoopWatchdog::LoopWatchdog() : budgetUs((uint32_t)LOOP_STALL_BUDGET_MS * 1000UL) {
+    clear();
+}
+
+void LoopWatchdog::closeSection(uint32_t nowUs) {
+    uint32_t elapsed = nowUs - sectionStartUs;
+    uint32_t before = sectionUs[current];
+    sectionUs[current] = before + elapsed;
+
+    if (current == LOOP_SEC_TX) {
+        chargedUs += chargedTxUs(before + elapsed) - chargedTxUs(before);
+    } else {
+        chargedUs += elapsed;
+    }
+
+    if (culprit == LOOP_SEC_COUNT && chargedUs > budgetUs) {
+        culprit = current;
+    }
+    sectionStartUs = nowUs;
+}
+
+void LoopWatchdog::startIteration() {
+    iterationStartUs = micros();
+    sectionStartUs = iterationStartUs;
+    chargedUs = 0;
+    memset(sectionUs, 0, sizeof(sectionUs));
+    current = LOOP_SEC_OTHER;
+    culprit = LOOP_SEC_COUNT;
+}
+
+void LoopWatchdog::enterSection(LoopSection section) {
+    closeSection(micros());
+    current = section;
+}
+
+void LoopWatchdog::endIteration() {
+    uint32_t nowUs = micros();
+    closeSection(nowUs);
+    current = LOOP_SEC_OTHER;
+
+    stats.iterations++;
+    if (chargedUs > stats.worstUs) stats.worstUs = chargedUs;
+
+    uint8_t longest = 0;
+    for (uint8_t s = 0; s < LOOP_SEC_COUNT; s++) {
+        if (sectionUs[s] > stats.sectionMaxUs[s]) stats.sectionMaxUs[s] = sectionUs[s];
+        if (sectionUs[s] > sectionUs[longest]) longest = s;
+    }
+
+    if (culprit == LOOP_SEC_COUNT) return;   // Within budget
+
+    stats.overruns++;
+    stats.sectionBlamed[culprit]++;
+
+    LoopStall& stall = history[historyHead];
+    stall.atMs = millis() - (nowUs - iterationStartUs) / 1000UL;
+    stall.totalUs = nowUs - iterationStartUs;
+    stall.chargedUs = chargedUs;
+    stall.culprit = culprit;
+    stall.culpritUs = sectionUs[culprit];
+    stall.longest = longest;
+    stall.longestUs = sectionUs[longest];
+
+    historyHead = (historyHead + 1) % LOOP_STALL_HISTORY;
+    if (historyCount < LOOP_STALL_HISTORY) historyCount++;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CONFIGURATION / ACCESS                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void LoopWatchdog::setBudgetMs(uint32_t ms) {
+    budgetUs = ms * 1000UL;
+}
+
+uint32_t LoopWatchdog::getBudgetMs() const {
+    return budgetUs / 1000UL;
+}
+
+const LoopWatchdogStats& LoopWatchdog::getStats() const {
+    return stats;
+}
+
+bool LoopWatchdog::getStall(uint8_t index, LoopStall& out) const {
+    if (index >= historyCount) return false;
+    out = history[(historyHead + LOOP_STALL_HISTORY - 1 - index) % LOOP_STALL_HISTORY];
+    return true;
+}
+
+uint8_t LoopWatchdog::getStallCount() const {
+    return historyCount;
+}
+
+void LoopWatchdog::clear() {
+    memset(&stats, 0, sizeof(stats));
+    memset(history, 0, sizeof(history));
+    memset(sectionUs, 0, sizeof(sectionUs));
+    historyHead = 0;
+    historyCount = 0;
+    iterationStartUs = micros();
+    sectionStartUs = iterationStartUs;
+    chargedUs = 0;
+    current = LOOP_SEC_OTHER;
+    culprit = LOOP_SEC_COUNT;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REPORTING                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void LoopWatchdog::printReport() const {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  LOOP STALLS                                                  ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    float pct = stats.iterations ? 100.0f * stats.overruns / stats.iterations : 0.0f;
+    Serial.printf("  Budget:      %lu ms (TX allowance %u ms)\n",
+                  (unsigned long)getBudgetMs(), (unsigned)LOOP_TX_ALLOWANCE_MS);
+    Serial.printf("  Iterations:  %lu\n", (unsigned long)stats.iterations);
+    Serial.printf("  Overruns:    %lu (%.2f%%)\n", (unsigned long)stats.overruns, pct);
+    Serial.printf("  Worst:       %.1f ms\n", stats.worstUs / 1000.0f);
+
+    Serial.println(F("    Section     max ms   blamed"));
+    for (uint8_t s = 0; s < LOOP_SEC_COUNT; s++) {
+        Serial.printf("    %-9s %8.1f %8lu\n",
+                      LOOP_SECTION_NAMES[s],
+                      stats.sectionMaxUs[s] / 1000.0f,
+                      (unsigned long)stats.sectionBlamed[s]);
+    }
+
+    if (historyCount == 0) {
+        Serial.println(F("  No overruns recorded"));
+        Serial.println();
+        return;
+    }
+
+    Serial.printf("  Last %u overruns (newest first):\n", historyCount);
+    Serial.println(F("        at ms   total   charged  culprit         longest"));
+    for (uint8_t i = 0; i < historyCount; i++) {
+        LoopStall stall;
+        getStall(i, stall);
+        Serial.printf("    %9lu %7.1f %9.1f  %-7s %6.1f  %-7s %6.1f\n",
+                      (unsigned long)stall.atMs,
+                      stall.totalUs / 1000.0f,
+                      stall.chargedUs / 1000.0f,
+                      loopSectionName(stall.culprit),
+                      stall.culpritUs / 1000.0f,
+                      loopSectionName(stall.longest),
+                      stall.longestUs / 1000.0f);
+    }
+    Serial.println();
+}
+
+void printLoopWatchdogJsonFields(Print& out) {
+    const LoopWatchdogStats& stats = loopWatchdog.getStats();
+
+    uint8_t mostBlamed = 0;
+    for (uint8_t s = 1; s < LOOP_SEC_COUNT; s++) {
+        if (stats.sectionBlamed[s] > stats.sectionBlamed[mostBlamed]) mostBlamed = s;
+    }
+
+    out.printf(",\"loopStalls\":%lu,\"loopWorstMs\":%lu,\"loopStallSection\":\"%s\"",
+               (unsigned long)stats.overruns,
+               (unsigned long)(stats.worstUs / 1000UL),
+               stats.overruns ? LOOP_SECTION_NAMES[mostBlamed] : "");
+}
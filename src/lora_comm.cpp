@@ -1,5 +1,7 @@
 #include "lora_comm.h"
 #include "config.h"  // For DEVICE_ID constant
+#include "mesh_schema.h"
+#include "metrics.h"
 #include <cstring>
 
 // Heltec WiFi LoRa 32 V3 pin definitions
@@ -10,10 +12,40 @@
 #define LORA_RST     12
 #define LORA_IRQ     14
 
+// SX1262 SPI clock (chip limit 16 MHz; 8 MHz leaves margin on the V3 board)
+#define LORA_SPI_CLOCK_HZ   8000000
+
+// SX1262 with direct RX FIFO access, so a frame can be read header first.
+// RadioLib's readData() always transfers the whole frame and keeps buffer
+// access protected.
+class MeshRadio : public SX1262 {
+public:
+    explicit MeshRadio(Module* mod) : SX1262(mod) {}
+
+    // Length and FIFO offset of the last received frame (one SPI command)
+    int16_t getRxBufferStatus(uint8_t& length, uint8_t& offset) {
+        uint8_t status[2] = {0, 0};
+        int16_t state = getMod()->SPIreadStream(RADIOLIB_SX126X_CMD_GET_RX_BUFFER_STATUS, status, 2);
+        length = status[0];
+        offset = status[1];
+        return state;
+    }
+
+    // Read part of the received frame
+    int16_t readFifo(uint8_t* data, uint8_t numBytes, uint8_t offset) {
+        return readBuffer(data, numBytes, offset);
+    }
+
+    // True if the last frame failed its header or payload CRC
+    bool rxCrcError() {
+        return (getIrqStatus() & (RADIOLIB_SX126X_IRQ_CRC_ERR | RADIOLIB_SX126X_IRQ_HEADER_ERR)) != 0;
+    }
+};
+
 // LoRa globals
 SPIClass spi(HSPI);
-SPISettings spiSettings(2000000, MSBFIRST, SPI_MODE0);
-SX1262 radio = new Module(LORA_CS, LORA_IRQ, LORA_RST, RADIOLIB_NC, spi, spiSettings);
+SPISettings spiSettings(LORA_SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0);
+MeshRadio radio(new Module(LORA_CS, LORA_IRQ, LORA_RST, RADIOLIB_NC, spi, spiSettings));
 
 constexpr size_t LORA_MAX_PACKET_SIZE = 255;
 constexpr size_t LORA_MAX_PAYLOAD_SIZE = LORA_MAX_PACKET_SIZE - LORA_HEADER_SIZE;
@@ -26,10 +58,14 @@ uint16_t loraSeq = 0;
 // *** KEY FIX: Interrupt-driven packet detection ***
 // This volatile flag is set by the ISR when a NEW packet arrives
 volatile bool packetReceived = false;
+volatile unsigned long packetReceivedAtMs = 0;  // millis() at the RX-done interrupt
 
 // Spinlock mutex for protecting packetReceived flag (ISR-safe)
 static portMUX_TYPE radioMux = portMUX_INITIALIZER_UNLOCKED;
 
+// Set while a CAD owns DIO1 (its done interrupt is not a packet)
+static volatile bool cadActive = false;
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         STATIC BUFFERS (STACK OPTIMIZATION)               ║
 // ║  Shared TX/RX buffers to save stack space (~1KB saved)                   ║
@@ -39,14 +75,31 @@ static portMUX_TYPE radioMux = portMUX_INITIALIZER_UNLOCKED;
 static uint8_t txBuffer[LORA_MAX_PACKET_SIZE];  // 255 bytes - shared TX buffer
 static uint8_t rxBuffer[LORA_MAX_PACKET_SIZE];  // 255 bytes - shared RX buffer
 
+// RX path
+static RxHeaderFilter rxHeaderFilter = nullptr;
+static RadioRxStats radioRxStats;
+
 // Interrupt Service Routine - called by radio when packet received
 #if defined(ESP8266) || defined(ESP32)
 ICACHE_RAM_ATTR
 #endif
 void setPacketReceivedFlag(void) {
+    if (cadActive) return;
     portENTER_CRITICAL_ISR(&radioMux);
     packetReceived = true;
+    packetReceivedAtMs = millis();
     portEXIT_CRITICAL_ISR(&radioMux);
+    metricInc(MET_RADIO_IRQS);
+}
+
+/**
+ * Account a sent frame: time on air, and message type for mesh payloads
+ */
+static void noteTransmit(const uint8_t* payload, size_t payloadLen, size_t packetLen) {
+    metricAdd(MET_TX_AIRTIME_MS, radio.getTimeOnAir(packetLen) / 1000);
+    if (payloadLen >= 2 && payload[0] == MESH_PROTOCOL_VERSION) {
+        metricIncLabel(FAM_TX_BY_TYPE, payload[1]);
+    }
 }
 
 bool initLoRa() {
@@ -138,6 +191,7 @@ bool sendMessage(String message) {
     radio.startReceive();
 
     if (state == RADIOLIB_ERR_NONE) {
+        noteTransmit(nullptr, 0, packetLen);
         Serial.println(F("LoRa TX successful"));
         return true;
     } else {
@@ -189,6 +243,7 @@ bool sendBinaryMessage(const uint8_t* data, uint8_t length) {
     radio.startReceive();
 
     if (state == RADIOLIB_ERR_NONE) {
+        noteTransmit(data, length, packetLen);
         Serial.println(F("LoRa TX successful"));
         return true;
     } else {
@@ -241,6 +296,7 @@ bool forwardPacket(const LoRaPacketHeader &header, const String &payload) {
     radio.startReceive();
 
     if (state == RADIOLIB_ERR_NONE) {
+        noteTransmit((const uint8_t*)payload.c_str(), outgoing.payloadLen, packetLen);
         Serial.println(F("LoRa relay successful"));
         return true;
     }
@@ -257,6 +313,20 @@ void setLoRaReceiveMode() {
     }
 }
 
+/**
+ * Back to RX and account one frame's SPI and CPU time
+ * (the log line printed afterwards is not counted)
+ */
+static void finishRx(unsigned long rxStartUs, unsigned long spiUs) {
+    radio.startReceive();
+
+    unsigned long rxUs = micros() - rxStartUs;
+    radioRxStats.spiTimeUs += spiUs;
+    radioRxStats.rxTimeUs += rxUs;
+    if (spiUs > radioRxStats.maxSpiUs) radioRxStats.maxSpiUs = spiUs;
+    if (rxUs > radioRxStats.maxRxUs) radioRxStats.maxRxUs = rxUs;
+}
+
 bool receivePacket(LoRaReceivedPacket &packet) {
     if (!loraReady) return false;
 
@@ -264,8 +334,10 @@ bool receivePacket(LoRaReceivedPacket &packet) {
     // This prevents re-reading stale data from the radio buffer
     // Use critical section to safely read and clear the flag
     bool hasPacket;
+    unsigned long receivedAtMs;
     portENTER_CRITICAL(&radioMux);
     hasPacket = packetReceived;
+    receivedAtMs = packetReceivedAtMs;
     if (hasPacket) {
         packetReceived = false;  // Clear flag atomically
     }
@@ -275,108 +347,126 @@ bool receivePacket(LoRaReceivedPacket &packet) {
         return false;
     }
 
-    size_t packetLen = radio.getPacketLength(true);
-    
+    unsigned long rxStartUs = micros();
+    unsigned long spiUs = 0;
+    unsigned long t0;
+
+    // Length, FIFO offset and CRC status - nothing read from the FIFO yet
+    uint8_t packetLen = 0;
+    uint8_t fifoOffset = 0;
+    t0 = micros();
+    radio.getRxBufferStatus(packetLen, fifoOffset);
+    bool crcError = radio.rxCrcError();
+    spiUs += micros() - t0;
+
     if (packetLen == 0) {
-        radio.startReceive();
+        finishRx(rxStartUs, spiUs);
+        return false;
+    }
+
+    if (crcError || packetLen < LORA_HEADER_SIZE) {
+        if (!crcError) {
+            Serial.print(F("LoRa RX: Invalid length: "));
+            Serial.println(packetLen);
+        }
+        radioRxStats.framesInvalid++;
+        radioRxStats.bytesSkipped += packetLen;
+        finishRx(rxStartUs, spiUs);
         return false;
     }
 
-    if (packetLen < LORA_HEADER_SIZE || packetLen > LORA_MAX_PACKET_SIZE) {
-        Serial.print(F("LoRa RX: Invalid length: "));
+    // Header first: LoRa header + MeshHeader (short frames in one go)
+    uint8_t headLen = (packetLen < LORA_RX_HEAD_SIZE) ? packetLen : LORA_RX_HEAD_SIZE;
+    t0 = micros();
+    radio.readFifo(rxBuffer, headLen, fifoOffset);
+    spiUs += micros() - t0;
+    radioRxStats.bytesRead += headLen;
+
+    LoRaPacketHeader header;
+    size_t idx = 0;
+    header.originId = rxBuffer[idx++];
+    header.seq = (static_cast<uint16_t>(rxBuffer[idx++]) << 8);
+    header.seq |= rxBuffer[idx++];
+    header.ttl = rxBuffer[idx++];
+    header.payloadLen = (static_cast<uint16_t>(rxBuffer[idx++]) << 8);
+    header.payloadLen |= rxBuffer[idx++];
+
+    const size_t expectedLen = LORA_HEADER_SIZE + header.payloadLen;
+
+    if (header.payloadLen > LORA_MAX_PAYLOAD_SIZE || expectedLen != packetLen) {
+        Serial.print(F("LoRa RX: Length mismatch "));
+        Serial.print(expectedLen);
+        Serial.print(F(" vs "));
         Serial.println(packetLen);
-        // Use rxBuffer for discarding invalid packets too
-        radio.readData(rxBuffer, min(packetLen, LORA_MAX_PACKET_SIZE));
-        radio.startReceive();
+        radioRxStats.framesInvalid++;
+        radioRxStats.bytesSkipped += packetLen - headLen;
+        finishRx(rxStartUs, spiUs);
         return false;
     }
 
-    // Use static rxBuffer to save stack space
-    int state = radio.readData(rxBuffer, packetLen);
+    // Only reject own packets here - mesh-level checks belong to the filter
+    if (header.originId == DEVICE_ID) {
+        radioRxStats.framesOwn++;
+        radioRxStats.bytesSkipped += packetLen - headLen;
+        finishRx(rxStartUs, spiUs);
+        return false;
+    }
 
-    if (state == RADIOLIB_ERR_NONE) {
-        // DEBUG - print both methods
-        Serial.print(F("[DEBUG] getRSSI(): "));
-        Serial.println(radio.getRSSI());
-        Serial.print(F("[DEBUG] getRSSI(true): "));
-        Serial.println(radio.getRSSI(true));
-        Serial.print(F("[DEBUG] getSNR(): "));
-        Serial.println(radio.getSNR());
-
-        LoRaPacketHeader header;
-        size_t idx = 0;
-        header.originId = rxBuffer[idx++];
-        header.seq = (static_cast<uint16_t>(rxBuffer[idx++]) << 8);
-        header.seq |= rxBuffer[idx++];
-        header.ttl = rxBuffer[idx++];
-        header.payloadLen = (static_cast<uint16_t>(rxBuffer[idx++]) << 8);
-        header.payloadLen |= rxBuffer[idx++];
-
-        const size_t expectedLen = LORA_HEADER_SIZE + header.payloadLen;
-        
-        if (header.payloadLen > LORA_MAX_PAYLOAD_SIZE) {
-            Serial.println(F("LoRa RX: Payload too large"));
-            radio.startReceive();
-            return false;
-        }
-        
-        if (expectedLen != packetLen) {
-            Serial.print(F("LoRa RX: Length mismatch "));
-            Serial.print(expectedLen);
-            Serial.print(F(" vs "));
-            Serial.println(packetLen);
-            radio.startReceive();
-            return false;
-        }
-        
-        // Only reject own packets - let main.cpp handle duplicates and TTL
-        if (header.originId == DEVICE_ID) {
-            Serial.println(F("LoRa RX: Ignoring own packet"));
-            radio.startReceive();
-            return false;
-        }
+    if (rxHeaderFilter != nullptr &&
+        !rxHeaderFilter(header, &rxBuffer[LORA_HEADER_SIZE], headLen - LORA_HEADER_SIZE)) {
+        radioRxStats.framesFiltered++;
+        radioRxStats.bytesSkipped += packetLen - headLen;
+        finishRx(rxStartUs, spiUs);
+        return false;
+    }
 
-        // Store RSSI/SNR with critical section protection (volatile floats)
-        portENTER_CRITICAL(&radioMux);
-        lastRSSI = radio.getRSSI(true);
-        lastSNR = radio.getSNR();
-        portEXIT_CRITICAL(&radioMux);
+    // Rest of the frame
+    t0 = micros();
+    if (packetLen > headLen) {
+        radio.readFifo(&rxBuffer[headLen], packetLen - headLen, (uint8_t)(fifoOffset + headLen));
+        radioRxStats.bytesRead += packetLen - headLen;
+    }
 
-        packet.header = header;
+    // Packet RSSI/SNR, read once per frame
+    float rssi = radio.getRSSI(true);
+    float snr = radio.getSNR();
+    spiUs += micros() - t0;
 
-        // Store raw bytes
-        packet.payloadLen = header.payloadLen;
-        if (packet.payloadLen > 64) packet.payloadLen = 64;
-        memcpy(packet.payloadBytes, &rxBuffer[idx], packet.payloadLen);
+    // Store RSSI/SNR with critical section protection (volatile floats)
+    portENTER_CRITICAL(&radioMux);
+    lastRSSI = rssi;
+    lastSNR = snr;
+    portEXIT_CRITICAL(&radioMux);
 
-        // Also create string version for legacy/text messages
-        packet.payload = String((char*)&rxBuffer[idx], header.payloadLen);
-        
-        packet.rssi = lastRSSI;
-        packet.snr = lastSNR;
-
-        Serial.print(F("LoRa RX: "));
-        Serial.print(packet.payloadLen);
-        Serial.print(F(" bytes, origin="));
-        Serial.print(header.originId);
-        Serial.print(F(" seq="));
-        Serial.print(header.seq);
-        Serial.print(F(" RSSI:"));
-        Serial.print(lastRSSI);
-        Serial.print(F(" SNR:"));
-        Serial.println(lastSNR);
+    packet.header = header;
 
-        radio.startReceive();
-        return true;
-    }
+    // Store raw bytes
+    packet.payloadLen = header.payloadLen;
+    if (packet.payloadLen > 64) packet.payloadLen = 64;
+    memcpy(packet.payloadBytes, &rxBuffer[idx], packet.payloadLen);
 
-    if (state != RADIOLIB_ERR_RX_TIMEOUT) {
-        Serial.print(F("LoRa RX error: "));
-        Serial.println(state);
-    }
-    
-    radio.startReceive();
-    return false;
+    // Also create string version for legacy/text messages
+    packet.payload = String((char*)&rxBuffer[idx], header.payloadLen);
+
+    packet.rssi = rssi;
+    packet.snr = snr;
+    packet.receivedAtMs = receivedAtMs;
+
+    radioRxStats.framesRead++;
+    finishRx(rxStartUs, spiUs);
+
+    Serial.print(F("LoRa RX: "));
+    Serial.print(packet.payloadLen);
+    Serial.print(F(" bytes, origin="));
+    Serial.print(header.originId);
+    Serial.print(F(" seq="));
+    Serial.print(header.seq);
+    Serial.print(F(" RSSI:"));
+    Serial.print(rssi);
+    Serial.print(F(" SNR:"));
+    Serial.println(snr);
+
+    return true;
 }
 
 String receiveMessage() {
@@ -407,6 +497,77 @@ float getLastSNR() {
     return snr;
 }
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RX PATH STATISTICS                                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void setRxHeaderFilter(RxHeaderFilter filter) {
+    rxHeaderFilter = filter;
+}
+
+RadioRxStats getRadioRxStats() {
+    RadioRxStats stats = radioRxStats;
+    stats.spiClockHz = LORA_SPI_CLOCK_HZ;
+    return stats;
+}
+
+void printRadioRxStats() {
+    unsigned long frames = radioRxStats.framesRead + radioRxStats.framesFiltered +
+                           radioRxStats.framesOwn + radioRxStats.framesInvalid;
+
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  RADIO RX PATH                                                ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  SPI clock:        %lu MHz\n", (unsigned long)(LORA_SPI_CLOCK_HZ / 1000000UL));
+    Serial.printf("  Header filter:    %s\n", rxHeaderFilter != nullptr ? "installed" : "none");
+    Serial.printf("  Frames:           %lu (read %lu, filtered %lu, own %lu, invalid %lu)\n",
+                  frames, radioRxStats.framesRead, radioRxStats.framesFiltered,
+                  radioRxStats.framesOwn, radioRxStats.framesInvalid);
+    Serial.printf("  FIFO bytes:       %lu read, %lu skipped\n",
+                  radioRxStats.bytesRead, radioRxStats.bytesSkipped);
+
+    if (frames > 0) {
+        Serial.printf("  SPI per frame:    %lu us avg, %lu us max\n",
+                      radioRxStats.spiTimeUs / frames, radioRxStats.maxSpiUs);
+        Serial.printf("  CPU per frame:    %lu us avg, %lu us max (receivePacket, excl. logging)\n",
+                      radioRxStats.rxTimeUs / frames, radioRxStats.maxRxUs);
+    }
+    Serial.println();
+}
+
+uint32_t getFrameAirtimeMs(size_t payloadLen) {
+    return (uint32_t)(radio.getTimeOnAir(LORA_HEADER_SIZE + payloadLen) / 1000);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CHANNEL SAMPLING                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+float sampleChannelRssi() {
+    if (!loraReady) return 0.0f;
+    return radio.getRSSI(false);    // GetRssiInst, stays in RX
+}
+
+int8_t sampleChannelActivity() {
+    if (!loraReady) return -1;
+
+    // Don't overwrite a frame that is waiting in the FIFO
+    portENTER_CRITICAL(&radioMux);
+    bool pending = packetReceived;
+    if (!pending) cadActive = true;
+    portEXIT_CRITICAL(&radioMux);
+    if (pending) return -1;
+
+    int16_t state = radio.scanChannel();
+    cadActive = false;
+    radio.startReceive();
+
+    if (state == RADIOLIB_LORA_DETECTED) return 1;
+    if (state == RADIOLIB_CHANNEL_FREE) return 0;
+    return -1;
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         FULL_REPORT ENCODING                              ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -414,95 +575,39 @@ float getLastSNR() {
 // Static sequence counter for message IDs (wraps at 255)
 static uint8_t meshMessageSeq = 0;
 
+uint8_t getMeshMessageSeq() {
+    return meshMessageSeq;
+}
+
+void setMeshMessageSeq(uint8_t seq) {
+    meshMessageSeq = seq;
+}
+
 uint8_t encodeFullReport(uint8_t* buffer, const FullReportMsg& report) {
-    uint8_t idx = 0;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // MeshHeader (8 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = MESH_PROTOCOL_VERSION;          // version
-    buffer[idx++] = MSG_FULL_REPORT;                // messageType
-    buffer[idx++] = DEVICE_ID;                      // sourceId
-    buffer[idx++] = ADDR_BROADCAST;                 // destId (broadcast to all)
-    buffer[idx++] = DEVICE_ID;                      // senderId (same as source initially)
-    buffer[idx++] = meshMessageSeq++;               // messageId (auto-increment, wraps at 255)
-    buffer[idx++] = MESH_DEFAULT_TTL;               // ttl
-    buffer[idx++] = 0;                              // flags (no special flags for broadcast)
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Environmental sensors (8 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = report.temperatureF_x10 & 0xFF;
-    buffer[idx++] = (report.temperatureF_x10 >> 8) & 0xFF;
-    buffer[idx++] = report.humidity_x10 & 0xFF;
-    buffer[idx++] = (report.humidity_x10 >> 8) & 0xFF;
-    buffer[idx++] = report.pressure_hPa & 0xFF;
-    buffer[idx++] = (report.pressure_hPa >> 8) & 0xFF;
-    buffer[idx++] = report.altitude_m & 0xFF;
-    buffer[idx++] = (report.altitude_m >> 8) & 0xFF;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // GPS data (12 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = report.latitude_x1e6 & 0xFF;
-    buffer[idx++] = (report.latitude_x1e6 >> 8) & 0xFF;
-    buffer[idx++] = (report.latitude_x1e6 >> 16) & 0xFF;
-    buffer[idx++] = (report.latitude_x1e6 >> 24) & 0xFF;
-    buffer[idx++] = report.longitude_x1e6 & 0xFF;
-    buffer[idx++] = (report.longitude_x1e6 >> 8) & 0xFF;
-    buffer[idx++] = (report.longitude_x1e6 >> 16) & 0xFF;
-    buffer[idx++] = (report.longitude_x1e6 >> 24) & 0xFF;
-    buffer[idx++] = report.gps_altitude_m & 0xFF;
-    buffer[idx++] = (report.gps_altitude_m >> 8) & 0xFF;
-    buffer[idx++] = report.satellites;
-    buffer[idx++] = report.hdop_x10;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // System status (10 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = report.uptime_sec & 0xFF;
-    buffer[idx++] = (report.uptime_sec >> 8) & 0xFF;
-    buffer[idx++] = (report.uptime_sec >> 16) & 0xFF;
-    buffer[idx++] = (report.uptime_sec >> 24) & 0xFF;
-    buffer[idx++] = report.txCount & 0xFF;
-    buffer[idx++] = (report.txCount >> 8) & 0xFF;
-    buffer[idx++] = report.rxCount & 0xFF;
-    buffer[idx++] = (report.rxCount >> 8) & 0xFF;
-    buffer[idx++] = report.battery_pct;
-    buffer[idx++] = report.neighborCount;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Flags (1 byte)
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = report.flags;
-
-    return idx;  // Should be 39 bytes (8-byte header + 31-byte payload)
+    // Header is ours to fill; destId comes from the caller (anycast gateway or broadcast)
+    FullReportMsg msg = report;
+    msg.meshHeader.version = MESH_PROTOCOL_VERSION;
+    msg.meshHeader.messageType = MSG_FULL_REPORT;
+    msg.meshHeader.sourceId = DEVICE_ID;
+    msg.meshHeader.senderId = DEVICE_ID;            // same as source initially
+    msg.meshHeader.messageId = meshMessageSeq++;    // auto-increment, wraps at 255
+    msg.meshHeader.ttl = MESH_DEFAULT_TTL;
+    msg.meshHeader.flags = 0;                       // no special flags for broadcast
+
+    // Field layout comes from FULL_REPORT_SCHEMA (mesh_schema.h)
+    return schemaEncodeFullReport(buffer, msg);     // 39 bytes (8-byte header + 31-byte payload)
 }
 
 bool decodeFullReport(const uint8_t* buffer, uint8_t length, FullReportMsg& report) {
 
     // Need at least 39 bytes (8 MeshHeader + 31 payload)
-    if (length < 39) {
+    if (!schemaDecodeFullReport(buffer, length, report)) {
         Serial.print(F("decodeFullReport: Buffer too short ("));
         Serial.print(length);
         Serial.println(F(" bytes, need 39)"));
         return false;
     }
 
-    uint8_t idx = 0;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // MeshHeader (8 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    report.meshHeader.version = buffer[idx++];
-    report.meshHeader.messageType = buffer[idx++];
-    report.meshHeader.sourceId = buffer[idx++];
-    report.meshHeader.destId = buffer[idx++];
-    report.meshHeader.senderId = buffer[idx++];
-    report.meshHeader.messageId = buffer[idx++];
-    report.meshHeader.ttl = buffer[idx++];
-    report.meshHeader.flags = buffer[idx++];
-
     // Validate protocol version
     if (report.meshHeader.version != MESH_PROTOCOL_VERSION) {
         Serial.print(F("⚠ WARNING: Protocol version mismatch! Got v"));
@@ -520,50 +625,6 @@ bool decodeFullReport(const uint8_t* buffer, uint8_t length, FullReportMsg& repo
         return false;
     }
 
-    // ─────────────────────────────────────────────────────────────────────────
-    // Environmental sensors (8 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    report.temperatureF_x10 = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-    report.humidity_x10 = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-    report.pressure_hPa = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-    report.altitude_m = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // GPS data (12 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    report.latitude_x1e6 = buffer[idx] | (buffer[idx+1] << 8) |
-                           (buffer[idx+2] << 16) | (buffer[idx+3] << 24);
-    idx += 4;
-    report.longitude_x1e6 = buffer[idx] | (buffer[idx+1] << 8) |
-                            (buffer[idx+2] << 16) | (buffer[idx+3] << 24);
-    idx += 4;
-    report.gps_altitude_m = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-    report.satellites = buffer[idx++];
-    report.hdop_x10 = buffer[idx++];
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // System status (10 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    report.uptime_sec = buffer[idx] | (buffer[idx+1] << 8) |
-                        (buffer[idx+2] << 16) | (buffer[idx+3] << 24);
-    idx += 4;
-    report.txCount = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-    report.rxCount = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-    report.battery_pct = buffer[idx++];
-    report.neighborCount = buffer[idx++];
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Flags (1 byte)
-    // ─────────────────────────────────────────────────────────────────────────
-    report.flags = buffer[idx++];
-
     return true;
 }
 
@@ -581,44 +642,25 @@ MessageType getMessageType(const uint8_t* buffer, uint8_t length) {
 static uint16_t beaconSeq = 0;
 
 uint8_t encodeBeacon(uint8_t* buffer, const BeaconMsg& beacon) {
-    uint8_t idx = 0;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // MeshHeader (8 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = MESH_PROTOCOL_VERSION;          // version
-    buffer[idx++] = MSG_BEACON;                     // messageType
-    buffer[idx++] = DEVICE_ID;                      // sourceId
-    buffer[idx++] = ADDR_BROADCAST;                 // destId (broadcast to all)
-    buffer[idx++] = DEVICE_ID;                      // senderId (same as source initially)
-    buffer[idx++] = beaconSeq & 0xFF;               // messageId (beacon seq, lower byte)
-    buffer[idx++] = MESH_MAX_HOPS;                  // ttl (beacons propagate far)
-    buffer[idx++] = 0;                              // flags (no special flags for beacons)
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Beacon payload - routing info (4 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = beacon.distanceToGateway;       // distance (hop count)
-    buffer[idx++] = beacon.gatewayId;               // which gateway
-    buffer[idx++] = beacon.sequenceNumber & 0xFF;   // sequence (lower byte)
-    buffer[idx++] = (beacon.sequenceNumber >> 8) & 0xFF;  // sequence (upper byte)
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Beacon payload - time sync info (4 bytes) - NEW
-    // ─────────────────────────────────────────────────────────────────────────
-    buffer[idx++] = beacon.gpsHour;                 // GPS hour (0-23)
-    buffer[idx++] = beacon.gpsMinute;               // GPS minute (0-59)
-    buffer[idx++] = beacon.gpsSecond;               // GPS second (0-59)
-    buffer[idx++] = beacon.gpsValid;                // GPS valid flag (0 or 1)
+    BeaconMsg msg = beacon;
+    msg.meshHeader.version = MESH_PROTOCOL_VERSION;
+    msg.meshHeader.messageType = MSG_BEACON;
+    msg.meshHeader.sourceId = DEVICE_ID;
+    msg.meshHeader.destId = ADDR_BROADCAST;         // broadcast to all
+    msg.meshHeader.senderId = DEVICE_ID;            // same as source initially
+    msg.meshHeader.messageId = beaconSeq & 0xFF;    // beacon seq, lower byte
+    msg.meshHeader.ttl = MESH_MAX_HOPS;             // beacons propagate far
+    msg.meshHeader.flags = 0;                       // no special flags for beacons
 
     beaconSeq++;  // Increment for next beacon
 
-    return idx;  // Should be 16 bytes (8-byte header + 8-byte payload)
+    // Field layout comes from BEACON_SCHEMA (mesh_schema.h)
+    return schemaEncodeBeacon(buffer, msg);         // 21 bytes (8-byte header + 13-byte payload)
 }
 
 bool decodeBeacon(const uint8_t* buffer, uint8_t length, BeaconMsg& beacon) {
     // Need at least 12 bytes for backwards compatibility (old beacons without time)
-    // New beacons are 16 bytes (8 MeshHeader + 4 routing + 4 time sync)
+    // New beacons are 21 bytes (8 MeshHeader + 4 routing + 4 time sync + 2 epoch + 3 correction)
     if (length < 12) {
         Serial.print(F("decodeBeacon: Buffer too short ("));
         Serial.print(length);
@@ -626,19 +668,13 @@ bool decodeBeacon(const uint8_t* buffer, uint8_t length, BeaconMsg& beacon) {
         return false;
     }
 
-    uint8_t idx = 0;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // MeshHeader (8 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    beacon.meshHeader.version = buffer[idx++];
-    beacon.meshHeader.messageType = buffer[idx++];
-    beacon.meshHeader.sourceId = buffer[idx++];
-    beacon.meshHeader.destId = buffer[idx++];
-    beacon.meshHeader.senderId = buffer[idx++];
-    beacon.meshHeader.messageId = buffer[idx++];
-    beacon.meshHeader.ttl = buffer[idx++];
-    beacon.meshHeader.flags = buffer[idx++];
+    // Older firmware sends 12 bytes (no time sync), 16 (no epoch) or 18 (no
+    // slot correction); the missing fields decode as 0, which marks the time
+    // as invalid and names no node to correct
+    uint8_t full[BEACON_WIRE_SIZE] = {0};
+    memcpy(full, buffer, length >= BEACON_WIRE_SIZE ? BEACON_WIRE_SIZE :
+                         (length >= 18 ? 18 : (length >= 16 ? 16 : 12)));
+    schemaDecodeBeacon(full, sizeof(full), beacon);
 
     // Validate protocol version
     if (beacon.meshHeader.version != MESH_PROTOCOL_VERSION) {
@@ -657,31 +693,5 @@ bool decodeBeacon(const uint8_t* buffer, uint8_t length, BeaconMsg& beacon) {
         return false;
     }
 
-    // ─────────────────────────────────────────────────────────────────────────
-    // Beacon payload - routing info (4 bytes)
-    // ─────────────────────────────────────────────────────────────────────────
-    beacon.distanceToGateway = buffer[idx++];
-    beacon.gatewayId = buffer[idx++];
-    beacon.sequenceNumber = buffer[idx] | (buffer[idx+1] << 8);
-    idx += 2;
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Beacon payload - time sync info (4 bytes) - NEW
-    // Handle backwards compatibility with old 12-byte beacons
-    // ─────────────────────────────────────────────────────────────────────────
-    if (length >= 16) {
-        // New beacon format with time sync
-        beacon.gpsHour = buffer[idx++];
-        beacon.gpsMinute = buffer[idx++];
-        beacon.gpsSecond = buffer[idx++];
-        beacon.gpsValid = buffer[idx++];
-    } else {
-        // Old beacon format without time sync - mark as invalid
-        beacon.gpsHour = 0;
-        beacon.gpsMinute = 0;
-        beacon.gpsSecond = 0;
-        beacon.gpsValid = 0;  // No time available in old format
-    }
-
     return true;
 }
\ No newline at end of file
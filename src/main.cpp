@@ -23,6 +23,7 @@
 // Sensors
 #include "sht30.h"
 #include "bmp180.h"
+#include "sensor_math.h"
 
 // Project modules
 #include "config.h"
@@ -31,8 +32,6 @@
 #include "display_manager.h"
 #include "serial_output.h"
 #include "serial_json.h"
-#include "web_dashboard.h"
-#include "thingspeak.h"
 #include "neighbor_table.h"
 #include "duplicate_cache.h"
 #include "transmit_queue.h"
@@ -40,6 +39,14 @@
 #include "mesh_debug.h"
 #include "mesh_commands.h"
 #include "memory_monitor.h"
+#include "traffic_generator.h"
+#include "gateway_sync.h"
+#include "warm_start.h"
+#include "boot_metrics.h"
+#include "loop_watchdog.h"
+#include "metrics.h"
+#include "channel_monitor.h"
+#include "slot_monitor.h"
 // Hardware interfaces
 #include "lora_comm.h"
 #include "tdma_scheduler.h"
@@ -47,6 +54,14 @@
 #include "gradient_routing.h"
 #include "network_time.h"
 
+// Gateway-only subsystems (not compiled into relay / leaf builds)
+#if MESH_WITH_UPLINK
+#include <WiFi.h>
+#include "web_dashboard.h"
+#include "uplink.h"
+#include "json_cache.h"
+#endif
+
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GLOBAL OBJECTS                                    ║
@@ -69,14 +84,15 @@ BMP180 bmp180;
 bool sht30_ok = false;
 bool bmp180_ok = false;
 
-// Cached sensor readings (updated periodically)
-float sensor_tempF = 72.5f;         // Temperature in Fahrenheit
-float sensor_humidity = 45.0f;      // Humidity percentage
-float sensor_pressure_hPa = 1013.0f; // Pressure in hPa
-float sensor_altitude_m = 0.0f;     // Barometric altitude in meters
+// Cached sensor readings (updated periodically), already in FullReportMsg scaling
+int16_t sensor_tempF_x10 = 725;         // Temperature in 0.1 °F
+uint16_t sensor_humidity_x10 = 450;     // Humidity in 0.1 %
+uint16_t sensor_pressure_hPa = 1013;    // Pressure in hPa
+int16_t sensor_altitude_m = 0;          // Barometric altitude in meters
 
 // Sea level pressure calibration (auto-calibrated from GPS altitude)
-static float calibrated_sea_level_pa = SEA_LEVEL_PRESSURE_PA;  // Start with standard
+static int32_t calibrated_sea_level_pa = (int32_t)SEA_LEVEL_PRESSURE_PA;  // Start with standard
+static int32_t calibrated_sea_level_q8 = 0;     // EMA state, Pa Q8 (sensor_math.h)
 static bool sea_level_calibrated = false;
 
 // Timing for sensor reads
@@ -105,6 +121,8 @@ static unsigned long lastNodeCheck = 0;
 static unsigned long lastStatsPrint = 0;
 static unsigned long lastNeighborPrune = 0;
 static unsigned long lastBeaconSent = 0;
+static int lastBeaconMinute = -1;           // Minute of the last sub-frame beacon
+static uint16_t gatewayBeaconSeq = 0;       // Beacon sequence within this boot epoch
 
 // Note: BEACON_INTERVAL_MS is now defined in config.h/config.cpp
 
@@ -114,6 +132,7 @@ static unsigned long lastBeaconSent = 0;
 
 static uint8_t primaryTxThisSlot = 0;
 static bool wasInSlot = false;
+static uint32_t slotAirtimeStartMs = 0;     // MET_TX_AIRTIME_MS at slot entry
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         SENSOR READING                                    ║
@@ -123,10 +142,9 @@ void readSensors() {
     // Read SHT30 (temperature and humidity)
     if (SENSOR_SHT30_ENABLED && sht30_ok) {
         if (sht30.read()) {
-            // Convert Celsius to Fahrenheit
-            float tempC = sht30.getTemperature();
-            sensor_tempF = tempC * 1.8f + 32.0f;
-            sensor_humidity = sht30.getHumidity();
+            // Fahrenheit straight from the raw count (sensor_math.h)
+            sensor_tempF_x10 = sht30.getTemperatureF_x10();
+            sensor_humidity_x10 = sht30.getHumidity_x10();
         } else {
             Serial.println(F("[SENSOR] SHT30 read failed"));
         }
@@ -134,44 +152,43 @@ void readSensors() {
 
     // Read BMP180 (pressure and altitude)
     if (SENSOR_BMP180_ENABLED && bmp180_ok) {
-        float pressure_pa = bmp180.readPressure();
-        if (pressure_pa > 0) {
-            sensor_pressure_hPa = pressure_pa / 100.0f;  // Convert Pa to hPa
+        // One temperature + one pressure conversion serves every field below
+        if (bmp180.read()) {
+            int32_t pressure_pa = bmp180.getPressurePa();
+            sensor_pressure_hPa = pressureToHpa(pressure_pa);
 
             // Auto-calibrate sea level pressure using GPS altitude
-            // Formula: P0 = P / (1 - altitude/44330)^5.255
-            if (g_location_valid && gps.altitude.isValid()) {
-                float gps_alt = gps.altitude.meters();
+            // Formula: P0 = P / (1 - altitude/44330)^5.255 (table, see sensor_math.cpp)
+            if (g_location_valid && isAltitudeValid()) {
+                float gps_alt = getGPSAltitude();
                 // Only calibrate if GPS altitude is reasonable (-500m to 10000m)
                 if (gps_alt > -500.0f && gps_alt < 10000.0f) {
-                    float ratio = 1.0f - (gps_alt / 44330.0f);
-                    if (ratio > 0.0f) {
-                        float new_sea_level = pressure_pa / powf(ratio, 5.255f);
-                        // Sanity check: sea level pressure should be 950-1050 hPa
-                        if (new_sea_level > 95000.0f && new_sea_level < 105000.0f) {
-                            // Smooth the calibration to avoid jumps
-                            if (!sea_level_calibrated) {
-                                calibrated_sea_level_pa = new_sea_level;
-                                sea_level_calibrated = true;
-                                Serial.print(F("[SENSOR] Sea level pressure calibrated from GPS: "));
-                                Serial.print(new_sea_level / 100.0f, 1);
-                                Serial.println(F(" hPa"));
-                            } else {
-                                // Exponential moving average (slow adaptation)
-                                calibrated_sea_level_pa = calibrated_sea_level_pa * 0.95f + new_sea_level * 0.05f;
-                            }
+                    int32_t new_sea_level = baroSeaLevelPa(pressure_pa, (int32_t)(gps_alt * 1000.0f));
+                    // Sanity check: sea level pressure should be 950-1050 hPa
+                    if (new_sea_level > 95000 && new_sea_level < 105000) {
+                        // Smooth the calibration to avoid jumps
+                        if (!sea_level_calibrated) {
+                            calibrated_sea_level_pa = new_sea_level;
+                            calibrated_sea_level_q8 = baroSeaLevelToQ8(new_sea_level);
+                            sea_level_calibrated = true;
+                            Serial.printf("[SENSOR] Sea level pressure calibrated from GPS: %ld.%ld hPa\n",
+                                          (long)(new_sea_level / 100), (long)(new_sea_level % 100) / 10);
+                        } else {
+                            // Exponential moving average (slow adaptation, alpha = 1/20), in
+                            // Q8 so sub-Pa steps accumulate instead of truncating to zero
+                            calibrated_sea_level_q8 = baroSeaLevelEmaQ8(calibrated_sea_level_q8, new_sea_level);
+                            calibrated_sea_level_pa = baroSeaLevelFromQ8(calibrated_sea_level_q8);
                         }
                     }
                 }
             }
 
             // Calculate altitude using calibrated sea level pressure
-            sensor_altitude_m = bmp180.readAltitude(calibrated_sea_level_pa);
+            sensor_altitude_m = baroAltitudeM(pressure_pa, calibrated_sea_level_pa);
 
             // If SHT30 is not available, use BMP180 temperature
             if (!SENSOR_SHT30_ENABLED || !sht30_ok) {
-                float tempC = bmp180.readTemperature();
-                sensor_tempF = tempC * 1.8f + 32.0f;
+                sensor_tempF_x10 = celsiusToFahrenheit_x10(bmp180.getTemperatureC_x10());
             }
         } else {
             Serial.println(F("[SENSOR] BMP180 read failed"));
@@ -188,18 +205,18 @@ void buildFullReport(FullReportMsg& report) {
     memset(&report, 0, sizeof(report));
 
     // Environmental sensors - use real sensor values
-    report.temperatureF_x10 = (int16_t)(sensor_tempF * 10.0f);
-    report.humidity_x10 = (uint16_t)(sensor_humidity * 10.0f);
-    report.pressure_hPa = (uint16_t)sensor_pressure_hPa;
-    report.altitude_m = (int16_t)sensor_altitude_m;
+    report.temperatureF_x10 = sensor_tempF_x10;
+    report.humidity_x10 = sensor_humidity_x10;
+    report.pressure_hPa = sensor_pressure_hPa;
+    report.altitude_m = sensor_altitude_m;
     
     // GPS data
     if (g_location_valid) {
         report.latitude_x1e6 = (int32_t)(g_latitude * 1000000.0);
         report.longitude_x1e6 = (int32_t)(g_longitude * 1000000.0);
         report.gps_altitude_m = (int16_t)getGPSAltitude();
-        report.satellites = gps.satellites.isValid() ? gps.satellites.value() : 0;
-        report.hdop_x10 = gps.hdop.isValid() ? (uint8_t)(gps.hdop.hdop() * 10) : 255;
+        report.satellites = getGPSSatellites();
+        report.hdop_x10 = isHdopValid() ? (uint8_t)(getGPSHdop() * 10) : 255;
         report.flags |= FLAG_GPS_VALID;
     } else {
         report.latitude_x1e6 = 0;
@@ -248,6 +265,9 @@ bool transmit() {
     // Build the FULL_REPORT
     FullReportMsg report;
     buildFullReport(report);
+
+    // Anycast: address the lowest-cost gateway (broadcast when no route)
+    report.meshHeader.destId = getAnycastGateway();
     
     NodeMessage* selfNode = getNodeMessage(DEVICE_ID);
     if (selfNode != nullptr) {
@@ -255,6 +275,7 @@ bool transmit() {
         selfNode->hasData = true;
         selfNode->lastHeardTime = millis();
         selfNode->messageCount++;  // <-- ADD THIS
+        publishNode(DEVICE_ID);
     }
 
     // Encode to binary
@@ -307,7 +328,8 @@ bool transmit() {
 
 void transmitQueuedForwards(uint8_t slotEndSecond) {
     // Calculate how much time remains in our slot
-    uint8_t currentSecond = g_second;
+    // (scheduler time: GPS or network, still advancing while we block here)
+    uint8_t currentSecond = tdmaScheduler.getCurrentSecond();
 
     // If we're past our slot end, don't transmit
     if (currentSecond >= slotEndSecond) {
@@ -322,12 +344,11 @@ void transmitQueuedForwards(uint8_t slotEndSecond) {
                  currentSecond, safeEndSecond, transmitQueue.depth());
 
     // Transmit queued forwards while time and messages remain
-    uint8_t forwardsSent = 0;
-    const uint8_t MAX_FORWARDS_PER_SLOT = 5;  // Safety limit
+    uint8_t forwardsSent = 0;  // Safety limit: MAX_FORWARDS_PER_SLOT (transmit_queue.h)
 
     while (transmitQueue.depth() > 0 && forwardsSent < MAX_FORWARDS_PER_SLOT) {
         // Check if we still have time
-        currentSecond = g_second;
+        currentSecond = tdmaScheduler.getCurrentSecond();
         if (currentSecond >= safeEndSecond) {
             Serial.println(F("⏱️ Slot time ending - stopping forwards"));
             break;
@@ -350,6 +371,9 @@ void transmitQueuedForwards(uint8_t slotEndSecond) {
         Serial.print(msg->length);
         Serial.println(F(" bytes"));
 
+        // Load test frames carry their accumulated queueing latency
+        loadGenStampResidence(msg->data, msg->length, millis() - msg->queuedAtMs);
+
         bool success = sendBinaryMessage(msg->data, msg->length);
 
         if (success) {
@@ -394,7 +418,8 @@ void sendGatewayBeacon() {
     BeaconMsg beacon;
     beacon.distanceToGateway = 0;  // Gateway is distance 0
     beacon.gatewayId = DEVICE_ID;
-    beacon.sequenceNumber = (uint16_t)(millis() / 1000);  // Use uptime as sequence
+    beacon.sequenceNumber = gatewayBeaconSeq++;
+    beacon.epoch = getWarmStartStatus().bootCount;  // Boot count: newer than any earlier boot's beacons
 
     // ─────────────────────────────────────────────────────────────────────────
     // Include GPS time for network time synchronization
@@ -413,8 +438,17 @@ void sendGatewayBeacon() {
         beacon.gpsValid = 0;
     }
 
-    // Encode to buffer (now 16 bytes with time sync)
-    uint8_t buffer[20];
+    // Clock correction for the node drifting furthest off its TX second
+    uint8_t correctionNodeId = 0;
+    int16_t correctionMs = 0;
+    if (beacon.gpsValid) {
+        slotMonitor.takeCorrection(correctionNodeId, correctionMs);
+    }
+    beacon.correctionNodeId = correctionNodeId;
+    beacon.correctionMs = correctionMs;
+
+    // Encode to buffer (21 bytes with time sync, epoch and slot correction)
+    uint8_t buffer[sizeof(BeaconMsg)];
     uint8_t length = encodeBeacon(buffer, beacon);
 
     // Send beacon
@@ -426,6 +460,8 @@ void sendGatewayBeacon() {
         Serial.println(F("║           GATEWAY BEACON TRANSMITTED                      ║"));
         Serial.println(F("╚═══════════════════════════════════════════════════════════╝"));
         Serial.print(F("  Distance: 0 (gateway)"));
+        Serial.print(F("  |  Epoch: "));
+        Serial.print(beacon.epoch);
         Serial.print(F("  |  Seq: "));
         Serial.print(beacon.sequenceNumber);
         Serial.print(F("  |  Size: "));
@@ -442,6 +478,10 @@ void sendGatewayBeacon() {
             Serial.print(beacon.gpsSecond);
             Serial.println(F(" (GPS)"));
         }
+        if (beacon.correctionNodeId != 0) {
+            Serial.printf("  Slot correction: Node %u %+d ms\n",
+                          beacon.correctionNodeId, beacon.correctionMs);
+        }
         Serial.println(F("─────────────────────────────────────────────────────────────"));
     } else {
         Serial.println(F("⚠️ Gateway beacon transmission FAILED"));
@@ -458,7 +498,7 @@ void sendPendingBeacon() {
     BeaconMsg beacon;
     if (getPendingBeacon(beacon)) {
         // Encode to buffer
-        uint8_t buffer[16];
+        uint8_t buffer[sizeof(BeaconMsg)];
         uint8_t length = encodeBeacon(buffer, beacon);
 
         // Send beacon
@@ -495,6 +535,68 @@ void sendPendingBeacon() {
     }
 }
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         METRIC GAUGES                                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Gauges are read from their owners when metrics are enumerated
+static void bindMetricGauges() {
+    metricBind(MET_UPTIME_SEC, []() -> uint32_t { return millis() / 1000; });
+    metricBind(MET_FREE_HEAP, []() -> uint32_t { return ESP.getFreeHeap(); });
+    metricBind(MET_MIN_FREE_HEAP, []() -> uint32_t { return ESP.getMinFreeHeap(); });
+    metricBind(MET_TX_QUEUE_DEPTH, []() -> uint32_t { return transmitQueue.depth(); });
+    metricBind(MET_NEIGHBORS, []() -> uint32_t { return neighborTable.getActiveCount(); });
+    metricBind(MET_LIVE_NODES, []() -> uint32_t { return getNodeCount(); });
+    metricBind(MET_GATEWAY_DISTANCE, []() -> uint32_t {
+        RoutingState route = getRoutingState();
+        return route.routeValid ? route.distanceToGateway : DISTANCE_UNKNOWN;
+    });
+    metricBind(MET_LOOP_STALLS, []() -> uint32_t { return loopWatchdog.getStats().overruns; });
+    metricBind(MET_CHANNEL_BUSY_PCT, []() -> uint32_t { return channelMonitor.getBusyPercent(); });
+    metricBind(MET_SLOT_FLAGGED_NODES, []() -> uint32_t { return slotMonitor.getFlaggedCount(); });
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BOOT SERVICES TASK                                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Slow peripherals that the mesh does not need to start listening.
+// The gateway's WiFi bring-up alone (scan + up to 40 connect attempts) takes
+// many seconds, so it runs here while loop() already services the radio.
+static void startBootServices() {
+    bootServiceStarting(BOOT_SVC_DISPLAY);
+    bootServiceDone(BOOT_SVC_DISPLAY, initDisplay());
+
+    if (!MESH_WITH_UPLINK || !IS_GATEWAY) {
+        bootServiceSkip(BOOT_SVC_WIFI);
+        bootServiceSkip(BOOT_SVC_THINGSPEAK);
+        return;
+    }
+
+#if MESH_WITH_UPLINK
+
+    // Use lightweight dashboard for AP mode, full dashboard for Station mode
+    bootServiceStarting(BOOT_SVC_WIFI);
+    bool wifiOk = WIFI_USE_STATION_MODE ? initWebDashboard() : initWebDashboardLite();
+    bootServiceDone(BOOT_SVC_WIFI, wifiOk);
+    if (wifiOk) {
+        Serial.print(F("[BOOT] Dashboard IP: "));
+        Serial.println(getGatewayIP());
+    }
+
+    // Reports received before this point are handled like a WiFi outage
+    bootServiceStarting(BOOT_SVC_THINGSPEAK);
+    initUplink();
+    bootServiceDone(BOOT_SVC_THINGSPEAK, getUplinkBackend() != UPLINK_OFF && WiFi.status() == WL_CONNECTED);
+#endif
+}
+
+static void bootServicesTask(void* param) {
+    (void)param;
+    startBootServices();
+    vTaskDelete(nullptr);
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         SETUP                                             ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -507,9 +609,17 @@ void setup() {
     printStartupBanner();
     printHeader("SYSTEM INITIALIZATION");
 
+    // Read reset reason and the RTC snapshot before anything else runs
+    bootPhaseBegin("Core modules");
+    initWarmStart();
+    printRow("Boot", "#" + String(getWarmStartStatus().bootCount));
+
     // Initialize node store
     initNodeStore();
-    printRow("Node Store", "OK (" + String(MESH_MAX_NODES) + " slots)");
+#if MESH_WITH_UPLINK
+    initJsonCache();
+#endif
+    printRow("Node Store", "OK (" + String(NODE_TABLE_SIZE) + " slots)");
 
     // Initialize packet handler
     initPacketHandler();
@@ -517,33 +627,82 @@ void setup() {
 
     // Initialize mesh statistics
     initMeshStats();
+    bindMetricGauges();
     printRow("Mesh Statistics", "OK");
 
     // Initialize memory monitor
     initMemoryMonitor();
     printRow("Memory Monitor", "OK");
 
+    // Initialize traffic generator (idle until 'mesh load start')
+    initTrafficGenerator();
+    printRow("Traffic Generator", "OK (idle)");
+
     // Initialize gradient routing
     initGradientRouting();
     printRow("Gradient Routing", IS_GATEWAY ? "OK (Gateway)" : "OK (Node)");
+    printRow("Build Role", BUILD_ROLE_NAME);   // Matches GATEWAY_NODE_IDS (static_assert in config.cpp)
+
+    // Initialize multi-gateway upload coordination
+    initGatewaySync();
+    printRow("Gateways", String(getConfiguredGatewayCount()) + " configured");
 
     // Initialize network time sync (for nodes without GPS)
     initNetworkTime();
     printRow("Network Time Sync", "OK (fallback enabled)");
 
-    // Initialize display
-    if (initDisplay()) {
-        printRow("OLED Display", "OK");
+    // Restore routes, neighbors, time and messageId saved before the reset
+    applyWarmStart();
+    const WarmStartStatus& warm = getWarmStartStatus();
+    if (warm.snapshotValid && warm.elapsedKnown) {
+        printRow("Warm Start", String(warm.routesRestored) + " routes, " +
+                 String(warm.neighborsRestored) + " nbrs" +
+                 (warm.timeRestored ? ", time" : ""));
+    } else {
+        printRow("Warm Start", warm.seqFromNvs ? "Cold (msgId skipped ahead)" : "Cold");
+    }
+
+    // Initialize LoRa first so the node is listening as early as possible
+    bootPhaseBegin("LoRa radio");
+    if (initLoRa()) {
+        printRow("LoRa Radio", "OK");
+        setLoRaReceiveMode();
+        bootMarkRadioListening();
+    } else {
+        printRow("LoRa Radio", "FAILED");
+    }
+
+    // Initialize TDMA Scheduler
+    tdmaScheduler.setDepthOrdering(USE_DEPTH_ORDERED_SLOTS);
+    tdmaScheduler.setBeaconSubframe(USE_BEACON_SUBFRAME);
+    tdmaScheduler.init(DEVICE_ID);
+    printRow("TDMA Scheduler", "OK");
+    printRow("  Slot Start", String(tdmaScheduler.getSlotStart()) + "s");
+    printRow("  Slot End", String(tdmaScheduler.getSlotEnd()) + "s");
+
+    // Display, WiFi/dashboard and the cloud uplink come up in the background
+    bootPhaseBegin("Start async tasks");
+    resetDisplayState();
+    if (xTaskCreatePinnedToCore(bootServicesTask, "bootServices", BOOT_SERVICES_STACK_SIZE,
+                                nullptr, 1, nullptr, 0) == pdPASS) {
+        printRow("OLED Display", "Starting (async)");
+        if (IS_GATEWAY) {
+            printRow("WiFi/Dashboard", "Starting (async)");
+            printRow("Cloud Uplink", "After WiFi (async)");
+        }
     } else {
-        printRow("OLED Display", "FAILED");
+        printRow("Boot Services Task", "FAILED - starting inline");
+        startBootServices();
     }
 
     // Initialize GPS
-    Serial2.begin(9600, SERIAL_8N1, 46, -1);
+    bootPhaseBegin("GPS");
+    Serial2.begin(GPS_BAUD, SERIAL_8N1, GPS_RX_PIN, GPS_UBX_MODE ? GPS_TX_PIN : -1);
     initGPS();
-    printRow("GPS Module", "OK - Waiting for fix");
+    printRow("GPS Module", GPS_UBX_MODE ? "OK - Configuring UBX" : "OK - Waiting for fix");
 
     // Initialize sensor I2C bus and sensors
+    bootPhaseBegin("Sensors");
     printDivider();
     printRow("Sensor I2C Bus", "GPIO" + String(SENSOR_I2C_SDA) + "/GPIO" + String(SENSOR_I2C_SCL));
     SensorWire.begin(SENSOR_I2C_SDA, SENSOR_I2C_SCL);
@@ -555,8 +714,8 @@ void setup() {
             printRow("SHT30 (Temp/Hum)", "OK @ 0x44");
             // Initial read
             if (sht30.read()) {
-                sensor_tempF = sht30.getTemperature() * 1.8f + 32.0f;
-                sensor_humidity = sht30.getHumidity();
+                sensor_tempF_x10 = sht30.getTemperatureF_x10();
+                sensor_humidity_x10 = sht30.getHumidity_x10();
             }
         } else {
             printRow("SHT30 (Temp/Hum)", "NOT FOUND");
@@ -571,10 +730,9 @@ void setup() {
         if (bmp180_ok) {
             printRow("BMP180 (Press/Alt)", "OK @ 0x77");
             // Initial read (uses standard pressure until GPS calibration)
-            float pressure_pa = bmp180.readPressure();
-            if (pressure_pa > 0) {
-                sensor_pressure_hPa = pressure_pa / 100.0f;
-                sensor_altitude_m = bmp180.readAltitude(calibrated_sea_level_pa);
+            if (bmp180.read()) {
+                sensor_pressure_hPa = pressureToHpa(bmp180.getPressurePa());
+                sensor_altitude_m = baroAltitudeM(bmp180.getPressurePa(), calibrated_sea_level_pa);
             }
         } else {
             printRow("BMP180 (Press/Alt)", "NOT FOUND");
@@ -582,52 +740,22 @@ void setup() {
     } else {
         printRow("BMP180 (Press/Alt)", "Disabled");
     }
-
-    // Initialize LoRa
-    if (initLoRa()) {
-        printRow("LoRa Radio", "OK");
-        setLoRaReceiveMode();
-    } else {
-        printRow("LoRa Radio", "FAILED");
-    }
-
-    // Initialize TDMA Scheduler
-    tdmaScheduler.init(DEVICE_ID);
-    printRow("TDMA Scheduler", "OK");
-    if (IS_GATEWAY) {
-        initThingSpeak();
-        printRow("ThingSpeak", THINGSPEAK_ENABLED ? "Enabled" : "Disabled");
-    }
-    printRow("  Slot Start", String(tdmaScheduler.getSlotStart()) + "s");
-    printRow("  Slot End", String(tdmaScheduler.getSlotEnd()) + "s");
+    bootPhaseEnd();
 
     printDivider();
     printRow("Device ID", String(DEVICE_ID));
     printRow("Device Name", String(DEVICE_NAME));
     printRow("Node Timeout", String(NODE_TIMEOUT_MS / 1000) + "s");
     printRow("Message Type", "FULL_REPORT (32 bytes)");
-    
-        // Initialize Web Dashboard (gateway only)
-    if (IS_GATEWAY) {
-        printDivider();
-        // Use lightweight dashboard for AP mode, full dashboard for Station mode
-        if (!WIFI_USE_STATION_MODE) {
-            if (initWebDashboardLite()) {
-                printRow("WiFi Mode", "Access Point (Lite)");
-                printRow("Dashboard IP", getGatewayIP());
-            } else {
-                printRow("WiFi AP", "FAILED");
-            }
-        } else {
-            if (initWebDashboard()) {
-                printRow("WiFi Mode", "Station (Full)");
-                printRow("Dashboard IP", getGatewayIP());
-            } else {
-                printRow("WiFi", "FAILED");
-            }
-        }
+
+    // Boot phase timings ('mesh boot' shows async services and first RX)
+    printDivider();
+    const BootMetrics& boot = getBootMetrics();
+    for (uint8_t i = 0; i < boot.phaseCount; i++) {
+        printRow(boot.phases[i].name, String(boot.phases[i].durationMs) + " ms");
     }
-    
+    printRow("Radio Listening", "@" + String(boot.radioListeningMs) + " ms");
+
     printFooter();
 
 
@@ -648,6 +776,7 @@ void setup() {
     Serial.println(F("║  >> SYSTEM READY - Listening for transmissions...             ║"));
     Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
     Serial.println();
+    bootMarkSetupDone();
 
     // Memory check
     Serial.println();
@@ -706,23 +835,36 @@ void processSerialCommands() {
 
 void loop() {
     unsigned long now = millis();
+    loopWatchdog.startIteration();
 
     // ─────────────────────────────────────────────────────────────────────────
     // Serial Command Processing (for testing - e.g., SETTIME command)
     // ─────────────────────────────────────────────────────────────────────────
+    loopWatchdog.enterSection(LOOP_SEC_SERIAL);
     processSerialCommands();
 
     // ─────────────────────────────────────────────────────────────────────────
     // GPS Processing (High Priority)
     // ─────────────────────────────────────────────────────────────────────────
+    loopWatchdog.enterSection(LOOP_SEC_GPS);
     while (Serial2.available() > 0) {
         processGPSData();
     }
+    updateGPS();
 
     // Update TDMA scheduler with current time (GPS or network fallback)
+    loopWatchdog.enterSection(LOOP_SEC_TDMA);
     // Require at least 1 satellite for GPS time to be valid for TDMA
     // This prevents using stale cached GPS time when satellites are lost
-    bool gpsValidForTDMA = g_datetime_valid && gps.satellites.isValid() && gps.satellites.value() >= 1;
+    bool gpsValidForTDMA = g_datetime_valid && getGPSSatellites() >= 1;
+
+    // Depth-ordered slots follow our hop distance to the gateway
+    if (IS_GATEWAY) {
+        tdmaScheduler.setDepth(0);
+    } else {
+        RoutingState route = getRoutingState();
+        tdmaScheduler.setDepth(route.routeValid ? route.distanceToGateway : DISTANCE_UNKNOWN);
+    }
     TimeSource timeSource = tdmaScheduler.updateWithFallback(g_hour, g_minute, g_second, gpsValidForTDMA);
 
     // ─────────────────────────────────────────────────────────────────────────
@@ -732,8 +874,10 @@ void loop() {
 
     if (inSlot && !wasInSlot) {
         primaryTxThisSlot = 0;
+        slotAirtimeStartMs = metricGet(MET_TX_AIRTIME_MS);
         printSlotEntry();
     } else if (!inSlot && wasInSlot) {
+        metricObserve(HIST_SLOT_AIRTIME, metricGet(MET_TX_AIRTIME_MS) - slotAirtimeStartMs);
         printSlotExit(primaryTxThisSlot);
     }
     wasInSlot = inSlot;
@@ -743,12 +887,14 @@ void loop() {
     // ─────────────────────────────────────────────────────────────────────────
     
     // GPS Status
+    loopWatchdog.enterSection(LOOP_SEC_STATUS);
     if (now - lastGPSStatusPrint >= GPS_STATUS_INTERVAL_MS) {
         printGPSStatusLine();
         lastGPSStatusPrint = now;
     }
 
     // Sensor reading (if sensors enabled)
+    loopWatchdog.enterSection(LOOP_SEC_SENSORS);
     if ((SENSOR_SHT30_ENABLED || SENSOR_BMP180_ENABLED) &&
         (now - lastSensorRead >= SENSOR_READ_INTERVAL_MS)) {
         readSensors();
@@ -756,6 +902,7 @@ void loop() {
     }
 
     // Node timeout checks
+    loopWatchdog.enterSection(LOOP_SEC_STATUS);
     if (now - lastNodeCheck >= NODE_CHECK_INTERVAL_MS) {
         checkNodeTimeouts();
         lastNodeCheck = now;
@@ -781,21 +928,43 @@ void loop() {
     // ─────────────────────────────────────────────────────────────────────────
     // Gradient Routing - Beacon Broadcasting (only if enabled in config)
     // ─────────────────────────────────────────────────────────────────────────
+    loopWatchdog.enterSection(LOOP_SEC_BEACON);
 
     if (USE_GRADIENT_ROUTING) {
         // Gateway: Send periodic beacons
-        if (IS_GATEWAY && (now - lastBeaconSent >= BEACON_INTERVAL_MS)) {
+        // With GPS time, one per minute at the start of the beacon sub-frame
+        // (second 0); otherwise free-running every BEACON_INTERVAL_MS
+        if (IS_GATEWAY && USE_BEACON_SUBFRAME && g_datetime_valid) {
+            if (g_second == 0 && g_minute != lastBeaconMinute) {
+                sendGatewayBeacon();
+                lastBeaconSent = now;
+                lastBeaconMinute = g_minute;
+            }
+        } else if (IS_GATEWAY && (now - lastBeaconSent >= BEACON_INTERVAL_MS)) {
             sendGatewayBeacon();
             lastBeaconSent = now;
         }
 
         // Non-gateway nodes: Send pending beacon rebroadcasts
-        if (!IS_GATEWAY && hasPendingBeacon()) {
+        if (!IS_GATEWAY && ROLE_FORWARDS && hasPendingBeacon()) {
             sendPendingBeacon();
         }
     }
 
+    // Multi-gateway: upload reports no other gateway claimed in time
+    loopWatchdog.enterSection(LOOP_SEC_UPLINK);
+    if (IS_GATEWAY) {
+        gatewaySyncUpdate();
+#if MESH_WITH_UPLINK
+        uplinkUpdate();
+#endif
+    }
+
+    // Snapshot routes/neighbors/time to RTC memory for a fast rejoin after reset
+    warmStartUpdate();
+
     // Neighbor table and duplicate cache pruning
+    loopWatchdog.enterSection(LOOP_SEC_PRUNE);
     if (now - lastNeighborPrune >= NEIGHBOR_PRUNE_INTERVAL_MS) {
         // Prune expired neighbors
         uint8_t prunedNeighbors = neighborTable.pruneExpired(NEIGHBOR_TIMEOUT_MS);
@@ -836,19 +1005,25 @@ void loop() {
     // ─────────────────────────────────────────────────────────────────────────
     // Receive Processing
     // ─────────────────────────────────────────────────────────────────────────
+    loopWatchdog.enterSection(LOOP_SEC_RX);
     if (now - lastRxCheck >= RX_CHECK_INTERVAL_MS) {
         checkForIncomingMessages();
         lastRxCheck = now;
     }
 
+    // Noise floor / occupancy sampling while the radio idles in RX
+    channelMonitor.update();
+
     // ─────────────────────────────────────────────────────────────────────────
     // Serial Command Processing
     // ─────────────────────────────────────────────────────────────────────────
+    loopWatchdog.enterSection(LOOP_SEC_SERIAL);
     processMeshCommands();
 
     // ─────────────────────────────────────────────────────────────────────────
     // Transmission
     // ─────────────────────────────────────────────────────────────────────────
+    loopWatchdog.enterSection(LOOP_SEC_TX);
     if (tdmaScheduler.shouldTransmitNow()) {
         if (primaryTxThisSlot < 1) {
             totalTxAttempts++;
@@ -856,10 +1031,17 @@ void loop() {
             if (transmit()) {
                 successfulTx++;
                 primaryTxThisSlot++;
+                warmStartOnReportSent();
 
                 // Small delay after primary transmission
                 delay(100);
 
+                // Capacity testing: synthetic frames share the forward queue
+                loadGenOnSlot();
+
+                // Multi-gateway: announce reports we uploaded this slot
+                gatewaySyncOnSlot();
+
                 // Now transmit any queued forwards during remaining slot time
                 transmitQueuedForwards(tdmaScheduler.getSlotEnd());
             }
@@ -872,6 +1054,7 @@ void loop() {
     // ─────────────────────────────────────────────────────────────────────────
     
     // Check for display state timeout
+    loopWatchdog.enterSection(LOOP_SEC_DISPLAY);
     if (currentDisplay != DISPLAY_WAITING) {
         if (now - displayStateStart >= DISPLAY_TIME_MS) {
             setDisplayState(DISPLAY_WAITING);
@@ -884,12 +1067,18 @@ void loop() {
         lastDisplayUpdate = now;
     }
 
+#if MESH_WITH_UPLINK
     // Handle web dashboard (use lite version for AP mode)
+    loopWatchdog.enterSection(LOOP_SEC_WEB);
     if (!WIFI_USE_STATION_MODE) {
         handleWebDashboardLite();
     } else {
         handleWebDashboard();
     }
+#endif
+
+    // Stall accounting stops before the deliberate idle delay
+    loopWatchdog.endIteration();
 
     // Small delay to prevent tight loop
     delay(5);
@@ -7,6 +7,26 @@
 #include "mesh_protocol.h"
 #include "lora_comm.h"
 #include "memory_monitor.h"
+#include "traffic_generator.h"
+#include "serial_json.h"
+#include "reorder_buffer.h"
+#include "warm_start.h"
+#include "boot_metrics.h"
+#include "gateway_sync.h"
+#include "node_store.h"
+#include "mesh_schema.h"
+#include "loop_watchdog.h"
+#include "metrics.h"
+#include "fec.h"
+#include "sensor_math.h"
+#include "rate_limiter.h"
+#if MESH_WITH_UPLINK
+#include "json_cache.h"
+#include "uplink.h"
+#endif
+#include "channel_monitor.h"
+#include "slot_monitor.h"
+#include "neo6m.h"
 
 // External declarations for functions we need
 extern uint8_t encodeFullReport(uint8_t* buffer, const FullReportMsg& report);
@@ -77,6 +97,108 @@ void printMeshCommandHelp() {
     Serial.println(F("    └─ Display memory usage report"));
     Serial.println();
 
+    Serial.println(F("  mesh load start <rate> [minB] [maxB] [burst%] [burstX]"));
+    Serial.println(F("    └─ Generate synthetic frames (rate = frames per slot)"));
+    Serial.println(F("  mesh load ramp <from> <to> [slotsPerStep]"));
+    Serial.println(F("    └─ Step offered load up to find the saturation point"));
+    Serial.println(F("  mesh load stop | status | report | clear"));
+    Serial.println(F("    └─ Stop generator / show state / capacity report (gateway)"));
+    Serial.println();
+
+    Serial.println(F("  mesh gateways"));
+    Serial.println(F("    └─ Show gateway routes (anycast/failover) and upload dedupe"));
+    Serial.println();
+
+    Serial.println(F("  mesh reorder"));
+    Serial.println(F("    └─ Show gateway reorder window and per-path delivery stats"));
+    Serial.println();
+
+    Serial.println(F("  mesh warmstart"));
+    Serial.println(F("    └─ Show reset reason, restored state and time to first report"));
+    Serial.println();
+
+    Serial.println(F("  mesh latency"));
+    Serial.println(F("    └─ Show report age at the gateway by hop count"));
+    Serial.println();
+
+    Serial.println(F("  mesh boot"));
+    Serial.println(F("    └─ Show boot phase timings, async service readiness, first RX"));
+    Serial.println();
+
+    Serial.println(F("  mesh build"));
+    Serial.println(F("    └─ Show build role, linked subsystems, flash / RAM use, boot time"));
+    Serial.println();
+
+    Serial.println(F("  mesh radio"));
+    Serial.println(F("    └─ Show RX path: frames filtered by header, SPI and CPU time per frame"));
+    Serial.println();
+
+    Serial.println(F("  mesh nodes"));
+    Serial.println(F("    └─ Show node table: live nodes, evictions, memory per node"));
+    Serial.println();
+
+    Serial.println(F("  mesh stalls [clear|budget <ms>]"));
+    Serial.println(F("    └─ Show loop() overruns and which section was running"));
+    Serial.println();
+
+    Serial.println(F("  mesh channel [clear|json|cad <on|off>]"));
+    Serial.println(F("    └─ Noise floor trend and per-slot occupancy from idle RX sampling"));
+    Serial.println();
+
+    Serial.println(F("  mesh slots [clear|json]"));
+    Serial.println(F("    └─ Per-node TX timing error vs the TDMA schedule, out-of-slot frames"));
+    Serial.println();
+
+    Serial.println(F("  mesh ratelimit [clear|on|off|<class> <perMin> <burst>]"));
+    Serial.println(F("    └─ Per-node RX/forward budgets, drops, buckets over the limit"));
+    Serial.println();
+
+    Serial.println(F("  mesh gps"));
+    Serial.println(F("    └─ GPS receiver mode (NMEA/UBX, power save), UART bytes/s, parse time"));
+    Serial.println();
+
+    Serial.println(F("  mesh metrics [json|prom]"));
+    Serial.println(F("    └─ Dump counters, gauges and histograms (table, JSON line or Prometheus)"));
+    Serial.println();
+
+#if MESH_WITH_UPLINK
+    Serial.println(F("  mesh uplink [thingspeak|mqtt|off]"));
+    Serial.println(F("    └─ Show cloud uplink stats, or switch backend (saved across resets)"));
+    Serial.println();
+#endif
+
+    Serial.println(F("  mesh schema lua"));
+    Serial.println(F("    └─ Print a Wireshark Lua dissector generated from the message schema"));
+    Serial.println();
+
+#if MESH_WITH_UPLINK
+    Serial.println(F("  mesh bench json"));
+    Serial.println(F("    └─ Time dashboard JSON for 5 and 100 nodes, full vs cached fragments"));
+    Serial.println();
+#endif
+
+    Serial.println(F("  mesh bench snapshot"));
+    Serial.println(F("    └─ Stress node snapshots: readers on both cores check for torn views"));
+    Serial.println();
+
+#if MESH_WITH_UPLINK
+    Serial.println(F("  mesh bench uplink [reports]"));
+    Serial.println(F("    └─ Compare ThingSpeak GET vs batched MQTT against loopback stand-ins"));
+    Serial.println();
+#endif
+
+    Serial.println(F("  mesh bench codec"));
+    Serial.println(F("    └─ Time schema-generated vs hand-written codecs and JSON"));
+    Serial.println();
+
+    Serial.println(F("  mesh bench fec"));
+    Serial.println(F("    └─ Time FEC encode/decode, simulate ARQ vs FEC transfer time"));
+    Serial.println();
+
+    Serial.println(F("  mesh bench sensors"));
+    Serial.println(F("    └─ Cycles per sample, float vs fixed-point sensor math"));
+    Serial.println();
+
     Serial.println(F("  mesh help"));
     Serial.println(F("    └─ Show this help message"));
     Serial.println();
@@ -169,6 +291,22 @@ void printNeighborTable() {
     }
 
     Serial.println(F("└──────┴─────────┴─────────┴─────────┴──────────┴──────────┘"));
+
+    // Link loss from gaps in each neighbor's own report sequence
+    Serial.print(F("Link loss:"));
+    for (uint8_t i = 0; i < count; i++) {
+        float loss;
+        Serial.print(F("  "));
+        Serial.print(neighbors[i]->nodeId);
+        Serial.print('=');
+        if (neighborTable.getLinkLoss(neighbors[i]->nodeId, loss)) {
+            Serial.print(loss * 100.0f, 1);
+            Serial.print('%');
+        } else {
+            Serial.print('?');
+        }
+    }
+    Serial.println();
     Serial.println();
 }
 
@@ -329,6 +467,17 @@ void resetMeshSubsystems() {
     Serial.println(F("✅ Transmit queue cleared"));
     Serial.println();
 
+    Serial.println(F("Flushing reorder window..."));
+    reorderBuffer.flushAll();
+    reorderBuffer.clear();
+    Serial.println(F("✅ Reorder window cleared"));
+    Serial.println();
+
+    Serial.println(F("Clearing rate limiter buckets..."));
+    rateLimiter.clear();
+    Serial.println(F("✅ Rate limiter cleared"));
+    Serial.println();
+
     Serial.println(F("Resetting mesh statistics..."));
     resetMeshStats();
     Serial.println(F("✅ Statistics reset"));
@@ -339,6 +488,57 @@ void resetMeshSubsystems() {
     printSeparator();
 }
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         LOAD GENERATOR COMMANDS                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static void processLoadCommand(const String& args) {
+    int a = 0, b = 0, c = 0, d = 0, e = 0;
+
+    if (args.startsWith("start")) {
+        int n = sscanf(args.c_str() + 5, "%d %d %d %d %d", &a, &b, &c, &d, &e);
+        if (n < 1) {
+            Serial.println(F("Usage: mesh load start <rate> [minB] [maxB] [burst%] [burstX]"));
+            return;
+        }
+        LoadGenConfig config;
+        memset(&config, 0, sizeof(config));
+        config.framesPerSlot = a;
+        config.minBytes = (n >= 2) ? b : LOADGEN_HEADER_SIZE;
+        config.maxBytes = (n >= 3) ? c : config.minBytes;
+        config.burstPercent = (n >= 4) ? d : 0;
+        config.burstMultiplier = (n >= 5) ? e : 2;
+        startLoadGenerator(config);
+    } else if (args.startsWith("ramp")) {
+        int n = sscanf(args.c_str() + 4, "%d %d %d", &a, &b, &c);
+        if (n < 2 || b < a) {
+            Serial.println(F("Usage: mesh load ramp <from> <to> [slotsPerStep]"));
+            return;
+        }
+        LoadGenConfig config;
+        memset(&config, 0, sizeof(config));
+        config.framesPerSlot = a;
+        config.minBytes = LOADGEN_HEADER_SIZE;
+        config.maxBytes = MAX_MESSAGE_SIZE;
+        config.burstMultiplier = 1;
+        config.rampTo = b;
+        config.rampSlotsPerStep = (n >= 3) ? c : 3;
+        startLoadGenerator(config);
+    } else if (args == "stop") {
+        stopLoadGenerator();
+    } else if (args == "status") {
+        printLoadGenStatus();
+    } else if (args == "report") {
+        printLoadReport();
+        outputLoadReportJson();
+    } else if (args == "clear") {
+        clearLoadTestStats();
+        Serial.println(F("✅ Load test statistics cleared"));
+    } else {
+        Serial.println(F("Usage: mesh load start|ramp|stop|status|report|clear"));
+    }
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         COMMAND PROCESSOR                                 ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -406,6 +606,250 @@ void processMeshCommands() {
                         printMemoryReport();
                     }
 
+                    // ─────────────────────────────────────────────────────────
+                    // mesh gateways
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "gateways") {
+                        printGatewaySyncStatus();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh reorder
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "reorder") {
+                        reorderBuffer.printStatus();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh warmstart
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "warmstart") {
+                        printWarmStartStatus();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh boot
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "boot") {
+                        printBootMetrics();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh build
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "build") {
+                        printBuildInfo();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh latency
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "latency") {
+                        printReportAgeStats();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh radio
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "radio") {
+                        printRadioRxStats();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh nodes
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "nodes") {
+                        printNodeTable();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh stalls [clear|budget <ms>]
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("stalls")) {
+                        String stallArgs = subCmd.substring(6);
+                        stallArgs.trim();
+                        if (stallArgs.length() == 0) {
+                            loopWatchdog.printReport();
+                        } else if (stallArgs == "clear") {
+                            loopWatchdog.clear();
+                            Serial.println(F("Loop stall history cleared"));
+                        } else if (stallArgs.startsWith("budget") && stallArgs.substring(6).toInt() > 0) {
+                            loopWatchdog.setBudgetMs(stallArgs.substring(6).toInt());
+                            Serial.print(F("Loop budget: "));
+                            Serial.print(loopWatchdog.getBudgetMs());
+                            Serial.println(F(" ms"));
+                        } else {
+                            Serial.println(F("Usage: mesh stalls [clear|budget <ms>]"));
+                        }
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh channel [clear|json|cad <on|off>]
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("channel")) {
+                        String channelArgs = subCmd.substring(7);
+                        channelArgs.trim();
+                        if (channelArgs.length() == 0) {
+                            channelMonitor.printReport();
+                        } else if (channelArgs == "clear") {
+                            channelMonitor.clear();
+                            Serial.println(F("Channel samples cleared"));
+                        } else if (channelArgs == "json") {
+                            channelMonitor.printJson(Serial);
+                            Serial.println();
+                        } else if (channelArgs == "cad on" || channelArgs == "cad off") {
+                            channelMonitor.setCadEnabled(channelArgs == "cad on");
+                            Serial.print(F("CAD sampling "));
+                            Serial.println(channelMonitor.isCadEnabled() ? F("on") : F("off"));
+                        } else {
+                            Serial.println(F("Usage: mesh channel [clear|json|cad <on|off>]"));
+                        }
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh slots [clear|json]
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("slots")) {
+                        String slotArgs = subCmd.substring(5);
+                        slotArgs.trim();
+                        if (slotArgs.length() == 0) {
+                            slotMonitor.printReport();
+                        } else if (slotArgs == "clear") {
+                            slotMonitor.clear();
+                            Serial.println(F("Slot timing cleared"));
+                        } else if (slotArgs == "json") {
+                            slotMonitor.printJson(Serial);
+                            Serial.println();
+                        } else {
+                            Serial.println(F("Usage: mesh slots [clear|json]"));
+                        }
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh ratelimit [clear|on|off|<class> <perMin> <burst>]
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("ratelimit")) {
+                        String rateArgs = subCmd.substring(9);
+                        rateArgs.trim();
+                        int firstSpace = rateArgs.indexOf(' ');
+                        int secondSpace = firstSpace < 0 ? -1 : rateArgs.indexOf(' ', firstSpace + 1);
+                        RateClass rateClass;
+
+                        if (rateArgs.length() == 0) {
+                            rateLimiter.printStatus();
+                        } else if (rateArgs == "clear") {
+                            rateLimiter.clear();
+                            Serial.println(F("Rate limiter buckets cleared"));
+                        } else if (rateArgs == "on" || rateArgs == "off") {
+                            rateLimiter.setEnabled(rateArgs == "on");
+                            Serial.print(F("Rate limiting "));
+                            Serial.println(rateLimiter.isEnabled() ? F("on") : F("off"));
+                        } else if (secondSpace > 0 && parseRateClass(rateArgs.substring(0, firstSpace), rateClass)) {
+                            long perMinute = rateArgs.substring(firstSpace + 1, secondSpace).toInt();
+                            long burst = rateArgs.substring(secondSpace + 1).toInt();
+                            rateLimiter.setLimit(rateClass, (uint16_t)constrain(perMinute, 0L, 6000L),
+                                                 (uint8_t)constrain(burst, 0L, 60L));
+                            RateLimit limit = rateLimiter.getLimit(rateClass);
+                            Serial.printf("Rate limit %s: %u/min, burst %u%s\n", getRateClassName(rateClass),
+                                          limit.perMinute, limit.burst, limit.perMinute == 0 ? " (unlimited)" : "");
+                        } else {
+                            Serial.println(F("Usage: mesh ratelimit [clear|on|off|<class> <perMin> <burst>]"));
+                            Serial.println(F("       class: report, beacon, claim, load, other, forward"));
+                        }
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh gps
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd == "gps") {
+                        printGPSStatus();
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh metrics [json|prom]
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("metrics")) {
+                        String metricArgs = subCmd.substring(7);
+                        metricArgs.trim();
+                        if (metricArgs.length() == 0) {
+                            printMetrics(Serial);
+                        } else if (metricArgs == "json") {
+                            printMetricsJson(Serial);
+                        } else if (metricArgs == "prom") {
+                            printMetricsPrometheus(Serial);
+                        } else {
+                            Serial.println(F("Usage: mesh metrics [json|prom]"));
+                        }
+                    }
+
+#if MESH_WITH_UPLINK
+                    // ─────────────────────────────────────────────────────────
+                    // mesh uplink [thingspeak|mqtt|off]
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("uplink")) {
+                        String uplinkArgs = subCmd.substring(6);
+                        uplinkArgs.trim();
+                        UplinkBackend backend;
+                        if (uplinkArgs.length() == 0) {
+                            printUplinkStatus();
+                        } else if (parseUplinkBackend(uplinkArgs, backend)) {
+                            setUplinkBackend(backend);
+                            Serial.print(F("Uplink backend: "));
+                            Serial.println(getUplinkBackendName(backend));
+                        } else {
+                            Serial.println(F("Usage: mesh uplink [thingspeak|mqtt|off]"));
+                        }
+                    }
+#endif
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh schema lua
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("schema")) {
+                        String schemaArgs = subCmd.substring(6);
+                        schemaArgs.trim();
+                        if (schemaArgs == "lua") {
+                            printLuaDissector(Serial);
+                        } else {
+                            Serial.println(F("Usage: mesh schema lua"));
+                        }
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh bench <json|snapshot|uplink|codec|fec|sensors>
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("bench")) {
+                        String benchArgs = subCmd.substring(5);
+                        benchArgs.trim();
+#if MESH_WITH_UPLINK
+                        if (benchArgs == "json") {
+                            runJsonBenchmark();
+                        } else if (benchArgs.startsWith("uplink")) {
+                            runUplinkBenchmark(benchArgs.substring(6).toInt());
+                        } else
+#endif
+                        if (benchArgs == "snapshot") {
+                            runSnapshotStressTest();
+                        } else if (benchArgs == "codec") {
+                            runCodecBenchmark();
+                        } else if (benchArgs == "fec") {
+                            runFecBenchmark();
+                        } else if (benchArgs == "sensors") {
+                            runSensorMathBenchmark();
+                        } else {
+                            Serial.println(F("Usage: mesh bench <json|snapshot|uplink|codec|fec|sensors>"));
+                        }
+                    }
+
+                    // ─────────────────────────────────────────────────────────
+                    // mesh load <start|ramp|stop|status|report|clear> ...
+                    // ─────────────────────────────────────────────────────────
+                    else if (subCmd.startsWith("load")) {
+                        String loadArgs = subCmd.substring(4);
+                        loadArgs.trim();
+                        processLoadCommand(loadArgs);
+                    }
+
                     // ─────────────────────────────────────────────────────────
                     // mesh test [destId] [ttl] [message]
                     // ─────────────────────────────────────────────────────────
@@ -0,0 +1,440 @@
+#include "mesh_schema.h"
+#include <type_traits>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FIELD ACCESS                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Fixed-size loops over sizeof(T) unroll into plain byte stores/loads, and
+// offsets are compile-time constants, so the codecs have no branches.
+
+template<typename T>
+static inline void storeLE(uint8_t* p, T value) {
+    typedef typename std::make_unsigned<T>::type U;
+    U bits = (U)value;
+    for (uint8_t i = 0; i < sizeof(T); i++) p[i] = (uint8_t)(bits >> (8 * i));
+}
+
+template<typename T>
+static inline T loadLE(const uint8_t* p) {
+    typedef typename std::make_unsigned<T>::type U;
+    U bits = 0;
+    for (uint8_t i = 0; i < sizeof(T); i++) bits |= (U)((U)p[i] << (8 * i));
+    return (T)bits;
+}
+
+#define SCHEMA_STORE_HEADER(type, field, key, format) \
+    storeLE<type>(buffer + offset, msg.meshHeader.field); offset += sizeof(type);
+#define SCHEMA_STORE(type, field, key, format) \
+    storeLE<type>(buffer + offset, msg.field); offset += sizeof(type);
+#define SCHEMA_LOAD_HEADER(type, field, key, format) \
+    msg.meshHeader.field = loadLE<type>(buffer + offset); offset += sizeof(type);
+#define SCHEMA_LOAD(type, field, key, format) \
+    msg.field = loadLE<type>(buffer + offset); offset += sizeof(type);
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GENERATED CODECS                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+uint8_t schemaEncodeFullReport(uint8_t* buffer, const FullReportMsg& msg) {
+    uint8_t offset = 0;
+    MESH_HEADER_SCHEMA(SCHEMA_STORE_HEADER)
+    FULL_REPORT_SCHEMA(SCHEMA_STORE)
+    return offset;
+}
+
+bool schemaDecodeFullReport(const uint8_t* buffer, uint8_t length, FullReportMsg& msg) {
+    if (length < FULL_REPORT_WIRE_SIZE) return false;
+    uint8_t offset = 0;
+    MESH_HEADER_SCHEMA(SCHEMA_LOAD_HEADER)
+    FULL_REPORT_SCHEMA(SCHEMA_LOAD)
+    return true;
+}
+
+uint8_t schemaEncodeBeacon(uint8_t* buffer, const BeaconMsg& msg) {
+    uint8_t offset = 0;
+    MESH_HEADER_SCHEMA(SCHEMA_STORE_HEADER)
+    BEACON_SCHEMA(SCHEMA_STORE)
+    return offset;
+}
+
+bool schemaDecodeBeacon(const uint8_t* buffer, uint8_t length, BeaconMsg& msg) {
+    if (length < BEACON_WIRE_SIZE) return false;
+    uint8_t offset = 0;
+    MESH_HEADER_SCHEMA(SCHEMA_LOAD_HEADER)
+    BEACON_SCHEMA(SCHEMA_LOAD)
+    return true;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GENERATED JSON                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static inline char* putLiteral(char* p, const char* text, uint8_t length) {
+    memcpy(p, text, length);
+    return p + length;
+}
+
+static inline char* putUnsigned(char* p, uint32_t value) {
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) *p++ = digits[--count];
+    return p;
+}
+
+template<typename T>
+static inline char* putInt(char* p, T value) {
+    uint32_t magnitude = (uint32_t)value;
+    if (std::is_signed<T>::value && (int32_t)value < 0) {
+        *p++ = '-';
+        magnitude = 0u - magnitude;
+    }
+    return putUnsigned(p, magnitude);
+}
+
+// Same text as printf("%.<decimals>f", value / scale) for these integer fields
+template<typename T>
+static inline char* putFixed(char* p, T value, uint8_t decimals, uint32_t scale) {
+    uint32_t magnitude = (uint32_t)value;
+    if (std::is_signed<T>::value && (int32_t)value < 0) {
+        *p++ = '-';
+        magnitude = 0u - magnitude;
+    }
+    p = putUnsigned(p, magnitude / scale);
+    *p++ = '.';
+    uint32_t fraction = magnitude % scale;
+    for (int8_t i = decimals - 1; i >= 0; i--) {
+        p[i] = '0' + fraction % 10;
+        fraction /= 10;
+    }
+    return p + decimals;
+}
+
+#define SCHEMA_JSON_KEY(p, key)             p = putLiteral(p, ",\"" key "\":", sizeof(",\"" key "\":") - 1)
+#define SCHEMA_JSON_NONE(p, key, value)
+#define SCHEMA_JSON_INT(p, key, value)      SCHEMA_JSON_KEY(p, key); p = putInt(p, value);
+#define SCHEMA_JSON_X10(p, key, value)      SCHEMA_JSON_KEY(p, key); p = putFixed(p, value, 1, 10);
+#define SCHEMA_JSON_X1E6(p, key, value)     SCHEMA_JSON_KEY(p, key); p = putFixed(p, value, 6, 1000000);
+#define SCHEMA_JSON_HEADER(type, field, key, format) SCHEMA_JSON_##format(p, key, msg.meshHeader.field)
+#define SCHEMA_JSON(type, field, key, format)        SCHEMA_JSON_##format(p, key, msg.field)
+
+uint16_t schemaReportJson(char* out, const FullReportMsg& msg) {
+    char* p = out;
+    MESH_HEADER_SCHEMA(SCHEMA_JSON_HEADER)
+    FULL_REPORT_SCHEMA(SCHEMA_JSON)
+    *p = '\0';
+    return (uint16_t)(p - out);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         LUA DISSECTOR                                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static const struct {
+    uint8_t     type;
+    const char* name;
+} MESSAGE_NAMES[] = {
+    { MSG_FULL_REPORT,  "FULL_REPORT" },
+    { MSG_ROUTED_DATA,  "ROUTED_DATA" },
+    { MSG_ACK,          "ACK" },
+    { MSG_BEACON,       "BEACON" },
+    { MSG_LOAD_TEST,    "LOAD_TEST" },
+    { MSG_UPLINK_CLAIM, "UPLINK_CLAIM" },
+};
+
+/**
+ * f.<group>_<field> = ProtoField.<type>("cecs490mesh.<group>.<field>", ...)
+ * type is the C type name without "_t" (uint16_t -> uint16)
+ */
+static void luaDeclare(Print& out, const char* group, const char* cType, const char* field) {
+    char luaType[8];
+    size_t length = strlen(cType) - 2;
+    memcpy(luaType, cType, length);
+    luaType[length] = '\0';
+    out.printf("f.%s_%s = ProtoField.%s(\"cecs490mesh.%s.%s\", \"%s\", base.DEC)\n",
+               group, field, luaType, group, field, field);
+}
+
+static void luaAdd(Print& out, const char* group, const char* field, const char* tree,
+                   uint8_t offset, uint8_t size, bool littleEndian) {
+    // Beacons from older firmware are shorter - only add fields that are present
+    out.printf("%sif buf:len() >= %u then %s:%s(f.%s_%s, buf(%u, %u)) end\n",
+               strcmp(tree, "body") == 0 ? "        " : "    ",
+               offset + size, tree, littleEndian ? "add_le" : "add", group, field, offset, size);
+}
+
+#define LUA_DECLARE(type, field, key, format)   luaDeclare(out, group, #type, #field);
+#define LUA_ADD(type, field, key, format) \
+    luaAdd(out, group, #field, tree, offset, sizeof(type), littleEndian); offset += sizeof(type);
+
+void printLuaDissector(Print& out) {
+    const char* group;
+    const char* tree;
+    uint8_t offset;
+    bool littleEndian;
+
+    out.println(F("-- CECS490 LoRa mesh dissector, generated by \"mesh schema lua\""));
+    out.println(F("-- from include/mesh_schema.h - regenerate instead of editing."));
+    out.println(F("-- Frames: LoRa header + mesh payload, pcap link type USER0 (147)."));
+    out.println(F("local mesh = Proto(\"cecs490mesh\", \"CECS490 LoRa Mesh\")"));
+    out.println(F("local f = mesh.fields"));
+
+    group = "lora";   LORA_HEADER_SCHEMA(LUA_DECLARE)
+    group = "hdr";    MESH_HEADER_SCHEMA(LUA_DECLARE)
+    group = "report"; FULL_REPORT_SCHEMA(LUA_DECLARE)
+    group = "beacon"; BEACON_SCHEMA(LUA_DECLARE)
+
+    out.print(F("local MSG_TYPES = {"));
+    for (uint8_t i = 0; i < sizeof(MESSAGE_NAMES) / sizeof(MESSAGE_NAMES[0]); i++) {
+        out.printf(" [%u] = \"%s\",", MESSAGE_NAMES[i].type, MESSAGE_NAMES[i].name);
+    }
+    out.println(F(" }"));
+    out.println();
+
+    out.println(F("function mesh.dissector(buf, pinfo, tree)"));
+    out.printf("    if buf:len() < %u then return 0 end\n", LORA_HEADER_WIRE_SIZE + MESH_HEADER_WIRE_SIZE);
+    out.println(F("    pinfo.cols.protocol = \"MESH\""));
+    out.println(F("    local root = tree:add(mesh, buf())"));
+
+    out.printf("    local lora = root:add(mesh, buf(0, %u), \"LoRa header\")\n", LORA_HEADER_WIRE_SIZE);
+    group = "lora"; tree = "lora"; offset = 0; littleEndian = false;
+    LORA_HEADER_SCHEMA(LUA_ADD)
+
+    out.printf("    local header = root:add(mesh, buf(%u, %u), \"MeshHeader\")\n",
+               LORA_HEADER_WIRE_SIZE, MESH_HEADER_WIRE_SIZE);
+    group = "hdr"; tree = "header"; littleEndian = true;
+    MESH_HEADER_SCHEMA(LUA_ADD)
+
+    uint8_t body = offset;
+    out.printf("    local msgType = buf(%u, 1):uint()\n", LORA_HEADER_WIRE_SIZE + 1);
+    out.printf("    pinfo.cols.info = (MSG_TYPES[msgType] or (\"type \" .. msgType)) .. \" from \" .. buf(%u, 1):uint()\n",
+               LORA_HEADER_WIRE_SIZE + 2);
+
+    out.printf("    if msgType == %u then\n", MSG_FULL_REPORT);
+    out.printf("        local body = root:add(mesh, buf(%u), \"FULL_REPORT\")\n", body);
+    group = "report"; tree = "body"; offset = body;
+    FULL_REPORT_SCHEMA(LUA_ADD)
+
+    out.printf("    elseif msgType == %u then\n", MSG_BEACON);
+    out.printf("        local body = root:add(mesh, buf(%u), \"BEACON\")\n", body);
+    group = "beacon"; offset = body;
+    BEACON_SCHEMA(LUA_ADD)
+
+    out.println(F("    end"));
+    out.println(F("    return buf:len()"));
+    out.println(F("end"));
+    out.println();
+    out.println(F("DissectorTable.get(\"wtap_encap\"):add(wtap.USER0, mesh)"));
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CODEC BENCHMARK                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// The hand-written codecs these replaced (lora_comm.cpp, json_cache.cpp),
+// kept here as the baseline. Header bytes come from the message like the
+// generated encoders, so both do the same work.
+
+static uint8_t handEncodeFullReport(uint8_t* buffer, const FullReportMsg& report) {
+    uint8_t idx = 0;
+    buffer[idx++] = report.meshHeader.version;
+    buffer[idx++] = report.meshHeader.messageType;
+    buffer[idx++] = report.meshHeader.sourceId;
+    buffer[idx++] = report.meshHeader.destId;
+    buffer[idx++] = report.meshHeader.senderId;
+    buffer[idx++] = report.meshHeader.messageId;
+    buffer[idx++] = report.meshHeader.ttl;
+    buffer[idx++] = report.meshHeader.flags;
+    buffer[idx++] = report.temperatureF_x10 & 0xFF;
+    buffer[idx++] = (report.temperatureF_x10 >> 8) & 0xFF;
+    buffer[idx++] = report.humidity_x10 & 0xFF;
+    buffer[idx++] = (report.humidity_x10 >> 8) & 0xFF;
+    buffer[idx++] = report.pressure_hPa & 0xFF;
+    buffer[idx++] = (report.pressure_hPa >> 8) & 0xFF;
+    buffer[idx++] = report.altitude_m & 0xFF;
+    buffer[idx++] = (report.altitude_m >> 8) & 0xFF;
+    buffer[idx++] = report.latitude_x1e6 & 0xFF;
+    buffer[idx++] = (report.latitude_x1e6 >> 8) & 0xFF;
+    buffer[idx++] = (report.latitude_x1e6 >> 16) & 0xFF;
+    buffer[idx++] = (report.latitude_x1e6 >> 24) & 0xFF;
+    buffer[idx++] = report.longitude_x1e6 & 0xFF;
+    buffer[idx++] = (report.longitude_x1e6 >> 8) & 0xFF;
+    buffer[idx++] = (report.longitude_x1e6 >> 16) & 0xFF;
+    buffer[idx++] = (report.longitude_x1e6 >> 24) & 0xFF;
+    buffer[idx++] = report.gps_altitude_m & 0xFF;
+    buffer[idx++] = (report.gps_altitude_m >> 8) & 0xFF;
+    buffer[idx++] = report.satellites;
+    buffer[idx++] = report.hdop_x10;
+    buffer[idx++] = report.uptime_sec & 0xFF;
+    buffer[idx++] = (report.uptime_sec >> 8) & 0xFF;
+    buffer[idx++] = (report.uptime_sec >> 16) & 0xFF;
+    buffer[idx++] = (report.uptime_sec >> 24) & 0xFF;
+    buffer[idx++] = report.txCount & 0xFF;
+    buffer[idx++] = (report.txCount >> 8) & 0xFF;
+    buffer[idx++] = report.rxCount & 0xFF;
+    buffer[idx++] = (report.rxCount >> 8) & 0xFF;
+    buffer[idx++] = report.battery_pct;
+    buffer[idx++] = report.neighborCount;
+    buffer[idx++] = report.flags;
+    return idx;
+}
+
+static bool handDecodeFullReport(const uint8_t* buffer, uint8_t length, FullReportMsg& report) {
+    if (length < 39) return false;
+    uint8_t idx = 0;
+    report.meshHeader.version = buffer[idx++];
+    report.meshHeader.messageType = buffer[idx++];
+    report.meshHeader.sourceId = buffer[idx++];
+    report.meshHeader.destId = buffer[idx++];
+    report.meshHeader.senderId = buffer[idx++];
+    report.meshHeader.messageId = buffer[idx++];
+    report.meshHeader.ttl = buffer[idx++];
+    report.meshHeader.flags = buffer[idx++];
+    report.temperatureF_x10 = buffer[idx] | (buffer[idx+1] << 8);
+    idx += 2;
+    report.humidity_x10 = buffer[idx] | (buffer[idx+1] << 8);
+    idx += 2;
+    report.pressure_hPa = buffer[idx] | (buffer[idx+1] << 8);
+    idx += 2;
+    report.altitude_m = buffer[idx] | (buffer[idx+1] << 8);
+    idx += 2;
+    report.latitude_x1e6 = buffer[idx] | (buffer[idx+1] << 8) |
+                           (buffer[idx+2] << 16) | (buffer[idx+3] << 24);
+    idx += 4;
+    report.longitude_x1e6 = buffer[idx] | (buffer[idx+1] << 8) |
+                            (buffer[idx+2] << 16) | (buffer[idx+3] << 24);
+    idx += 4;
+    report.gps_altitude_m = buffer[idx] | (buffer[idx+1] << 8);
+    idx += 2;
+    report.satellites = buffer[idx++];
+    report.hdop_x10 = buffer[idx++];
+    report.uptime_sec = buffer[idx] | (buffer[idx+1] << 8) |
+                        (buffer[idx+2] << 16) | (buffer[idx+3] << 24);
+    idx += 4;
+    report.txCount = buffer[idx] | (buffer[idx+1] << 8);
+    idx += 2;
+    report.rxCount = buffer[idx] | (buffer[idx+1] << 8);
+    idx += 2;
+    report.battery_pct = buffer[idx++];
+    report.neighborCount = buffer[idx++];
+    report.flags = buffer[idx++];
+    return true;
+}
+
+static uint16_t handReportJson(char* out, size_t size, const FullReportMsg& report) {
+    int len = snprintf(out, size,
+        ",\"meshSourceId\":%u,\"meshSenderId\":%u,\"meshMsgId\":%u,\"meshTtl\":%u,"
+        "\"temp\":%.1f,\"humidity\":%.1f,\"pressure\":%u,\"altitude\":%d,"
+        "\"lat\":%.6f,\"lng\":%.6f,\"gpsAlt\":%d,\"satellites\":%u,\"hdop\":%.1f,"
+        "\"uptime_sec\":%lu,\"txCount\":%u,\"rxCount\":%u,\"battery\":%u,\"neighborCount\":%u",
+        report.meshHeader.sourceId, report.meshHeader.senderId, report.meshHeader.messageId,
+        report.meshHeader.ttl,
+        report.temperatureF_x10 / 10.0, report.humidity_x10 / 10.0, report.pressure_hPa, report.altitude_m,
+        report.latitude_x1e6 / 1000000.0, report.longitude_x1e6 / 1000000.0, report.gps_altitude_m,
+        report.satellites, report.hdop_x10 / 10.0,
+        (unsigned long)report.uptime_sec, report.txCount, report.rxCount, report.battery_pct,
+        report.neighborCount);
+    return (len > 0) ? (uint16_t)len : 0;
+}
+
+static void fillBenchReport(FullReportMsg& report, uint32_t seed) {
+    uint8_t* bytes = (uint8_t*)&report;
+    for (uint8_t i = 0; i < sizeof(report); i++) {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = seed >> 16;
+    }
+}
+
+void runCodecBenchmark() {
+    static uint8_t hand[CODEC_BENCH_ITERATIONS > 64 ? 64 : CODEC_BENCH_ITERATIONS][FULL_REPORT_WIRE_SIZE];
+    const uint8_t samples = sizeof(hand) / sizeof(hand[0]);
+    FullReportMsg reports[8];
+    for (uint8_t i = 0; i < 8; i++) fillBenchReport(reports[i], 490 + i);
+
+    // Agreement: same bytes, same struct back, same JSON text
+    uint16_t mismatches = 0;
+    for (uint8_t i = 0; i < samples; i++) {
+        FullReportMsg report;
+        fillBenchReport(report, i * 7919);
+        uint8_t generated[FULL_REPORT_WIRE_SIZE];
+        handEncodeFullReport(hand[i], report);
+        schemaEncodeFullReport(generated, report);
+        FullReportMsg decoded;
+        schemaDecodeFullReport(hand[i], FULL_REPORT_WIRE_SIZE, decoded);
+        char handJson[SCHEMA_REPORT_JSON_MAX];
+        char generatedJson[SCHEMA_REPORT_JSON_MAX];
+        handReportJson(handJson, sizeof(handJson), report);
+        schemaReportJson(generatedJson, report);
+        if (memcmp(hand[i], generated, FULL_REPORT_WIRE_SIZE) != 0 ||
+            memcmp(&decoded, &report, sizeof(report)) != 0 ||
+            strcmp(handJson, generatedJson) != 0) {
+            mismatches++;
+        }
+    }
+
+    BeaconMsg beacon;
+    memset(&beacon, 0, sizeof(beacon));
+    beacon.distanceToGateway = 2;
+    beacon.sequenceNumber = 0x1234;
+    beacon.epoch = 0xBEEF;
+    uint8_t beaconBytes[BEACON_WIRE_SIZE];
+    BeaconMsg beaconBack;
+    schemaEncodeBeacon(beaconBytes, beacon);
+    schemaDecodeBeacon(beaconBytes, sizeof(beaconBytes), beaconBack);
+    if (memcmp(&beacon, &beaconBack, sizeof(beacon)) != 0) mismatches++;
+
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  MESSAGE CODEC BENCHMARK                                      ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  %u messages per point, FULL_REPORT (%u bytes)\n",
+                  CODEC_BENCH_ITERATIONS, FULL_REPORT_WIRE_SIZE);
+    Serial.println(F("                    Hand-written     Schema   Speedup"));
+
+    uint8_t buffer[FULL_REPORT_WIRE_SIZE];
+    FullReportMsg decoded;
+    char json[SCHEMA_REPORT_JSON_MAX];
+    volatile uint32_t sink = 0;
+    unsigned long times[6];
+
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < CODEC_BENCH_ITERATIONS; i++) sink += handEncodeFullReport(buffer, reports[i & 7]);
+    times[0] = micros() - start;
+    start = micros();
+    for (uint16_t i = 0; i < CODEC_BENCH_ITERATIONS; i++) sink += schemaEncodeFullReport(buffer, reports[i & 7]);
+    times[1] = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CODEC_BENCH_ITERATIONS; i++) {
+        sink += handDecodeFullReport(hand[i % samples], FULL_REPORT_WIRE_SIZE, decoded) + decoded.uptime_sec;
+    }
+    times[2] = micros() - start;
+    start = micros();
+    for (uint16_t i = 0; i < CODEC_BENCH_ITERATIONS; i++) {
+        sink += schemaDecodeFullReport(hand[i % samples], FULL_REPORT_WIRE_SIZE, decoded) + decoded.uptime_sec;
+    }
+    times[3] = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CODEC_BENCH_ITERATIONS; i++) sink += handReportJson(json, sizeof(json), reports[i & 7]);
+    times[4] = micros() - start;
+    start = micros();
+    for (uint16_t i = 0; i < CODEC_BENCH_ITERATIONS; i++) sink += schemaReportJson(json, reports[i & 7]);
+    times[5] = micros() - start;
+
+    static const char* const ROWS[] = { "Encode", "Decode", "JSON fields" };
+    for (uint8_t r = 0; r < 3; r++) {
+        float handNs = times[r * 2] * 1000.0f / CODEC_BENCH_ITERATIONS;
+        float schemaNs = times[r * 2 + 1] * 1000.0f / CODEC_BENCH_ITERATIONS;
+        Serial.printf("  %-14s  %9.0f ns  %9.0f ns  %7.1fx\n", ROWS[r], handNs, schemaNs,
+                      schemaNs > 0 ? handNs / schemaNs : 0.0f);
+    }
+    Serial.printf("  Agreement:        %u of %u samples differ  %s\n", mismatches, samples + 1,
+                  mismatches == 0 ? "OK" : "FAIL");
+    Serial.printf("  (checksum %lu)\n", (unsigned long)sink);
+    Serial.println();
+}
@@ -1,10 +1,12 @@
 #include "mesh_stats.h"
+#include "metrics.h"
+#include "channel_monitor.h"
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GLOBAL STATISTICS                                 ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-static MeshStats stats;
+static ReportAgeStats reportAges;
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         INITIALIZATION                                    ║
@@ -15,15 +17,8 @@ void initMeshStats() {
 }
 
 void resetMeshStats() {
-    stats.packetsReceived = 0;
-    stats.duplicatesDropped = 0;
-    stats.packetsSent = 0;
-    stats.packetsForwarded = 0;
-    stats.ttlExpired = 0;
-    stats.queueOverflows = 0;
-    stats.ownPacketsIgnored = 0;
-    stats.gatewayBroadcastSkips = 0;
-    stats.uptimeSeconds = 0;
+    metricsReset();
+    memset(&reportAges, 0, sizeof(reportAges));
 }
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -31,6 +26,16 @@ void resetMeshStats() {
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 MeshStats getMeshStats() {
+    MeshStats stats;
+    stats.packetsReceived       = metricGet(MET_PACKETS_RECEIVED);
+    stats.duplicatesDropped     = metricGet(MET_DUPLICATES_DROPPED);
+    stats.packetsSent           = metricGet(MET_PACKETS_SENT);
+    stats.packetsForwarded      = metricGet(MET_PACKETS_FORWARDED);
+    stats.ttlExpired            = metricGet(MET_TTL_EXPIRED);
+    stats.queueOverflows        = metricGet(MET_QUEUE_OVERFLOWS);
+    stats.ownPacketsIgnored     = metricGet(MET_OWN_PACKETS_IGNORED);
+    stats.gatewayBroadcastSkips = metricGet(MET_GATEWAY_BC_SKIPS);
+    stats.uptimeSeconds         = millis() / 1000;
     return stats;
 }
 
@@ -39,39 +44,51 @@ MeshStats getMeshStats() {
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 void incrementPacketsReceived() {
-    stats.packetsReceived++;
+    metricInc(MET_PACKETS_RECEIVED);
 }
 
 void incrementPacketsSent() {
-    stats.packetsSent++;
+    metricInc(MET_PACKETS_SENT);
 }
 
 void incrementPacketsForwarded() {
-    stats.packetsForwarded++;
+    metricInc(MET_PACKETS_FORWARDED);
 }
 
 void incrementDuplicatesDropped() {
-    stats.duplicatesDropped++;
+    metricInc(MET_DUPLICATES_DROPPED);
 }
 
 void incrementTTLExpired() {
-    stats.ttlExpired++;
+    metricInc(MET_TTL_EXPIRED);
 }
 
 void incrementQueueOverflows() {
-    stats.queueOverflows++;
+    metricInc(MET_QUEUE_OVERFLOWS);
 }
 
 void incrementOwnPacketsIgnored() {
-    stats.ownPacketsIgnored++;
+    metricInc(MET_OWN_PACKETS_IGNORED);
 }
 
 void incrementGatewayBroadcastSkips() {
-    stats.gatewayBroadcastSkips++;
+    metricInc(MET_GATEWAY_BC_SKIPS);
 }
 
-void updateMeshStatsUptime() {
-    stats.uptimeSeconds = millis() / 1000;
+void recordReportAge(uint8_t hops, uint8_t ageSec) {
+    if (hops == 0) return;
+    metricObserve(HIST_REPORT_AGE, ageSec);
+    uint8_t bucket = (hops > REPORT_AGE_HOP_BUCKETS) ? REPORT_AGE_HOP_BUCKETS - 1 : hops - 1;
+
+    reportAges.count[bucket]++;
+    reportAges.sumSec[bucket] += ageSec;
+    if (ageSec > reportAges.maxSec[bucket]) {
+        reportAges.maxSec[bucket] = ageSec;
+    }
+}
+
+ReportAgeStats getReportAgeStats() {
+    return reportAges;
 }
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -79,7 +96,7 @@ void updateMeshStatsUptime() {
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 void printMeshStats() {
-    updateMeshStatsUptime();
+    MeshStats stats = getMeshStats();
 
     Serial.println();
     Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
@@ -154,6 +171,23 @@ void printMeshStats() {
 
     Serial.println(F("║                                                               ║"));
 
+    // Channel (see 'mesh channel' for the per-slot heatmap)
+    Serial.println(F("║  CHANNEL:                                                     ║"));
+    String floorStr = String(channelMonitor.getNoiseFloorDbm()) + " dBm";
+    Serial.print(F("║    Noise Floor:           "));
+    Serial.print(floorStr);
+    for (int i = floorStr.length(); i < 34; i++) Serial.print(' ');
+    Serial.println(F("║"));
+
+    String busyStr = String(channelMonitor.getBusyPercent()) + "% busy, " +
+                     String(channelMonitor.getCadPercent()) + "% CAD";
+    Serial.print(F("║    Last Minute:           "));
+    Serial.print(busyStr);
+    for (int i = busyStr.length(); i < 34; i++) Serial.print(' ');
+    Serial.println(F("║"));
+
+    Serial.println(F("║                                                               ║"));
+
     // Uptime
     Serial.print(F("║  Uptime: "));
     uint32_t hours = stats.uptimeSeconds / 3600;
@@ -169,8 +203,32 @@ void printMeshStats() {
     Serial.println();
 }
 
+void printReportAgeStats() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  REPORT AGE AT GATEWAY                                        ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    bool any = false;
+    for (uint8_t b = 0; b < REPORT_AGE_HOP_BUCKETS; b++) {
+        if (reportAges.count[b] == 0) continue;
+        any = true;
+        Serial.printf("  %u%s hop:  %5lu reports  avg %4.1f s  max %2u s\n",
+                      b + 1,
+                      (b == REPORT_AGE_HOP_BUCKETS - 1) ? "+" : " ",
+                      (unsigned long)reportAges.count[b],
+                      (float)reportAges.sumSec[b] / reportAges.count[b],
+                      reportAges.maxSec[b]);
+    }
+
+    if (!any) {
+        Serial.println(F("  No timed reports yet (gateway with valid time only)"));
+    }
+    Serial.println();
+}
+
 String getMeshStatsString() {
-    updateMeshStatsUptime();
+    MeshStats stats = getMeshStats();
 
     String result = "RX:" + String(stats.packetsReceived);
     result += " TX:" + String(stats.packetsSent);
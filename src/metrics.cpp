@@ -0,0 +1,422 @@
+#include "metrics.h"
+#include <atomic>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         METRIC DESCRIPTIONS                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct MetricInfo {
+    const char* name;
+    uint8_t     kind;
+    const char* help;
+};
+
+// Same order as MetricId
+static const MetricInfo METRIC_INFO[MET_COUNT] = {
+    { "mesh_packets_received_total",    METRIC_COUNTER, "Mesh reports accepted (duplicates excluded)" },
+    { "mesh_packets_sent_total",        METRIC_COUNTER, "Own packets transmitted" },
+    { "mesh_packets_forwarded_total",   METRIC_COUNTER, "Forwards transmitted" },
+    { "mesh_forwards_scheduled_total",  METRIC_COUNTER, "Forwards queued by the packet handler" },
+    { "mesh_duplicates_dropped_total",  METRIC_COUNTER, "Mesh duplicates dropped by the duplicate cache" },
+    { "mesh_ttl_expired_total",         METRIC_COUNTER, "Packets not forwarded because TTL ran out" },
+    { "mesh_queue_overflows_total",     METRIC_COUNTER, "Forwards dropped on a full queue" },
+    { "mesh_own_packets_ignored_total", METRIC_COUNTER, "Own packets heard back and not forwarded" },
+    { "mesh_gateway_bc_skips_total",    METRIC_COUNTER, "Gateway broadcasts not forwarded" },
+    { "radio_rx_frames_total",          METRIC_COUNTER, "Frames handed to the packet handler" },
+    { "radio_rx_legacy_duplicates_total", METRIC_COUNTER, "Duplicates of legacy (non-mesh) messages" },
+    { "radio_irqs_total",               METRIC_COUNTER, "Radio RX-done interrupts" },
+    { "radio_tx_airtime_ms_total",      METRIC_COUNTER, "Time on air of all transmissions" },
+
+    { "routing_beacons_received_total", METRIC_COUNTER, "Beacons received" },
+    { "routing_beacons_sent_total",     METRIC_COUNTER, "Beacons sent or relayed" },
+    { "routing_route_updates_total",    METRIC_COUNTER, "Route changes" },
+    { "routing_unicast_forwards_total", METRIC_COUNTER, "Forwards along the gradient" },
+    { "routing_flooding_fallbacks_total", METRIC_COUNTER, "Forwards that fell back to flooding" },
+    { "routing_route_expirations_total", METRIC_COUNTER, "Routes expired" },
+    { "routing_gateway_switches_total", METRIC_COUNTER, "Selected gateway changed" },
+    { "routing_beacon_slot_misses_total", METRIC_COUNTER, "Sub-frame relays dropped (micro-slot passed)" },
+    { "routing_beacons_out_of_phase_total", METRIC_COUNTER, "Beacons heard outside the sub-frame" },
+    { "routing_beacons_duplicate_total", METRIC_COUNTER, "Echoes of the current beacon" },
+    { "routing_beacons_stale_total",    METRIC_COUNTER, "Beacons with an older sequence or epoch" },
+    { "routing_gateway_reboots_total",  METRIC_COUNTER, "Gateway epoch increases seen" },
+
+    { "channel_rssi_samples_total",     METRIC_COUNTER, "Instantaneous RSSI samples taken in RX" },
+    { "channel_busy_samples_total",     METRIC_COUNTER, "RSSI samples above noise floor + margin" },
+    { "channel_cad_scans_total",        METRIC_COUNTER, "CAD scans on a quiet channel" },
+    { "channel_cad_detected_total",     METRIC_COUNTER, "CAD scans that found a LoRa preamble" },
+
+    { "tdma_slot_violations_total",     METRIC_COUNTER, "Frames heard starting outside the sender's slot" },
+    { "tdma_slot_corrections_sent_total", METRIC_COUNTER, "Clock corrections sent in beacons" },
+    { "tdma_slot_corrections_applied_total", METRIC_COUNTER, "Clock corrections applied to network time" },
+
+    { "gps_uart_bytes_total",           METRIC_COUNTER, "Bytes read from the GPS UART" },
+    { "gps_parse_microseconds_total",   METRIC_COUNTER, "CPU time spent parsing GPS data" },
+
+    { "system_uptime_seconds",          METRIC_GAUGE,   "Seconds since boot" },
+    { "system_free_heap_bytes",         METRIC_GAUGE,   "Free heap" },
+    { "system_min_free_heap_bytes",     METRIC_GAUGE,   "Lowest free heap since boot" },
+    { "mesh_tx_queue_depth",            METRIC_GAUGE,   "Forwards waiting in the queue" },
+    { "mesh_neighbors",                 METRIC_GAUGE,   "Active neighbors" },
+    { "mesh_live_nodes",                METRIC_GAUGE,   "Nodes in the node table" },
+    { "routing_gateway_distance",       METRIC_GAUGE,   "Hops to the gateway (255 = no route)" },
+    { "system_loop_stalls_total",       METRIC_COUNTER, "loop() iterations over budget" },
+    { "channel_busy_percent",           METRIC_GAUGE,   "Channel busy share of the last minute" },
+    { "tdma_slot_flagged_nodes",        METRIC_GAUGE,   "Nodes with timing near the slot guard" }
+};
+
+struct HistogramInfo {
+    const char*    name;
+    const char*    help;
+    const int32_t* bounds;
+    uint8_t        bucketCount;
+};
+
+static const int32_t QUEUE_DEPTH_BOUNDS[]  = { 0, 1, 2, 3, 4, 6, 8, 12, 16 };
+static const int32_t RSSI_BOUNDS[]         = { -120, -110, -100, -90, -80, -70, -60, -50 };
+static const int32_t REPORT_AGE_BOUNDS[]   = { 1, 2, 5, 10, 15, 20, 30, 45, 60 };
+static const int32_t SLOT_AIRTIME_BOUNDS[] = { 50, 100, 200, 300, 500, 750, 1000, 1500, 2000 };
+static const int32_t CHANNEL_RSSI_BOUNDS[] = { -125, -120, -115, -110, -105, -100, -90, -80, -70 };
+static const int32_t SLOT_ERROR_BOUNDS[]   = { -1000, -500, -250, -100, 0, 100, 250, 500, 1000 };
+
+#define BOUNDS(array) array, (uint8_t)(sizeof(array) / sizeof(array[0]))
+
+// Same order as HistogramId
+static const HistogramInfo HISTOGRAM_INFO[HIST_COUNT] = {
+    { "mesh_tx_queue_depth_on_enqueue", "Queue depth after each enqueue",             BOUNDS(QUEUE_DEPTH_BOUNDS) },
+    { "radio_rx_rssi_dbm",              "RSSI of received frames",                    BOUNDS(RSSI_BOUNDS) },
+    { "mesh_report_age_seconds",        "Report age at the gateway (from TX slot)",   BOUNDS(REPORT_AGE_BOUNDS) },
+    { "tdma_slot_airtime_ms",           "Time on air per own TDMA slot",              BOUNDS(SLOT_AIRTIME_BOUNDS) },
+    { "channel_rssi_dbm",               "Instantaneous RSSI while idle in RX",        BOUNDS(CHANNEL_RSSI_BOUNDS) },
+    { "tdma_slot_timing_error_ms",      "Report start minus the sender's TX second",  BOUNDS(SLOT_ERROR_BOUNDS) }
+};
+
+static const char* const MESSAGE_TYPE_LABELS[METRIC_TYPE_LABELS] = {
+    "0x00", "full_report", "routed_data", "ack", "heartbeat", "sensor_data", "gps_data", "status",
+    "text", "alert", "beacon", "load_test", "uplink_claim", "0x0d", "0x0e", "0x0f"
+};
+
+struct FamilyInfo {
+    const char*        name;
+    const char*        help;
+    const char*        labelName;
+    uint16_t           labels;
+    const char* const* labelText;     // nullptr = print the label number
+};
+
+// Same order as MetricFamily
+static const FamilyInfo FAMILY_INFO[FAM_COUNT] = {
+    { "mesh_node_reports_total",  "Reports accepted by source node",  "node", METRIC_NODE_LABELS, nullptr },
+    { "mesh_node_forwards_total", "Forwards queued by source node",   "node", METRIC_NODE_LABELS, nullptr },
+    { "radio_rx_by_type_total",   "Frames received by message type",  "type", METRIC_TYPE_LABELS, MESSAGE_TYPE_LABELS },
+    { "radio_tx_by_type_total",   "Frames sent by message type",      "type", METRIC_TYPE_LABELS, MESSAGE_TYPE_LABELS },
+    { "mesh_node_rx_limited_total", "Frames over the receive rate limit by node", "node", METRIC_NODE_LABELS, nullptr },
+    { "mesh_node_forwards_limited_total", "Forwards over the rate limit by source node", "node", METRIC_NODE_LABELS, nullptr }
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STORAGE                                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct HistogramState {
+    std::atomic<uint32_t> buckets[METRIC_MAX_BUCKETS + 1];     // Not cumulative; last = +Inf
+    std::atomic<uint32_t> count;
+    std::atomic<int32_t>  sum;
+};
+
+static std::atomic<uint32_t> scalars[MET_COUNT];
+static MetricReader readers[MET_COUNT];
+static HistogramState histograms[HIST_COUNT];
+
+static std::atomic<uint32_t> reportsByNode[METRIC_NODE_LABELS];
+static std::atomic<uint32_t> forwardsByNode[METRIC_NODE_LABELS];
+static std::atomic<uint32_t> rxByType[METRIC_TYPE_LABELS];
+static std::atomic<uint32_t> txByType[METRIC_TYPE_LABELS];
+static std::atomic<uint32_t> rxLimitedByNode[METRIC_NODE_LABELS];
+static std::atomic<uint32_t> forwardsLimitedByNode[METRIC_NODE_LABELS];
+
+static std::atomic<uint32_t>* const FAMILY_STORAGE[FAM_COUNT] = {
+    reportsByNode, forwardsByNode, rxByType, txByType, rxLimitedByNode, forwardsLimitedByNode
+};
+
+static_assert(sizeof(QUEUE_DEPTH_BOUNDS) / sizeof(int32_t) <= METRIC_MAX_BUCKETS, "too many buckets");
+static_assert(sizeof(RSSI_BOUNDS) / sizeof(int32_t) <= METRIC_MAX_BUCKETS, "too many buckets");
+static_assert(sizeof(REPORT_AGE_BOUNDS) / sizeof(int32_t) <= METRIC_MAX_BUCKETS, "too many buckets");
+static_assert(sizeof(SLOT_AIRTIME_BOUNDS) / sizeof(int32_t) <= METRIC_MAX_BUCKETS, "too many buckets");
+static_assert(sizeof(CHANNEL_RSSI_BOUNDS) / sizeof(int32_t) <= METRIC_MAX_BUCKETS, "too many buckets");
+static_assert(sizeof(SLOT_ERROR_BOUNDS) / sizeof(int32_t) <= METRIC_MAX_BUCKETS, "too many buckets");
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UPDATES                                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+IRAM_ATTR void metricInc(MetricId id) {
+    scalars[id].fetch_add(1, std::memory_order_relaxed);
+}
+
+IRAM_ATTR void metricAdd(MetricId id, uint32_t amount) {
+    scalars[id].fetch_add(amount, std::memory_order_relaxed);
+}
+
+IRAM_ATTR void metricSet(MetricId id, uint32_t value) {
+    scalars[id].store(value, std::memory_order_relaxed);
+}
+
+IRAM_ATTR void metricObserve(HistogramId id, int32_t value) {
+    const HistogramInfo& info = HISTOGRAM_INFO[id];
+    uint8_t bucket = 0;
+    while (bucket < info.bucketCount && value > info.bounds[bucket]) bucket++;
+
+    HistogramState& state = histograms[id];
+    state.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    state.count.fetch_add(1, std::memory_order_relaxed);
+    state.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+IRAM_ATTR void metricIncLabel(MetricFamily family, uint8_t label) {
+    if (label >= FAMILY_INFO[family].labels) return;
+    FAMILY_STORAGE[family][label].fetch_add(1, std::memory_order_relaxed);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         READS / RESET                                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+uint32_t metricGet(MetricId id) {
+    if (readers[id] != nullptr) return readers[id]();
+    return scalars[id].load(std::memory_order_relaxed);
+}
+
+uint32_t metricGetLabel(MetricFamily family, uint8_t label) {
+    if (label >= FAMILY_INFO[family].labels) return 0;
+    return FAMILY_STORAGE[family][label].load(std::memory_order_relaxed);
+}
+
+void metricBind(MetricId id, MetricReader reader) {
+    readers[id] = reader;
+}
+
+void metricsReset() {
+    for (uint8_t i = 0; i < MET_COUNT; i++) {
+        if (METRIC_INFO[i].kind == METRIC_COUNTER) scalars[i].store(0, std::memory_order_relaxed);
+    }
+    for (uint8_t h = 0; h < HIST_COUNT; h++) {
+        for (uint8_t b = 0; b <= METRIC_MAX_BUCKETS; b++) {
+            histograms[h].buckets[b].store(0, std::memory_order_relaxed);
+        }
+        histograms[h].count.store(0, std::memory_order_relaxed);
+        histograms[h].sum.store(0, std::memory_order_relaxed);
+    }
+    for (uint8_t f = 0; f < FAM_COUNT; f++) {
+        for (uint16_t l = 0; l < FAMILY_INFO[f].labels; l++) {
+            FAMILY_STORAGE[f][l].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ENUMERATION                                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void metricsForEach(MetricVisitor visitor, void* context) {
+    MetricSample sample;
+
+    for (uint8_t i = 0; i < MET_COUNT; i++) {
+        memset(&sample, 0, sizeof(sample));
+        sample.name = METRIC_INFO[i].name;
+        sample.help = METRIC_INFO[i].help;
+        sample.kind = METRIC_INFO[i].kind;
+        sample.value = metricGet((MetricId)i);
+        visitor(sample, context);
+    }
+
+    for (uint8_t h = 0; h < HIST_COUNT; h++) {
+        const HistogramInfo& info = HISTOGRAM_INFO[h];
+        const HistogramState& state = histograms[h];
+
+        memset(&sample, 0, sizeof(sample));
+        sample.name = info.name;
+        sample.help = info.help;
+        sample.kind = METRIC_HISTOGRAM;
+        sample.bounds = info.bounds;
+        sample.bucketCount = info.bucketCount;
+
+        // Cumulative; +Inf doubles as the count so the buckets stay consistent
+        uint32_t running = 0;
+        for (uint8_t b = 0; b < info.bucketCount; b++) {
+            running += state.buckets[b].load(std::memory_order_relaxed);
+            sample.bucketCounts[b] = running;
+        }
+        running += state.buckets[info.bucketCount].load(std::memory_order_relaxed);
+        sample.bucketCounts[info.bucketCount] = running;
+        sample.count = running;
+        sample.sum = state.sum.load(std::memory_order_relaxed);
+        visitor(sample, context);
+    }
+
+    for (uint8_t f = 0; f < FAM_COUNT; f++) {
+        const FamilyInfo& info = FAMILY_INFO[f];
+        for (uint16_t l = 0; l < info.labels; l++) {
+            uint32_t value = FAMILY_STORAGE[f][l].load(std::memory_order_relaxed);
+            if (value == 0) continue;
+
+            memset(&sample, 0, sizeof(sample));
+            sample.name = info.name;
+            sample.help = info.help;
+            sample.kind = METRIC_COUNTER;
+            sample.labelName = info.labelName;
+            if (info.labelText != nullptr) {
+                strlcpy(sample.labelValue, info.labelText[l], sizeof(sample.labelValue));
+            } else {
+                snprintf(sample.labelValue, sizeof(sample.labelValue), "%u", l);
+            }
+            sample.value = value;
+            visitor(sample, context);
+        }
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         OUTPUT FORMATS                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+struct MetricPrinter {
+    Print*      out;
+    const char* lastName;       // Families print their header / open their object once
+};
+
+static void printReadable(const MetricSample& s, void* context) {
+    Print& out = *((MetricPrinter*)context)->out;
+
+    if (s.kind != METRIC_HISTOGRAM) {
+        if (s.labelName) {
+            char full[64];
+            snprintf(full, sizeof(full), "%s{%s=%s}", s.name, s.labelName, s.labelValue);
+            out.printf("  %-40s %10lu\n", full, (unsigned long)s.value);
+        } else {
+            out.printf("  %-40s %10lu\n", s.name, (unsigned long)s.value);
+        }
+        return;
+    }
+
+    out.printf("  %-40s %10lu  avg %.1f\n", s.name, (unsigned long)s.count,
+               s.count ? (float)s.sum / s.count : 0.0f);
+    if (s.count == 0) return;
+
+    out.print(F("      "));
+    uint32_t previous = 0;
+    for (uint8_t b = 0; b <= s.bucketCount; b++) {
+        uint32_t inBucket = s.bucketCounts[b] - previous;
+        previous = s.bucketCounts[b];
+        if (b < s.bucketCount) {
+            out.printf("<=%ld:%lu ", (long)s.bounds[b], (unsigned long)inBucket);
+        } else {
+            out.printf(">%ld:%lu", (long)s.bounds[b - 1], (unsigned long)inBucket);
+        }
+    }
+    out.println();
+}
+
+static void printJson(const MetricSample& s, void* context) {
+    MetricPrinter& printer = *(MetricPrinter*)context;
+    Print& out = *printer.out;
+
+    if (s.labelName) {
+        // Family members arrive together: {"3":12,"4":9}
+        bool first = (printer.lastName != s.name);
+        if (first) {
+            if (printer.lastName != nullptr) out.print('}');
+            out.printf(",\"%s\":{", s.name);
+            printer.lastName = s.name;
+        }
+        out.printf("%s\"%s\":%lu", first ? "" : ",", s.labelValue, (unsigned long)s.value);
+        return;
+    }
+
+    if (s.kind != METRIC_HISTOGRAM) {
+        out.printf(",\"%s\":%lu", s.name, (unsigned long)s.value);
+        return;
+    }
+
+    out.printf(",\"%s\":{\"count\":%lu,\"sum\":%ld,\"le\":[", s.name, (unsigned long)s.count, (long)s.sum);
+    for (uint8_t b = 0; b < s.bucketCount; b++) {
+        out.printf("%s%ld", b ? "," : "", (long)s.bounds[b]);
+    }
+    out.print(F("],\"buckets\":["));
+    for (uint8_t b = 0; b <= s.bucketCount; b++) {
+        out.printf("%s%lu", b ? "," : "", (unsigned long)s.bucketCounts[b]);
+    }
+    out.print(F("]}"));
+}
+
+static void printPrometheus(const MetricSample& s, void* context) {
+    MetricPrinter& printer = *(MetricPrinter*)context;
+    Print& out = *printer.out;
+
+    if (printer.lastName != s.name) {
+        static const char* const TYPE_NAMES[] = { "counter", "gauge", "histogram" };
+        out.printf("# HELP %s %s\n# TYPE %s %s\n", s.name, s.help, s.name, TYPE_NAMES[s.kind]);
+        printer.lastName = s.name;
+    }
+
+    if (s.kind != METRIC_HISTOGRAM) {
+        if (s.labelName) {
+            out.printf("%s{%s=\"%s\"} %lu\n", s.name, s.labelName, s.labelValue, (unsigned long)s.value);
+        } else {
+            out.printf("%s %lu\n", s.name, (unsigned long)s.value);
+        }
+        return;
+    }
+
+    for (uint8_t b = 0; b < s.bucketCount; b++) {
+        out.printf("%s_bucket{le=\"%ld\"} %lu\n", s.name, (long)s.bounds[b], (unsigned long)s.bucketCounts[b]);
+    }
+    out.printf("%s_bucket{le=\"+Inf\"} %lu\n", s.name, (unsigned long)s.bucketCounts[s.bucketCount]);
+    out.printf("%s_sum %ld\n%s_count %lu\n", s.name, (long)s.sum, s.name, (unsigned long)s.count);
+}
+
+void printMetrics(Print& out) {
+    out.println();
+    out.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    out.println(F("║  METRICS                                                      ║"));
+    out.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    MetricPrinter printer = { &out, nullptr };
+    metricsForEach(printReadable, &printer);
+    out.println();
+}
+
+void printMetricsJson(Print& out) {
+    out.print(F("{\"type\":\"metrics\""));
+
+    MetricPrinter printer = { &out, nullptr };
+    metricsForEach(printJson, &printer);
+    if (printer.lastName != nullptr) out.print('}');
+
+    out.println('}');
+}
+
+void printMetricsPrometheus(Print& out) {
+    MetricPrinter printer = { &out, nullptr };
+    metricsForEach(printPrometheus, &printer);
+}
+
+/**
+ * Print adapter that appends to a String (for WebServer::send)
+ */
+class StringPrint : public Print {
+public:
+    String& target;
+    explicit StringPrint(String& s) : target(s) {}
+    size_t write(uint8_t c) override {
+        target += (char)c;
+        return 1;
+    }
+};
+
+String getMetricsPrometheus() {
+    String text;
+    text.reserve(8192);
+    StringPrint printer(text);
+    printMetricsPrometheus(printer);
+    return text;
+}
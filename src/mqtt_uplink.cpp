@@ -0,0 +1,458 @@
+#include "mqtt_uplink.h"
+
+// MQTT 3.1.1 control packet types (upper nibble of the fixed header)
+#define MQTT_CONNECT        0x10
+#define MQTT_CONNACK        2
+#define MQTT_PUBLISH_QOS1   0x32
+#define MQTT_PUBLISH_DUP    0x08
+#define MQTT_PUBACK         4
+#define MQTT_PINGREQ        0xC0
+#define MQTT_PINGRESP       13
+#define MQTT_DISCONNECT     0xE0
+
+// Fixed header (1) + remaining length (<= 2 bytes for our sizes)
+#define MQTT_FIXED_HEADER_MAX   3
+#define MQTT_PUBLISH_MAX        (MQTT_FIXED_HEADER_MAX + 2 + MQTT_TOPIC_MAX + 2 + MQTT_PAYLOAD_MAX)
+
+static uint8_t encodeRemainingLength(uint8_t* out, uint16_t length) {
+    uint8_t used = 0;
+    do {
+        uint8_t digit = length % 128;
+        length /= 128;
+        if (length > 0) digit |= 0x80;
+        out[used++] = digit;
+    } while (length > 0);
+    return used;
+}
+
+static uint16_t putString(uint8_t* out, const char* text) {
+    uint16_t length = strlen(text);
+    out[0] = length >> 8;
+    out[1] = length & 0xFF;
+    memcpy(out + 2, text, length);
+    return length + 2;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CONSTRUCTOR / SETUP                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+MqttUplink::MqttUplink()
+    : state(STATE_IDLE), port(0), username(""), password(""), keepAliveSec(MQTT_KEEPALIVE_SEC),
+      queueHead(0), queueCount(0), nextPacketId(1), rxLength(0), stateSinceMs(0),
+      reconnectDelayMs(MQTT_RECONNECT_MIN_MS), lastSendMs(0), pingSentMs(0), pingOutstanding(false),
+      connectResult(CONNECT_NONE) {
+    host[0] = '\0';
+    clientId[0] = '\0';
+    topic[0] = '\0';
+    memset(inflight, 0, sizeof(inflight));
+    memset(&stats, 0, sizeof(stats));
+}
+
+void MqttUplink::begin(const char* brokerHost, uint16_t brokerPort, const char* id,
+                       const char* reportTopic, const char* user, const char* pass,
+                       uint16_t keepAlive) {
+    strlcpy(host, brokerHost, sizeof(host));
+    strlcpy(clientId, id, sizeof(clientId));
+    strlcpy(topic, reportTopic, sizeof(topic));
+    port = brokerPort;
+    username = user;
+    password = pass;
+    keepAliveSec = keepAlive;
+
+    // First attempt on the next update()
+    reconnectDelayMs = MQTT_RECONNECT_MIN_MS;
+    state = STATE_DISCONNECTED;
+    stateSinceMs = millis() - reconnectDelayMs;
+}
+
+void MqttUplink::stop() {
+    if (state == STATE_CONNECTED) {
+        static const uint8_t disconnect[] = { MQTT_DISCONNECT, 0 };
+        client.write(disconnect, sizeof(disconnect));
+    }
+    // A running connect task still owns the client; update() closes it later
+    if (!connectTaskBusy()) client.stop();
+    state = STATE_IDLE;
+}
+
+void MqttUplink::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CONNECTION                                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+bool MqttUplink::writePacket(const uint8_t* data, size_t length) {
+    if (client.write(data, length) != length) {
+        dropConnection();
+        return false;
+    }
+    lastSendMs = millis();
+    stats.bytesSent += length;
+    return true;
+}
+
+void MqttUplink::connectTask(void* param) {
+    MqttUplink* self = (MqttUplink*)param;
+    bool connected = self->client.connect(self->host, self->port);
+    self->connectResult.store(connected ? CONNECT_OK : CONNECT_FAILED);
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @return true while a connect task owns the client. A result nobody
+ * waited for (stop() during the connect) is discarded and its socket closed.
+ */
+bool MqttUplink::connectTaskBusy() {
+    uint8_t result = connectResult.load();
+    if (result == CONNECT_PENDING) return true;
+    if (result != CONNECT_NONE) {
+        connectResult.store(CONNECT_NONE);
+        client.stop();
+    }
+    return false;
+}
+
+void MqttUplink::startConnect() {
+    client.stop();
+    connectResult.store(CONNECT_PENDING);
+    if (xTaskCreatePinnedToCore(connectTask, "mqttConnect", MQTT_CONNECT_STACK_SIZE,
+                                this, 1, nullptr, 0) != pdPASS) {
+        connectResult.store(CONNECT_NONE);
+        stats.connectFailures++;
+        dropConnection();
+        return;
+    }
+    state = STATE_TCP_CONNECT;
+    stateSinceMs = millis();
+}
+
+void MqttUplink::sendConnect() {
+    client.setNoDelay(true);
+
+    uint8_t flags = 0;                  // Clean session off: broker keeps our QoS 1 state
+    if (username[0] != '\0') flags |= 0x80;
+    if (password[0] != '\0') flags |= 0x40;
+
+    uint8_t body[10 + 2 + MQTT_CLIENT_ID_MAX + 2 * (2 + 64)];
+    uint16_t length = putString(body, "MQTT");
+    body[length++] = 4;                 // Protocol level 3.1.1
+    body[length++] = flags;
+    body[length++] = keepAliveSec >> 8;
+    body[length++] = keepAliveSec & 0xFF;
+    length += putString(body + length, clientId);
+    if (flags & 0x80) length += putString(body + length, username);
+    if (flags & 0x40) length += putString(body + length, password);
+
+    uint8_t packet[MQTT_FIXED_HEADER_MAX + sizeof(body)];
+    packet[0] = MQTT_CONNECT;
+    uint8_t headerLength = 1 + encodeRemainingLength(packet + 1, length);
+    memcpy(packet + headerLength, body, length);
+
+    rxLength = 0;
+    pingOutstanding = false;
+    if (!writePacket(packet, headerLength + length)) return;
+
+    state = STATE_CONNACK_WAIT;
+    stateSinceMs = millis();
+}
+
+void MqttUplink::dropConnection() {
+    client.stop();
+    state = STATE_DISCONNECTED;
+    stateSinceMs = millis();
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         INCOMING PACKETS                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void MqttUplink::readPackets() {
+    while (client.available() > 0) {
+        int c = client.read();
+        if (c < 0) break;
+        rxBuffer[rxLength++] = (uint8_t)c;
+
+        if (rxLength < 2) continue;
+
+        // CONNACK, PUBACK and PINGRESP all have a one-byte remaining length
+        uint8_t remaining = rxBuffer[1];
+        if ((remaining & 0x80) || remaining > MQTT_RX_BUFFER_SIZE - 2) {
+            Serial.println(F("[MQTT] Unexpected packet from broker, reconnecting"));
+            dropConnection();
+            return;
+        }
+        if (rxLength < 2 + remaining) continue;
+
+        rxLength = 0;
+        handlePacket(rxBuffer[0] >> 4, rxBuffer + 2, remaining);
+        if (state == STATE_DISCONNECTED) return;
+    }
+}
+
+void MqttUplink::handlePacket(uint8_t type, const uint8_t* body, uint8_t length) {
+    if (type == MQTT_CONNACK && length == 2) {
+        if (body[1] != 0) {
+            stats.connectFailures++;
+            Serial.print(F("[MQTT] Broker refused connection, code "));
+            Serial.println(body[1]);
+            dropConnection();
+            return;
+        }
+
+        state = STATE_CONNECTED;
+        stateSinceMs = millis();
+        reconnectDelayMs = MQTT_RECONNECT_MIN_MS;
+        stats.connects++;
+        if (body[0] & 0x01) stats.sessionsResumed++;
+
+        Serial.print(F("[MQTT] Connected to "));
+        Serial.print(host);
+        Serial.println((body[0] & 0x01) ? F(" (session resumed)") : F(" (new session)"));
+
+        // Anything unacknowledged from the previous connection goes again
+        retransmit(true);
+    } else if (type == MQTT_PUBACK && length == 2) {
+        handlePuback(((uint16_t)body[0] << 8) | body[1]);
+    } else if (type == MQTT_PINGRESP) {
+        pingOutstanding = false;
+    }
+}
+
+void MqttUplink::handlePuback(uint16_t packetId) {
+    for (uint8_t i = 0; i < MQTT_INFLIGHT_MAX; i++) {
+        InflightPublish& slot = inflight[i];
+        if (slot.packetId != packetId) continue;
+
+        uint32_t now = millis();
+        for (uint8_t r = 0; r < slot.count; r++) {
+            uint32_t latencyMs = now - slot.queuedAtMs[r];
+            stats.latencySumMs += latencyMs;
+            if (latencyMs > stats.latencyMaxMs) stats.latencyMaxMs = latencyMs;
+        }
+        stats.reportsAcked += slot.count;
+        stats.pubacks++;
+        slot.packetId = 0;
+        return;
+    }
+    // Late PUBACK for a publish already acknowledged (DUP resend) - ignore
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         PUBLISHING                                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+bool MqttUplink::sendPublish(InflightPublish& slot, bool duplicate) {
+    static uint8_t packet[MQTT_PUBLISH_MAX];
+
+    uint16_t topicLength = strlen(topic);
+    uint16_t payloadLength = MQTT_PAYLOAD_HEADER_SIZE + slot.count * MQTT_RECORD_SIZE;
+    uint16_t remaining = 2 + topicLength + 2 + payloadLength;
+
+    packet[0] = MQTT_PUBLISH_QOS1 | (duplicate ? MQTT_PUBLISH_DUP : 0);
+    uint16_t length = 1 + encodeRemainingLength(packet + 1, remaining);
+    length += putString(packet + length, topic);
+    packet[length++] = slot.packetId >> 8;
+    packet[length++] = slot.packetId & 0xFF;
+    packet[length++] = MQTT_PAYLOAD_VERSION;
+    packet[length++] = DEVICE_ID;
+    packet[length++] = slot.count;
+    memcpy(packet + length, slot.records, slot.count * MQTT_RECORD_SIZE);
+    length += slot.count * MQTT_RECORD_SIZE;
+
+    slot.sentAtMs = millis();
+    return writePacket(packet, length);
+}
+
+void MqttUplink::publishBatch() {
+    while (queueCount > 0) {
+        uint32_t now = millis();
+        bool due = (queueCount >= MQTT_BATCH_MAX) ||
+                   (now - queue[queueHead].queuedAtMs >= MQTT_BATCH_WAIT_MS);
+        if (!due) return;
+
+        InflightPublish* slot = nullptr;
+        for (uint8_t i = 0; i < MQTT_INFLIGHT_MAX; i++) {
+            if (inflight[i].packetId == 0) {
+                slot = &inflight[i];
+                break;
+            }
+        }
+        if (slot == nullptr) return;        // Window full - wait for a PUBACK
+
+        slot->count = min((uint8_t)MQTT_BATCH_MAX, queueCount);
+        for (uint8_t r = 0; r < slot->count; r++) {
+            slot->records[r] = queue[queueHead].record;
+            slot->queuedAtMs[r] = queue[queueHead].queuedAtMs;
+            queueHead = (queueHead + 1) % MQTT_QUEUE_SIZE;
+            queueCount--;
+        }
+        slot->packetId = nextPacketId++;
+        if (nextPacketId == 0) nextPacketId = 1;
+
+        stats.publishes++;
+        // On failure the slot stays in flight and is resent after reconnecting
+        if (!sendPublish(*slot, false)) return;
+    }
+}
+
+void MqttUplink::retransmit(bool all) {
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < MQTT_INFLIGHT_MAX; i++) {
+        InflightPublish& slot = inflight[i];
+        if (slot.packetId == 0) continue;
+        if (!all && now - slot.sentAtMs < MQTT_RETRY_MS) continue;
+
+        stats.retransmits++;
+        if (!sendPublish(slot, true)) return;
+    }
+}
+
+bool MqttUplink::enqueue(uint8_t nodeId, const FullReportMsg& report, float rssi) {
+    if (queueCount >= MQTT_QUEUE_SIZE) {
+        stats.reportsDropped++;
+        return false;
+    }
+
+    QueuedReport& entry = queue[(queueHead + queueCount) % MQTT_QUEUE_SIZE];
+    MqttReportRecord& record = entry.record;
+    record.nodeId = nodeId;
+    record.messageId = report.meshHeader.messageId;
+    record.temperatureF_x10 = report.temperatureF_x10;
+    record.humidity_x10 = report.humidity_x10;
+    record.pressure_hPa = report.pressure_hPa;
+    record.altitude_m = report.altitude_m;
+    record.latitude_x1e6 = report.latitude_x1e6;
+    record.longitude_x1e6 = report.longitude_x1e6;
+    record.satellites = report.satellites;
+    record.battery_pct = report.battery_pct;
+    record.rssi = (int8_t)constrain((int)rssi, -128, 127);
+    record.flags = report.flags;
+    record.uptime_sec = report.uptime_sec;
+    entry.queuedAtMs = millis();
+
+    queueCount++;
+    stats.reportsQueued++;
+    return true;
+}
+
+uint8_t MqttUplink::inflightCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MQTT_INFLIGHT_MAX; i++) {
+        if (inflight[i].packetId != 0) count++;
+    }
+    return count;
+}
+
+uint16_t MqttUplink::pendingReports() const {
+    uint16_t pending = queueCount;
+    for (uint8_t i = 0; i < MQTT_INFLIGHT_MAX; i++) {
+        if (inflight[i].packetId != 0) pending += inflight[i].count;
+    }
+    return pending;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UPDATE                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void MqttUplink::update() {
+    uint32_t now = millis();
+
+    switch (state) {
+        case STATE_IDLE:
+            connectTaskBusy();
+            return;
+
+        case STATE_DISCONNECTED:
+            if (!connectTaskBusy() && now - stateSinceMs >= reconnectDelayMs) {
+                // Back off further in case this attempt fails too (CONNACK resets it)
+                reconnectDelayMs = min((uint32_t)MQTT_RECONNECT_MAX_MS, reconnectDelayMs * 2);
+                startConnect();
+            }
+            return;
+
+        case STATE_TCP_CONNECT: {
+            uint8_t result = connectResult.load();
+            if (result == CONNECT_PENDING) return;
+            connectResult.store(CONNECT_NONE);
+            if (result == CONNECT_OK) {
+                sendConnect();
+            } else {
+                stats.connectFailures++;
+                dropConnection();
+            }
+            return;
+        }
+
+        case STATE_CONNACK_WAIT:
+            readPackets();
+            if (state == STATE_CONNACK_WAIT && now - stateSinceMs >= MQTT_CONNACK_TIMEOUT_MS) {
+                stats.connectFailures++;
+                dropConnection();
+            }
+            return;
+
+        case STATE_CONNECTED:
+            break;
+    }
+
+    if (!client.connected()) {
+        Serial.println(F("[MQTT] Connection lost"));
+        dropConnection();
+        return;
+    }
+
+    readPackets();
+    if (state != STATE_CONNECTED) return;
+
+    retransmit(false);
+    if (state != STATE_CONNECTED) return;
+    publishBatch();
+    if (state != STATE_CONNECTED) return;
+
+    // Keepalive: ping after half the interval without traffic, give up after a full one
+    uint32_t keepAliveMs = (uint32_t)keepAliveSec * 1000;
+    if (pingOutstanding) {
+        if (now - pingSentMs >= keepAliveMs) {
+            Serial.println(F("[MQTT] No PINGRESP, reconnecting"));
+            dropConnection();
+        }
+    } else if (now - lastSendMs >= keepAliveMs / 2) {
+        static const uint8_t pingreq[] = { MQTT_PINGREQ, 0 };
+        if (writePacket(pingreq, sizeof(pingreq))) {
+            pingOutstanding = true;
+            pingSentMs = now;
+        }
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STATUS                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void MqttUplink::printStatus() {
+    static const char* const STATE_NAMES[] = { "idle", "disconnected", "TCP connect", "waiting for CONNACK", "connected" };
+    unsigned long reportsPublished = stats.reportsAcked + pendingReports() - queueCount;
+
+    Serial.printf("  Broker:           %s:%u (%s)\n", host, port, STATE_NAMES[state]);
+    Serial.printf("  Client / topic:   %s -> %s\n", clientId, topic);
+    Serial.printf("  Queued:           %u of %u\n", queueCount, MQTT_QUEUE_SIZE);
+    Serial.printf("  In flight:        %u of %u publishes (%u reports pending)\n",
+                  inflightCount(), MQTT_INFLIGHT_MAX, pendingReports());
+    Serial.printf("  Reports:          %lu queued, %lu acked, %lu dropped\n",
+                  stats.reportsQueued, stats.reportsAcked, stats.reportsDropped);
+    Serial.printf("  Publishes:        %lu (%.1f reports each), %lu retransmits, %lu PUBACKs\n",
+                  stats.publishes,
+                  stats.publishes > 0 ? (float)reportsPublished / stats.publishes : 0.0f,
+                  stats.retransmits, stats.pubacks);
+    Serial.printf("  Connects:         %lu (%lu resumed), %lu failed\n",
+                  stats.connects, stats.sessionsResumed, stats.connectFailures);
+    Serial.printf("  Bytes sent:       %lu (%.1f per report)\n", stats.bytesSent,
+                  stats.reportsAcked > 0 ? (float)stats.bytesSent / stats.reportsAcked : 0.0f);
+    Serial.printf("  Report latency:   %.1f ms avg, %lu ms max (queued -> PUBACK)\n",
+                  stats.reportsAcked > 0 ? (float)stats.latencySumMs / stats.reportsAcked : 0.0f,
+                  stats.latencyMaxMs);
+}
@@ -55,6 +55,8 @@ void NeighborTable::update(uint8_t nodeId, int16_t rssi) {
             neighbors[i].rssiMax = rssi;
             neighbors[i].lastHeardMs = now;
             neighbors[i].packetsReceived = 1;
+            neighbors[i].lossSamples = 0;
+            neighbors[i].lossRate = 0.0f;
             neighbors[i].isActive = true;
             count++;
 
@@ -118,6 +120,28 @@ void NeighborTable::clear() {
     count = 0;
 }
 
+bool NeighborTable::restore(const Neighbor& entry, uint32_t ageMs) {
+    if (entry.nodeId == 0 || ageMs >= NEIGHBOR_TIMEOUT_MS) {
+        return false;
+    }
+
+    // Never overwrite something heard since boot
+    if (get(entry.nodeId) != nullptr) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < MAX_NEIGHBORS; i++) {
+        if (!neighbors[i].isActive) {
+            neighbors[i] = entry;
+            neighbors[i].lastHeardMs = millis() - ageMs;
+            neighbors[i].isActive = true;
+            count++;
+            return true;
+        }
+    }
+    return false;
+}
+
 int16_t NeighborTable::getAverageRSSI(uint8_t nodeId) {
     Neighbor* n = get(nodeId);
     if (n == nullptr) {
@@ -127,3 +151,34 @@ int16_t NeighborTable::getAverageRSSI(uint8_t nodeId) {
     // Return average of min and max observed RSSI
     return (n->rssiMin + n->rssiMax) / 2;
 }
+
+void NeighborTable::noteMessageId(uint8_t nodeId, uint8_t messageId) {
+    Neighbor* n = get(nodeId);
+    if (n == nullptr) return;
+
+    uint8_t gap = messageId - n->lastMessageId;     // Wraps with the 8-bit counter
+    n->lastMessageId = messageId;
+
+    if (n->lossSamples == 0 || gap == 0 || gap > NEIGHBOR_SEQ_RESYNC_GAP) {
+        // First report, repeat, or the counter restarted: nothing to measure
+        if (n->lossSamples == 0) n->lossSamples = 1;
+        return;
+    }
+
+    // gap - 1 missed slots, then one received
+    for (uint8_t i = 0; i < gap; i++) {
+        float missed = (i + 1 < gap) ? 1.0f : 0.0f;
+        n->lossRate += NEIGHBOR_LOSS_ALPHA * (missed - n->lossRate);
+        if (n->lossSamples < 255) n->lossSamples++;
+    }
+}
+
+bool NeighborTable::getLinkLoss(uint8_t nodeId, float& lossRate) {
+    Neighbor* n = get(nodeId);
+    if (n == nullptr || n->lossSamples < NEIGHBOR_LOSS_MIN_SAMPLES) {
+        return false;
+    }
+
+    lossRate = n->lossRate;
+    return true;
+}
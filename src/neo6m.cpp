@@ -1,4 +1,6 @@
 #include "neo6m.h"
+#include "config.h"
+#include "metrics.h"
 
 // UTC offset configuration
 const int UTC_OFFSET = -8; // PST (-8) + 12hr GPS correction = +4
@@ -18,6 +20,307 @@ bool g_datetime_valid = false;
 // TinyGPS++ object
 TinyGPSPlus gps;
 
+// ===== UBX Binary Mode =====
+
+// NEO-6M typical supply current at 3.0 V (datasheet): continuous
+// tracking vs 1 Hz cyclic tracking
+static const uint8_t NEO6M_TRACKING_MA = 39;
+static const uint8_t NEO6M_POWER_SAVE_MA = 11;
+
+static UbxParser ubxParser;
+static UbxNavState ubxNav;
+static GpsUbxState ubxState = GPS_UBX_OFF;
+static bool ubxPowerSave = false;
+
+// CFG messages go out one at a time, each waiting for its ACK
+enum UbxSequence : uint8_t {
+  UBX_SEQ_NONE = 0,
+  UBX_SEQ_CONFIGURE,      // Message rates (UBX_MSG_PLAN)
+  UBX_SEQ_POWER_SAVE,     // CFG-PM2, then CFG-RXM power save
+  UBX_SEQ_CONTINUOUS      // CFG-RXM continuous
+};
+
+struct UbxMsgRate {
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint8_t rate;
+};
+
+// NAV messages first, so a receiver that stops answering halfway still reports
+static const UbxMsgRate UBX_MSG_PLAN[] = {
+  { UBX_CLASS_NAV,  UBX_NAV_POSLLH,  1 },
+  { UBX_CLASS_NAV,  UBX_NAV_SOL,     1 },
+  { UBX_CLASS_NAV,  UBX_NAV_TIMEUTC, 1 },
+  { UBX_CLASS_NAV,  UBX_NAV_DOP,     GPS_UBX_DOP_RATE },
+  { UBX_CLASS_NMEA, UBX_NMEA_GGA,    0 },
+  { UBX_CLASS_NMEA, UBX_NMEA_GLL,    0 },
+  { UBX_CLASS_NMEA, UBX_NMEA_GSA,    0 },
+  { UBX_CLASS_NMEA, UBX_NMEA_GSV,    0 },
+  { UBX_CLASS_NMEA, UBX_NMEA_RMC,    0 },
+  { UBX_CLASS_NMEA, UBX_NMEA_VTG,    0 }
+};
+static const uint8_t UBX_MSG_PLAN_COUNT = sizeof(UBX_MSG_PLAN) / sizeof(UBX_MSG_PLAN[0]);
+
+static UbxSequence ubxSeq = UBX_SEQ_NONE;
+static uint8_t ubxStep = 0;
+static uint8_t ubxRetries = 0;
+static bool ubxAwaitingAck = false;
+static uint8_t ubxAckClass = 0;
+static uint8_t ubxAckId = 0;
+static unsigned long ubxSentMs = 0;
+static bool ubxAnswered = false;      // Any ACK/NAK since boot: the TX line works
+static uint8_t ubxNaks = 0;
+
+// Time holdover: last valid NAV-TIMEUTC and when its epoch began
+static bool ubxTimeAnchored = false;
+static unsigned long ubxTimeAnchorMs = 0;
+static int32_t ubxAnchorMsOfDay = 0;
+static uint16_t ubxAnchorYear = 0;
+static uint8_t ubxAnchorMonth = 0;
+static uint8_t ubxAnchorDay = 0;
+static unsigned long ubxLastSolMs = 0;
+static unsigned long ubxLockedSinceMs = 0;
+
+// Parse cost
+static uint32_t gpsBytes = 0;
+static uint32_t gpsParseUs = 0;
+static unsigned long gpsWindowStartMs = 0;
+static uint32_t gpsWindowBytes = 0;
+static uint32_t gpsWindowParseUs = 0;
+static float gpsBytesPerSec = 0.0f;
+static float gpsParseUsPerSec = 0.0f;
+
+static void sendUbxStep();
+
+// ===== Raw UART Capture (GPS_CAPTURE_MS) =====
+
+static uint8_t captureRx[32];
+static uint8_t captureRxLen = 0;
+
+static bool captureActive() {
+  return GPS_CAPTURE_MS > 0 && millis() < GPS_CAPTURE_MS;
+}
+
+static void captureLine(const char* tag, const uint8_t* data, uint16_t len) {
+  Serial.printf("%s %lu", tag, millis());
+  for (uint16_t i = 0; i < len; i++) Serial.printf(" %02X", data[i]);
+  Serial.println();
+}
+
+static void flushCaptureRx() {
+  if (captureRxLen == 0) return;
+  captureLine("GPSRX", captureRx, captureRxLen);
+  captureRxLen = 0;
+}
+
+static void captureRxByte(uint8_t c) {
+  captureRx[captureRxLen++] = c;
+  if (captureRxLen == sizeof(captureRx)) flushCaptureRx();
+}
+
+// Frame for one step of a sequence, 0 when the sequence is done
+static uint16_t buildUbxStep(UbxSequence seq, uint8_t step, uint8_t* out) {
+  switch (seq) {
+    case UBX_SEQ_CONFIGURE:
+      if (step >= UBX_MSG_PLAN_COUNT) return 0;
+      return ubxBuildCfgMsg(UBX_MSG_PLAN[step].msgClass, UBX_MSG_PLAN[step].msgId,
+                            UBX_MSG_PLAN[step].rate, out);
+    case UBX_SEQ_POWER_SAVE:
+      if (step == 0) return ubxBuildCfgPm2(GPS_POWER_SAVE_PERIOD_MS, out);
+      if (step == 1) return ubxBuildCfgRxm(true, out);
+      return 0;
+    case UBX_SEQ_CONTINUOUS:
+      if (step == 0) return ubxBuildCfgRxm(false, out);
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+static void finishUbxSequence() {
+  switch (ubxSeq) {
+    case UBX_SEQ_CONFIGURE:
+      ubxState = GPS_UBX_ACTIVE;
+      Serial.printf("[GPS] UBX mode: NAV-POSLLH/SOL/TIMEUTC/DOP on, NMEA off (%u refused)\n", ubxNaks);
+      break;
+    case UBX_SEQ_POWER_SAVE:
+      ubxPowerSave = true;
+      Serial.printf("[GPS] Power save: %s, fix every %lu ms\n",
+                    GPS_POWER_SAVE_PERIOD_MS > UBX_PM2_CYCLIC_MAX_MS ? "ON/OFF" : "cyclic tracking",
+                    GPS_POWER_SAVE_PERIOD_MS);
+      break;
+    case UBX_SEQ_CONTINUOUS:
+      ubxPowerSave = false;
+      Serial.println(F("[GPS] Continuous tracking"));
+      break;
+    default:
+      break;
+  }
+  ubxSeq = UBX_SEQ_NONE;
+  ubxAwaitingAck = false;
+}
+
+static void startUbxSequence(UbxSequence seq) {
+  ubxSeq = seq;
+  ubxStep = 0;
+  ubxRetries = 0;
+  sendUbxStep();
+}
+
+static void sendUbxStep() {
+  uint8_t frame[UBX_MAX_FRAME];
+  uint16_t len = buildUbxStep(ubxSeq, ubxStep, frame);
+  if (len == 0) {
+    finishUbxSequence();
+    return;
+  }
+  Serial2.write(frame, len);
+  if (captureActive()) {
+    flushCaptureRx();         // Keep the log in wire order
+    captureLine("GPSTX", frame, len);
+  }
+  ubxAckClass = frame[2];
+  ubxAckId = frame[3];
+  ubxAwaitingAck = true;
+  ubxSentMs = millis();
+}
+
+static void nextUbxStep() {
+  ubxAwaitingAck = false;
+  ubxStep++;
+  ubxRetries = 0;
+  sendUbxStep();
+}
+
+static void checkUbxTimeout(unsigned long now) {
+  if (!ubxAwaitingAck || now - ubxSentMs < GPS_UBX_ACK_TIMEOUT_MS) return;
+
+  if (ubxRetries < GPS_UBX_CFG_RETRIES) {
+    ubxRetries++;
+    sendUbxStep();
+    return;
+  }
+
+  if (!ubxAnswered) {
+    // Nothing ever came back: receiver RX not wired, or not a u-blox
+    ubxAwaitingAck = false;
+    ubxSeq = UBX_SEQ_NONE;
+    ubxState = GPS_UBX_FAILED;
+    Serial.printf("[GPS] No UBX reply (GPS RX wired to GPIO%d?) - staying on NMEA\n", GPS_TX_PIN);
+    return;
+  }
+  Serial.printf("[GPS] No ACK for CFG 0x%02X, skipped\n", ubxAckId);
+  nextUbxStep();
+}
+
+// Epoch start of a valid NAV-TIMEUTC, minus the frame's time on the UART
+static void anchorUbxTime(const UbxFrame& frame, unsigned long now) {
+  uint32_t uartMs = (uint32_t)(frame.length + UBX_FRAME_OVERHEAD) * 10000UL / GPS_BAUD;
+  ubxTimeAnchorMs = now - uartMs;
+  ubxAnchorMsOfDay = ((int32_t)ubxNav.hour * 3600L + ubxNav.minute * 60L + ubxNav.second) * 1000L +
+                     ubxNav.nanos / 1000000L;
+  ubxAnchorYear = ubxNav.year;
+  ubxAnchorMonth = ubxNav.month;
+  ubxAnchorDay = ubxNav.day;
+  ubxTimeAnchored = true;
+}
+
+// g_* time from the anchor plus millis(), so it keeps ticking between fixes
+static void updateUbxTime(unsigned long now) {
+  if (!ubxTimeAnchored) return;
+
+  unsigned long age = now - ubxTimeAnchorMs;
+  if (age > GPS_HOLDOVER_MAX_MS) {
+    g_datetime_valid = false;
+    return;
+  }
+
+  int32_t msOfDay = ubxAnchorMsOfDay + (int32_t)age;
+  if (msOfDay < 0) msOfDay = 0;
+
+  int y = ubxAnchorYear;
+  int m = ubxAnchorMonth - 1;   // 0..11 for our helpers
+  int d = ubxAnchorDay;
+  int hh = msOfDay / 3600000L;  // Past 23 after midnight: applyUtcOffset rolls the date
+  applyUtcOffset(y, m, d, hh, UTC_OFFSET);
+
+  g_year = y;
+  g_month = m + 1;
+  g_day = d;
+  g_hour = hh;
+  g_minute = (msOfDay / 60000L) % 60;
+  g_second = (msOfDay / 1000L) % 60;
+  g_datetime_valid = true;
+}
+
+static void updateUbxLocation() {
+  g_latitude = ubxNav.latE7 / 1e7;
+  g_longitude = ubxNav.lonE7 / 1e7;
+  g_location_valid = ubxNav.fixOk && ubxNav.fixType >= 2 && ubxNav.fixType <= 4;
+}
+
+static bool handleUbxFrame(const UbxFrame& frame) {
+  bool acked;
+  if (ubxAwaitingAck && ubxIsAckFor(frame, ubxAckClass, ubxAckId, acked)) {
+    ubxAnswered = true;
+    if (!acked) {
+      ubxNaks++;
+      Serial.printf("[GPS] CFG 0x%02X refused (NAK)\n", ubxAckId);
+    }
+    nextUbxStep();
+    return false;
+  }
+
+  uint8_t decoded = ubxDecodeNav(frame, ubxNav);
+  if (decoded == 0 || ubxState != GPS_UBX_ACTIVE) return false;
+
+  unsigned long now = millis();
+  if (decoded == UBX_SEEN_TIMEUTC && ubxNav.timeValid) {
+    anchorUbxTime(frame, now);
+    updateUbxTime(now);
+  } else if (decoded == UBX_SEEN_SOL) {
+    ubxLastSolMs = now;
+    updateUbxLocation();
+  } else if (decoded == UBX_SEEN_POSLLH) {
+    updateUbxLocation();
+  }
+  return true;
+}
+
+// Fixed nodes: power save after a settled fix, back to continuous if time is lost
+static void updateUbxPowerMode(unsigned long now) {
+  if (!GPS_FIXED_POSITION || ubxState != GPS_UBX_ACTIVE || ubxSeq != UBX_SEQ_NONE) return;
+
+  bool timeFresh = ubxTimeAnchored && now - ubxTimeAnchorMs <= GPS_HOLDOVER_MAX_MS;
+
+  if (!ubxPowerSave) {
+    bool locked = timeFresh && ubxNav.fixOk && ubxNav.fixType == 3;
+    if (!locked) {
+      ubxLockedSinceMs = 0;
+    } else if (ubxLockedSinceMs == 0) {
+      ubxLockedSinceMs = now;
+    } else if (now - ubxLockedSinceMs >= GPS_POWER_SAVE_SETTLE_MS) {
+      startUbxSequence(UBX_SEQ_POWER_SAVE);
+    }
+  } else if (!timeFresh) {
+    Serial.println(F("[GPS] No time fix in power save - resuming continuous tracking"));
+    ubxLockedSinceMs = 0;
+    startUbxSequence(UBX_SEQ_CONTINUOUS);
+  }
+}
+
+static void updateGPSStatsWindow(unsigned long now) {
+  unsigned long elapsed = now - gpsWindowStartMs;
+  if (elapsed < GPS_STATS_WINDOW_MS) return;
+
+  gpsBytesPerSec = (gpsBytes - gpsWindowBytes) * 1000.0f / elapsed;
+  gpsParseUsPerSec = (gpsParseUs - gpsWindowParseUs) * 1000.0f / elapsed;
+  gpsWindowBytes = gpsBytes;
+  gpsWindowParseUs = gpsParseUs;
+  gpsWindowStartMs = now;
+}
+
+
 // Initialize GPS (if needed for future expansion)
 void initGPS() {
   // GPS initialization code can go here if needed
@@ -32,20 +335,61 @@ void initGPS() {
   g_second = 0;
   g_location_valid = false;
   g_datetime_valid = false;
+
+  gpsWindowStartMs = millis();
+  if (GPS_UBX_MODE) {
+    ubxState = GPS_UBX_CONFIGURING;
+    startUbxSequence(UBX_SEQ_CONFIGURE);
+  }
 }
 
 // Process incoming GPS data (call this in main loop when Serial2.available())
 bool processGPSData() {
   bool newData = false;
+  uint32_t bytes = 0;
+  unsigned long startUs = micros();
+  bool capture = captureActive();
   while (Serial2.available() > 0) {
-    if (gps.encode(Serial2.read())) {
+    uint8_t c = Serial2.read();
+    bytes++;
+    if (capture) captureRxByte(c);
+
+    if (ubxState != GPS_UBX_OFF) {
+      UbxFeedResult result = ubxParser.feed(c);
+      if (result == UBX_FEED_FRAME) {
+        if (handleUbxFrame(ubxParser.frame())) newData = true;
+        continue;
+      }
+      // Inside a UBX frame, or NMEA text once UBX has taken over
+      if (result != UBX_FEED_NONE || ubxState == GPS_UBX_ACTIVE) continue;
+    }
+
+    if (gps.encode(c)) {
       updateGlobalGPSData();
       newData = true;
     }
   }
+  if (capture) flushCaptureRx();
+  uint32_t parseUs = micros() - startUs;
+  gpsBytes += bytes;
+  gpsParseUs += parseUs;
+  metricAdd(MET_GPS_UART_BYTES, bytes);
+  metricAdd(MET_GPS_PARSE_US, parseUs);
   return newData;
 }
 
+void updateGPS() {
+  unsigned long now = millis();
+  if (ubxState != GPS_UBX_OFF) {
+    checkUbxTimeout(now);
+    if (ubxState == GPS_UBX_ACTIVE) {
+      updateUbxTime(now);
+      updateUbxPowerMode(now);
+    }
+  }
+  updateGPSStatsWindow(now);
+}
+
 // Update global GPS variables with latest data
 void updateGlobalGPSData() {
   // Update location data
@@ -273,16 +617,100 @@ int getGPSSecond() {
 // ===== GPS Altitude Functions =====
 
 float getGPSAltitude() {
-  if (gps.altitude.isValid()) {
+  if (isAltitudeValid()) {
+    if (ubxState == GPS_UBX_ACTIVE) return ubxNav.heightMslMm / 1000.0f;
     return gps.altitude.meters();
   }
   return -999.0f; // Invalid reading
 }
 
 bool isAltitudeValid() {
+  if (ubxState == GPS_UBX_ACTIVE) {
+    return (ubxNav.seen & UBX_SEEN_POSLLH) && ubxNav.fixOk && ubxNav.fixType >= 3 && ubxNav.fixType <= 4;
+  }
   return gps.altitude.isValid();
 }
 
+// ===== GPS Fix Quality Functions =====
+
+bool isSatellitesValid() {
+  if (ubxState == GPS_UBX_ACTIVE) {
+    // Last count is kept between power-save fixes, up to the holdover limit
+    return (ubxNav.seen & UBX_SEEN_SOL) && millis() - ubxLastSolMs <= GPS_HOLDOVER_MAX_MS;
+  }
+  return gps.satellites.isValid();
+}
+
+uint8_t getGPSSatellites() {
+  if (!isSatellitesValid()) return 0;
+  if (ubxState == GPS_UBX_ACTIVE) return ubxNav.numSV;
+  return gps.satellites.value();
+}
+
+bool isHdopValid() {
+  if (ubxState == GPS_UBX_ACTIVE) return (ubxNav.seen & UBX_SEEN_DOP) != 0;
+  return gps.hdop.isValid();
+}
+
+float getGPSHdop() {
+  if (!isHdopValid()) return 99.99f;
+  if (ubxState == GPS_UBX_ACTIVE) return ubxNav.hDopX100 / 100.0f;
+  return gps.hdop.hdop();
+}
+
+// ===== Receiver Mode and Parse Cost =====
+
+GpsStats getGPSStats() {
+  GpsStats stats;
+  stats.ubxState = ubxState;
+  stats.powerSave = ubxPowerSave;
+  stats.bytes = gpsBytes;
+  stats.parseUs = gpsParseUs;
+  stats.nmeaSentences = gps.passedChecksum();
+  stats.nmeaFailed = gps.failedChecksum();
+  stats.ubx = ubxParser.getStats();
+  stats.cfgNaks = ubxNaks;
+  stats.bytesPerSec = gpsBytesPerSec;
+  stats.parseUsPerSec = gpsParseUsPerSec;
+  stats.timeAgeMs = ubxTimeAnchored ? millis() - ubxTimeAnchorMs : 0;
+  return stats;
+}
+
+void printGPSStatus() {
+  static const char* const STATE_NAMES[] = { "NMEA", "configuring UBX", "UBX", "NMEA (UBX failed)" };
+  GpsStats stats = getGPSStats();
+
+  Serial.println();
+  Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+  Serial.println(F("║  GPS RECEIVER                                                 ║"));
+  Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+  Serial.printf("  Mode:            %s\n", STATE_NAMES[stats.ubxState]);
+  if (stats.ubxState == GPS_UBX_ACTIVE) {
+    const char* power = "continuous";
+    if (stats.powerSave) {
+      power = GPS_POWER_SAVE_PERIOD_MS > UBX_PM2_CYCLIC_MAX_MS ? "power save (ON/OFF)" : "power save (cyclic)";
+    }
+    Serial.printf("  Power:           %s, ~%u mA typ.%s\n", power,
+                  stats.powerSave ? NEO6M_POWER_SAVE_MA : NEO6M_TRACKING_MA,
+                  stats.powerSave && GPS_POWER_SAVE_PERIOD_MS > UBX_PM2_CYCLIC_MAX_MS ? " while on" : "");
+    if (ubxTimeAnchored) {
+      Serial.printf("  Time age:        %lu ms (holdover limit %lu ms)\n", stats.timeAgeMs, GPS_HOLDOVER_MAX_MS);
+    }
+    Serial.printf("  Fix:             type %u%s, %u SV, HDOP %.2f, hAcc %.1f m\n",
+                  ubxNav.fixType, ubxNav.fixOk ? " ok" : "", ubxNav.numSV,
+                  ubxNav.hDopX100 / 100.0f, ubxNav.hAccMm / 1000.0f);
+  }
+  Serial.printf("  UART:            %.0f bytes/s (%lu total)\n", stats.bytesPerSec, (unsigned long)stats.bytes);
+  Serial.printf("  Parse CPU:       %.0f us/s (%.3f%%)\n", stats.parseUsPerSec, stats.parseUsPerSec / 10000.0f);
+  Serial.printf("  NMEA sentences:  %lu ok, %lu bad checksum\n",
+                (unsigned long)stats.nmeaSentences, (unsigned long)stats.nmeaFailed);
+  if (stats.ubxState != GPS_UBX_OFF) {
+    Serial.printf("  UBX frames:      %lu ok, %lu bad checksum, %u CFG refused\n",
+                  (unsigned long)stats.ubx.frames, (unsigned long)stats.ubx.checksumErrors, stats.cfgNaks);
+  }
+  Serial.println();
+}
+
 // ===== Formatting Helper Functions =====
 
 String getFormattedTime12Hour() {
@@ -12,6 +12,11 @@ static const unsigned long NETWORK_TIME_MAX_AGE_MS = 120000;  // 2 minutes
 // Minimum interval between time updates (prevents rapid updates)
 static const unsigned long NETWORK_TIME_MIN_UPDATE_MS = 1000;  // 1 second
 
+// Limit on the summed gateway slot corrections (a beacon cannot move us further)
+static const int16_t NETWORK_TIME_MAX_CORRECTION_MS = 3000;
+
+static const int32_t MS_PER_DAY = 86400000L;
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GLOBAL STATE                                      ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -26,11 +31,13 @@ void initNetworkTime() {
     networkTime.hour = 0;
     networkTime.minute = 0;
     networkTime.second = 0;
+    networkTime.subSecondMs = 0;
     networkTime.receivedAtMillis = 0;
     networkTime.lastUpdateTime = 0;
     networkTime.valid = false;
     networkTime.sourceNodeId = 0;
     networkTime.hopCount = 255;  // Max value = no time source
+    networkTime.correctionMs = 0;
 
     Serial.println(F("[NET-TIME] Network time sync initialized (multi-hop enabled)"));
     Serial.println(F("[NET-TIME] Waiting for beacon with GPS time..."));
@@ -40,7 +47,8 @@ void initNetworkTime() {
 // ║                         TIME UPDATE                                       ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-void updateNetworkTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t sourceNode, uint8_t hopCount) {
+void updateNetworkTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t sourceNode, uint8_t hopCount,
+                       uint16_t phaseMs) {
     unsigned long now = millis();
 
     // Rate limit updates (prevent rapid beacon storms from causing issues)
@@ -73,6 +81,7 @@ void updateNetworkTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t sou
     networkTime.hour = hour;
     networkTime.minute = minute;
     networkTime.second = second;
+    networkTime.subSecondMs = phaseMs;
     networkTime.receivedAtMillis = now;
     networkTime.lastUpdateTime = now;
     networkTime.sourceNodeId = sourceNode;
@@ -80,8 +89,8 @@ void updateNetworkTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t sou
     networkTime.valid = true;
 
     // Log the update
-    Serial.printf("[NET-TIME] Time updated: %02d:%02d:%02d from Node %d (hop %d)\n",
-                  hour, minute, second, sourceNode, hopCount);
+    Serial.printf("[NET-TIME] Time updated: %02d:%02d:%02d +%u ms from Node %d (hop %d)\n",
+                  hour, minute, second, phaseMs, sourceNode, hopCount);
 }
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -89,24 +98,31 @@ void updateNetworkTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t sou
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 bool getNetworkTime(uint8_t &hour, uint8_t &minute, uint8_t &second) {
+    uint16_t millisecond;
+    return getNetworkTimeMs(hour, minute, second, millisecond);
+}
+
+bool getNetworkTimeMs(uint8_t &hour, uint8_t &minute, uint8_t &second, uint16_t &millisecond) {
     // Check if network time is still valid
     if (!isNetworkTimeValid()) {
         return false;
     }
 
-    // Calculate elapsed time since beacon was received
+    // Calculate elapsed time since the received second began
+    // (a negative slot correction can put us before it)
     unsigned long now = millis();
-    unsigned long elapsedMs = now - networkTime.receivedAtMillis;
-    unsigned long elapsedSeconds = elapsedMs / 1000;
+    int32_t elapsedMs = (int32_t)(now - networkTime.receivedAtMillis) +
+                        networkTime.subSecondMs + networkTime.correctionMs;
 
     // Start from the time we received
-    uint32_t totalSeconds = networkTime.hour * 3600UL +
-                            networkTime.minute * 60UL +
-                            networkTime.second +
-                            elapsedSeconds;
+    int32_t totalMs = (networkTime.hour * 3600L +
+                       networkTime.minute * 60L +
+                       networkTime.second) * 1000L + elapsedMs;
 
     // Handle day wraparound (86400 seconds in a day)
-    totalSeconds = totalSeconds % 86400UL;
+    totalMs = ((totalMs % MS_PER_DAY) + MS_PER_DAY) % MS_PER_DAY;
+    millisecond = (uint16_t)(totalMs % 1000);
+    uint32_t totalSeconds = (uint32_t)(totalMs / 1000);
 
     // Extract hour, minute, second
     hour = (uint8_t)(totalSeconds / 3600);
@@ -116,6 +132,21 @@ bool getNetworkTime(uint8_t &hour, uint8_t &minute, uint8_t &second) {
     return true;
 }
 
+bool applyNetworkTimeCorrection(int16_t correctionMs) {
+    if (!isNetworkTimeValid()) {
+        return false;
+    }
+
+    int32_t total = (int32_t)networkTime.correctionMs + correctionMs;
+    if (total > NETWORK_TIME_MAX_CORRECTION_MS) total = NETWORK_TIME_MAX_CORRECTION_MS;
+    if (total < -NETWORK_TIME_MAX_CORRECTION_MS) total = -NETWORK_TIME_MAX_CORRECTION_MS;
+    networkTime.correctionMs = (int16_t)total;
+
+    Serial.printf("[NET-TIME] Slot correction %+d ms from gateway (total %+d ms)\n",
+                  correctionMs, networkTime.correctionMs);
+    return true;
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         VALIDITY CHECK                                    ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -145,6 +176,33 @@ void invalidateNetworkTime() {
     Serial.println(F("[NET-TIME] Network time invalidated"));
 }
 
+bool restoreNetworkTime(uint8_t hour, uint8_t minute, uint8_t second,
+                        uint8_t sourceNode, uint8_t hopCount, unsigned long ageMs) {
+    if (networkTime.valid || ageMs > NETWORK_TIME_MAX_AGE_MS) {
+        return false;
+    }
+    if (hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    // Backdate the reference so elapsed-time extrapolation spans the reset
+    // (unsigned wraparound keeps millis() - receivedAtMillis == ageMs)
+    unsigned long now = millis();
+    networkTime.hour = hour;
+    networkTime.minute = minute;
+    networkTime.second = second;
+    networkTime.subSecondMs = 0;
+    networkTime.receivedAtMillis = now - ageMs;
+    networkTime.lastUpdateTime = now - ageMs;
+    networkTime.sourceNodeId = sourceNode;
+    networkTime.hopCount = hopCount;
+    networkTime.valid = true;
+
+    Serial.printf("[NET-TIME] Restored %02d:%02d:%02d from snapshot (age %lu ms, hop %d)\n",
+                  hour, minute, second, ageMs, hopCount);
+    return true;
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         UTILITY FUNCTIONS                                 ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
@@ -212,6 +270,8 @@ void printNetworkTimeStatus() {
         Serial.print(age);
         Serial.println(F(" seconds"));
 
+        Serial.printf("  Slot Correction: %+d ms\n", networkTime.correctionMs);
+
         Serial.print(F("  Max Age: "));
         Serial.print(NETWORK_TIME_MAX_AGE_MS / 1000);
         Serial.println(F(" seconds"));
@@ -239,10 +299,12 @@ void setManualTime(uint8_t hour, uint8_t minute, uint8_t second) {
     networkTime.hour = hour;
     networkTime.minute = minute;
     networkTime.second = second;
+    networkTime.subSecondMs = 0;
     networkTime.receivedAtMillis = now;
     networkTime.lastUpdateTime = now;
     networkTime.sourceNodeId = 0;      // 0 = manual/local
     networkTime.hopCount = 0;          // 0 = highest priority (direct source)
+    networkTime.correctionMs = 0;      // Manual time is taken as exact
     networkTime.valid = true;
 
     Serial.println(F(""));
@@ -1,24 +1,49 @@
 #include "node_store.h"
+#include "rate_limiter.h"
 #include "serial_output.h"
+#include "snapshot_latch.h"
+#include <atomic>
+#include <new>
+#include <stddef.h>
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GLOBAL NODE STORE                                 ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
-NodeMessage nodeStore[MESH_MAX_NODES];
+static NodeMessage nodeTable[NODE_TABLE_SIZE];
+
+// Every live node keeps its own rate budget (rate_limiter.h)
+static_assert(RATE_LIMIT_NODES >= NODE_TABLE_MAX_LIVE, "rate limiter must track every live node");
+
+/**
+ * Published copy of the table (see snapshot_latch.h). Published slots mirror
+ * the table, so readers probe them the same way the writer probes nodeTable[].
+ */
+typedef SnapshotLatch<NodeSnapshot, NODE_TABLE_SIZE> NodeLatch;
+
+static NodeLatch nodeLatch;
+static unsigned long snapshotsPublished = 0;
+static std::atomic<uint32_t> snapshotReads(0);
+static std::atomic<uint32_t> snapshotRetries(0);
+
+static std::atomic<uint16_t> liveNodes(0);
+static uint16_t tombstones = 0;
+static unsigned long nodesInserted = 0;
+static unsigned long nodesEvicted = 0;
+static unsigned long nodesRejected = 0;
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         NODE MESSAGE METHODS                              ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 NodeMessage::NodeMessage() {
+    nodeId = NODE_ID_EMPTY;
     clear();
 }
 
 void NodeMessage::clear() {
     hasData = false;
     isOnline = false;
-    payload = "";
     originId = 0;
     lastSeq = 0;
     expectedNextSeq = 0;
@@ -27,6 +52,9 @@ void NodeMessage::clear() {
     lastHeardTime = 0;
     messageCount = 0;
     packetsLost = 0;
+    packetsReordered = 0;
+    missingMask = 0;
+    memset(&lastReport, 0, sizeof(lastReport));
 }
 
 bool NodeMessage::hasTimedOut(unsigned long timeoutMs) const {
@@ -45,29 +73,60 @@ float NodeMessage::getPacketLossPercent() const {
     return (float)packetsLost / totalExpected * 100.0;
 }
 
+bool NodeMessage::isLateMeshPacket(uint8_t meshMessageId) const {
+    if (!hasData) return false;
+
+    // Position behind the window: 0 = last ID received, 1 = the one before...
+    uint8_t behind = (uint8_t)((uint8_t)expectedNextSeq - 1 - meshMessageId);
+    return behind < 32 && (missingMask & (1UL << behind));
+}
+
 uint16_t NodeMessage::updateFromMeshPacket(const LoRaReceivedPacket& packet, uint8_t meshMessageId) {
     uint16_t gap = 0;
 
+    // ─────────────────────────────────────────────────────────────────────
+    // Late arrival: this ID was counted as lost when a newer one arrived.
+    // Relays can deliver out of order - correct the loss, keep the window.
+    // ─────────────────────────────────────────────────────────────────────
+    if (isLateMeshPacket(meshMessageId)) {
+        uint8_t behind = (uint8_t)((uint8_t)expectedNextSeq - 1 - meshMessageId);
+        missingMask &= ~(1UL << behind);
+        if (packetsLost > 0) packetsLost--;
+        packetsReordered++;
+
+        isOnline = true;
+        lastRssi = packet.rssi;
+        lastSnr = packet.snr;
+        lastHeardTime = millis();
+        messageCount++;
+        return 0;
+    }
+
     // Use mesh messageId for gap detection (8-bit, wraps at 255)
     if (hasData && meshMessageId != (uint8_t)expectedNextSeq) {
-        // Calculate gap (handle sequence wraparound at 255)
-        if (meshMessageId > (uint8_t)expectedNextSeq) {
-            gap = meshMessageId - (uint8_t)expectedNextSeq;
-        } else if (meshMessageId < (uint8_t)lastSeq) {
-            // Sequence wrapped around (8-bit max = 255)
-            gap = (255 - (uint8_t)expectedNextSeq) + meshMessageId + 1;
-        }
+        // Distance ahead of the expected ID (handles wraparound at 255)
+        gap = (uint8_t)(meshMessageId - (uint8_t)expectedNextSeq);
 
         // Sanity check - ignore huge gaps (likely node restart)
         // Reduced threshold for 8-bit sequence numbers
         if (gap > 0 && gap < 100) {
             packetsLost += gap;
+        } else {
+            gap = 0;
+            missingMask = 0;
         }
     }
 
+    // Slide the missing-ID window and mark the IDs we just skipped
+    uint8_t shift = gap + 1;
+    missingMask = (hasData && shift < 32) ? (missingMask << shift) : 0;
+    if (gap > 0) {
+        uint32_t skipped = (gap >= 31) ? 0x7FFFFFFFUL : ((1UL << gap) - 1);
+        missingMask |= skipped << 1;
+    }
+
     hasData = true;
     isOnline = true;
-    payload = packet.payload;
     originId = packet.header.originId;
     lastSeq = meshMessageId;              // Store mesh message ID
     expectedNextSeq = meshMessageId + 1;  // Expect next mesh message ID
@@ -100,7 +159,6 @@ uint16_t NodeMessage::updateFromPacket(const LoRaReceivedPacket& packet) {
 
     hasData = true;
     isOnline = true;
-    payload = packet.payload;
     originId = packet.header.originId;
     lastSeq = packet.header.seq;
     expectedNextSeq = packet.header.seq + 1;
@@ -112,50 +170,496 @@ uint16_t NodeMessage::updateFromPacket(const LoRaReceivedPacket& packet) {
     return gap;
 }
 
+unsigned long NodeSnapshot::getAgeSeconds() const {
+    if (!hasData) return 0;
+    return (millis() - lastHeardTime) / 1000;
+}
+
+float NodeSnapshot::getPacketLossPercent() const {
+    if (messageCount == 0) return 0.0;
+    unsigned long totalExpected = messageCount + packetsLost;
+    return (float)packetsLost / totalExpected * 100.0;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SNAPSHOT LATCH                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static_assert(offsetof(NodeSnapshot, nodeId) == 0, "nodeId must be in the first latch word");
+
+/**
+ * Key of a published slot without copying the whole snapshot
+ */
+static uint8_t latchedNodeId(uint8_t copy, uint16_t slot) {
+    uint32_t word = nodeLatch.loadWord(copy, slot, 0);
+    uint8_t nodeId;
+    memcpy(&nodeId, &word, sizeof(nodeId));
+    return nodeId;
+}
+
+static void noteSnapshotRead(uint32_t retries) {
+    snapshotReads.fetch_add(1, std::memory_order_relaxed);
+    if (retries > 0) snapshotRetries.fetch_add(retries, std::memory_order_relaxed);
+}
+
+static void fillSnapshot(NodeSnapshot& snapshot, const NodeMessage& node, uint16_t slot, uint32_t publishCount) {
+    snapshot.nodeId = node.nodeId;
+    snapshot.slot = slot;
+    snapshot.hasData = node.hasData;
+    snapshot.isOnline = node.isOnline;
+    snapshot.lastRssi = node.lastRssi;
+    snapshot.lastSnr = node.lastSnr;
+    snapshot.lastHeardTime = node.lastHeardTime;
+    snapshot.messageCount = node.messageCount;
+    snapshot.packetsLost = node.packetsLost;
+    snapshot.publishCount = publishCount;
+    snapshot.lastReport = node.lastReport;
+}
+
+static void publishSlot(uint16_t slot) {
+    // Only the writer stores to the latch, so its own copy is stable
+    NodeSnapshot snapshot;
+    nodeLatch.load(1, slot, snapshot);
+    fillSnapshot(snapshot, nodeTable[slot], slot, snapshot.publishCount + 1);
+    nodeLatch.publish(slot, snapshot);
+    snapshotsPublished++;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         NODE TABLE                                        ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static bool isLiveId(uint8_t nodeId) {
+    return nodeId != NODE_ID_EMPTY && nodeId != NODE_ID_TOMBSTONE;
+}
+
+/**
+ * First slot to probe. Node IDs are small integers, so the ID itself spreads
+ * them perfectly and keeps slot order = ID order below NODE_TABLE_SIZE.
+ */
+static uint16_t homeSlot(uint8_t nodeId) {
+    return nodeId & (NODE_TABLE_SIZE - 1);
+}
+
+static uint16_t nextSlot(uint16_t slot) {
+    return (slot + 1) & (NODE_TABLE_SIZE - 1);
+}
+
+/**
+ * Linear probe for nodeId, stops at the first never-used slot
+ * @return slot, or -1 if not in the table
+ */
+static int16_t findSlot(uint8_t nodeId) {
+    uint16_t slot = homeSlot(nodeId);
+    for (uint16_t probe = 0; probe < NODE_TABLE_SIZE; probe++) {
+        uint8_t key = nodeTable[slot].nodeId;
+        if (key == nodeId) return slot;
+        if (key == NODE_ID_EMPTY) return -1;
+        slot = nextSlot(slot);
+    }
+    return -1;
+}
+
+/**
+ * Evict the least recently heard node that is long dead
+ * @return true if a slot was freed
+ */
+static bool evictLeastRecent() {
+    unsigned long now = millis();
+    int16_t victim = -1;
+    unsigned long victimAge = 0;
+
+    for (uint16_t slot = 0; slot < NODE_TABLE_SIZE; slot++) {
+        const NodeMessage& node = nodeTable[slot];
+        if (!isLiveId(node.nodeId) || node.nodeId == DEVICE_ID) continue;
+
+        unsigned long age = now - node.lastHeardTime;
+        if (age >= NODE_EVICT_AGE_MS && (victim < 0 || age > victimAge)) {
+            victim = slot;
+            victimAge = age;
+        }
+    }
+    if (victim < 0) return false;
+
+    // Tombstone keeps probes for nodes stored past this slot working
+    nodeTable[victim].clear();
+    nodeTable[victim].nodeId = NODE_ID_TOMBSTONE;
+    publishSlot(victim);
+    liveNodes.fetch_sub(1, std::memory_order_relaxed);
+    tombstones++;
+    nodesEvicted++;
+    return true;
+}
+
+/**
+ * Add nodeId (known not to be in the table)
+ * @return slot, or -1 if the table is full of live nodes
+ */
+static int16_t insertSlot(uint8_t nodeId) {
+    if (liveNodes.load(std::memory_order_relaxed) >= NODE_TABLE_MAX_LIVE && !evictLeastRecent()) {
+        nodesRejected++;
+        return -1;
+    }
+
+    // First unused slot on the probe path (tombstone or never used)
+    uint16_t slot = homeSlot(nodeId);
+    for (uint16_t probe = 0; probe < NODE_TABLE_SIZE; probe++) {
+        NodeMessage& node = nodeTable[slot];
+        if (!isLiveId(node.nodeId)) {
+            if (node.nodeId == NODE_ID_TOMBSTONE) tombstones--;
+            node.clear();
+            node.nodeId = nodeId;
+            liveNodes.fetch_add(1, std::memory_order_relaxed);
+            nodesInserted++;
+            return slot;
+        }
+        slot = nextSlot(slot);
+    }
+
+    nodesRejected++;
+    return -1;
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         NODE STORE FUNCTIONS                              ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 void initNodeStore() {
-    for (uint8_t i = 0; i < MESH_MAX_NODES; i++) {
-        nodeStore[i].clear();
+    nodeLatch.reset();
+    for (uint16_t slot = 0; slot < NODE_TABLE_SIZE; slot++) {
+        nodeTable[slot].nodeId = NODE_ID_EMPTY;
+        nodeTable[slot].clear();
     }
+    liveNodes.store(0);
+    tombstones = 0;
+    nodesInserted = 0;
+    nodesEvicted = 0;
+    nodesRejected = 0;
+
+    // Own node is always present (the dashboard shows the gateway)
+    getNodeMessage(DEVICE_ID);
+    publishNode(DEVICE_ID);
 }
 
 NodeMessage* getNodeMessage(uint8_t nodeId) {
-    if (nodeId < 1 || nodeId > MESH_MAX_NODES) return nullptr;
-    return &nodeStore[nodeId - 1];
+    if (!isLiveId(nodeId)) return nullptr;
+
+    int16_t slot = findSlot(nodeId);
+    if (slot < 0) {
+        slot = insertSlot(nodeId);
+        if (slot < 0) return nullptr;
+    }
+    return &nodeTable[slot];
+}
+
+NodeMessage* findNodeMessage(uint8_t nodeId) {
+    if (!isLiveId(nodeId)) return nullptr;
+
+    int16_t slot = findSlot(nodeId);
+    return (slot < 0) ? nullptr : &nodeTable[slot];
+}
+
+void publishNode(uint8_t nodeId) {
+    if (!isLiveId(nodeId)) return;
+
+    int16_t slot = findSlot(nodeId);
+    if (slot >= 0) publishSlot(slot);
+}
+
+bool readNodeSnapshot(uint8_t nodeId, NodeSnapshot& snapshot) {
+    if (!isLiveId(nodeId)) return false;
+
+    uint32_t retries = 0;
+    bool found;
+
+    // Same probe as findSlot(), on the published copy readers may use
+    while (true) {
+        uint32_t sequence = nodeLatch.beginRead();
+        uint8_t copy = sequence & 1;
+
+        found = false;
+        uint16_t slot = homeSlot(nodeId);
+        for (uint16_t probe = 0; probe < NODE_TABLE_SIZE; probe++) {
+            uint8_t key = latchedNodeId(copy, slot);
+            if (key == nodeId) {
+                nodeLatch.load(copy, slot, snapshot);
+                found = true;
+                break;
+            }
+            if (key == NODE_ID_EMPTY) break;
+            slot = nextSlot(slot);
+        }
+
+        if (!nodeLatch.retryRead(sequence)) break;
+        retries++;
+    }
+
+    noteSnapshotRead(retries);
+    return found && snapshot.nodeId == nodeId;
+}
+
+bool nextLiveNode(uint16_t& cursor, NodeSnapshot& snapshot) {
+    while (cursor < NODE_TABLE_SIZE) {
+        uint16_t slot = cursor++;
+
+        // Cheap look at the key first, most slots are unused
+        if (!isLiveId(latchedNodeId(0, slot)) && !isLiveId(latchedNodeId(1, slot))) {
+            continue;
+        }
+
+        noteSnapshotRead(nodeLatch.read(slot, 1, &snapshot));
+        if (isLiveId(snapshot.nodeId)) return true;
+    }
+    return false;
+}
+
+uint32_t getNodeStoreSequence() {
+    return nodeLatch.getSequence();
+}
+
+SnapshotStats getSnapshotStats() {
+    SnapshotStats stats;
+    stats.published = snapshotsPublished;
+    stats.reads = snapshotReads.load(std::memory_order_relaxed);
+    stats.retries = snapshotRetries.load(std::memory_order_relaxed);
+    return stats;
+}
+
+NodeTableStats getNodeTableStats() {
+    NodeTableStats stats;
+    stats.live = liveNodes.load(std::memory_order_relaxed);
+    stats.tombstones = tombstones;
+    stats.inserted = nodesInserted;
+    stats.evicted = nodesEvicted;
+    stats.rejected = nodesRejected;
+    stats.bytesPerSlot = sizeof(NodeMessage) + 2 * sizeof(NodeSnapshot);
+    return stats;
+}
+
+void printNodeTable() {
+    NodeTableStats stats = getNodeTableStats();
+    uint32_t totalBytes = (uint32_t)stats.bytesPerSlot * NODE_TABLE_SIZE;
+
+    printHeader("NODE TABLE");
+    printRow("Live nodes", String(stats.live) + " / " + String(NODE_TABLE_MAX_LIVE) +
+             " (" + String(NODE_TABLE_SIZE) + " slots)");
+    printRow("Tombstones", String(stats.tombstones));
+    printRow("Inserted", String(stats.inserted));
+    printRow("Evicted", String(stats.evicted) + " (silent > " + String(NODE_EVICT_AGE_MS / 60000) + " min)");
+    printRow("Rejected", String(stats.rejected));
+    printDivider();
+    printRow("Entry", String(sizeof(NodeMessage)) + " bytes");
+    printRow("Published copy", String(sizeof(NodeSnapshot)) + " bytes x 2");
+    printRow("Per node", String(stats.bytesPerSlot) + " bytes");
+    printRow("Table total", String(totalBytes) + " bytes");
+    printDivider();
+
+    uint16_t cursor = 0;
+    NodeSnapshot node;
+    while (nextLiveNode(cursor, node)) {
+        String label = "  Node " + String(node.nodeId);
+        printRow(label.c_str(), "slot " + String(node.slot) + ", " + String(node.messageCount) +
+                 " msgs, heard " + String(node.getAgeSeconds()) + "s ago");
+    }
+    printFooter();
 }
 
 void checkNodeTimeouts() {
-    for (uint8_t i = 0; i < MESH_MAX_NODES; i++) {
-        uint8_t nodeId = i + 1;
-        if (nodeId == DEVICE_ID) continue;
-        
-        NodeMessage* node = &nodeStore[i];
+    for (uint16_t slot = 0; slot < NODE_TABLE_SIZE; slot++) {
+        NodeMessage* node = &nodeTable[slot];
+        if (!isLiveId(node->nodeId) || node->nodeId == DEVICE_ID) continue;
+
         if (node->hasData && node->isOnline && node->hasTimedOut(NODE_TIMEOUT_MS)) {
-            printNodeOfflineAlert(nodeId, node->getAgeSeconds());
+            printNodeOfflineAlert(node->nodeId, node->getAgeSeconds());
             node->isOnline = false;
+            publishSlot(slot);
         }
     }
 }
 
 String getNodeStatusIcon(uint8_t nodeId) {
     if (nodeId == DEVICE_ID) return "[*]";
-    if (nodeId < 1 || nodeId > MESH_MAX_NODES) return "[?]";
+    if (!isLiveId(nodeId)) return "[?]";
 
-    NodeMessage* node = &nodeStore[nodeId - 1];
-    if (!node->hasData) return "[ ]";
-    if (node->isOnline) return "[O]";
+    NodeSnapshot node;
+    if (!readNodeSnapshot(nodeId, node)) return "[ ]";
+    if (!node.hasData) return "[ ]";
+    if (node.isOnline) return "[O]";
     return "[x]";
 }
 
 uint8_t getNodeCount() {
-    uint8_t count = 0;
-    for (uint8_t i = 0; i < MESH_MAX_NODES; i++) {
-        if (nodeStore[i].hasData) {
+    uint16_t count = 0;
+    uint16_t cursor = 0;
+    NodeSnapshot node;
+    while (nextLiveNode(cursor, node)) {
+        if (node.hasData) {
             count++;
         }
     }
-    return count;
+    return (count > 255) ? 255 : count;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STRESS TEST                                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+typedef SnapshotLatch<NodeSnapshot, SNAPSHOT_STRESS_NODES> StressLatch;
+
+struct SnapshotStress {
+    StressLatch* latch;
+    volatile bool running;
+    std::atomic<uint32_t> reads;
+    std::atomic<uint32_t> retries;
+    std::atomic<uint32_t> torn;          // Latched views that never existed (must stay 0)
+    std::atomic<uint32_t> tornUnlatched; // Same check on plain copies (control)
+    std::atomic<uint8_t> finished;
+};
+
+/**
+ * Test pattern: every field of round k's snapshot is derived from k
+ */
+static void fillStressSnapshot(NodeSnapshot& snapshot, uint32_t k) {
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.hasData = true;
+    snapshot.lastHeardTime = k;
+    snapshot.messageCount = k;
+    snapshot.packetsLost = ~k;
+    snapshot.publishCount = k;
+    snapshot.lastReport.uptime_sec = k;
+    snapshot.lastReport.latitude_x1e6 = (int32_t)k;
+    snapshot.lastReport.longitude_x1e6 = -(int32_t)k;
+    snapshot.lastReport.meshHeader.messageId = (uint8_t)k;
+}
+
+static bool stressSnapshotValid(const NodeSnapshot& snapshot) {
+    uint32_t k = snapshot.publishCount;
+    return snapshot.lastHeardTime == k &&
+           snapshot.messageCount == k &&
+           snapshot.packetsLost == (unsigned long)~k &&
+           snapshot.lastReport.uptime_sec == k &&
+           snapshot.lastReport.latitude_x1e6 == (int32_t)k &&
+           snapshot.lastReport.longitude_x1e6 == -(int32_t)k &&
+           snapshot.lastReport.meshHeader.messageId == (uint8_t)k;
+}
+
+/**
+ * A round publishes nodes in order, so a real state is some nodes at round
+ * k and the rest still at k - 1
+ */
+static bool stressViewValid(const NodeSnapshot* view) {
+    uint32_t first = view[0].publishCount;
+    bool behind = false;
+
+    for (uint8_t i = 0; i < SNAPSHOT_STRESS_NODES; i++) {
+        if (!stressSnapshotValid(view[i])) return false;
+        uint32_t k = view[i].publishCount;
+        if (k == first && !behind) continue;
+        if (k != first - 1) return false;
+        behind = true;
+    }
+    return true;
+}
+
+static void snapshotStressReader(void* param) {
+    SnapshotStress* stress = (SnapshotStress*)param;
+    NodeSnapshot view[SNAPSHOT_STRESS_NODES];
+    uint32_t iteration = 0;
+
+    while (stress->running) {
+        uint32_t retries = stress->latch->read(0, SNAPSHOT_STRESS_NODES, view);
+        stress->retries.fetch_add(retries, std::memory_order_relaxed);
+        if (!stressViewValid(view)) stress->torn.fetch_add(1, std::memory_order_relaxed);
+
+        // Control: the same copy without the sequence check
+        for (uint8_t i = 0; i < SNAPSHOT_STRESS_NODES; i++) {
+            stress->latch->load(0, i, view[i]);
+        }
+        if (!stressViewValid(view)) stress->tornUnlatched.fetch_add(1, std::memory_order_relaxed);
+
+        stress->reads.fetch_add(1, std::memory_order_relaxed);
+
+        // Let the idle task run (task watchdog)
+        if ((++iteration & 0xFF) == 0) vTaskDelay(1);
+    }
+
+    stress->finished.fetch_add(1);
+    vTaskDelete(nullptr);
+}
+
+void runSnapshotStressTest() {
+    SnapshotStress* stress = new (std::nothrow) SnapshotStress();
+    StressLatch* latch = new (std::nothrow) StressLatch();
+    if (stress == nullptr || latch == nullptr) {
+        Serial.println(F("Not enough heap for the stress test"));
+        delete stress;
+        delete latch;
+        return;
+    }
+    latch->reset();
+    stress->latch = latch;
+
+    NodeSnapshot snapshot;
+    uint32_t k = 1;
+    for (uint8_t i = 0; i < SNAPSHOT_STRESS_NODES; i++) {
+        fillStressSnapshot(snapshot, k);
+        stress->latch->publish(i, snapshot);
+    }
+    stress->running = true;
+
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  NODE SNAPSHOT STRESS TEST                                    ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  Writer: loop task, readers: one task per core, %u ms\n", SNAPSHOT_STRESS_MS);
+
+    uint8_t readers = 0;
+    for (BaseType_t core = 0; core < 2; core++) {
+        if (xTaskCreatePinnedToCore(snapshotStressReader, "snapStress", SNAPSHOT_STRESS_STACK_SIZE,
+                                    stress, 1, nullptr, core) == pdPASS) {
+            readers++;
+        }
+    }
+
+    unsigned long start = millis();
+    unsigned long publishUs = 0;
+    uint32_t publishes = 0;
+    while (millis() - start < SNAPSHOT_STRESS_MS) {
+        k++;
+        unsigned long t0 = micros();
+        for (uint8_t i = 0; i < SNAPSHOT_STRESS_NODES; i++) {
+            fillStressSnapshot(snapshot, k);
+            stress->latch->publish(i, snapshot);
+        }
+        publishUs += micros() - t0;
+        publishes += SNAPSHOT_STRESS_NODES;
+        if ((k & 0xFF) == 0) delay(1);
+    }
+
+    stress->running = false;
+    unsigned long waitStart = millis();
+    while (stress->finished.load() < readers && millis() - waitStart < 1000) {
+        delay(10);
+    }
+
+    Serial.printf("  Reader tasks:     %u\n", readers);
+    Serial.printf("  Publishes:        %lu (%.2f us each)\n", (unsigned long)publishes,
+                  publishes > 0 ? (float)publishUs / publishes : 0.0f);
+    Serial.printf("  Views read:       %lu (%lu retries)\n",
+                  (unsigned long)stress->reads.load(), (unsigned long)stress->retries.load());
+    Serial.printf("  Torn (latched):   %lu  %s\n", (unsigned long)stress->torn.load(),
+                  stress->torn.load() == 0 ? "OK" : "FAIL");
+    Serial.printf("  Torn (unlatched): %lu  (control, no sequence check)\n",
+                  (unsigned long)stress->tornUnlatched.load());
+
+    SnapshotStats stats = getSnapshotStats();
+    Serial.printf("  Node store:       %lu published, %lu reads, %lu retries\n",
+                  stats.published, stats.reads, stats.retries);
+    Serial.println();
+
+    // Readers that did not stop in time still hold the pointers
+    if (stress->finished.load() == readers) {
+        delete stress->latch;
+        delete stress;
+    }
 }
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include "serial_output.h"
 #include "serial_json.h"
 #include "display_manager.h"
-#include "thingspeak.h"
 #include "neighbor_table.h"
 #include "duplicate_cache.h"
 #include "transmit_queue.h"
@@ -14,16 +13,20 @@
 #include "network_topology.h"
 #include "gradient_routing.h"
 #include "network_time.h"
+#include "traffic_generator.h"
+#include "reorder_buffer.h"
+#include "gateway_sync.h"
+#include "boot_metrics.h"
+#include "tdma_scheduler.h"
+#include "mesh_schema.h"
+#include "metrics.h"
+#include "slot_monitor.h"
+#include "rate_limiter.h"
 
-// ╔═══════════════════════════════════════════════════════════════════════════╗
-// ║                         STATISTICS                                        ║
-// ╚═══════════════════════════════════════════════════════════════════════════╝
+// External references
+extern TDMAScheduler tdmaScheduler;
 
-static unsigned long rxCount = 0;
-static unsigned long duplicateRxMessages = 0;
-static unsigned long validRxMessages = 0;
-static unsigned long duplicatesDropped = 0;  // Mesh-level duplicates (from duplicate cache)
-static unsigned long packetsForwarded = 0;   // Packets scheduled for forwarding
+// Counters live in the metrics registry (metrics.h)
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         LAST RECEIVED REPORT                              ║
@@ -33,19 +36,138 @@ static FullReportMsg lastReceivedReport;
 static bool lastReportValid = false;
 static uint8_t lastReportOrigin = 0;
 
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REPORT DELIVERY                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Hand a FULL_REPORT to node statistics, serial output and uplinks
+ * On the gateway this is called by the reorder buffer, so reports from each
+ * source arrive here in messageId order.
+ */
+static void deliverFullReport(const LoRaReceivedPacket& packet, const FullReportMsg& report) {
+    // Update node store for the ORIGINAL SOURCE (not the forwarder)
+    NodeMessage* node = getNodeMessage(report.meshHeader.sourceId);
+    uint16_t gap = 0;
+    unsigned long msgCount = 0;
+    unsigned long lost = 0;
+    float lossPercent = 0.0;
+
+    if (node != nullptr) {
+        // A late report must not replace the newer one already stored
+        bool late = node->isLateMeshPacket(report.meshHeader.messageId);
+
+        // Update packet tracking stats (only for the original source)
+        // Use mesh messageId for gap detection (not LoRa seq)
+        gap = node->updateFromMeshPacket(packet, report.meshHeader.messageId);
+        msgCount = node->messageCount;
+        lost = node->packetsLost;
+        lossPercent = node->getPacketLossPercent();
+
+        // Store the decoded report
+        if (!late) {
+            node->lastReport = report;
+        }
+        publishNode(report.meshHeader.sourceId);
+    }
+
+    // Print fancy FULL_REPORT output
+    printRxFullReport(packet, report, gap, msgCount, lost, lossPercent);
+
+    // Send to the cloud uplink (gateway only, deduplicated across gateways)
+    if (IS_GATEWAY) {
+        gatewayUplinkReport(report, packet.rssi);
+    }
+
+    // Output JSON for desktop dashboard (serial bridge)
+    outputNodeDataJson(report.meshHeader.sourceId, report, packet.rssi, packet.snr);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RX HEADER FILTER                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * Count and log a FULL_REPORT we already processed
+ */
+static void noteReportDuplicate(const MeshHeader& header) {
+    incrementDuplicatesDropped();
+    debugLogDuplicate(header.sourceId, header.messageId, true);
+    if (IS_GATEWAY) {
+        reorderBuffer.noteDuplicate(header.sourceId, header.senderId);
+    }
+    Serial.print(F("🚫 Duplicate mesh message from Node "));
+    Serial.print(header.sourceId);
+    Serial.print(F(" msg #"));
+    Serial.print(header.messageId);
+    Serial.print(F(" (dropped, total: "));
+    Serial.print(metricGet(MET_DUPLICATES_DROPPED));
+    Serial.println(F(")"));
+}
+
+/**
+ * Count a frame dropped by the filter like one handed to the packet handler
+ */
+static void noteFilteredFrame(uint8_t messageType) {
+    metricInc(MET_RX_FRAMES);
+    metricIncLabel(FAM_RX_BY_TYPE, messageType);
+}
+
+/**
+ * Decide from the MeshHeader alone whether a frame is worth reading
+ * Own frames echoed back by relays, FULL_REPORT duplicates and frames over
+ * the sender's rate limit are dropped while their payload is still in the
+ * radio FIFO.
+ */
+static bool acceptRxHeader(const LoRaPacketHeader& header, const uint8_t* payloadHead, uint8_t headLen) {
+    if (headLen < sizeof(MeshHeader)) {
+        return true;  // Too short for a mesh frame, let the full path decide
+    }
+
+    MeshHeader meshHeader;
+    memcpy(&meshHeader, payloadHead, sizeof(MeshHeader));
+    if (meshHeader.version != MESH_PROTOCOL_VERSION) {
+        // Legacy text frame: only the LoRa header names the sender
+        return rateLimiter.allow(header.originId, RATE_RX_OTHER);
+    }
+
+    if (meshHeader.sourceId == DEVICE_ID) {
+        noteFilteredFrame(meshHeader.messageType);
+        return false;
+    }
+
+    if (meshHeader.messageType == MSG_FULL_REPORT &&
+        duplicateCache.isDuplicate(meshHeader.sourceId, meshHeader.messageId)) {
+        noteFilteredFrame(meshHeader.messageType);
+        noteReportDuplicate(meshHeader);
+        return false;
+    }
+
+    // Only new frames spend tokens. Beacon copies come from every relay,
+    // so beacons are charged to the neighbor that sent them.
+    RateClass rateClass = rateClassForType(meshHeader.messageType);
+    uint8_t chargedNode = (rateClass == RATE_RX_BEACON) ? meshHeader.senderId : meshHeader.sourceId;
+    if (!rateLimiter.allow(chargedNode, rateClass)) {
+        noteFilteredFrame(meshHeader.messageType);
+        return false;
+    }
+
+    return true;
+}
+
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         INITIALIZATION                                    ║
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 void initPacketHandler() {
     duplicateCache.clear();
-    rxCount = 0;
-    duplicateRxMessages = 0;
-    validRxMessages = 0;
-    duplicatesDropped = 0;
-    packetsForwarded = 0;
     lastReportValid = false;
     lastReportOrigin = 0;
+    reorderBuffer.clear();
+    reorderBuffer.setDeliveryHandler(deliverFullReport);
+    rateLimiter.clear();
+    rateLimiter.setEnabled(USE_RATE_LIMIT);
+    setRxHeaderFilter(acceptRxHeader);
 }
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -67,8 +189,16 @@ bool shouldForward(MeshHeader* header) {
         return false;
     }
 
-    // Gateway doesn't forward broadcasts (to prevent loops)
-    if (IS_GATEWAY && header->destId == ADDR_BROADCAST) {
+    // Leaf builds only source reports
+    if (!ROLE_FORWARDS) {
+        debugLogForwardDecision(false, "Leaf node", header);
+        return false;
+    }
+
+    // Gateway doesn't forward broadcasts or gateway-bound traffic (to prevent loops)
+    // Another gateway's report still terminates here: it is uploaded or claimed
+    if (IS_GATEWAY && (header->destId == ADDR_BROADCAST || header->destId == ADDR_GATEWAY ||
+                       isGatewayId(header->destId))) {
         incrementGatewayBroadcastSkips();
         debugLogForwardDecision(false, "Gateway broadcast loop prevention", header);
         return false;
@@ -90,7 +220,8 @@ bool shouldForward(MeshHeader* header) {
         // The senderId tells us who we heard this from directly
         // If the immediate sender is our next-hop toward gateway, don't forward
         // (that would send it backwards away from gateway)
-        uint8_t nextHop = getNextHop();
+        // Anycast: use our route to the addressed gateway when we have one
+        uint8_t nextHop = getNextHopFor(header->destId);
         if (header->senderId == nextHop) {
             // Packet came FROM our route toward gateway - don't send it back
             debugLogForwardDecision(false, "Packet from next-hop (wrong direction)", header);
@@ -107,14 +238,20 @@ bool shouldForward(MeshHeader* header) {
     return true;
 }
 
-void scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header) {
+bool scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header) {
     // Create a copy of the packet for modification
     uint8_t forwardBuffer[64];
 
     // Validate length
     if (len == 0 || len > 64) {
         Serial.println(F("⚠️ Forward failed: invalid packet length"));
-        return;
+        return false;
+    }
+
+    // One source may not take over the queue (load-test frames are meant to fill it)
+    if (header->messageType != MSG_LOAD_TEST && !rateLimiter.allow(header->sourceId, RATE_FORWARD)) {
+        debugLogForwardDecision(false, "Source over forward rate limit", header);
+        return false;
     }
 
     // Copy packet data to local buffer
@@ -139,7 +276,7 @@ void scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header) {
     uint8_t nextHop = 0;
 
     if (useGradientRouting) {
-        nextHop = getNextHop();
+        nextHop = getNextHopFor(header->destId);
         incrementUnicastForwards();
 
         Serial.println(F(""));
@@ -166,6 +303,7 @@ void scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header) {
     // next-hop should continue forwarding toward the gateway
     if (transmitQueue.enqueue(forwardBuffer, len)) {
         // Success - log the forward action
+        metricIncLabel(FAM_FORWARDS_BY_NODE, forwardHeader->sourceId);
         debugLogQueueOp("Enqueue success", transmitQueue.depth(), TX_QUEUE_SIZE);
 
         Serial.print(F("  Source: Node "));
@@ -179,6 +317,7 @@ void scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header) {
         Serial.print(F("  |  Queue: "));
         Serial.println(transmitQueue.depth());
         Serial.println(F("─────────────────────────────────────────────────────────────"));
+        return true;
     } else {
         // Queue full - log warning and increment overflow counter
         incrementQueueOverflows();
@@ -188,6 +327,7 @@ void scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header) {
         Serial.print(F(" msgId="));
         Serial.println(forwardHeader->messageId);
         Serial.println(F("─────────────────────────────────────────────────────────────"));
+        return false;
     }
 }
 
@@ -198,13 +338,24 @@ void scheduleForward(uint8_t* data, uint8_t len, MeshHeader* header) {
 void checkForIncomingMessages() {
     LoRaReceivedPacket packet;
 
-    while (receivePacket(packet)) {
-        // Update statistics
-        rxCount++;
+    // Release held reports whose gap was never filled
+    if (IS_GATEWAY) {
+        reorderBuffer.flushExpired();
+    }
 
+    while (receivePacket(packet)) {
         // Get message type from raw bytes
         MessageType msgType = getMessageType(packet.payloadBytes, packet.payloadLen);
 
+        // Update statistics
+        metricInc(MET_RX_FRAMES);
+        metricIncLabel(FAM_RX_BY_TYPE, msgType);
+        metricObserve(HIST_RX_RSSI, (int32_t)packet.rssi);
+        bootNoteRx();
+
+        // Gateway (and optionally relays): was the sender inside its TDMA slot?
+        slotMonitor.noteFrame(packet, msgType);
+
         // ═══════════════════════════════════════════════════════════════════════
         // BEACON MESSAGE HANDLING (Gradient Routing)
         // ═══════════════════════════════════════════════════════════════════════
@@ -216,6 +367,31 @@ void checkForIncomingMessages() {
                     continue;
                 }
 
+                // A beacon outside seconds 0-3 can collide with data slots
+                if (USE_BEACON_SUBFRAME && tdmaScheduler.getStatus().timeSynced &&
+                    !tdmaScheduler.isInBeaconSubframe()) {
+                    noteBeaconOutOfPhase();
+                }
+
+                // Drop stale beacons and echoes before they touch routing or time
+                BeaconCheck freshness = checkBeaconFreshness(beacon);
+                if (freshness == BEACON_DUPLICATE || freshness == BEACON_STALE) {
+                    if (freshness == BEACON_STALE) {
+                        Serial.printf("  Stale beacon dropped: gateway %u epoch %u seq %u\n",
+                                      beacon.gatewayId, beacon.epoch, beacon.sequenceNumber);
+                    }
+                    neighborTable.update(beacon.meshHeader.senderId, packet.rssi);
+                    continue;
+                }
+
+                // Another copy of the current beacon may still offer a better route
+                if (freshness == BEACON_ROUTE_COPY) {
+                    updateRoutingState(beacon.distanceToGateway, beacon.meshHeader.senderId,
+                                       beacon.gatewayId, beacon.sequenceNumber, (int16_t)packet.rssi);
+                    neighborTable.update(beacon.meshHeader.senderId, packet.rssi);
+                    continue;
+                }
+
                 // Log beacon reception
                 Serial.println(F(""));
                 Serial.println(F("╔═══════════════════════════════════════════════════════════╗"));
@@ -229,6 +405,8 @@ void checkForIncomingMessages() {
                 Serial.println(beacon.meshHeader.ttl);
                 Serial.print(F("  Gateway: "));
                 Serial.print(beacon.gatewayId);
+                Serial.print(F("  |  Epoch: "));
+                Serial.print(beacon.epoch);
                 Serial.print(F("  |  Seq: "));
                 Serial.print(beacon.sequenceNumber);
                 Serial.print(F("  |  RSSI: "));
@@ -249,12 +427,19 @@ void checkForIncomingMessages() {
                 // NETWORK TIME SYNC: Extract GPS time from beacon
                 // Hop count = distanceToGateway + 1 (gateway is distance 0, so
                 // receiving from gateway = 1 hop from GPS source)
+                // Sub-frame beacons also give the phase within the second:
+                // sender's micro-slot + airtime + our processing delay
                 // ─────────────────────────────────────────────────────────────────
                 if (beacon.gpsValid) {
                     uint8_t timeHopCount = beacon.distanceToGateway + 1;
+                    uint16_t phaseMs = 0;
+                    if (isSubframeBeacon(beacon)) {
+                        phaseMs = getBeaconSlotOffsetMs(beacon.distanceToGateway, beacon.meshHeader.senderId) +
+                                  BEACON_AIRTIME_MS + (uint16_t)(millis() - packet.receivedAtMs);
+                    }
                     updateNetworkTime(beacon.gpsHour, beacon.gpsMinute,
                                      beacon.gpsSecond, beacon.meshHeader.senderId,
-                                     timeHopCount);
+                                     timeHopCount, phaseMs);
                     Serial.print(F("  Time Sync: "));
                     Serial.print(beacon.gpsHour);
                     Serial.print(F(":"));
@@ -268,8 +453,14 @@ void checkForIncomingMessages() {
                     Serial.println(F(")"));
                 }
 
+                // Gateway measured our reports off our TX second: shift network time
+                if (beacon.correctionNodeId == DEVICE_ID &&
+                    applyNetworkTimeCorrection(beacon.correctionMs)) {
+                    metricInc(MET_SLOT_CORRECTIONS_APPLIED);
+                }
+
                 // Schedule beacon rebroadcast (non-gateway nodes only)
-                scheduleBeaconRebroadcast(beacon, (int16_t)packet.rssi);
+                scheduleBeaconRebroadcast(beacon, packet.receivedAtMs);
 
                 // Update neighbor table with beacon sender
                 neighborTable.update(beacon.meshHeader.senderId, packet.rssi);
@@ -277,6 +468,66 @@ void checkForIncomingMessages() {
             continue;  // Don't process beacon as data packet
         }
 
+        // ═══════════════════════════════════════════════════════════════════════
+        // LOAD TEST FRAME HANDLING (Traffic Generator)
+        // Gateway measures, relays forward like any other report
+        // ═══════════════════════════════════════════════════════════════════════
+        if (msgType == MSG_LOAD_TEST) {
+            if (packet.payloadLen < LOADGEN_HEADER_SIZE) {
+                continue;
+            }
+
+            MeshHeader loadHeader;
+            memcpy(&loadHeader, packet.payloadBytes, sizeof(MeshHeader));
+
+            if (loadHeader.sourceId == DEVICE_ID ||
+                isLoadTestDuplicate(packet.payloadBytes, packet.payloadLen)) {
+                continue;
+            }
+
+            neighborTable.update(loadHeader.senderId, packet.rssi);
+
+            if (IS_GATEWAY) {
+                recordLoadTestFrame(packet.payloadBytes, packet.payloadLen);
+            } else if (shouldForward(&loadHeader) &&
+                       scheduleForward(packet.payloadBytes, packet.payloadLen, &loadHeader)) {
+                metricInc(MET_FORWARDS_SCHEDULED);
+            }
+            continue;
+        }
+
+        // ═══════════════════════════════════════════════════════════════════════
+        // UPLINK CLAIM HANDLING (Multi-gateway dedupe)
+        // Gateways drop deferred uploads, everyone floods the claim onward
+        // ═══════════════════════════════════════════════════════════════════════
+        if (msgType == MSG_UPLINK_CLAIM) {
+            if (packet.payloadLen < UPLINK_CLAIM_HEADER_SIZE) {
+                continue;
+            }
+
+            MeshHeader claimHeader;
+            memcpy(&claimHeader, packet.payloadBytes, sizeof(MeshHeader));
+
+            if (claimHeader.sourceId == DEVICE_ID ||
+                isUplinkClaimDuplicate(claimHeader.sourceId, claimHeader.messageId)) {
+                continue;
+            }
+
+            neighborTable.update(claimHeader.senderId, packet.rssi);
+
+            if (IS_GATEWAY) {
+                applyUplinkClaim(packet.payloadBytes, packet.payloadLen);
+            }
+
+            // Claims travel gateway-to-gateway, away from and toward gradients,
+            // so they bypass the gradient filter and only stop on TTL
+            if (claimHeader.ttl > 1 &&
+                scheduleForward(packet.payloadBytes, packet.payloadLen, &claimHeader)) {
+                metricInc(MET_FORWARDS_SCHEDULED);
+            }
+            continue;
+        }
+
         // ═══════════════════════════════════════════════════════════════════════
         // FULL_REPORT MESSAGE HANDLING
         // ═══════════════════════════════════════════════════════════════════════
@@ -301,17 +552,8 @@ void checkForIncomingMessages() {
                 lastReceivedReport.meshHeader.sourceId,
                 lastReceivedReport.meshHeader.messageId)) {
                 // This is a duplicate from mesh forwarding - skip processing
-                duplicatesDropped++;
-                incrementDuplicatesDropped();
-                debugLogDuplicate(lastReceivedReport.meshHeader.sourceId,
-                                 lastReceivedReport.meshHeader.messageId, true);
-                Serial.print(F("🚫 Duplicate mesh message from Node "));
-                Serial.print(lastReceivedReport.meshHeader.sourceId);
-                Serial.print(F(" msg #"));
-                Serial.print(lastReceivedReport.meshHeader.messageId);
-                Serial.print(F(" (dropped, total: "));
-                Serial.print(duplicatesDropped);
-                Serial.println(F(")"));
+                // (normally already dropped by acceptRxHeader)
+                noteReportDuplicate(lastReceivedReport.meshHeader);
                 continue;
             }
 
@@ -331,8 +573,8 @@ void checkForIncomingMessages() {
             addPacketRoute(lastReceivedReport);
 
             // Update valid message counter
-            validRxMessages++;
             incrementPacketsReceived();
+            metricIncLabel(FAM_REPORTS_BY_NODE, lastReceivedReport.meshHeader.sourceId);
 
             lastReportValid = true;
             // Use sourceId from MeshHeader (original sender, not immediate sender)
@@ -341,52 +583,47 @@ void checkForIncomingMessages() {
             // Update neighbor table with immediate sender's RSSI (who we heard directly)
             neighborTable.update(lastReceivedReport.meshHeader.senderId, packet.rssi);
 
-            // Update node store for the ORIGINAL SOURCE (not the forwarder)
-            NodeMessage* node = getNodeMessage(lastReceivedReport.meshHeader.sourceId);
-            uint16_t gap = 0;
-            unsigned long msgCount = 0;
-            unsigned long lost = 0;
-            float lossPercent = 0.0;
+            // Heard straight from its source: messageId gaps are link losses
+            if (lastReceivedReport.meshHeader.senderId == lastReceivedReport.meshHeader.sourceId) {
+                neighborTable.noteMessageId(lastReceivedReport.meshHeader.sourceId,
+                                            lastReceivedReport.meshHeader.messageId);
+            }
 
-            if (node != nullptr) {
-                // Update packet tracking stats (only for the original source)
-                // Use mesh messageId for gap detection (not LoRa seq)
-                gap = node->updateFromMeshPacket(packet, lastReceivedReport.meshHeader.messageId);
-                msgCount = node->messageCount;
-                lost = node->packetsLost;
-                lossPercent = node->getPacketLossPercent();
+            // Update display with decoded data (immediate, even if held below)
+            updateRxDisplayFullReport(packet, lastReceivedReport);
 
-                // Store the decoded report
-                node->lastReport = lastReceivedReport;
+            // Gateway: age at arrival by hop count, from the source's TX slot
+            // (path length stands in for the source's depth)
+            if (IS_GATEWAY && tdmaScheduler.getStatus().timeSynced) {
+                uint8_t hops = meshHopCount(lastReceivedReport.meshHeader);
+                uint8_t sentAt = tdmaScheduler.getTransmissionSecondFor(
+                    lastReceivedReport.meshHeader.sourceId, hops);
+                recordReportAge(hops, (tdmaScheduler.getCurrentSecond() + 60 - sentAt) % 60);
             }
 
-            // Print fancy FULL_REPORT output
-            printRxFullReport(packet, lastReceivedReport, gap, msgCount, lost, lossPercent);
-
-            // Update display with decoded data
-            updateRxDisplayFullReport(packet, lastReceivedReport);
-            // Send to ThingSpeak cloud (gateway only)
+            // Gateway: restore per-source order across relay paths
             if (IS_GATEWAY) {
-                sendToThingSpeak(lastReceivedReport.meshHeader.sourceId, lastReceivedReport, packet.rssi);
+                reorderBuffer.submit(packet, lastReceivedReport);
+            } else {
+                deliverFullReport(packet, lastReceivedReport);
             }
 
-            // Output JSON for desktop dashboard (serial bridge)
-            outputNodeDataJson(lastReceivedReport.meshHeader.sourceId, lastReceivedReport, packet.rssi, packet.snr);
-
             // ─────────────────────────────────────────────────────────────────────
             // Check if packet should be forwarded to other nodes
             // ─────────────────────────────────────────────────────────────────────
-            if (shouldForward(&lastReceivedReport.meshHeader)) {
-                scheduleForward(packet.payloadBytes, packet.payloadLen, &lastReceivedReport.meshHeader);
-                packetsForwarded++;
+            if (shouldForward(&lastReceivedReport.meshHeader) &&
+                scheduleForward(packet.payloadBytes, packet.payloadLen, &lastReceivedReport.meshHeader)) {
+                metricInc(MET_FORWARDS_SCHEDULED);
             }
         } else {
             // Legacy string message or decode failure
-            duplicateRxMessages++;  // Use old counter for non-mesh messages
+            metricInc(MET_RX_LEGACY_DUPLICATES);  // Use old counter for non-mesh messages
             lastReportValid = false;
 
-            // For legacy messages, use LoRa header originId to track stats
-            NodeMessage* legacyNode = getNodeMessage(packet.header.originId);
+            // For legacy messages, use LoRa header originId to track stats.
+            // Only nodes already known from a decoded report: noise or a
+            // babbling sender must not fill the node table.
+            NodeMessage* legacyNode = findNodeMessage(packet.header.originId);
             uint16_t gap = 0;
             unsigned long msgCount = 0;
             unsigned long lost = 0;
@@ -397,6 +634,7 @@ void checkForIncomingMessages() {
                 msgCount = legacyNode->messageCount;
                 lost = legacyNode->packetsLost;
                 lossPercent = legacyNode->getPacketLossPercent();
+                publishNode(packet.header.originId);
             }
 
             printRxPacket(packet, gap, msgCount, lost, lossPercent);
@@ -410,23 +648,23 @@ void checkForIncomingMessages() {
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 unsigned long getRxCount() {
-    return rxCount;
+    return metricGet(MET_RX_FRAMES);
 }
 
 unsigned long getDuplicateCount() {
-    return duplicateRxMessages;
+    return metricGet(MET_RX_LEGACY_DUPLICATES);
 }
 
 unsigned long getValidRxCount() {
-    return validRxMessages;
+    return metricGet(MET_PACKETS_RECEIVED);
 }
 
 unsigned long getDuplicatesDroppedCount() {
-    return duplicatesDropped;
+    return metricGet(MET_DUPLICATES_DROPPED);
 }
 
 unsigned long getPacketsForwardedCount() {
-    return packetsForwarded;
+    return metricGet(MET_FORWARDS_SCHEDULED);
 }
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
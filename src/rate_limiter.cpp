@@ -0,0 +1,270 @@
+#include "rate_limiter.h"
+#include "mesh_protocol.h"
+#include "metrics.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+RateLimiter rateLimiter;
+
+static const uint32_t RATE_TOKEN_UNITS = 60000;    // One frame; perMinute units are added per ms
+
+static const char* const RATE_CLASS_NAMES[RATE_CLASS_COUNT] = {
+    "report", "beacon", "claim", "load", "other", "forward"
+};
+
+// Same order as RateClass
+static const RateLimit DEFAULT_LIMITS[RATE_CLASS_COUNT] = {
+    { RATE_REPORT_PER_MIN,  RATE_REPORT_BURST },
+    { RATE_BEACON_PER_MIN,  RATE_BEACON_BURST },
+    { RATE_CLAIM_PER_MIN,   RATE_CLAIM_BURST },
+    { 0,                    0 },
+    { RATE_OTHER_PER_MIN,   RATE_OTHER_BURST },
+    { RATE_FORWARD_PER_MIN, RATE_FORWARD_BURST }
+};
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HELPERS                                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+RateClass rateClassForType(uint8_t messageType) {
+    switch (messageType) {
+        case MSG_FULL_REPORT:  return RATE_RX_REPORT;
+        case MSG_BEACON:       return RATE_RX_BEACON;
+        case MSG_UPLINK_CLAIM: return RATE_RX_CLAIM;
+        case MSG_LOAD_TEST:    return RATE_RX_LOAD;
+        default:               return RATE_RX_OTHER;
+    }
+}
+
+const char* getRateClassName(RateClass rateClass) {
+    return rateClass < RATE_CLASS_COUNT ? RATE_CLASS_NAMES[rateClass] : "?";
+}
+
+bool parseRateClass(const String& name, RateClass& rateClass) {
+    for (uint8_t c = 0; c < RATE_CLASS_COUNT; c++) {
+        if (name == RATE_CLASS_NAMES[c]) {
+            rateClass = (RateClass)c;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RATE LIMITER IMPLEMENTATION                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+RateLimiter::RateLimiter() : enabled(true) {
+    memcpy(limits, DEFAULT_LIMITS, sizeof(limits));
+    clear();
+}
+
+RateNodeEntry* RateLimiter::findEntry(uint8_t nodeId, uint32_t now) {
+    int16_t freeSlot = -1;
+    int16_t oldestSlot = -1;        // Least recently used within budget
+    int16_t oldestLimited = -1;     // Least recently used over budget
+
+    for (uint8_t i = 0; i < RATE_LIMIT_NODES; i++) {
+        RateNodeEntry& entry = entries[i];
+        if (!entry.used) {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (entry.nodeId == nodeId) {
+            return &entry;
+        }
+        int16_t& oldest = entry.limitedMask ? oldestLimited : oldestSlot;
+        if (oldest < 0 || now - entry.lastUsedMs > now - entries[oldest].lastUsedMs) {
+            oldest = i;
+        }
+    }
+
+    // New node starts with full buckets. An over-budget node is only
+    // reused when every entry is over budget, so new IDs cannot reset it.
+    uint8_t slot;
+    if (freeSlot >= 0) {
+        slot = (uint8_t)freeSlot;
+    } else if (oldestSlot >= 0) {
+        slot = (uint8_t)oldestSlot;
+        stats.evictions++;
+    } else {
+        slot = (uint8_t)oldestLimited;
+        stats.evictions++;
+        stats.limitedEvictions++;
+    }
+
+    RateNodeEntry& entry = entries[slot];
+    memset(&entry, 0, sizeof(entry));
+    entry.nodeId = nodeId;
+    entry.used = true;
+    for (uint8_t c = 0; c < RATE_CLASS_COUNT; c++) {
+        entry.tokens[c] = (uint32_t)limits[c].burst * RATE_TOKEN_UNITS;
+    }
+    entry.lastRefillMs = now;
+    entry.lastUsedMs = now;
+    return &entry;
+}
+
+void RateLimiter::refill(RateNodeEntry& entry, uint32_t now) {
+    uint32_t elapsed = now - entry.lastRefillMs;
+    entry.lastRefillMs = now;
+
+    for (uint8_t c = 0; c < RATE_CLASS_COUNT; c++) {
+        const RateLimit& limit = limits[c];
+        if (limit.perMinute == 0) continue;
+
+        uint32_t capacity = (uint32_t)limit.burst * RATE_TOKEN_UNITS;
+        uint32_t& tokens = entry.tokens[c];
+        if (tokens >= capacity) {
+            tokens = capacity;
+            continue;
+        }
+
+        // Compare before multiplying: a long idle gap would overflow elapsed * rate
+        uint32_t missing = capacity - tokens;
+        if (elapsed >= missing / limit.perMinute + 1) {
+            tokens = capacity;
+        } else {
+            tokens += elapsed * limit.perMinute;
+            if (tokens > capacity) tokens = capacity;
+        }
+    }
+}
+
+bool RateLimiter::allow(uint8_t nodeId, RateClass rateClass) {
+    const RateLimit& limit = limits[rateClass];
+    if (!enabled || limit.perMinute == 0) {
+        stats.passed[rateClass]++;
+        return true;
+    }
+
+    uint32_t now = millis();
+    RateNodeEntry* entry = findEntry(nodeId, now);
+    refill(*entry, now);
+    entry->lastUsedMs = now;
+
+    uint8_t classBit = (uint8_t)(1 << rateClass);
+    if (entry->tokens[rateClass] >= RATE_TOKEN_UNITS) {
+        entry->tokens[rateClass] -= RATE_TOKEN_UNITS;
+        entry->passed++;
+        stats.passed[rateClass]++;
+        if (entry->limitedMask & classBit) {
+            entry->limitedMask &= (uint8_t)~classBit;
+            Serial.printf("[RATE] Node %u %s back within %u/min (%u dropped)\n",
+                          nodeId, RATE_CLASS_NAMES[rateClass], limit.perMinute,
+                          entry->episodeDrops[rateClass]);
+        }
+        return true;
+    }
+
+    entry->dropped++;
+    if (entry->episodeDrops[rateClass] < UINT16_MAX) entry->episodeDrops[rateClass]++;
+    stats.dropped[rateClass]++;
+    metricIncLabel(rateClass == RATE_FORWARD ? FAM_FORWARDS_LIMITED_BY_NODE : FAM_RX_LIMITED_BY_NODE, nodeId);
+
+    // Log the start of an episode only - printing every drop is the cost we avoid
+    if (!(entry->limitedMask & classBit)) {
+        entry->limitedMask |= classBit;
+        entry->episodeDrops[rateClass] = 1;
+        Serial.printf("[RATE] Node %u over %u %s/min - dropping\n",
+                      nodeId, limit.perMinute, RATE_CLASS_NAMES[rateClass]);
+    }
+    return false;
+}
+
+void RateLimiter::setLimit(RateClass rateClass, uint16_t perMinute, uint8_t burst) {
+    if (rateClass >= RATE_CLASS_COUNT) return;
+    if (perMinute > 0 && burst == 0) burst = 1;
+
+    limits[rateClass].perMinute = perMinute;
+    limits[rateClass].burst = burst;
+
+    uint32_t capacity = (uint32_t)burst * RATE_TOKEN_UNITS;
+    for (uint8_t i = 0; i < RATE_LIMIT_NODES; i++) {
+        if (entries[i].used && entries[i].tokens[rateClass] > capacity) {
+            entries[i].tokens[rateClass] = capacity;
+        }
+    }
+}
+
+RateLimit RateLimiter::getLimit(RateClass rateClass) const {
+    return limits[rateClass];
+}
+
+void RateLimiter::setEnabled(bool on) {
+    enabled = on;
+}
+
+bool RateLimiter::isEnabled() const {
+    return enabled;
+}
+
+void RateLimiter::clear() {
+    memset(entries, 0, sizeof(entries));
+    memset(&stats, 0, sizeof(stats));
+}
+
+RateLimiterStats RateLimiter::getStats() const {
+    return stats;
+}
+
+uint8_t RateLimiter::trackedNodes() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < RATE_LIMIT_NODES; i++) {
+        if (entries[i].used) count++;
+    }
+    return count;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STATUS                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void RateLimiter::printStatus() const {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  RATE LIMITER                                                 ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  Enabled: %s\n", enabled ? "yes" : "no (all frames pass)");
+
+    Serial.println(F("  Class     Limit            Passed     Dropped"));
+    for (uint8_t c = 0; c < RATE_CLASS_COUNT; c++) {
+        char limitText[24];
+        if (limits[c].perMinute == 0) {
+            snprintf(limitText, sizeof(limitText), "unlimited");
+        } else {
+            snprintf(limitText, sizeof(limitText), "%u/min, %u burst", limits[c].perMinute, limits[c].burst);
+        }
+        Serial.printf("  %-9s %-16s %7lu  %10lu\n", RATE_CLASS_NAMES[c], limitText,
+                      (unsigned long)stats.passed[c], (unsigned long)stats.dropped[c]);
+    }
+
+    uint8_t inUse = trackedNodes();
+    Serial.printf("  Nodes: %u/%u tracked, %lu reused (%lu over budget)\n", inUse, RATE_LIMIT_NODES,
+                  (unsigned long)stats.evictions, (unsigned long)stats.limitedEvictions);
+
+    // Only nodes that ever went over budget; the rest are all "ok"
+    bool header = false;
+    for (uint8_t i = 0; i < RATE_LIMIT_NODES; i++) {
+        const RateNodeEntry& entry = entries[i];
+        if (!entry.used || entry.dropped == 0) continue;
+        if (!header) {
+            Serial.println(F("  Node   Passed  Dropped  State"));
+            header = true;
+        }
+        char state[48] = "ok";
+        if (entry.limitedMask) {
+            int len = snprintf(state, sizeof(state), "LIMITED");
+            for (uint8_t c = 0; c < RATE_CLASS_COUNT && len < (int)sizeof(state); c++) {
+                if (entry.limitedMask & (1 << c)) {
+                    len += snprintf(state + len, sizeof(state) - len, " %s", RATE_CLASS_NAMES[c]);
+                }
+            }
+        }
+        Serial.printf("  %4u  %7lu  %7lu  %s\n", entry.nodeId,
+                      (unsigned long)entry.passed, (unsigned long)entry.dropped, state);
+    }
+    Serial.println();
+}
@@ -0,0 +1,355 @@
+#include "reorder_buffer.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+ReorderBuffer reorderBuffer;
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REORDER BUFFER IMPLEMENTATION                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+ReorderBuffer::ReorderBuffer() : deliverFn(nullptr) {
+    clear();
+}
+
+void ReorderBuffer::setDeliveryHandler(ReorderDeliverFn fn) {
+    deliverFn = fn;
+}
+
+void ReorderBuffer::clear() {
+    memset(windows, 0, sizeof(windows));
+    evictions = 0;
+    bypassed = 0;
+}
+
+ReorderWindow* ReorderBuffer::getWindow(uint8_t originId, bool create) {
+    for (uint8_t i = 0; i < REORDER_MAX_ORIGINS; i++) {
+        if (windows[i].used && windows[i].originId == originId) {
+            return &windows[i];
+        }
+    }
+    if (!create) return nullptr;
+
+    // Free window, else the idle one heard least recently (its order state
+    // is lost, the source resyncs on its next report)
+    uint32_t now = millis();
+    int8_t slot = -1;
+    bool evict = false;
+    for (uint8_t i = 0; i < REORDER_MAX_ORIGINS; i++) {
+        if (!windows[i].used) {
+            slot = i;
+            evict = false;
+            break;
+        }
+        if (heldCount(windows[i]) > 0) continue;
+        if (slot < 0 || now - windows[i].lastReportMs > now - windows[slot].lastReportMs) {
+            slot = i;
+            evict = true;
+        }
+    }
+
+    if (slot < 0) {
+        bypassed++;
+        return nullptr;
+    }
+    if (evict) evictions++;
+
+    memset(&windows[slot], 0, sizeof(ReorderWindow));
+    windows[slot].used = true;
+    windows[slot].originId = originId;
+    windows[slot].lastReportMs = now;
+    return &windows[slot];
+}
+
+const ReorderWindow* ReorderBuffer::getWindowFor(uint8_t originId) const {
+    for (uint8_t i = 0; i < REORDER_MAX_ORIGINS; i++) {
+        if (windows[i].used && windows[i].originId == originId) {
+            return &windows[i];
+        }
+    }
+    return nullptr;
+}
+
+void ReorderBuffer::recordPath(ReorderWindow& window, uint8_t senderId, bool firstCopy) {
+    PathStats* slot = nullptr;
+    PathStats* weakest = &window.paths[0];
+
+    for (uint8_t i = 0; i < REORDER_MAX_PATHS; i++) {
+        PathStats& path = window.paths[i];
+        if ((path.wins || path.losses) && path.senderId == senderId) {
+            slot = &path;
+            break;
+        }
+        if (slot == nullptr && path.wins == 0 && path.losses == 0) {
+            slot = &path;
+            slot->senderId = senderId;
+            break;
+        }
+        if (path.wins + path.losses < weakest->wins + weakest->losses) {
+            weakest = &path;
+        }
+    }
+
+    // Table full - replace the least used path
+    if (slot == nullptr) {
+        slot = weakest;
+        slot->senderId = senderId;
+        slot->wins = 0;
+        slot->losses = 0;
+    }
+
+    if (firstCopy) {
+        if (slot->wins < 0xFFFF) slot->wins++;
+    } else {
+        if (slot->losses < 0xFFFF) slot->losses++;
+    }
+}
+
+uint8_t ReorderBuffer::heldCount(const ReorderWindow& window) const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < REORDER_WINDOW_SIZE; i++) {
+        if (window.held[i].occupied) count++;
+    }
+    return count;
+}
+
+void ReorderBuffer::deliver(const LoRaPacketHeader& header, const FullReportMsg& report, float rssi, float snr) {
+    if (deliverFn == nullptr) return;
+
+    LoRaReceivedPacket packet;
+    packet.header = header;
+    packet.payloadLen = 0;
+    packet.rssi = rssi;
+    packet.snr = snr;
+    deliverFn(packet, report);
+}
+
+void ReorderBuffer::releaseHeld(ReorderWindow& window, uint8_t index) {
+    HeldReport& entry = window.held[index];
+    window.expectedId = entry.report.meshHeader.messageId + 1;
+    window.released++;
+    entry.occupied = false;
+    deliver(entry.header, entry.report, entry.rssi, entry.snr);
+}
+
+void ReorderBuffer::drainInOrder(ReorderWindow& window) {
+    bool found = true;
+    while (found) {
+        found = false;
+        for (uint8_t i = 0; i < REORDER_WINDOW_SIZE; i++) {
+            if (window.held[i].occupied &&
+                window.held[i].report.meshHeader.messageId == window.expectedId) {
+                releaseHeld(window, i);
+                found = true;
+                break;
+            }
+        }
+    }
+}
+
+void ReorderBuffer::releaseOldest(ReorderWindow& window) {
+    // Lowest messageId relative to the expected one (handles wraparound)
+    int8_t bestDistance = 127;
+    int8_t bestIndex = -1;
+
+    for (uint8_t i = 0; i < REORDER_WINDOW_SIZE; i++) {
+        if (!window.held[i].occupied) continue;
+        int8_t distance = (int8_t)(window.held[i].report.meshHeader.messageId - window.expectedId);
+        if (bestIndex < 0 || distance < bestDistance) {
+            bestDistance = distance;
+            bestIndex = i;
+        }
+    }
+
+    if (bestIndex < 0) return;
+
+    // Give up on the gap in front of it
+    releaseHeld(window, bestIndex);
+    drainInOrder(window);
+}
+
+void ReorderBuffer::flushWindow(ReorderWindow& window) {
+    while (heldCount(window) > 0) {
+        releaseOldest(window);
+    }
+}
+
+void ReorderBuffer::submit(const LoRaReceivedPacket& packet, const FullReportMsg& report) {
+    ReorderWindow* window = getWindow(report.meshHeader.sourceId, true);
+    if (window == nullptr) {
+        if (deliverFn) deliverFn(packet, report);
+        return;
+    }
+
+    window->lastReportMs = millis();
+    recordPath(*window, report.meshHeader.senderId, true);
+
+    uint8_t messageId = report.meshHeader.messageId;
+
+    // First report from this source - nothing to order against
+    if (!window->synced) {
+        window->synced = true;
+        window->expectedId = messageId + 1;
+        window->released++;
+        if (deliverFn) deliverFn(packet, report);
+        return;
+    }
+
+    int8_t distance = (int8_t)(messageId - window->expectedId);
+
+    // ─────────────────────────────────────────────────────────────────────
+    // In order: deliver, then anything that was waiting behind it
+    // ─────────────────────────────────────────────────────────────────────
+    if (distance == 0) {
+        if (heldCount(*window) > 0) window->reordered++;
+        window->expectedId = messageId + 1;
+        window->released++;
+        if (deliverFn) deliverFn(packet, report);
+        drainInOrder(*window);
+        return;
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Behind the window: its slot was already given up - pass it on late
+    // ─────────────────────────────────────────────────────────────────────
+    if (distance < 0) {
+        window->lateArrivals++;
+        if (deliverFn) deliverFn(packet, report);
+        return;
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Far ahead: source restarted or we were out of range - release what
+    // this source held (older than this report), then resync. Other
+    // sources keep their windows.
+    // ─────────────────────────────────────────────────────────────────────
+    if (distance >= REORDER_MAX_AHEAD) {
+        flushWindow(*window);
+        window->expectedId = messageId + 1;
+        window->released++;
+        if (deliverFn) deliverFn(packet, report);
+        return;
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Ahead of a gap: hold it (make room by giving up the oldest gap)
+    // ─────────────────────────────────────────────────────────────────────
+    if (heldCount(*window) >= REORDER_WINDOW_SIZE) {
+        releaseOldest(*window);
+
+        // Releasing may have moved the window past this report
+        distance = (int8_t)(messageId - window->expectedId);
+        if (distance <= 0) {
+            if (distance < 0) window->lateArrivals++;
+            else window->released++;
+            if (distance == 0) window->expectedId = messageId + 1;
+            if (deliverFn) deliverFn(packet, report);
+            drainInOrder(*window);
+            return;
+        }
+    }
+
+    for (uint8_t i = 0; i < REORDER_WINDOW_SIZE; i++) {
+        HeldReport& entry = window->held[i];
+        if (!entry.occupied) {
+            entry.header = packet.header;
+            entry.report = report;
+            entry.rssi = packet.rssi;
+            entry.snr = packet.snr;
+            entry.heldSinceMs = millis();
+            entry.occupied = true;
+            break;
+        }
+    }
+}
+
+void ReorderBuffer::noteDuplicate(uint8_t originId, uint8_t senderId) {
+    ReorderWindow* window = getWindow(originId, false);
+    if (window == nullptr) return;
+    recordPath(*window, senderId, false);
+}
+
+void ReorderBuffer::flushExpired() {
+    unsigned long now = millis();
+
+    for (uint8_t w = 0; w < REORDER_MAX_ORIGINS; w++) {
+        ReorderWindow& window = windows[w];
+        if (!window.used) continue;
+
+        bool expired = true;
+        while (expired) {
+            expired = false;
+            for (uint8_t i = 0; i < REORDER_WINDOW_SIZE; i++) {
+                if (window.held[i].occupied && now - window.held[i].heldSinceMs >= REORDER_HOLD_MS) {
+                    expired = true;
+                    break;
+                }
+            }
+            if (expired) {
+                window.timeouts++;
+                releaseOldest(window);
+            }
+        }
+    }
+}
+
+void ReorderBuffer::flushAll() {
+    for (uint8_t w = 0; w < REORDER_MAX_ORIGINS; w++) {
+        ReorderWindow& window = windows[w];
+        if (!window.used) continue;
+        flushWindow(window);
+    }
+}
+
+void ReorderBuffer::printStatus() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  REORDER WINDOW                                               ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.print(F("  Hold time: "));
+    Serial.print(REORDER_HOLD_MS / 1000);
+    Serial.print(F(" s   Window: "));
+    Serial.print(REORDER_WINDOW_SIZE);
+    Serial.println(F(" reports/source"));
+
+    uint8_t inUse = 0;
+    for (uint8_t w = 0; w < REORDER_MAX_ORIGINS; w++) {
+        if (windows[w].used) inUse++;
+    }
+    Serial.printf("  Windows: %u/%u in use, %lu reused, %lu reports bypassed (all windows holding)\n",
+                  inUse, REORDER_MAX_ORIGINS, (unsigned long)evictions, (unsigned long)bypassed);
+
+    bool any = false;
+    for (uint8_t w = 0; w < REORDER_MAX_ORIGINS; w++) {
+        const ReorderWindow& window = windows[w];
+        if (!window.used) continue;
+        any = true;
+
+        Serial.printf("  Node %u  next #%u  held %u  released %lu  reordered %lu  timeouts %lu  late %lu\n",
+                      window.originId,
+                      window.expectedId,
+                      heldCount(window),
+                      (unsigned long)window.released,
+                      (unsigned long)window.reordered,
+                      (unsigned long)window.timeouts,
+                      (unsigned long)window.lateArrivals);
+
+        for (uint8_t p = 0; p < REORDER_MAX_PATHS; p++) {
+            const PathStats& path = window.paths[p];
+            if (path.wins == 0 && path.losses == 0) continue;
+            uint32_t total = path.wins + path.losses;
+            Serial.printf("    via %-3u first %5u  later %5u  (%3lu%% first)\n",
+                          path.senderId,
+                          path.wins,
+                          path.losses,
+                          (unsigned long)(path.wins * 100UL / total));
+        }
+    }
+
+    if (!any) {
+        Serial.println(F("  No reports received yet"));
+    }
+    Serial.println();
+}
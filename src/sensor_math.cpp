@@ -0,0 +1,332 @@
+#include "sensor_math.h"
+#include <math.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         COMPILE-TIME TABLES                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// C++11 constexpr (single return, recursion), so the toolchain's default
+// -std=gnu++11 builds the tables without any float code at run time.
+
+// ln(x) = 2 atanh(z), z = (x - 1) / (x + 1); |z| <= 0.6 over both tables
+static constexpr double lnSeries(double z2, double term, int k) {
+    return k > 81 ? 0.0 : term / k + lnSeries(z2, term * z2, k + 2);
+}
+
+static constexpr double lnZ(double z) {
+    return 2.0 * lnSeries(z * z, z, 1);
+}
+
+static constexpr double constLn(double x) {
+    return lnZ((x - 1.0) / (x + 1.0));
+}
+
+// |x| <= 1.4 over both tables
+static constexpr double expSeries(double x, double term, int n) {
+    return n > 40 ? term : term + expSeries(x, term * x / n, n + 1);
+}
+
+static constexpr double constPow(double base, double exponent) {
+    return expSeries(exponent * constLn(base), 1.0, 1);
+}
+
+static constexpr int32_t roundToInt(double x) {
+    return (int32_t)(x >= 0.0 ? x + 0.5 : x - 0.5);
+}
+
+static constexpr double BARO_SCALE_M = 44330.0;
+static constexpr double BARO_EXPONENT = 5.255;
+
+// Altitude (mm) at knot i: p / p0 = 0.25 + i / 256
+static constexpr int32_t altitudeKnotMm(int i) {
+    return roundToInt(BARO_SCALE_M * 1000.0 * (1.0 - constPow(0.25 + i / 256.0, 1.0 / BARO_EXPONENT)));
+}
+
+// p / p0 (Q24) at knot i: h = BARO_HEIGHT_MIN_MM + i * 65.536 m
+static constexpr int32_t pressureRatioKnotQ24(int i) {
+    return roundToInt(16777216.0 *
+        constPow(1.0 - (BARO_HEIGHT_MIN_MM + i * 65536.0) / (BARO_SCALE_M * 1000.0), BARO_EXPONENT));
+}
+
+#define TABLE_REPEAT_4(F, i)    F(i), F(i + 1), F(i + 2), F(i + 3)
+#define TABLE_REPEAT_16(F, i)   TABLE_REPEAT_4(F, i), TABLE_REPEAT_4(F, i + 4), \
+                                TABLE_REPEAT_4(F, i + 8), TABLE_REPEAT_4(F, i + 12)
+#define TABLE_REPEAT_64(F, i)   TABLE_REPEAT_16(F, i), TABLE_REPEAT_16(F, i + 16), \
+                                TABLE_REPEAT_16(F, i + 32), TABLE_REPEAT_16(F, i + 48)
+#define TABLE_REPEAT_256(F, i)  TABLE_REPEAT_64(F, i), TABLE_REPEAT_64(F, i + 64), \
+                                TABLE_REPEAT_64(F, i + 128), TABLE_REPEAT_64(F, i + 192)
+
+static constexpr int32_t ALTITUDE_TABLE_MM[BARO_TABLE_POINTS] = {
+    TABLE_REPEAT_256(altitudeKnotMm, 0), altitudeKnotMm(256)
+};
+
+static constexpr int32_t PRESSURE_RATIO_TABLE_Q24[BARO_TABLE_POINTS] = {
+    TABLE_REPEAT_256(pressureRatioKnotQ24, 0), pressureRatioKnotQ24(256)
+};
+
+// Knot 192 is p = p0, knot 16 is sea level (h = 0)
+static_assert(ALTITUDE_TABLE_MM[192] == 0, "altitude table: p = p0 must be 0 m");
+static_assert(PRESSURE_RATIO_TABLE_Q24[16] == (1L << 24), "sea-level table: h = 0 must be ratio 1");
+static_assert(ALTITUDE_TABLE_MM[0] > ALTITUDE_TABLE_MM[256], "altitude falls as pressure rises");
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BMP180                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+int32_t bmp180ComputeB5(const Bmp180Calibration& cal, int32_t ut) {
+    // B5 = X1 + X2, where:
+    // X1 = (UT - AC6) * AC5 / 2^15
+    // X2 = MC * 2^11 / (X1 + MD)
+    int32_t X1 = ((ut - (int32_t)cal.ac6) * (int32_t)cal.ac5) >> 15;
+    int32_t X2 = ((int32_t)cal.mc << 11) / (X1 + (int32_t)cal.md);
+    return X1 + X2;
+}
+
+int16_t bmp180TemperatureC_x10(int32_t b5) {
+    // T in 0.1 °C: T = (B5 + 8) / 2^4
+    return (int16_t)((b5 + 8) >> 4);
+}
+
+int32_t bmp180PressurePa(const Bmp180Calibration& cal, int32_t b5, int32_t up, uint8_t oss) {
+    int32_t B6 = b5 - 4000;
+    int32_t X1 = ((int32_t)cal.b2 * ((B6 * B6) >> 12)) >> 11;
+    int32_t X2 = ((int32_t)cal.ac2 * B6) >> 11;
+    int32_t X3 = X1 + X2;
+    // B3 = (((AC1*4 + X3) << OSS) + 2) / 4
+    int32_t B3 = (((((int32_t)cal.ac1) * 4 + X3) << oss) + 2) >> 2;
+    X1 = ((int32_t)cal.ac3 * B6) >> 13;
+    X2 = ((int32_t)cal.b1 * ((B6 * B6) >> 12)) >> 16;
+    X3 = ((X1 + X2) + 2) >> 2;
+    uint32_t B4 = ((uint32_t)cal.ac4 * (uint32_t)(X3 + 32768)) >> 15;
+    if (B4 == 0) return 0;
+    uint32_t B7 = ((uint32_t)up - (uint32_t)B3) * (uint32_t)(50000UL >> oss);
+    int32_t p;
+    if (B7 < 0x80000000UL) {
+        p = (int32_t)((B7 << 1) / B4);
+    } else {
+        p = (int32_t)((B7 / B4) << 1);
+    }
+    X1 = (p >> 8);
+    X1 = (X1 * X1);
+    X1 = (X1 * 3038) >> 16;
+    X2 = (-7357 * p) >> 16;
+    return p + ((X1 + X2 + (int32_t)3791) >> 4);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SHT30                                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+uint8_t sht30Crc8(const uint8_t* data, uint8_t len) {
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+int16_t sht30TemperatureF_x10(uint16_t raw) {
+    return (int16_t)(-490 + (int32_t)((3150UL * raw + 32767UL) / 65535UL));
+}
+
+int16_t sht30TemperatureC_x100(uint16_t raw) {
+    return (int16_t)(-4500 + (int32_t)((17500UL * raw + 32767UL) / 65535UL));
+}
+
+uint16_t sht30Humidity_x10(uint16_t raw) {
+    return (uint16_t)((1000UL * raw + 32767UL) / 65535UL);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CONVERSIONS                                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+int16_t celsiusToFahrenheit_x10(int16_t celsius_x10) {
+    int32_t scaled = (int32_t)celsius_x10 * 18;     // 0.01 °F above 32 °F
+    scaled += scaled >= 0 ? 5 : -5;
+    return (int16_t)(scaled / 10 + 320);
+}
+
+uint16_t pressureToHpa(int32_t pressurePa) {
+    if (pressurePa <= 0) return 0;
+    return (uint16_t)((pressurePa + 50) / 100);
+}
+
+int32_t baroAltitudeMm(int32_t pressurePa, int32_t seaLevelPa) {
+    if (pressurePa <= 0 || seaLevelPa <= 0) return 0;
+
+    uint32_t ratio = (uint32_t)(((uint64_t)pressurePa << 24) / (uint32_t)seaLevelPa);
+    if (ratio <= BARO_RATIO_MIN_Q24) return ALTITUDE_TABLE_MM[0];
+
+    uint32_t offset = ratio - BARO_RATIO_MIN_Q24;
+    uint32_t index = offset >> BARO_RATIO_STEP_SHIFT;
+    if (index >= BARO_TABLE_POINTS - 1) return ALTITUDE_TABLE_MM[BARO_TABLE_POINTS - 1];
+
+    uint32_t frac = offset & ((1UL << BARO_RATIO_STEP_SHIFT) - 1);
+    int32_t a = ALTITUDE_TABLE_MM[index];
+    int32_t b = ALTITUDE_TABLE_MM[index + 1];
+    return a + (int32_t)(((int64_t)(b - a) * frac) >> BARO_RATIO_STEP_SHIFT);
+}
+
+int16_t baroAltitudeM(int32_t pressurePa, int32_t seaLevelPa) {
+    int32_t mm = baroAltitudeMm(pressurePa, seaLevelPa);
+    return (int16_t)((mm + (mm >= 0 ? 500 : -500)) / 1000);
+}
+
+int32_t baroSeaLevelPa(int32_t pressurePa, int32_t altitudeMm) {
+    if (pressurePa <= 0) return 0;
+
+    int32_t offset = altitudeMm - BARO_HEIGHT_MIN_MM;
+    if (offset < 0) offset = 0;
+    uint32_t index = (uint32_t)offset >> BARO_HEIGHT_STEP_SHIFT;
+    uint32_t frac = (uint32_t)offset & ((1UL << BARO_HEIGHT_STEP_SHIFT) - 1);
+    if (index >= BARO_TABLE_POINTS - 1) {
+        index = BARO_TABLE_POINTS - 2;
+        frac = 1UL << BARO_HEIGHT_STEP_SHIFT;
+    }
+
+    int32_t a = PRESSURE_RATIO_TABLE_Q24[index];
+    int32_t b = PRESSURE_RATIO_TABLE_Q24[index + 1];
+    uint32_t ratio = (uint32_t)(a + (int32_t)(((int64_t)(b - a) * frac) >> BARO_HEIGHT_STEP_SHIFT));
+    return (int32_t)((((uint64_t)pressurePa << 24) + ratio / 2) / ratio);
+}
+
+int32_t baroSeaLevelEmaQ8(int32_t averageQ8, int32_t samplePa) {
+    int32_t diff = baroSeaLevelToQ8(samplePa) - averageQ8;
+    int32_t half = BARO_SEA_LEVEL_EMA_DIV / 2;
+    return averageQ8 + (diff >= 0 ? diff + half : diff - half) / BARO_SEA_LEVEL_EMA_DIV;
+}
+
+int32_t baroSeaLevelToQ8(int32_t pressurePa) {
+    return pressurePa * (1L << BARO_SEA_LEVEL_EMA_SHIFT);
+}
+
+int32_t baroSeaLevelFromQ8(int32_t averageQ8) {
+    return (averageQ8 + (1L << (BARO_SEA_LEVEL_EMA_SHIFT - 1))) >> BARO_SEA_LEVEL_EMA_SHIFT;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FLOAT REFERENCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+float sht30TemperatureFRef(uint16_t raw) {
+    float tempC = -45.0 + 175.0 * (raw / 65535.0);
+    return tempC * 1.8f + 32.0f;
+}
+
+float sht30HumidityRef(uint16_t raw) {
+    return 100.0 * (raw / 65535.0);
+}
+
+float baroAltitudeRef(float pressurePa, float seaLevelPa) {
+    // 0.190294957 ≈ 1/5.255
+    return 44330.0f * (1.0f - powf(pressurePa / seaLevelPa, 0.190294957f));
+}
+
+float baroSeaLevelRef(float pressurePa, float altitudeM) {
+    return pressurePa / powf(1.0f - (altitudeM / 44330.0f), 5.255f);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BENCHMARK                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#ifdef ARDUINO
+
+#define SENSOR_BENCH_SAMPLES        1000
+
+static volatile int32_t benchSink;      // Keeps the loops from being optimized away
+
+static void printBenchRow(const char* name, uint32_t floatCycles, uint32_t fixedCycles, const char* error) {
+    Serial.printf("    %-26s %8.0f %8.0f  %5.1fx  %s\n", name,
+                  (float)floatCycles / SENSOR_BENCH_SAMPLES, (float)fixedCycles / SENSOR_BENCH_SAMPLES,
+                  fixedCycles ? (float)floatCycles / fixedCycles : 0.0f, error);
+}
+
+void runSensorMathBenchmark() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  SENSOR MATH BENCHMARK                                        ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  %u samples per row, CPU cycles per sample at %u MHz\n",
+                  SENSOR_BENCH_SAMPLES, (unsigned)ESP.getCpuFreqMHz());
+    Serial.println(F("    step                          float    fixed  speedup  max error"));
+
+    // SHT30: raw counts to wire temperature (0.1 °F) and humidity (0.1 %)
+    int32_t sink = 0;
+    uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        uint16_t raw = (uint16_t)(i * 65);
+        sink += (int16_t)(sht30TemperatureFRef(raw) * 10.0f) + (uint16_t)(sht30HumidityRef(raw) * 10.0f);
+    }
+    uint32_t floatCycles = ESP.getCycleCount() - start;
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        uint16_t raw = (uint16_t)(i * 65);
+        sink += sht30TemperatureF_x10(raw) + sht30Humidity_x10(raw);
+    }
+    uint32_t fixedCycles = ESP.getCycleCount() - start;
+    int maxLsb = 0;
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        uint16_t raw = (uint16_t)(i * 65);
+        int err = abs(sht30TemperatureF_x10(raw) - (int)lroundf(sht30TemperatureFRef(raw) * 10.0f));
+        if (err > maxLsb) maxLsb = err;
+    }
+    char error[24];
+    snprintf(error, sizeof(error), "%d LSB", maxLsb);
+    printBenchRow("SHT30 temp + RH", floatCycles, fixedCycles, error);
+
+    // Altitude from pressure, 300-1100 hPa against the calibrated p0
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        sink += (int16_t)baroAltitudeRef(30000.0f + i * 80.0f, 101325.0f);
+    }
+    floatCycles = ESP.getCycleCount() - start;
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        sink += baroAltitudeM(30000 + i * 80, 101325);
+    }
+    fixedCycles = ESP.getCycleCount() - start;
+    float maxM = 0.0f;
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        float err = fabsf(baroAltitudeMm(30000 + i * 80, 101325) / 1000.0f -
+                          baroAltitudeRef(30000.0f + i * 80.0f, 101325.0f));
+        if (err > maxM) maxM = err;
+    }
+    snprintf(error, sizeof(error), "%.2f m", maxM);
+    printBenchRow("Altitude (powf vs table)", floatCycles, fixedCycles, error);
+
+    // Sea-level pressure from a GPS height, -500 m to 10 km
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        sink += (int32_t)baroSeaLevelRef(100000.0f - i * 60.0f, -500.0f + i * 10.5f);
+    }
+    floatCycles = ESP.getCycleCount() - start;
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        sink += baroSeaLevelPa(100000 - i * 60, -500000 + i * 10500);
+    }
+    fixedCycles = ESP.getCycleCount() - start;
+    float maxPa = 0.0f;
+    for (uint32_t i = 0; i < SENSOR_BENCH_SAMPLES; i++) {
+        float err = fabsf(baroSeaLevelPa(100000 - i * 60, -500000 + i * 10500) -
+                          baroSeaLevelRef(100000.0f - i * 60.0f, -500.0f + i * 10.5f));
+        if (err > maxPa) maxPa = err;
+    }
+    snprintf(error, sizeof(error), "%.0f Pa", maxPa);
+    printBenchRow("Sea-level p0 (GPS height)", floatCycles, fixedCycles, error);
+
+    benchSink = sink;
+    Serial.println(F("  Float error is the float reference's own rounding plus the table's;"));
+    Serial.println(F("  tools/sensor_bench checks both against a double-precision curve"));
+    Serial.println();
+}
+
+#endif // ARDUINO
@@ -2,6 +2,13 @@
 #include "config.h"
 #include "mesh_stats.h"
 #include "gradient_routing.h"
+#include "traffic_generator.h"
+#include "mesh_schema.h"
+#include "loop_watchdog.h"
+#include "channel_monitor.h"
+
+static_assert(SERIAL_JSON_LINE_SIZE >= 32 + SCHEMA_REPORT_JSON_MAX + 128,
+              "SERIAL_JSON_LINE_SIZE too small for a node_data line");
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         SERIAL JSON OUTPUT                                ║
@@ -13,64 +20,34 @@
 // ╚═══════════════════════════════════════════════════════════════════════════╝
 
 void outputNodeDataJson(uint8_t nodeId, const FullReportMsg& report, float rssi, float snr) {
-    // Calculate hop distance from TTL
-    uint8_t hopDistance = (nodeId == GATEWAY_NODE_ID) ? 0 : (MESH_DEFAULT_TTL - report.meshHeader.ttl);
-
-    // Build JSON string
-    // Note: Using print statements to avoid String memory fragmentation
-    Serial.print(F("{\"type\":\"node_data\","));
-    Serial.print(F("\"nodeId\":"));
-    Serial.print(nodeId);
-    Serial.print(F(",\"temp\":"));
-    Serial.print(report.temperatureF_x10 / 10.0, 1);
-    Serial.print(F(",\"humidity\":"));
-    Serial.print(report.humidity_x10 / 10.0, 1);
-    Serial.print(F(",\"pressure\":"));
-    Serial.print(report.pressure_hPa);
-    Serial.print(F(",\"altitude\":"));
-    Serial.print(report.altitude_m);
-
-    // Sensor status (check FLAGS_SENSORS_OK for now, individual flags in future)
-    Serial.print(F(",\"sensorsOk\":"));
-    Serial.print((report.flags & FLAG_SENSORS_OK) ? F("true") : F("false"));
-
-    Serial.print(F(",\"lat\":"));
-    Serial.print(report.latitude_x1e6 / 1000000.0, 6);
-    Serial.print(F(",\"lng\":"));
-    Serial.print(report.longitude_x1e6 / 1000000.0, 6);
-    Serial.print(F(",\"satellites\":"));
-    Serial.print(report.satellites);
-    Serial.print(F(",\"rssi\":"));
-    Serial.print(rssi, 0);
-    Serial.print(F(",\"snr\":"));
-    Serial.print(snr, 1);
-    Serial.print(F(",\"hopDistance\":"));
-    Serial.print(hopDistance);
-    Serial.print(F(",\"meshMsgId\":"));
-    Serial.print(report.meshHeader.messageId);
-    Serial.print(F(",\"meshTtl\":"));
-    Serial.print(report.meshHeader.ttl);
-    Serial.print(F(",\"meshSenderId\":"));
-    Serial.print(report.meshHeader.senderId);
-    Serial.print(F(",\"neighborCount\":"));
-    Serial.print(report.neighborCount);
-    Serial.print(F(",\"uptime_sec\":"));
-    Serial.print(report.uptime_sec);
-    Serial.print(F(",\"online\":true"));
+    // Same hop definition as the dashboard and report-age statistics
+    uint8_t hopDistance = meshHopCount(report.meshHeader);
 
     // Extract time source from flags (bits 4-5)
     uint8_t timeSrcFlags = report.flags & FLAG_TIME_SRC_MASK;
-    Serial.print(F(",\"timeSource\":\""));
+    const char* timeSource = "NONE";
     if (timeSrcFlags == FLAG_TIME_SRC_GPS) {
-        Serial.print(F("GPS"));
+        timeSource = "GPS";
     } else if (timeSrcFlags == FLAG_TIME_SRC_NET) {
-        Serial.print(F("NET"));
-    } else {
-        Serial.print(F("NONE"));
+        timeSource = "NET";
     }
-    Serial.print(F("\""));
 
-    Serial.println(F("}"));
+    // Build the whole line in one buffer and write it once
+    // (one UART write instead of ~40 small prints, and no String fragmentation)
+    // Report fields come from the schema; only the link-level extras are formatted here
+    // Sensor status: FLAG_SENSORS_OK for now, individual flags in future
+    char line[SERIAL_JSON_LINE_SIZE];
+    int len = snprintf(line, sizeof(line), "{\"type\":\"node_data\",\"nodeId\":%u", nodeId);
+    len += schemaReportJson(line + len, report);
+    int tail = snprintf(line + len, sizeof(line) - len,
+        ",\"sensorsOk\":%s,\"rssi\":%.0f,\"snr\":%.1f,\"hopDistance\":%u,"
+        "\"online\":true,\"timeSource\":\"%s\"}\r\n",
+        (report.flags & FLAG_SENSORS_OK) ? "true" : "false",
+        rssi, snr, hopDistance, timeSource);
+
+    if (tail > 0 && (size_t)tail < sizeof(line) - len) {
+        Serial.write((const uint8_t*)line, len + tail);
+    }
 }
 
 void outputGatewayStatusJson() {
@@ -93,6 +70,8 @@ void outputGatewayStatusJson() {
         Serial.print(state.distanceToGateway);
         Serial.print(F(",\"nextHop\":"));
         Serial.print(state.nextHop);
+        Serial.print(F(",\"gatewayId\":"));
+        Serial.print(state.gatewayId);
     }
 
     Serial.println(F("}"));
@@ -128,6 +107,9 @@ void outputMeshStatsJson() {
         Serial.print(routeStats.floodingFallbacks);
     }
 
+    printLoopWatchdogJsonFields(Serial);
+    printChannelJsonFields(Serial);
+
     Serial.println(F("}"));
 }
 
@@ -141,3 +123,43 @@ void outputBeaconJson(uint8_t senderId, uint8_t distance, int16_t rssi) {
     Serial.print(rssi);
     Serial.println(F("}"));
 }
+
+void outputLoadReportJson() {
+    for (uint8_t s = 0; s < LOADGEN_MAX_SOURCES; s++) {
+        const LoadSourceStats* source = getLoadSourceStats(s);
+        if (source == nullptr) continue;
+
+        Serial.print(F("{\"type\":\"load_report\","));
+        Serial.print(F("\"sourceId\":"));
+        Serial.print(source->sourceId);
+        Serial.print(F(",\"testId\":"));
+        Serial.print(source->testId);
+        Serial.print(F(",\"curve\":["));
+
+        for (uint8_t l = 0; l < source->levelCount; l++) {
+            const LoadLevelStats& level = source->levels[l];
+            uint32_t expected = (uint16_t)(level.highestSeq - level.firstSeq) + 1;
+            uint32_t windowMs = level.lastRxMs - level.firstRxMs;
+            if (windowMs < 1000) windowMs = 1000;
+
+            if (l > 0) Serial.print(F(","));
+            Serial.print(F("{\"offered\":"));
+            Serial.print(level.offeredPerSlot);
+            Serial.print(F(",\"received\":"));
+            Serial.print(level.received);
+            Serial.print(F(",\"expected\":"));
+            Serial.print(expected);
+            Serial.print(F(",\"goodputBpm\":"));
+            Serial.print((uint32_t)((uint64_t)level.bytes * 60000UL / windowMs));
+            Serial.print(F(",\"latAvgMs\":"));
+            Serial.print(level.received > 0 ? level.latencySumMs / level.received : 0);
+            Serial.print(F(",\"latMaxMs\":"));
+            Serial.print(level.latencyMaxMs);
+            Serial.print(F(",\"srcDrops\":"));
+            Serial.print(level.dropsAtEnd - level.dropsAtStart);
+            Serial.print(F("}"));
+        }
+
+        Serial.println(F("]}"));
+    }
+}
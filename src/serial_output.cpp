@@ -113,10 +113,12 @@ void printStartupBanner() {
 
 void printNetworkStatus() {
     printHeader("NETWORK STATUS");
-    
-    for (uint8_t i = 0; i < MESH_MAX_NODES; i++) {
-        uint8_t nodeId = i + 1;
-        NodeMessage* node = &nodeStore[i];
+
+    uint16_t cursor = 0;
+    NodeSnapshot snapshot;
+    while (nextLiveNode(cursor, snapshot)) {
+        uint8_t nodeId = snapshot.nodeId;
+        const NodeSnapshot* node = &snapshot;
         
         String status;
         if (nodeId == DEVICE_ID) {
@@ -138,6 +140,9 @@ void printNetworkStatus() {
             printRow("  Last RSSI", String(node->lastRssi, 1) + " dBm");
         }
     }
+
+    NodeTableStats table = getNodeTableStats();
+    printRow("Node Table", String(table.live) + " / " + String(NODE_TABLE_SIZE) + " slots");
     
     printFooter();
 }
@@ -166,7 +171,7 @@ void printSystemStats() {
     char timeStr[20];
     snprintf(timeStr, sizeof(timeStr), "%2d:%02d:%02d %s", hour12, g_minute, g_second, ampm);
     printRow("Local Time", String(timeStr));
-    printRow("GPS Satellites", gps.satellites.isValid() ? String(gps.satellites.value()) : "?");
+    printRow("GPS Satellites", isSatellitesValid() ? String(getGPSSatellites()) : "?");
     
     printDivider();
     
@@ -201,7 +206,7 @@ void printGPSStatusLine() {
 
     // GPS time is only valid for display if we have actual satellites
     // This prevents showing stale cached GPS time when satellites are lost
-    bool gpsHasSatellites = gps.satellites.isValid() && gps.satellites.value() >= 1;
+    bool gpsHasSatellites = getGPSSatellites() >= 1;
 
     if (g_datetime_valid && gpsHasSatellites) {
         // GPS time is available with satellites
@@ -219,7 +224,7 @@ void printGPSStatusLine() {
         // No valid time source
         char buffer[70];
         snprintf(buffer, sizeof(buffer), "║  Time: WAITING | Sats: %d | Mode: %s",
-                 gps.satellites.isValid() ? gps.satellites.value() : 0,
+                 getGPSSatellites(),
                  tdmaScheduler.getDeviceMode().c_str());
         Serial.print(buffer);
         int len = strlen(buffer);
@@ -247,7 +252,7 @@ void printGPSStatusLine() {
         char buffer[70];
         snprintf(buffer, sizeof(buffer), "║  %s: %2d:%02d:%02d %s | Sats: %d | Mode: %s",
                  srcStr, hour12, dispMin, dispSec, ampm,
-                 gps.satellites.isValid() ? gps.satellites.value() : 0,
+                 getGPSSatellites(),
                  tdmaScheduler.getDeviceMode().c_str());
 
         Serial.print(buffer);
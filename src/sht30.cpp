@@ -1,8 +1,9 @@
 #include "sht30.h"
 
 SHT30::SHT30() {
-  _temperature = 0.0;
-  _humidity = 0.0;
+  _wire = nullptr;
+  _rawTemperature = 0x6666;   // 25 °C
+  _rawHumidity = 0x8000;      // 50 %RH
 }
 
 bool SHT30::begin(TwoWire *wire) {
@@ -30,21 +31,28 @@ bool SHT30::read() {
     data[i] = _wire->read();
   }
   
-  // Convert temperature
-  uint16_t temp_raw = (data[0] << 8) | data[1];
-  _temperature = -45.0 + 175.0 * (temp_raw / 65535.0);
-  
-  // Convert humidity
-  uint16_t hum_raw = (data[3] << 8) | data[4];
-  _humidity = 100.0 * (hum_raw / 65535.0);
+  // Each word is followed by its CRC (datasheet 4.12)
+  if (sht30Crc8(data, 2) != data[2] || sht30Crc8(data + 3, 2) != data[5]) return false;
+
+  // Keep raw counts; conversion is integer math in the getters
+  _rawTemperature = (data[0] << 8) | data[1];
+  _rawHumidity = (data[3] << 8) | data[4];
   
   return true;
 }
 
 float SHT30::getTemperature() {
-  return _temperature;
+  return sht30TemperatureC_x100(_rawTemperature) / 100.0f;
 }
 
 float SHT30::getHumidity() {
-  return _humidity;
+  return sht30Humidity_x10(_rawHumidity) / 10.0f;
+}
+
+int16_t SHT30::getTemperatureF_x10() {
+  return sht30TemperatureF_x10(_rawTemperature);
+}
+
+uint16_t SHT30::getHumidity_x10() {
+  return sht30Humidity_x10(_rawHumidity);
 }
\ No newline at end of file
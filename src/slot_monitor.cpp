@@ -0,0 +1,283 @@
+#include "slot_monitor.h"
+#include "config.h"
+#include "mesh_schema.h"
+#include "metrics.h"
+
+extern TDMAScheduler tdmaScheduler;
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL INSTANCE                                   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+SlotMonitor slotMonitor;
+
+static const int32_t MS_PER_MINUTE = 60000L;
+static const float FLAG_ERROR_MS = SLOT_TIMING_GUARD_MS * SLOT_TIMING_FLAG_PCT / 100.0f;
+
+// Signed distance between two points of the minute, -30000..29999 ms
+static int32_t wrapMinuteMs(int32_t ms) {
+    ms %= MS_PER_MINUTE;
+    if (ms < -MS_PER_MINUTE / 2) ms += MS_PER_MINUTE;
+    if (ms >= MS_PER_MINUTE / 2) ms -= MS_PER_MINUTE;
+    return ms;
+}
+
+static int16_t clampMs(int32_t ms, int32_t limit) {
+    if (ms > limit) return (int16_t)limit;
+    if (ms < -limit) return (int16_t)-limit;
+    return (int16_t)ms;
+}
+
+// Bounds of the slot holding a node's TX second, in ms relative to that second
+static void slotBoundsMs(uint8_t nodeId, uint8_t txSecond, int32_t& fromMs, int32_t& toMs) {
+    uint8_t txBand = 0;
+    uint8_t band = 0;
+    uint8_t owner = 0;
+    uint8_t first = txSecond;
+    uint8_t last = txSecond;
+    tdmaScheduler.getSlotAt(txSecond, txBand, owner);
+    while (first > 0 && tdmaScheduler.getSlotAt(first - 1, band, owner) && owner == nodeId && band == txBand) {
+        first--;
+    }
+    while (last < 59 && tdmaScheduler.getSlotAt(last + 1, band, owner) && owner == nodeId && band == txBand) {
+        last++;
+    }
+    fromMs = ((int32_t)first - txSecond) * 1000L;
+    toMs = ((int32_t)last + 1 - txSecond) * 1000L;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FRAME TIMING                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+SlotMonitor::SlotMonitor() {
+    clear();
+}
+
+void SlotMonitor::clear() {
+    memset(nodes, 0, sizeof(nodes));
+}
+
+bool SlotMonitor::isEnabled() const {
+    return IS_GATEWAY || USE_RELAY_SLOT_MONITOR;
+}
+
+void SlotMonitor::noteFrame(const LoRaReceivedPacket& packet, MessageType type) {
+    if (!isEnabled()) return;
+    // Beacons have their own sub-frame check (noteBeaconOutOfPhase)
+    if (type == MSG_BEACON) return;
+    if (packet.payloadLen < sizeof(MeshHeader) || packet.payloadBytes[0] != MESH_PROTOCOL_VERSION) return;
+    if (!tdmaScheduler.getStatus().timeSynced) return;
+
+    MeshHeader header;
+    memcpy(&header, packet.payloadBytes, sizeof(MeshHeader));
+    uint8_t sender = header.senderId;
+    if (sender == DEVICE_ID || sender < 1 || sender > TDMAScheduler::MAX_NODES) return;
+
+    // Start on air, in ms into our minute: RX-done interrupt minus time on air
+    int32_t startMs = (int32_t)tdmaScheduler.getMillisIntoMinute() -
+                      (int32_t)(millis() - packet.receivedAtMs) -
+                      (int32_t)getFrameAirtimeMs(packet.payloadLen);
+    startMs = (startMs % MS_PER_MINUTE + MS_PER_MINUTE) % MS_PER_MINUTE;
+
+    SlotTimingStats& stats = nodes[sender - 1];
+    stats.lastHeardMs = millis();
+
+    // Error against the nearest TX second this ID has in any band (its depth
+    // may differ from ours). The frame is in slot from SLOT_TIMING_GUARD_MS
+    // before that slot opens to its end: with the beacon sub-frame the TX
+    // second opens the slot, and a clock a few ms fast must not land the
+    // report in the previous node's second.
+    int32_t errorMs = MS_PER_MINUTE;
+    bool inSlot = false;
+    for (uint8_t distance = 1; distance <= TDMAScheduler::DEPTH_BANDS; distance++) {
+        uint8_t txSecond = tdmaScheduler.getTransmissionSecondFor(sender, distance);
+        int32_t candidate = wrapMinuteMs(startMs - txSecond * 1000L);
+        int32_t fromMs = 0;
+        int32_t toMs = 0;
+        slotBoundsMs(sender, txSecond, fromMs, toMs);
+        if (candidate >= fromMs - SLOT_TIMING_GUARD_MS && candidate < toMs) {
+            inSlot = true;
+        }
+        if (abs(candidate) < abs(errorMs)) {
+            errorMs = candidate;
+        }
+    }
+
+    if (!inSlot) {
+        uint8_t band = 0;
+        uint8_t owner = 0;
+        tdmaScheduler.getSlotAt((uint8_t)(startMs / 1000), band, owner);
+        stats.outOfSlot++;
+        metricInc(MET_SLOT_VIOLATIONS);
+        if (owner >= 1 && owner <= TDMAScheduler::MAX_NODES && owner != sender) {
+            nodes[owner - 1].intrusions++;
+            Serial.printf("[SLOT] Node %u transmitted in node %u's slot (%lu.%03lu s into the minute)\n",
+                          sender, owner, (unsigned long)(startMs / 1000), (unsigned long)(startMs % 1000));
+        } else {
+            Serial.printf("[SLOT] Node %u transmitted outside any data slot (%lu.%03lu s into the minute)\n",
+                          sender, (unsigned long)(startMs / 1000), (unsigned long)(startMs % 1000));
+        }
+    }
+
+    // Only a node's own report goes out at its TX second; forwards and
+    // load-test frames fill the rest of the slot
+    if (type != MSG_FULL_REPORT || header.sourceId != sender) return;
+
+    FullReportMsg report;
+    if (!schemaDecodeFullReport(packet.payloadBytes, packet.payloadLen, report)) return;
+    noteReportTiming(stats, sender, errorMs, (report.flags & FLAG_TIME_SRC_MASK) >> 4);
+}
+
+void SlotMonitor::noteReportTiming(SlotTimingStats& stats, uint8_t nodeId, int32_t errorMs,
+                                   uint8_t timeSource) {
+    int16_t error = clampMs(errorMs, INT16_MAX);
+    if (stats.reports == 0) {
+        stats.minErrorMs = error;
+        stats.maxErrorMs = error;
+    }
+    if (error < stats.minErrorMs) stats.minErrorMs = error;
+    if (error > stats.maxErrorMs) stats.maxErrorMs = error;
+    stats.reports++;
+    stats.lastErrorMs = error;
+    stats.errorSumMs += error;
+    stats.timeSource = timeSource;
+    metricObserve(HIST_SLOT_TIMING_ERROR, error);
+
+    if (stats.ewmaSamples == 0) {
+        stats.ewmaErrorMs = error;
+    } else {
+        stats.ewmaErrorMs += SLOT_TIMING_ALPHA * (error - stats.ewmaErrorMs);
+    }
+    if (stats.ewmaSamples < 255) stats.ewmaSamples++;
+
+    bool wasFlagged = stats.flagged;
+    stats.flagged = fabsf(stats.ewmaErrorMs) >= FLAG_ERROR_MS;
+    if (stats.flagged && !wasFlagged) {
+        Serial.printf("[SLOT] Node %u running %+d ms off its TX second (guard %u ms) - flagged\n",
+                      nodeId, (int)lroundf(stats.ewmaErrorMs), SLOT_TIMING_GUARD_MS);
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         CORRECTIONS                                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+bool SlotMonitor::takeCorrection(uint8_t& nodeId, int16_t& correctionMs) {
+    if (!IS_GATEWAY) return false;
+
+    int8_t worst = -1;
+    for (uint8_t i = 0; i < TDMAScheduler::MAX_NODES; i++) {
+        const SlotTimingStats& s = nodes[i];
+        // GPS-timed nodes cannot take a correction to network time
+        if (s.timeSource != TIME_SOURCE_NETWORK) continue;
+        if (s.ewmaSamples < SLOT_TIMING_MIN_SAMPLES) continue;
+        if (millis() - s.lastHeardMs > SLOT_TIMING_STALE_MS) continue;
+        if (fabsf(s.ewmaErrorMs) < SLOT_CORRECTION_MIN_MS) continue;
+        if (worst < 0 || fabsf(s.ewmaErrorMs) > fabsf(nodes[worst].ewmaErrorMs)) {
+            worst = i;
+        }
+    }
+    if (worst < 0) return false;
+
+    SlotTimingStats& s = nodes[worst];
+    nodeId = worst + 1;
+    correctionMs = clampMs(lroundf(s.ewmaErrorMs), SLOT_CORRECTION_MAX_MS);
+    s.lastCorrectionMs = correctionMs;
+    s.corrections++;
+    s.ewmaErrorMs = 0.0f;
+    s.ewmaSamples = 0;
+    metricInc(MET_SLOT_CORRECTIONS_SENT);
+    return true;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         ACCESSORS                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+const SlotTimingStats* SlotMonitor::getStats(uint8_t nodeId) const {
+    if (nodeId < 1 || nodeId > TDMAScheduler::MAX_NODES) return nullptr;
+    return &nodes[nodeId - 1];
+}
+
+uint8_t SlotMonitor::getFlaggedCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < TDMAScheduler::MAX_NODES; i++) {
+        if (nodes[i].flagged) count++;
+    }
+    return count;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REPORTING                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void SlotMonitor::printReport() const {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  SLOT TIMING                                                  ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    if (!isEnabled()) {
+        Serial.println(F("  Off on this node (gateway, or relay with USE_RELAY_SLOT_MONITOR)"));
+        Serial.println();
+        return;
+    }
+    Serial.printf("  Mode:    %s\n", IS_GATEWAY ? "gateway (corrections sent in beacons)" : "relay (monitor only)");
+    Serial.printf("  Guard:   %u ms, flag at %.0f ms, correct above %u ms\n",
+                  SLOT_TIMING_GUARD_MS, FLAG_ERROR_MS, SLOT_CORRECTION_MIN_MS);
+    if (!tdmaScheduler.getStatus().timeSynced) {
+        Serial.println(F("  (time not synced - frames are not being timed)"));
+    }
+
+    Serial.println();
+    Serial.println(F("    Node  Time  Reports   Last   Mean   EWMA    Min    Max  Out  Hit  Corr"));
+    bool any = false;
+    for (uint8_t i = 0; i < TDMAScheduler::MAX_NODES; i++) {
+        const SlotTimingStats& s = nodes[i];
+        if (s.lastHeardMs == 0) continue;
+        any = true;
+        if (s.reports > 0) {
+            Serial.printf("  %s %-3u  %-4s  %7u  %+5d  %+5ld  %+5d  %+5d  %+5d  %3u  %3u  %3u",
+                          s.flagged ? "!" : " ", i + 1,
+                          getTimeSourceString((TimeSource)s.timeSource), s.reports,
+                          s.lastErrorMs, (long)(s.errorSumMs / s.reports),
+                          (int)lroundf(s.ewmaErrorMs), s.minErrorMs, s.maxErrorMs,
+                          s.outOfSlot, s.intrusions, s.corrections);
+        } else {
+            Serial.printf("  %s %-3u  %-4s  %7u  %5s  %5s  %5s  %5s  %5s  %3u  %3u  %3u",
+                          s.flagged ? "!" : " ", i + 1, "-", 0, "-", "-", "-", "-", "-",
+                          s.outOfSlot, s.intrusions, s.corrections);
+        }
+        if (s.corrections > 0) {
+            Serial.printf("  (last %+d ms)", s.lastCorrectionMs);
+        }
+        Serial.println();
+    }
+    if (!any) {
+        Serial.println(F("    (no frames timed yet)"));
+    }
+    Serial.println(F("    Error = report start - scheduled TX second (+ late). Out = frames"));
+    Serial.println(F("    outside own slot, Hit = others' frames inside it, ! = flagged"));
+    Serial.println();
+}
+
+void SlotMonitor::printJson(Print& out) const {
+    out.printf("{\"enabled\":%s,\"guardMs\":%u,\"flagged\":%u,\"nodes\":[",
+               isEnabled() ? "true" : "false", SLOT_TIMING_GUARD_MS, getFlaggedCount());
+    bool first = true;
+    for (uint8_t i = 0; i < TDMAScheduler::MAX_NODES; i++) {
+        const SlotTimingStats& s = nodes[i];
+        if (s.lastHeardMs == 0) continue;
+        out.printf("%s{\"node\":%u,\"timeSource\":\"%s\",\"reports\":%u,\"lastMs\":%d,\"meanMs\":%ld,"
+                   "\"ewmaMs\":%d,\"minMs\":%d,\"maxMs\":%d,\"outOfSlot\":%u,\"intrusions\":%u,"
+                   "\"flagged\":%s,\"corrections\":%u,\"lastCorrectionMs\":%d}",
+                   first ? "" : ",", i + 1, getTimeSourceString((TimeSource)s.timeSource),
+                   s.reports, s.lastErrorMs, s.reports ? (long)(s.errorSumMs / s.reports) : 0L,
+                   (int)lroundf(s.ewmaErrorMs), s.minErrorMs, s.maxErrorMs,
+                   s.outOfSlot, s.intrusions, s.flagged ? "true" : "false",
+                   s.corrections, s.lastCorrectionMs);
+        first = false;
+    }
+    out.print(F("]}"));
+}
@@ -23,6 +23,19 @@ TDMAScheduler::TDMAScheduler() {
     transmissionsCompletedThisSlot = 0;
     slotActiveThisMinute = false;
 
+    // Legacy ID-ordered slots until setDepthOrdering(true)
+    depthOrdered = false;
+    depth = 255;
+    depthBand = 0;
+    secondStartedMs = 0;
+
+    // Depth bands use the full minute until setBeaconSubframe(true)
+    beaconSubframe = false;
+    dataStartSec = 0;
+    bandDurationSec = BAND_DURATION_SEC;
+    subslotDurationSec = SUBSLOT_DURATION_SEC;
+    subslotTxOffset = SUBSLOT_TX_OFFSET;
+
     // Initialize GPS timestamp
     currentTime.hour = 0;
     currentTime.minute = 0;
@@ -46,11 +59,16 @@ void TDMAScheduler::init(uint8_t deviceId) {
     }
 
     // Calculate slot boundaries
+    depthBand = depthOrdered ? bandForDepth(depth) : 0;
     status.slotStartSecond = calculateSlotStart(config.deviceId);
     status.slotEndSecond = calculateSlotEnd(config.deviceId);
 
     Serial.print("[TDMA] Initialized for Device ");
     Serial.println(config.deviceId);
+    if (depthOrdered) {
+        Serial.print("[TDMA] Depth-ordered slots, band ");
+        Serial.println(depthBand);
+    }
     Serial.print("[TDMA] Slot window: seconds ");
     Serial.print(status.slotStartSecond);
     Serial.print(" - ");
@@ -73,7 +91,112 @@ void TDMAScheduler::setTransmissionOffset(uint8_t offset) {
     Serial.println(offset);
 }
 
+void TDMAScheduler::setDepthOrdering(bool enabled) {
+    depthOrdered = enabled;
+    depthBand = depthOrdered ? bandForDepth(depth) : 0;
+    status.slotStartSecond = calculateSlotStart(config.deviceId);
+    status.slotEndSecond = calculateSlotEnd(config.deviceId);
+}
+
+void TDMAScheduler::setDepth(uint8_t distanceToGateway) {
+    // Applied by update() once we are outside our slot
+    depth = distanceToGateway;
+}
+
+uint8_t TDMAScheduler::getDepthBand() {
+    return depthBand;
+}
+
+void TDMAScheduler::setBeaconSubframe(bool enabled) {
+    beaconSubframe = enabled;
+    if (enabled) {
+        dataStartSec = BEACON_SUBFRAME_SEC;
+        bandDurationSec = SUBFRAME_BAND_DURATION_SEC;
+        subslotDurationSec = SUBFRAME_SUBSLOT_SEC;
+        subslotTxOffset = 0;
+    } else {
+        dataStartSec = 0;
+        bandDurationSec = BAND_DURATION_SEC;
+        subslotDurationSec = SUBSLOT_DURATION_SEC;
+        subslotTxOffset = SUBSLOT_TX_OFFSET;
+    }
+    status.slotStartSecond = calculateSlotStart(config.deviceId);
+    status.slotEndSecond = calculateSlotEnd(config.deviceId);
+}
+
+bool TDMAScheduler::isInBeaconSubframe() {
+    return beaconSubframe && status.timeSynced &&
+           getMillisIntoMinute() < BEACON_SUBFRAME_SEC * 1000UL;
+}
+
+uint8_t TDMAScheduler::getTransmissionSecondFor(uint8_t deviceId, uint8_t distanceToGateway) {
+    if (deviceId < 1 || deviceId > MAX_NODES) {
+        return 0;
+    }
+    if (depthOrdered) {
+        return (uint8_t)(dataStartSec + bandForDepth(distanceToGateway) * bandDurationSec +
+                         (deviceId - 1) * subslotDurationSec + subslotTxOffset);
+    }
+    return (uint8_t)((deviceId - 1) * SLOT_DURATION_SEC + config.transmissionOffset);
+}
+
+uint8_t TDMAScheduler::bandForDepth(uint8_t distanceToGateway) {
+    // Deepest first: depth 3+ (or no route) -> 0, depth 2 -> 1, depth 0/1 -> 2
+    if (distanceToGateway >= DEPTH_BANDS) {
+        return 0;
+    }
+    if (distanceToGateway == 0) {
+        return DEPTH_BANDS - 1;
+    }
+    return DEPTH_BANDS - distanceToGateway;
+}
+
+void TDMAScheduler::applySlotLayout() {
+    uint8_t oldStart = status.slotStartSecond;
+
+    depthBand = bandForDepth(depth);
+    status.slotStartSecond = calculateSlotStart(config.deviceId);
+    status.slotEndSecond = calculateSlotEnd(config.deviceId);
+
+    Serial.print("[TDMA] Depth ");
+    Serial.print(depth);
+    Serial.print(" -> band ");
+    Serial.print(depthBand);
+    Serial.print(", slot moved from ");
+    Serial.print(oldStart);
+    Serial.print(" to ");
+    Serial.print(status.slotStartSecond);
+    Serial.print(" - ");
+    Serial.println(status.slotEndSecond);
+}
+
+bool TDMAScheduler::getSlotAt(uint8_t second, uint8_t& band, uint8_t& deviceId) {
+    if (second >= 60) {
+        return false;
+    }
+    if (depthOrdered) {
+        if (second < dataStartSec) {
+            return false;
+        }
+        uint8_t offset = second - dataStartSec;
+        band = offset / bandDurationSec;
+        deviceId = (offset % bandDurationSec) / subslotDurationSec + 1;
+        return band < DEPTH_BANDS && deviceId <= MAX_NODES;
+    }
+    band = 0;
+    deviceId = second / SLOT_DURATION_SEC + 1;
+    return true;
+}
+
 uint8_t TDMAScheduler::calculateSlotStart(uint8_t deviceId) {
+    if (depthOrdered) {
+        // Slot start = band * 20 + (deviceId - 1) * 4 seconds
+        // Band 1: Node 1: 20, Node 2: 24, Node 3: 28, Node 4: 32, Node 5: 36
+        // (beacon sub-frame: 4 + band * 15 + (deviceId - 1) * 3)
+        return (uint8_t)(dataStartSec + depthBand * bandDurationSec +
+                         (deviceId - 1) * subslotDurationSec);
+    }
+
     // Slot start = (deviceId - 1) * 12 seconds
     // Node 1: 0, Node 2: 12, Node 3: 24, Node 4: 36, Node 5: 48
     return (uint8_t)((deviceId - 1) * SLOT_DURATION_SEC);
@@ -81,8 +204,10 @@ uint8_t TDMAScheduler::calculateSlotStart(uint8_t deviceId) {
 
 uint8_t TDMAScheduler::calculateSlotEnd(uint8_t deviceId) {
     // Slot end = slotStart + 11 (gives 12 seconds: 0-11, 12-23, 24-35, 36-47, 48-59)
+    // or the depth-ordered sub-slot length (4 or 3 seconds)
     uint8_t slotStart = calculateSlotStart(deviceId);
-    uint8_t slotEnd = slotStart + (SLOT_DURATION_SEC - 1);
+    uint8_t duration = depthOrdered ? subslotDurationSec : SLOT_DURATION_SEC;
+    uint8_t slotEnd = slotStart + (duration - 1);
     
     // Cap at 59 for last slot
     if (slotEnd > 59) {
@@ -97,6 +222,9 @@ bool TDMAScheduler::isWithinMySlot(uint8_t second) {
 }
 
 uint8_t TDMAScheduler::getAbsoluteTransmissionSecond() {
+    if (depthOrdered) {
+        return status.slotStartSecond + subslotTxOffset;
+    }
     return status.slotStartSecond + config.transmissionOffset;
 }
 
@@ -108,6 +236,11 @@ void TDMAScheduler::update(int gpsHour, int gpsMinute, int gpsSecond, bool gpsVa
     // Update GPS timestamp
     extern int g_year, g_month, g_day;
 
+    // Remember when the second ticked (getCurrentSecond() extrapolates from it)
+    if (!currentTime.valid || currentTime.second != (uint8_t)gpsSecond) {
+        secondStartedMs = millis();
+    }
+
     currentTime.hour = (uint8_t)gpsHour;
     currentTime.minute = (uint8_t)gpsMinute;
     currentTime.second = (uint8_t)gpsSecond;
@@ -126,6 +259,11 @@ void TDMAScheduler::update(int gpsHour, int gpsMinute, int gpsSecond, bool gpsVa
 
     uint8_t currentSec = (uint8_t)gpsSecond;
 
+    // Follow routing depth changes, but never move the slot while inside it
+    if (depthOrdered && !status.isMyTimeSlot && bandForDepth(depth) != depthBand) {
+        applySlotLayout();
+    }
+
     // Check if we're in our slot
     bool wasInSlot = status.isMyTimeSlot;
     status.isMyTimeSlot = isWithinMySlot(currentSec);
@@ -208,6 +346,7 @@ TimeSource TDMAScheduler::updateWithFallback(int gpsHour, int gpsMinute, int gps
     // ─────────────────────────────────────────────────────────────────────────
 
     uint8_t hour, minute, second;
+    uint16_t subSecondMs = 0;
     TimeSource source = TIME_SOURCE_NONE;
 
     if (gpsValid) {
@@ -218,7 +357,7 @@ TimeSource TDMAScheduler::updateWithFallback(int gpsHour, int gpsMinute, int gps
         source = TIME_SOURCE_GPS;
     } else if (isNetworkTimeValid()) {
         // Priority 2: Use network time from beacon (fallback)
-        if (getNetworkTime(hour, minute, second)) {
+        if (getNetworkTimeMs(hour, minute, second, subSecondMs)) {
             source = TIME_SOURCE_NETWORK;
         }
     }
@@ -238,6 +377,11 @@ TimeSource TDMAScheduler::updateWithFallback(int gpsHour, int gpsMinute, int gps
     // Call the main update logic with the determined time
     update((int)hour, (int)minute, (int)second, true);
 
+    // Network time knows where the second boundary is (beacon phase)
+    if (source == TIME_SOURCE_NETWORK) {
+        secondStartedMs = millis() - subSecondMs;
+    }
+
     // Override the legacy gpsTimeSynced to reflect actual source
     status.gpsTimeSynced = gpsValid;
 
@@ -347,4 +491,22 @@ uint8_t TDMAScheduler::getSlotStart() {
 
 uint8_t TDMAScheduler::getSlotEnd() {
     return status.slotEndSecond;
+}
+
+uint8_t TDMAScheduler::getCurrentSecond() {
+    return (uint8_t)(getMillisIntoMinute() / 1000);
+}
+
+uint32_t TDMAScheduler::getMillisIntoMinute() {
+    if (!currentTime.valid) {
+        return currentTime.second * 1000UL;
+    }
+
+    // The GPS/network second only advances when loop() runs update()
+    unsigned long elapsedMs = millis() - secondStartedMs;
+    return (uint32_t)((currentTime.second * 1000UL + elapsedMs) % 60000UL);
+}
+
+uint8_t TDMAScheduler::getCurrentMinute() {
+    return currentTime.minute;
 }
\ No newline at end of file
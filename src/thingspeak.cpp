@@ -6,6 +6,10 @@
 // Statistics
 static unsigned long successCount = 0;
 static unsigned long failCount = 0;
+static unsigned long latencySumMs = 0;
+static unsigned long latencyMaxMs = 0;
+
+static const char* THINGSPEAK_UPDATE_URL = "http://api.thingspeak.com/update";
 
 // Rate limiting - ThingSpeak free tier requires 15 seconds between updates
 static unsigned long lastSendTime = 0;
@@ -14,6 +18,8 @@ const unsigned long THINGSPEAK_MIN_INTERVAL_MS = 15000;  // 15 seconds
 void initThingSpeak() {
     successCount = 0;
     failCount = 0;
+    latencySumMs = 0;
+    latencyMaxMs = 0;
     lastSendTime = 0;
     
     Serial.println(F("[THINGSPEAK] Initialized"));
@@ -22,6 +28,41 @@ void initThingSpeak() {
     Serial.println(F(" seconds"));
 }
 
+const ThingSpeakChannel* findThingSpeakChannel(uint8_t nodeId) {
+    for (uint8_t i = 0; i < THINGSPEAK_CHANNEL_COUNT; i++) {
+        if (THINGSPEAK_CHANNELS[i].nodeId == nodeId) {
+            return &THINGSPEAK_CHANNELS[i];
+        }
+    }
+    return nullptr;
+}
+
+int thingSpeakUpdate(const char* updateUrl, const char* apiKey, uint8_t nodeId,
+                     const FullReportMsg& report, float rssi, String& response) {
+    // Build the URL with all fields
+    String url = updateUrl;
+    url += "?api_key=";
+    url += apiKey;
+    url += "&field1=" + String(report.temperatureF_x10 / 10.0, 1);
+    url += "&field2=" + String(report.humidity_x10 / 10.0, 1);
+    url += "&field3=" + String(report.pressure_hPa);
+    url += "&field4=" + String(nodeId);
+    url += "&field5=" + String((int)rssi);
+    url += "&field6=" + String(report.satellites);
+    url += "&field7=" + String(report.altitude_m);
+    url += "&field8=" + String(report.battery_pct);
+
+    // Make the HTTP request
+    HTTPClient http;
+    http.begin(url);
+    http.setTimeout(10000);
+
+    int httpCode = http.GET();
+    response = http.getString();
+    http.end();
+    return httpCode;
+}
+
 bool sendToThingSpeak(uint8_t nodeId, const FullReportMsg& report, float rssi) {
     // Check if ThingSpeak is enabled
     if (!THINGSPEAK_ENABLED) {
@@ -34,16 +75,9 @@ bool sendToThingSpeak(uint8_t nodeId, const FullReportMsg& report, float rssi) {
         return false;
     }
     
-    // Validate node ID (must be 2-5, gateway doesn't send its own data)
-    if (nodeId < 2 || nodeId > 5) {
-        Serial.print(F("[THINGSPEAK] Invalid node ID for cloud upload: "));
-        Serial.println(nodeId);
-        return false;
-    }
-    
-    // Get the API key for this node
-    // Array index = nodeId - 1 (Node 2 = index 1, Node 3 = index 2, etc.)
-    const char* apiKey = THINGSPEAK_API_KEYS[nodeId - 1];
+    // Get the API key for this node (the gateway doesn't send its own data)
+    const ThingSpeakChannel* channel = findThingSpeakChannel(nodeId);
+    const char* apiKey = (channel != nullptr) ? channel->writeKey : nullptr;
     
     if (apiKey == nullptr || strlen(apiKey) == 0) {
         Serial.print(F("[THINGSPEAK] No API key configured for Node "));
@@ -51,18 +85,6 @@ bool sendToThingSpeak(uint8_t nodeId, const FullReportMsg& report, float rssi) {
         return false;
     }
     
-    // Build the URL with all fields
-    String url = "http://api.thingspeak.com/update?api_key=";
-    url += apiKey;
-    url += "&field1=" + String(report.temperatureF_x10 / 10.0, 1);
-    url += "&field2=" + String(report.humidity_x10 / 10.0, 1);
-    url += "&field3=" + String(report.pressure_hPa);
-    url += "&field4=" + String(nodeId);
-    url += "&field5=" + String((int)rssi);
-    url += "&field6=" + String(report.satellites);
-    url += "&field7=" + String(report.altitude_m);
-    url += "&field8=" + String(report.battery_pct);
-    
     Serial.print(F("[THINGSPEAK] Sending Node "));
     Serial.print(nodeId);
     Serial.print(F(" data | Temp: "));
@@ -71,18 +93,16 @@ bool sendToThingSpeak(uint8_t nodeId, const FullReportMsg& report, float rssi) {
     Serial.print(report.humidity_x10 / 10.0, 1);
     Serial.println(F("%"));
     
-    // Make the HTTP request
-    HTTPClient http;
-    http.begin(url);
-    http.setTimeout(10000);
-    
-    int httpCode = http.GET();
-    String response = http.getString();
-    http.end();
+    String response;
+    unsigned long startMs = millis();
+    int httpCode = thingSpeakUpdate(THINGSPEAK_UPDATE_URL, apiKey, nodeId, report, rssi, response);
+    unsigned long elapsedMs = millis() - startMs;
     
     // Check response
     if (httpCode == 200 && response.toInt() > 0) {
         successCount++;
+        latencySumMs += elapsedMs;
+        if (elapsedMs > latencyMaxMs) latencyMaxMs = elapsedMs;
         Serial.print(F("[THINGSPEAK] Success! Node "));
         Serial.print(nodeId);
         Serial.print(F(" Entry ID: "));
@@ -106,4 +126,12 @@ unsigned long getThingSpeakSuccessCount() {
 
 unsigned long getThingSpeakFailCount() {
     return failCount;
+}
+
+unsigned long getThingSpeakLatencyAvgMs() {
+    return (successCount > 0) ? latencySumMs / successCount : 0;
+}
+
+unsigned long getThingSpeakLatencyMaxMs() {
+    return latencyMaxMs;
 }
\ No newline at end of file
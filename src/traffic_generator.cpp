@@ -0,0 +1,520 @@
+#include "traffic_generator.h"
+#include "transmit_queue.h"
+#include "mesh_debug.h"
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GENERATOR STATE (NODE SIDE)                       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static LoadGenConfig activeConfig;
+static bool generatorActive = false;
+static uint8_t currentTestId = 0;
+static uint8_t currentRate = 0;          // Offered load for the current slot
+static uint8_t slotsAtCurrentRate = 0;   // Ramp progress
+static uint16_t loadSequence = 0;
+static uint16_t generatorDrops = 0;
+static uint32_t framesGenerated = 0;
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MEASUREMENT STATE (GATEWAY SIDE)                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static LoadSourceStats sourceStats[LOADGEN_MAX_SOURCES];
+
+// Load frames use their own (sourceId, testId, sequence) key space so that
+// synthetic traffic never collides with FULL_REPORT message IDs in the main
+// cache. Bit i of seen = sequence (highest - i) was received.
+struct LoadDuplicateWindow {
+    bool     used;
+    uint8_t  sourceId;
+    uint8_t  testId;
+    uint16_t highest;
+    uint32_t seen[LOADGEN_DUP_WINDOW / 32];
+};
+
+static LoadDuplicateWindow loadWindows[LOADGEN_MAX_SOURCES];
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         INITIALIZATION                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void initTrafficGenerator() {
+    memset(&activeConfig, 0, sizeof(activeConfig));
+    generatorActive = false;
+    currentRate = 0;
+    slotsAtCurrentRate = 0;
+    loadSequence = 0;
+    generatorDrops = 0;
+    framesGenerated = 0;
+    clearLoadTestStats();
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GENERATOR CONTROL                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+bool startLoadGenerator(const LoadGenConfig& config) {
+    if (IS_GATEWAY) {
+        Serial.println(F("[LOAD] Gateway measures load - start the generator on a node"));
+        return false;
+    }
+
+    if (config.framesPerSlot == 0 || config.framesPerSlot > LOADGEN_MAX_RATE) {
+        Serial.print(F("[LOAD] Rate must be 1-"));
+        Serial.println(LOADGEN_MAX_RATE);
+        return false;
+    }
+
+    if (config.minBytes < LOADGEN_HEADER_SIZE || config.maxBytes > MAX_MESSAGE_SIZE ||
+        config.minBytes > config.maxBytes) {
+        Serial.print(F("[LOAD] Frame size must be "));
+        Serial.print(LOADGEN_HEADER_SIZE);
+        Serial.print(F("-"));
+        Serial.print(MAX_MESSAGE_SIZE);
+        Serial.println(F(" bytes (min <= max)"));
+        return false;
+    }
+
+    activeConfig = config;
+    if (activeConfig.burstPercent > 100) activeConfig.burstPercent = 100;
+    if (activeConfig.burstMultiplier == 0) activeConfig.burstMultiplier = 1;
+    if (activeConfig.rampTo > LOADGEN_MAX_RATE) activeConfig.rampTo = LOADGEN_MAX_RATE;
+    if (activeConfig.rampSlotsPerStep == 0) activeConfig.rampSlotsPerStep = 1;
+
+    // New test ID so the gateway starts a fresh measurement window
+    currentTestId++;
+    currentRate = activeConfig.framesPerSlot;
+    slotsAtCurrentRate = 0;
+    loadSequence = 0;
+    generatorDrops = 0;
+    framesGenerated = 0;
+    generatorActive = true;
+
+    Serial.print(F("[LOAD] Generator started | test="));
+    Serial.print(currentTestId);
+    Serial.print(F(" rate="));
+    Serial.print(currentRate);
+    Serial.print(F("/slot size="));
+    Serial.print(activeConfig.minBytes);
+    Serial.print(F("-"));
+    Serial.print(activeConfig.maxBytes);
+    Serial.print(F("B burst="));
+    Serial.print(activeConfig.burstPercent);
+    Serial.print(F("%x"));
+    Serial.println(activeConfig.burstMultiplier);
+
+    return true;
+}
+
+void stopLoadGenerator() {
+    if (generatorActive) {
+        Serial.print(F("[LOAD] Generator stopped | frames="));
+        Serial.print(framesGenerated);
+        Serial.print(F(" drops="));
+        Serial.println(generatorDrops);
+    }
+    generatorActive = false;
+}
+
+bool isLoadGeneratorActive() {
+    return generatorActive;
+}
+
+LoadGenConfig getLoadGenConfig() {
+    return activeConfig;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FRAME GENERATION                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static uint8_t encodeLoadFrame(uint8_t* buffer, uint8_t size) {
+    uint8_t idx = 0;
+
+    // MeshHeader (8 bytes) - messageId mirrors the low byte of the sequence
+    buffer[idx++] = MESH_PROTOCOL_VERSION;
+    buffer[idx++] = MSG_LOAD_TEST;
+    buffer[idx++] = DEVICE_ID;
+    buffer[idx++] = ADDR_BROADCAST;
+    buffer[idx++] = DEVICE_ID;
+    buffer[idx++] = loadSequence & 0xFF;
+    buffer[idx++] = MESH_DEFAULT_TTL;
+    buffer[idx++] = 0;
+
+    // Load test fields (10 bytes)
+    buffer[idx++] = currentTestId;
+    buffer[idx++] = currentRate;
+    buffer[idx++] = loadSequence & 0xFF;
+    buffer[idx++] = (loadSequence >> 8) & 0xFF;
+    buffer[idx++] = 0;  // latencyMs - stamped at transmit time
+    buffer[idx++] = 0;
+    buffer[idx++] = 0;
+    buffer[idx++] = 0;
+    buffer[idx++] = generatorDrops & 0xFF;
+    buffer[idx++] = (generatorDrops >> 8) & 0xFF;
+
+    // Filler up to the requested size
+    while (idx < size) {
+        buffer[idx] = idx;
+        idx++;
+    }
+
+    return idx;
+}
+
+uint8_t loadGenOnSlot() {
+    if (!generatorActive) {
+        return 0;
+    }
+
+    // Burstiness: some slots offer a multiple of the configured rate
+    uint8_t framesThisSlot = currentRate;
+    if (activeConfig.burstPercent > 0 && random(100) < activeConfig.burstPercent) {
+        framesThisSlot = min((int)currentRate * activeConfig.burstMultiplier, LOADGEN_MAX_BURST);
+    }
+
+    uint8_t enqueued = 0;
+    uint8_t frame[MAX_MESSAGE_SIZE];
+
+    for (uint8_t i = 0; i < framesThisSlot; i++) {
+        // Uniform size distribution between min and max
+        uint8_t size = activeConfig.minBytes;
+        if (activeConfig.maxBytes > activeConfig.minBytes) {
+            size = random(activeConfig.minBytes, activeConfig.maxBytes + 1);
+        }
+
+        uint8_t length = encodeLoadFrame(frame, size);
+        loadSequence++;
+        framesGenerated++;
+
+        if (transmitQueue.enqueue(frame, length)) {
+            enqueued++;
+        } else {
+            generatorDrops++;
+        }
+    }
+
+    DEBUG_QUE_F("Load generator | offered=%d enqueued=%d drops=%u depth=%d/%d",
+                framesThisSlot, enqueued, generatorDrops, transmitQueue.depth(), TX_QUEUE_SIZE);
+
+    // Ramp: step the offered load up after rampSlotsPerStep slots
+    if (activeConfig.rampTo > 0) {
+        slotsAtCurrentRate++;
+        if (slotsAtCurrentRate >= activeConfig.rampSlotsPerStep) {
+            slotsAtCurrentRate = 0;
+            if (currentRate >= activeConfig.rampTo) {
+                Serial.println(F("[LOAD] Ramp complete"));
+                stopLoadGenerator();
+            } else {
+                currentRate++;
+                Serial.print(F("[LOAD] Ramp step -> "));
+                Serial.print(currentRate);
+                Serial.println(F(" frames/slot"));
+            }
+        }
+    }
+
+    return enqueued;
+}
+
+void loadGenStampResidence(uint8_t* data, uint8_t length, uint32_t residenceMs) {
+    if (length < LOADGEN_HEADER_SIZE || data[1] != MSG_LOAD_TEST) {
+        return;
+    }
+
+    // latencyMs lives at offset 12 (little-endian)
+    uint32_t latency = data[12] | (data[13] << 8) | ((uint32_t)data[14] << 16) | ((uint32_t)data[15] << 24);
+    latency += residenceMs;
+    data[12] = latency & 0xFF;
+    data[13] = (latency >> 8) & 0xFF;
+    data[14] = (latency >> 16) & 0xFF;
+    data[15] = (latency >> 24) & 0xFF;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GATEWAY MEASUREMENT                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static LoadSourceStats* findOrCreateSource(uint8_t sourceId, uint8_t testId) {
+    LoadSourceStats* freeSlot = nullptr;
+
+    for (uint8_t i = 0; i < LOADGEN_MAX_SOURCES; i++) {
+        if (sourceStats[i].used && sourceStats[i].sourceId == sourceId) {
+            // A new test ID from the same source starts a fresh window
+            if (sourceStats[i].testId != testId) {
+                memset(&sourceStats[i], 0, sizeof(LoadSourceStats));
+                sourceStats[i].used = true;
+                sourceStats[i].sourceId = sourceId;
+                sourceStats[i].testId = testId;
+            }
+            return &sourceStats[i];
+        }
+        if (!sourceStats[i].used && freeSlot == nullptr) {
+            freeSlot = &sourceStats[i];
+        }
+    }
+
+    if (freeSlot != nullptr) {
+        memset(freeSlot, 0, sizeof(LoadSourceStats));
+        freeSlot->used = true;
+        freeSlot->sourceId = sourceId;
+        freeSlot->testId = testId;
+    }
+    return freeSlot;
+}
+
+static LoadLevelStats* findOrCreateLevel(LoadSourceStats* source, uint8_t offered) {
+    for (uint8_t i = 0; i < source->levelCount; i++) {
+        if (source->levels[i].offeredPerSlot == offered) {
+            return &source->levels[i];
+        }
+    }
+
+    if (source->levelCount >= LOADGEN_MAX_LEVELS) {
+        return nullptr;
+    }
+
+    LoadLevelStats* level = &source->levels[source->levelCount++];
+    memset(level, 0, sizeof(LoadLevelStats));
+    level->offeredPerSlot = offered;
+    level->used = true;
+    return level;
+}
+
+bool recordLoadTestFrame(const uint8_t* data, uint8_t length) {
+    if (length < LOADGEN_HEADER_SIZE || data[1] != MSG_LOAD_TEST) {
+        return false;
+    }
+
+    uint8_t sourceId = data[2];
+    uint8_t testId = data[8];
+    uint8_t offered = data[9];
+    uint16_t sequence = data[10] | (data[11] << 8);
+    uint32_t latency = data[12] | (data[13] << 8) | ((uint32_t)data[14] << 16) | ((uint32_t)data[15] << 24);
+    uint16_t drops = data[16] | (data[17] << 8);
+
+    LoadSourceStats* source = findOrCreateSource(sourceId, testId);
+    if (source == nullptr) {
+        return false;
+    }
+
+    LoadLevelStats* level = findOrCreateLevel(source, offered);
+    if (level == nullptr) {
+        return false;
+    }
+
+    uint32_t now = millis();
+    if (level->received == 0) {
+        level->firstSeq = sequence;
+        level->highestSeq = sequence;
+        level->firstRxMs = now;
+        level->dropsAtStart = drops;
+    }
+    if ((int16_t)(sequence - level->highestSeq) > 0) {
+        level->highestSeq = sequence;
+    }
+    if ((int16_t)(sequence - level->firstSeq) < 0) {
+        level->firstSeq = sequence;
+    }
+    if (drops > level->dropsAtEnd) {
+        level->dropsAtEnd = drops;
+    }
+
+    level->received++;
+    level->bytes += length - LOADGEN_HEADER_SIZE;   // Padding only: headers are not goodput
+    level->latencySumMs += latency;
+    if (latency > level->latencyMaxMs) {
+        level->latencyMaxMs = latency;
+    }
+    level->lastRxMs = now;
+
+    return true;
+}
+
+static LoadDuplicateWindow* findOrCreateWindow(uint8_t sourceId, uint8_t testId) {
+    LoadDuplicateWindow* freeSlot = nullptr;
+
+    for (uint8_t i = 0; i < LOADGEN_MAX_SOURCES; i++) {
+        if (loadWindows[i].used && loadWindows[i].sourceId == sourceId) {
+            // A new test restarts the sequence at 0
+            if (loadWindows[i].testId != testId) {
+                memset(&loadWindows[i], 0, sizeof(LoadDuplicateWindow));
+                loadWindows[i].used = true;
+                loadWindows[i].sourceId = sourceId;
+                loadWindows[i].testId = testId;
+            }
+            return &loadWindows[i];
+        }
+        if (!loadWindows[i].used && freeSlot == nullptr) {
+            freeSlot = &loadWindows[i];
+        }
+    }
+
+    if (freeSlot != nullptr) {
+        memset(freeSlot, 0, sizeof(LoadDuplicateWindow));
+        freeSlot->used = true;
+        freeSlot->sourceId = sourceId;
+        freeSlot->testId = testId;
+    }
+    return freeSlot;
+}
+
+// Move the window up to a newer sequence
+static void shiftWindow(LoadDuplicateWindow* window, uint16_t ahead) {
+    const uint8_t words = LOADGEN_DUP_WINDOW / 32;
+    if (ahead >= LOADGEN_DUP_WINDOW) {
+        memset(window->seen, 0, sizeof(window->seen));
+        return;
+    }
+    uint8_t wordShift = ahead / 32;
+    uint8_t bitShift = ahead % 32;
+    for (int8_t i = words - 1; i >= 0; i--) {
+        uint32_t value = 0;
+        if (i - wordShift >= 0) {
+            value = window->seen[i - wordShift] << bitShift;
+            if (bitShift > 0 && i - wordShift - 1 >= 0) {
+                value |= window->seen[i - wordShift - 1] >> (32 - bitShift);
+            }
+        }
+        window->seen[i] = value;
+    }
+}
+
+bool isLoadTestDuplicate(const uint8_t* data, uint8_t length) {
+    if (length < LOADGEN_HEADER_SIZE) {
+        return true;
+    }
+
+    LoadTestMsg msg;
+    memcpy(&msg, data, sizeof(LoadTestMsg));
+
+    LoadDuplicateWindow* window = findOrCreateWindow(msg.meshHeader.sourceId, msg.testId);
+    if (window == nullptr) {
+        return false;   // More sources than the gateway tracks: not measured anyway
+    }
+
+    // The highest sequence is always marked: bit 0 clear means an empty window
+    bool empty = (window->seen[0] & 1) == 0;
+    int16_t ahead = (int16_t)(msg.sequence - window->highest);
+    if (empty || ahead > 0) {
+        shiftWindow(window, empty ? LOADGEN_DUP_WINDOW : (uint16_t)ahead);
+        window->highest = msg.sequence;
+        window->seen[0] |= 1;
+        return false;
+    }
+
+    uint16_t age = (uint16_t)-ahead;
+    if (age >= LOADGEN_DUP_WINDOW) {
+        return true;    // Older than the window: cannot tell, never count it twice
+    }
+    uint32_t bit = 1UL << (age % 32);
+    if (window->seen[age / 32] & bit) {
+        return true;
+    }
+    window->seen[age / 32] |= bit;
+    return false;
+}
+
+const LoadSourceStats* getLoadSourceStats(uint8_t index) {
+    if (index >= LOADGEN_MAX_SOURCES || !sourceStats[index].used) {
+        return nullptr;
+    }
+    return &sourceStats[index];
+}
+
+void clearLoadTestStats() {
+    memset(sourceStats, 0, sizeof(sourceStats));
+    memset(loadWindows, 0, sizeof(loadWindows));
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REPORTING                                         ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void printLoadGenStatus() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  LOAD GENERATOR STATUS                                        ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    Serial.print(F("  State:           "));
+    Serial.println(generatorActive ? F("RUNNING") : F("STOPPED"));
+    Serial.print(F("  Test ID:         "));
+    Serial.println(currentTestId);
+    Serial.print(F("  Offered Load:    "));
+    Serial.print(currentRate);
+    Serial.println(F(" frames/slot"));
+    Serial.print(F("  Frame Size:      "));
+    Serial.print(activeConfig.minBytes);
+    Serial.print(F("-"));
+    Serial.print(activeConfig.maxBytes);
+    Serial.println(F(" bytes"));
+    Serial.print(F("  Burst:           "));
+    Serial.print(activeConfig.burstPercent);
+    Serial.print(F("% of slots x"));
+    Serial.println(activeConfig.burstMultiplier);
+    if (activeConfig.rampTo > 0) {
+        Serial.print(F("  Ramp:            to "));
+        Serial.print(activeConfig.rampTo);
+        Serial.print(F(" every "));
+        Serial.print(activeConfig.rampSlotsPerStep);
+        Serial.println(F(" slot(s)"));
+    }
+    Serial.print(F("  Frames Generated: "));
+    Serial.println(framesGenerated);
+    Serial.print(F("  Queue Drops:     "));
+    Serial.println(generatorDrops);
+    Serial.println(F("─────────────────────────────────────────────────────────────────"));
+}
+
+void printLoadReport() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  CAPACITY TEST REPORT                                         ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    bool any = false;
+    for (uint8_t s = 0; s < LOADGEN_MAX_SOURCES; s++) {
+        const LoadSourceStats* source = getLoadSourceStats(s);
+        if (source == nullptr) continue;
+        any = true;
+
+        Serial.print(F("  Source Node "));
+        Serial.print(source->sourceId);
+        Serial.print(F("  (test "));
+        Serial.print(source->testId);
+        Serial.println(F(")"));
+        Serial.println(F("  Offered │ Rx    │ Loss%  │ Goodput B/min │ Lat avg/max ms │ SrcDrops"));
+
+        for (uint8_t l = 0; l < source->levelCount; l++) {
+            const LoadLevelStats& level = source->levels[l];
+            uint32_t expected = (uint16_t)(level.highestSeq - level.firstSeq) + 1;
+            float lossPct = 0.0f;
+            if (expected > level.received) {
+                lossPct = 100.0f * (expected - level.received) / expected;
+            }
+
+            // Goodput over the window this level was observed (min 1 s)
+            uint32_t windowMs = level.lastRxMs - level.firstRxMs;
+            if (windowMs < 1000) windowMs = 1000;
+            uint32_t goodputPerMin = (uint32_t)((uint64_t)level.bytes * 60000UL / windowMs);
+            uint32_t avgLatency = level.received > 0 ? level.latencySumMs / level.received : 0;
+
+            Serial.printf("  %7u │ %5lu │ %5.1f%% │ %13lu │ %6lu/%-7lu │ %u\n",
+                          level.offeredPerSlot,
+                          (unsigned long)level.received,
+                          lossPct,
+                          (unsigned long)goodputPerMin,
+                          (unsigned long)avgLatency,
+                          (unsigned long)level.latencyMaxMs,
+                          (unsigned)(level.dropsAtEnd - level.dropsAtStart));
+        }
+        Serial.println();
+    }
+
+    if (!any) {
+        Serial.println(F("  No load test traffic received."));
+        Serial.println(F("  Start a generator on a node: mesh load start <rate>"));
+    }
+    Serial.println(F("─────────────────────────────────────────────────────────────────"));
+}
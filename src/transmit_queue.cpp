@@ -1,5 +1,6 @@
 #include "transmit_queue.h"
 #include "mesh_debug.h"
+#include "metrics.h"
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                         GLOBAL INSTANCE                                   ║
@@ -41,6 +42,7 @@ bool TransmitQueue::enqueue(const uint8_t* data, uint8_t len) {
 
     // Increment count
     count++;
+    metricObserve(HIST_TX_QUEUE_DEPTH, count);
 
     return true;
 }
@@ -0,0 +1,258 @@
+#include "ubx.h"
+#include <string.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FIELD HELPERS                                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static uint16_t readU2(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t readU4(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int32_t readI4(const uint8_t* p) {
+    return (int32_t)readU4(p);
+}
+
+static void writeU2(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void writeU4(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FRAME BUILDING                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void ubxChecksum(const uint8_t* data, uint16_t len, uint8_t& ckA, uint8_t& ckB) {
+    ckA = 0;
+    ckB = 0;
+    for (uint16_t i = 0; i < len; i++) {
+        ckA += data[i];
+        ckB += ckA;
+    }
+}
+
+uint16_t ubxBuildFrame(uint8_t msgClass, uint8_t msgId, const uint8_t* payload, uint16_t len,
+                       uint8_t* out) {
+    if (len > UBX_MAX_PAYLOAD) return 0;
+
+    out[0] = UBX_SYNC_1;
+    out[1] = UBX_SYNC_2;
+    out[2] = msgClass;
+    out[3] = msgId;
+    writeU2(out + 4, len);
+    if (len > 0) memcpy(out + 6, payload, len);
+
+    uint8_t ckA, ckB;
+    ubxChecksum(out + 2, len + 4, ckA, ckB);
+    out[6 + len] = ckA;
+    out[7 + len] = ckB;
+    return len + UBX_FRAME_OVERHEAD;
+}
+
+uint16_t ubxBuildCfgMsg(uint8_t msgClass, uint8_t msgId, uint8_t rate, uint8_t* out) {
+    const uint8_t payload[3] = { msgClass, msgId, rate };
+    return ubxBuildFrame(UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload), out);
+}
+
+uint16_t ubxBuildCfgRxm(bool powerSave, uint8_t* out) {
+    // reserved1 must be 8; lpMode 0 = continuous, 1 = power save
+    const uint8_t payload[2] = { 8, (uint8_t)(powerSave ? 1 : 0) };
+    return ubxBuildFrame(UBX_CLASS_CFG, UBX_CFG_RXM, payload, sizeof(payload), out);
+}
+
+// CFG-PM2 flags (u-blox 6)
+static const uint32_t PM2_LIMIT_PEAK_CURRENT = 1UL << 8;    // limitPeakCurr = 1 (limited)
+static const uint32_t PM2_WAIT_TIME_FIX      = 1UL << 10;   // Stay on until time is fixed
+static const uint32_t PM2_UPDATE_RTC         = 1UL << 11;
+static const uint32_t PM2_UPDATE_EPH         = 1UL << 12;   // Wake to keep ephemeris valid
+
+static const uint32_t PM2_SEARCH_PERIOD_MS   = 10000;       // Retry interval after losing all satellites
+static const uint16_t PM2_ON_TIME_SEC        = 2;           // ON/OFF: stay on this long after a fix
+
+uint16_t ubxBuildCfgPm2(uint32_t updatePeriodMs, uint8_t* out) {
+    uint8_t payload[44];
+    memset(payload, 0, sizeof(payload));
+
+    payload[0] = 1;     // version
+    writeU4(payload + 4, PM2_LIMIT_PEAK_CURRENT | PM2_WAIT_TIME_FIX | PM2_UPDATE_RTC | PM2_UPDATE_EPH);
+    writeU4(payload + 8, updatePeriodMs);
+    writeU4(payload + 12, PM2_SEARCH_PERIOD_MS);
+    // gridOffset (16) = 0: fixes aligned to the GPS time grid
+    if (updatePeriodMs > UBX_PM2_CYCLIC_MAX_MS) {
+        writeU2(payload + 20, PM2_ON_TIME_SEC);
+    }
+    return ubxBuildFrame(UBX_CLASS_CFG, UBX_CFG_PM2, payload, sizeof(payload), out);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STREAM PARSER                                     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+UbxParser::UbxParser() {
+    reset();
+    memset(&stats, 0, sizeof(stats));
+}
+
+void UbxParser::reset() {
+    state = WAIT_SYNC_1;
+    received = 0;
+    ckA = 0;
+    ckB = 0;
+    rxCkA = 0;
+    memset(&current, 0, sizeof(current));
+}
+
+void UbxParser::addToChecksum(uint8_t byte) {
+    ckA += byte;
+    ckB += ckA;
+}
+
+UbxFeedResult UbxParser::feed(uint8_t byte) {
+    switch (state) {
+        case WAIT_SYNC_1:
+            if (byte == UBX_SYNC_1) {
+                state = WAIT_SYNC_2;
+                return UBX_FEED_PARTIAL;
+            }
+            stats.otherBytes++;
+            return UBX_FEED_NONE;
+
+        case WAIT_SYNC_2:
+            if (byte == UBX_SYNC_2) {
+                state = READ_CLASS;
+                ckA = 0;
+                ckB = 0;
+                return UBX_FEED_PARTIAL;
+            }
+            // Stray 0xB5: this byte may itself start a frame
+            state = WAIT_SYNC_1;
+            return feed(byte);
+
+        case READ_CLASS:
+            current.msgClass = byte;
+            addToChecksum(byte);
+            state = READ_ID;
+            return UBX_FEED_PARTIAL;
+
+        case READ_ID:
+            current.msgId = byte;
+            addToChecksum(byte);
+            state = READ_LEN_1;
+            return UBX_FEED_PARTIAL;
+
+        case READ_LEN_1:
+            current.length = byte;
+            addToChecksum(byte);
+            state = READ_LEN_2;
+            return UBX_FEED_PARTIAL;
+
+        case READ_LEN_2:
+            current.length |= (uint16_t)byte << 8;
+            addToChecksum(byte);
+            received = 0;
+            state = current.length > 0 ? READ_PAYLOAD : READ_CK_A;
+            return UBX_FEED_PARTIAL;
+
+        case READ_PAYLOAD:
+            if (received < UBX_MAX_PAYLOAD) current.payload[received] = byte;
+            received++;
+            addToChecksum(byte);
+            if (received >= current.length) state = READ_CK_A;
+            return UBX_FEED_PARTIAL;
+
+        case READ_CK_A:
+            rxCkA = byte;
+            state = READ_CK_B;
+            return UBX_FEED_PARTIAL;
+
+        case READ_CK_B:
+            state = WAIT_SYNC_1;
+            if (rxCkA != ckA || byte != ckB) {
+                stats.checksumErrors++;
+                return UBX_FEED_ERROR;
+            }
+            if (current.length > UBX_MAX_PAYLOAD) {
+                stats.oversized++;
+                return UBX_FEED_PARTIAL;
+            }
+            stats.frames++;
+            return UBX_FEED_FRAME;
+    }
+    return UBX_FEED_NONE;
+}
+
+const UbxFrame& UbxParser::frame() const {
+    return current;
+}
+
+const UbxParserStats& UbxParser::getStats() const {
+    return stats;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         MESSAGE DECODING                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+uint8_t ubxDecodeNav(const UbxFrame& frame, UbxNavState& state) {
+    if (frame.msgClass != UBX_CLASS_NAV) return 0;
+    const uint8_t* p = frame.payload;
+
+    switch (frame.msgId) {
+        case UBX_NAV_POSLLH:
+            if (frame.length != 28) return 0;
+            state.lonE7 = readI4(p + 4);
+            state.latE7 = readI4(p + 8);
+            state.heightMslMm = readI4(p + 16);
+            state.hAccMm = readU4(p + 20);
+            state.seen |= UBX_SEEN_POSLLH;
+            return UBX_SEEN_POSLLH;
+
+        case UBX_NAV_SOL:
+            if (frame.length != 52) return 0;
+            state.fixType = p[10];
+            state.fixOk = (p[11] & 0x01) != 0;
+            state.numSV = p[47];
+            state.seen |= UBX_SEEN_SOL;
+            return UBX_SEEN_SOL;
+
+        case UBX_NAV_DOP:
+            if (frame.length != 18) return 0;
+            state.hDopX100 = readU2(p + 12);
+            state.seen |= UBX_SEEN_DOP;
+            return UBX_SEEN_DOP;
+
+        case UBX_NAV_TIMEUTC:
+            if (frame.length != 20) return 0;
+            state.tAccNs = readU4(p + 4);
+            state.nanos = readI4(p + 8);
+            state.year = readU2(p + 12);
+            state.month = p[14];
+            state.day = p[15];
+            state.hour = p[16];
+            state.minute = p[17];
+            state.second = p[18];
+            state.timeValid = (p[19] & 0x04) != 0;
+            state.seen |= UBX_SEEN_TIMEUTC;
+            return UBX_SEEN_TIMEUTC;
+    }
+    return 0;
+}
+
+bool ubxIsAckFor(const UbxFrame& frame, uint8_t msgClass, uint8_t msgId, bool& acked) {
+    if (frame.msgClass != UBX_CLASS_ACK || frame.length != 2) return false;
+    if (frame.msgId != UBX_ACK_ACK && frame.msgId != UBX_ACK_NAK) return false;
+    if (frame.payload[0] != msgClass || frame.payload[1] != msgId) return false;
+    acked = frame.msgId == UBX_ACK_ACK;
+    return true;
+}
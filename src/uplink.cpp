@@ -0,0 +1,439 @@
+#include "uplink.h"
+#include "thingspeak.h"
+#include "mqtt_uplink.h"
+#include <WiFi.h>
+#include <Preferences.h>
+#include <atomic>
+#include <new>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL STATE                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static const char* NVS_NAMESPACE = "uplink";
+
+static UplinkBackend currentBackend = UPLINK_DEFAULT_BACKEND;
+static MqttUplink mqttUplink;
+static char mqttClientId[MQTT_CLIENT_ID_MAX];
+static char mqttTopic[MQTT_TOPIC_MAX];
+
+// Set last in initUplink() on the boot task (core 0), read from loop() -
+// reports before that are handled like a WiFi outage
+static std::atomic<bool> uplinkStarted(false);
+
+static void startMqtt() {
+    mqttUplink.begin(MQTT_BROKER_HOST, MQTT_BROKER_PORT, mqttClientId, mqttTopic,
+                     MQTT_USERNAME, MQTT_PASSWORD, MQTT_KEEPALIVE_SEC);
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         INITIALIZATION                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void initUplink() {
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, true)) {
+        uint8_t saved = prefs.getUChar("backend", UPLINK_DEFAULT_BACKEND);
+        prefs.end();
+        if (saved <= UPLINK_MQTT) currentBackend = (UplinkBackend)saved;
+    }
+
+    // Same client ID every boot so the broker resumes our session
+    snprintf(mqttClientId, sizeof(mqttClientId), "mesh-gw-%u", DEVICE_ID);
+    snprintf(mqttTopic, sizeof(mqttTopic), "%s/gw%u/reports", MQTT_TOPIC_PREFIX, DEVICE_ID);
+
+    initThingSpeak();
+    if (currentBackend == UPLINK_MQTT) startMqtt();
+    uplinkStarted = true;
+
+    Serial.print(F("[UPLINK] Backend: "));
+    Serial.println(getUplinkBackendName(currentBackend));
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         REPORT ROUTING                                    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+bool uplinkReport(uint8_t nodeId, const FullReportMsg& report, float rssi) {
+    switch (currentBackend) {
+        case UPLINK_THINGSPEAK:
+            return sendToThingSpeak(nodeId, report, rssi);
+        case UPLINK_MQTT:
+            return uplinkStarted && mqttUplink.enqueue(nodeId, report, rssi);
+        case UPLINK_OFF:
+        default:
+            return false;
+    }
+}
+
+void uplinkUpdate() {
+    if (!uplinkStarted || currentBackend != UPLINK_MQTT) return;
+    if (WiFi.status() != WL_CONNECTED) return;
+    mqttUplink.update();
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BACKEND SELECTION                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+UplinkBackend getUplinkBackend() {
+    return currentBackend;
+}
+
+void setUplinkBackend(UplinkBackend backend) {
+    if (backend != currentBackend) {
+        if (currentBackend == UPLINK_MQTT) mqttUplink.stop();
+        currentBackend = backend;
+        if (backend == UPLINK_MQTT && uplinkStarted) startMqtt();
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) return;
+    prefs.putUChar("backend", backend);
+    prefs.end();
+}
+
+const char* getUplinkBackendName(UplinkBackend backend) {
+    switch (backend) {
+        case UPLINK_THINGSPEAK: return "thingspeak";
+        case UPLINK_MQTT:       return "mqtt";
+        case UPLINK_OFF:        return "off";
+        default:                return "unknown";
+    }
+}
+
+bool parseUplinkBackend(const String& name, UplinkBackend& backend) {
+    if (name == "thingspeak") {
+        backend = UPLINK_THINGSPEAK;
+    } else if (name == "mqtt") {
+        backend = UPLINK_MQTT;
+    } else if (name == "off") {
+        backend = UPLINK_OFF;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STATUS                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void printUplinkStatus() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  CLOUD UPLINK                                                 ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+
+    Serial.printf("  Backend:          %s%s\n", getUplinkBackendName(currentBackend),
+                  uplinkStarted ? "" : " (waiting for WiFi)");
+
+    Serial.println(F("  ThingSpeak (HTTP GET per report)"));
+    Serial.printf("  Uploads:          %lu ok, %lu failed\n",
+                  getThingSpeakSuccessCount(), getThingSpeakFailCount());
+    Serial.printf("  Request time:     %lu ms avg, %lu ms max\n",
+                  getThingSpeakLatencyAvgMs(), getThingSpeakLatencyMaxMs());
+
+    Serial.println(F("  MQTT (batched QoS 1, persistent session)"));
+    mqttUplink.printStatus();
+    Serial.println();
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UPLINK BENCHMARK                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#define UPLINK_BENCH_BROKER_BUFFER  1024
+
+// Shared between the bench (loop task) and the stand-in server task
+struct UplinkBenchServers {
+    std::atomic<bool>     running;
+    std::atomic<bool>     ready;
+    std::atomic<bool>     finished;
+    std::atomic<uint32_t> httpRequests;
+    std::atomic<uint32_t> publishes;
+    std::atomic<uint32_t> duplicates;       // PUBLISH with DUP set
+    std::atomic<uint32_t> records;          // Reports in first-time publishes
+    uint8_t               brokerBuffer[UPLINK_BENCH_BROKER_BUFFER];
+    uint16_t              brokerLength;
+};
+
+struct UplinkBenchResult {
+    uint16_t      delivered;
+    unsigned long requests;
+    unsigned long elapsedMs;
+    unsigned long latencySumMs;
+    unsigned long latencyMaxMs;
+};
+
+/**
+ * Broker stand-in: CONNACK, PUBACK for QoS 1 and PINGRESP - just enough
+ * for MqttUplink. No subscriptions and no session state.
+ */
+static void serviceBenchBroker(WiFiClient& peer, UplinkBenchServers& servers) {
+    uint8_t* buffer = servers.brokerBuffer;
+    while (peer.available() > 0 && servers.brokerLength < UPLINK_BENCH_BROKER_BUFFER) {
+        int n = peer.read(buffer + servers.brokerLength, UPLINK_BENCH_BROKER_BUFFER - servers.brokerLength);
+        if (n <= 0) break;
+        servers.brokerLength += n;
+    }
+
+    uint16_t offset = 0;
+    while (servers.brokerLength - offset >= 2) {
+        uint32_t remaining = 0;
+        uint8_t shift = 0;
+        uint16_t pos = offset + 1;
+        bool lengthComplete = false;
+        while (pos < servers.brokerLength && shift < 28) {
+            uint8_t digit = buffer[pos++];
+            remaining |= (uint32_t)(digit & 0x7F) << shift;
+            shift += 7;
+            if (!(digit & 0x80)) {
+                lengthComplete = true;
+                break;
+            }
+        }
+        if (!lengthComplete || pos + remaining > servers.brokerLength) break;
+
+        uint8_t header = buffer[offset];
+        const uint8_t* body = buffer + pos;
+        switch (header >> 4) {
+            case 1: {       // CONNECT
+                static const uint8_t connack[] = { 0x20, 2, 0, 0 };
+                peer.write(connack, sizeof(connack));
+                break;
+            }
+            case 3: {       // PUBLISH, QoS 1
+                uint16_t topicLength = ((uint16_t)body[0] << 8) | body[1];
+                const uint8_t* packetId = body + 2 + topicLength;
+                if (header & 0x08) {
+                    servers.duplicates++;
+                } else {
+                    servers.records += packetId[2 + 2];     // Payload: version, gateway, count
+                }
+                servers.publishes++;
+                uint8_t puback[] = { 0x40, 2, packetId[0], packetId[1] };
+                peer.write(puback, sizeof(puback));
+                break;
+            }
+            case 12: {      // PINGREQ
+                static const uint8_t pingresp[] = { 0xD0, 0 };
+                peer.write(pingresp, sizeof(pingresp));
+                break;
+            }
+            default:
+                break;
+        }
+        offset = pos + remaining;
+    }
+
+    memmove(buffer, buffer + offset, servers.brokerLength - offset);
+    servers.brokerLength -= offset;
+}
+
+/**
+ * ThingSpeak stand-in: answers each GET with an increasing entry ID
+ */
+static void serviceBenchHttp(WiFiServer& http, UplinkBenchServers& servers) {
+    WiFiClient request = http.available();
+    if (!request) return;
+
+    static const char END_OF_HEADERS[] = "\r\n\r\n";
+    uint8_t matched = 0;
+    unsigned long start = millis();
+    while (matched < 4 && request.connected() && millis() - start < 1000) {
+        int c = request.read();
+        if (c < 0) {
+            vTaskDelay(1);
+            continue;
+        }
+        matched = (c == END_OF_HEADERS[matched]) ? matched + 1 : (c == '\r' ? 1 : 0);
+    }
+
+    uint32_t entryId = ++servers.httpRequests;
+    char body[12];
+    int bodyLength = snprintf(body, sizeof(body), "%lu", (unsigned long)entryId);
+    char response[128];
+    int length = snprintf(response, sizeof(response),
+                          "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n"
+                          "Content-Length: %d\r\nConnection: close\r\n\r\n%s", bodyLength, body);
+    request.write((const uint8_t*)response, length);
+    request.stop();
+}
+
+static void uplinkBenchServerTask(void* param) {
+    UplinkBenchServers* servers = (UplinkBenchServers*)param;
+
+    WiFiServer broker(UPLINK_BENCH_MQTT_PORT);
+    WiFiServer http(UPLINK_BENCH_HTTP_PORT);
+    broker.begin();
+    broker.setNoDelay(true);
+    http.begin();
+    http.setNoDelay(true);
+    servers->ready = true;
+
+    WiFiClient peer;
+    while (servers->running) {
+        WiFiClient incoming = broker.available();
+        if (incoming) {
+            peer.stop();
+            peer = incoming;
+            peer.setNoDelay(true);
+            servers->brokerLength = 0;
+        }
+        if (peer.connected()) serviceBenchBroker(peer, *servers);
+        serviceBenchHttp(http, *servers);
+        vTaskDelay(1);
+    }
+
+    peer.stop();
+    broker.end();
+    http.end();
+    servers->finished = true;
+    vTaskDelete(nullptr);
+}
+
+static void fillBenchReport(FullReportMsg& report, uint16_t index) {
+    memset(&report, 0, sizeof(report));
+    report.meshHeader.sourceId = 2 + index % 4;
+    report.meshHeader.messageId = index & 0xFF;
+    report.temperatureF_x10 = 700 + index % 50;
+    report.humidity_x10 = 450 + index % 100;
+    report.pressure_hPa = 1013;
+    report.altitude_m = 30;
+    report.latitude_x1e6 = 33783000 + index;
+    report.longitude_x1e6 = -118114000 - index;
+    report.satellites = 8;
+    report.battery_pct = 90;
+    report.uptime_sec = 600 + index;
+}
+
+static void benchThingSpeak(uint16_t reports, UplinkBenchResult& result) {
+    char url[48];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/update", UPLINK_BENCH_HTTP_PORT);
+
+    FullReportMsg report;
+    unsigned long start = millis();
+    for (uint16_t i = 0; i < reports && millis() - start < UPLINK_BENCH_TIMEOUT_MS; i++) {
+        fillBenchReport(report, i);
+        String response;
+        unsigned long t0 = millis();
+        int httpCode = thingSpeakUpdate(url, "BENCH", report.meshHeader.sourceId, report, -80, response);
+        unsigned long latencyMs = millis() - t0;
+
+        result.requests++;
+        if (httpCode == 200 && response.toInt() > 0) {
+            result.delivered++;
+            result.latencySumMs += latencyMs;
+            if (latencyMs > result.latencyMaxMs) result.latencyMaxMs = latencyMs;
+        }
+    }
+    result.elapsedMs = millis() - start;
+}
+
+static void benchMqtt(uint16_t reports, MqttUplink& client, UplinkBenchResult& result) {
+    client.begin("127.0.0.1", UPLINK_BENCH_MQTT_PORT, "mesh-bench", "bench/reports");
+
+    unsigned long connectStart = millis();
+    while (!client.isConnected() && millis() - connectStart < 3000) {
+        client.update();
+        delay(1);
+    }
+    if (!client.isConnected()) return;
+
+    // Reports arrive as fast as the queue takes them
+    FullReportMsg report;
+    uint16_t queued = 0;
+    unsigned long start = millis();
+    while (client.getStats().reportsAcked < reports && millis() - start < UPLINK_BENCH_TIMEOUT_MS) {
+        while (queued < reports) {
+            fillBenchReport(report, queued);
+            if (!client.enqueue(report.meshHeader.sourceId, report, -80)) break;
+            queued++;
+        }
+        client.update();
+        yield();
+    }
+    result.elapsedMs = millis() - start;
+
+    const MqttUplinkStats& stats = client.getStats();
+    result.delivered = stats.reportsAcked;
+    result.requests = stats.publishes;
+    result.latencySumMs = stats.latencySumMs;
+    result.latencyMaxMs = stats.latencyMaxMs;
+    client.stop();
+}
+
+void runUplinkBenchmark(uint16_t reports) {
+    if (reports == 0 || reports > UPLINK_BENCH_MAX_REPORTS) reports = UPLINK_BENCH_REPORTS;
+
+    if (!IS_GATEWAY) {
+        Serial.println(F("Uplink bench needs the gateway's WiFi stack"));
+        return;
+    }
+
+    UplinkBenchServers* servers = new (std::nothrow) UplinkBenchServers();
+    MqttUplink* client = new (std::nothrow) MqttUplink();
+    if (servers == nullptr || client == nullptr) {
+        Serial.println(F("Not enough heap for the uplink bench"));
+        delete servers;
+        delete client;
+        return;
+    }
+    servers->running = true;
+
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  UPLINK BENCHMARK                                             ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  Reports:          %u per backend, loopback stand-ins on core 0\n", reports);
+
+    if (xTaskCreatePinnedToCore(uplinkBenchServerTask, "uplinkBench", UPLINK_BENCH_STACK_SIZE,
+                                servers, 1, nullptr, 0) != pdPASS) {
+        Serial.println(F("  Could not start the stand-in task"));
+        delete servers;
+        delete client;
+        return;
+    }
+    unsigned long waitStart = millis();
+    while (!servers->ready && millis() - waitStart < 1000) delay(1);
+
+    UplinkBenchResult http = {};
+    UplinkBenchResult mqtt = {};
+    benchThingSpeak(reports, http);
+    benchMqtt(reports, *client, mqtt);
+
+    const MqttUplinkStats& stats = client->getStats();
+    Serial.println(F("                    ThingSpeak GET    MQTT QoS 1"));
+    Serial.printf("  Delivered:        %-17u %u\n", http.delivered, mqtt.delivered);
+    Serial.printf("  Requests:         %-17lu %lu publishes\n", http.requests, mqtt.requests);
+    Serial.printf("  Elapsed:          %-17lu %lu ms\n", http.elapsedMs, mqtt.elapsedMs);
+    Serial.printf("  Throughput:       %-17.1f %.1f reports/s\n",
+                  http.elapsedMs > 0 ? http.delivered * 1000.0f / http.elapsedMs : 0.0f,
+                  mqtt.elapsedMs > 0 ? mqtt.delivered * 1000.0f / mqtt.elapsedMs : 0.0f);
+    Serial.printf("  Latency avg:      %-17.1f %.1f ms per report\n",
+                  http.delivered > 0 ? (float)http.latencySumMs / http.delivered : 0.0f,
+                  mqtt.delivered > 0 ? (float)mqtt.latencySumMs / mqtt.delivered : 0.0f);
+    Serial.printf("  Latency max:      %-17lu %lu ms\n", http.latencyMaxMs, mqtt.latencyMaxMs);
+    Serial.printf("  MQTT bytes:       %lu (%.1f per report, %lu retransmits)\n", stats.bytesSent,
+                  mqtt.delivered > 0 ? (float)stats.bytesSent / mqtt.delivered : 0.0f, stats.retransmits);
+
+    servers->running = false;
+    waitStart = millis();
+    while (!servers->finished && millis() - waitStart < 1000) delay(10);
+
+    uint32_t records = servers->records.load();
+    Serial.printf("  Broker received:  %lu reports in %lu publishes (%lu DUP)  %s\n",
+                  (unsigned long)records, (unsigned long)servers->publishes.load(),
+                  (unsigned long)servers->duplicates.load(),
+                  (records == reports && mqtt.delivered == reports) ? "OK" : "FAIL");
+    Serial.println(F("  MQTT latency includes queueing: the burst fills the 32-report queue"));
+    Serial.println();
+
+    // A connect task that did not finish in time still holds the client
+    waitStart = millis();
+    while (client->isConnecting() && millis() - waitStart < 5000) delay(10);
+    if (!client->isConnecting()) delete client;
+    // A stand-in task that did not stop in time still holds the pointer
+    if (servers->finished) delete servers;
+}
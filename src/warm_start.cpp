@@ -0,0 +1,310 @@
+#include "warm_start.h"
+#include "network_time.h"
+#include "lora_comm.h"
+#include "neo6m.h"
+#include <Preferences.h>
+#include <esp_system.h>
+#include <sys/time.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         GLOBAL STATE                                      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+// Survives soft resets; validated by magic + CRC
+RTC_NOINIT_ATTR static WarmStartSnapshot rtcSnapshot;
+
+// Copy taken at boot (rtcSnapshot is overwritten by the first save)
+static WarmStartSnapshot bootSnapshot;
+
+static WarmStartStatus warmStatus;
+static uint16_t nvsSeqCeiling = 0xFFFF;   // 0xFFFF = nothing reserved yet
+static unsigned long lastSnapshotMs = 0;
+
+static const char* NVS_NAMESPACE = "warmstart";
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HELPERS                                           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static uint32_t crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t snapshotCrc(const WarmStartSnapshot& snapshot) {
+    return crc32((const uint8_t*)&snapshot, offsetof(WarmStartSnapshot, crc));
+}
+
+static int64_t systemClockUs() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+static void reserveSequence(uint8_t seq) {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) return;
+    nvsSeqCeiling = (uint8_t)(seq + WARM_START_SEQ_STRIDE);
+    prefs.putUShort("seq", nvsSeqCeiling);
+    prefs.end();
+}
+
+static const char* resetReasonString(uint8_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON:   return "Power-on";
+        case ESP_RST_EXT:       return "External";
+        case ESP_RST_SW:        return "Software";
+        case ESP_RST_PANIC:     return "Panic";
+        case ESP_RST_INT_WDT:   return "Interrupt WDT";
+        case ESP_RST_TASK_WDT:  return "Task WDT";
+        case ESP_RST_WDT:       return "Watchdog";
+        case ESP_RST_DEEPSLEEP: return "Deep sleep";
+        case ESP_RST_BROWNOUT:  return "Brownout";
+        default:                return "Unknown";
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         BOOT                                              ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void initWarmStart() {
+    memset(&warmStatus, 0, sizeof(warmStatus));
+    warmStatus.resetReason = (uint8_t)esp_reset_reason();
+
+    // Boot counter and messageId reservation live in NVS (survive power loss)
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, false)) {
+        warmStatus.bootCount = prefs.getUShort("boots", 0) + 1;
+        prefs.putUShort("boots", warmStatus.bootCount);
+        nvsSeqCeiling = prefs.getUShort("seq", 0xFFFF);
+        prefs.end();
+    }
+
+    // Validate the RTC snapshot left by the previous boot
+    memcpy(&bootSnapshot, &rtcSnapshot, sizeof(WarmStartSnapshot));
+    warmStatus.snapshotValid = bootSnapshot.magic == WARM_START_MAGIC &&
+                               bootSnapshot.version == WARM_START_VERSION &&
+                               bootSnapshot.deviceId == DEVICE_ID &&
+                               bootSnapshot.crc == snapshotCrc(bootSnapshot);
+
+    if (warmStatus.snapshotValid) {
+        warmStatus.previousFirstReportMs = bootSnapshot.firstReportMs;
+        warmStatus.previousWasWarm = bootSnapshot.firstReportWarm != 0;
+    }
+
+    // Invalidate so a crash before the first save can't replay it twice
+    rtcSnapshot.magic = 0;
+}
+
+void applyWarmStart() {
+    // ─────────────────────────────────────────────────────────────────────────
+    // messageId: exact from RTC, otherwise skip past the NVS reservation
+    // so the gateway's duplicate cache doesn't drop our first reports
+    // ─────────────────────────────────────────────────────────────────────────
+    if (warmStatus.snapshotValid) {
+        setMeshMessageSeq(bootSnapshot.meshMessageSeq);
+        warmStatus.seqFromRtc = true;
+    } else if (nvsSeqCeiling != 0xFFFF) {
+        setMeshMessageSeq((uint8_t)nvsSeqCeiling);
+        warmStatus.seqFromNvs = true;
+    }
+    reserveSequence(getMeshMessageSeq());
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // Time-sensitive state needs to know how long we were down
+    // ─────────────────────────────────────────────────────────────────────────
+    if (warmStatus.snapshotValid) {
+        int64_t nowUs = systemClockUs();
+        if (nowUs >= bootSnapshot.savedAtUs) {
+            warmStatus.elapsedKnown = true;
+            warmStatus.elapsedMs = (uint32_t)((nowUs - bootSnapshot.savedAtUs) / 1000);
+        }
+    }
+
+    if (warmStatus.snapshotValid && warmStatus.elapsedKnown) {
+        uint32_t elapsed = warmStatus.elapsedMs;
+
+        for (uint8_t i = 0; i < bootSnapshot.routeCount && i < ROUTE_TABLE_SIZE; i++) {
+            const WarmRoute& saved = bootSnapshot.routes[i];
+            RoutingState route;
+            route.distanceToGateway = saved.distanceToGateway;
+            route.nextHop = saved.nextHop;
+            route.gatewayId = saved.gatewayId;
+            route.bestRssi = saved.bestRssi;
+            route.lastBeaconSeq = saved.lastBeaconSeq;
+            route.lastBeaconTime = 0;
+            route.routeValid = true;
+            if (restoreGatewayRoute(route, saved.ageMs + elapsed)) {
+                warmStatus.routesRestored++;
+            }
+        }
+
+        for (uint8_t i = 0; i < bootSnapshot.neighborCount && i < MAX_NEIGHBORS; i++) {
+            const WarmNeighbor& saved = bootSnapshot.neighbors[i];
+            Neighbor neighbor;
+            neighbor.nodeId = saved.nodeId;
+            neighbor.rssi = saved.rssi;
+            neighbor.rssiMin = saved.rssiMin;
+            neighbor.rssiMax = saved.rssiMax;
+            neighbor.packetsReceived = saved.packetsReceived;
+            if (neighborTable.restore(neighbor, saved.ageMs + elapsed)) {
+                warmStatus.neighborsRestored++;
+            }
+        }
+
+        const WarmTime& savedTime = bootSnapshot.time;
+        if (savedTime.valid) {
+            warmStatus.timeRestored = restoreNetworkTime(savedTime.hour, savedTime.minute,
+                                                         savedTime.second, savedTime.sourceNodeId,
+                                                         savedTime.hopCount, savedTime.ageMs + elapsed);
+        }
+    }
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         PERIODIC SNAPSHOT                                 ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static void saveSnapshot() {
+    WarmStartSnapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+    unsigned long now = millis();
+
+    snapshot.magic = WARM_START_MAGIC;
+    snapshot.version = WARM_START_VERSION;
+    snapshot.deviceId = DEVICE_ID;
+    snapshot.bootCount = warmStatus.bootCount;
+    snapshot.meshMessageSeq = getMeshMessageSeq();
+
+    // Routes (nodes only - the gateway has nothing to restore)
+    for (uint8_t i = 0; i < ROUTE_TABLE_SIZE; i++) {
+        RoutingState route;
+        if (!getGatewayRoute(i, route) || !route.routeValid) continue;
+        WarmRoute& saved = snapshot.routes[snapshot.routeCount++];
+        saved.gatewayId = route.gatewayId;
+        saved.distanceToGateway = route.distanceToGateway;
+        saved.nextHop = route.nextHop;
+        saved.bestRssi = route.bestRssi;
+        saved.lastBeaconSeq = route.lastBeaconSeq;
+        saved.ageMs = now - route.lastBeaconTime;
+    }
+
+    // Neighbors
+    Neighbor* active[MAX_NEIGHBORS];
+    uint8_t activeCount = neighborTable.getActiveNeighbors(active, MAX_NEIGHBORS);
+    for (uint8_t i = 0; i < activeCount; i++) {
+        WarmNeighbor& saved = snapshot.neighbors[snapshot.neighborCount++];
+        saved.nodeId = active[i]->nodeId;
+        saved.rssi = active[i]->rssi;
+        saved.rssiMin = active[i]->rssiMin;
+        saved.rssiMax = active[i]->rssiMax;
+        saved.packetsReceived = active[i]->packetsReceived;
+        saved.ageMs = now - active[i]->lastHeardMs;
+    }
+
+    // Time reference: own GPS first, then network time
+    if (g_datetime_valid) {
+        snapshot.time.hour = g_hour;
+        snapshot.time.minute = g_minute;
+        snapshot.time.second = g_second;
+        snapshot.time.sourceNodeId = DEVICE_ID;
+        snapshot.time.hopCount = 0;
+        snapshot.time.ageMs = 0;
+        snapshot.time.valid = 1;
+    } else if (isNetworkTimeValid()) {
+        const NetworkTimeState& net = getNetworkTimeState();
+        snapshot.time.hour = net.hour;
+        snapshot.time.minute = net.minute;
+        snapshot.time.second = net.second;
+        snapshot.time.sourceNodeId = net.sourceNodeId;
+        snapshot.time.hopCount = net.hopCount;
+        snapshot.time.ageMs = now - net.receivedAtMillis + net.subSecondMs;
+        snapshot.time.valid = 1;
+    }
+
+    snapshot.firstReportMs = warmStatus.firstReportMs;
+    snapshot.firstReportWarm = (warmStatus.routesRestored > 0 || warmStatus.timeRestored) ? 1 : 0;
+    snapshot.savedAtUs = systemClockUs();
+    snapshot.crc = snapshotCrc(snapshot);
+
+    memcpy(&rtcSnapshot, &snapshot, sizeof(WarmStartSnapshot));
+}
+
+void warmStartUpdate() {
+    unsigned long now = millis();
+    if (lastSnapshotMs != 0 && now - lastSnapshotMs < WARM_START_SNAPSHOT_INTERVAL_MS) {
+        return;
+    }
+    lastSnapshotMs = now;
+
+    saveSnapshot();
+
+    // Extend the NVS messageId reservation before we run past it
+    uint8_t seq = getMeshMessageSeq();
+    if (nvsSeqCeiling == 0xFFFF || (int8_t)((uint8_t)nvsSeqCeiling - seq) < WARM_START_SEQ_REFRESH) {
+        reserveSequence(seq);
+    }
+}
+
+void warmStartOnReportSent() {
+    if (warmStatus.firstReportMs != 0) return;
+
+    warmStatus.firstReportMs = millis();
+    bool warm = warmStatus.routesRestored > 0 || warmStatus.timeRestored;
+
+    Serial.printf("[WARM] First report sent %lu ms after boot (%s start)\n",
+                  (unsigned long)warmStatus.firstReportMs, warm ? "warm" : "cold");
+
+    // Make the measurement survive the next reset
+    lastSnapshotMs = 0;
+    warmStartUpdate();
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         STATUS                                            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+const WarmStartStatus& getWarmStartStatus() {
+    return warmStatus;
+}
+
+void printWarmStartStatus() {
+    Serial.println();
+    Serial.println(F("╔═══════════════════════════════════════════════════════════════╗"));
+    Serial.println(F("║  WARM START                                                   ║"));
+    Serial.println(F("╚═══════════════════════════════════════════════════════════════╝"));
+    Serial.printf("  Boot count:       %u\n", warmStatus.bootCount);
+    Serial.printf("  Reset reason:     %s\n", resetReasonString(warmStatus.resetReason));
+    Serial.printf("  RTC snapshot:     %s\n", warmStatus.snapshotValid ? "valid" : "none");
+    if (warmStatus.snapshotValid) {
+        if (warmStatus.elapsedKnown) {
+            Serial.printf("  Downtime:         %lu ms\n", (unsigned long)warmStatus.elapsedMs);
+        } else {
+            Serial.println(F("  Downtime:         unknown"));
+        }
+    }
+    Serial.printf("  Restored:         %u routes, %u neighbors, time %s\n",
+                  warmStatus.routesRestored, warmStatus.neighborsRestored,
+                  warmStatus.timeRestored ? "yes" : "no");
+    Serial.printf("  messageId source: %s (NVS reserved up to %u)\n",
+                  warmStatus.seqFromRtc ? "RTC" : (warmStatus.seqFromNvs ? "NVS" : "fresh"),
+                  nvsSeqCeiling == 0xFFFF ? 0 : nvsSeqCeiling);
+    if (warmStatus.firstReportMs != 0) {
+        Serial.printf("  First report:     %lu ms after boot\n", (unsigned long)warmStatus.firstReportMs);
+    } else {
+        Serial.println(F("  First report:     not sent yet"));
+    }
+    if (warmStatus.previousFirstReportMs != 0) {
+        Serial.printf("  Previous boot:    %lu ms (%s start)\n",
+                      (unsigned long)warmStatus.previousFirstReportMs,
+                      warmStatus.previousWasWarm ? "warm" : "cold");
+    }
+    Serial.println();
+}
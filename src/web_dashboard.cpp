@@ -18,24 +18,30 @@
 #include "transmit_queue.h"
 #include "packet_handler.h"
 #include "network_time.h"  // For manual time setting
+#include "json_cache.h"
+#include "metrics.h"
+#include "channel_monitor.h"
 #include <WiFi.h>
 #include <WebServer.h>
 #include <DNSServer.h>
 #include <esp_wpa2.h>  // For WPA2-Enterprise (eduroam) support
+#include <atomic>
 
 // Web server on port 80
 static WebServer server(80);
 static DNSServer dnsServer;
-static bool dashboardRunning = false;
+static std::atomic<bool> dashboardRunning(false);  // Set on the boot task (core 0), read from loop()
 static unsigned long serverStartTime = 0;
 
 // Forward declarations
 void handleRoot();
 void handleData();
+void handleMetrics();
+void handleChannel();
 void handleSetTime();
 void handleNotFound();
 String generateHTML();
-String generateJSON();
+String generateJSON(uint32_t since);
 
 bool initWebDashboard() {
     if (!IS_GATEWAY) {
@@ -168,6 +174,8 @@ bool initWebDashboard() {
     // Setup web server routes
     server.on("/", handleRoot);
     server.on("/data", handleData);
+    server.on("/metrics", handleMetrics);
+    server.on("/channel", handleChannel);
     server.on("/settime", handleSetTime);
     server.on("/test", []() {
         server.send(200, "text/html", "<html><body><h1>Server Working!</h1><p>Free heap: " + String(ESP.getFreeHeap()) + " bytes</p></body></html>");
@@ -259,9 +267,32 @@ void handleRoot() {
     Serial.println(F("[HTTP] Dashboard sent successfully"));
 }
 
+// Prometheus text format for scrapers (same registry as 'mesh metrics')
+void handleMetrics() {
+    server.send(200, "text/plain; version=0.0.4", getMetricsPrometheus());
+}
+
+// Noise floor, per-second occupancy and slot roll-up ('mesh channel json')
+void handleChannel() {
+    server.send(200, "application/json", getChannelJson());
+}
+
 void handleData() {
     Serial.println(F("[HTTP] GET /data - Sending JSON"));
-    String json = generateJSON();
+    // ?since=<version> returns only the nodes changed after that version
+    uint32_t since = 0;
+    if (server.hasArg("since")) {
+        since = strtoul(server.arg("since").c_str(), nullptr, 10);
+    }
+    // A version from before a reboot (the counter restarts at 0) gets a full
+    // response; "since":0 in it tells the client to replace its node list
+    if (since > getJsonCacheVersion()) {
+        since = 0;
+    }
+
+    unsigned long start = micros();
+    String json = generateJSON(since);
+    jsonCacheNoteResponse(micros() - start);
     Serial.print(F("[HTTP] JSON size: "));
     Serial.print(json.length());
     Serial.println(F(" bytes"));
@@ -309,11 +340,11 @@ void handleNotFound() {
     server.send(404, "text/plain", "Not Found");
 }
 
-String generateJSON() {
+String generateJSON(uint32_t since) {
     String json;
     // Pre-allocate capacity to prevent multiple reallocations
-    // Estimate: ~200 bytes gateway + ~400 bytes per node × 5 nodes = ~2200 bytes
-    json.reserve(2500);
+    // Estimate: ~200 bytes gateway + ~400 bytes per live node
+    json.reserve(300 + (size_t)getNodeCount() * 400);
 
     json = "{";
 
@@ -340,65 +371,16 @@ String generateJSON() {
 
     json += "},";
     
-    // All nodes
+    // All nodes (cached per-node fragments, see json_cache)
     json += "\"nodes\":{";
-    bool first = true;
-    
-    for (uint8_t i = 1; i <= MESH_MAX_NODES; i++) {
-        NodeMessage* node = getNodeMessage(i);
-        if (node == nullptr) continue;
-        
-        if (!first) json += ",";
-        first = false;
-        
-        // Check if online (has data and heard within last 60 seconds)
-    
-        bool online;
-        if (i == DEVICE_ID) {
-            // Gateway is always online (it's running this code!)
-            online = true;
-        } else {
-            online = node->hasData && (millis() - node->lastHeardTime < 60000);
-        }
-
-        json += "\"" + String(i) + "\":{";
-        json += "\"online\":" + String(online ? "true" : "false") + ",";
-        json += "\"lastHeard\":" + String(node->lastHeardTime) + ",";
-        json += "\"messageCount\":" + String(node->messageCount) + ",";
-        json += "\"rssi\":" + String(node->lastRssi, 0) + ",";
-        json += "\"snr\":" + String(node->lastSnr, 1) + ",";
-        json += "\"packetsLost\":" + String(node->packetsLost) + ",";
-
-        // Mesh header info
-        json += "\"meshSourceId\":" + String(node->lastReport.meshHeader.sourceId) + ",";
-        json += "\"meshSenderId\":" + String(node->lastReport.meshHeader.senderId) + ",";
-        json += "\"meshTtl\":" + String(node->lastReport.meshHeader.ttl) + ",";
-        json += "\"meshMsgId\":" + String(node->lastReport.meshHeader.messageId) + ",";
-
-        // Calculate hop distance from TTL (how many hops packet traveled)
-        // Gateway (i==1) is always 0 hops, others calculated from TTL decrease
-        uint8_t hopDistance = (i == GATEWAY_NODE_ID) ? 0 : (MESH_DEFAULT_TTL - node->lastReport.meshHeader.ttl);
-        json += "\"hopDistance\":" + String(hopDistance) + ",";
-
-        // Sensor data from last report
-        json += "\"temp\":" + String(node->lastReport.temperatureF_x10 / 10.0, 1) + ",";
-        json += "\"humidity\":" + String(node->lastReport.humidity_x10 / 10.0, 1) + ",";
-        json += "\"pressure\":" + String(node->lastReport.pressure_hPa) + ",";
-        json += "\"altitude\":" + String(node->lastReport.altitude_m) + ",";
-
-        // GPS data
-        json += "\"lat\":" + String(node->lastReport.latitude_x1e6 / 1000000.0, 6) + ",";
-        json += "\"lng\":" + String(node->lastReport.longitude_x1e6 / 1000000.0, 6) + ",";
-        json += "\"satellites\":" + String(node->lastReport.satellites) + ",";
-        json += "\"gpsAlt\":" + String(node->lastReport.gps_altitude_m) + ",";
-
-        // Neighbor information
-        json += "\"neighborCount\":" + String(node->lastReport.neighborCount);
-
-        json += "}";
-    }
-    
-    json += "}}";
+    appendNodesJson(json, since);
+    json += "},";
+
+    // Clients pass this back as ?since= to receive only changed nodes
+    json += "\"version\":" + String(getJsonCacheVersion()) + ",";
+    json += "\"since\":" + String(since);
+
+    json += "}";
     return json;
 }
 
@@ -810,6 +792,38 @@ static const char DASHBOARD_HTML[] PROGMEM = R"rawliteral(
             font-size: 1rem;
             font-weight: 600;
         }
+        /* Channel tab styles */
+        .channel-strip {
+            display: grid;
+            grid-template-columns: repeat(60, 1fr);
+            gap: 1px;
+        }
+        .channel-cell {
+            height: 28px;
+            border-radius: 2px;
+            background: var(--bg-page);
+        }
+        .channel-label {
+            font-size: 0.75rem;
+            color: var(--text-secondary);
+            margin: 10px 0 4px;
+        }
+        .channel-table {
+            width: 100%;
+            border-collapse: collapse;
+            font-size: 0.875rem;
+        }
+        .channel-table th, .channel-table td {
+            text-align: left;
+            padding: 6px 8px;
+            border-bottom: 1px solid var(--border);
+        }
+        .channel-trend {
+            width: 100%;
+            height: 160px;
+            background: var(--bg-page);
+            border-radius: 6px;
+        }
         .chart-frame {
             width: 100%;
             height: 260px;
@@ -1022,6 +1036,7 @@ static const char DASHBOARD_HTML[] PROGMEM = R"rawliteral(
         <div class="tab" onclick="showTab('nodes')">Node Details</div>
         <div class="tab" onclick="showTab('heatmap')">Signal Heatmap</div>
         <div class="tab" onclick="showTab('history')">History</div>
+        <div class="tab" onclick="showTab('channel')">Channel</div>
     </div>
     
     <div id="mapContent" class="content active">
@@ -1111,6 +1126,32 @@ static const char DASHBOARD_HTML[] PROGMEM = R"rawliteral(
             </div>
         </div>
     </div>
+
+    <div id="channelContent" class="content">
+        <div class="history-container">
+            <div class="history-header">
+                <h2>📶 Channel Occupancy</h2>
+                <span class="toolbar-label" id="channelSummary">--</span>
+            </div>
+            <div class="chart-grid">
+                <div class="chart-card">
+                    <h3>Busy per second of the minute</h3>
+                    <div class="channel-strip" id="channelBusy"></div>
+                    <div class="channel-label">CAD activity (LoRa below the noise floor)</div>
+                    <div class="channel-strip" id="channelCad"></div>
+                    <div class="channel-label">0 s &rarr; 59 s &middot; grey &lt;1%, blue &lt;30%, amber &lt;60%, red 60%+</div>
+                </div>
+                <div class="chart-card">
+                    <h3>Per TDMA slot</h3>
+                    <table class="channel-table" id="channelSlots"></table>
+                </div>
+                <div class="chart-card">
+                    <h3>Noise floor (blue) and strongest sample (amber), last hour</h3>
+                    <svg class="channel-trend" id="channelTrend" viewBox="0 0 600 160" preserveAspectRatio="none"></svg>
+                </div>
+            </div>
+        </div>
+    </div>
     
     <script>
         // Detect online/offline mode
@@ -1219,6 +1260,10 @@ static const char DASHBOARD_HTML[] PROGMEM = R"rawliteral(
                 document.querySelector('.tabs .tab:nth-child(4)').classList.add('active');
                 document.getElementById('historyContent').classList.add('active');
                 updateHistoryCharts();
+            } else if (tabName === 'channel') {
+                document.querySelector('.tabs .tab:nth-child(5)').classList.add('active');
+                document.getElementById('channelContent').classList.add('active');
+                updateChannel();
             }
         }
 
@@ -1642,11 +1687,71 @@ static const char DASHBOARD_HTML[] PROGMEM = R"rawliteral(
                 updateMap(data.nodes, data.gateway);
                 updateNodeCards(data.nodes);
 
+                if (document.getElementById('channelContent').classList.contains('active')) {
+                    updateChannel();
+                }
+
             } catch (e) {
                 console.error('Update failed:', e);
             }
         }
         
+        // Channel occupancy (/channel): heatmap cell colour by percent
+        function occupancyColor(pct) {
+            if (pct < 1) return '#e2e8f0';
+            if (pct < 10) return '#bfdbfe';
+            if (pct < 30) return '#60a5fa';
+            if (pct < 60) return '#f59e0b';
+            return '#ef4444';
+        }
+
+        function trendLine(points, field, color) {
+            if (points.length < 2) return '';
+            const coords = points.map((p, i) => {
+                const x = i * 600 / (points.length - 1);
+                const y = Math.min(160, Math.max(0, (-40 - p[field]) * 160 / 90));  // -40..-130 dBm
+                return x.toFixed(1) + ',' + y.toFixed(1);
+            });
+            return '<polyline fill="none" stroke="' + color + '" stroke-width="2" points="' + coords.join(' ') + '"/>';
+        }
+
+        async function updateChannel() {
+            try {
+                const response = await fetch('/channel');
+                const ch = await response.json();
+
+                document.getElementById('channelSummary').textContent =
+                    'Noise floor ' + ch.noiseFloor + ' dBm · last minute ' + ch.busyPct + '% busy, ' +
+                    ch.cadPct + '% CAD' + (ch.synced ? '' : ' · waiting for time sync');
+
+                let busy = '';
+                let cad = '';
+                ch.seconds.forEach((s, i) => {
+                    busy += '<div class="channel-cell" style="background:' + occupancyColor(s[0]) +
+                            '" title="' + i + ' s: ' + s[0] + '% busy, mean ' + s[2] + ' dBm"></div>';
+                    cad += '<div class="channel-cell" style="background:' + occupancyColor(s[1]) +
+                           '" title="' + i + ' s: ' + s[1] + '% CAD"></div>';
+                });
+                document.getElementById('channelBusy').innerHTML = busy;
+                document.getElementById('channelCad').innerHTML = cad;
+
+                let rows = '<tr><th>Slot</th><th>Seconds</th><th>Busy</th><th>CAD</th><th>Mean</th></tr>';
+                for (const s of ch.slots) {
+                    rows += '<tr><td>' + (s.band ? 'Band ' + s.band + ' · ' : '') + 'Node ' + s.node + '</td>' +
+                            '<td>' + s.from + '-' + s.to + '</td>' +
+                            '<td>' + s.busy.toFixed(1) + '%</td>' +
+                            '<td>' + s.cad.toFixed(1) + '%</td>' +
+                            '<td>' + s.meanDbm.toFixed(1) + ' dBm</td></tr>';
+                }
+                document.getElementById('channelSlots').innerHTML = rows;
+
+                document.getElementById('channelTrend').innerHTML =
+                    trendLine(ch.trend, 1, '#2563eb') + trendLine(ch.trend, 2, '#f59e0b');
+            } catch (e) {
+                console.error('Channel update failed:', e);
+            }
+        }
+
         // Note: Initialization is done in the async IIFE above after online check completes
 
         // Manual time setting functions
@@ -14,19 +14,23 @@
 #include "node_store.h"
 #include "mesh_stats.h"
 #include "transmit_queue.h"
+#include "metrics.h"
+#include "channel_monitor.h"
 #include <WiFi.h>
 #include <WebServer.h>
 #include <DNSServer.h>
+#include <atomic>
 
 // Web server on port 80
 static WebServer serverLite(80);
 static DNSServer dnsServerLite;
-static bool dashboardLiteRunning = false;
+static std::atomic<bool> dashboardLiteRunning(false);  // Set on the boot task (core 0), read from loop()
 static unsigned long serverLiteStartTime = 0;
 
 // Forward declarations
 void handleRootLite();
 void handleDataLite();
+void handleMetricsLite();
 String generateHTMLLite();
 String generateJSONLite();
 
@@ -58,6 +62,10 @@ bool initWebDashboardLite() {
     // Setup web server routes
     serverLite.on("/", handleRootLite);
     serverLite.on("/data", handleDataLite);
+    serverLite.on("/metrics", handleMetricsLite);
+    serverLite.on("/channel", []() {
+        serverLite.send(200, "application/json", getChannelJson());
+    });
     serverLite.on("/test", []() {
         serverLite.send(200, "text/plain", "Lite Server OK! Free heap: " + String(ESP.getFreeHeap()));
     });
@@ -131,6 +139,10 @@ void handleDataLite() {
     serverLite.send(200, "application/json", json);
 }
 
+void handleMetricsLite() {
+    serverLite.send(200, "text/plain; version=0.0.4", getMetricsPrometheus());
+}
+
 String generateJSONLite() {
     String json = "{\"gateway\":{";
     json += "\"uptime\":" + String((millis() - serverLiteStartTime) / 1000) + ",";
@@ -138,9 +150,11 @@ String generateJSONLite() {
     json += "},\"nodes\":[";
 
     bool first = true;
-    for (uint8_t i = 1; i <= MESH_MAX_NODES; i++) {
-        NodeMessage* node = getNodeMessage(i);
-        if (node == nullptr) continue;
+    uint16_t cursor = 0;
+    NodeSnapshot snapshot;
+    while (nextLiveNode(cursor, snapshot)) {
+        uint8_t i = snapshot.nodeId;
+        const NodeSnapshot* node = &snapshot;
 
         bool online = (i == DEVICE_ID) || (node->hasData && (millis() - node->lastHeardTime < 60000));
 
@@ -0,0 +1,203 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FEC HOST BENCHMARK                                ║
+// ║  Same codec as the firmware (src/fec.cpp), timed and checked on the PC    ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   fec_bench [--frame-bytes 200] [--groups 2000] [--trials 10000] [--frames 16]
+//
+// 1. Encode/decode throughput per group size, decoding with k data frames
+//    lost (the most work the decoder ever does).
+// 2. Random erasure patterns: every pattern with at most k losses must
+//    decode to the original data, every pattern with more must refuse.
+// 3. Completion time of one transfer over a lossy link, plain ARQ vs FEC
+//    sized by the planner, in TDMA cycles. 'mesh bench fec' prints the
+//    same tables on the ESP32.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "fec.h"
+
+struct BenchOptions {
+    unsigned frameBytes;
+    unsigned groups;
+    unsigned trials;
+    unsigned frames;
+};
+
+static const unsigned GROUP_SIZES[][2] = { { 4, 1 }, { 8, 2 }, { 16, 4 }, { 32, 8 } };
+static const float LOSS_POINTS[] = { 0.01f, 0.05f, 0.10f, 0.20f, 0.30f };
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// THROUGHPUT
+// ═══════════════════════════════════════════════════════════════════════════
+
+static bool benchGroup(unsigned n, unsigned k, const BenchOptions& opts) {
+    std::vector<std::vector<uint8_t>> store(n + k, std::vector<uint8_t>(opts.frameBytes));
+    std::vector<std::vector<uint8_t>> original(n, std::vector<uint8_t>(opts.frameBytes));
+    std::vector<uint8_t*> frames(n + k);
+    bool received[FEC_MAX_DATA_FRAMES + FEC_MAX_REPAIR_FRAMES];
+
+    for (unsigned f = 0; f < n + k; f++) frames[f] = store[f].data();
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned b = 0; b < opts.frameBytes; b++) store[i][b] = (uint8_t)rand();
+        original[i] = store[i];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned g = 0; g < opts.groups; g++) {
+        fecEncode(frames.data(), n, frames.data() + n, k, opts.frameBytes);
+    }
+    double encodeSec = secondsSince(start);
+
+    bool ok = true;
+    double decodeSec = 0;
+    for (unsigned g = 0; g < opts.groups; g++) {
+        for (unsigned f = 0; f < n + k; f++) received[f] = (f >= k);
+        for (unsigned i = 0; i < k; i++) memset(frames[i], 0, opts.frameBytes);
+        start = std::chrono::steady_clock::now();
+        ok &= fecDecode(frames.data(), received, n, k, opts.frameBytes);
+        decodeSec += secondsSince(start);
+    }
+    for (unsigned i = 0; i < n; i++) {
+        if (store[i] != original[i]) ok = false;
+    }
+
+    double dataMb = (double)n * opts.frameBytes * opts.groups / 1e6;
+    printf("  %2u+%-2u  %9.2f us %8.1f MB/s  %9.2f us %8.1f MB/s  %s\n",
+           n, k,
+           encodeSec * 1e6 / opts.groups, dataMb / encodeSec,
+           decodeSec * 1e6 / opts.groups, dataMb / decodeSec,
+           ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RANDOM ERASURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+static bool checkErasures(unsigned n, unsigned k, unsigned patterns, unsigned len) {
+    std::vector<std::vector<uint8_t>> original(n, std::vector<uint8_t>(len));
+    std::vector<std::vector<uint8_t>> store(n + k, std::vector<uint8_t>(len));
+    std::vector<uint8_t*> frames(n + k);
+    bool received[FEC_MAX_DATA_FRAMES + FEC_MAX_REPAIR_FRAMES];
+
+    for (unsigned f = 0; f < n + k; f++) frames[f] = store[f].data();
+    unsigned failures = 0;
+
+    for (unsigned p = 0; p < patterns; p++) {
+        for (unsigned i = 0; i < n; i++) {
+            for (unsigned b = 0; b < len; b++) original[i][b] = (uint8_t)rand();
+            store[i] = original[i];
+        }
+        fecEncode(frames.data(), n, frames.data() + n, k, len);
+
+        unsigned lost = 0;
+        unsigned dropTarget = (unsigned)rand() % (k + 2);       // Sometimes one too many
+        for (unsigned f = 0; f < n + k; f++) received[f] = true;
+        while (lost < dropTarget) {
+            unsigned f = (unsigned)rand() % (n + k);
+            if (!received[f]) continue;
+            received[f] = false;
+            if (f < n) memset(frames[f], 0xA5, len);
+            lost++;
+        }
+
+        bool decoded = fecDecode(frames.data(), received, n, k, len);
+        if (decoded != (lost <= k)) {
+            failures++;
+            continue;
+        }
+        for (unsigned i = 0; decoded && i < n; i++) {
+            if (store[i] != original[i]) {
+                failures++;
+                break;
+            }
+        }
+    }
+
+    printf("  %2u+%-2u  %u patterns  %s\n", n, k, patterns,
+           failures ? "FAILED" : "ok");
+    return failures == 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [--frame-bytes N] [--groups N] [--trials N] [--frames N]\n", program);
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    opts.frameBytes = 200;
+    opts.groups = 2000;
+    opts.trials = 10000;
+    opts.frames = 16;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--frame-bytes" && hasValue) {
+            opts.frameBytes = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--groups" && hasValue) {
+            opts.groups = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--trials" && hasValue) {
+            opts.trials = (unsigned)atoi(argv[++i]);
+        } else if (arg == "--frames" && hasValue) {
+            opts.frames = (unsigned)atoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return (arg == "-h" || arg == "--help") ? 0 : 1;
+        }
+    }
+    if (opts.frameBytes == 0 || opts.groups == 0 || opts.trials == 0 ||
+        opts.trials > 65535 || opts.frames == 0 || opts.frames > FEC_MAX_DATA_FRAMES) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    srand(490);
+    fecInit();
+    bool ok = true;
+
+    printf("Throughput: %u-byte frames, %u groups per point, decode with k data frames lost\n",
+           opts.frameBytes, opts.groups);
+    printf("  n+k     encode/group    rate          decode/group    rate\n");
+    for (const auto& size : GROUP_SIZES) {
+        ok &= benchGroup(size[0], size[1], opts);
+    }
+
+    printf("\nRandom erasures (up to k + 1 frames lost)\n");
+    for (const auto& size : GROUP_SIZES) {
+        ok &= checkErasures(size[0], size[1], 2000, 32);
+    }
+
+    printf("\nCompletion time, %u-frame transfer, %u trials (1 round = 1 TDMA cycle)\n",
+           opts.frames, opts.trials);
+    printf("  loss   k   ARQ mean  p95  frames   FEC mean  p95  frames   gain\n");
+    for (unsigned p = 0; p < sizeof(LOSS_POINTS) / sizeof(LOSS_POINTS[0]); p++) {
+        float loss = LOSS_POINTS[p];
+        uint8_t k = fecRepairFrames((uint8_t)opts.frames, loss);
+        FecSimResult arq, fec;
+        fecSimulateTransfer((uint8_t)opts.frames, 0, loss, (uint16_t)opts.trials, 490 + p, arq);
+        fecSimulateTransfer((uint8_t)opts.frames, k, loss, (uint16_t)opts.trials, 490 + p, fec);
+        printf("  %3.0f%%  %2u   %8.2f  %3u  %6.2f   %8.2f  %3u  %6.2f  %5.1f s\n",
+               loss * 100.0f, k,
+               arq.meanRounds, arq.p95Rounds, arq.framesPerData,
+               fec.meanRounds, fec.p95Rounds, fec.framesPerData,
+               (arq.meanRounds - fec.meanRounds) * 60.0f);
+    }
+
+    return ok ? 0 : 1;
+}
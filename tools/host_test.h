@@ -0,0 +1,39 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HOST TEST CHECKS                                  ║
+// ║  Shared by the PC test programs under tools/ (see host_test.mk)           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   CHECK(value == expected, "value %d, expected %d", value, expected);
+//   ...
+//   return checkSummary();
+//
+// A failed CHECK prints its file, line and message and the program goes on,
+// so one run lists every failure. Call it from one thread only.
+
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                        \
+    do {                                                        \
+        if (!(cond)) {                                          \
+            failures++;                                         \
+            printf("  FAIL %s:%d: ", __FILE__, __LINE__);       \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+        }                                                       \
+    } while (0)
+
+/**
+ * Print PASSED/FAILED with the failure count
+ * @return exit code for main(): 0 if every CHECK held
+ */
+static inline int checkSummary() {
+    printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "PASSED", failures, failures == 1 ? "" : "s");
+    return failures ? 1 : 0;
+}
+
+#endif // HOST_TEST_H
@@ -0,0 +1,47 @@
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         HOST TEST BUILD RULES                             ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+#
+# Shared by the tools that build firmware sources on the PC. A tool's
+# Makefile sets these, then includes this file:
+#
+#   TOOL           Binary name, built from $(TOOL).cpp
+#   FIRMWARE       Modules compiled from ../../src (names without .cpp)
+#   INCLUDES       Extra -I flags ahead of ../../include (e.g. an Arduino shim)
+#   TOOL_CXXFLAGS  Extra compile flags
+#   LDLIBS         Extra link libraries
+#   TEST_ARGS      Arguments 'make test' passes to the binary
+#
+# Targets: all (default), test, clean. Test sources include "host_test.h"
+# (this directory) for CHECK() and checkSummary().
+
+CXX      ?= g++
+CXXFLAGS ?= -O2 -g
+CXXFLAGS += -std=c++17 -Wall -Wextra -I.. $(INCLUDES) -I../../include $(TOOL_CXXFLAGS)
+
+BUILD    := build
+OBJECTS  := $(FIRMWARE:%=$(BUILD)/%.o) $(BUILD)/$(TOOL).o
+
+all: $(TOOL)
+
+$(TOOL): $(OBJECTS)
+	$(CXX) $(LDFLAGS) -o $@ $^ $(LDLIBS)
+
+$(BUILD)/%.o: ../../src/%.cpp | $(BUILD)
+	$(CXX) $(CXXFLAGS) -MMD -MP -c -o $@ $<
+
+$(BUILD)/%.o: %.cpp | $(BUILD)
+	$(CXX) $(CXXFLAGS) -MMD -MP -c -o $@ $<
+
+$(BUILD):
+	mkdir -p $(BUILD)
+
+test: $(TOOL)
+	./$(TOOL) $(TEST_ARGS)
+
+clean:
+	rm -rf $(BUILD) $(TOOL)
+
+.PHONY: all test clean
+
+-include $(wildcard $(BUILD)/*.d)
@@ -0,0 +1,533 @@
+#!/usr/bin/env python3
+"""
+LoRa Mesh Autotuner
+===================
+Searches the firmware's mesh timing constants on a simulated site
+(mesh_sim.py) and reports the best delivery / latency / airtime trade-offs.
+
+Output:
+- Ranked configurations (score, metrics, Pareto-optimal marker)
+- Deployable profile for the best one (build_flags + config.cpp lines)
+- Sensitivity of the score to each parameter around the best configuration
+- Optional JSON with everything (--out)
+
+Usage:
+    python autotune.py sites/campus.json
+    python autotune.py sites/hillside.json --search grid --params TX_QUEUE_SIZE,MAX_FORWARDS_PER_SLOT
+    python autotune.py sites/hillside.json --search bayes --budget 120 --jobs 8 --out results
+
+Score (higher is better):
+    100 * delivery - latency-weight * p95 latency (s) - airtime-weight * channel airtime (%)
+"""
+
+import argparse
+import itertools
+import json
+import math
+import random
+import sys
+import time
+from multiprocessing import Pool
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+import mesh_sim
+from firmware_node import stale_model_sources
+from mesh_sim import PARAMETERS, Parameter
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         CONFIGURATION                                     ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+DEFAULT_LATENCY_WEIGHT = 0.5    # Score points per second of p95 latency
+DEFAULT_AIRTIME_WEIGHT = 5.0    # Score points per percent of channel airtime
+BAYES_INITIAL_POINTS = 12       # Random configurations before the model takes over
+BAYES_CANDIDATES = 600          # Random candidates scored by expected improvement per step
+GP_LENGTH_SCALE = 0.35          # RBF kernel, on parameters scaled to 0..1
+GP_NOISE = 0.05                 # Relative to the score variance (seed noise)
+
+# Per-worker state (set once by the pool initializer)
+_worker_site = None
+_worker_defaults = None
+_worker_seeds: List[int] = []
+_worker_hours = 1.0
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         CONFIGURATION SPACE                               ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+def inactive_parameters(config: Dict[str, object]) -> Dict[str, str]:
+    """
+    Parameters that cannot change the result under this configuration,
+    with the reason. They are pinned to the firmware default so equivalent
+    configurations are only simulated once.
+    """
+    reasons = {'NEIGHBOR_TIMEOUT_MS': 'only feeds neighborCount and warm start, no forwarding decision'}
+    if config['USE_BEACON_SUBFRAME']:
+        # The gateway has GPS time in every site, so it beacons at second 0
+        for name in ('BEACON_INTERVAL_MS', 'BEACON_REBROADCAST_MIN_MS', 'BEACON_REBROADCAST_MAX_MS'):
+            reasons[name] = 'beacon sub-frame uses fixed micro-slots'
+    if config['USE_DEPTH_ORDERED_SLOTS']:
+        reasons['TDMA_TX_OFFSET_SEC'] = 'ID-ordered layout only'
+        if config['USE_BEACON_SUBFRAME']:
+            reasons['TDMA_SUBSLOT_TX_OFFSET_SEC'] = 'sub-frame layout transmits at sub-slot start'
+    else:
+        reasons['TDMA_SUBSLOT_TX_OFFSET_SEC'] = 'depth-ordered layout only'
+    return reasons
+
+
+def canonical(config: Dict[str, object], defaults: Dict[str, object]) -> Dict[str, object]:
+    result = dict(config)
+    for name in inactive_parameters(config):
+        result[name] = defaults[name]
+    return result
+
+
+def valid(config: Dict[str, object]) -> bool:
+    return config['BEACON_REBROADCAST_MIN_MS'] < config['BEACON_REBROADCAST_MAX_MS']
+
+
+def config_key(config: Dict[str, object]) -> Tuple:
+    return tuple(config[p.name] for p in PARAMETERS)
+
+
+def encode(config: Dict[str, object], searched: List[Parameter]) -> List[float]:
+    """Position of each searched value in its candidate list, scaled to 0..1"""
+    vector = []
+    for p in searched:
+        value = config[p.name]
+        index = p.values.index(value) if value in p.values else 0
+        vector.append(index / (len(p.values) - 1) if len(p.values) > 1 else 0.0)
+    return vector
+
+
+def random_config(base: Dict[str, object], searched: List[Parameter], rng: random.Random) -> Dict[str, object]:
+    config = dict(base)
+    for p in searched:
+        config[p.name] = rng.choice(p.values)
+    return config
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         EVALUATION                                        ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+def _init_worker(site, defaults, seeds, hours):
+    global _worker_site, _worker_defaults, _worker_seeds, _worker_hours
+    _worker_site, _worker_defaults, _worker_seeds, _worker_hours = site, defaults, seeds, hours
+
+
+def _evaluate_worker(config: Dict[str, object]) -> Dict[str, float]:
+    params = dict(_worker_defaults)
+    params.update(config)
+    return mesh_sim.evaluate(_worker_site, params, _worker_seeds, _worker_hours)
+
+
+def score(metrics: Dict[str, float], args) -> float:
+    return (100.0 * metrics['delivery'] - args.latency_weight * metrics['latencyP95Sec'] -
+            args.airtime_weight * metrics['airtimePct'])
+
+
+class Evaluator:
+    """Runs configurations in parallel, each distinct (canonical) one once"""
+
+    def __init__(self, site, defaults, args):
+        self.site = site
+        self.defaults = defaults
+        self.args = args
+        self.cache: Dict[Tuple, Dict] = {}
+        seeds = list(range(1, args.seeds + 1))
+        self.pool = Pool(args.jobs, _init_worker, (site, defaults, seeds, args.hours)) if args.jobs > 1 else None
+        if self.pool is None:
+            _init_worker(site, defaults, seeds, args.hours)
+
+    def run(self, configs: List[Dict[str, object]]) -> List[Dict]:
+        pending = []
+        for config in configs:
+            config = canonical(config, self.defaults)
+            key = config_key(config)
+            if key not in self.cache and key not in (config_key(c) for c in pending):
+                pending.append(config)
+
+        if pending:
+            mapper = self.pool.map if self.pool else map
+            for config, metrics in zip(pending, mapper(_evaluate_worker, pending)):
+                self.cache[config_key(config)] = {
+                    'params': {p.name: config[p.name] for p in PARAMETERS},
+                    'metrics': metrics,
+                    'score': score(metrics, self.args),
+                }
+        return [self.cache[config_key(canonical(c, self.defaults))] for c in configs]
+
+    def results(self) -> List[Dict]:
+        return sorted(self.cache.values(), key=lambda r: r['score'], reverse=True)
+
+    def close(self):
+        if self.pool:
+            self.pool.close()
+            self.pool.join()
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         SEARCH STRATEGIES                                 ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+def grid_search(evaluator: Evaluator, base: Dict[str, object], searched: List[Parameter],
+                budget: int, rng: random.Random):
+    """
+    Every combination of the searched values; when that exceeds the budget,
+    an evenly drawn sample of the grid (use --params to keep it exhaustive)
+    """
+    grid = []
+    seen = set()
+    for combo in itertools.product(*(p.values for p in searched)):
+        config = dict(base)
+        config.update({p.name: v for p, v in zip(searched, combo)})
+        config = canonical(config, evaluator.defaults)
+        key = config_key(config)
+        if valid(config) and key not in seen:
+            seen.add(key)
+            grid.append(config)
+
+    if len(grid) > budget:
+        print(f"  Grid has {len(grid)} distinct points, sampling {budget}")
+        grid = rng.sample(grid, budget)
+    else:
+        print(f"  Grid has {len(grid)} distinct points")
+
+    batch = max(evaluator.args.jobs * 4, 8)
+    for start in range(0, len(grid), batch):
+        evaluator.run(grid[start:start + batch])
+        _progress(evaluator, start + batch, len(grid))
+
+
+def _cholesky(matrix: List[List[float]]) -> List[List[float]]:
+    n = len(matrix)
+    lower = [[0.0] * n for _ in range(n)]
+    for i in range(n):
+        for j in range(i + 1):
+            total = matrix[i][j] - sum(lower[i][k] * lower[j][k] for k in range(j))
+            if i == j:
+                lower[i][j] = math.sqrt(max(total, 1e-12))
+            else:
+                lower[i][j] = total / lower[j][j]
+    return lower
+
+
+def _solve_lower(lower: List[List[float]], b: List[float]) -> List[float]:
+    x = []
+    for i, row in enumerate(lower):
+        x.append((b[i] - sum(row[k] * x[k] for k in range(i))) / row[i])
+    return x
+
+
+def _solve_upper(lower: List[List[float]], b: List[float]) -> List[float]:
+    n = len(lower)
+    x = [0.0] * n
+    for i in reversed(range(n)):
+        x[i] = (b[i] - sum(lower[k][i] * x[k] for k in range(i + 1, n))) / lower[i][i]
+    return x
+
+
+def _kernel(a: List[float], b: List[float]) -> float:
+    distance = sum((x - y) ** 2 for x, y in zip(a, b))
+    return math.exp(-0.5 * distance / (GP_LENGTH_SCALE ** 2))
+
+
+def _expected_improvement(mean: float, std: float, best: float) -> float:
+    if std <= 1e-9:
+        return 0.0
+    z = (mean - best) / std
+    cdf = 0.5 * (1.0 + math.erf(z / math.sqrt(2.0)))
+    pdf = math.exp(-0.5 * z * z) / math.sqrt(2.0 * math.pi)
+    return (mean - best) * cdf + std * pdf
+
+
+def bayes_search(evaluator: Evaluator, base: Dict[str, object], searched: List[Parameter],
+                 budget: int, rng: random.Random):
+    """
+    Gaussian-process model of the score over the searched parameters
+    (RBF kernel on value positions), next points by expected improvement.
+    Each step proposes one point per worker.
+    """
+    def draw_valid():
+        while True:
+            config = canonical(random_config(base, searched, rng), evaluator.defaults)
+            if valid(config):
+                return config
+
+    evaluator.run([base] + [draw_valid() for _ in range(BAYES_INITIAL_POINTS - 1)])
+    _progress(evaluator, len(evaluator.cache), budget)
+
+    while len(evaluator.cache) < budget:
+        results = list(evaluator.cache.values())
+        xs = [encode(r['params'], searched) for r in results]
+        ys = [r['score'] for r in results]
+        mean_y = sum(ys) / len(ys)
+        scale = math.sqrt(sum((y - mean_y) ** 2 for y in ys) / len(ys)) or 1.0
+        ys_norm = [(y - mean_y) / scale for y in ys]
+
+        n = len(xs)
+        k = [[_kernel(xs[i], xs[j]) + (GP_NOISE if i == j else 0.0) for j in range(n)] for i in range(n)]
+        lower = _cholesky(k)
+        alpha = _solve_upper(lower, _solve_lower(lower, ys_norm))
+        best = max(ys_norm)
+
+        known = {config_key(canonical(r['params'], evaluator.defaults)) for r in results}
+        candidates = []
+        for _ in range(BAYES_CANDIDATES):
+            config = draw_valid()
+            key = config_key(config)
+            if key in known:
+                continue
+            known.add(key)
+            x = encode(config, searched)
+            k_star = [_kernel(x, xi) for xi in xs]
+            mean = sum(a * b for a, b in zip(k_star, alpha))
+            v = _solve_lower(lower, k_star)
+            std = math.sqrt(max(1.0 - sum(t * t for t in v), 0.0))
+            candidates.append((_expected_improvement(mean, std, best), config))
+
+        if not candidates:
+            break   # Space exhausted
+        candidates.sort(key=lambda c: c[0], reverse=True)
+        batch = min(max(evaluator.args.jobs, 1), budget - len(evaluator.cache))
+        evaluator.run([config for _, config in candidates[:batch]])
+        _progress(evaluator, len(evaluator.cache), budget)
+
+
+def _progress(evaluator: Evaluator, done: int, total: int):
+    best = evaluator.results()[0]
+    print(f"\r  {min(done, total):4d}/{total}  best score {best['score']:7.2f}", end='', flush=True)
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         REPORTS                                           ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+def pareto_front(results: List[Dict]) -> set:
+    """Configurations no other beats on delivery, p95 latency and airtime at once"""
+    front = set()
+    for i, a in enumerate(results):
+        ma = a['metrics']
+        dominated = False
+        for b in results:
+            mb = b['metrics']
+            if b is a:
+                continue
+            if (mb['delivery'] >= ma['delivery'] and mb['latencyP95Sec'] <= ma['latencyP95Sec'] and
+                    mb['airtimePct'] <= ma['airtimePct'] and
+                    (mb['delivery'] > ma['delivery'] or mb['latencyP95Sec'] < ma['latencyP95Sec'] or
+                     mb['airtimePct'] < ma['airtimePct'])):
+                dominated = True
+                break
+        if not dominated:
+            front.add(i)
+    return front
+
+
+def changed(params: Dict[str, object], defaults: Dict[str, object]) -> Dict[str, object]:
+    return {name: value for name, value in params.items() if value != defaults[name]}
+
+
+def print_ranking(results: List[Dict], defaults: Dict[str, object], baseline: Dict, top: int):
+    front = pareto_front(results)
+    print()
+    print("╔═══════════════════════════════════════════════════════════════════════════╗")
+    print("║  RANKED CONFIGURATIONS                       (P = Pareto-optimal)         ║")
+    print("╚═══════════════════════════════════════════════════════════════════════════╝")
+    print(f"  {'#':>3}   {'Score':>7} {'Deliv':>7} {'p95 s':>7} {'Air %':>6}  Changes from firmware defaults")
+    rows = [(None, baseline)] + list(enumerate(results[:top], 1))
+    for rank, result in rows:
+        m = result['metrics']
+        marker = 'P' if results.index(result) in front else ' '
+        diff = changed(result['params'], defaults)
+        label = 'now' if rank is None else str(rank)
+        text = ', '.join(f"{k}={_format(v)}" for k, v in diff.items()) or '(firmware defaults)'
+        print(f"  {label:>3} {marker} {result['score']:7.2f} {100 * m['delivery']:6.1f}% "
+              f"{m['latencyP95Sec']:7.1f} {m['airtimePct']:6.2f}  {text}")
+
+
+def print_profile(site_name: str, best: Dict, defaults: Dict[str, object]):
+    """Where each changed value goes in the firmware"""
+    diff = changed(best['params'], defaults)
+    print()
+    print(f"─── Deploy profile: {site_name} ───")
+    if not diff:
+        print("  Firmware defaults are already the best configuration found.")
+        return
+    flags = [p for p in PARAMETERS if p.name in diff and p.deploy == 'flag']
+    consts = [p for p in PARAMETERS if p.name in diff and p.deploy == 'config']
+    if flags:
+        print("  platformio.ini, in the site's env:")
+        print("    build_flags =")
+        print("    \t${env.build_flags}")
+        for p in flags:
+            print(f"    \t-D {p.name}={_format(diff[p.name])}")
+    if consts:
+        print("  src/config.cpp:")
+        for p in consts:
+            kind = 'bool' if isinstance(diff[p.name], bool) else 'unsigned long'
+            print(f"    const {kind} {p.name} = {_format(diff[p.name])};")
+
+
+def sensitivity(evaluator: Evaluator, best: Dict) -> List[Dict]:
+    """
+    One parameter at a time across its candidate values, the rest held at
+    the best configuration. Spread = best minus worst score along the sweep.
+    """
+    base = best['params']
+    reasons = inactive_parameters(base)
+    configs = []
+    for p in PARAMETERS:
+        if p.name in reasons:
+            continue
+        for value in p.values:
+            config = dict(base)
+            config[p.name] = value
+            if valid(config):
+                configs.append(config)
+    evaluator.run(configs)
+
+    rows = []
+    for p in PARAMETERS:
+        if p.name in reasons:
+            rows.append({'name': p.name, 'inactive': reasons[p.name]})
+            continue
+        sweep = []
+        for value in p.values:
+            config = dict(base)
+            config[p.name] = value
+            if valid(config):
+                sweep.append((value, evaluator.run([config])[0]))
+        scores = [r['score'] for _, r in sweep]
+        rows.append({
+            'name': p.name,
+            'spread': max(scores) - min(scores),
+            'sweep': [{'value': v, 'score': r['score'], 'delivery': r['metrics']['delivery'],
+                       'latencyP95Sec': r['metrics']['latencyP95Sec'],
+                       'airtimePct': r['metrics']['airtimePct']} for v, r in sweep],
+        })
+    rows.sort(key=lambda r: r.get('spread', -1.0), reverse=True)
+    return rows
+
+
+def print_sensitivity(rows: List[Dict], best: Dict, noise: float):
+    print()
+    print("╔═══════════════════════════════════════════════════════════════════════════╗")
+    print("║  SENSITIVITY AROUND THE BEST CONFIGURATION                                ║")
+    print("╚═══════════════════════════════════════════════════════════════════════════╝")
+    print(f"  Seed noise on the score is about ±{noise:.2f}; smaller spreads are not significant.")
+    for row in rows:
+        if 'inactive' in row:
+            continue
+        print(f"  {row['name']:28} spread {row['spread']:6.2f}"
+              f"{'   (not significant)' if row['spread'] < 2 * noise else ''}")
+        current = best['params'][row['name']]
+        for point in row['sweep']:
+            marker = '◀' if point['value'] == current else ' '
+            print(f"      {_format(point['value']):>8} {marker} score {point['score']:7.2f}  "
+                  f"deliv {100 * point['delivery']:5.1f}%  p95 {point['latencyP95Sec']:6.1f}s  "
+                  f"air {point['airtimePct']:5.2f}%")
+    for row in rows:
+        if 'inactive' in row:
+            print(f"  {row['name']:28} no effect: {row['inactive']}")
+
+
+def _format(value) -> str:
+    if isinstance(value, bool):
+        return 'true' if value else 'false'
+    return str(value)
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         MAIN                                              ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+def main():
+    parser = argparse.ArgumentParser(description='Search mesh timing constants on a simulated site')
+    parser.add_argument('site', help='Site description (JSON, see sites/)')
+    parser.add_argument('--search', choices=['grid', 'bayes'], default='bayes')
+    parser.add_argument('--params', default='',
+                        help='Comma-separated parameters to search (default: all)')
+    parser.add_argument('--budget', type=int, default=80, help='Configurations to simulate')
+    parser.add_argument('--seeds', type=int, default=3, help='Runs per configuration')
+    parser.add_argument('--hours', type=float, default=1.0, help='Simulated time per run')
+    parser.add_argument('--jobs', type=int, default=4, help='Parallel simulations')
+    parser.add_argument('--top', type=int, default=10, help='Ranked configurations to print')
+    parser.add_argument('--latency-weight', type=float, default=DEFAULT_LATENCY_WEIGHT)
+    parser.add_argument('--airtime-weight', type=float, default=DEFAULT_AIRTIME_WEIGHT)
+    parser.add_argument('--no-sensitivity', action='store_true', help='Skip the sensitivity sweep')
+    parser.add_argument('--out', help='Directory for <site>.json with all results')
+    parser.add_argument('--random-seed', type=int, default=490)
+    args = parser.parse_args()
+
+    stale = stale_model_sources()
+    if stale:
+        print(f"Warning: firmware changed under the model ({', '.join(stale)}); "
+              f"see 'make check'", file=sys.stderr)
+
+    defaults = mesh_sim.read_firmware_defaults()
+    site = mesh_sim.load_site(Path(args.site), int(defaults['MAX_NODES']))
+    base = {p.name: defaults[p.name] for p in PARAMETERS}
+
+    names = [n.strip() for n in args.params.split(',') if n.strip()]
+    unknown = [n for n in names if n not in base]
+    if unknown:
+        raise SystemExit(f"Unknown parameter(s): {', '.join(unknown)}")
+    searched = [p for p in PARAMETERS if not names or p.name in names]
+
+    print(f"Site {site.name}: {len(site.nodes)} nodes, {args.search} search over "
+          f"{len(searched)} parameters, {args.seeds} x {args.hours:g} h per configuration")
+    started = time.time()
+    rng = random.Random(args.random_seed)
+    evaluator = Evaluator(site, defaults, args)
+    try:
+        baseline = evaluator.run([base])[0]
+        if args.search == 'grid':
+            grid_search(evaluator, base, searched, args.budget, rng)
+        else:
+            bayes_search(evaluator, base, searched, args.budget, rng)
+        print(f"\n  {len(evaluator.cache)} configurations in {time.time() - started:.0f} s")
+
+        ranked = evaluator.results()
+        best = ranked[0]
+        print_ranking(ranked, defaults, baseline, args.top)
+        print_profile(site.name, best, defaults)
+
+        rows = []
+        if not args.no_sensitivity:
+            rows = sensitivity(evaluator, best)
+            m = best['metrics']
+            noise = math.sqrt((100.0 * m['deliveryStd']) ** 2 +
+                              (args.latency_weight * m['latencyP95SecStd']) ** 2 +
+                              (args.airtime_weight * m['airtimePctStd']) ** 2) / math.sqrt(args.seeds)
+            print_sensitivity(rows, best, noise)
+    finally:
+        evaluator.close()
+
+    if args.out:
+        out_dir = Path(args.out)
+        out_dir.mkdir(parents=True, exist_ok=True)
+        ranked = evaluator.results()
+        front = pareto_front(ranked)
+        report = {
+            'site': site.name,
+            'search': args.search,
+            'seeds': args.seeds,
+            'hours': args.hours,
+            'weights': {'latency': args.latency_weight, 'airtime': args.airtime_weight},
+            'firmwareDefaults': base,
+            'baseline': baseline,
+            'ranked': [dict(r, pareto=i in front, changes=changed(r['params'], defaults))
+                       for i, r in enumerate(ranked)],
+            'sensitivity': rows,
+        }
+        path = out_dir / f"{site.name}.json"
+        path.write_text(json.dumps(report, indent=2))
+        print(f"\nWrote {path}")
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,217 @@
+"""
+Firmware Node Library
+=====================
+Loads the firmware's mesh logic (built by the Makefile from src/) once per
+simulated node and checks that the glue around it still matches the tree.
+
+- Building: one libmeshnode.so per set of -D parameters, cached under
+  build/<key>/ (flag parameters are compile-time #defines)
+- Loading: the modules keep their state in globals, so every DEVICE_ID gets
+  its own copy of the library file and its own dlopen() handle
+- Model check: host/sim_node.cpp and mesh_sim.py follow the firmware
+  functions listed in model_sources.json; their SHA-256 is recorded there
+  and compared with the tree (python mesh_sim.py --check-model)
+"""
+
+import ctypes
+import fcntl
+import hashlib
+import json
+import re
+import shutil
+import subprocess
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+HERE = Path(__file__).resolve().parent
+FIRMWARE_ROOT = HERE.parents[1]
+MODEL_SOURCES = HERE / 'model_sources.json'
+
+# Return codes of sim_receive() (host/sim_node.h)
+SIM_RX_DROPPED = 0
+SIM_RX_BEACON = 1
+SIM_RX_BEACON_FRESH = 2
+SIM_RX_REPORT = 3
+SIM_RX_FORWARD = 4
+SIM_NO_BEACON = 0xFFFFFFFF
+
+
+def _message_type(name: str) -> int:
+    text = (FIRMWARE_ROOT / 'include' / 'mesh_protocol.h').read_text(encoding='utf-8', errors='replace')
+    return int(re.search(r'\b%s\s*=\s*(0x[0-9A-Fa-f]+|\d+)' % name, text).group(1), 0)
+
+
+MSG_FULL_REPORT = _message_type('MSG_FULL_REPORT')
+MSG_BEACON = _message_type('MSG_BEACON')
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         C STRUCTURES (host/sim_node.h)                    ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+class SimConfig(ctypes.Structure):
+    _fields_ = [
+        ('deviceId', ctypes.c_uint8),
+        ('isGateway', ctypes.c_uint8),
+        ('gatewayIds', ctypes.c_uint8 * 3),
+        ('useGradientRouting', ctypes.c_uint8),
+        ('useDepthOrderedSlots', ctypes.c_uint8),
+        ('useBeaconSubframe', ctypes.c_uint8),
+        ('useRateLimit', ctypes.c_uint8),
+        ('routeTimeoutMs', ctypes.c_uint32),
+        ('beaconRebroadcastMinMs', ctypes.c_uint32),
+        ('beaconRebroadcastMaxMs', ctypes.c_uint32),
+        ('pruneIntervalMs', ctypes.c_uint32),
+        ('seed', ctypes.c_uint32),
+    ]
+
+
+class SimFrame(ctypes.Structure):
+    _fields_ = [
+        ('messageType', ctypes.c_uint8),
+        ('sourceId', ctypes.c_uint8),
+        ('destId', ctypes.c_uint8),
+        ('senderId', ctypes.c_uint8),
+        ('messageId', ctypes.c_uint8),
+        ('ttl', ctypes.c_uint8),
+        ('gatewayId', ctypes.c_uint8),
+        ('distance', ctypes.c_uint8),
+        ('sequence', ctypes.c_uint16),
+        ('gpsValid', ctypes.c_uint8),
+        ('gpsSecond', ctypes.c_uint8),
+        ('tag', ctypes.c_uint32),
+    ]
+
+
+class SimCounters(ctypes.Structure):
+    _fields_ = [
+        ('queueOverflows', ctypes.c_uint32),
+        ('rateLimited', ctypes.c_uint32),
+        ('beaconSlotMisses', ctypes.c_uint32),
+        ('routeExpirations', ctypes.c_uint32),
+        ('duplicatesDropped', ctypes.c_uint32),
+    ]
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         BUILD AND LOAD                                    ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+_libraries: Dict[Tuple[str, int], ctypes.CDLL] = {}
+
+
+def build_library(defines: Dict[str, object]) -> Path:
+    """Build (or reuse) libmeshnode.so for one set of -D parameters"""
+    flags = ' '.join(f'-D{name}={_define_value(value)}' for name, value in sorted(defines.items()))
+    key = hashlib.sha256(flags.encode()).hexdigest()[:12]
+    build = HERE / 'build' / key
+    library = build / 'libmeshnode.so'
+    build.mkdir(parents=True, exist_ok=True)
+
+    # autotune.py workers may ask for the same build at once
+    with open(build / '.lock', 'w') as lock:
+        fcntl.flock(lock, fcntl.LOCK_EX)
+        result = subprocess.run(['make', '-s', 'lib', f'BUILD=build/{key}', f'DEFINES={flags}'],
+                                cwd=HERE, capture_output=True, text=True)
+    if result.returncode != 0:
+        raise RuntimeError(f'Building the node library failed:\n{result.stdout}{result.stderr}')
+    return library
+
+
+def _define_value(value) -> str:
+    if isinstance(value, bool):
+        return 'true' if value else 'false'
+    return str(value)
+
+
+def load_node(library: Path, node_id: int) -> ctypes.CDLL:
+    """A library instance of our own for node_id (globals are per instance)"""
+    key = (str(library), node_id)
+    if key in _libraries:
+        return _libraries[key]
+
+    copy = library.with_name(f'node_{node_id}.so')
+    if not copy.exists() or copy.stat().st_mtime < library.stat().st_mtime:
+        shutil.copyfile(library, copy.with_suffix('.tmp'))
+        copy.with_suffix('.tmp').replace(copy)
+    lib = ctypes.CDLL(str(copy))
+
+    lib.sim_init.argtypes = [ctypes.POINTER(SimConfig)]
+    lib.sim_set_time.argtypes = [ctypes.c_uint32]
+    lib.sim_receive.argtypes = [ctypes.POINTER(SimFrame), ctypes.c_int16]
+    lib.sim_tick.argtypes = [ctypes.c_uint8, ctypes.c_uint8, ctypes.POINTER(ctypes.c_uint8)]
+    lib.sim_own_report.argtypes = [ctypes.POINTER(SimFrame), ctypes.c_uint32]
+    lib.sim_take_forward.argtypes = [ctypes.POINTER(SimFrame)]
+    lib.sim_next_beacon_ms.argtypes = [ctypes.c_uint32]
+    lib.sim_next_beacon_ms.restype = ctypes.c_uint32
+    lib.sim_take_beacon.argtypes = [ctypes.POINTER(SimFrame)]
+    lib.sim_queue_depth.restype = ctypes.c_uint8
+    lib.sim_depth.restype = ctypes.c_uint8
+    lib.sim_counters.argtypes = [ctypes.POINTER(SimCounters)]
+
+    _libraries[key] = lib
+    return lib
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         MODEL CHECK                                       ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+def _function_body(text: str, name: str) -> str:
+    """Source of one top-level function definition, signature to closing brace"""
+    match = re.search(r'^[A-Za-z_][\w\s\*&:<>,]*\b%s\s*\([^;{]*\)\s*(?:const\s*)?\{' % re.escape(name),
+                      text, re.MULTILINE)
+    if match is None:
+        raise KeyError(name)
+
+    depth = 0
+    i = match.end() - 1
+    while i < len(text):
+        c = text[i]
+        if text.startswith('//', i):
+            i = text.find('\n', i)
+            continue
+        if text.startswith('/*', i):
+            i = text.find('*/', i) + 2
+            continue
+        if c in '"\'':
+            i += 1
+            while text[i] != c:
+                i += 2 if text[i] == '\\' else 1
+        elif c == '{':
+            depth += 1
+        elif c == '}':
+            depth -= 1
+            if depth == 0:
+                return text[match.start():i + 1]
+        i += 1
+    raise KeyError(name)
+
+
+def function_hashes(functions: List[str], root: Path = FIRMWARE_ROOT) -> Dict[str, str]:
+    """SHA-256 of each 'path:function' (line endings normalized)"""
+    hashes = {}
+    for entry in functions:
+        path, _, name = entry.partition(':')
+        text = (root / path).read_text(encoding='utf-8', errors='replace').replace('\r\n', '\n')
+        try:
+            body = _function_body(text, name)
+        except KeyError:
+            hashes[entry] = 'missing'
+            continue
+        hashes[entry] = hashlib.sha256(body.encode('utf-8')).hexdigest()
+    return hashes
+
+
+def stale_model_sources() -> List[str]:
+    """Followed firmware functions that changed since model_sources.json was updated"""
+    recorded = json.loads(MODEL_SOURCES.read_text())['functions']
+    current = function_hashes(list(recorded))
+    return [entry for entry, digest in recorded.items() if current[entry] != digest]
+
+
+def accept_model_sources():
+    """Record the current hashes (after host/sim_node.cpp and mesh_sim.py were updated)"""
+    data = json.loads(MODEL_SOURCES.read_text())
+    data['functions'] = function_hashes(list(data['functions']))
+    MODEL_SOURCES.write_text(json.dumps(data, indent=2) + '\n')
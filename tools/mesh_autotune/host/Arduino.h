@@ -0,0 +1,67 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HOST ARDUINO SHIM                                 ║
+// ║  Just enough of the Arduino core to build the mesh logic on a PC          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+// Used by the simulator's node library (Makefile 'lib'). millis() and
+// random() come from the simulator, Serial output is discarded.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper*>(text))
+
+#define DEC 10
+#define HEX 16
+
+unsigned long millis();
+long random(long high);
+long random(long low, long high);
+void delay(unsigned long ms);
+
+class String {
+public:
+    String(const char* text = "") : value(text ? text : "") {}
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return (unsigned int)value.size(); }
+    bool operator==(const String& other) const { return value == other.value; }
+    bool operator==(const char* other) const { return value == other; }
+
+private:
+    std::string value;
+};
+
+class Print {
+public:
+    size_t print(const __FlashStringHelper*) { return 0; }
+    size_t print(const char*) { return 0; }
+    size_t print(const String&) { return 0; }
+    size_t print(char) { return 0; }
+    size_t print(long, int = DEC) { return 0; }
+    size_t print(unsigned long, int = DEC) { return 0; }
+    size_t print(double, int = 2) { return 0; }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(short value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned short value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(float value, int digits = 2) { return print((double)value, digits); }
+
+    size_t println() { return 0; }
+    template <typename T> size_t println(T value) { return print(value); }
+    template <typename T> size_t println(T value, int format) { return print(value, format); }
+
+    size_t printf(const char*, ...) __attribute__((format(printf, 2, 3))) { return 0; }
+};
+
+extern Print Serial;
+
+#endif // HOST_ARDUINO_H
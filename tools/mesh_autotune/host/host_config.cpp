@@ -0,0 +1,50 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HOST CONFIGURATION                                ║
+// ║  config.cpp values the simulator sets per node and per run                ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+// config.h declares these 'extern const'; the firmware sources only see the
+// declaration and read them from memory. This file deliberately does not
+// include config.h, so it can define them writable and sim_init() can
+// configure a library instance without a rebuild.
+
+#include <stdint.h>
+
+#include "sim_node.h"
+
+uint8_t DEVICE_ID = 1;
+bool IS_GATEWAY = false;
+uint8_t GATEWAY_NODE_IDS[3] = {0, 0, 0};   // MAX_GATEWAYS
+
+bool USE_GRADIENT_ROUTING = true;
+bool USE_DEPTH_ORDERED_SLOTS = false;
+bool USE_BEACON_SUBFRAME = false;
+bool USE_RATE_LIMIT = true;
+unsigned long ROUTE_TIMEOUT_MS = 150000;
+unsigned long BEACON_REBROADCAST_MIN_MS = 100;
+unsigned long BEACON_REBROADCAST_MAX_MS = 500;
+unsigned long NEIGHBOR_PRUNE_INTERVAL_MS = 60000;
+
+bool isGatewayId(uint8_t nodeId) {
+    if (nodeId == 0) return false;
+    for (uint8_t i = 0; i < 3; i++) {
+        if (GATEWAY_NODE_IDS[i] == nodeId) return true;
+    }
+    return false;
+}
+
+void hostApplyConfig(const SimConfig& config) {
+    DEVICE_ID = config.deviceId;
+    IS_GATEWAY = config.isGateway != 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        GATEWAY_NODE_IDS[i] = config.gatewayIds[i];
+    }
+    USE_GRADIENT_ROUTING = config.useGradientRouting != 0;
+    USE_DEPTH_ORDERED_SLOTS = config.useDepthOrderedSlots != 0;
+    USE_BEACON_SUBFRAME = config.useBeaconSubframe != 0;
+    USE_RATE_LIMIT = config.useRateLimit != 0;
+    ROUTE_TIMEOUT_MS = config.routeTimeoutMs;
+    BEACON_REBROADCAST_MIN_MS = config.beaconRebroadcastMinMs;
+    BEACON_REBROADCAST_MAX_MS = config.beaconRebroadcastMaxMs;
+    NEIGHBOR_PRUNE_INTERVAL_MS = config.pruneIntervalMs;
+}
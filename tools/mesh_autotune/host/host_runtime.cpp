@@ -0,0 +1,93 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         HOST RUNTIME                                      ║
+// ║  Clock, random(), Serial, metrics and GPS/network-time stand-ins          ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+#include <Arduino.h>
+#include <random>
+
+#include "metrics.h"
+#include "network_time.h"
+
+static unsigned long hostNowMs = 0;
+static std::mt19937 hostRandom;
+
+Print Serial;
+
+// GPS date (gps.cpp), only copied into TDMA timestamps
+int g_year = 2026;
+int g_month = 1;
+int g_day = 1;
+
+void hostSetMillis(unsigned long nowMs) {
+    hostNowMs = nowMs;
+}
+
+void hostSeedRandom(uint32_t seed) {
+    hostRandom.seed(seed);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Arduino core
+// ─────────────────────────────────────────────────────────────────────────────
+
+unsigned long millis() {
+    return hostNowMs;
+}
+
+long random(long high) {
+    return random(0, high);
+}
+
+long random(long low, long high) {
+    // Arduino: [low, high), and low when the range is empty
+    if (high <= low) return low;
+    std::uniform_int_distribution<long> range(low, high - 1);
+    return range(hostRandom);
+}
+
+void delay(unsigned long) {
+    // Blocking time is modelled by the simulator's event queue
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Metrics (counters only, the simulator reads a few of them)
+// ─────────────────────────────────────────────────────────────────────────────
+
+static uint32_t counters[MET_COUNT];
+
+void metricInc(MetricId id) {
+    if (id < MET_COUNT) counters[id]++;
+}
+
+void metricAdd(MetricId id, uint32_t amount) {
+    if (id < MET_COUNT) counters[id] += amount;
+}
+
+void metricSet(MetricId id, uint32_t value) {
+    if (id < MET_COUNT) counters[id] = value;
+}
+
+void metricObserve(HistogramId, int32_t) {}
+
+void metricIncLabel(MetricFamily, uint8_t) {}
+
+uint32_t metricGet(MetricId id) {
+    return id < MET_COUNT ? counters[id] : 0;
+}
+
+void metricsReset() {
+    memset(counters, 0, sizeof(counters));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Network time: the simulator passes each node its own clock as GPS time
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool isNetworkTimeValid() {
+    return false;
+}
+
+bool getNetworkTimeMs(uint8_t&, uint8_t&, uint8_t&, uint16_t&) {
+    return false;
+}
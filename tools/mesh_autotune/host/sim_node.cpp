@@ -0,0 +1,336 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SIMULATOR NODE LIBRARY                            ║
+// ║  Firmware modules behind a stubbed radio, driven by mesh_sim.py           ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+// Routing, duplicate detection, queueing, slot timing and rate limiting are
+// the firmware's own code. What is here is the glue that calls them, as
+// packet_handler.cpp and main.cpp do, without the radio, display, node
+// store and logging around it. Keep it in step with the functions listed in
+// model_sources.json ('make check').
+
+#include <Arduino.h>
+
+#include "sim_node.h"
+#include "config.h"
+#include "mesh_protocol.h"
+#include "gradient_routing.h"
+#include "duplicate_cache.h"
+#include "transmit_queue.h"
+#include "tdma_scheduler.h"
+#include "rate_limiter.h"
+#include "metrics.h"
+
+// host_config.cpp, host_runtime.cpp
+void hostApplyConfig(const SimConfig& config);
+void hostSetMillis(unsigned long nowMs);
+void hostSeedRandom(uint32_t seed);
+
+#define FORWARD_PRUNE_AGE_MS 60000          // main.cpp: transmitQueue.pruneOld(60000)
+
+TDMAScheduler tdmaScheduler;                // main.cpp
+
+static uint8_t ownMessageId = 0;            // lora_comm.cpp meshMessageSeq
+static unsigned long lastPruneMs = 0;
+static uint32_t rateLimitedFrames = 0;
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         FRAME CONVERSION                                  ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+static MeshHeader toHeader(const SimFrame& frame) {
+    MeshHeader header;
+    header.version = MESH_PROTOCOL_VERSION;
+    header.messageType = frame.messageType;
+    header.sourceId = frame.sourceId;
+    header.destId = frame.destId;
+    header.senderId = frame.senderId;
+    header.messageId = frame.messageId;
+    header.ttl = frame.ttl;
+    header.flags = 0;
+    return header;
+}
+
+static void fromHeader(const MeshHeader& header, SimFrame& frame) {
+    memset(&frame, 0, sizeof(frame));
+    frame.messageType = header.messageType;
+    frame.sourceId = header.sourceId;
+    frame.destId = header.destId;
+    frame.senderId = header.senderId;
+    frame.messageId = header.messageId;
+    frame.ttl = header.ttl;
+}
+
+static BeaconMsg toBeacon(const SimFrame& frame) {
+    BeaconMsg beacon;
+    memset(&beacon, 0, sizeof(beacon));
+    beacon.meshHeader = toHeader(frame);
+    beacon.distanceToGateway = frame.distance;
+    beacon.gatewayId = frame.gatewayId;
+    beacon.sequenceNumber = frame.sequence;
+    beacon.gpsSecond = frame.gpsSecond;
+    beacon.gpsValid = frame.gpsValid;
+    beacon.epoch = 1;
+    return beacon;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         PACKET HANDLER GLUE                               ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+/**
+ * packet_handler.cpp acceptRxHeader()
+ */
+static bool acceptHeader(const MeshHeader& header) {
+    if (header.sourceId == DEVICE_ID) {
+        return false;
+    }
+
+    if (header.messageType == MSG_FULL_REPORT &&
+        duplicateCache.isDuplicate(header.sourceId, header.messageId)) {
+        metricInc(MET_DUPLICATES_DROPPED);
+        return false;
+    }
+
+    RateClass rateClass = rateClassForType(header.messageType);
+    uint8_t chargedNode = (rateClass == RATE_RX_BEACON) ? header.senderId : header.sourceId;
+    if (!rateLimiter.allow(chargedNode, rateClass)) {
+        rateLimitedFrames++;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * packet_handler.cpp shouldForward()
+ */
+static bool shouldForward(const MeshHeader& header) {
+    if (header.ttl <= 1) return false;
+    if (header.sourceId == DEVICE_ID) return false;
+    if (!ROLE_FORWARDS) return false;
+
+    if (IS_GATEWAY && (header.destId == ADDR_BROADCAST || header.destId == ADDR_GATEWAY ||
+                       isGatewayId(header.destId))) {
+        return false;
+    }
+
+    if (hasValidRoute()) {
+        if (IS_GATEWAY) return true;
+        return header.senderId != getNextHopFor(header.destId);
+    }
+    return true;    // Flooding fallback
+}
+
+/**
+ * packet_handler.cpp scheduleForward() (the report payload is the tag)
+ */
+static bool scheduleForward(const MeshHeader& header, uint32_t tag) {
+    if (header.messageType != MSG_LOAD_TEST && !rateLimiter.allow(header.sourceId, RATE_FORWARD)) {
+        rateLimitedFrames++;
+        return false;
+    }
+
+    uint8_t buffer[sizeof(MeshHeader) + sizeof(tag)];
+    MeshHeader forwardHeader = header;
+    forwardHeader.ttl--;
+    forwardHeader.senderId = DEVICE_ID;
+    forwardHeader.flags |= FLAG_IS_FORWARDED;
+    memcpy(buffer, &forwardHeader, sizeof(MeshHeader));
+    memcpy(buffer + sizeof(MeshHeader), &tag, sizeof(tag));
+
+    if (hasValidRoute()) {
+        incrementUnicastForwards();
+    } else {
+        incrementFloodingFallbacks();
+    }
+
+    if (transmitQueue.enqueue(buffer, sizeof(buffer))) {
+        return true;
+    }
+    metricInc(MET_QUEUE_OVERFLOWS);
+    return false;
+}
+
+/**
+ * packet_handler.cpp checkForIncomingMessages(), MSG_BEACON branch
+ */
+static int receiveBeacon(const SimFrame& frame, int16_t rssi) {
+    BeaconMsg beacon = toBeacon(frame);
+
+    BeaconCheck freshness = checkBeaconFreshness(beacon);
+    if (freshness == BEACON_DUPLICATE || freshness == BEACON_STALE) {
+        return SIM_RX_DROPPED;
+    }
+
+    updateRoutingState(beacon.distanceToGateway, beacon.meshHeader.senderId,
+                       beacon.gatewayId, beacon.sequenceNumber, rssi);
+    if (freshness == BEACON_ROUTE_COPY) {
+        return SIM_RX_BEACON;
+    }
+
+    // Network time is the simulator's: it syncs the node on a fresh beacon
+    scheduleBeaconRebroadcast(beacon, millis());
+    return SIM_RX_BEACON_FRESH;
+}
+
+/**
+ * packet_handler.cpp checkForIncomingMessages(), MSG_FULL_REPORT branch
+ */
+static int receiveReport(const SimFrame& frame) {
+    MeshHeader header = toHeader(frame);
+
+    duplicateCache.markSeen(header.sourceId, header.messageId);
+
+    if (shouldForward(header) && scheduleForward(header, frame.tag)) {
+        metricInc(MET_FORWARDS_SCHEDULED);
+        return SIM_RX_FORWARD;
+    }
+    return SIM_RX_REPORT;
+}
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         C API                                             ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+
+void sim_init(const SimConfig* config) {
+    hostApplyConfig(*config);
+    hostSetMillis(0);
+    hostSeedRandom(config->seed);
+    metricsReset();
+
+    duplicateCache = DuplicateCache();
+    transmitQueue = TransmitQueue();
+    rateLimiter = RateLimiter();
+    rateLimiter.setEnabled(USE_RATE_LIMIT);
+    initGradientRouting();
+
+    // main.cpp setup()
+    tdmaScheduler = TDMAScheduler();
+    tdmaScheduler.setDepthOrdering(USE_DEPTH_ORDERED_SLOTS);
+    tdmaScheduler.setBeaconSubframe(USE_BEACON_SUBFRAME);
+    tdmaScheduler.init(DEVICE_ID);
+
+    ownMessageId = 0;
+    lastPruneMs = 0;
+    rateLimitedFrames = 0;
+}
+
+void sim_set_time(uint32_t nowMs) {
+    hostSetMillis(nowMs);
+}
+
+int sim_receive(const SimFrame* frame, int16_t rssi) {
+    if (!acceptHeader(toHeader(*frame))) {
+        return SIM_RX_DROPPED;
+    }
+    if (frame->messageType == MSG_BEACON) {
+        return receiveBeacon(*frame, rssi);
+    }
+    return receiveReport(*frame);
+}
+
+int sim_tick(uint8_t minute, uint8_t second, uint8_t* slotEnd) {
+    // main.cpp loop(): depth for the slot layout, then the scheduler
+    if (IS_GATEWAY) {
+        tdmaScheduler.setDepth(0);
+    } else {
+        RoutingState route = getRoutingState();
+        tdmaScheduler.setDepth(route.routeValid ? route.distanceToGateway : DISTANCE_UNKNOWN);
+    }
+    tdmaScheduler.updateWithFallback(0, minute, second, true);
+
+    if (millis() - lastPruneMs >= NEIGHBOR_PRUNE_INTERVAL_MS) {
+        duplicateCache.prune();
+        transmitQueue.pruneOld(FORWARD_PRUNE_AGE_MS);
+        lastPruneMs = millis();
+    }
+
+    if (!tdmaScheduler.shouldTransmitNow()) {
+        return 0;
+    }
+    *slotEnd = tdmaScheduler.getSlotEnd();
+    tdmaScheduler.markTransmissionComplete();
+    return 1;
+}
+
+void sim_own_report(SimFrame* out, uint32_t tag) {
+    // main.cpp transmit(), lora_comm.cpp FULL_REPORT header
+    memset(out, 0, sizeof(*out));
+    out->messageType = MSG_FULL_REPORT;
+    out->sourceId = DEVICE_ID;
+    out->senderId = DEVICE_ID;
+    out->destId = getAnycastGateway();
+    out->messageId = ownMessageId++;
+    out->ttl = MESH_DEFAULT_TTL;
+    out->tag = tag;
+}
+
+int sim_take_forward(SimFrame* out) {
+    QueuedMessage* msg = transmitQueue.peek();
+    if (msg == nullptr) {
+        return 0;
+    }
+    MeshHeader header;
+    memcpy(&header, msg->data, sizeof(MeshHeader));
+    fromHeader(header, *out);
+    memcpy(&out->tag, msg->data + sizeof(MeshHeader), sizeof(out->tag));
+    transmitQueue.dequeue();
+    return 1;
+}
+
+uint32_t sim_next_beacon_ms(uint32_t horizonMs) {
+    // hasPendingBeacon() only turns true as time passes: search for the edge
+    unsigned long now = millis();
+    unsigned long low = now;
+    unsigned long high = now + horizonMs;
+
+    hostSetMillis(high);
+    bool due = hasPendingBeacon();
+    while (due && low < high) {
+        unsigned long mid = low + (high - low) / 2;
+        hostSetMillis(mid);
+        if (hasPendingBeacon()) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    hostSetMillis(now);
+    return due ? (uint32_t)high : SIM_NO_BEACON;
+}
+
+int sim_take_beacon(SimFrame* out) {
+    // main.cpp sendPendingBeacon()
+    if (IS_GATEWAY || !ROLE_FORWARDS) {
+        return 0;
+    }
+    BeaconMsg beacon;
+    if (!getPendingBeacon(beacon)) {
+        return 0;
+    }
+    fromHeader(beacon.meshHeader, *out);
+    out->gatewayId = beacon.gatewayId;
+    out->distance = beacon.distanceToGateway;
+    out->sequence = beacon.sequenceNumber;
+    out->gpsValid = beacon.gpsValid;
+    out->gpsSecond = beacon.gpsSecond;
+    return 1;
+}
+
+uint8_t sim_queue_depth() {
+    return transmitQueue.depth();
+}
+
+uint8_t sim_depth() {
+    if (IS_GATEWAY) return 0;
+    RoutingState route = getRoutingState();
+    return route.routeValid ? route.distanceToGateway : DISTANCE_UNKNOWN;
+}
+
+void sim_counters(SimCounters* out) {
+    out->queueOverflows = metricGet(MET_QUEUE_OVERFLOWS);
+    out->rateLimited = rateLimitedFrames;
+    out->beaconSlotMisses = metricGet(MET_BEACON_SLOT_MISSES);
+    out->routeExpirations = metricGet(MET_ROUTE_EXPIRATIONS);
+    out->duplicatesDropped = metricGet(MET_DUPLICATES_DROPPED);
+}
@@ -0,0 +1,103 @@
+#ifndef SIM_NODE_H
+#define SIM_NODE_H
+
+#include <stdint.h>
+
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SIMULATOR NODE LIBRARY                            ║
+// ║  One mesh node's firmware logic behind a C API for mesh_sim.py            ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+// The library links the firmware's own gradient_routing, duplicate_cache,
+// transmit_queue, tdma_scheduler and rate_limiter sources. Their state is
+// global, so mesh_sim.py loads one copy of the library per DEVICE_ID.
+//
+// sim_node.cpp replaces the radio and the glue around those modules
+// (packet_handler.cpp receive path, main.cpp loop). That glue is the part
+// still written twice; model_sources.json records the firmware functions it
+// follows and 'make check' fails when they change.
+//
+// The ctypes structures in firmware_node.py must match these.
+
+#define SIM_NO_BEACON   0xFFFFFFFFUL
+
+// The library is built with -fvisibility=hidden: only this API is exported
+#define SIM_API extern "C" __attribute__((visibility("default")))
+
+enum SimRxResult {
+    SIM_RX_DROPPED = 0,         // Filtered, duplicate, stale or own frame
+    SIM_RX_BEACON = 1,          // Beacon copy used for routing only
+    SIM_RX_BEACON_FRESH = 2,    // New beacon: routing, time sync, rebroadcast
+    SIM_RX_REPORT = 3,          // New report, not forwarded
+    SIM_RX_FORWARD = 4          // New report, queued for forwarding
+};
+
+struct SimConfig {
+    uint8_t  deviceId;
+    uint8_t  isGateway;
+    uint8_t  gatewayIds[3];                 // MAX_GATEWAYS
+    uint8_t  useGradientRouting;
+    uint8_t  useDepthOrderedSlots;
+    uint8_t  useBeaconSubframe;
+    uint8_t  useRateLimit;
+    uint32_t routeTimeoutMs;
+    uint32_t beaconRebroadcastMinMs;
+    uint32_t beaconRebroadcastMaxMs;
+    uint32_t pruneIntervalMs;               // NEIGHBOR_PRUNE_INTERVAL_MS
+    uint32_t seed;                          // random()
+};
+
+// A frame as the simulator's radio carries it (FULL_REPORT or BEACON)
+struct SimFrame {
+    uint8_t  messageType;       // MSG_FULL_REPORT or MSG_BEACON
+    uint8_t  sourceId;
+    uint8_t  destId;
+    uint8_t  senderId;
+    uint8_t  messageId;
+    uint8_t  ttl;
+    uint8_t  gatewayId;         // Beacon fields
+    uint8_t  distance;
+    uint16_t sequence;
+    uint8_t  gpsValid;
+    uint8_t  gpsSecond;
+    uint32_t tag;               // Simulator's report number, carried in the payload
+};
+
+struct SimCounters {
+    uint32_t queueOverflows;
+    uint32_t rateLimited;
+    uint32_t beaconSlotMisses;
+    uint32_t routeExpirations;
+    uint32_t duplicatesDropped;
+};
+
+/** Reset every module and configure them for one node (clock at 0) */
+SIM_API void sim_init(const SimConfig* config);
+
+/** Set millis() (simulation milliseconds) */
+SIM_API void sim_set_time(uint32_t nowMs);
+
+/** One frame off the air: header filter, then the beacon or report path */
+SIM_API int sim_receive(const SimFrame* frame, int16_t rssi);
+
+/** Loop iteration at the start of a second: depth, TDMA, pruning
+ *  @return 1 if the scheduler says transmit now (slotEnd is set) */
+SIM_API int sim_tick(uint8_t minute, uint8_t second, uint8_t* slotEnd);
+
+/** Build our own FULL_REPORT (anycast to the best gateway) */
+SIM_API void sim_own_report(SimFrame* out, uint32_t tag);
+
+/** Front of the forward queue, removed; 0 when empty */
+SIM_API int sim_take_forward(SimFrame* out);
+
+/** When the next beacon relay is due, or SIM_NO_BEACON within horizonMs */
+SIM_API uint32_t sim_next_beacon_ms(uint32_t horizonMs);
+
+/** The due beacon relay, if it is still in its slot; 0 when none */
+SIM_API int sim_take_beacon(SimFrame* out);
+
+SIM_API uint8_t sim_queue_depth();
+SIM_API uint8_t sim_depth();
+SIM_API void sim_counters(SimCounters* out);
+
+#endif // SIM_NODE_H
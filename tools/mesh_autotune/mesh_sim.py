@@ -0,0 +1,695 @@
+#!/usr/bin/env python3
+"""
+LoRa Mesh Simulator
+===================
+Discrete-event model of the firmware's mesh timing over a simulated site.
+
+Every node runs the firmware's own mesh modules, built for the host by the
+Makefile and loaded once per DEVICE_ID (firmware_node.py):
+- TDMA slots: ID-ordered or depth-ordered bands, beacon sub-frame
+  (tdma_scheduler.cpp)
+- Gradient routing: freshness check, route updates, micro-slot or
+  random-delay rebroadcast, ROUTE_TIMEOUT_MS expiry (gradient_routing.cpp)
+- Forwarding: duplicate cache, transmit queue and rate limiter
+  (duplicate_cache.cpp, transmit_queue.cpp, rate_limiter.cpp) behind the
+  receive path of packet_handler.cpp (host/sim_node.cpp)
+
+What is modelled here:
+- Main loop timing: one report per frame at the TX second, then up to
+  MAX_FORWARDS_PER_SLOT queued forwards until one second before the slot
+  ends; beacon relays wait for a blocking transmission (main.cpp)
+- Gateway beacons, each node's network-time error
+- Radio: SX1262 airtime, log-distance path loss with per-link shadowing and
+  per-frame fading, sensitivity, half duplex and capture-effect collisions
+
+The glue that mirrors packet_handler.cpp and main.cpp is checked against the
+tree: 'python mesh_sim.py --check-model' (make check) fails when a function
+it follows changed, '--accept-model' records the tree once the glue is updated.
+
+Usage:
+    python mesh_sim.py sites/bench5.json
+    python mesh_sim.py sites/hillside.json --set TX_QUEUE_SIZE=4 --hours 2 --seeds 5
+    python mesh_sim.py --check-model
+"""
+
+import argparse
+import ctypes
+import heapq
+import json
+import math
+import random
+import re
+import statistics
+import sys
+from collections import deque
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+from firmware_node import (MSG_BEACON, MSG_FULL_REPORT, SIM_NO_BEACON, SIM_RX_BEACON_FRESH,
+                           SIM_RX_DROPPED, SimConfig, SimCounters, SimFrame, accept_model_sources,
+                           build_library, load_node, stale_model_sources)
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         FIRMWARE CONSTANTS                                ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+# Repository root (tools/mesh_autotune/ -> repo)
+FIRMWARE_ROOT = Path(__file__).resolve().parents[2]
+
+
+@dataclass
+class Parameter:
+    """One tunable firmware constant and the values the search may try"""
+    name: str
+    source: str             # File that defines the default (relative to the repo)
+    deploy: str             # 'config' = edit config.cpp, 'flag' = build_flags -D
+    values: list            # Candidate values (ordered, used by grid and Bayesian search)
+
+
+# Everything autotune.py may change. Defaults come from the tree, not from here.
+PARAMETERS: List[Parameter] = [
+    Parameter('BEACON_INTERVAL_MS', 'src/config.cpp', 'config', [10000, 20000, 30000, 60000, 120000]),
+    Parameter('ROUTE_TIMEOUT_MS', 'src/config.cpp', 'config', [65000, 90000, 150000, 240000, 400000]),
+    Parameter('BEACON_REBROADCAST_MIN_MS', 'src/config.cpp', 'config', [0, 50, 100, 250, 500]),
+    Parameter('BEACON_REBROADCAST_MAX_MS', 'src/config.cpp', 'config', [200, 500, 1000, 2000, 4000]),
+    Parameter('DUPLICATE_WINDOW_MS', 'include/duplicate_cache.h', 'flag', [20000, 60000, 120000, 300000, 900000]),
+    Parameter('NEIGHBOR_TIMEOUT_MS', 'include/neighbor_table.h', 'flag', [60000, 180000, 600000]),
+    Parameter('TX_QUEUE_SIZE', 'include/transmit_queue.h', 'flag', [2, 4, 8, 12, 16]),
+    Parameter('MAX_FORWARDS_PER_SLOT', 'include/transmit_queue.h', 'flag', [1, 2, 3, 5, 8]),
+    Parameter('TDMA_TX_OFFSET_SEC', 'include/tdma_scheduler.h', 'flag', [0, 2, 4, 6, 8]),
+    Parameter('TDMA_SUBSLOT_TX_OFFSET_SEC', 'include/tdma_scheduler.h', 'flag', [0, 1, 2]),
+    Parameter('USE_DEPTH_ORDERED_SLOTS', 'src/config.cpp', 'config', [False, True]),
+    Parameter('USE_BEACON_SUBFRAME', 'src/config.cpp', 'config', [False, True]),
+]
+
+# Fixed protocol constants the model needs (not searched)
+MODEL_CONSTANTS = {
+    'USE_GRADIENT_ROUTING': 'src/config.cpp',
+    'USE_RATE_LIMIT': 'src/config.cpp',
+    'NEIGHBOR_PRUNE_INTERVAL_MS': 'src/config.cpp',
+    'MESH_MAX_HOPS': 'include/config.h',
+    'BEACON_DEPTH_SLOT_MS': 'include/gradient_routing.h',
+    'BEACON_ID_SPACING_MS': 'include/gradient_routing.h',
+    'MAX_NODES': 'include/tdma_scheduler.h',
+    'LORA_HEADER_SIZE': 'include/lora_comm.h',
+}
+
+# Message sizes (mesh_schema.h), sent after the LoRa header
+REPORT_MESSAGE_BYTES = 39
+BEACON_MESSAGE_BYTES = 21
+
+# Firmware timing the model cannot read from a constant
+PRIMARY_TX_PAUSE_MS = 100       # delay(100) after our own report (main.cpp)
+FORWARD_GAP_MS = 50             # delay(50) between queued forwards (main.cpp)
+ADDR_BROADCAST = 0xFF
+
+
+def _parse_value(text: str):
+    text = text.strip().rstrip('UuLl')
+    if text in ('true', 'false'):
+        return text == 'true'
+    return int(text, 0)
+
+
+def read_firmware_defaults(root: Path = FIRMWARE_ROOT) -> Dict[str, object]:
+    """
+    Read the current value of every parameter and model constant from the
+    firmware sources (config.cpp consts, #defines, static constexpr members)
+    """
+    wanted = {p.name: p.source for p in PARAMETERS}
+    wanted.update(MODEL_CONSTANTS)
+    values: Dict[str, object] = {}
+    cache: Dict[str, str] = {}
+
+    for name, source in wanted.items():
+        if source not in cache:
+            cache[source] = (root / source).read_text(encoding='utf-8', errors='replace')
+        text = cache[source]
+        patterns = [
+            r'#define\s+%s\s+([^\s/]+)' % name,
+            r'const\s+(?:unsigned long|bool|uint8_t|uint16_t|size_t)\s+%s\s*=\s*([^;]+);' % name,
+            r'static\s+constexpr\s+\w+\s+%s\s*=\s*([^;]+);' % name,
+        ]
+        for pattern in patterns:
+            match = re.search(pattern, text)
+            if match:
+                try:
+                    values[name] = _parse_value(match.group(1))
+                except ValueError:
+                    continue
+                break
+        if name not in values:
+            raise RuntimeError(f'{name} not found in {source}')
+
+    return values
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         SITE DESCRIPTION                                  ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+DEFAULT_RADIO = {
+    'sf': 7,                    # lora_comm.cpp: SF7, 125 kHz, CR 4/5, 14 dBm
+    'bandwidthKHz': 125,
+    'codingRate': 5,
+    'preamble': 8,
+    'txPowerDbm': 14,
+    'referenceLossDb': 31.7,    # Free space at 1 m, 915 MHz
+    'pathLossExponent': 3.0,
+    'shadowingDb': 4.0,         # Per link, fixed for a run
+    'fadingDb': 2.0,            # Per frame
+    'sensitivityDbm': -124.0,   # SX1262 at SF7/125 kHz
+    'captureDb': 6.0,           # Stronger frame survives an overlap by this margin
+}
+
+
+@dataclass
+class SiteNode:
+    node_id: int
+    x: float
+    y: float
+    gateway: bool = False
+    report_every_min: int = 1   # Firmware reports every frame; >1 models a quieter node
+
+
+@dataclass
+class Site:
+    name: str
+    nodes: List[SiteNode]
+    radio: Dict[str, float]
+    link_loss: Dict[Tuple[int, int], float] = field(default_factory=dict)
+    clock_jitter_ms: float = 20.0
+
+
+def load_site(path: Path, max_nodes: int) -> Site:
+    """
+    Load a site file (see sites/*.json)
+
+    nodes:  [{"id", "x", "y" (meters), "gateway", "reportEveryMin"}]
+    radio:  overrides for DEFAULT_RADIO
+    links:  [{"a", "b", "lossDb"}] fixed path loss for a pair (walls, hills);
+            "lossDb": null removes the link
+    """
+    data = json.loads(Path(path).read_text())
+    radio = dict(DEFAULT_RADIO)
+    radio.update(data.get('radio', {}))
+
+    nodes = []
+    for entry in data['nodes']:
+        node_id = int(entry['id'])
+        if not 1 <= node_id <= max_nodes:
+            raise ValueError(f'node {node_id}: TDMA slots exist for IDs 1-{max_nodes} only')
+        nodes.append(SiteNode(node_id, float(entry['x']), float(entry['y']),
+                              bool(entry.get('gateway', False)),
+                              int(entry.get('reportEveryMin', 1))))
+    if not any(n.gateway for n in nodes):
+        raise ValueError('site has no gateway')
+
+    link_loss = {}
+    for link in data.get('links', []):
+        loss = link['lossDb']
+        a, b = int(link['a']), int(link['b'])
+        link_loss[(min(a, b), max(a, b))] = math.inf if loss is None else float(loss)
+
+    return Site(data.get('name', Path(path).stem), nodes, radio, link_loss,
+                float(data.get('clockJitterMs', 20.0)))
+
+
+def lora_airtime_ms(payload_bytes: int, radio: Dict[str, float]) -> float:
+    """Semtech time-on-air: explicit header, CRC on"""
+    sf = int(radio['sf'])
+    bw = radio['bandwidthKHz'] * 1000.0
+    cr = int(radio['codingRate']) - 4
+    symbol_ms = (2 ** sf) / bw * 1000.0
+    low_rate = 1 if symbol_ms > 16.0 else 0
+    numerator = 8 * payload_bytes - 4 * sf + 28 + 16
+    symbols = 8 + max(math.ceil(numerator / (4.0 * (sf - 2 * low_rate))) * (cr + 4), 0)
+    return (radio['preamble'] + 4.25) * symbol_ms + symbols * symbol_ms
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         SIMULATION STATE                                  ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+@dataclass
+class Frame:
+    kind: str                   # 'report' or 'beacon'
+    sender: int
+    source: int
+    msg_id: int
+    ttl: int
+    dest: int = 0
+    uid: int = 0                # Unique report number (delivery accounting)
+    gateway_id: int = 0         # Beacon fields
+    sequence: int = 0
+    distance: int = 0
+    gps_valid: bool = True
+    gps_second: int = 0
+
+    def to_c(self) -> SimFrame:
+        return SimFrame(MSG_FULL_REPORT if self.kind == 'report' else MSG_BEACON,
+                        self.source, self.dest, self.sender, self.msg_id & 0xFF, self.ttl,
+                        self.gateway_id, self.distance, self.sequence & 0xFFFF,
+                        int(self.gps_valid), self.gps_second, self.uid)
+
+    @staticmethod
+    def from_c(frame: SimFrame) -> 'Frame':
+        return Frame('report' if frame.messageType == MSG_FULL_REPORT else 'beacon',
+                     frame.senderId, frame.sourceId, frame.messageId, frame.ttl, frame.destId,
+                     frame.tag, frame.gatewayId, frame.distance, frame.sequence,
+                     bool(frame.gpsValid), frame.gpsSecond)
+
+
+@dataclass
+class Arrival:
+    frame: Frame
+    start: float
+    end: float
+    rssi: float
+
+
+class SimNode:
+    """One site node: its firmware library instance, radio and clock"""
+
+    def __init__(self, site_node: SiteNode, firmware: ctypes.CDLL):
+        self.id = site_node.node_id
+        self.gateway = site_node.gateway
+        self.report_every = max(1, site_node.report_every_min)
+        self.fw = firmware
+        self.clock_offset_ms = 0.0
+        self.synced = self.gateway      # Gateway has GPS time
+        self.beacon_seq = 0
+        self.minutes = 0
+        self.beacon_due: Optional[int] = None   # Next relay event in the queue
+        self.tx_until = -1.0
+        self.tx_intervals: deque = deque(maxlen=32)
+
+
+@dataclass
+class SimResult:
+    generated: int = 0
+    delivered: int = 0
+    latencies: List[float] = field(default_factory=list)
+    airtime_ms: float = 0.0
+    node_airtime_ms: Dict[int, float] = field(default_factory=dict)
+    duration_ms: float = 0.0
+    queue_drops: int = 0
+    rate_limited: int = 0
+    collisions: int = 0
+    forwards: int = 0
+    beacons: int = 0
+    beacon_slot_misses: int = 0
+    route_losses: int = 0
+
+    def metrics(self) -> Dict[str, float]:
+        lat = sorted(self.latencies)
+        p95 = lat[min(len(lat) - 1, int(0.95 * len(lat)))] / 1000.0 if lat else 0.0
+        busiest = max(self.node_airtime_ms.values()) if self.node_airtime_ms else 0.0
+        return {
+            'delivery': self.delivered / self.generated if self.generated else 0.0,
+            'latencyMeanSec': statistics.fmean(lat) / 1000.0 if lat else 0.0,
+            'latencyP95Sec': p95,
+            'airtimePct': 100.0 * self.airtime_ms / self.duration_ms if self.duration_ms else 0.0,
+            'dutyMaxPct': 100.0 * busiest / self.duration_ms if self.duration_ms else 0.0,
+            'airtimePerReportMs': self.airtime_ms / self.delivered if self.delivered else 0.0,
+            'queueDrops': self.queue_drops,
+            'rateLimited': self.rate_limited,
+            'collisions': self.collisions,
+            'forwards': self.forwards,
+            'beaconSlotMisses': self.beacon_slot_misses,
+            'routeLosses': self.route_losses,
+        }
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         SIMULATOR                                         ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+class MeshSimulator:
+    """
+    One run of one configuration on one site
+
+    Time is in milliseconds of gateway (GPS) time, which is also every
+    node's millis(). Each synced node ticks once per second of its own clock,
+    which is offset from the gateway's by the network-time error
+    (clockJitterMs) drawn when it first syncs.
+    """
+
+    def __init__(self, site: Site, params: Dict[str, object], seed: int,
+                 duration_ms: float, warmup_ms: float = 300000.0):
+        self.site = site
+        self.p = params
+        self.rng = random.Random(seed)
+        self.duration_ms = duration_ms
+        self.warmup_ms = warmup_ms
+        self.radio = site.radio
+
+        # -D parameters need their own build; config.cpp values are set per run
+        library = build_library({p.name: params[p.name] for p in PARAMETERS if p.deploy == 'flag'})
+        gateway_ids = ([n.node_id for n in site.nodes if n.gateway] + [0, 0, 0])[:3]
+        self.nodes: Dict[int, SimNode] = {}
+        for site_node in site.nodes:
+            firmware = load_node(library, site_node.node_id)
+            config = SimConfig(site_node.node_id, int(site_node.gateway), (ctypes.c_uint8 * 3)(*gateway_ids),
+                               int(params['USE_GRADIENT_ROUTING']), int(params['USE_DEPTH_ORDERED_SLOTS']),
+                               int(params['USE_BEACON_SUBFRAME']), int(params['USE_RATE_LIMIT']),
+                               params['ROUTE_TIMEOUT_MS'], params['BEACON_REBROADCAST_MIN_MS'],
+                               params['BEACON_REBROADCAST_MAX_MS'], params['NEIGHBOR_PRUNE_INTERVAL_MS'],
+                               seed * 1000 + site_node.node_id)
+            firmware.sim_init(ctypes.byref(config))
+            self.nodes[site_node.node_id] = SimNode(site_node, firmware)
+
+        self.events: list = []
+        self.event_seq = 0
+        self.now = 0.0
+        self.result = SimResult(node_airtime_ms={n: 0.0 for n in self.nodes})
+        self.arrivals: Dict[int, List[Arrival]] = {n: [] for n in self.nodes}
+        header = int(params['LORA_HEADER_SIZE'])
+        self.report_airtime = lora_airtime_ms(header + REPORT_MESSAGE_BYTES, self.radio)
+        self.beacon_airtime = lora_airtime_ms(header + BEACON_MESSAGE_BYTES, self.radio)
+        # Latest a relay can be scheduled: random delay or deepest micro-slot
+        self.beacon_horizon_ms = int(max(params['BEACON_REBROADCAST_MAX_MS'],
+                                         (params['MESH_MAX_HOPS'] + 1) * params['BEACON_DEPTH_SLOT_MS'] +
+                                         params['MAX_NODES'] * params['BEACON_ID_SPACING_MS']))
+        self.next_uid = 0
+        self.counted_uids: Dict[int, float] = {}   # uid -> created (reports in the scored window)
+        self.delivered_uids = set()
+
+        self.mean_loss = self._link_budgets()
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # Event queue
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def schedule(self, at_ms: float, callback, *args):
+        self.event_seq += 1
+        heapq.heappush(self.events, (at_ms, self.event_seq, callback, args))
+
+    def run(self) -> SimResult:
+        gateways = [n for n in self.nodes.values() if n.gateway]
+        for gw in gateways:
+            if self.p['USE_BEACON_SUBFRAME']:
+                self.schedule(0.0, self._gateway_subframe_beacon, gw)
+            else:
+                self.schedule(self.rng.uniform(0, self.p['BEACON_INTERVAL_MS']),
+                              self._gateway_interval_beacon, gw)
+            self._start_ticks(gw, 0.0)
+
+        while self.events:
+            at_ms, _, callback, args = heapq.heappop(self.events)
+            if at_ms > self.duration_ms:
+                break
+            self.now = at_ms
+            callback(*args)
+
+        # Expected reports in the scored window, so a node that never syncs
+        # (and never transmits) counts as lost rather than absent
+        scored_minutes = max(0.0, (self.duration_ms - 120000.0 - self.warmup_ms) / 60000.0)
+        expected = sum(int(scored_minutes // n.report_every)
+                       for n in self.nodes.values() if not n.gateway)
+        self.result.duration_ms = self.duration_ms
+        self.result.generated = max(expected, len(self.counted_uids))
+        self.result.delivered = len(self.delivered_uids & set(self.counted_uids))
+
+        counters = SimCounters()
+        for node in self.nodes.values():
+            node.fw.sim_counters(ctypes.byref(counters))
+            self.result.queue_drops += counters.queueOverflows
+            self.result.rate_limited += counters.rateLimited
+            self.result.beacon_slot_misses += counters.beaconSlotMisses
+            self.result.route_losses += counters.routeExpirations
+        return self.result
+
+    def _firmware(self, node: SimNode) -> ctypes.CDLL:
+        """The node's library with millis() at the current time"""
+        node.fw.sim_set_time(int(self.now))
+        return node.fw
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # Radio channel
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def _link_budgets(self) -> Dict[Tuple[int, int], float]:
+        loss = {}
+        ids = sorted(self.nodes)
+        positions = {n.node_id: (n.x, n.y) for n in self.site.nodes}
+        for i, a in enumerate(ids):
+            for b in ids[i + 1:]:
+                if (a, b) in self.site.link_loss:
+                    value = self.site.link_loss[(a, b)]
+                else:
+                    (xa, ya), (xb, yb) = positions[a], positions[b]
+                    meters = max(1.0, math.hypot(xa - xb, ya - yb))
+                    value = (self.radio['referenceLossDb'] +
+                             10.0 * self.radio['pathLossExponent'] * math.log10(meters) +
+                             self.rng.gauss(0.0, self.radio['shadowingDb']))
+                loss[(a, b)] = loss[(b, a)] = value
+        return loss
+
+    def transmit(self, node: SimNode, frame: Frame) -> float:
+        """Put a frame on the air now; returns when the radio is free again"""
+        airtime = self.report_airtime if frame.kind == 'report' else self.beacon_airtime
+        start, end = self.now, self.now + airtime
+        node.tx_until = end
+        node.tx_intervals.append((start, end))
+        self.result.airtime_ms += airtime
+        self.result.node_airtime_ms[node.id] += airtime
+
+        for other in self.nodes.values():
+            if other is node:
+                continue
+            loss = self.mean_loss[(node.id, other.id)]
+            if math.isinf(loss):
+                continue
+            rssi = self.radio['txPowerDbm'] - loss + self.rng.gauss(0.0, self.radio['fadingDb'])
+            if rssi < self.radio['sensitivityDbm'] - self.radio['captureDb']:
+                continue    # Too weak to matter, even as interference
+            arrival = Arrival(frame, start, end, rssi)
+            self.arrivals[other.id].append(arrival)
+            self.schedule(end, self._frame_end, other, arrival)
+        return end
+
+    def _frame_end(self, node: SimNode, arrival: Arrival):
+        arrivals = self.arrivals[node.id]
+        arrivals[:] = [a for a in arrivals if a.end > self.now - 2000.0]
+
+        if arrival.rssi < self.radio['sensitivityDbm']:
+            return
+        # Half duplex: lost if we transmitted during any part of it
+        for tx_start, tx_end in node.tx_intervals:
+            if tx_start < arrival.end and tx_end > arrival.start:
+                return
+        # Capture effect: every overlapping frame must be captureDb weaker
+        for other in arrivals:
+            if other is arrival or other.end <= arrival.start or other.start >= arrival.end:
+                continue
+            if arrival.rssi - other.rssi < self.radio['captureDb']:
+                self.result.collisions += 1
+                return
+
+        if arrival.frame.kind == 'beacon':
+            self._receive_beacon(node, arrival.frame, arrival.rssi)
+        else:
+            self._receive_report(node, arrival.frame, arrival.rssi)
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # Beacons (main.cpp sendGatewayBeacon / sendPendingBeacon)
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def _gateway_beacon(self, gw: SimNode, subframe: bool):
+        if self.now < gw.tx_until:
+            self.schedule(gw.tx_until + 1.0, self._gateway_beacon, gw, subframe)
+            return
+        second = 0 if subframe else int(self.now // 1000.0) % 60
+        frame = Frame('beacon', gw.id, gw.id, gw.beacon_seq & 0xFF, int(self.p['MESH_MAX_HOPS']),
+                      ADDR_BROADCAST, gateway_id=gw.id, sequence=gw.beacon_seq, distance=0,
+                      gps_valid=True, gps_second=second)
+        gw.beacon_seq += 1
+        self.result.beacons += 1
+        self.transmit(gw, frame)
+
+    def _gateway_subframe_beacon(self, gw: SimNode):
+        self._gateway_beacon(gw, True)
+        self.schedule(self.now - self.now % 60000.0 + 60000.0, self._gateway_subframe_beacon, gw)
+
+    def _gateway_interval_beacon(self, gw: SimNode):
+        self._gateway_beacon(gw, False)
+        self.schedule(self.now + self.p['BEACON_INTERVAL_MS'], self._gateway_interval_beacon, gw)
+
+    def _receive_beacon(self, node: SimNode, beacon: Frame, rssi: float):
+        result = self._firmware(node).sim_receive(ctypes.byref(beacon.to_c()), int(round(rssi)))
+        if result == SIM_RX_DROPPED:
+            return
+
+        # Network time from a fresh beacon
+        if result == SIM_RX_BEACON_FRESH and beacon.gps_valid and not node.synced:
+            node.synced = True
+            node.clock_offset_ms = self.rng.gauss(0.0, self.site.clock_jitter_ms)
+            self._start_ticks(node, self.now)
+
+        self._plan_beacon_relay(node)
+
+    def _plan_beacon_relay(self, node: SimNode):
+        """Queue an event for the earliest relay the firmware has pending"""
+        due = self._firmware(node).sim_next_beacon_ms(self.beacon_horizon_ms)
+        if due == SIM_NO_BEACON or due == node.beacon_due:
+            return
+        node.beacon_due = due
+        self.schedule(max(float(due), self.now), self._send_pending_beacon, node, due)
+
+    def _send_pending_beacon(self, node: SimNode, due: int):
+        if node.beacon_due != due:
+            return      # An earlier relay took this event's place
+        if self.now < node.tx_until:
+            # Loop is blocked in a slot transmission; polled again when it returns
+            self.schedule(node.tx_until + 1.0, self._send_pending_beacon, node, due)
+            return
+        node.beacon_due = None
+        relay = SimFrame()
+        if self._firmware(node).sim_take_beacon(ctypes.byref(relay)):
+            self.result.beacons += 1
+            self.transmit(node, Frame.from_c(relay))
+        self._plan_beacon_relay(node)
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # Reports (packet_handler.cpp receive path in host/sim_node.cpp)
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def _receive_report(self, node: SimNode, frame: Frame, rssi: float):
+        result = self._firmware(node).sim_receive(ctypes.byref(frame.to_c()), int(round(rssi)))
+        if result == SIM_RX_DROPPED:
+            return
+
+        if node.gateway and not self.nodes[frame.source].gateway:
+            if frame.uid not in self.delivered_uids:
+                self.delivered_uids.add(frame.uid)
+                if frame.uid in self.counted_uids:
+                    self.result.latencies.append(self.now - self.counted_uids[frame.uid])
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # TDMA (main.cpp loop, transmit + transmitQueuedForwards)
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def _local_ms(self, node: SimNode, at_ms: float) -> float:
+        return at_ms + node.clock_offset_ms
+
+    def _local_second(self, node: SimNode, at_ms: float) -> int:
+        return int(self._local_ms(node, at_ms) // 1000.0) % 60
+
+    def _start_ticks(self, node: SimNode, from_ms: float):
+        local = self._local_ms(node, from_ms)
+        next_tick = (math.floor(local / 1000.0) + 1) * 1000.0 - node.clock_offset_ms
+        self.schedule(next_tick, self._tick, node)
+
+    def _tick(self, node: SimNode):
+        self.schedule(self.now + 1000.0, self._tick, node)
+        second = self._local_second(node, self.now + 1.0)
+        minute = int(self._local_ms(node, self.now + 1.0) // 60000.0) % 60
+
+        slot_end = ctypes.c_uint8()
+        if not self._firmware(node).sim_tick(minute, second, ctypes.byref(slot_end)):
+            return
+        node.minutes += 1
+        # A beacon relay still on the air delays the slot, like the blocking loop
+        self.schedule(max(self.now, node.tx_until), self._slot_transmit, node, slot_end.value)
+
+    def _slot_transmit(self, node: SimNode, slot_end: int):
+        at = self.now
+        if node.minutes % node.report_every == 0:
+            report = SimFrame()
+            self._firmware(node).sim_own_report(ctypes.byref(report), self.next_uid)
+            frame = Frame.from_c(report)
+            self.next_uid += 1
+            if not node.gateway and self.warmup_ms <= self.now <= self.duration_ms - 120000.0:
+                self.counted_uids[frame.uid] = self.now
+            at = self.transmit(node, frame) + PRIMARY_TX_PAUSE_MS
+        self.schedule(at, self._send_forwards, node, slot_end, 0)
+
+    def _send_forwards(self, node: SimNode, slot_end: int, sent: int):
+        safe_end = max(slot_end - 1, 0)
+        if sent >= self.p['MAX_FORWARDS_PER_SLOT']:
+            return
+        if self._local_second(node, self.now) >= safe_end:
+            return
+        queued = SimFrame()
+        if not self._firmware(node).sim_take_forward(ctypes.byref(queued)):
+            return
+        self.result.forwards += 1
+        done = self.transmit(node, Frame.from_c(queued))
+        self.schedule(done + FORWARD_GAP_MS, self._send_forwards, node, slot_end, sent + 1)
+
+
+# ╔═══════════════════════════════════════════════════════════════════════════╗
+# ║                         RUNNING CONFIGURATIONS                            ║
+# ╚═══════════════════════════════════════════════════════════════════════════╝
+
+def evaluate(site: Site, params: Dict[str, object], seeds: List[int],
+             hours: float) -> Dict[str, float]:
+    """Run one configuration on several seeds and average the metrics"""
+    runs = []
+    for seed in seeds:
+        sim = MeshSimulator(site, params, seed, hours * 3600000.0)
+        runs.append(sim.run().metrics())
+    averaged = {key: statistics.fmean(r[key] for r in runs) for key in runs[0]}
+    for key in ('delivery', 'latencyP95Sec', 'airtimePct'):
+        averaged[key + 'Std'] = statistics.pstdev(r[key] for r in runs)
+    return averaged
+
+
+def parse_overrides(items: List[str], defaults: Dict[str, object]) -> Dict[str, object]:
+    params = dict(defaults)
+    for item in items:
+        name, _, value = item.partition('=')
+        if name not in params:
+            raise SystemExit(f'Unknown parameter {name}')
+        params[name] = _parse_value(value)
+    return params
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Simulate one mesh configuration on a site')
+    parser.add_argument('site', nargs='?', help='Site description (JSON)')
+    parser.add_argument('--set', action='append', default=[], metavar='NAME=VALUE',
+                        help='Override a firmware parameter (repeatable)')
+    parser.add_argument('--hours', type=float, default=2.0, help='Simulated time per run')
+    parser.add_argument('--seeds', type=int, default=3, help='Runs to average')
+    parser.add_argument('--check-model', action='store_true',
+                        help='Fail if firmware functions the glue follows changed')
+    parser.add_argument('--accept-model', action='store_true',
+                        help='Record the tree after updating host/sim_node.cpp and this file')
+    args = parser.parse_args()
+
+    if args.accept_model:
+        accept_model_sources()
+        return 0
+    stale = stale_model_sources()
+    if args.check_model:
+        for entry in stale:
+            print(f'Model out of date: {entry} changed')
+        return 1 if stale else 0
+    if args.site is None:
+        parser.error('site is required')
+    if stale:
+        print(f"Warning: firmware changed under the model ({', '.join(stale)}); "
+              f"see 'make check'", file=sys.stderr)
+
+    defaults = read_firmware_defaults()
+    params = parse_overrides(args.set, defaults)
+    site = load_site(Path(args.site), int(defaults['MAX_NODES']))
+
+    header = int(defaults['LORA_HEADER_SIZE'])
+    print(f"Site {site.name}: {len(site.nodes)} nodes, report airtime "
+          f"{lora_airtime_ms(header + REPORT_MESSAGE_BYTES, site.radio):.1f} ms")
+    for p in PARAMETERS:
+        marker = '*' if params[p.name] != defaults[p.name] else ' '
+        print(f"  {marker} {p.name:28} {params[p.name]}")
+
+    metrics = evaluate(site, params, list(range(1, args.seeds + 1)), args.hours)
+    print()
+    for key, value in metrics.items():
+        print(f"  {key:20} {value:.4g}")
+
+
+if __name__ == '__main__':
+    sys.exit(main())
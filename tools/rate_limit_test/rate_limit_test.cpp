@@ -0,0 +1,199 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         RATE LIMITER HOST TEST                            ║
+// ║  Same limiter as the firmware (src/rate_limiter.cpp), on a fake clock     ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   rate_limit_test [--frames 2000000]
+//
+// 1. Budgets: burst, refill and per-class independence of one node.
+// 2. Capacity: a full node table (NODE_TABLE_MAX_LIVE nodes) sending every
+//    class keeps one entry per node, none reused, every budget its own.
+// 3. Eviction under load: a babbling node stays over budget while a flood
+//    of new source IDs cycles through the entries; an over-budget entry is
+//    only reused when every entry is over budget.
+// 4. Cost: allow() time per frame with every entry in use, on this machine.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "host_test.h"
+#include "rate_limiter.h"
+#include "metrics.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HOST RUNTIME
+// ═══════════════════════════════════════════════════════════════════════════
+
+static unsigned long nowMs = 1000;
+static uint32_t limitedByNode[256];
+
+Print Serial;
+
+unsigned long millis() {
+    return nowMs;
+}
+
+void metricIncLabel(MetricFamily, uint8_t label) {
+    limitedByNode[label]++;
+}
+
+// Frames of one class a node gets through, sent back to back
+static unsigned sendBurst(RateLimiter& limiter, uint8_t nodeId, RateClass rateClass, unsigned frames) {
+    unsigned passed = 0;
+    for (unsigned i = 0; i < frames; i++) {
+        if (limiter.allow(nodeId, rateClass)) passed++;
+    }
+    return passed;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BUDGETS
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void testBudgets() {
+    printf("\n[1] Budgets\n");
+    RateLimiter limiter;
+
+    unsigned burst = sendBurst(limiter, 7, RATE_RX_REPORT, 10);
+    CHECK(burst == RATE_REPORT_BURST, "report burst %u, expected %u", burst, RATE_REPORT_BURST);
+
+    // Other classes of the same node are untouched
+    unsigned forwards = sendBurst(limiter, 7, RATE_FORWARD, 10);
+    CHECK(forwards == RATE_FORWARD_BURST, "forward burst %u next to a drained report budget", forwards);
+
+    // One report token per 60000 / RATE_REPORT_PER_MIN ms
+    nowMs += 60000 / RATE_REPORT_PER_MIN - 1;
+    CHECK(!limiter.allow(7, RATE_RX_REPORT), "refilled a token early");
+    nowMs += 1;
+    CHECK(limiter.allow(7, RATE_RX_REPORT), "no token after 60000 / perMinute ms");
+
+    // A long idle gap fills to the burst, not beyond
+    nowMs += 3600000;
+    burst = sendBurst(limiter, 7, RATE_RX_REPORT, 10);
+    CHECK(burst == RATE_REPORT_BURST, "burst %u after an hour idle", burst);
+
+    CHECK(sendBurst(limiter, 7, RATE_RX_LOAD, 1000) == 1000, "load frames must not be limited");
+    printf("  report burst %u, refill %u ms per frame, classes independent\n",
+           RATE_REPORT_BURST, 60000 / RATE_REPORT_PER_MIN);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CAPACITY
+// ═══════════════════════════════════════════════════════════════════════════
+
+static const RateClass LIMITED_CLASSES[] = {
+    RATE_RX_REPORT, RATE_RX_BEACON, RATE_RX_CLAIM, RATE_RX_OTHER, RATE_FORWARD
+};
+
+static void testCapacity() {
+    printf("\n[2] Capacity: %u nodes x every class\n", RATE_LIMIT_NODES);
+    RateLimiter limiter;
+
+    // Every node drains every class
+    for (uint8_t id = 1; id <= RATE_LIMIT_NODES; id++) {
+        for (RateClass c : LIMITED_CLASSES) {
+            sendBurst(limiter, id, c, limiter.getLimit(c).burst);
+        }
+    }
+    RateLimiterStats stats = limiter.getStats();
+    CHECK(limiter.trackedNodes() == RATE_LIMIT_NODES, "%u nodes tracked", limiter.trackedNodes());
+    CHECK(stats.evictions == 0, "%lu entries reused with room for every node", (unsigned long)stats.evictions);
+
+    // Each budget is still drained: nothing was forgotten and refilled
+    unsigned leaked = 0;
+    for (uint8_t id = 1; id <= RATE_LIMIT_NODES; id++) {
+        for (RateClass c : LIMITED_CLASSES) {
+            if (limiter.allow(id, c)) leaked++;
+        }
+    }
+    CHECK(leaked == 0, "%u frames passed a drained budget", leaked);
+    printf("  %u nodes tracked, %lu reused, %u frames past a drained budget\n",
+           limiter.trackedNodes(), (unsigned long)limiter.getStats().evictions, leaked);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EVICTION UNDER LOAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void testEviction() {
+    printf("\n[3] Eviction under load\n");
+    RateLimiter limiter;
+    memset(limitedByNode, 0, sizeof(limitedByNode));
+
+    // Node 7 babbles; 250 spoofed source IDs (1 frame each) cycle through
+    // the remaining entries several times while it keeps sending
+    const uint8_t babbler = 7;
+    unsigned babblerPassed = sendBurst(limiter, babbler, RATE_RX_REPORT, 20);
+    unsigned floodFrames = 0;
+    for (unsigned round = 0; round < 4; round++) {
+        for (unsigned id = 1; id <= 254; id++) {
+            if (id == babbler) continue;
+            limiter.allow((uint8_t)id, RATE_RX_REPORT);
+            floodFrames++;
+        }
+        nowMs += 100;
+        babblerPassed += sendBurst(limiter, babbler, RATE_RX_REPORT, 20);
+    }
+    RateLimiterStats stats = limiter.getStats();
+    CHECK(babblerPassed == RATE_REPORT_BURST, "babbler got %u reports through the flood, budget %u",
+          babblerPassed, RATE_REPORT_BURST);
+    CHECK(stats.evictions > 0, "the flood should reuse entries");
+    CHECK(stats.limitedEvictions == 0, "%lu over-budget entries reused while others were within budget",
+          (unsigned long)stats.limitedEvictions);
+    CHECK(limitedByNode[babbler] == 100 - RATE_REPORT_BURST, "babbler drops %u", limitedByNode[babbler]);
+    printf("  %u flood frames, %lu entries reused, babbler %u/100 passed, %lu over-budget reused\n",
+           floodFrames, (unsigned long)stats.evictions, babblerPassed, (unsigned long)stats.limitedEvictions);
+
+    // Every entry over budget: the least recently used one has to go
+    RateLimiter full;
+    for (unsigned id = 1; id <= RATE_LIMIT_NODES; id++) {
+        sendBurst(full, (uint8_t)id, RATE_RX_REPORT, RATE_REPORT_BURST + 1);
+        nowMs += 1;
+    }
+    full.allow(RATE_LIMIT_NODES + 1, RATE_RX_REPORT);
+    stats = full.getStats();
+    CHECK(stats.evictions == 1 && stats.limitedEvictions == 1, "all over budget: %lu reused, %lu over budget",
+          (unsigned long)stats.evictions, (unsigned long)stats.limitedEvictions);
+
+    // The evicted one was node 1 (least recently used): it starts over
+    unsigned node1 = sendBurst(full, 1, RATE_RX_REPORT, 10);
+    unsigned node2 = sendBurst(full, 2, RATE_RX_REPORT, 10);
+    CHECK(node1 == RATE_REPORT_BURST && node2 == 0, "after eviction node 1 %u, node 2 %u", node1, node2);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COST
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void testCost(unsigned frames) {
+    printf("\n[4] Cost\n");
+    RateLimiter limiter;
+    for (uint8_t id = 1; id <= RATE_LIMIT_NODES; id++) limiter.allow(id, RATE_RX_REPORT);
+
+    unsigned passed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < frames; i++) {
+        nowMs += 1;
+        if (limiter.allow((uint8_t)(1 + (i * 37) % RATE_LIMIT_NODES), RATE_RX_REPORT)) passed++;
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("  allow(), %u entries in use   %6.1f ns/frame here (%u of %u passed)\n",
+           RATE_LIMIT_NODES, sec * 1e9 / frames, passed, frames);
+    CHECK(limiter.trackedNodes() == RATE_LIMIT_NODES, "cost run tracked %u", limiter.trackedNodes());
+}
+
+int main(int argc, char** argv) {
+    unsigned frames = 2000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--frames") == 0) frames = (unsigned)atoi(argv[i + 1]);
+    }
+
+    testBudgets();
+    testCapacity();
+    testEviction();
+    testCost(frames);
+
+    return checkSummary();
+}
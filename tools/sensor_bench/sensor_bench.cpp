@@ -0,0 +1,246 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SENSOR MATH HOST TEST                             ║
+// ║  Same code as the firmware (src/sensor_math.cpp), checked and timed       ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   sensor_bench [--samples 2000000]
+//
+// 1. Datasheet vectors: BMP180 worked example (3.5), SHT30 CRC (4.12).
+// 2. Accuracy over the full sensor range against a double-precision
+//    curve, for both the fixed-point code and the float code it replaced:
+//    every SHT30 raw count, BMP180 -40..85 °C, 300-1100 hPa against
+//    950-1050 hPa sea level, sea-level calibration from -500 m to 10 km.
+// 3. Time per sample, float vs fixed-point (cycles on x86 via the TSC).
+//    'mesh bench sensors' prints the same rows in ESP32 cycles.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#include "host_test.h"
+#include "sensor_math.h"
+
+// Exact curves the firmware approximates
+static double altitudeTruthM(double p, double p0) {
+    return 44330.0 * (1.0 - pow(p / p0, 1.0 / 5.255));
+}
+
+static double seaLevelTruthPa(double p, double h) {
+    return p / pow(1.0 - h / 44330.0, 5.255);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DATASHEET VECTORS
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void testDatasheet() {
+    printf("\n[1] Datasheet vectors\n");
+
+    // BMP180 datasheet 3.5, oss = 0
+    Bmp180Calibration cal = { 408, -72, -14383, 32741, 32757, 23153, 6190, 4, -32768, -8711, 2868 };
+    int32_t b5 = bmp180ComputeB5(cal, 27898);
+    int16_t t = bmp180TemperatureC_x10(b5);
+    int32_t p = bmp180PressurePa(cal, b5, 23843, 0);
+    CHECK(t == 150, "BMP180 T = %d, datasheet 150", t);
+    CHECK(p == 69964, "BMP180 p = %d, datasheet 69964", p);
+    printf("  BMP180 example        T = %d (0.1 °C)  p = %d Pa\n", t, p);
+
+    // SHT3x datasheet 4.12: CRC(0xBEEF) = 0x92
+    const uint8_t word[2] = { 0xBE, 0xEF };
+    uint8_t crc = sht30Crc8(word, 2);
+    CHECK(crc == 0x92, "SHT30 CRC 0x%02X, datasheet 0x92", crc);
+    printf("  SHT30 CRC(0xBEEF)     0x%02X\n", crc);
+
+    // Scale ends
+    CHECK(sht30TemperatureF_x10(0) == -490 && sht30TemperatureF_x10(65535) == 2660, "SHT30 °F ends");
+    CHECK(sht30Humidity_x10(0) == 0 && sht30Humidity_x10(65535) == 1000, "SHT30 RH ends");
+    CHECK(baroAltitudeMm(101325, 101325) == 0, "altitude at p0");
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ACCURACY
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void testAccuracy() {
+    printf("\n[2] Accuracy vs double-precision curve (max |error|)\n");
+    printf("  %-34s %14s %14s\n", "", "fixed-point", "old float");
+
+    // SHT30, every raw count, in wire LSB (0.1 °F, 0.1 %RH)
+    double fixT = 0, fltT = 0, fixH = 0, fltH = 0;
+    for (uint32_t raw = 0; raw <= 65535; raw++) {
+        double tTruth = (-49.0 + 315.0 * raw / 65535.0) * 10.0;
+        double hTruth = 100.0 * raw / 65535.0 * 10.0;
+        fixT = fmax(fixT, fabs(sht30TemperatureF_x10((uint16_t)raw) - tTruth));
+        fltT = fmax(fltT, fabs((int16_t)(sht30TemperatureFRef((uint16_t)raw) * 10.0f) - tTruth));
+        fixH = fmax(fixH, fabs(sht30Humidity_x10((uint16_t)raw) - hTruth));
+        fltH = fmax(fltH, fabs((uint16_t)(sht30HumidityRef((uint16_t)raw) * 10.0f) - hTruth));
+    }
+    printf("  %-34s %10.3f LSB %10.3f LSB\n", "SHT30 temperature (0.1 °F)", fixT, fltT);
+    printf("  %-34s %10.3f LSB %10.3f LSB\n", "SHT30 humidity (0.1 %RH)", fixH, fltH);
+    CHECK(fixT <= 0.5001 && fixH <= 0.5001, "SHT30 fixed-point must round to nearest");
+
+    // BMP180 temperature to wire °F, -40..85 °C
+    double fixC = 0, fltC = 0;
+    for (int c10 = -400; c10 <= 850; c10++) {
+        double truth = (c10 / 10.0 * 1.8 + 32.0) * 10.0;
+        fixC = fmax(fixC, fabs(celsiusToFahrenheit_x10((int16_t)c10) - truth));
+        fltC = fmax(fltC, fabs((int16_t)(((c10 / 10.0f) * 1.8f + 32.0f) * 10.0f) - truth));
+    }
+    printf("  %-34s %10.3f LSB %10.3f LSB\n", "BMP180 °C -> 0.1 °F", fixC, fltC);
+    CHECK(fixC <= 0.5001, "°C -> °F must round to nearest");
+
+    // Pressure to wire hPa
+    double fixP = 0, fltP = 0;
+    for (int32_t p = 30000; p <= 110000; p++) {
+        fixP = fmax(fixP, fabs(pressureToHpa(p) - p / 100.0));
+        fltP = fmax(fltP, fabs((uint16_t)(p / 100.0f) - p / 100.0));
+    }
+    printf("  %-34s %10.3f hPa %10.3f hPa\n", "Pressure -> hPa", fixP, fltP);
+
+    // Altitude, 300-1100 hPa against p0 950-1050 hPa, every 2 Pa
+    double fixA = 0, fltA = 0, fixNear = 0;
+    uint32_t wireExact = 0, wireTotal = 0;
+    for (int32_t p0 = 95000; p0 <= 105000; p0 += 500) {
+        for (int32_t p = 30000; p <= 110000; p += 2) {
+            double truth = altitudeTruthM(p, p0);
+            double fixed = baroAltitudeMm(p, p0) / 1000.0;
+            double err = fabs(fixed - truth);
+            fixA = fmax(fixA, err);
+            if (truth > -500.0 && truth < 3000.0) fixNear = fmax(fixNear, err);
+            fltA = fmax(fltA, fabs(baroAltitudeRef((float)p, (float)p0) - truth));
+            wireExact += baroAltitudeM(p, p0) == (int16_t)lround(truth);
+            wireTotal++;
+        }
+    }
+    printf("  %-34s %12.3f m %12.3f m\n", "Altitude 300-1100 hPa", fixA, fltA);
+    printf("  %-34s %12.3f m\n", "  ... -500 m to 3 km", fixNear);
+    printf("  %-34s %11.2f %%\n", "  ... wire metres = rounded truth", 100.0 * wireExact / wireTotal);
+    CHECK(fixA < 0.2, "altitude error %.3f m over the sensor range", fixA);
+    CHECK(fixNear < 0.03, "altitude error %.3f m below 3 km", fixNear);
+
+    // Sea-level pressure from GPS height (the firmware accepts -500 m .. 10 km)
+    double fixS = 0, fltS = 0;
+    for (int32_t hDm = -5000; hDm <= 100000; hDm += 3) {
+        double h = hDm / 10.0;
+        for (int32_t p = 30000; p <= 110000; p += 10000) {
+            double truth = seaLevelTruthPa(p, h);
+            if (truth < 90000.0 || truth > 110000.0) continue;      // Not a reading at this height
+            fixS = fmax(fixS, fabs(baroSeaLevelPa(p, hDm * 100) - truth));
+            fltS = fmax(fltS, fabs(baroSeaLevelRef((float)p, (float)h) - truth));
+        }
+    }
+    printf("  %-34s %11.2f Pa %11.2f Pa\n", "Sea-level p0, -500 m to 10 km", fixS, fltS);
+    CHECK(fixS < 5.0, "sea-level error %.2f Pa", fixS);
+
+    // Sea-level calibration average against a double EMA: a 15 Pa gap (the
+    // integer-Pa average never moved) and a 1000 Pa step, 200 samples each
+    double fixE = 0, oldE = 0;
+    const int32_t starts[] = { 101325, 101325 };
+    const int32_t targets[] = { 101340, 100325 };
+    for (int i = 0; i < 2; i++) {
+        int32_t q8 = baroSeaLevelToQ8(starts[i]);
+        int32_t old = starts[i];
+        double truth = starts[i];
+        for (int n = 0; n < 200; n++) {
+            q8 = baroSeaLevelEmaQ8(q8, targets[i]);
+            old += (targets[i] - old) / BARO_SEA_LEVEL_EMA_DIV;
+            truth += (targets[i] - truth) / BARO_SEA_LEVEL_EMA_DIV;
+            fixE = fmax(fixE, fabs(q8 / 256.0 - truth));
+        }
+        fixE = fmax(fixE, fabs(baroSeaLevelFromQ8(q8) - truth));
+        oldE = fmax(oldE, fabs(old - truth));
+    }
+    printf("  %-34s %11.2f Pa %11.2f Pa\n", "Sea-level EMA 1/20 (old: whole Pa)", fixE, oldE);
+    CHECK(fixE < 0.51, "sea-level average error %.2f Pa", fixE);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TIMING
+// ═══════════════════════════════════════════════════════════════════════════
+
+static volatile int64_t sink;
+
+struct Timing {
+    double nsPerSample;
+    double cyclesPerSample;
+};
+
+template <typename F>
+static Timing timeLoop(unsigned samples, F body) {
+    int64_t acc = 0;
+#ifdef HAVE_TSC
+    uint64_t tsc = __rdtsc();
+#endif
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < samples; i++) acc += body(i);
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Timing t;
+#ifdef HAVE_TSC
+    t.cyclesPerSample = (double)(__rdtsc() - tsc) / samples;
+#else
+    t.cyclesPerSample = 0;
+#endif
+    t.nsPerSample = sec * 1e9 / samples;
+    sink = acc;
+    return t;
+}
+
+static void printRow(const char* name, Timing flt, Timing fix) {
+    printf("  %-26s %7.1f ns %7.1f cyc   %7.1f ns %7.1f cyc   %5.1fx\n", name,
+           flt.nsPerSample, flt.cyclesPerSample, fix.nsPerSample, fix.cyclesPerSample,
+           fix.nsPerSample > 0 ? flt.nsPerSample / fix.nsPerSample : 0.0);
+}
+
+static void testTiming(unsigned samples) {
+    printf("\n[3] Time per sample (%u samples)\n", samples);
+    printf("  %-26s %22s   %22s\n", "", "float", "fixed-point");
+
+    Timing flt = timeLoop(samples, [](unsigned i) {
+        uint16_t raw = (uint16_t)(i * 65);
+        return (int)(int16_t)(sht30TemperatureFRef(raw) * 10.0f) + (uint16_t)(sht30HumidityRef(raw) * 10.0f);
+    });
+    Timing fix = timeLoop(samples, [](unsigned i) {
+        uint16_t raw = (uint16_t)(i * 65);
+        return sht30TemperatureF_x10(raw) + sht30Humidity_x10(raw);
+    });
+    printRow("SHT30 temp + RH", flt, fix);
+
+    flt = timeLoop(samples, [](unsigned i) {
+        return (int)(int16_t)baroAltitudeRef(30000.0f + (i % 1000) * 80.0f, 101325.0f);
+    });
+    fix = timeLoop(samples, [](unsigned i) {
+        return (int)baroAltitudeM(30000 + (i % 1000) * 80, 101325);
+    });
+    printRow("Altitude (powf vs table)", flt, fix);
+
+    flt = timeLoop(samples, [](unsigned i) {
+        return (int)baroSeaLevelRef(100000.0f - (i % 1000) * 60.0f, -500.0f + (i % 1000) * 10.5f);
+    });
+    fix = timeLoop(samples, [](unsigned i) {
+        return (int)baroSeaLevelPa(100000 - (i % 1000) * 60, -500000 + (i % 1000) * 10500);
+    });
+    printRow("Sea-level p0 (GPS height)", flt, fix);
+#ifndef HAVE_TSC
+    printf("  (no cycle counter on this CPU)\n");
+#endif
+}
+
+int main(int argc, char** argv) {
+    unsigned samples = 2000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--samples") == 0) samples = (unsigned)atoi(argv[i + 1]);
+    }
+
+    testDatasheet();
+    testAccuracy();
+    testTiming(samples);
+
+    return checkSummary();
+}
@@ -0,0 +1,197 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         SNAPSHOT LATCH STRESS TEST                        ║
+// ║  Same latch as the node store (include/snapshot_latch.h), on threads      ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   snapshot_stress [--readers 4] [--ms 3000]
+//
+// One writer thread publishes rounds of a test pattern into a latch of
+// NODES entries; every field of round k is derived from k and each round
+// publishes the entries in order. Reader threads take views of all entries
+// and check that each one could have existed: every entry intact, some at
+// round k and the rest still at k - 1.
+//
+// 1. read() views: torn views must stay 0.
+// 2. beginRead() / retryRead() probe of one entry, as readNodeSnapshot()
+//    does: torn entries must stay 0.
+// 3. Control: the same check on copy 0 without the sequence check. It
+//    should find torn views, which shows the test can see them.
+//
+// 'mesh bench snapshot' runs the same check on the ESP32's two cores.
+// 'make tsan' builds with ThreadSanitizer.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "host_test.h"
+#include "snapshot_latch.h"
+
+static const uint16_t NODES = 8;
+
+// Roughly a NodeSnapshot: a key, counters and a report-sized payload
+struct TestSnapshot {
+    uint8_t  nodeId;
+    uint8_t  pad[3];
+    uint32_t round;
+    uint32_t inverse;
+    uint32_t payload[20];
+};
+
+typedef SnapshotLatch<TestSnapshot, NODES> TestLatch;
+
+static void fillSnapshot(TestSnapshot& snapshot, uint16_t index, uint32_t k) {
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.nodeId = (uint8_t)(index + 1);
+    snapshot.round = k;
+    snapshot.inverse = ~k;
+    for (uint8_t i = 0; i < 20; i++) {
+        snapshot.payload[i] = k * 2654435761u + i;
+    }
+}
+
+static bool snapshotValid(const TestSnapshot& snapshot, uint16_t index) {
+    uint32_t k = snapshot.round;
+    if (snapshot.nodeId != index + 1 || snapshot.inverse != ~k) return false;
+    for (uint8_t i = 0; i < 20; i++) {
+        if (snapshot.payload[i] != k * 2654435761u + i) return false;
+    }
+    return true;
+}
+
+// Entries are published in order, so a real state is k...k, k-1...k-1
+static bool viewValid(const TestSnapshot* view) {
+    uint32_t first = view[0].round;
+    bool behind = false;
+
+    for (uint16_t i = 0; i < NODES; i++) {
+        if (!snapshotValid(view[i], i)) return false;
+        uint32_t k = view[i].round;
+        if (k == first && !behind) continue;
+        if (k != first - 1) return false;
+        behind = true;
+    }
+    return true;
+}
+
+struct ReaderStats {
+    uint64_t views = 0;
+    uint64_t retries = 0;
+    uint64_t torn = 0;
+    uint64_t probes = 0;
+    uint64_t tornProbes = 0;
+    uint64_t unlatchedViews = 0;
+    uint64_t tornUnlatched = 0;
+};
+
+static void reader(const TestLatch& latch, const std::atomic<bool>& running, ReaderStats& stats) {
+    TestSnapshot view[NODES];
+    uint16_t probeIndex = 0;
+
+    while (running.load(std::memory_order_relaxed)) {
+        // 1. Whole view
+        stats.retries += latch.read(0, NODES, view);
+        if (!viewValid(view)) stats.torn++;
+        stats.views++;
+
+        // 2. One entry, key first (readNodeSnapshot)
+        TestSnapshot one = TestSnapshot();
+        while (true) {
+            uint32_t sequence = latch.beginRead();
+            uint32_t key = latch.loadWord(sequence & 1, probeIndex, 0);
+            if ((key & 0xFF) == probeIndex + 1u) latch.load(sequence & 1, probeIndex, one);
+            if (!latch.retryRead(sequence)) break;
+            stats.retries++;
+        }
+        if (!snapshotValid(one, probeIndex)) stats.tornProbes++;
+        stats.probes++;
+        probeIndex = (probeIndex + 1) % NODES;
+
+        // 3. Control: no sequence check
+        for (uint16_t i = 0; i < NODES; i++) {
+            latch.load(0, i, view[i]);
+        }
+        if (!viewValid(view)) stats.tornUnlatched++;
+        stats.unlatchedViews++;
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned readers = 4;
+    unsigned durationMs = 3000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--readers") == 0) readers = (unsigned)atoi(argv[i + 1]);
+        if (strcmp(argv[i], "--ms") == 0) durationMs = (unsigned)atoi(argv[i + 1]);
+    }
+    if (readers == 0) readers = 1;
+
+    TestLatch* latch = new TestLatch();
+    latch->reset();
+
+    TestSnapshot snapshot;
+    uint32_t k = 1;
+    for (uint16_t i = 0; i < NODES; i++) {
+        fillSnapshot(snapshot, i, k);
+        latch->publish(i, snapshot);
+    }
+
+    printf("\nSnapshot latch: %u entries of %zu bytes, 1 writer, %u readers, %u ms (%u hardware threads)\n",
+           NODES, sizeof(TestSnapshot), readers, durationMs, std::thread::hardware_concurrency());
+
+    std::atomic<bool> running(true);
+    std::vector<ReaderStats> stats(readers);
+    std::vector<std::thread> threads;
+    for (unsigned r = 0; r < readers; r++) {
+        threads.emplace_back(reader, std::cref(*latch), std::cref(running), std::ref(stats[r]));
+    }
+
+    uint64_t publishes = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(durationMs);
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (unsigned burst = 0; burst < 64; burst++) {
+            k++;
+            for (uint16_t i = 0; i < NODES; i++) {
+                fillSnapshot(snapshot, i, k);
+                latch->publish(i, snapshot);
+            }
+            publishes += NODES;
+        }
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    running.store(false);
+    for (std::thread& t : threads) t.join();
+
+    ReaderStats total;
+    for (const ReaderStats& s : stats) {
+        total.views += s.views;
+        total.retries += s.retries;
+        total.torn += s.torn;
+        total.probes += s.probes;
+        total.tornProbes += s.tornProbes;
+        total.unlatchedViews += s.unlatchedViews;
+        total.tornUnlatched += s.tornUnlatched;
+    }
+
+    printf("  Publishes:          %llu (%.1f ns each)\n", (unsigned long long)publishes,
+           publishes ? sec * 1e9 / publishes : 0.0);
+    printf("  [1] Views read:     %llu (%llu retries), torn %llu\n", (unsigned long long)total.views,
+           (unsigned long long)total.retries, (unsigned long long)total.torn);
+    printf("  [2] Entry probes:   %llu, torn %llu\n", (unsigned long long)total.probes,
+           (unsigned long long)total.tornProbes);
+    printf("  [3] Unlatched:      %llu views, torn %llu (control, expected > 0 on a multi-core host)\n",
+           (unsigned long long)total.unlatchedViews, (unsigned long long)total.tornUnlatched);
+
+    CHECK(total.views > 0 && total.probes > 0, "readers made no progress");
+    CHECK(total.torn == 0, "%llu torn views through read()", (unsigned long long)total.torn);
+    CHECK(total.tornProbes == 0, "%llu torn entries through beginRead()/retryRead()",
+          (unsigned long long)total.tornProbes);
+
+    delete latch;
+    return checkSummary();
+}
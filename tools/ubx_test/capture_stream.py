@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""
+GPS Capture to Stream File
+==========================
+Turns the Serial log of a GPS_CAPTURE_MS build (include/neo6m.h) into a
+streams/ file that ubx_test replays.
+
+- GPSRX lines (bytes from the receiver) become the stream: NMEA sentences as
+  '$' lines, UBX frames and anything else as hex lines
+- GPSTX lines (CFG frames the driver sent on GPS_TX_PIN) become '# >'
+  comments at their place in the stream, so the CFG-MSG switch can be read
+  against the receiver's answers
+- Bytes before the first '$' or UBX sync are dropped (the capture started
+  mid-sentence); a gap of more than half a second starts a '# t=' comment
+
+Usage:
+    PLATFORMIO_BUILD_FLAGS="-D GPS_CAPTURE_MS=30000" pio run -t upload
+    pio device monitor -b 115200 | tee boot.log  # reset the node, wait 30 s
+    python capture_stream.py boot.log streams/capture_neo6m_switch.txt \\
+        --note "NEO-6M <firmware>, <board>, <date>"
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+LINE = re.compile(r'GPS(RX|TX) (\d+)((?: [0-9A-Fa-f]{2})+)\s*$')
+GAP_MS = 500
+
+
+def read_log(path: Path):
+    """(direction, millis, bytes) for every capture line in the log"""
+    records = []
+    for text in path.read_text(encoding='utf-8', errors='replace').splitlines():
+        match = LINE.search(text)
+        if match:
+            records.append((match.group(1), int(match.group(2)), bytes.fromhex(match.group(3))))
+    return records
+
+
+def split_stream(data: bytes):
+    """Cut receiver bytes into ('nmea', text) and ('hex', bytes) pieces, losslessly"""
+    pieces = []
+    i = 0
+    while i < len(data):
+        if data[i] == ord('$'):
+            end = data.find(b'\r\n', i)
+            if end != -1 and b'\xb5b' not in data[i:end]:
+                pieces.append(('nmea', data[i:end].decode('ascii', errors='replace')))
+                i = end + 2
+                continue
+        if data[i:i + 2] == b'\xb5b' and i + 6 <= len(data):
+            length = data[i + 4] | (data[i + 5] << 8)
+            end = min(len(data), i + 8 + length)
+            pieces.append(('hex', data[i:end]))
+            i = end
+            continue
+        # Stray bytes up to the next sentence or frame
+        end = i + 1
+        while end < len(data) and data[end] != ord('$') and data[end:end + 2] != b'\xb5b':
+            end += 1
+        pieces.append(('hex', data[i:end]))
+        i = end
+    return pieces
+
+
+def hex_line(data: bytes) -> str:
+    return ' '.join(f'{b:02X}' for b in data)
+
+
+def convert(records, note: str) -> str:
+    out = [f'# Captured: {note}' if note else '# Captured from hardware (GPS_CAPTURE_MS build)',
+           '# Converted by capture_stream.py: GPSRX bytes are the stream, GPSTX frames',
+           '# (sent to the receiver) are the "# >" comments']
+
+    started = False
+    last_ms = None
+    pending = bytearray()
+
+    def flush():
+        nonlocal pending
+        for kind, value in split_stream(bytes(pending)):
+            out.append(value if kind == 'nmea' else hex_line(value))
+        pending = bytearray()
+
+    for direction, ms, data in records:
+        if direction == 'TX':
+            flush()
+            out.append(f'# > {ms} ms: {hex_line(data)}')
+            continue
+        if not started:
+            sync = [p for p in (data.find(b'$'), data.find(b'\xb5b')) if p != -1]
+            if not sync:
+                continue
+            data = data[min(sync):]
+            started = True
+        if last_ms is not None and ms - last_ms > GAP_MS:
+            flush()
+            out.append(f'# t={ms} ms')
+        last_ms = ms
+        pending += data
+    flush()
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a GPS_CAPTURE_MS Serial log to a stream file')
+    parser.add_argument('log', help='Serial log with GPSRX/GPSTX lines')
+    parser.add_argument('stream', help='Stream file to write (streams/capture_*.txt)')
+    parser.add_argument('--note', default='', help='Receiver, firmware, wiring and date for the header')
+    args = parser.parse_args()
+
+    records = read_log(Path(args.log))
+    if not any(direction == 'RX' for direction, _, _ in records):
+        print(f'No GPSRX lines in {args.log} (was the firmware built with -D GPS_CAPTURE_MS?)',
+              file=sys.stderr)
+        return 1
+
+    Path(args.stream).write_text(convert(records, args.note))
+    rx = sum(len(data) for direction, _, data in records if direction == 'RX')
+    tx = sum(1 for direction, _, _ in records if direction == 'TX')
+    print(f'{args.stream}: {rx} bytes from the receiver, {tx} frames sent to it')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
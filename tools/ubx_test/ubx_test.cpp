@@ -0,0 +1,326 @@
+// ╔═══════════════════════════════════════════════════════════════════════════╗
+// ║                         UBX HOST TEST                                     ║
+// ║  Same codec as the firmware (src/ubx.cpp), checked against byte streams   ║
+// ╚═══════════════════════════════════════════════════════════════════════════╝
+//
+//   ubx_test [--streams streams] [--bytes 2000000]
+//
+// 1. Encoder: CFG frames byte for byte against frames from the u-blox
+//    protocol spec / u-center, and every builder back through the parser.
+// 2. Replay: each stream in streams/ fed one byte at a time, as the
+//    driver does. Frame and checksum-error counts, NMEA pass-through and
+//    the decoded NAV state must match what the stream holds. The three
+//    named streams are synthetic (written from the protocol spec); hardware
+//    captures made with capture_stream.py (streams/capture_*.txt) are
+//    replayed as well and must decode cleanly.
+// 3. Cost: UART bytes per second of the default NMEA set vs the UBX
+//    message set, and parser time per byte on this machine.
+//
+// Stream files: '#' comments, '$' lines are NMEA text (CRLF added), any
+// other line is hex bytes.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+
+#include "host_test.h"
+#include "ubx.h"
+
+struct Stream {
+    std::vector<uint8_t> bytes;
+    size_t nmeaBytes;           // '$' lines, CRLF included
+};
+
+static bool loadStream(const std::string& path, Stream& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    out.bytes.clear();
+    out.nmeaBytes = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        if (line[0] == '$') {
+            line += "\r\n";
+            out.bytes.insert(out.bytes.end(), line.begin(), line.end());
+            out.nmeaBytes += line.size();
+            continue;
+        }
+        std::istringstream hex(line);
+        std::string token;
+        while (hex >> token) out.bytes.push_back((uint8_t)strtoul(token.c_str(), nullptr, 16));
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENCODER
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void expectBytes(const char* name, const uint8_t* got, uint16_t len,
+                        const std::vector<uint8_t>& want) {
+    bool same = len == want.size() && memcmp(got, want.data(), len) == 0;
+    CHECK(same, "%s: %u bytes, expected %zu", name, len, want.size());
+    if (same) printf("  %-28s %2u bytes  ok\n", name, len);
+}
+
+static void expectRoundTrip(const char* name, const uint8_t* frame, uint16_t len) {
+    UbxParser parser;
+    UbxFeedResult last = UBX_FEED_NONE;
+    for (uint16_t i = 0; i < len; i++) last = parser.feed(frame[i]);
+
+    CHECK(last == UBX_FEED_FRAME, "%s: parser did not accept the frame", name);
+    if (last != UBX_FEED_FRAME) return;
+    const UbxFrame& f = parser.frame();
+    CHECK(f.msgClass == frame[2] && f.msgId == frame[3], "%s: class/id", name);
+    CHECK(f.length == len - UBX_FRAME_OVERHEAD, "%s: length %u", name, f.length);
+    CHECK(memcmp(f.payload, frame + 6, f.length) == 0, "%s: payload", name);
+}
+
+static void testEncoder() {
+    printf("\n[1] Encoder\n");
+    uint8_t frame[UBX_MAX_FRAME];
+    uint16_t len;
+
+    len = ubxBuildCfgMsg(UBX_CLASS_NMEA, UBX_NMEA_GGA, 0, frame);
+    expectBytes("CFG-MSG GGA off", frame, len, { 0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0xF0, 0x00, 0x00, 0xFA, 0x0F });
+    expectRoundTrip("CFG-MSG GGA off", frame, len);
+
+    len = ubxBuildCfgMsg(UBX_CLASS_NMEA, UBX_NMEA_GSV, 0, frame);
+    expectBytes("CFG-MSG GSV off", frame, len, { 0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0xF0, 0x03, 0x00, 0xFD, 0x15 });
+
+    len = ubxBuildCfgMsg(UBX_CLASS_NAV, UBX_NAV_TIMEUTC, 1, frame);
+    expectBytes("CFG-MSG NAV-TIMEUTC 1", frame, len, { 0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x21, 0x01, 0x2D, 0x85 });
+    expectRoundTrip("CFG-MSG NAV-TIMEUTC 1", frame, len);
+
+    len = ubxBuildCfgRxm(true, frame);
+    expectBytes("CFG-RXM power save", frame, len, { 0xB5, 0x62, 0x06, 0x11, 0x02, 0x00, 0x08, 0x01, 0x22, 0x92 });
+    expectRoundTrip("CFG-RXM power save", frame, len);
+
+    len = ubxBuildCfgRxm(false, frame);
+    expectBytes("CFG-RXM continuous", frame, len, { 0xB5, 0x62, 0x06, 0x11, 0x02, 0x00, 0x08, 0x00, 0x21, 0x91 });
+
+    // CFG-PM2: no reference capture, so check the layout field by field
+    len = ubxBuildCfgPm2(1000, frame);
+    CHECK(len == 44 + UBX_FRAME_OVERHEAD, "CFG-PM2 length %u", len);
+    expectRoundTrip("CFG-PM2 1 s", frame, len);
+    const uint8_t* p = frame + 6;
+    CHECK(p[0] == 1, "CFG-PM2 version %u", p[0]);
+    CHECK((p[8] | (p[9] << 8)) == 1000, "CFG-PM2 updatePeriod");
+    CHECK(p[20] == 0 && p[21] == 0, "CFG-PM2 cyclic tracking must not set onTime");
+    printf("  %-28s %2u bytes  ok\n", "CFG-PM2 1 s (cyclic)", len);
+
+    len = ubxBuildCfgPm2(60000, frame);
+    p = frame + 6;
+    CHECK(p[20] != 0, "CFG-PM2 ON/OFF needs onTime");
+    printf("  %-28s %2u bytes  ok\n", "CFG-PM2 60 s (ON/OFF)", len);
+
+    uint8_t big[UBX_MAX_PAYLOAD + 1] = { 0 };
+    CHECK(ubxBuildFrame(UBX_CLASS_CFG, UBX_CFG_MSG, big, sizeof(big), frame) == 0,
+          "oversized payload must be refused");
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPLAY
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct ReplayResult {
+    UbxParserStats stats;
+    size_t passThrough;         // UBX_FEED_NONE bytes (NMEA parser input)
+    unsigned nav;               // NAV frames decoded
+    unsigned acks;
+    unsigned naks;
+    UbxNavState navState;
+};
+
+static ReplayResult replay(const Stream& stream) {
+    ReplayResult r;
+    memset(&r, 0, sizeof(r));
+    UbxParser parser;
+
+    for (uint8_t byte : stream.bytes) {
+        UbxFeedResult result = parser.feed(byte);
+        if (result == UBX_FEED_NONE) r.passThrough++;
+        if (result != UBX_FEED_FRAME) continue;
+
+        const UbxFrame& frame = parser.frame();
+        bool acked;
+        if (frame.msgClass == UBX_CLASS_ACK && frame.length == 2 &&
+            ubxIsAckFor(frame, frame.payload[0], frame.payload[1], acked)) {
+            if (acked) r.acks++;
+            else r.naks++;
+        } else if (ubxDecodeNav(frame, r.navState)) {
+            r.nav++;
+        }
+    }
+    r.stats = parser.getStats();
+    return r;
+}
+
+struct StreamExpectation {
+    const char* file;
+    unsigned frames;
+    unsigned checksumErrors;
+    unsigned nav;
+    unsigned acks;
+    unsigned naks;
+    long passThrough;           // -1 = exactly the NMEA text
+};
+
+static const StreamExpectation STREAMS[] = {
+    { "nmea_default.txt",   0,  0,  0, 0, 0, -1 },
+    { "ubx_switch.txt",    45,  1, 35, 9, 1, -1 },
+    { "ubx_power_save.txt", 17, 1, 15, 2, 0, 15 }
+};
+
+static void checkLastFix(const char* name, const UbxNavState& s, uint8_t numSV, uint16_t hDopX100,
+                         uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
+    CHECK(s.seen == (UBX_SEEN_POSLLH | UBX_SEEN_SOL | UBX_SEEN_TIMEUTC | UBX_SEEN_DOP),
+          "%s: seen 0x%02X", name, s.seen);
+    CHECK(s.latE7 == 337838000 && s.lonE7 == -1181141000, "%s: position %d,%d", name, s.latE7, s.lonE7);
+    CHECK(s.heightMslMm == 18300, "%s: hMSL %d mm", name, s.heightMslMm);
+    CHECK(s.fixType == 3 && s.fixOk, "%s: fix %u ok=%d", name, s.fixType, s.fixOk);
+    CHECK(s.numSV == numSV, "%s: numSV %u", name, s.numSV);
+    CHECK(s.hDopX100 == hDopX100, "%s: hDOP %u", name, s.hDopX100);
+    CHECK(s.timeValid && s.year == 2026 && s.month == 3 && s.day == day, "%s: date %u-%u-%u",
+          name, s.year, s.month, s.day);
+    CHECK(s.hour == hour && s.minute == minute && s.second == second, "%s: time %02u:%02u:%02u",
+          name, s.hour, s.minute, s.second);
+}
+
+static void testReplay(const std::string& dir) {
+    printf("\n[2] Replay (byte at a time)\n");
+    printf("  %-20s %6s %6s %6s %5s %5s %5s %7s\n", "stream", "bytes", "frames", "ckErr", "nav", "ack", "nak", "text");
+
+    for (const StreamExpectation& e : STREAMS) {
+        Stream stream;
+        if (!loadStream(dir + "/" + e.file, stream)) {
+            CHECK(false, "cannot read %s/%s", dir.c_str(), e.file);
+            continue;
+        }
+        ReplayResult r = replay(stream);
+        printf("  %-20s %6zu %6u %6u %5u %5u %5u %7zu\n", e.file, stream.bytes.size(),
+               r.stats.frames, r.stats.checksumErrors, r.nav, r.acks, r.naks, r.passThrough);
+
+        size_t wantText = e.passThrough < 0 ? stream.nmeaBytes : (size_t)e.passThrough;
+        CHECK(r.stats.frames == e.frames, "%s: %u frames, expected %u", e.file, r.stats.frames, e.frames);
+        CHECK(r.stats.checksumErrors == e.checksumErrors, "%s: %u checksum errors, expected %u",
+              e.file, r.stats.checksumErrors, e.checksumErrors);
+        CHECK(r.nav == e.nav, "%s: %u NAV frames, expected %u", e.file, r.nav, e.nav);
+        CHECK(r.acks == e.acks && r.naks == e.naks, "%s: %u ACK / %u NAK", e.file, r.acks, r.naks);
+        CHECK(r.passThrough == wantText, "%s: %zu bytes passed to NMEA, expected %zu",
+              e.file, r.passThrough, wantText);
+
+        if (strcmp(e.file, "ubx_switch.txt") == 0) {
+            checkLastFix(e.file, r.navState, 9, 105, 18, 20, 0, 11);
+        } else if (strcmp(e.file, "ubx_power_save.txt") == 0) {
+            checkLastFix(e.file, r.navState, 7, 112, 19, 0, 0, 1);
+            CHECK(r.navState.nanos == -90, "%s: nanos %d", e.file, r.navState.nanos);
+        }
+    }
+}
+
+static std::vector<std::string> captureFiles(const std::string& dir) {
+    std::vector<std::string> files;
+    DIR* d = opendir(dir.c_str());
+    if (d == nullptr) return files;
+    while (dirent* entry = readdir(d)) {
+        std::string name = entry->d_name;
+        if (name.rfind("capture_", 0) == 0 && name.size() > 4 && name.substr(name.size() - 4) == ".txt") {
+            files.push_back(name);
+        }
+    }
+    closedir(d);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static void testCaptures(const std::string& dir) {
+    std::vector<std::string> files = captureFiles(dir);
+    if (files.empty()) {
+        printf("  (no hardware captures: see capture_stream.py)\n");
+        return;
+    }
+
+    // Real receiver output has no expected counts; it has to decode cleanly
+    const uint8_t navSet = UBX_SEEN_POSLLH | UBX_SEEN_SOL | UBX_SEEN_TIMEUTC;
+    for (const std::string& file : files) {
+        Stream stream;
+        if (!loadStream(dir + "/" + file, stream)) {
+            CHECK(false, "cannot read %s/%s", dir.c_str(), file.c_str());
+            continue;
+        }
+        ReplayResult r = replay(stream);
+        printf("  %-20s %6zu %6u %6u %5u %5u %5u %7zu\n", file.c_str(), stream.bytes.size(),
+               r.stats.frames, r.stats.checksumErrors, r.nav, r.acks, r.naks, r.passThrough);
+
+        CHECK(r.stats.checksumErrors == 0, "%s: %u checksum errors", file.c_str(), r.stats.checksumErrors);
+        CHECK(r.acks + r.naks > 0, "%s: no ACK/NAK for the CFG messages", file.c_str());
+        CHECK((r.navState.seen & navSet) == navSet, "%s: seen 0x%02X", file.c_str(), r.navState.seen);
+        CHECK(r.passThrough == stream.nmeaBytes, "%s: %zu bytes passed to NMEA, %zu NMEA bytes",
+              file.c_str(), r.passThrough, stream.nmeaBytes);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COST
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void testCost(const std::string& dir, unsigned benchBytes) {
+    printf("\n[3] Cost\n");
+
+    Stream nmea;
+    if (!loadStream(dir + "/nmea_default.txt", nmea)) return;
+    double nmeaPerSec = nmea.bytes.size() / 5.0;    // 5 epochs in the capture
+
+    // Steady-state UBX output: POSLLH + SOL + TIMEUTC every second, DOP every 5th
+    const double ubxPerSec = (28 + 52 + 20 + UBX_FRAME_OVERHEAD * 3) + (18 + UBX_FRAME_OVERHEAD) / 5.0;
+    printf("  UART  NMEA default set  %6.0f bytes/s (%.0f%% of 9600 baud)\n",
+           nmeaPerSec, nmeaPerSec * 10 / 96.0);
+    printf("  UART  UBX NAV set       %6.0f bytes/s (%.0f%% of 9600 baud), %.0f%% fewer\n",
+           ubxPerSec, ubxPerSec * 10 / 96.0, 100.0 * (1.0 - ubxPerSec / nmeaPerSec));
+    CHECK(ubxPerSec < nmeaPerSec / 2, "UBX set should at least halve the UART load");
+
+    Stream ubx;
+    if (!loadStream(dir + "/ubx_power_save.txt", ubx)) return;
+    std::vector<uint8_t> buffer;
+    while (buffer.size() < benchBytes) buffer.insert(buffer.end(), ubx.bytes.begin(), ubx.bytes.end());
+
+    UbxParser parser;
+    UbxNavState state;
+    memset(&state, 0, sizeof(state));
+    auto start = std::chrono::steady_clock::now();
+    for (uint8_t byte : buffer) {
+        if (parser.feed(byte) == UBX_FEED_FRAME) ubxDecodeNav(parser.frame(), state);
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double nsPerByte = sec * 1e9 / buffer.size();
+    printf("  Parse UBX               %6.1f ns/byte here, %.1f us per second of output\n",
+           nsPerByte, nsPerByte * ubxPerSec / 1000.0);
+    CHECK(state.numSV == 7, "bench state");
+}
+
+int main(int argc, char** argv) {
+    std::string dir = "streams";
+    unsigned benchBytes = 2000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--streams") == 0) dir = argv[i + 1];
+        else if (strcmp(argv[i], "--bytes") == 0) benchBytes = (unsigned)atoi(argv[i + 1]);
+    }
+
+    testEncoder();
+    testReplay(dir);
+    testCaptures(dir);
+    testCost(dir, benchBytes);
+
+    return checkSummary();
+}